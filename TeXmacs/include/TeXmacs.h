@@ -82,6 +82,39 @@ typedef struct package_exports_1 {
                     : NULL indicates a pure error */
 } package_exports_1;
 
+/******************************************************************************
+* The second protocol avoids copying the input and output of evaluations
+******************************************************************************/
+
+typedef struct TeXmacs_exports_2 {
+  char* version_protocol; /* "TeXmacs communication protocol 2" */
+  char* version_TeXmacs;
+
+  char* (*reserve) (void* out, int size);
+  /* Reserve size more bytes at the end of the output buffer out,
+     and return a pointer to them, where the package may write its answer.
+     A negative size gives back the unused bytes at the end of the buffer */
+} TeXmacs_exports_2;
+
+typedef struct package_exports_2 {
+  char* version_protocol; /* "TeXmacs communication protocol 2" */
+  char* version_package;
+
+  char* (*install) (TeXmacs_exports_2* TeXmacs,
+		    char* options, char** errors);
+  /* Same as for the first protocol */
+
+  int (*evaluate) (const char* what, int n, char* session,
+		   void* out, char** errors);
+  /* Interactive evaluation routine for shells.
+     what: the n bytes to be evaluated, which are not null terminated
+           and owned by TeXmacs
+     session: name of your session ("default" by default, freed by TeXmacs)
+     out: output buffer, which should be filled using TeXmacs->reserve
+     *errors: contains error and warning messages (freed by TeXmacs)
+     returned value: zero on success */
+} package_exports_2;
+
 #if defined (__cplusplus)
 }
 #endif
@@ -96,6 +96,28 @@
       (set! bib-style tmp-s)
       res)))
 
+;; The fields are looked up directly in the scheme representation of the
+;; entries.  The C++ routines cpp-bib-field and cpp-bib-empty? would convert
+;; the entire entry at each call, and the styles access many fields of each
+;; entry.  As in the C++ routines, missing fields are the empty symbol.
+
+(define bib-missing-field (string->symbol ""))
+
+(define (bib-entry? x)
+  (and (func? x 'bib-entry 3) (string? (cadr x)) (string? (caddr x))
+       (func? (cadddr x) 'document)))
+
+(define (bib-field? y f)
+  (and (func? y 'bib-field 2) (== (cadr y) f)))
+
+(tm-define (bib-field x f)
+  (with y (and (bib-entry? x)
+               (list-find (cdr (cadddr x)) (lambda (y) (bib-field? y f))))
+    (if y (caddr y) bib-missing-field)))
+
+(tm-define (bib-empty? x f)
+  (== (bib-field x f) bib-missing-field))
+
 (tm-define (bib-car x)
   (if (pair? x) (car x) ""))
 
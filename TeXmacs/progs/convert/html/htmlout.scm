@@ -159,6 +159,10 @@
 	    thunk
 	    (lambda () (set! preformatted? saved-preformatted))))))
 
-(tm-define (serialize-html x)
+(tm-define (scheme-serialize-html x)
+  ;; reference implementation of the serializer in Data/Convert/Xml/htmlout
   (htmlout x)
   (output-produce))
+
+(tm-define (serialize-html x)
+  (cpp-serialize-html x))
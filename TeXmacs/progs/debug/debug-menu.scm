@@ -75,6 +75,7 @@
       ("All" (bench-print-all)))
   (-> "Memory"
       ("Memory usage" (show-meminfo))
+      ("Memory by subsystem" (display (texmacs-memory-report)))
       ("Collect garbage" (gc))
       ---
       (group "Permanent")
@@ -25,12 +25,10 @@
 ;; Get scores for the different files
 ;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;
 
-(define (get-score-sub file keyword-list)
-  (with r (system-search-score (system->url file) keyword-list)
-    (cons file r)))
-
 (define (get-score-list keyword-list file-list)
-  (let* ((l1 (map (cut get-score-sub <> keyword-list) file-list))
+  (let* ((scores (system-search-scores (map system->url file-list)
+                                       keyword-list))
+         (l1 (map cons file-list scores))
          (l2 (list-filter l1 (lambda (x) (!= (cdr x) 0))))
          (l3 (list-sort l2 (lambda (x y) (>= (cdr x) (cdr y))))))
     l3))
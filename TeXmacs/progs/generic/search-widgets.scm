@@ -279,13 +279,34 @@
       (end-editing))
     (perform-search*)))
 
+(define (further-search-results sels cur)
+  (cond ((or (null? sels) (null? (cdr sels))) (list))
+        ((path-less? (car sels) cur) (further-search-results (cddr sels) cur))
+        (else sels)))
+
+(define (all-further-search-results)
+  (with what (buffer-get-body (search-buffer))
+    (when (tm-func? what 'document 1)
+      (set! what (tm-ref what 0)))
+    (when (tm-func? what 'inactive 1)
+      (set! what (tm-ref what 0)))
+    (when (tm-func? what 'inactive* 1)
+      (set! what (tm-ref what 0)))
+    (with-buffer (master-buffer)
+      (if (tree-empty? what) (list)
+          (let* ((t (buffer-tree))
+                 (cur (get-search-reference #t))
+                 (sels (tree-perform-search t what (tree->path t) 1000000)))
+            (further-search-results (filter-search-results sels) cur))))))
+
 (tm-define (replace-all)
   (and-with by (by-tree)
-    (with-buffer (master-buffer)
-      (start-editing)
-      (while (replace-next by)
-        (perform-search*))
-      (end-editing))
+    (with sels (all-further-search-results)
+      (with-buffer (master-buffer)
+        (when (nnull? sels)
+          (start-editing)
+          (replace-all-occurrences sels (tree-copy by))
+          (end-editing))))
     (perform-search*)))
 
 ;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;
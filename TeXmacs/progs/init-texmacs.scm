@@ -74,8 +74,17 @@
                       '(old-primitive-load new-primitive-load))
       (set! primitive-load new-primitive-load)))
 
-;; TODO: scheme file caching using (set! primitive-load ...) and
-;; (set! %search-load-path)
+;; Guile 2 and later compile the modules when they are first loaded and
+;; recompile them whenever the sources are more recent; keep the compiled
+;; files of TeXmacs together with its other caches
+(if (and (not (member (scheme-dialect) (list "guile-a" "guile-b")))
+         (defined? '%compile-fallback-path))
+    (set! %compile-fallback-path
+          (string-append (url-concretize "$TEXMACS_HOME_PATH/system/cache")
+                         "/guile")))
+
+;; TODO: scheme file caching for older versions of guile using
+;; (set! primitive-load ...) and (set! %search-load-path)
 
 ;;(debug-enable 'backtrace 'debug)
 ;; (define load-indent 0)
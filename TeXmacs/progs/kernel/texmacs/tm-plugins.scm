@@ -535,14 +535,34 @@
 	      ))
 	(if (plugin-all-initialized?) (plugin-save-setup)))))
 
+(define plugin-initialize-queue (list))
+
+(define (plugin-initialize-next)
+  "Initialize the next plug-in in the queue and leave the others for later"
+  (with l (list-filter plugin-initialize-queue
+                       (cut ahash-ref plugin-initialize-todo <>))
+    (set! plugin-initialize-queue (if (null? l) l (cdr l)))
+    (when (nnull? l)
+      (plugin-initialize (car l))
+      (when (nnull? (cdr l))
+        (delayed
+          (:idle 100)
+          (plugin-initialize-next))))))
+
 (define-public (lazy-plugin-initialize name)
   "Initialize the plug-in @name in a lazy way"
   (ahash-set! plugin-initialize-todo name #t)
   (if (eval (ahash-ref plugin-data-table (list name :prioritary)))
       (plugin-initialize name)
-      (delayed
-        (:idle 1000)
-        (plugin-initialize name))))
+      (begin
+        ;; the plug-ins are initialized one by one while the user is idle,
+        ;; unless one of them is needed earlier, see lazy-plugin-force
+        (when (null? plugin-initialize-queue)
+          (delayed
+            (:idle 1000)
+            (plugin-initialize-next)))
+        (set! plugin-initialize-queue
+              (rcons plugin-initialize-queue name)))))
 
 (define-public (lazy-plugin-force)
   "Force all lazy plugin initializations to take place"
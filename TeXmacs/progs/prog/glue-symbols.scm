@@ -80,6 +80,7 @@
 "bench-print"
 "bench-print-all"
 "system-wait"
+"system-async"
 "get-show-kbd"
 "set-show-kbd"
 "set-latex-command"
@@ -478,6 +479,8 @@
 "try-latex-export"
 "parse-xml"
 "parse-html"
+"cpp-serialize-html"
+"cpp-serialize-html-file"
 "parse-bib"
 "conservative-bib-import"
 "conservative-bib-export"
@@ -557,6 +560,7 @@
 "url-scratch"
 "url-scratch?"
 "url-cache-invalidate"
+"url-prefetch"
 "string-save"
 "string-load"
 "string-append-to-file"
@@ -566,6 +570,7 @@
 "system-mkdir"
 "system-rmdir"
 "system-search-score"
+"system-search-scores"
 "system-1"
 "system-2"
 "system-url->string"
@@ -591,6 +596,7 @@
 "tmdb-get-name-completions"
 "supports-sql?"
 "sql-exec"
+"sql-exec-all"
 "sql-quote"
 "server-start"
 "server-stop"
@@ -680,6 +686,10 @@
 "buffer-pretend-modified"
 "buffer-pretend-saved"
 "buffer-pretend-autosaved"
+"buffer-journaled?"
+"buffer-flush-journal"
+"buffer-recoverable?"
+"buffer-recover"
 "buffer-attach-notifier"
 "buffer-has-name?"
 "buffer-aux?"
@@ -748,8 +758,8 @@
 "bib-purify"
 "bib-text-length"
 "bib-prefix"
-"bib-empty?"
-"bib-field"
+"cpp-bib-empty?"
+"cpp-bib-field"
 "bib-abbreviate"
 "insert-kbd-wildcard"
 "set-variant-keys"
@@ -1027,6 +1037,7 @@
 "search-start"
 "search-button-next"
 "replace-start"
+"replace-all-occurrences"
 "spell-start"
 "spell-replace"
 "session-complete-command"
@@ -71,6 +71,19 @@
   (server-write client (object->string* (list server-serial cmd)))
   (set! server-serial (+ server-serial 1)))
 
+(define server-batch-size 16)
+
+(define (server-process client)
+  ;; Handle the pending requests of client, but at most server-batch-size
+  ;; of them, so that a busy client does not starve the other ones.
+  ;; Return #t if at least one request was handled.
+  (let loop ((i 0))
+    (with msg (if (< i server-batch-size) (server-read client) "")
+      (if (== msg "") (> i 0)
+          (with (msg-id msg-cmd) (string->object msg)
+            (server-eval (list client msg-id) msg-cmd)
+            (loop (+ i 1)))))))
+
 (tm-define (server-add client)
   (ahash-set! server-client-active? client #t)
   (with wait 1
@@ -78,11 +91,8 @@
       (:while (ahash-ref server-client-active? client))
       (:pause ((lambda () (inexact->exact (round wait)))))
       (:do (set! wait (min (* 1.01 wait) 2500)))
-      (with msg (server-read client)
-        (when (!= msg "")
-          (with (msg-id msg-cmd) (string->object msg)
-            (server-eval (list client msg-id) msg-cmd)
-            (set! wait 1)))))))
+      (when (server-process client)
+        (set! wait 1)))))
 
 (tm-define (server-remove client)
   (ahash-remove! server-client-active? client))
@@ -355,7 +355,11 @@
            (aname (url-autosave name suffix))
            (fm (url-format name)))
       (if (url-scratch? name) (set! aname name))
-      (cond ((nin? fm (list "texmacs" "stm"))
+      (cond ((and (buffer-journaled? name) (not (rescue-mode?)))
+             ;; only the modifications since the last save are written
+             (buffer-flush-journal name)
+             (buffer-pretend-autosaved name))
+            ((nin? fm (list "texmacs" "stm"))
              (when (not (rescue-mode?))
                (set-message `(concat "Warning: " ,vname " not auto-saved")
                             "Auto-save file")))
@@ -468,6 +472,18 @@
              (set-message msg "Load file")))
           (else (load-buffer-load name opts)))))
 
+(define (load-buffer-check-journal name opts)
+  ;;(display* "load-buffer-check-journal " name ", " opts "\n")
+  (if (and (buffer-recoverable? name) (nin? :strict opts))
+      (user-confirm "Rescue file from crash?" #t
+        (lambda (answ)
+          (if (and answ (not (buffer-recover name)))
+              (begin
+                (load-buffer-open name opts)
+                (buffer-pretend-modified name))
+              (load-buffer-check-autosave name opts))))
+      (load-buffer-check-autosave name opts)))
+
 (define (load-buffer-check-autosave name opts)
   ;;(display* "load-buffer-check-autosave " name ", " opts "\n")
   (if (and (autosave-propose name) (nin? :strict opts))
@@ -495,7 +511,7 @@
       (if (current-buffer)
           (set! name (url-relative (current-buffer) name))
           (set! name (url-append (url-pwd) name))))
-  (load-buffer-check-autosave name opts))
+  (load-buffer-check-journal name opts))
 
 (tm-define (load-buffer name . opts)
   (:argument name smart-file "File name")
@@ -658,6 +674,76 @@
   (linked-files-inside (buffer-tree)))
 
 ;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;
+;; Batch conversions
+;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;
+
+(define (batch-url s)
+  (with u (system->url s)
+    (if (url-rooted? u) u (url-append (url-pwd) u))))
+
+(define (batch-convert-sub in out)
+  (and (url-exists? in)
+       (begin (load-buffer in :strict) (buffer-exists? in))
+       (with fm (url-format out)
+         (if (== fm "generic") (set! fm "verbatim"))
+         (not (buffer-export in out fm)))))
+
+(define (batch-convert-job line)
+  ;; a job is a line with an input and an output file
+  (with l (list-filter (string-tokenize-by-char line #\space)
+                       (lambda (s) (!= s "")))
+    (cond ((or (null? l) (string-starts? (car l) "#")) (noop))
+          ((!= (length l) 2)
+           (display* "batch: invalid job '" line "'\n"))
+          (else
+            (let* ((in (batch-url (car l)))
+                   (out (batch-url (cadr l)))
+                   (start (texmacs-time))
+                   (ok? (catch #t
+                          (lambda () (batch-convert-sub in out))
+                          (lambda err #f))))
+              (if (buffer-exists? in) (buffer-close in))
+              (display* "batch: " (if ok? "converted " "failed ")
+                        (car l) " -> " (cadr l) " ("
+                        (- (texmacs-time) start) " msec)\n")
+              (force-output))))))
+
+(tm-define (batch-convert jobs)
+  (:synopsis "Perform the conversions listed in the file @jobs")
+  ;; the styles, fonts and converters which were loaded for one job
+  ;; remain available for the next ones; "-" stands for the standard input,
+  ;; from which the jobs are read as they arrive
+  (if (== jobs "-")
+      (let next ((line (read-line)))
+        (when (string? line)
+          (batch-convert-job line)
+          (next (read-line))))
+      (for-each batch-convert-job
+                (string-split-lines (string-load (batch-url jobs))))))
+
+;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;
+;; Exporting pages as raster images
+;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;
+
+(define (raster-page-range pages)
+  ;; "all", a single page "3" or a range "2-5"
+  (with l (string-tokenize-by-char pages #\-)
+    (cond ((or (== pages "all") (null? l)) (list "1" "1000000"))
+          ((null? (cdr l)) (list (car l) (car l)))
+          (else (list (car l) (cadr l))))))
+
+(tm-define (raster-export in out dpi pages)
+  (:synopsis "Export the @pages of @in as images @out at resolution @dpi")
+  ;; page n is saved as out-n.png for out.png; the format is taken
+  ;; from the suffix of @out
+  (let* ((in* (batch-url in))
+         (r (raster-page-range pages)))
+    (load-buffer in* :strict)
+    (when (buffer-exists? in*)
+      (export-pages-raster (batch-url out) (string->number dpi)
+                           (car r) (cadr r)))))
+
+;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;
 ;; Deprecated functionality
 ;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;
 
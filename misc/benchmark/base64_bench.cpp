@@ -0,0 +1,57 @@
+/******************************************************************************
+* MODULE     : base64_bench.cpp
+* DESCRIPTION: throughput of the base64 coding of embedded images
+* COPYRIGHT  : (C) 2020  Joris van der Hoeven
+*******************************************************************************
+* This software falls under the GNU general public license version 3 or later.
+* It comes WITHOUT ANY WARRANTY WHATSOEVER. For details, see the file LICENSE
+* in the root directory or <http://www.gnu.org/licenses/gpl-3.0.html>.
+******************************************************************************/
+
+#include "bench.hpp"
+#include "string.hpp"
+#include "base64.hpp"
+
+static string raw, coded;
+
+static string
+make_data (int size) {
+  // pseudo-random bytes, as for compressed image formats
+  string r (size);
+  unsigned int x= 12345;
+  for (int i=0; i<size; i++) {
+    x= x * 1103515245 + 12345;
+    r[i]= (char) (x >> 16);
+  }
+  return r;
+}
+
+static void
+base64_encode (int size) {
+  (void) size;
+  bench_sink += N(encode_base64 (raw));
+}
+
+static void
+base64_decode (int size) {
+  (void) size;
+  bench_sink += N(decode_base64 (coded));
+}
+
+/******************************************************************************
+* Main
+******************************************************************************/
+
+int
+main () {
+  int sizes[]= { 1 << 10, 1 << 20, 1 << 24 };
+  bench_header ();
+  for (int k=0; k<3; k++) {
+    int size= sizes[k];
+    raw= make_data (size);
+    coded= encode_base64 (raw);
+    bench_run ("base64", "encode", size, base64_encode);
+    bench_run ("base64", "decode", size, base64_decode);
+  }
+  return 0;
+}
@@ -0,0 +1,52 @@
+/******************************************************************************
+* MODULE     : bench.hpp
+* DESCRIPTION: common routines for the benchmark executables
+* COPYRIGHT  : (C) 2020  Joris van der Hoeven
+*******************************************************************************
+* This software falls under the GNU general public license version 3 or later.
+* It comes WITHOUT ANY WARRANTY WHATSOEVER. For details, see the file LICENSE
+* in the root directory or <http://www.gnu.org/licenses/gpl-3.0.html>.
+******************************************************************************/
+
+#ifndef BENCH_H
+#define BENCH_H
+#include "tm_timer.hpp"
+#include <stdio.h>
+
+/******************************************************************************
+* Each benchmark routine performs one iteration of a task of a given size.
+* bench_run repeats it until at least BENCH_MIN_TIME milliseconds have
+* elapsed and prints one line of comma separated values:
+*   suite,name,size,iterations,total_ms,us_per_iteration
+******************************************************************************/
+
+#define BENCH_MIN_TIME 250
+
+typedef void (*bench_routine) (int size);
+static volatile int bench_sink= 0; // results are stored here, so that
+                                   // the compiler keeps the computations
+
+inline void
+bench_header () {
+  printf ("suite,name,size,iterations,total_ms,us_per_iteration\n");
+  fflush (stdout);
+}
+
+inline void
+bench_run (const char* suite, const char* name, int size, bench_routine r) {
+  r (size); // warm up caches and allocator free lists
+  int nr= 1;
+  time_t elapsed= 0;
+  while (true) {
+    time_t start= texmacs_time ();
+    for (int i=0; i<nr; i++) r (size);
+    elapsed= texmacs_time () - start;
+    if (elapsed >= BENCH_MIN_TIME || nr >= (1 << 24)) break;
+    nr <<= 1;
+  }
+  printf ("%s,%s,%d,%d,%d,%.3f\n", suite, name, size, nr, (int) elapsed,
+          (1000.0 * ((double) elapsed)) / ((double) nr));
+  fflush (stdout);
+}
+
+#endif // defined BENCH_H
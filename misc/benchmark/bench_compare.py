@@ -0,0 +1,278 @@
+#!/usr/bin/env python3
+###############################################################################
+#
+# MODULE      : bench_compare.py
+# DESCRIPTION : track the results of the benchmarks across revisions
+# COPYRIGHT   : (C) 2020  Joris van der Hoeven
+#
+# This software falls under the GNU general public license version 3 or later.
+# It comes WITHOUT ANY WARRANTY WHATSOEVER. For details, see the file LICENSE
+# in the root directory or <http://www.gnu.org/licenses/gpl-3.0.html>.
+#
+###############################################################################
+
+# The benchmark suites are run several times, and the timings of each
+# benchmark are stored in a JSON history, keyed by the git revision:
+#   bench_compare.py run --bench-dir build/misc/benchmark
+# The results of the suites which run inside TeXmacs can be added with
+#   make typeset_bench > typeset.csv
+#   bench_compare.py run --csv typeset.csv
+# The last run is then compared to the previous revision in the history,
+# or to the revision given by --base:
+#   bench_compare.py compare --base 1a2b3c4
+# A benchmark regresses when it becomes slower by more than --threshold
+# percent and the difference is significant according to a Mann-Whitney
+# test at level --alpha.  The exit status is 1 if there are regressions.
+# Make "bench_compare" runs the C++ suites and does the comparison.
+
+import argparse
+import datetime
+import json
+import math
+import os
+import platform
+import subprocess
+import sys
+
+###############################################################################
+# Parsing the output of the suites
+###############################################################################
+
+# For each output format: the columns which identify a benchmark
+# and the column with the timing, where smaller is better
+FORMATS = [
+    (["suite", "name", "size"], "us_per_iteration"),
+    (["suite", "document", "run"], "total_ms"),
+    (["stage"], "mean_ms"),
+]
+
+def parse_csv(text, default_suite):
+    "Collect the samples of all benchmarks in the comma separated values"
+    results = {}
+    header = None
+    for line in text.splitlines():
+        fields = [f.strip() for f in line.strip().split(",")]
+        for keys, value in FORMATS:
+            if set(keys + [value]) <= set(fields):
+                header = (fields, keys, value)
+                break
+        else:
+            if header is None or len(fields) != len(header[0]):
+                continue  # not a line of results, e.g. build output
+            columns, keys, value = header
+            row = dict(zip(columns, fields))
+            try:
+                sample = float(row[value])
+            except ValueError:
+                continue
+            name = "/".join(row[k] for k in keys)
+            if "suite" not in keys:
+                name = default_suite + "/" + name
+            results.setdefault(name, []).append(sample)
+    return results
+
+def merge(results, more):
+    for name, samples in more.items():
+        results.setdefault(name, []).extend(samples)
+
+###############################################################################
+# Running the suites
+###############################################################################
+
+def bench_executables(bench_dir):
+    if not os.path.isdir(bench_dir):
+        return []
+    names = sorted(f for f in os.listdir(bench_dir) if f.endswith("_bench"))
+    paths = [os.path.join(bench_dir, f) for f in names]
+    return [p for p in paths if os.access(p, os.X_OK)]
+
+def run_suites(args):
+    results = {}
+    executables = bench_executables(args.bench_dir)
+    if args.suite:
+        executables = [e for e in executables
+                       if os.path.basename(e) in args.suite]
+    for exe in executables:
+        suite = os.path.basename(exe)[:-len("_bench")]
+        for i in range(args.repeat):
+            sys.stderr.write("Running %s (%d/%d)\n" % (exe, i+1, args.repeat))
+            out = subprocess.run([exe], stdout=subprocess.PIPE,
+                                 universal_newlines=True)
+            if out.returncode != 0:
+                sys.stderr.write("Warning: %s failed\n" % exe)
+            merge(results, parse_csv(out.stdout, suite))
+    for csv in args.csv or []:
+        suite = os.path.basename(csv).split(".")[0]
+        with open(csv) as f:
+            merge(results, parse_csv(f.read(), suite))
+    return results
+
+###############################################################################
+# The history
+###############################################################################
+
+def git_revision():
+    def git(*cmd):
+        return subprocess.run(["git"] + list(cmd), stdout=subprocess.PIPE,
+                              stderr=subprocess.DEVNULL,
+                              universal_newlines=True).stdout.strip()
+    rev = git("rev-parse", "--short", "HEAD") or "unknown"
+    if git("status", "--porcelain", "--untracked-files=no"):
+        rev += "-dirty"
+    return rev
+
+def load_history(path):
+    if not os.path.exists(path):
+        return {"runs": []}
+    with open(path) as f:
+        return json.load(f)
+
+def save_history(path, history):
+    tmp = path + ".tmp"
+    with open(tmp, "w") as f:
+        json.dump(history, f, indent=1, sort_keys=True)
+    os.replace(tmp, path)
+
+def add_run(history, revision, results):
+    "Add the results to the run of the revision on this host, if any"
+    host = platform.node()
+    for run in history["runs"]:
+        if run["revision"] == revision and run["host"] == host:
+            merge(run["results"], results)
+            run["date"] = datetime.datetime.now().isoformat()
+            history["runs"].remove(run)
+            history["runs"].append(run)
+            return
+    history["runs"].append({
+        "revision": revision,
+        "host": host,
+        "date": datetime.datetime.now().isoformat(),
+        "results": results})
+
+###############################################################################
+# Statistics
+###############################################################################
+
+def median(xs):
+    ys = sorted(xs)
+    n = len(ys)
+    return ys[n//2] if n % 2 else 0.5 * (ys[n//2 - 1] + ys[n//2])
+
+def mann_whitney(xs, ys):
+    "Two sided p-value for the samples xs and ys being identically distributed"
+    n1, n2 = len(xs), len(ys)
+    if n1 == 0 or n2 == 0:
+        return 1.0
+    pooled = sorted([(x, 0) for x in xs] + [(y, 1) for y in ys])
+    ranks = [0.0] * len(pooled)
+    ties = 0.0
+    i = 0
+    while i < len(pooled):
+        j = i
+        while j + 1 < len(pooled) and pooled[j+1][0] == pooled[i][0]:
+            j += 1
+        for k in range(i, j+1):
+            ranks[k] = 0.5 * (i + j) + 1
+        t = j - i + 1
+        ties += t*t*t - t
+        i = j + 1
+    r1 = sum(r for r, (_, g) in zip(ranks, pooled) if g == 0)
+    u = r1 - n1 * (n1 + 1) / 2.0
+    n = n1 + n2
+    var = n1 * n2 / 12.0 * ((n + 1) - ties / (n * (n - 1)))
+    if var <= 0:
+        return 1.0
+    z = (abs(u - n1 * n2 / 2.0) - 0.5) / math.sqrt(var)
+    return math.erfc(max(z, 0.0) / math.sqrt(2.0))
+
+###############################################################################
+# Comparing runs
+###############################################################################
+
+def find_run(history, revision, host, before=None):
+    runs = [r for r in history["runs"] if r["host"] == host]
+    if before is not None:
+        runs = runs[:runs.index(before)]
+        runs = [r for r in runs if r["revision"] != before["revision"]]
+    if revision is not None:
+        runs = [r for r in runs if r["revision"].startswith(revision)]
+    return runs[-1] if runs else None
+
+def compare(history, args):
+    host = platform.node()
+    current = find_run(history, args.revision, host)
+    if current is None:
+        sys.stderr.write("No results for this host in the history\n")
+        return 0
+    base = find_run(history, args.base, host, current)
+    if base is None:
+        sys.stderr.write("No earlier revision to compare %s with\n"
+                         % current["revision"])
+        return 0
+    print("Comparing %s with %s (threshold %.1f%%, alpha %.3f)"
+          % (current["revision"], base["revision"],
+             args.threshold, args.alpha))
+    regressions = 0
+    for name in sorted(current["results"]):
+        new = current["results"][name]
+        old = base["results"].get(name)
+        if not old or not new:
+            continue
+        m_old, m_new = median(old), median(new)
+        if m_old <= 0:
+            continue
+        change = 100.0 * (m_new - m_old) / m_old
+        p = mann_whitney(old, new)
+        if p < args.alpha and change > args.threshold:
+            status = "REGRESSION"
+            regressions += 1
+        elif p < args.alpha and change < -args.threshold:
+            status = "improvement"
+        else:
+            status = ""
+        if status or args.verbose:
+            print("%-50s %12.3f %12.3f %+7.1f%%  p=%.3f  %s"
+                  % (name, m_old, m_new, change, p, status))
+    print("%d regression(s)" % regressions)
+    return 1 if regressions > 0 else 0
+
+###############################################################################
+# Main
+###############################################################################
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Track the TeXmacs benchmarks across revisions")
+    parser.add_argument("command", choices=["run", "compare"])
+    parser.add_argument("--history", default="bench_history.json",
+                        help="JSON file with the results of earlier runs")
+    parser.add_argument("--bench-dir", default="misc/benchmark",
+                        help="directory with the *_bench executables")
+    parser.add_argument("--suite", action="append",
+                        help="only run this executable, e.g. kernel_bench")
+    parser.add_argument("--csv", action="append",
+                        help="add the results of a suite run by hand")
+    parser.add_argument("--repeat", type=int, default=5,
+                        help="number of runs of each suite")
+    parser.add_argument("--revision", help="revision to compare")
+    parser.add_argument("--base", help="revision to compare with")
+    parser.add_argument("--threshold", type=float, default=5.0,
+                        help="minimal slowdown in percent for a regression")
+    parser.add_argument("--alpha", type=float, default=0.05,
+                        help="significance level of the test")
+    parser.add_argument("--verbose", action="store_true",
+                        help="also list the unchanged benchmarks")
+    args = parser.parse_args()
+
+    history = load_history(args.history)
+    if args.command == "run":
+        results = run_suites(args)
+        if not results:
+            sys.stderr.write("No benchmark results were found\n")
+            return 1
+        add_run(history, git_revision(), results)
+        save_history(args.history, history)
+    return compare(history, args)
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,76 @@
+
+;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;
+;;
+;; MODULE      : bib_bench.scm
+;; DESCRIPTION : benchmarks for the built-in BibTeX styles
+;; COPYRIGHT   : (C) 2020  Joris van der Hoeven
+;;
+;; This software falls under the GNU general public license version 3 or later.
+;; It comes WITHOUT ANY WARRANTY WHATSOEVER. For details, see the file LICENSE
+;; in the root directory or <http://www.gnu.org/licenses/gpl-3.0.html>.
+;;
+;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;
+
+;; The styles are evaluated by the scheme interpreter and can only be run
+;; from within TeXmacs, for instance using
+;;   texmacs -headless -x '(load "misc/benchmark/bib_bench.scm")' -q
+;; The output has the same format as the one of the C++ benchmarks.
+
+(use-modules (bibtex bib-utils))
+
+(define (bench-field name val)
+  `(bib-field ,name ,val))
+
+(define (bench-entry i)
+  (let* ((s (number->string i))
+         (type (list-ref '("article" "book" "inproceedings" "techreport")
+                         (modulo i 4))))
+    `(bib-entry ,type ,(string-append "key" s)
+       (document
+        ,(bench-field "author"
+                      (string-append "Ada Lovelace" s " and Alan Turing"))
+        ,(bench-field "title" (string-append "On the analytical engine " s))
+        ,(bench-field "journal" "Journal of Computing Machinery")
+        ,(bench-field "booktitle" "Proceedings of the Conference")
+        ,(bench-field "publisher" "Academic Press")
+        ,(bench-field "institution" "University of Cambridge")
+        ,(bench-field "year" (number->string (+ 1900 (modulo i 120))))
+        ,(bench-field "volume" (number->string (modulo i 50)))
+        ,(bench-field "pages" "1--20")))))
+
+(define (bench-bibliography n)
+  (with l (list)
+    (do ((i n (- i 1))) ((= i 0)) (set! l (cons (bench-entry i) l)))
+    `(document ,@l)))
+
+(define (bench-line name size iterations ms)
+  (display* "bibtex," name "," size "," iterations "," ms ","
+            (/ (* 1000.0 ms) iterations) "\n"))
+
+(define (bench-run name size thunk)
+  (let* ((start (texmacs-time))
+         (dummy (thunk))
+         (ms (- (texmacs-time) start)))
+    (bench-line name size 1 ms)))
+
+(define (bench-lookups t get)
+  (for-each (lambda (x)
+              (for-each (lambda (f) (get x f))
+                        '("author" "title" "year" "pages" "note")))
+            (cdr t)))
+
+(define (bench-styles n)
+  (with t (bench-bibliography n)
+    (bench-run "field_lookup_cpp" n
+               (lambda () (bench-lookups t cpp-bib-field)))
+    (bench-run "field_lookup_scheme" n
+               (lambda () (bench-lookups t bib-field)))
+    (for-each (lambda (style)
+                (eval `(use-modules (bibtex ,(string->symbol style))))
+                (bench-run (string-append "format_" style) n
+                           (lambda () (bib-process "bib" style t))))
+              '("plain" "alpha" "abbrv" "acm" "ieeetr" "siam"))))
+
+(display "suite,name,size,iterations,total_ms,us_per_iteration\n")
+(bench-styles 500)
+(bench-styles 5000)
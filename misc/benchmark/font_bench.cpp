@@ -0,0 +1,90 @@
+/******************************************************************************
+* MODULE     : font_bench.cpp
+* DESCRIPTION: benchmarks for measuring multilingual text with smart fonts
+* COPYRIGHT  : (C) 2020  Joris van der Hoeven
+*******************************************************************************
+* This software falls under the GNU general public license version 3 or later.
+* It comes WITHOUT ANY WARRANTY WHATSOEVER. For details, see the file LICENSE
+* in the root directory or <http://www.gnu.org/licenses/gpl-3.0.html>.
+******************************************************************************/
+
+#include "bench.hpp"
+#include "font.hpp"
+#include "analyze.hpp"
+#include "boot.hpp"
+
+/******************************************************************************
+* A sample document with paragraphs in several scripts, in the internal
+* encoding of TeXmacs: Cork for accented Latin letters and <#XXXX> for the
+* other Unicode characters
+******************************************************************************/
+
+static const char* sample[]= {
+  "The quick brown fox jumps over the lazy dog, again and again.",
+  "Le c\xF7" "ur d\xE9" "cid\xE9 de l'\xE9l\xE8ve na\xEFt \xE0 la for\xEAt.",
+  "<#3A4><#3B1> <#3BA><#3B1><#3BB><#3AC> <#3C0><#3C1><#3AC><#3B3>"
+  "<#3BC><#3B1><#3C4><#3B1> <#3B1><#3C1><#3B3><#3BF><#3CD><#3BD>.",
+  "<#412><#441><#435> <#441><#447><#430><#441><#442><#43B><#438><#432>"
+  "<#44B><#435> <#441><#435><#43C><#44C><#438> <#43F><#43E><#445>"
+  "<#43E><#436><#438>.",
+  "<#4E2D><#6587> <#6587><#672C> <#7684> <#6D4B><#8BD5> <#6587><#6863>.",
+  "<#65E5><#672C><#8A9E><#306E> <#30C6><#30AD><#30B9><#30C8> "
+  "<#3067><#3059>."
+};
+
+static font bench_fn;
+static array<string> lines;
+static array<string> words;
+
+static void
+make_sample () {
+  if (N(lines) != 0) return;
+  init_texmacs ();
+  bench_fn= smart_font ("TeXmacs Computer Modern", "rm", "medium", "right",
+                        10, 600);
+  for (int k=0; k<10; k++)
+    for (int i=0; i<(int) (sizeof (sample) / sizeof (char*)); i++) {
+      string s (sample[i]);
+      lines << s;
+      array<string> a= tokenize (s, " ");
+      for (int j=0; j<N(a); j++) words << a[j];
+    }
+}
+
+/******************************************************************************
+* Benchmarks
+******************************************************************************/
+
+static void
+word_extents (int size) {
+  // as when typesetting the words of a paragraph
+  (void) size;
+  make_sample ();
+  array<metric_struct> exs;
+  bench_fn->get_extents (words, exs);
+  bench_sink += N(exs);
+}
+
+static void
+line_positions (int size) {
+  // every character is resolved into a subfont
+  (void) size;
+  make_sample ();
+  SI r= 0;
+  for (int i=0; i<N(lines); i++) {
+    STACK_NEW_ARRAY (xpos, SI, N(lines[i])+1);
+    bench_fn->get_xpositions (lines[i], xpos);
+    r += xpos[N(lines[i])];
+    STACK_DELETE_ARRAY (xpos);
+  }
+  bench_sink += (int) r;
+}
+
+int
+main () {
+  bench_header ();
+  make_sample ();
+  bench_run ("font", "word_extents", N(words), word_extents);
+  bench_run ("font", "line_positions", N(lines), line_positions);
+  return 0;
+}
@@ -0,0 +1,220 @@
+/******************************************************************************
+* MODULE     : kernel_bench.cpp
+* DESCRIPTION: benchmarks for the containers and types of the kernel
+* COPYRIGHT  : (C) 2020  Joris van der Hoeven
+*******************************************************************************
+* This software falls under the GNU general public license version 3 or later.
+* It comes WITHOUT ANY WARRANTY WHATSOEVER. For details, see the file LICENSE
+* in the root directory or <http://www.gnu.org/licenses/gpl-3.0.html>.
+******************************************************************************/
+
+#include "bench.hpp"
+#include "tree.hpp"
+#include "hashmap.hpp"
+#include "flat_hashmap.hpp"
+#include "list.hpp"
+#include "rectangles.hpp"
+
+static array<string> keys;
+
+static void
+make_keys (int size) {
+  if (N(keys) >= size) return;
+  keys= array<string> ();
+  for (int i=0; i<size; i++)
+    keys << ("key" * as_string (i));
+}
+
+static tree
+make_document (int size) {
+  // a document of paragraphs with short words and symbols
+  tree doc (DOCUMENT);
+  string words[]= { "the", "<alpha>", "formula", " ", "x", "+", "<infty>" };
+  for (int i=0; i<size; i+=10) {
+    tree par (CONCAT);
+    for (int j=i; j<i+10 && j<size; j++) par << tree (words[j%7]);
+    par << tree (WITH, "font-shape", "italic", "y");
+    doc << par;
+  }
+  return doc;
+}
+
+/******************************************************************************
+* Hashmaps
+******************************************************************************/
+
+static void
+hashmap_insert (int size) {
+  hashmap<string,int> h (0);
+  for (int i=0; i<size; i++) h (keys[i])= i;
+  bench_sink += N(h);
+}
+
+static void
+flat_hashmap_insert (int size) {
+  flat_hashmap<string,int> h (0);
+  for (int i=0; i<size; i++) h (keys[i])= i;
+  bench_sink += N(h);
+}
+
+static hashmap<string,int> lookup_map (0);
+static flat_hashmap<string,int> flat_lookup_map (0);
+
+static void
+hashmap_lookup (int size) {
+  int s= 0;
+  for (int i=0; i<size; i++) s += lookup_map [keys[i]];
+  bench_sink += s;
+}
+
+static void
+flat_hashmap_lookup (int size) {
+  int s= 0;
+  for (int i=0; i<size; i++) s += flat_lookup_map [keys[i]];
+  bench_sink += s;
+}
+
+static void
+hashmap_resize (int size) {
+  hashmap<string,int> h= copy (lookup_map);
+  h->resize (size << 2);
+  h->resize (size >> 2);
+  bench_sink += N(h);
+}
+
+static void
+flat_hashmap_resize (int size) {
+  flat_hashmap<string,int> h= copy (flat_lookup_map);
+  h->resize (size << 2);
+  h->resize (size >> 2);
+  bench_sink += N(h);
+}
+
+/******************************************************************************
+* Arrays, lists and strings
+******************************************************************************/
+
+static void
+array_append (int size) {
+  array<int> a;
+  for (int i=0; i<size; i++) a << i;
+  bench_sink += N(a);
+}
+
+static list<int> traversal_list;
+
+static void
+list_traversal (int size) {
+  (void) size;
+  int s= 0;
+  for (list<int> l= traversal_list; !is_nil (l); l= l->next) s += l->item;
+  bench_sink += s;
+}
+
+static void
+string_concat (int size) {
+  string s;
+  for (int i=0; i<size; i++) s << keys[i%N(keys)];
+  bench_sink += N(s);
+}
+
+static void
+string_short (int size) {
+  array<string> a (size);
+  for (int i=0; i<size; i++) a[i]= string ((char) ('a' + (i%26)));
+  bench_sink += N(a);
+}
+
+/******************************************************************************
+* Trees
+******************************************************************************/
+
+static tree doc1, doc2;
+
+static void
+tree_build (int size) {
+  bench_sink += N(make_document (size));
+}
+
+static void
+tree_copy (int size) {
+  (void) size;
+  bench_sink += N(copy (doc1));
+}
+
+static void
+tree_equal (int size) {
+  (void) size;
+  bench_sink += (doc1 == doc2)? 1: 0;
+}
+
+/******************************************************************************
+* Rectangles
+******************************************************************************/
+
+static rectangles boxes1, boxes2;
+
+static rectangles
+make_boxes (int size, SI shift) {
+  // overlapping boxes of words on lines, as in invalidated selections
+  rectangles l;
+  for (int i=0; i<size; i++) {
+    SI x= (i % 50) * 90 + shift, y= (i / 50) * 120 + shift;
+    l= rectangles (rectangle (x, y, x + 100, y + 130), l);
+  }
+  return l;
+}
+
+static void
+rectangles_union (int size) {
+  (void) size;
+  bench_sink += N(boxes1 | boxes2);
+}
+
+static void
+rectangles_difference (int size) {
+  (void) size;
+  bench_sink += N(boxes1 - boxes2);
+}
+
+/******************************************************************************
+* Main
+******************************************************************************/
+
+int
+main () {
+  int sizes[]= { 1000, 100000 };
+  bench_header ();
+  for (int k=0; k<2; k++) {
+    int size= sizes[k];
+    make_keys (size);
+    lookup_map= hashmap<string,int> (0);
+    flat_lookup_map= flat_hashmap<string,int> (0);
+    for (int i=0; i<size; i++) lookup_map (keys[i])= i;
+    for (int i=0; i<size; i++) flat_lookup_map (keys[i])= i;
+    traversal_list= list<int> ();
+    for (int i=0; i<size; i++) traversal_list= list<int> (i, traversal_list);
+    doc1= make_document (size);
+    doc2= copy (doc1);
+    boxes1= make_boxes (size, 0);
+    boxes2= make_boxes (size, 45);
+
+    bench_run ("kernel", "hashmap_insert", size, hashmap_insert);
+    bench_run ("kernel", "flat_hashmap_insert", size, flat_hashmap_insert);
+    bench_run ("kernel", "hashmap_lookup", size, hashmap_lookup);
+    bench_run ("kernel", "flat_hashmap_lookup", size, flat_hashmap_lookup);
+    bench_run ("kernel", "hashmap_resize", size, hashmap_resize);
+    bench_run ("kernel", "flat_hashmap_resize", size, flat_hashmap_resize);
+    bench_run ("kernel", "array_append", size, array_append);
+    bench_run ("kernel", "list_traversal", size, list_traversal);
+    bench_run ("kernel", "string_concat", size, string_concat);
+    bench_run ("kernel", "string_short", size, string_short);
+    bench_run ("kernel", "tree_build", size, tree_build);
+    bench_run ("kernel", "tree_copy", size, tree_copy);
+    bench_run ("kernel", "tree_equal", size, tree_equal);
+    bench_run ("kernel", "rectangles_union", size, rectangles_union);
+    bench_run ("kernel", "rectangles_difference", size,
+               rectangles_difference);
+  }
+  return 0;
+}
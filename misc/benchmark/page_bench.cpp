@@ -0,0 +1,145 @@
+/******************************************************************************
+* MODULE     : page_bench.cpp
+* DESCRIPTION: latency of page breaking after edits in a long document
+* COPYRIGHT  : (C) 2020  Joris van der Hoeven
+*******************************************************************************
+* This software falls under the GNU general public license version 3 or later.
+* It comes WITHOUT ANY WARRANTY WHATSOEVER. For details, see the file LICENSE
+* in the root directory or <http://www.gnu.org/licenses/gpl-3.0.html>.
+******************************************************************************/
+
+#include "bench.hpp"
+#include "Page/new_breaker.hpp"
+#include "Boxes/construct.hpp"
+#include "Line/lazy_vstream.hpp"
+
+skeleton new_break_pages (array<page_item> l, space ph, int qual,
+                          space fn_sep, space fnote_sep, space float_sep,
+                          font fn, int first_page);
+
+struct bench_font_rep: font_rep {
+  bench_font_rep (): font_rep ("bench-font") { y1= -2000; y2= 8000; }
+  bool supports (string c) { (void) c; return true; }
+  void get_extents (string s, metric& ex) { (void) s; (void) ex; }
+  void draw_fixed (renderer ren, string s, SI x, SI y) {
+    (void) ren; (void) s; (void) x; (void) y; }
+  font magnify (double zx, double zy) { (void) zx; (void) zy; return this; }
+};
+
+/******************************************************************************
+* A book with chapters of about 10 pages, each starting on a new page
+******************************************************************************/
+
+#define LINES_PER_CHAPTER 500
+
+static font bench_fn;
+static array<page_item> book;
+static page_item edited[2];
+static int edit_pos;
+static int edit_count= 0;
+
+static page_item
+make_line (int i, SI h) {
+  page_item item (empty_box (decorate (), 0, -h/4, 100000, 3*h/4));
+  item->spc= space (1000, 2000, 3000);
+  item->penalty= (i % 7 == 0? 1000: 0);
+  return item;
+}
+
+static void
+make_book (int size) {
+  if (is_nil (bench_fn)) bench_fn= tm_new<bench_font_rep> ();
+  if (N(book) == size) return;
+  book= array<page_item> ();
+  for (int i=0; N(book) < size; i++) {
+    if (i > 0 && i % LINES_PER_CHAPTER == 0) book << page_item (NEW_PAGE, 1);
+    else book << make_line (i, 10000);
+  }
+}
+
+static skeleton
+break_book () {
+  return new_break_pages (book, space (490000, 500000, 510000), 2,
+                          space (0), space (0), space (0), bench_fn, 1);
+}
+
+static void
+edit_and_break (int size) {
+  // alternate between two versions of one line, as when typing
+  (void) size;
+  book[edit_pos]= edited[(edit_count++) & 1];
+  bench_sink += N(break_book ());
+}
+
+static void
+bench_edit (const char* name, int size, int percent) {
+  make_book (size);
+  edit_pos= (size * percent) / 100;
+  while (book[edit_pos]->type != PAGE_LINE_ITEM) edit_pos++;
+  edited[0]= make_line (edit_pos, 10000);
+  edited[1]= make_line (edit_pos, 25000);
+  bench_run ("page", name, size, edit_and_break);
+}
+
+/******************************************************************************
+* A paper with a large figure every few lines
+******************************************************************************/
+
+#define LINES_PER_FLOAT 12
+
+static array<page_item> paper;
+
+static page_item
+make_float_line (int i, SI h) {
+  array<page_item> body;
+  body << page_item (empty_box (decorate (), 0, 0, 300000, 150000));
+  array<lazy> fl;
+  fl << (lazy) lazy_vstream (decorate (), tuple ("float", "tbh"),
+                             body, stack_border ());
+  page_item item (make_line (i, h)->b, fl, 1);
+  item->spc= space (1000, 2000, 3000);
+  return item;
+}
+
+static void
+make_paper (int size) {
+  if (is_nil (bench_fn)) bench_fn= tm_new<bench_font_rep> ();
+  if (N(paper) == size) return;
+  paper= array<page_item> ();
+  for (int i=0; N(paper) < size; i++)
+    if (i % LINES_PER_FLOAT == LINES_PER_FLOAT - 1)
+      paper << make_float_line (i, 10000);
+    else paper << make_line (i, 10000);
+}
+
+static void
+break_paper (int size) {
+  (void) size;
+  bench_sink += N(new_break_pages (paper, space (490000, 500000, 510000), 2,
+                                   space (0), space (0), space (10000),
+                                   bench_fn, 1));
+}
+
+static void
+bench_floats (int size) {
+  make_paper (size);
+  bench_run ("page", "floats", size, break_paper);
+}
+
+/******************************************************************************
+* Main routine
+******************************************************************************/
+
+int
+main () {
+  bench_header ();
+  for (int size= 5000; size <= 20000; size *= 2) {
+    bench_edit ("edit_start", size, 0);
+    bench_edit ("edit_10", size, 10);
+    bench_edit ("edit_50", size, 50);
+    bench_edit ("edit_90", size, 90);
+  }
+  for (int size= 500; size <= 2000; size *= 2)
+    bench_floats (size);
+  return 0;
+}
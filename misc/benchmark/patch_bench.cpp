@@ -0,0 +1,75 @@
+
+/******************************************************************************
+* MODULE     : patch_bench.cpp
+* DESCRIPTION: benchmarks for the commutation of patches
+* COPYRIGHT  : (C) 2020  Joris van der Hoeven
+*******************************************************************************
+* This software falls under the GNU general public license version 3 or later.
+* It comes WITHOUT ANY WARRANTY WHATSOEVER. For details, see the file LICENSE
+* in the root directory or <http://www.gnu.org/licenses/gpl-3.0.html>.
+******************************************************************************/
+
+#include "bench.hpp"
+#include "patch.hpp"
+
+static patch history1, history2, history3;
+
+static patch
+typing_history (int par, int size) {
+  // size characters typed at the end of paragraph par
+  array<patch> a;
+  for (int i=0; i<size; i++)
+    a << patch (mod_insert (path (par), i, "x"),
+                mod_remove (path (par), i, 1));
+  return patch (a);
+}
+
+static patch
+paragraph_history (int size) {
+  // size paragraphs inserted at the end of a document of two paragraphs
+  array<patch> a;
+  for (int i=0; i<size; i++)
+    a << patch (mod_insert (path (), 2+i, tree (DOCUMENT, "y")),
+                mod_remove (path (), 2+i, 1));
+  return patch (a);
+}
+
+/******************************************************************************
+* Merging concurrent histories
+******************************************************************************/
+
+static void
+merge_disjoint (int size) {
+  // two authors typing in different paragraphs
+  (void) size;
+  patch p1= history1, p2= history2;
+  bench_sink += swap (p1, p2);
+}
+
+static void
+merge_shifted (int size) {
+  // one author typing while the other one inserts paragraphs
+  (void) size;
+  patch p1= history1, p2= history3;
+  bench_sink += swap (p1, p2);
+}
+
+/******************************************************************************
+* Main
+******************************************************************************/
+
+int
+main () {
+  int sizes[]= { 100, 1000, 10000 };
+  bench_header ();
+  for (int k=0; k<3; k++) {
+    int size= sizes[k];
+    history1= typing_history (0, size);
+    history2= typing_history (1, size);
+    history3= paragraph_history (size);
+    bench_run ("patch", "merge_disjoint", size, merge_disjoint);
+    if (size <= 1000)
+      bench_run ("patch", "merge_shifted", size, merge_shifted);
+  }
+  return 0;
+}
@@ -0,0 +1,46 @@
+
+;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;
+;;
+;; MODULE      : replay_bench.scm
+;; DESCRIPTION : editing latency benchmark replaying recorded keystrokes
+;; COPYRIGHT   : (C) 2020  Joris van der Hoeven
+;;
+;; This software falls under the GNU general public license version 3 or later.
+;; It comes WITHOUT ANY WARRANTY WHATSOEVER. For details, see the file LICENSE
+;; in the root directory or <http://www.gnu.org/licenses/gpl-3.0.html>.
+;;
+;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;
+
+;; A trace of keystrokes is recorded in a running TeXmacs session by
+;;   (keyboard-record-start)
+;; followed by some editing and
+;;   (keyboard-record-stop "session.keys")
+;; The trace contains one line "<delay in ms> <key>" for each keystroke.
+;; It is replayed on a document by
+;;   REPLAY_DOCUMENT=doc.tm REPLAY_TRACE=session.keys make replay_bench
+;; Each keystroke is handled, typeset and repainted offscreen before the
+;; next one, without the recorded delays.  The result is one line of comma
+;; separated values for the whole event and for each of its stages:
+;;   stage,events,mean_ms,p50_ms,p90_ms,p99_ms,max_ms
+
+(define replay-document
+  (or (getenv "REPLAY_DOCUMENT")
+      "$TEXMACS_PATH/doc/about/changes/change-log.en.tm"))
+
+(define replay-trace (getenv "REPLAY_TRACE"))
+
+(define (replay-bench doc trace)
+  (with u (url-system doc)
+    (load-buffer u :strict)
+    (when (buffer-exists? u)
+      (latency-reset)
+      (latency-start 0)
+      (keyboard-replay (url-system trace))
+      (latency-stop)
+      (display (latency-distribution))
+      (force-output)
+      (buffer-close u))))
+
+(if replay-trace
+    (replay-bench replay-document replay-trace)
+    (display "Please set REPLAY_TRACE to a recorded keystroke trace\n"))
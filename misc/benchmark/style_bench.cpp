@@ -0,0 +1,86 @@
+/******************************************************************************
+* MODULE     : style_bench.cpp
+* DESCRIPTION: benchmarks for the environments of the style evaluator
+* COPYRIGHT  : (C) 2020  Joris van der Hoeven
+*******************************************************************************
+* This software falls under the GNU general public license version 3 or later.
+* It comes WITHOUT ANY WARRANTY WHATSOEVER. For details, see the file LICENSE
+* in the root directory or <http://www.gnu.org/licenses/gpl-3.0.html>.
+******************************************************************************/
+
+#include "bench.hpp"
+#include "std_environment.hpp"
+#include "memorizer.hpp"
+#include "vars.hpp"
+
+static environment bench_env;
+static int bench_depth= -1;
+
+static void
+make_environment (int depth) {
+  // a global environment with the standard variables, followed by
+  // 'depth' nested assignments of other variables, as inside macros
+  if (bench_depth == depth) return;
+  hashmap<string,tree> h (UNINIT);
+  h (DPI)= "600"; h (ZOOM_FACTOR)= "1"; h (MAGNIFICATION)= "1";
+  h (MODE)= "text"; h (LANGUAGE)= "english";
+  h (FONT)= "roman"; h (FONT_FAMILY)= "rm";
+  h (FONT_SERIES)= "medium"; h (FONT_SHAPE)= "right";
+  h (FONT_SIZE)= "1"; h (FONT_BASE_SIZE)= "10"; h (MATH_LEVEL)= "0";
+  for (int i=0; i<200; i++)
+    h ("user-" * as_string (i))= as_string (i);
+  memorize_initialize ();
+  primitive (bench_env, h);
+  for (int i=0; i<depth; i++) {
+    assoc_environment local (1);
+    local->raw_write (0, "local-" * as_string (i), as_string (i));
+    assign (bench_env, local);
+  }
+  (void) memorize_finalize ();
+  bench_depth= depth;
+}
+
+static void
+read_by_name (int depth) {
+  make_environment (depth);
+  int r= 0;
+  for (int i=0; i<100; i++) {
+    r += N (as_string (bench_env [FONT]));
+    r += N (as_string (bench_env [FONT_FAMILY]));
+    r += N (as_string (bench_env [FONT_SERIES]));
+    r += N (as_string (bench_env [FONT_SHAPE]));
+    r += N (as_string (bench_env [FONT_SIZE]));
+    r += N (as_string (bench_env [MATH_LEVEL]));
+    r += N (as_string (bench_env [DPI]));
+    r += N (as_string (bench_env [MODE]));
+  }
+  bench_sink += r;
+}
+
+static void
+read_by_slot (int depth) {
+  make_environment (depth);
+  int r= 0;
+  for (int i=0; i<100; i++) {
+    r += N (as_string (bench_env [SLOT_FONT]));
+    r += N (as_string (bench_env [SLOT_FONT_FAMILY]));
+    r += N (as_string (bench_env [SLOT_FONT_SERIES]));
+    r += N (as_string (bench_env [SLOT_FONT_SHAPE]));
+    r += N (as_string (bench_env [SLOT_FONT_SIZE]));
+    r += N (as_string (bench_env [SLOT_MATH_LEVEL]));
+    r += N (as_string (bench_env [SLOT_DPI]));
+    r += N (as_string (bench_env [SLOT_MODE]));
+  }
+  bench_sink += r;
+}
+
+int
+main () {
+  bench_header ();
+  int depths[]= { 1, 10, 100 };
+  for (int i=0; i<3; i++) {
+    bench_run ("environment", "read_by_name", depths[i], read_by_name);
+    bench_run ("environment", "read_by_slot", depths[i], read_by_slot);
+  }
+  return 0;
+}
@@ -0,0 +1,67 @@
+
+;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;
+;;
+;; MODULE      : typeset_bench.scm
+;; DESCRIPTION : end-to-end benchmarks for typesetting whole documents
+;; COPYRIGHT   : (C) 2020  Joris van der Hoeven
+;;
+;; This software falls under the GNU general public license version 3 or later.
+;; It comes WITHOUT ANY WARRANTY WHATSOEVER. For details, see the file LICENSE
+;; in the root directory or <http://www.gnu.org/licenses/gpl-3.0.html>.
+;;
+;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;
+
+;; The typesetter needs the style files, the fonts and the scheme code of
+;; TeXmacs, so the benchmark is run from within TeXmacs, for instance using
+;;   texmacs -delete-style-cache -x '(load "misc/benchmark/typeset_bench.scm")' -q
+;; from the root of the source tree, or by "make typeset_bench".
+;;
+;; Each document of the corpus is typeset as for printing, once with an empty
+;; style cache and then bench-warm-runs times with warm caches.  There is one
+;; line of comma separated values for each run:
+;;   suite,document,run,pages,total_ms,style_ms,exec_ms,concat_ms,
+;;   line_ms,page_ms,peak_kb
+;; The phases are nested: macro expansion (exec) happens during the
+;; concatenation, which happens during page breaking for floats and
+;; footnotes.  The peak memory is the maximal resident set size so far.
+
+(define bench-corpus
+  '(("text" "$TEXMACS_PATH/doc/about/changes/change-log.en.tm")
+    ("math" "$TEXMACS_PATH/examples/texts/subscript-test.tm")
+    ("tables" "$TEXMACS_PATH/examples/texts/bigtable-test.tm")
+    ("graphics" "$TEXMACS_PATH/doc/main/graphics/man-graphics-style.en.tm")))
+
+(define bench-warm-runs 5)
+
+(define bench-phases
+  '("typeset style" "typeset exec" "typeset concat"
+    "line breaking" "page breaking"))
+
+(define (bench-line name run pages ms)
+  (display* "typeset," name "," run "," pages "," ms)
+  (for-each (lambda (phase) (display* "," (profile-time phase))) bench-phases)
+  (display* "," (texmacs-peak-memory) "\n")
+  (force-output))
+
+(define (bench-run name run)
+  (profile-reset)
+  (let* ((start (texmacs-time))
+         (pages (typeset-pages))
+         (ms (- (texmacs-time) start)))
+    (bench-line name run pages ms)))
+
+(define (bench-document name file)
+  (with u (url-system file)
+    (load-buffer u :strict)
+    (when (buffer-exists? u)
+      (style-clear-cache)
+      (bench-run name "fresh")
+      (do ((i 1 (+ i 1))) ((> i bench-warm-runs))
+        (bench-run name "warm"))
+      (buffer-close u))))
+
+(display "suite,document,run,pages,total_ms,style_ms,exec_ms,concat_ms,")
+(display "line_ms,page_ms,peak_kb\n")
+(profile-start)
+(for-each (lambda (x) (bench-document (car x) (cadr x))) bench-corpus)
+(profile-stop)
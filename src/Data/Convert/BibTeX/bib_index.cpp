@@ -0,0 +1,278 @@
+
+/******************************************************************************
+* MODULE     : bib_index.cpp
+* DESCRIPTION: indexes of BibTeX files for loading entries on demand
+* COPYRIGHT  : (C) 2020  Joris van der Hoeven
+*******************************************************************************
+* This software falls under the GNU general public license version 3 or later.
+* It comes WITHOUT ANY WARRANTY WHATSOEVER. For details, see the file LICENSE
+* in the root directory or <http://www.gnu.org/licenses/gpl-3.0.html>.
+******************************************************************************/
+
+#include "BibTeX/bib_index.hpp"
+#include "convert.hpp"
+#include "analyze.hpp"
+#include "hashset.hpp"
+#include "file.hpp"
+#include "sys_utils.hpp"
+#include "fast_hash.hpp"
+
+/******************************************************************************
+* Scanning the file
+******************************************************************************/
+
+static inline bool
+bib_index_blank (char c) {
+  return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+template<class S> static int
+bib_index_block_end (S s, int i) {
+  // position after the block which is opened by the brace or parenthesis at i
+  int n= N(s), depth= 1;
+  char open= s[i];
+  for (i++; i<n; i++) {
+    char c= s[i];
+    if (c == '\\') i++;
+    else if (c == '{') depth++;
+    else if (c == '}') {
+      depth--;
+      if (depth == 0) return i+1;
+    }
+    else if (c == ')' && open == '(' && depth == 1) return i+1;
+  }
+  return n;
+}
+
+template<class S> static bib_index
+make_bib_index_bis (S s) {
+  // the keys are delimited as in bib_entry from parsebib.cpp
+  bib_index ix;
+  int i= 0, n= N(s);
+  bool line_start= true;
+  while (i<n) {
+    char c= s[i];
+    if (c == '%' && line_start) {
+      while (i<n && s[i] != '\n') i++;
+      continue;
+    }
+    if (bib_index_blank (c)) {
+      if (c == '\n') line_start= true;
+      i++;
+      continue;
+    }
+    line_start= false;
+    if (c != '@') { i++; continue; }
+    int b= i++;
+    while (i<n && bib_index_blank (s[i])) i++;
+    int ts= i;
+    while (i<n && !bib_index_blank (s[i]) &&
+           s[i] != '{' && s[i] != '(' && s[i] != '=') i++;
+    string type= locase_all (s (ts, i));
+    while (i<n && bib_index_blank (s[i])) i++;
+    if (i>=n || (s[i] != '{' && s[i] != '(')) continue;
+    char close= (s[i] == '{'? '}': ')');
+    int e= bib_index_block_end (s, i);
+    if (type == "string" || type == "preamble") {
+      ix->pro_start << b;
+      ix->pro_end   << e;
+    }
+    else if (type != "comment") {
+      int k= i+1;
+      while (k<e && bib_index_blank (s[k])) k++;
+      int ks= k;
+      while (k<e && s[k] != ',' && s[k] != '\t' && s[k] != '\n' &&
+             s[k] != '\r' && s[k] != close) k++;
+      string key= s (ks, k);
+      if (key != "" && !ix->where->contains (key)) {
+        ix->where (key)= N(ix->keys);
+        ix->keys  << key;
+        ix->start << b;
+        ix->end   << e;
+      }
+    }
+    i= e;
+  }
+  return ix;
+}
+
+bib_index
+make_bib_index (string s) {
+  return make_bib_index_bis (s);
+}
+
+bib_index
+make_bib_index (mapped_string s) {
+  return make_bib_index_bis (s);
+}
+
+/******************************************************************************
+* Extracting the sources of a selection of entries
+******************************************************************************/
+
+template<class S> static string
+bib_index_source_bis (bib_index ix, S s, array<string> keys) {
+  string r;
+  for (int i=0; i<N(ix->pro_start); i++)
+    r << s (ix->pro_start[i], ix->pro_end[i]) << "\n";
+  for (int i=0; i<N(keys); i++) {
+    int k= ix->where[keys[i]];
+    if (k >= 0) r << s (ix->start[k], ix->end[k]) << "\n";
+  }
+  return r;
+}
+
+string
+bib_index_source (bib_index ix, string s, array<string> keys) {
+  return bib_index_source_bis (ix, s, keys);
+}
+
+string
+bib_index_source (bib_index ix, mapped_string s, array<string> keys) {
+  return bib_index_source_bis (ix, s, keys);
+}
+
+/******************************************************************************
+* Saving and loading indexes
+******************************************************************************/
+
+string
+as_string (bib_index ix) {
+  string r= "bib-index 1\n";
+  r << as_string (ix->size) << " " << as_string (ix->stamp) << "\n";
+  for (int i=0; i<N(ix->pro_start); i++)
+    r << "p " << as_string (ix->pro_start[i])
+      << " " << as_string (ix->pro_end[i]) << "\n";
+  for (int i=0; i<N(ix->keys); i++)
+    r << "e " << as_string (ix->start[i])
+      << " " << as_string (ix->end[i]) << " " << ix->keys[i] << "\n";
+  return r;
+}
+
+bib_index
+as_bib_index (string s) {
+  // returns an index with a negative size if s is not a valid index
+  bib_index ix, err;
+  err->size= -1;
+  int i= 0, n= N(s), a, b;
+  if (!read (s, i, "bib-index 1\n")) return err;
+  if (!read_int (s, i, ix->size) || !read (s, i, " ") ||
+      !read_int (s, i, ix->stamp) || !read (s, i, "\n")) return err;
+  while (i<n) {
+    if (i+1 >= n || s[i+1] != ' ') return err;
+    char kind= s[i];
+    i += 2;
+    if (!read_int (s, i, a) || !read (s, i, " ") || !read_int (s, i, b))
+      return err;
+    if (kind == 'p') {
+      if (!read (s, i, "\n")) return err;
+      ix->pro_start << a;
+      ix->pro_end   << b;
+    }
+    else if (kind == 'e') {
+      if (!read (s, i, " ")) return err;
+      int ks= i;
+      while (i<n && s[i] != '\n') i++;
+      if (i >= n) return err;
+      string key= s (ks, i++);
+      ix->where (key)= N(ix->keys);
+      ix->keys  << key;
+      ix->start << a;
+      ix->end   << b;
+    }
+    else return err;
+  }
+  return ix;
+}
+
+static url
+bib_index_file (url u) {
+  // the index is named after a digest of the file name
+  string digest= fast_hash_key (as_string (u));
+  return get_texmacs_home_path () * url ("system/cache/bib") *
+         url (digest * ".idx");
+}
+
+static hashmap<string,bib_index> bib_indexes= hashmap<string,bib_index> ();
+
+bib_index
+load_bib_index (url u) {
+  // the index is rebuilt whenever the size or the date of the file changes
+  string name= as_string (u);
+  int size = file_size (u);
+  int stamp= last_modified (u, false);
+  if (bib_indexes->contains (name)) {
+    bib_index ix= bib_indexes [name];
+    if (ix->size == size && ix->stamp == stamp) return ix;
+  }
+  url cached= bib_index_file (u);
+  string cs;
+  if (!load_string (cached, cs, false)) {
+    bib_index ix= as_bib_index (cs);
+    if (ix->size == size && ix->stamp == stamp) {
+      bib_indexes (name)= ix;
+      return ix;
+    }
+  }
+  mapped_string s;
+  if (load_mapped (u, s, false)) return bib_index ();
+  bib_index ix= make_bib_index (s);
+  ix->size = size;
+  ix->stamp= stamp;
+  mkdir (head (cached));
+  save_string (cached, as_string (ix), false);
+  bib_indexes (name)= ix;
+  return ix;
+}
+
+/******************************************************************************
+* Parsing entries on demand
+******************************************************************************/
+
+array<string>
+bib_entry_keys (url u) {
+  return load_bib_index (u)->keys;
+}
+
+static string
+bib_crossref (tree entry) {
+  tree fields= entry[2];
+  for (int i=0; i<N(fields); i++)
+    if (is_compound (fields[i], "bib-field", 2) &&
+        fields[i][0] == "crossref" && is_atomic (fields[i][1]))
+      return fields[i][1]->label;
+  return "";
+}
+
+tree
+parse_bib_entries (url u, array<string> keys) {
+  // only the requested entries, the entries they refer to through crossref
+  // fields, and the declarations of the file are parsed
+  tree r (DOCUMENT);
+  bib_index ix= load_bib_index (u);
+  mapped_string s;
+  if (load_mapped (u, s, false)) return r;
+  hashset<string> done;
+  bool first= true;
+  while (N(keys) != 0) {
+    array<string> sel;
+    for (int i=0; i<N(keys); i++)
+      if (!done->contains (keys[i]) && ix->where->contains (keys[i])) {
+        done->insert (keys[i]);
+        sel << keys[i];
+      }
+    if (N(sel) == 0) break;
+    tree t= parse_bib (bib_index_source (ix, s, sel));
+    keys= array<string> ();
+    if (!is_document (t)) break;
+    for (int i=0; i<N(t); i++)
+      if (is_compound (t[i], "bib-entry", 3)) {
+        r << t[i];
+        string cr= bib_crossref (t[i]);
+        if (cr != "") keys << cr;
+      }
+      else if (first) r << t[i];
+    first= false;
+  }
+  return r;
+}
@@ -0,0 +1,54 @@
+
+/******************************************************************************
+* MODULE     : bib_index.hpp
+* DESCRIPTION: indexes of BibTeX files for loading entries on demand
+* COPYRIGHT  : (C) 2020  Joris van der Hoeven
+*******************************************************************************
+* This software falls under the GNU general public license version 3 or later.
+* It comes WITHOUT ANY WARRANTY WHATSOEVER. For details, see the file LICENSE
+* in the root directory or <http://www.gnu.org/licenses/gpl-3.0.html>.
+******************************************************************************/
+
+#ifndef BIB_INDEX_H
+#define BIB_INDEX_H
+#include "url.hpp"
+#include "hashmap.hpp"
+#include "mapped_string.hpp"
+
+/******************************************************************************
+* An index records the byte ranges of the entries of a BibTeX file by key,
+* together with the ranges of the @string and @preamble declarations.
+* It is obtained by a quick scan of the file, which does not parse any of
+* the fields, and it is kept on disk for as long as the file is unchanged.
+******************************************************************************/
+
+class bib_index;
+struct bib_index_rep: concrete_struct {
+  int                 size;       // size of the indexed file
+  int                 stamp;      // modification time of the indexed file
+  array<int>          pro_start;  // ranges of the declarations
+  array<int>          pro_end;
+  array<string>       keys;       // keys of the entries, in order
+  array<int>          start;      // ranges of the entries
+  array<int>          end;
+  hashmap<string,int> where;      // position of each key in the above arrays
+
+  inline bib_index_rep (): size (0), stamp (0), where (-1) {}
+};
+
+class bib_index {
+  CONCRETE(bib_index);
+  inline bib_index (): rep (tm_new<bib_index_rep> ()) {}
+};
+CONCRETE_CODE(bib_index);
+
+bib_index make_bib_index (string s);
+bib_index make_bib_index (mapped_string s);
+string    as_string (bib_index ix);
+bib_index as_bib_index (string s);
+string    bib_index_source (bib_index ix, string s, array<string> keys);
+string    bib_index_source (bib_index ix, mapped_string s, array<string> keys);
+
+bib_index load_bib_index (url u);
+
+#endif // defined BIB_INDEX_H
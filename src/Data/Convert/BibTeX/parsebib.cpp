@@ -15,6 +15,7 @@
 #include "list.hpp"
 #include "tree_traverse.hpp"
 #include "Bibtex/bibtex_functions.hpp"
+#include "mapped_string.hpp"
 
 static string bib_current_tag= "";
 
@@ -25,8 +26,8 @@ bibtex_non_empty_comment (string s) {
   return false;
 }
 
-bool
-bib_ok (string s, int pos) {
+template<class S> static bool
+bib_ok (S s, int pos) {
   return 0 <= pos && pos < N(s);
 }
 
@@ -38,8 +39,8 @@ bib_error () {
     convert_error << "BibTeX parse error in " << bib_current_tag << "\n";
 }
 
-int
-bib_char (string s, int& pos, char c) {
+template<class S> static int
+bib_char (S s, int& pos, char c) {
   if (!bib_ok (s, pos)) return -1;
   if (s[pos] == c) pos++;
   else {
@@ -51,8 +52,8 @@ bib_char (string s, int& pos, char c) {
   return 0;
 }
 
-bool
-bib_open (string s, int& pos, char& cend) {
+template<class S> static bool
+bib_open (S s, int& pos, char& cend) {
   switch (s[pos]) {
   case '{': cend= '}'; return false;
   case '(': cend= ')'; return false;
@@ -72,15 +73,15 @@ bib_is_in (char c, string cs) {
   return i != N(cs);
 }
 
-void
-bib_blank (string s, int& pos) {
+template<class S> static void
+bib_blank (S s, int& pos) {
   if (!bib_ok (s, pos)) return;
   string cs= " \t\n\r";
   while (bib_ok (s, pos) && bib_is_in (s[pos], cs)) pos++;
 }
 
-void
-bib_within (string s, int& pos, char cbegin, char cend, string& content) {
+template<class S> static void
+bib_within (S s, int& pos, char cbegin, char cend, string& content) {
   if (!bib_ok (s, pos)) return;
   int depth= 0;
   if (bib_char (s, pos, cbegin))
@@ -100,8 +101,8 @@ bib_within (string s, int& pos, char cbegin, char cend, string& content) {
   bib_char (s, pos, cend);
 }
 
-void
-bib_until (string s, int& pos, string cs, string& content) {
+template<class S> static void
+bib_until (S s, int& pos, string cs, string& content) {
   if (!bib_ok (s, pos)) return;
   while (bib_ok (s, pos) && !bib_is_in (s[pos], cs)) {
     content << s[pos];
@@ -109,8 +110,8 @@ bib_until (string s, int& pos, string cs, string& content) {
   }
 }
 
-void
-bib_comment (string s, int& pos, tree& t) {
+template<class S> static void
+bib_comment (S s, int& pos, tree& t) {
   if (!bib_ok (s, pos)) return;
   string content;
   while (bib_ok (s, pos) && s[pos] == '%') {
@@ -125,7 +126,8 @@ bib_comment (string s, int& pos, tree& t) {
   }
 }
 
-void bib_atomic_arg (string s, int& pos, string ce, tree& a) {
+template<class S> static void
+bib_atomic_arg (S s, int& pos, string ce, tree& a) {
   if (!bib_ok (s, pos)) return;
   string sa;
   string f, v, j, l;
@@ -156,8 +158,8 @@ void bib_atomic_arg (string s, int& pos, string ce, tree& a) {
   }
 }
 
-void
-bib_arg (string s, int& pos, string ce, tree& arg) {
+template<class S> static void
+bib_arg (S s, int& pos, string ce, tree& arg) {
   if (!bib_ok (s, pos)) return;
   string cs= ",";
   cs << ce;
@@ -196,8 +198,8 @@ normalize_newlines (tree t) {
   }
 }
 
-void
-bib_fields (string s, int& pos, string ce, string tag, tree& fields) {
+template<class S> static void
+bib_fields (S s, int& pos, string ce, string tag, tree& fields) {
   if (!bib_ok (s, pos)) return;
   int savpos;
   bib_blank (s, pos);
@@ -234,8 +236,8 @@ bib_fields (string s, int& pos, string ce, string tag, tree& fields) {
   }
 }
 
-void
-bib_string (string s, int& pos, tree& t) {
+template<class S> static void
+bib_string (S s, int& pos, tree& t) {
   if (!bib_ok (s, pos)) return;
   tree fields= tree (DOCUMENT);
   string cs= ", \t\n\r";
@@ -252,8 +254,8 @@ bib_string (string s, int& pos, tree& t) {
   t << A (fields);
 }
 
-void
-bib_preamble (string s, int& pos, tree& t) {
+template<class S> static void
+bib_preamble (S s, int& pos, tree& t) {
   if (!bib_ok (s, pos)) return;
   string cs= ",";
   char cend;
@@ -281,8 +283,8 @@ bib_preamble (string s, int& pos, tree& t) {
   bib_char (s, pos, cend);
 }
 
-void
-bib_entry (string s, int& pos, tree type, tree& t) {
+template<class S> static void
+bib_entry (S s, int& pos, tree type, tree& t) {
   if (!bib_ok (s, pos)) return;
   tree entry;
   tree fields= tree (DOCUMENT);
@@ -306,8 +308,8 @@ bib_entry (string s, int& pos, tree type, tree& t) {
   t << entry;
 }
 
-void
-bib_list (string s, int& pos, tree& t) {
+template<class S> static void
+bib_list (S s, int& pos, tree& t) {
   if (!bib_ok (s, pos)) return;
   tree tentry (DOCUMENT);
   tree tpreamble (DOCUMENT);
@@ -412,8 +414,8 @@ bib_list (string s, int& pos, tree& t) {
   bib_parse_fields (t);
 }
 
-tree
-parse_bib (string s) {
+template<class S> static tree
+parse_bib_bis (S s) {
   int pos= 0;
   tree r (DOCUMENT);
   bib_current_tag= "";
@@ -425,3 +427,13 @@ parse_bib (string s) {
   }
   return r;
 }
+
+tree
+parse_bib (string s) {
+  return parse_bib_bis (s);
+}
+
+tree
+parse_bib (mapped_string s) {
+  return parse_bib_bis (s);
+}
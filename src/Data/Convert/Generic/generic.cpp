@@ -12,6 +12,7 @@
 #include "convert.hpp"
 #include "file.hpp"
 #include "scheme.hpp"
+#include "lru_cache.hpp"
 
 static url current_file_focus= url_none ();
 
@@ -50,12 +51,63 @@ get_format (string s, string suffix) {
   return as_string (call ("format-determine", s, suffix));
 }
 
+/******************************************************************************
+* Caching the conversions of snippets
+*******************************************************************************
+* The same snippets tend to be converted repeatedly during interactive work,
+* for instance when copying and pasting or for the outputs of plug-ins.
+* The recent conversions are cached by format, file focus and contents.
+* Documents are not cached, since their conversions read and write files.
+* The caches are cleared whenever a preference changes, because most
+* converters can be configured by preferences.
+******************************************************************************/
+
+#define CONVERSION_CACHE_BUDGET (4L << 20)
+
+static lru_cache<string,tree>
+  to_tree_cache (tree (UNINIT), CONVERSION_CACHE_BUDGET);
+static lru_cache<tree,string>
+  to_generic_cache ("", CONVERSION_CACHE_BUDGET);
+
+static bool
+is_cached_format (string fm) {
+  return ends (fm, "-snippet");
+}
+
+void
+reset_conversion_caches () {
+  to_tree_cache->clear ();
+  to_generic_cache->clear ();
+}
+
+void
+print_conversion_statistics () {
+  std_bench << "Conversions to TeXmacs: " << to_tree_cache << "\n";
+  std_bench << "Conversions from TeXmacs: " << to_generic_cache << "\n";
+}
+
 tree
 generic_to_tree (string s, string fm) {
-  return as_tree (call ("generic->texmacs", s, fm));
+  if (!is_cached_format (fm))
+    return as_tree (call ("generic->texmacs", s, fm));
+  string key= fm * "\n" * as_string (current_file_focus) * "\n" * s;
+  tree r= to_tree_cache [key];
+  // the trees are copied, since callers may modify them in place
+  if (!is_func (r, UNINIT)) return copy (r);
+  r= as_tree (call ("generic->texmacs", s, fm));
+  to_tree_cache->set (key, copy (r), 3 * N(key) + 64);
+  return r;
 }
 
 string
 tree_to_generic (tree doc, string fm) {
-  return as_string (call ("texmacs->generic", doc, fm));
+  if (!is_cached_format (fm))
+    return as_string (call ("texmacs->generic", doc, fm));
+  tree key= tuple (fm, as_string (current_file_focus), doc);
+  string r= to_generic_cache [key];
+  if (r != "" || to_generic_cache->contains (key)) return r;
+  r= as_string (call ("texmacs->generic", doc, fm));
+  key[2]= copy (doc);
+  to_generic_cache->set (key, r, 3 * N(r) + 64);
+  return r;
 }
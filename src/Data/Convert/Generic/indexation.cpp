@@ -157,8 +157,10 @@ compute_keys (url u) {
   load_string (u, s, false);
   string fm= get_format (s, suffix (u));
   if (fm != "texmacs") return compute_keys (s, fm);
-  tree t= texmacs_document_to_tree (s);
-  return compute_keys (t, fm);
+  tree t= texmacs_document_to_tree (s, true);
+  array<string> r= compute_keys (t, fm);
+  clear_shared_atoms ();
+  return r;
 }
 
 scheme_tree
@@ -167,6 +169,8 @@ compute_index (url u) {
   load_string (u, s, false);
   string fm= get_format (s, suffix (u));
   if (fm != "texmacs") return compute_index (s, fm);
-  tree t= texmacs_document_to_tree (s);
-  return compute_index (t, fm);
+  tree t= texmacs_document_to_tree (s, true);
+  scheme_tree r= compute_index (t, fm);
+  clear_shared_atoms ();
+  return r;
 }
@@ -22,6 +22,7 @@
 #define STATUS_NORMAL 0
 #define STATUS_ESCAPE 1
 #define STATUS_BEGIN  2
+#define STATUS_RAW    3
 
 #define MODE_VERBATIM 0
 #define MODE_SCHEME   1
@@ -47,6 +48,7 @@ texmacs_input_rep::texmacs_input_rep (string type2):
   channel (type),
   stack (""),
   ignore_verb (false),
+  raw_left (0),
   docs (tree (DOCUMENT, "")) { bof (); }
 
 texmacs_input::texmacs_input (string type):
@@ -135,9 +137,16 @@ texmacs_input_rep::put (char c) { // returns true when expecting input
     break;
   case STATUS_BEGIN:
     if (c == ':') {
+      // DATA_BEGIN format=size: starts a block whose size bytes are
+      // taken literally, without escapes
+      int k= search_backwards ("=", buf);
+      if (k > 0 && is_int (buf (k+1, N(buf)))) {
+        raw_left= max (as_int (buf (k+1, N(buf))), 0);
+        buf= buf (0, k);
+      }
       begin_mode (buf);
       buf   = "";
-      status= STATUS_NORMAL;
+      status= (raw_left > 0? STATUS_RAW: STATUS_NORMAL);
     }
     else if (c == '#') {
       begin_channel (buf);
@@ -146,11 +155,34 @@ texmacs_input_rep::put (char c) { // returns true when expecting input
     }
     else buf << c;
     break;
+  case STATUS_RAW:
+    buf << c;
+    if (--raw_left == 0) status= STATUS_NORMAL;
+    break;
   }
   if (status == STATUS_NORMAL) flush ();
   return block_done;
 }
 
+bool
+texmacs_input_rep::put (string s, int& i) {
+  // consume the input starting at position i of s and return true
+  // when expecting input; the contents of sized blocks are copied at once
+  if (status == STATUS_RAW) {
+    int k= min (raw_left, N(s) - i);
+    if (buf == "" && i == 0 && k == N(s)) buf= s;
+    else buf << s (i, i+k);
+    i += k;
+    raw_left -= k;
+    if (raw_left == 0) {
+      status= STATUS_NORMAL;
+      flush ();
+    }
+    return false;
+  }
+  return put (s[i++]);
+}
+
 void
 texmacs_input_rep::bof () {
   format = "verbatim";
@@ -23,6 +23,7 @@ struct texmacs_input_rep: concrete_struct {
   string channel;               // current output channel
   tree   stack;                 // stack for nested blocks
   bool   ignore_verb;           // hack to enable completion with some plugins
+  int    raw_left;              // remaining size of a sized block
   hashmap<string,tree> docs;    // output for each channel
 
   texmacs_input_rep (string type);
@@ -31,6 +32,7 @@ struct texmacs_input_rep: concrete_struct {
   void begin_channel (string s);
   void end ();
   bool put (char c);
+  bool put (string s, int& i);
   void bof ();
   void eof ();
   void write (tree t);
@@ -58,13 +58,15 @@ slash (string s) {
 * Converting scheme trees to strings
 ******************************************************************************/
 
+static void
+scheme_atom_to_string (string& out, string s) {
+  if (is_quoted (s)) out << scm_quote (raw_unquote (s));
+  else out << slash (s);
+}
+
 static void
 scheme_tree_to_string (string& out, scheme_tree p) {
-  if (!is_tuple (p)) {
-    string s= p->label;
-    if (is_quoted (s)) out << scm_quote (raw_unquote (s));
-    else out << slash (s);
-  }
+  if (!is_tuple (p)) scheme_atom_to_string (out, p->label);
   else {
     if (is_tuple (p, "\'", 1)) {
       out << "\'";
@@ -130,7 +132,49 @@ tree_to_scheme_tree (tree t) {
 * Conversion of trees to scheme strings
 ******************************************************************************/
 
+void
+tree_to_scheme (string& out, tree t) {
+  // same as scheme_tree_to_string (tree_to_scheme_tree (t)),
+  // but without building the intermediate scheme tree
+  if (is_atomic (t)) {
+    // the label is quoted by tree_to_scheme_tree and once more on output
+    string s= t->label;
+    int i, n= N(s);
+    out << '\"';
+    for (i=0; i<n; i++)
+      if (s[i] == '\"' || s[i] == '\\') out << "\\\\\\" << s[i];
+      else out << s[i];
+    out << '\"';
+    return;
+  }
+  int i, start= 0, n= N(t);
+  string s;
+  if (is_func (t, EXPAND) && is_atomic (t[0])) {
+    s= t[0]->label;
+    start= 1;
+  }
+  else {
+    s= as_string (L(t));
+    if (N(s) > 0 && is_digit (s[0]))
+      if (is_int (s)) s= "'" * s;
+  }
+  if (n - start == 1 && s == "\'") {
+    out << "\'";
+    tree_to_scheme (out, t[start]);
+    return;
+  }
+  out << "(";
+  scheme_atom_to_string (out, s);
+  for (i=start; i<n; i++) {
+    out << " ";
+    tree_to_scheme (out, t[i]);
+  }
+  out << ")";
+}
+
 string
 tree_to_scheme (tree t) {
-  return scheme_tree_to_string (tree_to_scheme_tree (t));
+  string out;
+  tree_to_scheme (out, t);
+  return out;
 }
@@ -72,20 +72,17 @@ get_range (tree id, int& b, int& e, string src) {
 
 int
 common_len (tree id, tree p, int c, int delta,
-            hashmap<tree,tree> corr,
+            hashmap<tree,tree> content,
             hashmap<tree,tree> next) {
+  // NOTE: content maps the identifiers to their subtrees, so that we
+  // need not search through all identifiers of common subtrees
   int len= 0;
   while (true) {
     c += delta;
     if (c < 0 || c >= N(p)) break;
-    if (!corr->contains (p[c])) break;
-    tree next_ids= corr[p[c]];
     if (!next->contains (id)) break;
     tree next_id= next[id];
-    bool found= false;
-    for (int k=0; k<N(next_ids); k++)
-      found= found || (next_ids[k] == next_id);
-    if (!found) break;
+    if (!content->contains (next_id) || content[next_id] != p[c]) break;
     len++;
   }
   return len;
@@ -93,14 +90,14 @@ common_len (tree id, tree p, int c, int delta,
 
 tree
 texmacs_best_match (tree ids, tree p, int c,
-                    hashmap<tree,tree> corr,
+                    hashmap<tree,tree> content,
                     hashmap<tree,tree> pred,
                     hashmap<tree,tree> succ) {
   if (N(ids) == 1) return ids[0];
   int best= -1, best_len= -1;
   for (int i=0; i<N(ids); i++) {
-    int plen= common_len (ids[i], p, c, -1, corr, pred);
-    int slen= common_len (ids[i], p, c,  1, corr, succ);
+    int plen= common_len (ids[i], p, c, -1, content, pred);
+    int slen= common_len (ids[i], p, c,  1, content, succ);
     int len = plen + slen;
     if (len > best_len) {
       best= i;
@@ -116,27 +113,21 @@ texmacs_best_match (tree ids, tree p, int c,
 }
 
 tree
-texmacs_invarianted (tree t, tree p, int c, string src,
+texmacs_invarianted (tree t, tree p, int c,
                      hashmap<tree,tree> corr,
+                     hashmap<tree,tree> content,
                      hashmap<tree,tree> pred,
                      hashmap<tree,tree> succ) {
   if (corr->contains (t)) {
-    tree oids= corr[t], ids (TUPLE);
-    for (int i=0; i<N(oids); i++) {
-      int b, e;
-      if (get_range (oids[i], b, e, src)) ids << oids[i];
-    }
-    if (N(ids) >= 1) {
-      tree id= texmacs_best_match (ids, p, c, corr, pred, succ);
-      if (id != tree (UNINIT)) return compound ("ilx", id);
-    }
+    tree id= texmacs_best_match (corr[t], p, c, content, pred, succ);
+    if (id != tree (UNINIT)) return compound ("ilx", id);
   }
   if (is_atomic (t)) return t;
   else {
     int i, n= N(t);
     tree r (t, n);
     for (i=0; i<n; i++)
-      r[i]= texmacs_invarianted (t[i], t, i, src, corr, pred, succ);
+      r[i]= texmacs_invarianted (t[i], t, i, corr, content, pred, succ);
     return r;
   }
 }
@@ -295,8 +286,22 @@ texmacs_invarianted (tree t, tree oldt, string src) {
   hashmap<tree,tree> succ (UNINIT);
   tree uoldbody= texmacs_correspondence (oldbody, corr);
   texmacs_neighbours (oldbody, pred, succ);
+  // only keep the identifiers with valid source ranges,
+  // once and for all instead of for every subtree
+  hashmap<tree,tree> vcorr (UNINIT);
+  hashmap<tree,tree> content (UNINIT);
+  iterator<tree> it= iterate (corr);
+  while (it->busy ()) {
+    tree r= it->next (), oids= corr[r], ids (TUPLE);
+    for (int i=0; i<N(oids); i++) {
+      int b, e;
+      content (oids[i])= r;
+      if (get_range (oids[i], b, e, src)) ids << oids[i];
+    }
+    if (N(ids) > 0) vcorr (r)= ids;
+  }
   tree body= orgbody;
-  body= texmacs_invarianted (body, UNINIT, -1, src, corr, pred, succ);
+  body= texmacs_invarianted (body, UNINIT, -1, vcorr, content, pred, succ);
   hashmap<tree,path> h (path (-1));
   //cout << "body" << LF << HRULE << body << LF << HRULE;
   //cout << "orgbody" << LF << HRULE << orgbody << LF << HRULE;
@@ -17,6 +17,7 @@
 #include "vars.hpp"
 #include "tree_correct.hpp"
 #include "url.hpp"
+#include "tm_timer.hpp"
 
 tree upgrade_tex (tree t);
 extern bool textm_class_flag;
@@ -1676,8 +1677,9 @@ finalize_misc (tree t) {
     int i, n= N(t);
     string l= as_string (L(t));
     // Restore name of users envs, munged in finalize_layout.
-    if (latex_type ("\\begin-"*l) == "user" && latex_arity ("\\begin-"*l) < 0
-        && N(t) == abs (latex_arity ("\\begin-"*l))+1) {
+    string env= "\\begin-" * l;
+    if (latex_type (env) == "user" && latex_arity (env) < 0
+        && N(t) == abs (latex_arity (env))+1) {
       tree r= compound (l*"*");
       for (int i=0; i<n; i++)
         r << finalize_misc (t[i]);
@@ -1860,13 +1862,15 @@ eat_space_around_control (tree t) {
 
 static tree
 downgrade_newlines (tree t) {
+  // geometry was extracted by filter_geometry and is removed in the same pass
   if (is_atomic (t)) return t;
-  tree r (L(t), N(t));
+  tree r (L(t));
   for (int i=0; i<N(t); i++) {
-    r[i]= downgrade_newlines (t[i]);
-    if (i>0 && is_compound (t[i-1], "!emptyline"))
-      if (is_func (t[i], NEW_LINE, 0))
-        r[i]= " ";
+    if (is_compound (t[i], "geometry")) continue;
+    if (i>0 && is_compound (t[i-1], "!emptyline") &&
+        is_func (t[i], NEW_LINE, 0))
+      r << tree (" ");
+    else r << downgrade_newlines (t[i]);
   }
   return r;
 }
@@ -2104,19 +2108,6 @@ unnest_withs (tree t) {
   return r;
 }
 
-/****************************** Remove geometry ******************************/
-
-static tree
-remove_geometry (tree t) {
-  if (is_atomic (t)) return t;
-  int i, n= N(t);
-  tree r(L(t));
-  for (i=0; i<n; i++)
-    if (!is_compound (t[i], "geometry"))
-      r << remove_geometry (t[i]);
-  return r;
-}
-
 /************************** Clean vertical spacing ***************************/
 
 static bool
@@ -2193,24 +2184,49 @@ clean_vspace (tree t) {
   }
 }
 
+/******************************************************************************
+* Timing of the conversion passes
+******************************************************************************/
+
+static tree
+latex_pass (string name, tree (*pass) (tree), tree t) {
+  // each pass rewrites the whole tree; profile it as "latex <name>"
+  profile_scope scope (profile_counter ("latex " * name));
+  return pass (t);
+}
+
+static tree
+latex_drd_correct (tree t) {
+  return drd_correct (std_drd, t);
+}
+
 /****************************** Finalize textm *******************************/
 
+static tree
+modernize_all_newlines (tree t) {
+  return modernize_newlines (t, false);
+}
+
+static tree
+merge_withs (tree t) {
+  return merge_successive_withs (t);
+}
+
 tree
 finalize_textm (tree t) {
-  t= downgrade_newlines (t);
-  t= remove_geometry (t);
-  t= modernize_newlines (t, false);
-  t= merge_successive_withs (t);
-  t= unnest_withs (t);
-  t= remove_empty_withs (t);
-  t= nonumber_to_eqnumber (t);
-  t= eat_space_around_control (t);
-  t= remove_superfluous_newlines (t);
-  t= concat_document_correct (t);
-  t= remove_labels_from_sections (t);
-  t= concat_sections_and_labels (t);
-  t= clean_vspace (t);
-  return simplify_correct (t);
+  t= latex_pass ("downgrade newlines", downgrade_newlines, t);
+  t= latex_pass ("modernize newlines", modernize_all_newlines, t);
+  t= latex_pass ("merge withs", merge_withs, t);
+  t= latex_pass ("unnest withs", unnest_withs, t);
+  t= latex_pass ("remove empty withs", remove_empty_withs, t);
+  t= latex_pass ("eqnumbers", nonumber_to_eqnumber, t);
+  t= latex_pass ("space around control", eat_space_around_control, t);
+  t= latex_pass ("superfluous newlines", remove_superfluous_newlines, t);
+  t= latex_pass ("concat document", concat_document_correct, t);
+  t= latex_pass ("section labels", remove_labels_from_sections, t);
+  t= latex_pass ("concat sections", concat_sections_and_labels, t);
+  t= latex_pass ("vertical spacing", clean_vspace, t);
+  return latex_pass ("simplify", simplify_correct, t);
 }
 
 /******************************************************************************
@@ -2311,7 +2327,8 @@ guess_missing (tree t) {
 tree
 latex_to_tree (tree t0) {
   // cout << "\n\nt0= " << t0 << "\n\n";
-  tree t1= kill_space_invaders (t0);
+  profile_scope scope (profile_counter ("latex to tree"));
+  tree t1= latex_pass ("space invaders", kill_space_invaders, t0);
   string style, lan= "";
   bool is_document= is_compound (t1, "!file", 1);
   if (is_document) t1= t1[0];
@@ -2326,22 +2343,22 @@ latex_to_tree (tree t0) {
   textm_natbib    = false;
   command_type ("!em") = "false";
   // cout << "\n\nt1= " << t1 << "\n\n";
-  tree t2= is_document? filter_preamble (t1): t1;
+  tree t2= is_document? latex_pass ("preamble", filter_preamble, t1): t1;
   // cout << "\n\nt2= " << t2 << "\n\n";
-  tree t3= parsed_latex_to_tree (t2);
+  tree t3= latex_pass ("parsed to tree", parsed_latex_to_tree, t2);
   // cout << "\n\nt3= " << t3 << "\n\n";
-  tree t4= finalize_document (t3);
+  tree t4= latex_pass ("finalize document", finalize_document, t3);
   // cout << "\n\nt4= " << t4 << "\n\n";
   tree t5= is_document? finalize_preamble (t4, style): t4;
   // cout << "\n\nt5= " << t5 << "\n\n";
-  tree t6= handle_matches (t5);
+  tree t6= latex_pass ("matches", handle_matches, t5);
   // cout << "\n\nt6= " << t6 << "\n\n";
   if ((!is_document) && is_func (t6, DOCUMENT, 1)) t6= t6[0];
-  tree t7= upgrade_tex (t6);
+  tree t7= latex_pass ("upgrade", upgrade_tex, t6);
   // cout << "\n\nt7= " << t7 << "\n\n";
-  tree t8= finalize_floats (t7);
+  tree t8= latex_pass ("floats", finalize_floats, t7);
   // cout << "\n\nt8= " << t8 << "\n\n";
-  tree t9= finalize_misc (t8);
+  tree t9= latex_pass ("misc", finalize_misc, t8);
   // cout << "\n\nt9= " << t9 << "\n\n";
 
   tree initial (COLLECTION), mods (WITH);
@@ -2350,9 +2367,9 @@ latex_to_tree (tree t0) {
     initial << filter_geometry (t9);
   }
 
-  tree t10= finalize_textm (t9);
+  tree t10= latex_pass ("finalize textm", finalize_textm, t9);
   // cout << "\n\nt10= " << t10 << "\n\n";
-  tree t11= drd_correct (std_drd, t10);
+  tree t11= latex_pass ("drd correct", latex_drd_correct, t10);
   // cout << "\n\nt11= " << t11 << "\n\n";
 
   if (!exists (url ("$TEXMACS_STYLE_PATH", style * ".ts")))
@@ -2376,14 +2393,14 @@ latex_to_tree (tree t0) {
   }
 
   tree t12= t11;
-  if (is_document) t12= simplify_correct (t11);
+  if (is_document) t12= latex_pass ("simplify", simplify_correct, t11);
   else if (N (mods) > 0) { t12= mods; t12 << t11; }
   // cout << "\n\nt12= " << t12 << "\n\n";
-  tree t13= latex_correct (t12);
+  tree t13= latex_pass ("latex correct", latex_correct, t12);
   // cout << "\n\nt13= " << t13 << "\n\n";
-  tree t14= guess_missing (t13);
+  tree t14= latex_pass ("guess missing", guess_missing, t13);
   // cout << "\n\nt14= " << t14 << "\n\n";
-  tree t15= postprocess_metadata (t14);
+  tree t15= latex_pass ("metadata", postprocess_metadata, t14);
   // cout << "\n\nt15= " << t15 << "\n\n";
   
   if (is_document) {
@@ -0,0 +1,106 @@
+
+/******************************************************************************
+* MODULE     : latex_tokens.cpp
+* DESCRIPTION: tokenization of the control sequences in LaTeX sources
+* COPYRIGHT  : (C) 2020  Joris van der Hoeven
+*******************************************************************************
+* This software falls under the GNU general public license version 3 or later.
+* It comes WITHOUT ANY WARRANTY WHATSOEVER. For details, see the file LICENSE
+* in the root directory or <http://www.gnu.org/licenses/gpl-3.0.html>.
+******************************************************************************/
+
+#include "Tex/latex_tokens.hpp"
+#include "hashmap.hpp"
+#include "analyze.hpp"
+#include <string.h>
+
+/******************************************************************************
+* Interned command names
+******************************************************************************/
+
+static hashmap<string,int> command_ids (-1);
+static array<string> command_names;
+
+int
+latex_command_id (string name) {
+  int id= command_ids [name];
+  if (id >= 0) return id;
+  id= N(command_names);
+  command_names << name;
+  command_ids (name)= id;
+  return id;
+}
+
+string
+latex_command_name (int id) {
+  return command_names[id];
+}
+
+int
+latex_command_end (string s, int i) {
+  // end of the control sequence which starts with the backslash at i
+  int n= N(s);
+  i++;
+  if (i < n && (is_alpha (s[i]) || s[i] == '@'))
+    while (i < n && (is_alpha (s[i]) || s[i] == '@')) i++;
+  else if (i < n) i++;
+  return i;
+}
+
+/******************************************************************************
+* Tokenization
+******************************************************************************/
+
+void
+latex_tokens::tokenize (string s2) {
+  s= s2;
+  start= array<int> ();
+  end  = array<int> ();
+  id   = array<int> ();
+  cur  = 0;
+  int i= 0, n= N(s);
+  const char* a= n == 0? (const char*) NULL: &s[0];
+  while (i < n) {
+    const char* p= (const char*) memchr (a + i, '\\', n - i);
+    if (p == NULL) break;
+    i= (int) (p - a);
+    int e= latex_command_end (s, i);
+    start << i;
+    end   << e;
+    id    << latex_command_id (s (i, e));
+    i= e;
+  }
+}
+
+bool
+latex_tokens::contains (string s2) {
+  // the tokens can only be used for the tokenized string itself
+  return s2.operator -> () == s.operator -> ();
+}
+
+int
+latex_tokens::find (int i) {
+  // index of the token starting at i, or -1
+  int k= N(start);
+  if (cur < k && start[cur] < i) cur++;
+  if (cur < k && start[cur] == i) return cur;
+  int lo= 0, hi= k;
+  while (lo < hi) {
+    int mid= (lo + hi) >> 1;
+    if (start[mid] < i) lo= mid + 1;
+    else hi= mid;
+  }
+  if (lo < k && start[lo] == i) { cur= lo; return lo; }
+  return -1;
+}
+
+int
+latex_tokens::command_at (string s2, int i, int& e) {
+  // id and end of the control sequence at i; other strings are scanned
+  if (contains (s2)) {
+    int k= find (i);
+    if (k >= 0) { e= end[k]; return id[k]; }
+  }
+  e= latex_command_end (s2, i);
+  return latex_command_id (s2 (i, e));
+}
@@ -0,0 +1,46 @@
+
+/******************************************************************************
+* MODULE     : latex_tokens.hpp
+* DESCRIPTION: tokenization of the control sequences in LaTeX sources
+* COPYRIGHT  : (C) 2020  Joris van der Hoeven
+*******************************************************************************
+* This software falls under the GNU general public license version 3 or later.
+* It comes WITHOUT ANY WARRANTY WHATSOEVER. For details, see the file LICENSE
+* in the root directory or <http://www.gnu.org/licenses/gpl-3.0.html>.
+******************************************************************************/
+
+#ifndef LATEX_TOKENS_H
+#define LATEX_TOKENS_H
+#include "string.hpp"
+#include "array.hpp"
+
+/******************************************************************************
+* Control sequences are either a backslash followed by a maximal sequence
+* of letters (and @), or a backslash followed by any other character.
+* Their names are interned, so that each command is represented by an
+* integer id and a shared string.
+******************************************************************************/
+
+int    latex_command_id   (string name);
+string latex_command_name (int id);
+int    latex_command_end  (string s, int i);
+
+/******************************************************************************
+* The tokens of a source string, computed in a single pass
+******************************************************************************/
+
+struct latex_tokens {
+  string     s;        // the tokenized string
+  array<int> start;    // positions of the backslashes
+  array<int> end;      // ends of the corresponding control sequences
+  array<int> id;       // interned names of the control sequences
+  int        cur;      // cursor for forward lookups
+
+  inline latex_tokens (): cur (0) {}
+  void tokenize (string s);
+  bool contains (string s2);
+  int  find (int i);
+  int  command_at (string s2, int i, int& e);
+};
+
+#endif // defined LATEX_TOKENS_H
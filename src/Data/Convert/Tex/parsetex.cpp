@@ -10,6 +10,7 @@
 ******************************************************************************/
 
 #include "Tex/convert_tex.hpp"
+#include "Tex/latex_tokens.hpp"
 #include "converter.hpp"
 #include "wencoding.hpp"
 
@@ -50,6 +51,7 @@ struct latex_parser {
   char lf;
   bool pic;
   hashmap<string,bool> loaded_package;
+  latex_tokens tokens;
   latex_parser (bool unicode2): level (0), unicode (unicode2) {}
   void latex_error (string s, int i, string message);
 
@@ -96,15 +98,18 @@ latex_parser::latex_error (string s, int i, string message) {
 
 int
 latex_search_forwards (string s, int pos, string in) {
+  // the matches of search_forwards are only accepted outside comments
   int k= N(s), n= N(in);
   if (k == 0) return pos;
-  char c= s[0];
   while (pos+k <= n) {
-    if (in[pos] == c && test (in, pos, s)) return pos;
-    if (in[pos] == '%' && (pos > 0 && in[pos-1] != '\\'))
-      while (pos < n && in[pos] != '\n') pos++;
-    else
-      pos++;
+    int next= search_forwards (s, pos, in);
+    if (next < 0) return -1;
+    int com= search_forwards ('%', pos, next, in);
+    while (com == 0 || (com > 0 && in[com-1] == '\\'))
+      com= search_forwards ('%', com + 1, next, in);
+    if (com < 0) return next;
+    pos= search_forwards ('\n', com, n, in);
+    if (pos < 0) return -1;
   }
   return -1;
 }
@@ -198,10 +203,9 @@ latex_parser::parse (string s, int& i, string stop, int change) {
          (s[i] != '$' || stop != "$$" || i+1>=n || s[i+1] != '$') &&
          (stop != "denom" ||
           (s[i] != '$' && s[i] != '}' &&
-           (i+2>n || s(i,i+2) != "\\]") &&
-           (i+2>n || s(i,i+2) != "\\)") &&
-           (i+4>n || s(i,i+4) != "\\end"))) &&
-         (stop != "\\egroup" || i+7>n || s(i,i+7) != "\\egroup")) {
+           !test (s, i, "\\]") && !test (s, i, "\\)") &&
+           !test (s, i, "\\end"))) &&
+         (stop != "\\egroup" || !test (s, i, "\\egroup"))) {
     if (N(stop) != 0 && stop[0] == '$' && test (s, i, "\\begin{")) {
       // Emergency break from math mode on certain text environments
       int j= i+7, start= j;
@@ -246,11 +250,13 @@ latex_parser::parse (string s, int& i, string stop, int change) {
       }
       else t << s (i-1, i);
       break;
-    case '\\':
+    case '\\': {
+      int e;
+      string name= latex_command_name (tokens.command_at (s, i, e));
       // TODO: move this in parse_command
-      if ((i+6)<n && (s (i+1, i+6) == "hskip" || s (i+1, i+6) == "vskip")) {
-        string skip = s (i+1, i+6);
-        i+=7;
+      if (e<n && (name == "\\hskip" || name == "\\vskip")) {
+        string skip = name (1, N(name));
+        i= e+1;
         bool tmp_textm_class_flag = textm_class_flag;
         textm_class_flag = true;
         if (can_parse_length (s, i)) {
@@ -261,17 +267,14 @@ latex_parser::parse (string s, int& i, string stop, int change) {
         }
         textm_class_flag = tmp_textm_class_flag;
       }
-      else if ((i+6)<n && s (i+1, i+5) == "char")
+      else if ((i+6)<n && name == "\\char")
         t << parse_char_code (s, i);
       // end of move
-      else if (((i+7)<n && !is_tex_alpha (s (i+5, i+7)) &&
-          (s (i, i+5) == "\\over" || s (i, i+5) == "\\atop")) ||
-          ((i+9)<n && !is_tex_alpha (s (i+7, i+9)) && s (i, i+7) == "\\choose"))
+      else if (((i+7)<n && (name == "\\over" || name == "\\atop")) ||
+               ((i+9)<n && name == "\\choose"))
         {
-          int start = i;
-          i++;
-          while (i<n && is_alpha (s[i])) i++;
-          string fr_cmd= s(start, i);
+          i= e;
+          string fr_cmd= name;
           if (fr_cmd == "\\over") fr_cmd= "\\frac";
           if (fr_cmd == "\\atop") fr_cmd= "\\ontop";
           int j;
@@ -283,16 +286,16 @@ latex_parser::parse (string s, int& i, string stop, int change) {
           tree den= parse (s, i, "denom");
           t << tree (TUPLE, fr_cmd, num, den);
         }
-      else if ((i+5) < n && s(i,i+3) == "\\sp" && !is_tex_alpha (s[i+3])) {
-        i+=3;
+      else if ((i+5) < n && name == "\\sp") {
+        i= e;
         t << parse_command (s, i, "\\<sup>");
       }
-      else if ((i+5) < n && s(i,i+3) == "\\sb" && !is_tex_alpha (s[i+3])) {
-        i+=3;
+      else if ((i+5) < n && name == "\\sb") {
+        i= e;
         t << parse_command (s, i, "\\<sub>");
       }
-      else if ((i+10) < n && s(i,i+8) == "\\pmatrix") {
-        i+=8;
+      else if ((i+10) < n && name == "\\pmatrix") {
+        i= e;
         tree arg= parse_command (s, i, "\\pmatrix");
         if (is_tuple (arg, "\\pmatrix", 1)) arg= arg[1];
         t << tree (TUPLE, "\\begin-pmatrix");
@@ -308,6 +311,7 @@ latex_parser::parse (string s, int& i, string stop, int change) {
         if (u == tuple ("\\\n")) t << "\n";
       }
       break;
+    }
     case '\'':
       i++;
       if (command_type ["!mode"] == "math") {
@@ -466,24 +470,25 @@ latex_parser::parse (string s, int& i, string stop, int change) {
 
 tree
 latex_parser::parse_backslash (string s, int& i, int change) {
-  int n= N(s);
-  if (((i+7)<n) && (s(i,i+5)=="\\verb")) {
+  int n= N(s), e;
+  string name= latex_command_name (tokens.command_at (s, i, e));
+  if (((i+7)<n) && (name == "\\verb")) {
     i+=6;
     return parse_verbatim (s, i, s(i-1,i), "\\verbatim");
   }
-  if (((i+6)<n) && (s(i,i+4)=="\\url") && s[i+4] != '{' && s[i+4] != ' ') {
+  if (((i+6)<n) && (name == "\\url") && s[i+4] != '{' && s[i+4] != ' ') {
     i+=5;
     return parse_verbatim (s, i, s(i-1,i), "\\url");
   }
-  if (((i+7)<n) && (s(i,i+5)=="\\path") && s[i+5] != '{' && s[i+5] != ' ') {
+  if (((i+7)<n) && (name == "\\path") && s[i+5] != '{' && s[i+5] != ' ') {
     i+=6;
     return parse_verbatim (s, i, s(i-1,i), "\\verbatim");
   }
-  if (((i+29)<n) && (s(i,i+16)=="\\begin{verbatim}")) {
+  if (((i+29)<n) && (name == "\\begin") && test (s, i, "\\begin{verbatim}")) {
     i+=16;
     return parse_verbatim (s, i, "\\end{verbatim}", "verbatim");
   }
-  if (((i+27)<n) && (s(i,i+14)=="\\begin{tmcode}")) {
+  if (((i+27)<n) && (name == "\\begin") && test (s, i, "\\begin{tmcode}")) {
     i+=14;
     if (i<n && s[i] == '[') {
       i++; tree opt= parse (s, i, ']'); i++;
@@ -492,11 +497,11 @@ latex_parser::parse_backslash (string s, int& i, int change) {
     else
       return parse_alltt (s, i, "\\end{tmcode}", "tmcode");
   }
-  if (((i+26)<n) && (s(i,i+13)=="\\begin{alltt}")) {
+  if (((i+26)<n) && (name == "\\begin") && test (s, i, "\\begin{alltt}")) {
     i+=13;
     return parse_alltt (s, i, "\\end{alltt}", "verbatim-code");
   }
-  if (((i+5)<n) && (s(i,i+4)=="\\url") && !is_tex_alpha (s[i+5])) {
+  if (((i+5)<n) && (name == "\\url") && !is_tex_alpha (s[i+5])) {
     i+=4;
     while (i<n && (s[i] == ' ' || s[i] == '\n' || s[i] == '\t')) i++;
     string ss;
@@ -508,7 +513,7 @@ latex_parser::parse_backslash (string s, int& i, int change) {
     }
     return tree (TUPLE, "\\url", ss);
   }
-  if (((i+6)<n) && (s(i,i+5)=="\\href")) {
+  if (((i+6)<n) && (name == "\\href")) {
     i+=5;
     while (i<n && (s[i] == ' ' || s[i] == '\n' || s[i] == '\t')) i++;
     string ss;
@@ -523,13 +528,13 @@ latex_parser::parse_backslash (string s, int& i, int change) {
     if (i<n && s[i] == '{') { i++; u= parse (s, i, "}"); i++; }
     return tree (TUPLE, "\\href", ss, u);
   }
-  if (((i+8)<n) && (s(i,i+7)=="\\bgroup")) {
+  if (((i+8)<n) && (name == "\\bgroup")) {
     i+=7;
     tree t (CONCAT);
     t << tree (TUPLE, "\\begingroup");
     t << parse (s, i, "\\egroup", change);
     t << tree (TUPLE, "\\endgroup");
-    if (((i+8)<n) && (s(i,i+7)=="\\egroup")) i+=7;
+    if (((i+8)<n) && test (s, i, "\\egroup")) i+=7;
     if ((i<n) && (!is_space (s[i]))) return t;
     int ln=0;
     while ((i<n) && is_space (s[i]))
@@ -565,9 +570,12 @@ latex_parser::parse_backslash (string s, int& i, int change) {
 
   /************************* normal commands *********************************/
   int start= i-1;
-  while ((i<n) && is_tex_alpha (s[i])) i++;
-  if ((i<n) && (s[i]=='*') && latex_type (s (start, i+1)) != "undefined") i++;
-  string r= s (start, i);
+  string r= name;
+  i= e;
+  if ((i<n) && (s[i]=='*') && latex_type (r * "*") != "undefined") {
+    r= r * "*";
+    i++;
+  }
   while ((i<n) && s[i] == ' ') i++;
   if (s[i] == '\n') {lf= 'N'; i++;}
   if ((r == "\\begin") || (r == "\\end")) {
@@ -825,15 +833,16 @@ latex_parser::parse_command (string s, int& i, string cmd, int change) {
   if (cmd == "\\begin-tabular*") cmd= "\\begin-tabularx";
   if (cmd == "\\end-tabular*") cmd= "\\end-tabularx";
 
-  if (latex_type (cmd) == "undefined")
+  string type= latex_type (cmd);
+  if (type == "undefined")
     return parse_unknown (s, i, cmd, change);
 
-  if (latex_type (cmd) == "math-environment") {
+  if (type == "math-environment") {
     if (cmd (0, 6) == "\\begin") command_type ("!mode") = "math";
     else command_type ("!mode") = "text";
   }
 
-  if (textm_class_flag && level <= 1 && latex_type (cmd) == "length") {
+  if (textm_class_flag && level <= 1 && type == "length") {
     //cout << "Parse length " << cmd << "\n";
     int n= N(s);
     while (i<n && (is_space (s[i]) || s[i] == '=')) i++;
@@ -905,7 +914,6 @@ latex_parser::parse_command (string s, int& i, string cmd, int change) {
   if (mbox_flag) command_type ("!mode") = "text";
 
   int  n     = N(s);
-  string type= latex_type (cmd);
   int  arity = latex_arity (cmd);
   bool option= (arity<0);
   if (option) arity= -1-arity;
@@ -1208,22 +1216,22 @@ latex_parser::parse_command (string s, int& i, string cmd, int change) {
   }
 
   /***************** apply substitutions and bords effects  ******************/
-  if ((pic && latex_type (cmd) == "replace")
-      || latex_type (cmd) == "begin-end!"
-      || latex_type (cmd) == "defined-env!"
-      || latex_type (cmd) == "bord-effect!") {
+  if ((pic && type == "replace")
+      || type == "begin-end!"
+      || type == "defined-env!"
+      || type == "bord-effect!") {
     int pos= 0;
     array<string> body= command_def[cmd];
     arity= command_arity[cmd];
-    if (N(body) > 0 && latex_type (cmd) == "bord-effect!"
+    if (N(body) > 0 && type == "bord-effect!"
         && !occurs (cmd, body[0]))
       (void) parse (body[0], pos, "", change);
-    else if (N(body) > 0 && latex_type (cmd) == "begin-end!"
+    else if (N(body) > 0 && type == "begin-end!"
         && is_tuple (t) && N(t) == 2)
       t= tuple (body[0] * "-" * as_string (u[1]));
-    else if (N(body) > 0 && latex_type (cmd) == "defined-env!")
+    else if (N(body) > 0 && type == "defined-env!")
       t= tuple (body[0]);
-    else if (latex_type (cmd) == "replace") {
+    else if (type == "replace") {
       if (cmd(0, 7) == "\\begin-") {
         int env_i= i;
         n= N(s);
@@ -1448,7 +1456,7 @@ verbatim_escape (string s) {
 tree
 latex_parser::parse_verbatim (string s, int& i, string end, string env) {
   int start=i, n= N(s), e= N(end);
-  while ((i<(n-e)) && (s(i,i+e)!=end)) i++;
+  while ((i<(n-e)) && !test (s, i, end)) i++;
   i+=e;
   if (N(env) > 0 && env[0] == '\\') {
     return tree (TUPLE, env, s(start,i-e));
@@ -1473,7 +1481,7 @@ latex_parser::parse_alltt (string s, int& i, string end, string env, tree opt)
   tree b= tree (TUPLE, begin);
   if (opt != tree (CONCAT)) b << opt;
   tree r= tree (CONCAT, b);
-  while ((i<(n-e)) && (s(i,i+e)!=end)) {
+  while ((i<(n-e)) && !test (s, i, end)) {
     if (s[i] == '\\') {
       r << s(start, i);
       r << parse_backslash (s, i);
@@ -1710,6 +1718,7 @@ latex_parser::parse (string s, int change) {
   tree t (CONCAT);
   for (i=0; i<N(a); i++) {
     int j=0;
+    tokens.tokenize (a[i]);
     while (j<N(a[i])) {
       int start= j;
       command_type ("!mode") = "text";
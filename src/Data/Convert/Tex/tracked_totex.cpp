@@ -223,7 +223,7 @@ tracked_texmacs_to_latex (tree d, object opts) {
   if (tracked_tree_to_latex_document (d, opts, s, ms)) return s;
 
   string post;
-  post << tree_to_scheme (purify (d));
+  tree_to_scheme (post, purify (d));
   post << "\n% Separate attachments\n";
   post << ms;
   // TODO: add integrity checksum
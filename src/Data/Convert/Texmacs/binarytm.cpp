@@ -0,0 +1,119 @@
+/******************************************************************************
+* MODULE     : binarytm.cpp
+* DESCRIPTION: compact binary format for TeXmacs trees
+* COPYRIGHT  : (C) 2020  Joris van der Hoeven
+*******************************************************************************
+* This software falls under the GNU general public license version 3 or later.
+* It comes WITHOUT ANY WARRANTY WHATSOEVER. For details, see the file LICENSE
+* in the root directory or <http://www.gnu.org/licenses/gpl-3.0.html>.
+******************************************************************************/
+
+#include "convert.hpp"
+
+/******************************************************************************
+* The binary format consists of
+*   - the magic string "\0TMB" and the format number,
+*   - the TeXmacs version which produced the tree,
+*   - a dictionary with the names of the user defined labels in the tree,
+*   - the tree itself, in prefix order.
+* Atoms are encoded by twice their length, followed by their contents,
+* and compound nodes by one plus twice the code of their label, followed
+* by their arity and their children. Standard labels are coded by their
+* values and the other ones by START_EXTENSIONS plus their index in the
+* dictionary. Trees are only read back by the same version of TeXmacs,
+* so that the standard labels are stable and trees never need upgrading.
+******************************************************************************/
+
+#define BINARY_MAGIC  "\0TMB"
+#define BINARY_FORMAT 1
+
+static void
+binary_write (string& r, tree t, hashmap<int,int>& code,
+              array<string>& labels) {
+  if (is_atomic (t)) {
+    marshall_number (r, 2 * ((unsigned long int) N(t->label)));
+    r << t->label;
+  }
+  else {
+    int l= (int) L(t);
+    if (l >= START_EXTENSIONS && !code->contains (l)) {
+      code (l)= START_EXTENSIONS + N(labels);
+      labels << as_string (L(t));
+    }
+    int c= (l < START_EXTENSIONS? l: code[l]);
+    marshall_number (r, 2 * ((unsigned long int) c) + 1);
+    marshall_number (r, N(t));
+    for (int i=0; i<N(t); i++)
+      binary_write (r, t[i], code, labels);
+  }
+}
+
+string
+tree_to_binary (tree t) {
+  string body;
+  hashmap<int,int> code (-1);
+  array<string> labels;
+  binary_write (body, t, code, labels);
+  string r (BINARY_MAGIC, 4);
+  marshall_number (r, BINARY_FORMAT);
+  marshall_string (r, TEXMACS_VERSION);
+  marshall_number (r, N(labels));
+  for (int i=0; i<N(labels); i++)
+    marshall_string (r, labels[i]);
+  r << body;
+  return r;
+}
+
+/******************************************************************************
+* Reading binary trees
+******************************************************************************/
+
+static tree
+binary_read (string s, int& pos, array<tree_label>& labels, bool& err) {
+  if (err || pos >= N(s)) { err= true; return ""; }
+  unsigned long int c= unmarshall_number (s, pos);
+  if ((c & 1) == 0) {
+    unsigned long int n= c >> 1;
+    if (n > (unsigned long int) (N(s) - pos)) { err= true; return ""; }
+    string a= s (pos, pos + (int) n);
+    pos += (int) n;
+    return a;
+  }
+  unsigned long int k= c >> 1;
+  if (pos >= N(s)) { err= true; return ""; }
+  unsigned long int n= unmarshall_number (s, pos);
+  // each child takes at least one byte
+  if (k >= (unsigned long int) (START_EXTENSIONS + N(labels)) ||
+      n > (unsigned long int) (N(s) - pos)) { err= true; return ""; }
+  tree_label l= (k < START_EXTENSIONS? (tree_label) k:
+                 labels[k - START_EXTENSIONS]);
+  tree t (l, (int) n);
+  for (int i=0; i<((int) n) && !err; i++)
+    t[i]= binary_read (s, pos, labels, err);
+  return t;
+}
+
+bool
+is_binary_tree (string s) {
+  return N(s) >= 4 && s (0, 4) == string (BINARY_MAGIC, 4);
+}
+
+tree
+binary_to_tree (string s) {
+  // returns an error tree for data from other versions of TeXmacs,
+  // in which case the textual source should be used instead
+  tree error (ERROR, "bad format or data");
+  if (!is_binary_tree (s)) return error;
+  int pos= 4;
+  if (unmarshall_number (s, pos) != BINARY_FORMAT) return error;
+  if (unmarshall_string (s, pos) != TEXMACS_VERSION) return error;
+  unsigned long int n= unmarshall_number (s, pos);
+  if (n > (unsigned long int) (N(s) - pos)) return error;
+  array<tree_label> labels ((int) n);
+  for (int i=0; i<((int) n); i++)
+    labels[i]= make_tree_label (unmarshall_string (s, pos));
+  bool err= false;
+  tree t= binary_read (s, pos, labels, err);
+  if (err || pos != N(s)) return error;
+  return t;
+}
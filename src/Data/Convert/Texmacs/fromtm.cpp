@@ -14,35 +14,128 @@
 #include "path.hpp"
 #include "vars.hpp"
 #include "drd_std.hpp"
+#include "mapped_string.hpp"
+#include <stdio.h>
+
+/******************************************************************************
+* Buffers for reading from files or pipes in blocks
+******************************************************************************/
+
+#define TM_STREAM_BLOCK 65536
+
+class tm_stream;
+class tm_stream_rep: concrete_struct {
+  FILE*  fin;   // the input
+  bool   eof;   // the end of the input has been reached
+  int    base;  // position of first buffered character in the input
+  string buf;   // the buffered characters
+  int    seen;  // largest position which has been accessed
+
+public:
+  inline tm_stream_rep (FILE* fin2):
+    fin (fin2), eof (false), base (0), buf (), seen (0) {}
+  void fill (int upto);
+  void discard (int upto);
+
+  friend class tm_stream;
+  friend inline int N (tm_stream s);
+};
+
+class tm_stream {
+  CONCRETE(tm_stream);
+  inline tm_stream (FILE* fin): rep (tm_new<tm_stream_rep> (fin)) {}
+  inline char operator [] (int i) {
+    if (i >= rep->base + N(rep->buf)) rep->fill (i + TM_STREAM_BLOCK);
+    if (i > rep->seen) rep->seen= i;
+    if (i < rep->base || i >= rep->base + N(rep->buf)) return '\0';
+    return rep->buf[i - rep->base]; }
+  inline string operator () (int i, int j) {
+    rep->fill (j);
+    return rep->buf (i - rep->base, j - rep->base); }
+};
+CONCRETE_CODE(tm_stream);
+
+void
+tm_stream_rep::fill (int upto) {
+  char block[TM_STREAM_BLOCK];
+  while (!eof && base + N(buf) < upto) {
+    int nr= (int) fread (block, 1, TM_STREAM_BLOCK, fin);
+    if (nr <= 0) eof= true;
+    else buf << string (block, nr);
+  }
+}
+
+void
+tm_stream_rep::discard (int upto) {
+  // the reader never needs to go back before the end of a completed node
+  if (upto - base < 4 * TM_STREAM_BLOCK) return;
+  buf = buf (upto - base, N(buf));
+  base= upto;
+}
+
+inline int
+N (tm_stream s) {
+  // the reader checks positions shortly after the last accessed one
+  // against the length, so we make sure that these are available
+  int n= s->base + N(s->buf);
+  if (!s->eof && s->seen + TM_STREAM_BLOCK > n) {
+    s->fill (s->seen + TM_STREAM_BLOCK);
+    n= s->base + N(s->buf);
+  }
+  return n;
+}
+
+static void
+skip_spaces (tm_stream s, int& i) {
+  while ((i<N(s)) && ((s[i]==' ') || (s[i]=='\t'))) i++;
+}
+
+static inline void discard (string s, int pos) { (void) s; (void) pos; }
+static inline void discard (mapped_string s, int pos) { (void) s; (void) pos; }
+static inline void discard (tm_stream s, int pos) { s->discard (pos); }
 
 /******************************************************************************
 * Conversion of TeXmacs strings of the present format to TeXmacs trees
+* The reader is parameterized by the type B of the buffer, which is
+* a string, a mapped_string or a tm_stream. When a routine is given, it is
+* called for each completed child of the document and of its body.
 ******************************************************************************/
 
+template<class B>
 struct tm_reader {
   string  version;            // document was composed using this version
   hashmap<string,int> codes;  // codes for to present version
   tree_label EXPAND_APPLY;    // APPLY (version < 0.3.3.22) or EXPAND (otherw)
   bool    backslash_ok;       // true for versions >= 1.0.1.23
   bool    with_extensions;    // true for versions >= 1.0.2.4
-  string  buf;                // the string being read from
+  B       buf;                // the string being read from
   int     pos;                // the current position of the reader
   string  last;               // last read string
-
-  tm_reader (string buf2):
+  tm_stream_routine routine;  // notified of completed children (or NULL)
+  void*   obj;                // argument for routine
+  int     level;              // nesting level of the current application
+  bool    in_body;            // reading the contents of the body
+  int     top_done;           // number of completed children of the document
+  int     body_index;         // index of the body in the document
+
+  tm_reader (B buf2):
     version (TEXMACS_VERSION),
     codes (STD_CODE),
     EXPAND_APPLY (EXPAND),
     backslash_ok (true),
     with_extensions (true),
-    buf (buf2), pos (0), last ("") {}
-  tm_reader (string buf2, string version2):
+    buf (buf2), pos (0), last (""),
+    routine (NULL), obj (NULL), level (0), in_body (false),
+    top_done (0), body_index (0) {}
+  tm_reader (B buf2, string version2):
     version (version2),
     codes (get_codes (version)),
     EXPAND_APPLY (version_inf (version, "0.3.3.22")? APPLY: EXPAND),
     backslash_ok (version_inf (version, "1.0.1.23")? false: true),
     with_extensions (version_inf (version, "1.0.2.4")? false: true),
-    buf (buf2), pos (0), last ("") {}
+    buf (buf2), pos (0), last (""),
+    routine (NULL), obj (NULL), level (0), in_body (false),
+    top_done (0), body_index (0) {}
 
   int    skip_blank ();
   string decode (string s);
@@ -51,10 +144,19 @@ struct tm_reader {
   string read_function_name ();
   tree   read_apply (string s, bool skip_flag);
   tree   read (bool skip_flag);
+  void   emit (tree D, int& done);
 };
 
-int
-tm_reader::skip_blank () {
+template<class B> void
+tm_reader<B>::emit (tree D, int& done) {
+  for (; done < N(D); done++)
+    if (level == 0) routine (obj, path (done), D[done]);
+    else routine (obj, path (body_index, done), D[done]);
+  discard (buf, pos);
+}
+
+template<class B> int
+tm_reader<B>::skip_blank () {
   int n=0;
   for (; pos < N(buf); pos++) {
     if (buf[pos]==' ') continue;
@@ -66,8 +168,8 @@ tm_reader::skip_blank () {
   return n;
 }
 
-string
-tm_reader::decode (string s) {
+template<class B> string
+tm_reader<B>::decode (string s) {
   int i, n=N(s);
   string r;
   for (i=0; i<n; i++)
@@ -86,8 +188,8 @@ tm_reader::decode (string s) {
   return r;
 }
 
-string
-tm_reader::read_char () {
+template<class B> string
+tm_reader<B>::read_char () {
   while (((pos+1) < N(buf)) && (buf[pos] == '\\') && (buf[pos+1] == '\n')) {
     pos += 2;
     skip_spaces (buf, pos);
@@ -97,8 +199,8 @@ tm_reader::read_char () {
   return buf (pos-1, pos);
 }
 
-string
-tm_reader::read_next () {
+template<class B> string
+tm_reader<B>::read_next () {
   int old_pos= pos;
   string c= read_char ();
   if (c == "") return c;
@@ -161,8 +263,8 @@ tm_reader::read_next () {
   return r;
 }
 
-string
-tm_reader::read_function_name () {
+template<class B> string
+tm_reader<B>::read_function_name () {
   string name= decode (read_next ());
   // cout << "==> " << name << "\n";
   while (true) {
@@ -185,8 +287,8 @@ get_collection (tree& u, tree t) {
   else if (is_compound (t)) u << t;
 }
 
-tree
-tm_reader::read_apply (string name, bool skip_flag) {
+template<class B> tree
+tm_reader<B>::read_apply (string name, bool skip_flag) {
   // cout << "Read apply " << name << INDENT << LF;
   tree t (make_tree_label (name));
   if (!with_extensions)
@@ -197,6 +299,10 @@ tm_reader::read_apply (string name, bool skip_flag) {
   }
 
   bool closed= !skip_flag;
+  bool old_in_body= in_body;
+  if (level == 0 && name == "body") { in_body= true; body_index= top_done; }
+  else in_body= false;
+  level++;
   while (pos < N(buf)) {
     // cout << "last= " << last << LF;
     bool sub_flag= (skip_flag) && ((last == "") || (last[N(last)-1] != '|'));
@@ -205,6 +311,8 @@ tm_reader::read_apply (string name, bool skip_flag) {
     if ((last == "/>") || (last == "/|")) closed= true;
     if (closed && ((last == ">") || (last == "/>"))) break;
   }
+  level--;
+  in_body= old_in_body;
   // cout << "last= " << last << UNINDENT << LF;
   // cout << "Done" << LF;
 
@@ -235,15 +343,19 @@ flush (tree& D, tree& C, string& S, bool& spc_flag, bool& ret_flag) {
   }
 }
 
-tree
-tm_reader::read (bool skip_flag) {
+template<class B> tree
+tm_reader<B>::read (bool skip_flag) {
   tree   D (DOCUMENT);
   tree   C (CONCAT);
   string S ("");
   bool   spc_flag= false;
   bool   ret_flag= false;
+  bool   stream= routine != NULL && (level == 0 || (level == 1 && in_body));
+  int    body_done= 0;
+  int&   done= (level == 0? top_done: body_done);
 
   while (true) {
+    if (stream) emit (D, done);
     last= read_next ();
     // cout << "--> " << last << "\n";
     if (last == "") break;
@@ -253,6 +365,7 @@ tm_reader::read (bool skip_flag) {
     if (last[0] == '<') {
       if (last[N(last)-1] == '\\') {
         flush (D, C, S, spc_flag, ret_flag);
+        if (stream) emit (D, done);
         string name= read_function_name ();
         if (last == ">") last= "\\>";
         else last= "\\|";
@@ -284,6 +397,7 @@ tm_reader::read (bool skip_flag) {
       }
       else {
         flush (D, C, S, spc_flag, ret_flag);
+        if (stream) emit (D, done);
         string name= decode (read_next ());
         string sep = ">";
         if (name == ">") name= "";
@@ -321,6 +435,7 @@ tm_reader::read (bool skip_flag) {
   flush (D, C, S, spc_flag, ret_flag);
   if (N(C) == 1) D << C[0];
   else if (N(C)>1) D << C;
+  if (stream) emit (D, done);
   // cout << "*** " << D << "\n";
   if (N(D)==0) return "";
   if (N(D)==1) {
@@ -333,13 +448,13 @@ tm_reader::read (bool skip_flag) {
 
 tree
 texmacs_to_tree (string s) {
-  tm_reader tmr (s);
+  tm_reader<string> tmr (s);
   return tmr.read (true);
 }
 
 tree
 texmacs_to_tree (string s, string version) {
-  tm_reader tmr (s, version);
+  tm_reader<string> tmr (s, version);
   return tmr.read (true);
 }
 
@@ -355,8 +470,38 @@ is_expand (tree t, string s, int n) {
   return (L(t) == EXPAND) && (N(t) == n+1) && (t[0] == s);
 }
 
-tree
-texmacs_document_to_tree (string s) {
+template<class B> static tree
+texmacs_new_document_to_tree (B s, tm_stream_routine routine= NULL,
+                              void* obj= NULL) {
+  // documents of the present format, starting with <TeXmacs|version>
+  int i;
+  for (i=9; i<N(s); i++)
+    if (s[i] == '>') break;
+  string version= s (9, i);
+  tm_reader<B> tmr (s, version);
+  if (!version_inf_eq (version, "1.99.12")) {
+    // partial results are only passed on for versions which do not
+    // require any upgrading except for the final automatic corrections
+    tmr.routine= routine;
+    tmr.obj= obj;
+  }
+  tree doc= tmr.read (true);
+  if (is_compound (doc, "TeXmacs", 1) ||
+      is_expand (doc, "TeXmacs", 1) ||
+      is_apply (doc, "TeXmacs", 1))
+    doc= tree (DOCUMENT, doc);
+  if (!is_document (doc)) return tree (ERROR, "bad format or data");
+  if (N(doc) == 0 || !is_compound (doc[0], "TeXmacs", 1)) {
+    tree d (DOCUMENT);
+    d << compound ("TeXmacs", version);
+    d << A(doc);
+    doc= d;
+  }
+  return upgrade (doc, version);
+}
+
+static tree
+texmacs_document_to_tree_bis (string s) {
   tree error (ERROR, "bad format or data");
   if (starts (s, "edit") ||
       starts (s, "TeXmacs") ||
@@ -390,28 +535,53 @@ texmacs_document_to_tree (string s) {
     return upgrade (doc, version);
   }
 
-  if (starts (s, "<TeXmacs|")) {
-    int i;
-    for (i=9; i<N(s); i++)
-      if (s[i] == '>') break;
-    string version= s (9, i);
-    tree doc= texmacs_to_tree (s, version);
-    if (is_compound (doc, "TeXmacs", 1) ||
-        is_expand (doc, "TeXmacs", 1) ||
-        is_apply (doc, "TeXmacs", 1))
-      doc= tree (DOCUMENT, doc);
-    if (!is_document (doc)) return error;
-    if (N(doc) == 0 || !is_compound (doc[0], "TeXmacs", 1)) {
-      tree d (DOCUMENT);
-      d << compound ("TeXmacs", version);
-      d << A(doc);
-      doc= d;
-    }
-    return upgrade (doc, version);
-  }
+  if (starts (s, "<TeXmacs|")) return texmacs_new_document_to_tree (s);
   return error;
 }
 
+tree
+texmacs_document_to_tree (string s, bool share) {
+  // when share holds, the short atoms of the resulting read-only
+  // document are shared with other documents read in the same way
+  MEM_TAG_SCOPE (MEM_TREES);
+  tree doc= texmacs_document_to_tree_bis (s);
+  if (share) share_atoms (doc);
+  return doc;
+}
+
+tree
+texmacs_document_to_tree (mapped_string s, bool share) {
+  // documents of the present format are parsed without copying them;
+  // older formats are rare and converted using an ordinary string
+  if (!starts (s, "<TeXmacs|"))
+    return texmacs_document_to_tree (as_string (s), share);
+  MEM_TAG_SCOPE (MEM_TREES);
+  tree doc= texmacs_new_document_to_tree (s);
+  if (share) share_atoms (doc);
+  return doc;
+}
+
+tree
+texmacs_stream_to_tree (url u, tm_stream_routine routine, void* obj) {
+  // read a document in blocks, so that the first completed parts can be
+  // used while the remainder is being read; routine is called with the
+  // path and the tree of each completed child of the document and of its
+  // body and the final document tree is returned
+  url r= u;
+  if (!is_rooted_name (r)) r= resolve (r);
+  if (!is_rooted_name (r)) return tree (ERROR, "file not found");
+  c_string _name (concretize (r));
+  FILE* fin= fopen (_name, "rb");
+  if (fin == NULL) return tree (ERROR, "file not readable");
+  tm_stream in (fin);
+  tree doc;
+  if (in (0, 9) == "<TeXmacs|")
+    doc= texmacs_new_document_to_tree (in, routine, obj);
+  else doc= texmacs_document_to_tree (in (0, 0x7fffffff));
+  fclose (fin);
+  return doc;
+}
+
 /******************************************************************************
 * Extracting attributes from a TeXmacs document tree
 ******************************************************************************/
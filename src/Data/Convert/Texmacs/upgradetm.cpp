@@ -19,6 +19,7 @@
 #include "scheme.hpp"
 #include "tree_correct.hpp"
 #include "merge_sort.hpp"
+#include "tm_timer.hpp"
 
 static bool upgrade_tex_flag= false;
 double get_magnification (string s);
@@ -2831,6 +2832,38 @@ rename_primitive (tree t, string which, string by) {
   return r;
 }
 
+static bool
+contains_labels (tree t, hashmap<int,int> h) {
+  if (is_atomic (t)) return false;
+  if (h->contains ((int) L(t))) return true;
+  for (int i=0; i<N(t); i++)
+    if (contains_labels (t[i], h)) return true;
+  return false;
+}
+
+static tree
+rename_primitives_bis (tree t, hashmap<int,int> h) {
+  if (is_atomic (t)) return t;
+  int i, n= N(t);
+  tree r (t, n);
+  if (h->contains ((int) L(t)))
+    r= tree ((tree_label) h[(int) L(t)], n);
+  for (i=0; i<n; i++)
+    r[i]= rename_primitives_bis (t[i], h);
+  return r;
+}
+
+tree
+rename_primitives (tree t, array<string> which, array<string> by) {
+  // several renamings in a single traversal, which is skipped
+  // altogether if none of the old primitives occurs in t
+  hashmap<int,int> h (-1);
+  for (int i=0; i<N(which); i++)
+    h ((int) make_tree_label (which[i]))= (int) make_tree_label (by[i]);
+  if (!contains_labels (t, h)) return t;
+  return rename_primitives_bis (t, h);
+}
+
 /******************************************************************************
 * Upgrade label assignment
 ******************************************************************************/
@@ -4210,173 +4243,184 @@ upgrade_mathml (tree t) {
   return t;
 }
 
+// each pass is timed separately when profiling
+#define UPGRADE_PASS(name,pass) \
+  { PROFILE_SCOPE ("upgrade " name); t= pass; }
+
 tree
 upgrade (tree t, string version) {
   if (version_inf (version, "0.3.1.9")) {
     path p;
-    t= upgrade_textual (t, p);
+    UPGRADE_PASS ("textual", upgrade_textual (t, p));
   }
   if (version_inf (version, "0.3.3.1"))
-    t= upgrade_apply_expand_value (t);
+    UPGRADE_PASS ("apply expand value", upgrade_apply_expand_value (t));
   if (version_inf (version, "0.3.3.20"))
-    t= upgrade_new_environments (t);
+    UPGRADE_PASS ("new environments", upgrade_new_environments (t));
   if (version_inf (version, "0.3.3.24"))
-    t= upgrade_items (t);
+    UPGRADE_PASS ("items", upgrade_items (t));
   if (version_inf (version, "0.3.4.4"))
-    t= upgrade_resize (t);
+    UPGRADE_PASS ("resize", upgrade_resize (t));
   if (version_inf_eq (version, "0.3.4.7"))
-    t= upgrade_table (t);
+    UPGRADE_PASS ("table", upgrade_table (t));
   if (version_inf_eq (version, "0.3.4.8"))
-    t= upgrade_split (t, false);
+    UPGRADE_PASS ("split", upgrade_split (t, false));
   if (version_inf_eq (version, "0.3.5.6"))
-    t= upgrade_project (t);
+    UPGRADE_PASS ("project", upgrade_project (t));
   if (version_inf_eq (version, "0.3.5.10"))
-    t= upgrade_title (t);
+    UPGRADE_PASS ("title", upgrade_title (t));
   if (version_inf_eq (version, "1.0.0.1"))
-    t= upgrade_cas (t);
+    UPGRADE_PASS ("cas", upgrade_cas (t));
   if (version_inf_eq (version, "1.0.0.8"))
-    t= simplify_correct (upgrade_mod_symbols (t));
+    UPGRADE_PASS ("mod symbols",
+                  simplify_correct (upgrade_mod_symbols (t)));
   if (version_inf_eq (version, "1.0.0.11"))
-    t= upgrade_menus_in_help (t);
+    UPGRADE_PASS ("menus in help", upgrade_menus_in_help (t));
   if (version_inf_eq (version, "1.0.0.13"))
-    t= upgrade_capitalize_menus (t);
+    UPGRADE_PASS ("capitalize menus", upgrade_capitalize_menus (t));
   if (version_inf_eq (version, "1.0.0.19"))
-    t= upgrade_traverse_branch (t);
+    UPGRADE_PASS ("traverse branch", upgrade_traverse_branch (t));
   if (version_inf_eq (version, "1.0.1.20"))
-    t= upgrade_session (t);
+    UPGRADE_PASS ("session", upgrade_session (t));
   if (version_inf_eq (version, "1.0.2.0"))
-    t= upgrade_formatting (t);
+    UPGRADE_PASS ("formatting", upgrade_formatting (t));
   if (version_inf_eq (version, "1.0.2.3"))
-    t= upgrade_expand (t, EXPAND);
+    UPGRADE_PASS ("expand", upgrade_expand (t, EXPAND));
   if (version_inf_eq (version, "1.0.2.4"))
-    t= upgrade_expand (t, HIDE_EXPAND);
+    UPGRADE_PASS ("expand", upgrade_expand (t, HIDE_EXPAND));
   if (version_inf_eq (version, "1.0.2.5")) {
-    t= upgrade_expand (t, VAR_EXPAND);
-    t= upgrade_xexpand (t);
+    UPGRADE_PASS ("expand", upgrade_expand (t, VAR_EXPAND));
+    UPGRADE_PASS ("xexpand", upgrade_xexpand (t));
   }
   if (version_inf_eq (version, "1.0.2.6")) {
-    t= upgrade_function (t);
-    t= upgrade_apply (t);
+    UPGRADE_PASS ("function", upgrade_function (t));
+    UPGRADE_PASS ("apply", upgrade_apply (t));
   }
   if (version_inf_eq (version, "1.0.2.8"))
-    t= upgrade_env_vars (t);
+    UPGRADE_PASS ("env vars", upgrade_env_vars (t));
   if (version_inf_eq (version, "1.0.3.3"))
-    t= upgrade_use_package (t);
+    UPGRADE_PASS ("use package", upgrade_use_package (t));
   if (version_inf_eq (version, "1.0.3.4"))
-    t= upgrade_style_rename (t);
+    UPGRADE_PASS ("style rename", upgrade_style_rename (t));
   if (version_inf_eq (version, "1.0.3.4"))
-    t= upgrade_item_punct (t);
+    UPGRADE_PASS ("item punct", upgrade_item_punct (t));
   if (version_inf_eq (version, "1.0.3.7"))
-    t= upgrade_page_pars (t);
+    UPGRADE_PASS ("page pars", upgrade_page_pars (t));
   if (version_inf_eq (version, "1.0.4")) {
-    t= substitute (t, tree (VALUE, "hrule"), compound ("hrule"));
-    t= upgrade_doc_info (t);
+    UPGRADE_PASS ("hrule",
+                  substitute (t, tree (VALUE, "hrule"), compound ("hrule")));
+    UPGRADE_PASS ("doc info", upgrade_doc_info (t));
   }
   if (version_inf_eq (version, "1.0.4.6"))
-    t= upgrade_bibliography (t);
+    UPGRADE_PASS ("bibliography", upgrade_bibliography (t));
   if (version_inf_eq (version, "1.0.5.4"))
-    t= upgrade_switch (t);
+    UPGRADE_PASS ("switch", upgrade_switch (t));
   if (version_inf_eq (version, "1.0.5.7"))
-    t= upgrade_fill (t);
+    UPGRADE_PASS ("fill", upgrade_fill (t));
   if (version_inf_eq (version, "1.0.5.8"))
-    t= upgrade_graphics (t);
+    UPGRADE_PASS ("graphics", upgrade_graphics (t));
   if (version_inf_eq (version, "1.0.5.11"))
-    t= upgrade_textat (t);
+    UPGRADE_PASS ("textat", upgrade_textat (t));
   if (version_inf_eq (version, "1.0.6.1"))
-    t= upgrade_cell_alignment (t);
+    UPGRADE_PASS ("cell alignment", upgrade_cell_alignment (t));
   if (version_inf_eq (version, "1.0.6.2"))
-    t= rename_primitive (t, "hyper-link", "hlink");
+    UPGRADE_PASS ("hyper link", rename_primitive (t, "hyper-link", "hlink"));
   if (version_inf_eq (version, "1.0.6.2"))
-    t= upgrade_label_assignment (t);
+    UPGRADE_PASS ("label assignment", upgrade_label_assignment (t));
   if (version_inf_eq (version, "1.0.6.10"))
-    t= upgrade_scheme_doc (t);
+    UPGRADE_PASS ("scheme doc", upgrade_scheme_doc (t));
   if (version_inf_eq (version, "1.0.6.14"))
-    t= upgrade_mmx (t);
+    UPGRADE_PASS ("mmx", upgrade_mmx (t));
   if (version_inf_eq (version, "1.0.7.1"))
-    t= upgrade_session (t, "scheme", "default");
+    UPGRADE_PASS ("session", upgrade_session (t, "scheme", "default"));
   if (version_inf_eq (version, "1.0.7.6"))
-    t= upgrade_presentation (t);
+    UPGRADE_PASS ("presentation", upgrade_presentation (t));
   if (version_inf_eq (version, "1.0.7.6") && is_non_style_document (t))
-    t= upgrade_math (t);
+    UPGRADE_PASS ("math", upgrade_math (t));
   if (version_inf_eq (version, "1.0.7.7"))
-    t= upgrade_resize_clipped (t);
+    UPGRADE_PASS ("resize clipped", upgrade_resize_clipped (t));
   if (version_inf_eq (version, "1.0.7.7"))
-    t= upgrade_image (t);
+    UPGRADE_PASS ("image", upgrade_image (t));
   if (version_inf_eq (version, "1.0.7.7"))
-    t= upgrade_root_switch (t);
+    UPGRADE_PASS ("root switch", upgrade_root_switch (t));
   if (version_inf_eq (version, "1.0.7.8"))
-    t= upgrade_hyphenation (t);
+    UPGRADE_PASS ("hyphenation", upgrade_hyphenation (t));
   if (DEBUG_CORRECT)
     if (is_non_style_document (t))
       math_status_cumul (t);
   if (version_inf_eq (version, "1.0.7.8") && is_non_style_document (t)) {
-    t= with_correct (t);
-    t= superfluous_with_correct (t);
-    t= upgrade_brackets (t);
+    UPGRADE_PASS ("with correct", with_correct (t));
+    UPGRADE_PASS ("superfluous with correct", superfluous_with_correct (t));
+    UPGRADE_PASS ("brackets", upgrade_brackets (t));
   }
   if (version_inf_eq (version, "1.0.7.9")) {
-    t= move_brackets (t);
+    UPGRADE_PASS ("move brackets", move_brackets (t));
     if (is_non_style_document (t))
-      t= upgrade_algorithm (t, false);
-    t= upgrade_math_ops (t);
+      UPGRADE_PASS ("algorithm", upgrade_algorithm (t, false));
+    UPGRADE_PASS ("math ops", upgrade_math_ops (t));
   }
-  if (version_inf_eq (version, "1.0.7.10"))
-    t= downgrade_big (t);
+  if (version_inf_eq (version, "1.0.7.10") && needs_downgrade_big (t))
+    UPGRADE_PASS ("downgrade big", downgrade_big (t));
   if (version_inf_eq (version, "1.0.7.13"))
-    t= upgrade_gr_attributes (t);
+    UPGRADE_PASS ("gr attributes", upgrade_gr_attributes (t));
   if (version_inf_eq (version, "1.0.7.14"))
-    t= upgrade_cursor (t);
+    UPGRADE_PASS ("cursor", upgrade_cursor (t));
   if (version_inf_eq (version, "1.0.7.15"))
-    t= upgrade_cyrillic (t);
+    UPGRADE_PASS ("cyrillic", upgrade_cyrillic (t));
   if (version_inf_eq (version, "1.0.7.17")) {
-    t= upgrade_metadata (t);
-    t= upgrade_abstract_data (t);
-    t= correct_metadata (t);
+    UPGRADE_PASS ("metadata", upgrade_metadata (t));
+    UPGRADE_PASS ("abstract data", upgrade_abstract_data (t));
+    UPGRADE_PASS ("correct metadata", correct_metadata (t));
   }
   if (version_inf_eq (version, "1.0.7.20")) {
-    t= upgrade_unroll (t);
-    t= upgrade_style (t, false);
-    t= upgrade_doc_language (t);
+    UPGRADE_PASS ("unroll", upgrade_unroll (t));
+    UPGRADE_PASS ("style", upgrade_style (t, false));
+    UPGRADE_PASS ("doc language", upgrade_doc_language (t));
   }
   if (version_inf_eq (version, "1.0.7.21")) {
-    t= upgrade_varsession (t);
-    t= upgrade_subsession (t);
+    UPGRADE_PASS ("varsession", upgrade_varsession (t));
+    UPGRADE_PASS ("subsession", upgrade_subsession (t));
   }
   if (version_inf_eq (version, "1.99.2")) {
-    t= upgrade_quotes (t);
-    t= upgrade_ancient (t);
+    UPGRADE_PASS ("quotes", upgrade_quotes (t));
+    UPGRADE_PASS ("ancient", upgrade_ancient (t));
   }
   if (version_inf_eq (version, "1.99.4"))
-    t= upgrade_draw_over_under (t);
+    UPGRADE_PASS ("draw over under", upgrade_draw_over_under (t));
   if (version_inf_eq (version, "1.99.6")) {
-    t= upgrade_qed (t);
+    UPGRADE_PASS ("qed", upgrade_qed (t));
     if (is_non_style_document (t))
-      t= preserve_spacing (t);
+      UPGRADE_PASS ("preserve spacing", preserve_spacing (t));
   }
   if (version_inf_eq (version, "1.99.8")) {
     if (is_non_style_document (t)) {
-      t= rename_style (t, "exam", "old-exam");
-      t= rename_style (t, "compact", "old-compact");
-      t= rename_style (t, "beamer", "old2-beamer");
+      UPGRADE_PASS ("rename style", rename_style (t, "exam", "old-exam"));
+      UPGRADE_PASS ("rename style", rename_style (t, "compact", "old-compact"));
+      UPGRADE_PASS ("rename style", rename_style (t, "beamer", "old2-beamer"));
     }
   }
   if (version_inf_eq (version, "1.99.9")) {
-    t= rename_primitive (t, "solution", "solution*");
-    t= rename_primitive (t, "answer", "answer*");
-    t= rename_primitive (t, "html-div", "html-div-class");
-    t= rename_primitive (t, "html-style", "html-div-style");
+    array<string> which, by;
+    which << string ("solution") << string ("answer")
+          << string ("html-div") << string ("html-style");
+    by    << string ("solution*") << string ("answer*")
+          << string ("html-div-class") << string ("html-div-style");
+    UPGRADE_PASS ("rename primitives", rename_primitives (t, which, by));
   }
   if (version_inf_eq (version, "1.99.11"))
     if (is_non_style_document (t))
-      t= preserve_dots (t);
+      UPGRADE_PASS ("preserve dots", preserve_dots (t));
   if (version_inf_eq (version, "1.99.12")) {
-    t= upgrade_copyright_dashes (t);
-    t= rename_primitive (t, "swell", "inflate");
-    t= rename_primitive (t, "swell-top", "inflate-top");
-    t= rename_primitive (t, "swell-bottom", "inflate-bottom");
+    UPGRADE_PASS ("copyright dashes", upgrade_copyright_dashes (t));
+    array<string> which, by;
+    which << string ("swell") << string ("swell-top")
+          << string ("swell-bottom");
+    by    << string ("inflate") << string ("inflate-top")
+          << string ("inflate-bottom");
+    UPGRADE_PASS ("rename primitives", rename_primitives (t, which, by));
   }
   
   if (is_non_style_document (t))
-    t= automatic_correct (t, version);
+    UPGRADE_PASS ("automatic correct", automatic_correct (t, version));
   return t;
 }
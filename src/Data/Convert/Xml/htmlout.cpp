@@ -0,0 +1,345 @@
+
+/******************************************************************************
+* MODULE     : htmlout.cpp
+* DESCRIPTION: serialization of Html and MathML scheme trees
+* COPYRIGHT  : (C) 2002-2020  Joris van der Hoeven
+*******************************************************************************
+* This software falls under the GNU general public license version 3 or later.
+* It comes WITHOUT ANY WARRANTY WHATSOEVER. For details, see the file LICENSE
+* in the root directory or <http://www.gnu.org/licenses/gpl-3.0.html>.
+******************************************************************************/
+
+#include "convert.hpp"
+#include "analyze.hpp"
+#include "file.hpp"
+#include "tm_ostream.hpp"
+
+/******************************************************************************
+* This is a port of the scheme modules (convert tools output) and
+* (convert html htmlout), which accumulate the whole document as a list
+* of strings; here the output is written to the sink as it is produced
+******************************************************************************/
+
+struct html_serializer {
+  tm_ostream& out;
+  int    indentation;
+  int    count;
+  bool   start_flag;
+  bool   space_flag;
+  bool   break_flag;
+  string tail;
+  int    line_length;
+  bool   preformatted;
+
+  html_serializer (tm_ostream& out2):
+    out (out2), indentation (0), count (0),
+    start_flag (true), space_flag (false), break_flag (true),
+    tail (""), line_length (79), preformatted (false) {}
+
+  // output machinery
+  void output_return ();
+  void output_raw (string s);
+  void output_prepared (string s);
+  void output_flush ();
+  void output_indent (int plus);
+  void output_lf ();
+  void output_lf_verbatim (string s);
+  void output_verbatim (string s);
+  void output_text (string s);
+
+  // html
+  void htmlout_indent (string s, int plus, bool close);
+  void htmlout_text (string s);
+  void htmlout_open (string s);
+  void htmlout_open_tags (string s, tree atts);
+  void htmlout_close (string s);
+  void htmlout_args (tree x, int start);
+  void htmlout_doctype (tree x);
+  void htmlout (tree x);
+};
+
+/******************************************************************************
+* The output machinery
+******************************************************************************/
+
+void
+html_serializer::output_return () {
+  start_flag= true;
+  int indent= max (0, min (40, indentation));
+  string s ("\n");
+  for (int i=0; i<indent; i++) s << ' ';
+  out << s;
+  count= indent;
+}
+
+void
+html_serializer::output_raw (string s) {
+  if (N(s) == 0) return;
+  start_flag= false;
+  break_flag= true;
+  out << s;
+}
+
+void
+html_serializer::output_prepared (string s) {
+  if (N(s) == 0 && !space_flag) return;
+  if (space_flag) count++;
+  count += N(s);
+  if (space_flag) break_flag= true;
+  if (count < line_length || start_flag || !break_flag) {
+    if (space_flag && !start_flag) output_raw (" ");
+    output_raw (s);
+  }
+  else {
+    output_return ();
+    count += N(s);
+    output_raw (s);
+  }
+  space_flag= false;
+}
+
+void
+html_serializer::output_flush () {
+  output_prepared (tail);
+  tail= "";
+}
+
+void
+html_serializer::output_indent (int plus) {
+  output_flush ();
+  indentation += plus;
+}
+
+void
+html_serializer::output_lf () {
+  if (N(tail) != 0) output_flush ();
+  output_return ();
+}
+
+void
+html_serializer::output_lf_verbatim (string s) {
+  output_flush ();
+  if (!start_flag) output_raw ("\n");
+  output_raw (s);
+  break_flag= false;
+}
+
+void
+html_serializer::output_verbatim (string s) {
+  output_flush ();
+  output_raw (s);
+  break_flag= false;
+}
+
+void
+html_serializer::output_text (string s) {
+  // break the text into words which may be wrapped
+  if (N(tail) != 0) s= tail * s;
+  int i= 0;
+  while (true) {
+    int pos= search_forwards (' ', i, N(s), s);
+    if (pos < i) break;
+    output_prepared (s (i, pos));
+    space_flag= true;
+    i= pos + 1;
+  }
+  tail= s (i, N(s));
+}
+
+/******************************************************************************
+* Outputting the main flow
+******************************************************************************/
+
+static bool
+htmlout_is_big_all (tree t) {
+  if (!is_atomic (t)) return false;
+  string s= t->label;
+  return s == "html" || s == "head" || s == "style" || s == "body" ||
+         s == "table" || s == "tr" || s == "ul" || s == "ol" ||
+         s == "dl" || s == "mtable" || s == "mtr";
+}
+
+static bool
+htmlout_is_big_tag (tree t) {
+  if (htmlout_is_big_all (t)) return true;
+  if (!is_atomic (t)) return false;
+  string s= t->label;
+  return s == "div" || s == "p" || s == "li" || s == "dt" || s == "dd" ||
+         s == "center" || s == "blockquote";
+}
+
+static bool
+htmlout_is_big (tree x) {
+  if (!is_tuple (x) || N(x) == 0) return false;
+  if (htmlout_is_big_all (x[0])) return true;
+  if (!htmlout_is_big_tag (x[0])) return false;
+  for (int i=1; i<N(x); i++)
+    if (is_tuple (x[i]) && N(x[i]) > 0 && htmlout_is_big_tag (x[i][0]))
+      return true;
+  return false;
+}
+
+static bool
+htmlout_p_simplify (tree x) {
+  if (!is_tuple (x, "p", 1) || !is_tuple (x[1]) || N(x[1]) == 0) return false;
+  tree h= x[1][0];
+  if (!is_atomic (h)) return false;
+  string s= h->label;
+  return s == "div" || s == "p" || s == "li" || s == "dt" || s == "dd" ||
+         s == "center" || s == "blockquote" ||
+         s == "ul" || s == "ol" || s == "dl";
+}
+
+static string
+htmlout_string (tree t) {
+  if (!is_atomic (t)) return "";
+  if (is_quoted (t->label)) return scm_unquote (t->label);
+  return t->label;
+}
+
+void
+html_serializer::htmlout_indent (string s, int plus, bool close) {
+  if (preformatted) return;
+  if (htmlout_is_big_tag (s)) {
+    output_indent (plus);
+    output_lf ();
+  }
+  else if (s == "pre" && !close) output_lf_verbatim ("");
+}
+
+void
+html_serializer::htmlout_text (string s) {
+  if (preformatted) output_verbatim (s);
+  else output_text (s);
+}
+
+void
+html_serializer::htmlout_open (string s) {
+  htmlout_text ("<" * s * ">");
+  htmlout_indent (s, 2, false);
+}
+
+void
+html_serializer::htmlout_open_tags (string s, tree atts) {
+  // the first occurrence of an attribute determines its position,
+  // the last one its value
+  array<string> names;
+  hashmap<string,string> vals ("");
+  for (int i=1; i<N(atts); i++) {
+    tree att= atts[i];
+    if (!is_tuple (att) || N(att) < 2 || !is_atomic (att[0])) continue;
+    string name= htmlout_string (att[0]);
+    if (!vals->contains (name)) names << name;
+    vals (name)= htmlout_string (att[1]);
+  }
+  htmlout_text ("<" * s);
+  for (int i=0; i<N(names); i++) {
+    string val= vals[names[i]];
+    if (val == "<implicit>") output_text (" " * names[i]);
+    else {
+      output_text (" " * names[i] * "=");
+      output_verbatim ("\"" * val * "\"");
+    }
+  }
+  htmlout_text (">");
+  htmlout_indent (s, 2, false);
+}
+
+void
+html_serializer::htmlout_close (string s) {
+  htmlout_indent (s, -2, true);
+  htmlout_text ("</" * s * ">");
+}
+
+void
+html_serializer::htmlout_args (tree x, int start) {
+  bool big= htmlout_is_big (x);
+  for (int i=start; i<N(x); i++) {
+    htmlout (x[i]);
+    if (big && i+1 < N(x)) output_lf ();
+  }
+}
+
+void
+html_serializer::htmlout_doctype (tree x) {
+  string s= "<!DOCTYPE";
+  for (int i=1; i<N(x); i++)
+    if (is_atomic (x[i])) {
+      if (is_quoted (x[i]->label))
+        s << " \"" << scm_unquote (x[i]->label) << "\"";
+      else s << " " << x[i]->label;
+    }
+  output_lf_verbatim (s * ">");
+  output_lf ();
+}
+
+void
+html_serializer::htmlout (tree x) {
+  if (is_atomic (x)) htmlout_text (htmlout_string (x));
+  else if (N(x) == 0 || !is_atomic (x[0])) return;
+  else if (is_tuple (x, "!concat") || is_tuple (x, "*TOP*"))
+    for (int i=1; i<N(x); i++) htmlout (x[i]);
+  else if (htmlout_p_simplify (x)) htmlout (x[1]);
+  else if (is_tuple (x, "*PI*") && N(x) >= 3) {
+    output_lf_verbatim ("<?" * htmlout_string (x[1]) *
+                        " " * htmlout_string (x[2]) * "?>");
+    output_lf ();
+  }
+  else if (is_tuple (x, "*DOCTYPE*")) htmlout_doctype (x);
+  else {
+    string s= x[0]->label;
+    if (N(x) == 1) {
+      htmlout_open (s);
+      htmlout_close (s);
+    }
+    else if (!is_tuple (x[1]) || N(x[1]) == 0 || x[1][0] != "@") {
+      htmlout_open (s);
+      htmlout_args (x, 1);
+      htmlout_close (s);
+    }
+    else {
+      tree atts= x[1];
+      htmlout_open_tags (s, atts);
+      bool saved= preformatted;
+      for (int i=1; i<N(atts); i++)
+        if (is_tuple (atts[i], "xml:space", 1)) {
+          string val= htmlout_string (atts[i][1]);
+          if (val == "preserve") preformatted= true;
+          else if (val == "default") preformatted= false;
+          break;
+        }
+      htmlout_args (x, 2);
+      preformatted= saved;
+      htmlout_close (s);
+    }
+  }
+}
+
+/******************************************************************************
+* Interface
+******************************************************************************/
+
+string
+serialize_html (scheme_tree t) {
+  tm_ostream out (tm_new<tm_ostream_rep> ());
+  out.buffer ();
+  {
+    html_serializer ser (out);
+    ser.htmlout (t);
+    ser.output_flush ();
+  }
+  return out.unbuffer ();
+}
+
+bool
+serialize_html (scheme_tree t, url u) {
+  // returns true on error
+  c_string name (concretize (u));
+  tm_ostream out= file_ostream ((char*) name);
+  if (!out->is_writable ()) return true;
+  html_serializer ser (out);
+  ser.htmlout (t);
+  ser.output_flush ();
+  out.flush ();
+  return !out->is_writable ();
+}
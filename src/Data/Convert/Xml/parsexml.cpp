@@ -13,6 +13,7 @@
 #include "hashset.hpp"
 #include "converter.hpp"
 #include "parse_string.hpp"
+#include "Xml/xml_handler.hpp"
 
 #define xml_quote scm_quote
 // FIXME: to be checked that this is the correct quoting style
@@ -25,12 +26,14 @@
 * should be parsed correctly and incorrect documents are transformed into
 * correct documents in a heuristic way.
 *
-* The parser proceeds in three steps: the first pass does all parsing
+* The parser proceeds in three stages: the first one does all parsing
 * except for the construction of a tree structure for nested tags.
 * The second stage takes care of the nesting, while heuristically
 * correcting improper nested trees, and while taking care of optional
-* closing tags in the case of Html. The last stage does some final
-* white space and entity cleanup.
+* closing tags in the case of Html. The last stage reports the corrected
+* document to an xml_handler, which may build the sxml tree. The stages
+* are interleaved: tokens are produced on demand and forgotten once they
+* have been reported, so that the document is never materialized twice.
 *
 * Present limitations: we do not fully parse <!DOCTYPE ...> constructs yet.
 * Entities which are present in the DOCTYPE definition of the document
@@ -43,8 +46,9 @@ struct xml_html_parser {
   parse_string s;
   hashmap<string,string> entities;
   array<tree> a;
-  int i, n;
+  int i;
   tree stack;
+  xml_handler* h;
 
   xml_html_parser ();
   inline void skip_space () {
@@ -69,7 +73,8 @@ struct xml_html_parser {
   tree parse_comment ();
   tree parse_cdata ();
   tree parse_misc ();
-  void parse ();
+  void parse_token ();
+  bool fetch ();
 
   tree parse_system ();
   tree parse_public ();
@@ -87,10 +92,10 @@ struct xml_html_parser {
   bool build_valid_child (string parent, string child);
   bool build_must_close (string tag);
   bool build_can_close (string tag);
-  void build (tree& r);
+  void build ();
+  void report (tree t);
 
-  tree finalize_sxml (tree t);
-  tree parse (string s);
+  void parse (string s, xml_handler& h);
 };
 
 /******************************************************************************
@@ -311,9 +316,12 @@ xml_html_parser::expand_entity (string s) {
 
 string
 xml_html_parser::expand_entities (string s) {
-  string r;
   int i, n= N(s);
-  for (i=0; i<n; ) {
+  for (i=0; i<n; i++)
+    if (s[i] == '&' || s[i] == '%') break;
+  if (i == n) return s;
+  string r= s (0, i);
+  while (i<n) {
     if (s[i] == '&' || s[i] == '%') {
       int start= i++;
       if (i<n && s[i] == '#') {
@@ -452,24 +460,36 @@ xml_html_parser::parse_misc () {
 }
 
 void
-xml_html_parser::parse () {
-  string r;
-  while (s) {
-    if (s[0] == '<') {
-      if (N(r) != 0) { a << tree (r); }
-      if (test (s, "</")) a << parse_closing ();
-      else if (test (s, "<?")) a << parse_pi ();
-      else if (test (s, "<!--")) a << parse_comment ();
-      else if (test (s, "<![CDATA[")) a << parse_cdata ();
-      else if (test (s, "<!DOCTYPE")) a << parse_doctype ();
-      else if (test (s, "<!")) a << parse_misc ();
-      else a << parse_opening ();
-      r= "";
+xml_html_parser::parse_token () {
+  if (s[0] == '<') {
+    if (test (s, "</")) a << parse_closing ();
+    else if (test (s, "<?")) a << parse_pi ();
+    else if (test (s, "<!--")) a << parse_comment ();
+    else if (test (s, "<![CDATA[")) a << parse_cdata ();
+    else if (test (s, "<!DOCTYPE")) a << parse_doctype ();
+    else if (test (s, "<!")) a << parse_misc ();
+    else a << parse_opening ();
+  }
+  else {
+    string r;
+    while (s && s[0] != '<') {
+      if (s[0] == '&') r << parse_entity ();
+      else r << s->read (1);
     }
-    else if (s[0] == '&') r << parse_entity ();
-    else r << s->read (1);
+    if (N(r) != 0) a << tree (r);
   }
-  if (N(r) != 0) a << tree (r);
+}
+
+bool
+xml_html_parser::fetch () {
+  // make a[i] the next token, reading it from the input if necessary
+  while (i >= N(a)) {
+    if (!s) return false;
+    a= array<tree> ();
+    i= 0;
+    parse_token ();
+  }
+  return true;
 }
 
 /******************************************************************************
@@ -635,32 +655,51 @@ xml_html_parser::build_can_close (string tag) {
   return false;
 }
 
+static tree
+build_attributes (tree t) {
+  tree r (TUPLE);
+  for (int k=2; k<N(t); k++)
+    if (is_tuple (t[k], "attr", 1)) r << tuple (t[k][1]);
+    else if (is_tuple (t[k], "attr", 2)) r << tuple (t[k][1], t[k][2]);
+  return r;
+}
+
 void
-xml_html_parser::build (tree& r) {
-  while (i<n) {
+xml_html_parser::build () {
+  while (!h->stop && fetch ()) {
     if (is_tuple (a[i], "begin")) {
       string name= a[i][1]->label;
       if (build_must_close (name)) return;
-      tree sub= copy (a[i]); sub[0]= "tag";
+      h->start_element (name, build_attributes (a[i]));
       i++;
-      if (html && html_empty_tag_table->contains (name))
-        r << sub;
-      else {
+      if (!html || !html_empty_tag_table->contains (name)) {
         stack= tuple (name, stack);
-        build (sub);
-        r << sub;
+        build ();
         stack= stack[1];
       }
+      h->end_element (name);
     }
     else if (is_tuple (a[i], "end")) {
       if (stack[0]->label == a[i][1]->label) { i++; return; }
       if (build_can_close (a[i][1]->label)) return;
       i++;
     }
-    else r << a[i++];
+    else report (a[i++]);
   }
 }
 
+void
+xml_html_parser::report (tree t) {
+  if (is_atomic (t)) h->text (t->label);
+  else if (is_tuple (t, "tag")) {
+    h->start_element (t[1]->label, build_attributes (t));
+    h->end_element (t[1]->label);
+  }
+  else if (is_tuple (t, "pi")) h->pi (t[1]->label, t[2]->label);
+  else if (is_tuple (t, "doctype")) h->doctype (t[1]->label);
+  else if (is_tuple (t, "cdata")) h->cdata (t[1]->label);
+}
+
 /******************************************************************************
 * Finalization
 ******************************************************************************/
@@ -719,47 +758,51 @@ xml_html_parser::finalize_space (tree t) {
   }
 }
 
-tree
-xml_html_parser::finalize_sxml (tree t) {
-  if (!is_tuple (t, "tag")) return ""; // sanity
-  int i, n= N(t);
-  tree tag = tuple (t[1]);
-  if (t[1] == "<document>") tag= tuple ("*TOP*");
-  tree attrs = tuple ("@");
-  tree content = tuple ();
-  for (i=2; i<n; i++)
-    if (is_tuple (t[i], "attr")) {
-      tree attr;
-      if (N(t[i]) == 2) attr= tuple (t[i][1]);
-      else attr= tuple (t[i][1]->label, xml_quote (t[i][2]->label));
-      attrs << attr;
+/******************************************************************************
+* Building sxml trees
+******************************************************************************/
+
+struct sxml_builder: public xml_handler {
+  array<tree> stack;
+
+  sxml_builder () { stack << tuple ("*TOP*"); }
+  inline void append (tree t) { stack[N(stack)-1] << t; }
+
+  void start_element (string name, tree attrs) {
+    tree tag= tuple (name);
+    if (N(attrs) > 0) {
+      tree r= tuple ("@");
+      for (int k=0; k<N(attrs); k++)
+        if (N(attrs[k]) == 1) r << tuple (attrs[k][0]);
+        else r << tuple (attrs[k][0]->label, xml_quote (attrs[k][1]->label));
+      tag << r;
     }
-    else if (is_tuple (t[i], "tag"))
-      content << finalize_sxml (t[i]);
-    else if (is_atomic (t[i]))
-      content << xml_quote (t[i]->label);
-    else if (is_tuple (t[i], "pi"))
-      content << tuple ("*PI*", t[i][1]->label, xml_quote (t[i][2]->label));
-    else if (is_tuple (t[i], "doctype"))
-      // TODO: convert DTD declarations
-      content << tuple ("*DOCTYPE*", xml_quote (t[i][1]->label));
-    else if (is_tuple (t[i], "cdata"))
-      content << xml_quote (t[i][1]->label);
-
-  if (N(attrs) > 1) tag << attrs;
-  tag << A(content);
-  return tag;
-}
+    stack << tag;
+  }
+  void end_element (string name) {
+    (void) name;
+    tree tag= stack[N(stack)-1];
+    stack->resize (N(stack)-1);
+    append (tag);
+  }
+  void text (string s) { append (xml_quote (s)); }
+  void pi (string target, string data) {
+    append (tuple ("*PI*", target, xml_quote (data))); }
+  void doctype (string name) {
+    // TODO: convert DTD declarations
+    append (tuple ("*DOCTYPE*", xml_quote (name))); }
+};
 
 /******************************************************************************
 * Building the structured parse tree with error correction
 ******************************************************************************/
 
-tree
-xml_html_parser::parse (string s2) {
+void
+xml_html_parser::parse (string s2, xml_handler& h2) {
   // end of line handling
   string s3;
-  i= 0, n= N(s2);
+  int n= N(s2);
+  i= 0;
   bool is_cr= false;
   while (i<n) {
     bool prev_is_cr= is_cr;
@@ -780,36 +823,41 @@ xml_html_parser::parse (string s2) {
   // cout << HRULE << LF;
   s= parse_string (s2);
   //cout << "Parsing " << s << "\n";
-  parse ();
-  // cout << HRULE << LF;
-  // cout << "a= " << a << "\n";
-  i= 0; n= N(a); stack= tuple ("<bottom>");
-  tree r= tuple ("tag", "<document>");
-  build (r);
-  // cout << HRULE << LF;
-  // print_tree (r);
-  r= finalize_sxml (r);
-  // cout << HRULE << LF;
-  // print_tree (r);
-  return r;
+  h= &h2;
+  a= array<tree> ();
+  i= 0;
+  stack= tuple ("<bottom>");
+  build ();
 }
 
 /******************************************************************************
 * Interface
 ******************************************************************************/
 
-tree
-parse_xml (string s) {
+void
+parse_xml (string s, xml_handler& h) {
   xml_html_parser parser;
   parser.html= false;
-  tree t= parser.parse (s);
-  return t;
+  parser.parse (s, h);
 }
 
-tree
-parse_plain_html (string s) {
+void
+parse_plain_html (string s, xml_handler& h) {
   xml_html_parser parser;
   parser.html= true;
-  tree t= parser.parse (s);
-  return t;
+  parser.parse (s, h);
+}
+
+tree
+parse_xml (string s) {
+  sxml_builder builder;
+  parse_xml (s, builder);
+  return builder.stack[0];
+}
+
+tree
+parse_plain_html (string s) {
+  sxml_builder builder;
+  parse_plain_html (s, builder);
+  return builder.stack[0];
 }
@@ -11,6 +11,7 @@
 
 #include "convert.hpp"
 #include "analyze.hpp"
+#include "Xml/xml_handler.hpp"
 
 tree find_first_element_by_name (tree t, string name) {
   if (!is_tuple (t)) return tree();
@@ -27,6 +28,33 @@ tree find_first_element_by_name (tree t, string name) {
   return tree();
 }
 
+struct first_element_handler: public xml_handler {
+  string name;
+  tree   result;
+
+  first_element_handler (string name2): name (name2), result () {}
+  void start_element (string tag, tree attrs) {
+    if (tag != name) return;
+    result= tuple (tag);
+    tree r= tuple ("@");
+    for (int i=0; i<N(attrs); i++)
+      if (N(attrs[i]) == 1) r << tuple (attrs[i][0]);
+      else r << tuple (attrs[i][0]->label, scm_quote (attrs[i][1]->label));
+    if (N(r) > 1) result << r;
+    stop= true;
+  }
+  void end_element (string tag) { (void) tag; }
+  void text (string s) { (void) s; }
+};
+
+tree parse_xml_element (string s, string name) {
+  // parse s only until the first element with the given name,
+  // whose attributes are returned as for find_first_element_by_name
+  first_element_handler h (name);
+  parse_xml (s, h);
+  return h.result;
+}
+
 string get_attr_from_element (tree t, string name, string default_value) {
   for (int i=1; i<N(t); i++)
     if (is_tuple (t[i]) && t[i][0]->label == "@") {
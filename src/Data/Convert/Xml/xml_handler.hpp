@@ -0,0 +1,43 @@
+
+/******************************************************************************
+* MODULE     : xml_handler.hpp
+* DESCRIPTION: event driven parsing of xml and html documents
+* COPYRIGHT  : (C) 2020  Joris van der Hoeven
+*******************************************************************************
+* This software falls under the GNU general public license version 3 or later.
+* It comes WITHOUT ANY WARRANTY WHATSOEVER. For details, see the file LICENSE
+* in the root directory or <http://www.gnu.org/licenses/gpl-3.0.html>.
+******************************************************************************/
+
+#ifndef XML_HANDLER_H
+#define XML_HANDLER_H
+#include "tree.hpp"
+
+/******************************************************************************
+* The parser reports the structure of the document to an xml_handler while
+* it reads the input, without materializing the document. The events are
+* those of the corrected document: tags are properly nested, also for Html.
+* Attributes are passed as a tuple of tuples (name) or (name value).
+* Strings are passed with the entities expanded and without quoting.
+* Comments and markup declarations are not reported.
+******************************************************************************/
+
+class xml_handler {
+public:
+  bool stop;  // may be set by the handler in order to abort the parsing
+
+  inline xml_handler (): stop (false) {}
+  inline virtual ~xml_handler () {}
+
+  virtual void start_element (string name, tree attrs) = 0;
+  virtual void end_element (string name) = 0;
+  virtual void text (string s) = 0;
+  virtual void cdata (string s) { text (s); }
+  virtual void pi (string target, string data) { (void) target; (void) data; }
+  virtual void doctype (string name) { (void) name; }
+};
+
+void parse_xml (string s, xml_handler& h);
+void parse_plain_html (string s, xml_handler& h);
+
+#endif // defined XML_HANDLER_H
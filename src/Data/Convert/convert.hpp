@@ -13,9 +13,11 @@
 #define CONVERT_H
 #include "analyze.hpp"
 #include "hashmap.hpp"
+#include "path.hpp"
 typedef tree scheme_tree;
 class url;
 class object;
+class mapped_string;
 
 /*** Miscellaneous ***/
 bool   is_snippet (tree doc);
@@ -28,6 +30,8 @@ string format_to_suffix (string format);
 string get_format (string s, string suffix);
 tree   generic_to_tree (string s, string format);
 string tree_to_generic (tree doc, string format);
+void   reset_conversion_caches ();
+void   print_conversion_statistics ();
 array<string> compute_keys (string s, string fm);
 array<string> compute_keys (tree t, string fm);
 array<string> compute_keys (url u);
@@ -37,8 +41,14 @@ scheme_tree compute_index (url u);
 
 /*** Texmacs ***/
 tree   texmacs_to_tree (string s);
-tree   texmacs_document_to_tree (string s);
+tree   texmacs_document_to_tree (string s, bool share= false);
+tree   texmacs_document_to_tree (mapped_string s, bool share= false);
+typedef void (*tm_stream_routine) (void* obj, path p, tree t);
+tree   texmacs_stream_to_tree (url u, tm_stream_routine routine, void* obj);
 string tree_to_texmacs (tree t);
+string tree_to_binary (tree t);
+tree   binary_to_tree (string s);
+bool   is_binary_tree (string s);
 tree   extract (tree doc, string attr);
 tree   extract_document (tree doc);
 tree   change_doc_attr (tree doc, string attr, tree val);
@@ -56,6 +66,7 @@ string scheme_tree_to_string (scheme_tree t);
 string scheme_tree_to_block (scheme_tree t);
 scheme_tree tree_to_scheme_tree (tree t);
 string tree_to_scheme (tree t);
+void   tree_to_scheme (string& out, tree t);
 scheme_tree string_to_scheme_tree (string s);
 scheme_tree block_to_scheme_tree  (string s);
 tree   scheme_tree_to_tree (scheme_tree t);
@@ -104,17 +115,23 @@ string xml_unspace (string s, bool first, bool last);
 tree   parse_xml (string s);
 tree   parse_plain_html (string s);
 tree   parse_html (string s);
+string serialize_html (scheme_tree t);
+bool   serialize_html (scheme_tree t, url u);
 tree   clean_html (tree t);
 tree   tmml_upgrade (scheme_tree t);
 tree   upgrade_mathml (tree t);
 tree   retrieve_mathjax (int id);
 
 tree   find_first_element_by_name (tree t, string name);
+tree   parse_xml_element (string s, string name);
 string get_attr_from_element (tree t, string name, string default_value);
 int    parse_xml_length (string length);
 
 /*** BibTeX ***/
 tree   parse_bib (string s);
+tree   parse_bib (mapped_string s);
+tree   parse_bib_entries (url u, array<string> keys);
+array<string> bib_entry_keys (url u);
 tree   conservative_bib_import (string olds, tree oldt, string news);
 string conservative_bib_export (tree oldt, string olds, tree newt);
 
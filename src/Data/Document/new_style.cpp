@@ -27,6 +27,9 @@ struct style_data_rep {
   drd_info drd_void;
   hashmap<tree,hashmap<string,tree> > style_cached;
   hashmap<tree,drd_info> drd_cached;
+  hashmap<tree,tree> style_depends;
+  bool collecting;
+  tree collected;
 
   style_data_rep ():
     style_cache (hashmap<string,tree> (UNINIT)),
@@ -35,7 +38,10 @@ struct style_data_rep {
     style_void (UNINIT),
     drd_void ("void"),
     style_cached (style_void),
-    drd_cached (drd_void) {}
+    drd_cached (drd_void),
+    style_depends (tree (TUPLE)),
+    collecting (false),
+    collected (TUPLE) {}
 };
 
 static style_data_rep* sd= NULL;
@@ -98,17 +104,39 @@ style_invalidate_cache () {
   remove ("$TEXMACS_HOME_PATH/system/cache" * url_wildcard ("__*"));
 }
 
+void
+style_declare_dependency (url u) {
+  // called for each package file which is read during a style computation
+  if (sd == NULL || !sd->collecting || is_none (u)) return;
+  tree dep= tuple (as_string (u), as_string (last_modified (u, false)));
+  for (int i=0; i<N(sd->collected); i++)
+    if (sd->collected[i] == dep) return;
+  sd->collected << dep;
+}
+
+static bool
+style_dependencies_up_to_date (tree deps) {
+  if (!is_tuple (deps)) return false;
+  for (int i=0; i<N(deps); i++)
+    if (!is_tuple (deps[i]) || N(deps[i]) != 2 || !is_atomic (deps[i][0]))
+      return false;
+    else if (as_string (last_modified (url (as_string (deps[i][0])), false))
+             != deps[i][1]) return false;
+  return true;
+}
+
 void
 style_set_cache (tree style, hashmap<string,tree> H, tree t) {
   init_style_data ();
   // cout << "set cache " << style << LF;
   sd->style_cache (copy (style))= H;
   sd->style_drd   (copy (style))= t;
+  // the package files and their modification times are stored along,
+  // so that the cache remains valid between sessions until a package changes
   url name ("$TEXMACS_HOME_PATH/system/cache", cache_file_name (style));
-  if (!exists (name)) {
-    save_string (name, tree_to_scheme (tuple ((tree) H, t)));
-    // cout << "saved " << name << LF;
-  }
+  tree deps= sd->style_depends [style];
+  save_string (name, tree_to_binary (tuple ((tree) H, t, deps)));
+  // cout << "saved " << name << LF;
 }
 
 void
@@ -126,11 +154,14 @@ style_get_cache (tree style, hashmap<string,tree>& H, tree& t, bool& f) {
     url name ("$TEXMACS_HOME_PATH/system/cache", cache_file_name (style));
     if (exists (name) && (!load_string (name, s, false))) {
       //cout << "loaded " << name << LF;
-      tree p= scheme_to_tree (s);
+      tree p= binary_to_tree (s);
+      if (!is_tuple (p) || N(p) != 3 ||
+          !style_dependencies_up_to_date (p[2])) return;
       H= hashmap<string,tree> (UNINIT, p[0]);
       t= p[1];
-      sd->style_cache (copy (style))= H;
-      sd->style_drd   (copy (style))= t;
+      sd->style_cache   (copy (style))= H;
+      sd->style_drd     (copy (style))= t;
+      sd->style_depends (copy (style))= p[2];
       f= true;
     }
   }
@@ -172,9 +203,19 @@ compute_env_and_drd (tree style) {
       drd->set_environment (H);
     }
     if (!ok) {
+      bool old_collecting= sd->collecting;
+      tree old_collected = sd->collected;
+      sd->collecting= true;
+      sd->collected = tree (TUPLE);
       env->exec (tree (USE_PACKAGE, A (style)));
       env->read_env (H);
       drd->heuristic_init (H);
+      sd->style_depends (style)= sd->collected;
+      // the packages of a nested style are also dependencies of the outer style
+      for (int i=0; i<N(sd->collected); i++)
+        if (old_collecting) old_collected << sd->collected[i];
+      sd->collecting= old_collecting;
+      sd->collected = old_collected;
     }
     sd->style_cached (style)= H;
     sd->drd_cached (style)= drd;
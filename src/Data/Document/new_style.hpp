@@ -17,6 +17,7 @@
 tree preprocess_style (tree st, url name);
 
 void style_invalidate_cache ();
+void style_declare_dependency (url u);
 void style_set_cache (tree style, hashmap<string,tree> H, tree t);
 void style_get_cache (tree style, hashmap<string,tree>& H, tree& t, bool& f);
 
@@ -15,15 +15,20 @@
 #include "drd_mode.hpp"
 #include "iterator.hpp"
 #include "analyze.hpp"
+#include "hashset.hpp"
 
 /******************************************************************************
 * Constructors and basic operations
 ******************************************************************************/
 
 drd_info_rep::drd_info_rep (string name2):
-  name (name2), info (tag_info ()), env (UNINIT) {}
+  name (name2), info (tag_info ()), env (UNINIT),
+  heuristic_defs (UNINIT), heuristic_infos (tag_info ()),
+  heuristic_mode (-1) {}
 drd_info_rep::drd_info_rep (string name2, drd_info base):
-  name (name2), info (tag_info (), base->info), env (UNINIT) {}
+  name (name2), info (tag_info (), base->info), env (UNINIT),
+  heuristic_defs (UNINIT), heuristic_infos (tag_info ()),
+  heuristic_mode (-1) {}
 drd_info::drd_info (string name):
   rep (tm_new<drd_info_rep> (name)) {}
 drd_info::drd_info (string name, drd_info base):
@@ -1008,32 +1013,123 @@ drd_info_rep::heuristic_init_parameter (string var, tree val) {
   return (old_ti != info[l]);
 }
 
+bool
+drd_info_rep::heuristic_init (string var, tree val) {
+  if (is_atomic (val))
+    return heuristic_init_parameter (var, val->label);
+  else if (is_func (val, MACRO))
+    return heuristic_init_macro (var, val);
+  else if (is_func (val, XMACRO))
+    return heuristic_init_xmacro (var, val);
+  else
+    return heuristic_init_parameter (var, val);
+}
+
+static void
+heuristic_depends (hashset<tree_label>& deps, tree t) {
+  // the tags whose information is used for the heuristic of a definition
+  if (is_atomic (t)) return;
+  deps->insert (L(t));
+  if (N(t) >= 1 && is_atomic (t[0])) {
+    if (is_func (t, COMPOUND))
+      deps->insert (make_tree_label (t[0]->label));
+    else if (is_func (t, EXTERN))
+      deps->insert (make_tree_label ("extern:" * t[0]->label));
+    else if (is_func (t, MAP_ARGS) && N(t) >= 2 && is_atomic (t[1])) {
+      deps->insert (make_tree_label (t[0]->label));
+      deps->insert (make_tree_label (t[1]->label));
+    }
+  }
+  for (int i=0; i<N(t); i++)
+    heuristic_depends (deps, t[i]);
+}
+
+void
+drd_info_rep::heuristic_depends (string var, tree val) {
+  hashset<tree_label> deps;
+  ::heuristic_depends (deps, val);
+  iterator<tree_label> it= iterate (deps);
+  while (it->busy ()) {
+    tree_label l= it->next ();
+    array<string> users= heuristic_users [l];
+    int i, n= N(users);
+    for (i=0; i<n; i++)
+      if (users[i] == var) break;
+    if (i == n) {
+      if (!heuristic_users->contains (l)) heuristic_users (l)= array<string> ();
+      heuristic_users (l) << var;
+    }
+  }
+}
+
 void
 drd_info_rep::heuristic_init (hashmap<string,tree> env2) {
+  // only the definitions which changed since the last call and
+  // the definitions which depend on modified tags are reconsidered
   // time_t tt= texmacs_time ();
   set_environment (env2);
-  bool flag= true;
+  if (heuristic_mode != get_access_mode ()) {
+    heuristic_defs = hashmap<string,tree> (UNINIT);
+    heuristic_infos= hashmap<tree_label,tag_info> (tag_info ());
+    heuristic_users= hashmap<tree_label,array<string> > ();
+    heuristic_mode = get_access_mode ();
+  }
+
+  hashset<string> todo;
+  iterator<string> it= iterate (env);
+  while (it->busy()) {
+    string var= it->next();
+    tree   val= env[var];
+    if (!heuristic_defs->contains (var) || heuristic_defs[var] != val) {
+      // the definitions might be modified in place later on
+      heuristic_defs (var)= copy (val);
+      heuristic_depends (var, val);
+      todo->insert (var);
+    }
+  }
+  iterator<tree_label> lt= iterate (heuristic_infos);
+  while (lt->busy()) {
+    tree_label l= lt->next();
+    if (info[l] != heuristic_infos[l]) {
+      if (env->contains (as_string (l))) todo->insert (as_string (l));
+      array<string> users= heuristic_users[l];
+      for (int i=0; i<N(users); i++) todo->insert (users[i]);
+    }
+  }
+
   int round= 0;
-  while (flag) {
+  while (N(todo) != 0) {
     // cout << HRULE;
-    flag= false;
-    iterator<string> it= iterate (env);
-    while (it->busy()) {
-      string var= it->next();
-      tree   val= env[var];
-      if (is_atomic (val))
-        flag= heuristic_init_parameter (var, val->label) | flag;
-      else if (is_func (val, MACRO))
-        flag= heuristic_init_macro (var, val) | flag;
-      else if (is_func (val, XMACRO))
-        flag= heuristic_init_xmacro (var, val) | flag;
-      else
-        flag= heuristic_init_parameter (var, val) | flag;
+    hashset<string> next;
+    iterator<string> jt= iterate (todo);
+    while (jt->busy()) {
+      string var= jt->next();
+      if (!env->contains (var)) continue;
+      tree_label l= make_tree_label (var);
+      if (heuristic_init (var, env[var])) {
+        next->insert (var);
+        array<string> users= heuristic_users[l];
+        for (int i=0; i<N(users); i++) next->insert (users[i]);
+      }
     }
+    todo= next;
     if ((round++) == 10) {
       cout << "TeXmacs] Warning: bad heuristic drd convergence\n";
-      flag= false;
+      break;
     }
   }
+
+  it= iterate (heuristic_defs);
+  while (it->busy()) {
+    tree_label l= make_tree_label (it->next());
+    if (!heuristic_infos->contains (l) || heuristic_infos[l] != info[l])
+      heuristic_infos (l)= copy (info[l]);
+  }
+  lt= iterate (heuristic_users);
+  while (lt->busy()) {
+    tree_label l= lt->next();
+    if (!heuristic_infos->contains (l) || heuristic_infos[l] != info[l])
+      heuristic_infos (l)= copy (info[l]);
+  }
   // cout << "--> " << (texmacs_time ()-tt) << "ms\n";
 }
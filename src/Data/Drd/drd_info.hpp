@@ -22,6 +22,12 @@ public:
   rel_hashmap<tree_label,tag_info> info;
   hashmap<string,tree> env;
 
+  // state of the last heuristic initialization
+  hashmap<string,tree> heuristic_defs;        // the handled definitions
+  hashmap<tree_label,tag_info> heuristic_infos; // the resulting tag infos
+  hashmap<tree_label,array<string> > heuristic_users; // dependent definitions
+  int heuristic_mode;                         // the access mode
+
 public:
   drd_info_rep (string name);
   drd_info_rep (string name, drd_info base);
@@ -125,6 +131,8 @@ public:
   bool heuristic_init_xmacro (string var, tree xmacro);
   bool heuristic_init_parameter (string var, string val);
   bool heuristic_init_parameter (string var, tree val);
+  bool heuristic_init (string var, tree val);
+  void heuristic_depends (string var, tree val);
   void heuristic_init (hashmap<string,tree> env);
 
   friend class drd_info;
@@ -12,6 +12,7 @@
 #include "archiver.hpp"
 #include "hashset.hpp"
 #include "iterator.hpp"
+#include "scheme.hpp"
 
 extern tree the_et;
 array<patch> singleton (patch p);
@@ -31,6 +32,8 @@ archiver_rep::archiver_rep (double author, path rp2):
   depth (0),
   last_save (0),
   last_autosave (0),
+  dropped (0),
+  open_marks (0),
   the_author (author),
   the_owner (0),
   rp (rp2),
@@ -58,6 +61,8 @@ archiver_rep::clear () {
   current= make_compound (0);
   the_owner= 0;
   depth= 0;
+  dropped= 0;
+  open_marks= 0;
   last_save= -1;
   last_autosave= -1;
 }
@@ -276,6 +281,7 @@ archiver_rep::normalize () {
 
 void
 archiver_rep::add (modification m) {
+  MEM_TAG_SCOPE (MEM_HISTORY);
   m= copy (m);
   if (the_owner != 0 && the_owner != get_author ()) {
     //cout << "Change " << the_owner << " -> " << get_author () << "\n";
@@ -335,6 +341,7 @@ archiver_rep::confirm () {
       if (depth <= last_save) last_save= -1;
       if (depth <= last_autosave) last_autosave= -1;
       normalize ();
+      truncate ();
       //show_all ();
     }
   }
@@ -411,6 +418,32 @@ archiver_rep::simplify () {
     }
 }
 
+static patch
+truncate_history (patch archive, int n, int& kept) {
+  // keep only the n most recent undo levels of the archive
+  if (nr_undo (archive) == 0) return archive;
+  if (n == 0) return make_branches (0);
+  patch un= get_undo (archive);
+  patch re= get_redo (archive);
+  patch nx= truncate_history (cdr (un), n-1, kept);
+  kept++;
+  return make_history (patch (car (un), nx), re);
+}
+
+void
+archiver_rep::truncate () {
+  // the history is cut back to the limit once it exceeds it by a quarter,
+  // so that the cost of the truncation is amortized over the confirmations
+  int limit= as_int (get_preference ("undo history limit", "1000"));
+  if (limit <= 0 || open_marks != 0 || depth - dropped <= limit + limit/4)
+    return;
+  int kept= 0;
+  archive= truncate_history (archive, limit, kept);
+  dropped= depth - kept;
+  if (last_save < dropped) last_save= -1;
+  if (last_autosave < dropped) last_autosave= -1;
+}
+
 /******************************************************************************
 * Undo and redo
 ******************************************************************************/
@@ -576,6 +609,7 @@ archiver_rep::mark_start (double m) {
   //cout << "Mark start " << m << "\n";
   confirm ();
   start_slave (m);
+  open_marks++;
   confirm ();
   //show_all ();
 }
@@ -589,6 +623,7 @@ archiver_rep::mark_end (double m) {
     confirm ();
   }
   archive= remove_marker (archive, m);
+  open_marks= max (open_marks - 1, 0);
   depth--;
   simplify ();
   //show_all ();
@@ -602,12 +637,14 @@ archiver_rep::mark_cancel (double m) {
     expose ();
     if (is_marker (car (get_undo (archive)), m, false)) {
       archive= remove_marker (archive, m);
+      open_marks= max (open_marks - 1, 0);
       depth--;
       simplify ();
       return true;
     }
     if (get_author (car (get_undo (archive))) != the_author) {
       archive= remove_marker (archive, m);
+      open_marks= max (open_marks - 1, 0);
       depth--;
       return false;
     }
@@ -23,6 +23,8 @@ class archiver_rep: public concrete_struct {
   int      depth;          // archive depth
   int      last_save;      // archive depth at last save
   int      last_autosave;  // archive depth at last autosave
+  int      dropped;        // archive depth at the oldest remaining level
+  int      open_marks;     // number of pending mark_start's
   double   the_author;     // the author corresponding to the archiver
   double   the_owner;      // author of current modifications
   path     rp;             // root path for document
@@ -36,6 +38,7 @@ protected:
   patch expose (patch archive);
   void expose ();
   void normalize ();
+  void truncate ();
   int corrected_depth ();
 
 public:
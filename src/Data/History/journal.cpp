@@ -0,0 +1,111 @@
+
+/******************************************************************************
+* MODULE     : journal.cpp
+* DESCRIPTION: journals of the modifications of documents since their last save
+* COPYRIGHT  : (C) 2020  Joris van der Hoeven
+*******************************************************************************
+* This software falls under the GNU general public license version 3 or later.
+* It comes WITHOUT ANY WARRANTY WHATSOEVER. For details, see the file LICENSE
+* in the root directory or <http://www.gnu.org/licenses/gpl-3.0.html>.
+******************************************************************************/
+
+#include "journal.hpp"
+#include "convert.hpp"
+#include "file.hpp"
+
+extern tree the_et;
+
+/******************************************************************************
+* Constructors and destructors
+******************************************************************************/
+
+journal_rep::journal_rep (url file2, path rp2):
+  file (file2), rp (rp2), pending (""), obs (journal_observer (this))
+{
+  reset ();
+  attach_observer (subtree (the_et, rp), obs);
+}
+
+journal_rep::~journal_rep () {
+  // the journal is only kept on disk in case of crashes
+  detach_observer (subtree (the_et, rp), obs);
+  if (exists (file)) remove (file);
+}
+
+void
+journal_announce (journal_rep* jour, modification mod) {
+  ASSERT (jour->rp <= mod->p, "invalid modification");
+  jour->add (mod / jour->rp);
+}
+
+/******************************************************************************
+* Recording modifications
+******************************************************************************/
+
+void
+journal_rep::add (modification mod) {
+  pending << as_string (mod);
+}
+
+void
+journal_rep::flush () {
+  if (N(pending) == 0) return;
+  if (!append_string (file, pending, false)) pending= "";
+}
+
+void
+journal_rep::reset () {
+  pending= "";
+  if (exists (file)) remove (file);
+}
+
+/******************************************************************************
+* Serialization of modifications
+******************************************************************************/
+
+string
+as_string (modification mod) {
+  // one line with the type, the path and the length of the tree,
+  // followed by the tree in scheme syntax on the next line
+  string t= tree_to_scheme (mod->t);
+  string r= get_type (mod);
+  r << " " << as_string (N(mod->p));
+  for (path p= mod->p; !is_nil (p); p= p->next)
+    r << " " << as_string (p->item);
+  r << " " << as_string (N(t)) << "\n" << t << "\n";
+  return r;
+}
+
+list<modification>
+as_modifications (string s) {
+  // an incomplete record at the end, due to a crash, is ignored
+  list<modification> r;
+  int i= 0, n= N(s);
+  while (i<n) {
+    int start= i;
+    while (i<n && s[i] != ' ') i++;
+    string type= s (start, i);
+    int len, item, size;
+    if (!read (s, i, " ") || !read_int (s, i, len)) break;
+    array<int> a;
+    for (int k=0; k<len; k++) {
+      if (!read (s, i, " ") || !read_int (s, i, item)) break;
+      a << item;
+    }
+    if (N(a) != len || !read (s, i, " ") || !read_int (s, i, size) ||
+        !read (s, i, "\n") || i + size + 1 > n || s[i + size] != '\n') break;
+    tree t= scheme_to_tree (s (i, i + size));
+    i += size + 1;
+    path p;
+    for (int k=len-1; k>=0; k--) p= path (a[k], p);
+    r= list<modification> (make_modification (type, p, t), r);
+  }
+  return reverse (r);
+}
+
+list<modification>
+load_journal (url u) {
+  string s;
+  if (load_string (u, s, false)) return list<modification> ();
+  return as_modifications (s);
+}
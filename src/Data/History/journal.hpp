@@ -0,0 +1,44 @@
+
+/******************************************************************************
+* MODULE     : journal.hpp
+* DESCRIPTION: journals of the modifications of documents since their last save
+* COPYRIGHT  : (C) 2020  Joris van der Hoeven
+*******************************************************************************
+* This software falls under the GNU general public license version 3 or later.
+* It comes WITHOUT ANY WARRANTY WHATSOEVER. For details, see the file LICENSE
+* in the root directory or <http://www.gnu.org/licenses/gpl-3.0.html>.
+******************************************************************************/
+
+#ifndef JOURNAL_H
+#define JOURNAL_H
+#include "modification.hpp"
+#include "url.hpp"
+
+/******************************************************************************
+* A journal records all modifications of a document since its last save,
+* including those due to undo and redo. The modifications are appended to
+* a file on disk, so that the document can be recovered after a crash by
+* replaying them on top of the saved file.
+******************************************************************************/
+
+class journal_rep {
+  url      file;     // the file on disk
+  path     rp;       // root path of the document
+  string   pending;  // modifications which have not yet been written
+  observer obs;      // observer for the modifications
+
+public:
+  journal_rep (url file, path rp);
+  ~journal_rep ();
+  void add (modification mod);
+  void flush ();     // write the pending modifications
+  void reset ();     // the document was saved
+
+  friend void journal_announce (journal_rep* jour, modification mod);
+};
+
+string as_string (modification mod);
+list<modification> as_modifications (string s);
+list<modification> load_journal (url u);
+
+#endif // defined JOURNAL_H
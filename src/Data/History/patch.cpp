@@ -495,12 +495,52 @@ swap (patch& p1, patch& p2, double a1, double a2) {
   return false;
 }
 
+static bool
+common_root (patch p, path& r, bool& first) {
+  // determine the common prefix r of the roots of all modifications in p;
+  // return false if p contains births or branches, or if r becomes empty
+  switch (get_type (p)) {
+  case PATCH_MODIFICATION:
+    if (first) r= root (get_modification (p));
+    else r= common (r, root (get_modification (p)));
+    first= false;
+    return !is_nil (r);
+  case PATCH_COMPOUND:
+    for (int i=0; i<N(p); i++)
+      if (!common_root (p[i], r, first)) return false;
+    return true;
+  case PATCH_AUTHOR:
+    return common_root (p[0], r, first);
+  default:
+    return false;
+  }
+}
+
+static bool
+independent (patch p1, patch p2) {
+  // the modifications of p1 and p2 apply to disjoint subtrees,
+  // so that all of them commute without any changes
+  path r1, r2;
+  bool first1= true, first2= true;
+  if (!common_root (p1, r1, first1) || first1) return false;
+  if (!common_root (p2, r2, first2) || first2) return false;
+  while (!is_nil (r1) && !is_nil (r2)) {
+    if (r1->item != r2->item) return true;
+    r1= r1->next;
+    r2= r2->next;
+  }
+  return false;
+}
+
 bool
 swap (patch& p1, patch& p2) {
   // Assuming that p1;p2 (the patch p1 followed by p2) is well-defined,
   // determine patches p1* and p2* such that p2*;p1* is equivalent
   // to p1;p2.  If such patches exist, then set p1 := p2* and
   // p2 := p1* and return true.  Otherwise, return false
+  if ((!is_modification (p1) || !is_modification (p2)) &&
+      independent (p1, p2))
+    return swap_basic (p1, p2);
   return swap (p1, p2, 0, 0);
 }
 
@@ -0,0 +1,66 @@
+
+/******************************************************************************
+* MODULE     : snapshot.cpp
+* DESCRIPTION: immutable snapshots of documents
+* COPYRIGHT  : (C) 2020  Joris van der Hoeven
+*******************************************************************************
+* This software falls under the GNU general public license version 3 or later.
+* It comes WITHOUT ANY WARRANTY WHATSOEVER. For details, see the file LICENSE
+* in the root directory or <http://www.gnu.org/licenses/gpl-3.0.html>.
+******************************************************************************/
+
+#include "snapshot.hpp"
+
+extern tree the_et;
+
+#define SNAPSHOT_PENDING_MAX 256
+
+/******************************************************************************
+* Constructors and destructors
+******************************************************************************/
+
+snapshot_rep::snapshot_rep (path rp2):
+  rp (rp2), doc (copy (subtree (the_et, rp2))), nr (0),
+  obs (snapshot_observer (this))
+{
+  attach_observer (subtree (the_et, rp), obs);
+}
+
+snapshot_rep::~snapshot_rep () {
+  detach_observer (subtree (the_et, rp), obs);
+}
+
+void
+snapshot_announce (snapshot_rep* snap, modification mod) {
+  ASSERT (snap->rp <= mod->p, "invalid modification");
+  snap->add (mod / snap->rp);
+}
+
+/******************************************************************************
+* Recording modifications
+******************************************************************************/
+
+void
+snapshot_rep::add (modification mod) {
+  // the inserted trees may be modified later on in the document
+  if (mod->k == MOD_SET_CURSOR) return;
+  if (mod->k == MOD_ASSIGN && is_nil (mod->p)) {
+    doc= copy (mod->t);
+    pending= list<modification> ();
+    nr= 0;
+    return;
+  }
+  pending= list<modification> (modification (mod->k, mod->p, copy (mod->t)),
+                               pending);
+  if (++nr >= SNAPSHOT_PENDING_MAX) (void) get ();
+}
+
+tree
+snapshot_rep::get () {
+  // only the nodes along the modified paths are copied
+  for (list<modification> l= reverse (pending); !is_nil (l); l= l->next)
+    doc= clean_apply (doc, l->item);
+  pending= list<modification> ();
+  nr= 0;
+  return doc;
+}
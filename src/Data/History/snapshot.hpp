@@ -0,0 +1,40 @@
+
+/******************************************************************************
+* MODULE     : snapshot.hpp
+* DESCRIPTION: immutable snapshots of documents
+* COPYRIGHT  : (C) 2020  Joris van der Hoeven
+*******************************************************************************
+* This software falls under the GNU general public license version 3 or later.
+* It comes WITHOUT ANY WARRANTY WHATSOEVER. For details, see the file LICENSE
+* in the root directory or <http://www.gnu.org/licenses/gpl-3.0.html>.
+******************************************************************************/
+
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+#include "modification.hpp"
+
+/******************************************************************************
+* A snapshot is a copy of a document which is never modified, so that it can
+* be handed to background tasks.  The document is only copied once; later
+* snapshots are obtained by replaying the modifications of the document
+* with clean_apply, so that they share all unmodified subtrees with the
+* previous snapshot.  Snapshots should never be modified in their turn.
+******************************************************************************/
+
+class snapshot_rep {
+  path     rp;       // root path of the document
+  tree     doc;      // the most recent snapshot
+  list<modification> pending;  // later modifications, in reverse order
+  int      nr;       // number of pending modifications
+  observer obs;      // observer for the modifications
+
+public:
+  snapshot_rep (path rp);
+  ~snapshot_rep ();
+  void add (modification mod);
+  tree get ();       // a snapshot of the current state of the document
+
+  friend void snapshot_announce (snapshot_rep* snap, modification mod);
+};
+
+#endif // defined SNAPSHOT_H
@@ -0,0 +1,70 @@
+
+/******************************************************************************
+* MODULE     : content_hash_observer.cpp
+* DESCRIPTION: Attach content hashes to trees
+* COPYRIGHT  : (C) 2020  Joris van der Hoeven
+*******************************************************************************
+* A content hash observer caches the fast hash of a large tree, so that
+* the hash of an enclosing tree can be recomputed without visiting the
+* tree again.  The hash is discarded as soon as the tree is modified.
+*******************************************************************************
+* This software falls under the GNU general public license version 3 or later.
+* It comes WITHOUT ANY WARRANTY WHATSOEVER. For details, see the file LICENSE
+* in the root directory or <http://www.gnu.org/licenses/gpl-3.0.html>.
+******************************************************************************/
+
+#include "modification.hpp"
+
+/******************************************************************************
+* Definition of the content_hash_observer_rep class
+******************************************************************************/
+
+class content_hash_observer_rep: public observer_rep {
+  DN h1, h2;
+public:
+  content_hash_observer_rep (DN h1b, DN h2b): h1 (h1b), h2 (h2b) {
+    interests= OBSERVE_ANNOUNCE; }
+  int get_type () { return OBSERVER_HASH; }
+  tm_ostream& print (tm_ostream& out) { return out << " hash"; }
+
+  void announce (tree& ref, modification mod);
+  bool get_content_hash (DN& h1, DN& h2);
+};
+
+/******************************************************************************
+* Call back routines and hash methods
+******************************************************************************/
+
+void
+content_hash_observer_rep::announce (tree& ref, modification mod) {
+  (void) mod;
+  remove_observer (ref->obs, observer (this));
+}
+
+bool
+content_hash_observer_rep::get_content_hash (DN& h1b, DN& h2b) {
+  h1b= h1; h2b= h2;
+  return true;
+}
+
+/******************************************************************************
+* Attaching and retrieving content hashes
+******************************************************************************/
+
+observer
+content_hash_observer (DN h1, DN h2) {
+  return tm_new<content_hash_observer_rep> (h1, h2);
+}
+
+void
+attach_content_hash (tree& ref, DN h1, DN h2) {
+  // as for signatures, the hashes are only reliable for trees inside
+  // the global meta-tree, for which modifications of subtrees are announced
+  if (!ip_attached (obtain_ip (ref))) return;
+  attach_observer (ref, content_hash_observer (h1, h2));
+}
+
+bool
+obtain_content_hash (tree& ref, DN& h1, DN& h2) {
+  return !is_nil (ref->obs) && ref->obs->get_content_hash (h1, h2);
+}
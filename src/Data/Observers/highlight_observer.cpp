@@ -23,7 +23,7 @@ class highlight_observer_rep: public observer_rep {
   array<int> cols;
 public:
   highlight_observer_rep (int lan2, array<int> cols2):
-    lan (lan2), cols (cols2) {}
+    lan (lan2), cols (cols2) { interests= OBSERVE_ANNOUNCE; }
   int get_type () { return OBSERVER_HIGHLIGHT; }
   tm_ostream& print (tm_ostream& out) {
     return out << " highlight<" << lan << ">"; }
@@ -0,0 +1,107 @@
+
+/******************************************************************************
+* MODULE     : line_state_observer.cpp
+* DESCRIPTION: Attach lexer states at the starts of lines to documents
+* COPYRIGHT  : (C) 2020  Joris van der Hoeven
+*******************************************************************************
+* A line state observer remembers the state of a lexer at the start of
+* each line of a document, so that syntax highlighting can resume at any
+* line instead of rescanning the document from its beginning.  The states
+* of the lines before 'valid' are up to date; the lines up to 'dirty' may
+* have been modified, but the states after 'dirty' can still be reused
+* as soon as the lexer arrives at the same state as before.
+*******************************************************************************
+* This software falls under the GNU general public license version 3 or later.
+* It comes WITHOUT ANY WARRANTY WHATSOEVER. For details, see the file LICENSE
+* in the root directory or <http://www.gnu.org/licenses/gpl-3.0.html>.
+******************************************************************************/
+
+#include "modification.hpp"
+
+/******************************************************************************
+* Definition of the line_state_observer_rep class
+******************************************************************************/
+
+class line_state_observer_rep: public observer_rep {
+  array<int> states;
+  int valid;
+  int dirty;
+public:
+  line_state_observer_rep (array<int> st, int v, int d):
+    states (st), valid (v), dirty (d) { interests= OBSERVE_ANNOUNCE; }
+  int get_type () { return OBSERVER_LINES; }
+  tm_ostream& print (tm_ostream& out) { return out << " lines"; }
+
+  void announce (tree& ref, modification mod);
+  bool get_line_states (array<int>& states, int& valid, int& dirty);
+  bool set_line_states (array<int> states, int valid, int dirty);
+};
+
+/******************************************************************************
+* Call back routines and line state methods
+******************************************************************************/
+
+static bool
+changes_lines (modification mod) {
+  // does the modification change the number of lines of the document?
+  int n= N(mod->p);
+  if (n == 1) return mod->k != MOD_ASSIGN && mod->k != MOD_SET_CURSOR;
+  if (n == 2) return mod->k == MOD_REMOVE || mod->k == MOD_SPLIT;
+  return false;
+}
+
+void
+line_state_observer_rep::announce (tree& ref, modification mod) {
+  (void) ref;
+  if (is_nil (mod->p)) {
+    states= array<int> (1);
+    states[0]= 0;
+    valid= 1;
+    dirty= -1;
+    return;
+  }
+  int k= max (mod->p->item, 0);
+  if (changes_lines (mod)) {
+    if (N(states) > k+1) states->resize (k+1);
+    valid= min (valid, k+1);
+  }
+  else {
+    valid= min (valid, k+1);
+    dirty= max (dirty, k);
+  }
+}
+
+bool
+line_state_observer_rep::get_line_states (array<int>& st, int& v, int& d) {
+  st= states; v= valid; d= dirty;
+  return true;
+}
+
+bool
+line_state_observer_rep::set_line_states (array<int> st, int v, int d) {
+  states= st; valid= v; dirty= d;
+  return true;
+}
+
+/******************************************************************************
+* Attaching and retrieving line states
+******************************************************************************/
+
+observer
+line_state_observer (array<int> states, int valid, int dirty) {
+  return tm_new<line_state_observer_rep> (states, valid, dirty);
+}
+
+void
+attach_line_states (tree& ref, array<int> states, int valid, int dirty) {
+  // as for signatures, line states are only reliable for trees inside
+  // the global meta-tree, for which modifications of lines are announced
+  if (!ip_attached (obtain_ip (ref))) return;
+  if (is_nil (ref->obs) || !ref->obs->set_line_states (states, valid, dirty))
+    attach_observer (ref, line_state_observer (states, valid, dirty));
+}
+
+bool
+obtain_line_states (tree& ref, array<int>& states, int& valid, int& dirty) {
+  return !is_nil (ref->obs) && ref->obs->get_line_states (states, valid, dirty);
+}
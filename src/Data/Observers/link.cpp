@@ -11,13 +11,14 @@
 
 #include "modification.hpp"
 #include "link.hpp"
+#include "array.hpp"
 #include "iterator.hpp"
 #include "vars.hpp"
 #include "boot.hpp"
 
-hashmap<string,list<observer> > id_resolve;
+hashmap<string,array<observer> > id_resolve;
 hashmap<observer,list<string> > pointer_resolve;
-hashmap<tree,list<soft_link> > vertex_occurrences;
+hashmap<tree,array<tree> > vertex_occurrences;
 hashmap<string,int> type_count (0);
 
 static hashset<string> visited_table;
@@ -26,14 +27,39 @@ extern tree the_et;
 
 /******************************************************************************
 * Soft links
+*******************************************************************************
+* The loci of an identifier and the links through a vertex are kept in
+* arrays in the order of their registration.  Registrations are mostly
+* undone in the reverse order, when the link repository of a typeset
+* bridge is destroyed, so that we search for the entries to be removed
+* starting with the most recent ones.
 ******************************************************************************/
 
+static void
+remove_last (array<observer>& a, observer which) {
+  int i, n= N(a);
+  for (i=n-1; i>=0; i--)
+    if (a[i] == which) break;
+  if (i < 0) return;
+  for (; i<n-1; i++) a[i]= a[i+1];
+  a->resize (n-1);
+}
+
+static void
+remove_last (array<tree>& a, tree which) {
+  int i, n= N(a);
+  for (i=n-1; i>=0; i--)
+    if (strong_equal (a[i], which)) break;
+  if (i < 0) return;
+  for (; i<n-1; i++) a[i]= a[i+1];
+  a->resize (n-1);
+}
+
 void
 register_pointer (string id, observer which) {
   // cout << "Register: " << id << " -> " << which << "\n";
   // cout << "Register: " << id << " -> " << obtain_tree (which) << "\n";
-  list<observer>& l1= id_resolve (id);
-  l1= list<observer> (which, l1);
+  id_resolve (id) << which;
   list<string>& l2= pointer_resolve (which);
   l2= list<string> (id, l2);
 }
@@ -42,9 +68,11 @@ void
 unregister_pointer (string id, observer which) {
   // cout << "Unregister: " << id << " -> " << which << "\n";
   // cout << "Unregister: " << id << " -> " << obtain_tree (which) << "\n";
-  list<observer>& l1= id_resolve (id);
-  l1= remove (l1, which);
-  if (is_nil (l1)) id_resolve->reset (id);
+  if (id_resolve->contains (id)) {
+    array<observer>& a= id_resolve (id);
+    remove_last (a, which);
+    if (N(a) == 0) id_resolve->reset (id);
+  }
   list<string>& l2= pointer_resolve (which);
   l2= remove (l2, id);
   if (is_nil (l2)) pointer_resolve->reset (which);
@@ -52,15 +80,15 @@ unregister_pointer (string id, observer which) {
 
 void
 register_vertex (tree v, soft_link ln) {
-  list<soft_link>& l= vertex_occurrences (v);
-  l= list<soft_link> (ln, l);
+  vertex_occurrences (v) << ln->t;
 }
 
 void
 unregister_vertex (tree v, soft_link ln) {
-  list<soft_link>& l= vertex_occurrences (v);
-  l= remove (l, ln);
-  if (is_nil (l)) vertex_occurrences->reset (v);
+  if (!vertex_occurrences->contains (v)) return;
+  array<tree>& a= vertex_occurrences (v);
+  remove_last (a, ln->t);
+  if (N(a) == 0) vertex_occurrences->reset (v);
 }
 
 void
@@ -134,39 +162,41 @@ link_repository_rep::insert_link (soft_link ln) {
 * Routines for navigation
 ******************************************************************************/
 
-list<string>
-get_ids (list<observer> l) {
-  if (is_nil (l)) return list<string> ();
-  return pointer_resolve [l->item] * get_ids (l->next);
-}
-
 list<string>
 get_ids (tree t) {
-  if (is_nil (t->obs)) return list<string> ();
+  list<string> r;
+  if (is_nil (t->obs)) return r;
   list<observer> l= t->obs->get_tree_pointers ();
-  return reverse (get_ids (l));
-}
-
-list<tree>
-as_trees (list<observer> l) {
-  if (is_nil (l)) return list<tree> ();
-  else return list<tree> (obtain_tree (l->item), as_trees (l->next));
+  for (; !is_nil (l); l= l->next)
+    for (list<string> ids= pointer_resolve [l->item];
+         !is_nil (ids); ids= ids->next)
+      r= list<string> (ids->item, r);
+  return r;
 }
 
 list<tree>
 get_trees (string id) {
-  return reverse (as_trees (id_resolve [id]));
+  list<tree> r;
+  if (!id_resolve->contains (id)) return r;
+  array<observer> a= id_resolve [id];
+  for (int i=N(a)-1; i>=0; i--)
+    r= list<tree> (obtain_tree (a[i]), r);
+  return r;
 }
 
 list<tree>
-as_tree_list (list<soft_link> l) {
-  if (is_nil (l)) return list<tree> ();
-  else return list<tree> (l->item->t, as_tree_list (l->next));
+get_links (tree v) {
+  list<tree> r;
+  if (!vertex_occurrences->contains (v)) return r;
+  array<tree> a= vertex_occurrences [v];
+  for (int i=N(a)-1; i>=0; i--)
+    r= list<tree> (a[i], r);
+  return r;
 }
 
-list<tree>
-get_links (tree v) {
-  return reverse (as_tree_list (vertex_occurrences [v]));
+bool
+has_links (string type) {
+  return type_count[type] > 0;
 }
 
 list<string>
@@ -78,6 +78,7 @@ list<string> get_ids (tree t);
 list<tree> get_trees (string id);
 list<tree> get_links (tree v);
 list<string> all_link_types ();
+bool has_links (string type);
 
 void set_locus_rendering (string var, string val);
 string get_locus_rendering (string var);
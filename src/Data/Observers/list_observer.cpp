@@ -26,7 +26,8 @@ class list_observer_rep: public observer_rep {
   observer o2;
 
 public:
-  list_observer_rep (observer o1b, observer o2b): o1 (o1b), o2 (o2b) {}
+  list_observer_rep (observer o1b, observer o2b): o1 (o1b), o2 (o2b) {
+    interests= o1->interests | o2->interests; }
   int get_type () { return OBSERVER_LIST; }
   tm_ostream& print (tm_ostream& out) {
     if (!is_nil (o1)) o1->print (out);
@@ -60,28 +61,37 @@ public:
   bool get_contents (int kind, blackbox& bb);
   bool set_highlight (int lan, int col, int start, int end);
   bool get_highlight (int lan, array<int>& cols);
+  bool get_signature (DN& sig);
+  bool get_content_hash (DN& h1, DN& h2);
+  bool get_line_states (array<int>& states, int& valid, int& dirty);
+  bool set_line_states (array<int> states, int valid, int dirty);
 };
 
+static inline bool
+interested (observer o, int what) {
+  return !is_nil (o) && (o->interests & what) != 0;
+}
+
 /******************************************************************************
 * Call back routines for announcements
 ******************************************************************************/
 
 void
 list_observer_rep::announce (tree& ref, modification mod) {
-  if (!is_nil (o1)) o1->announce (ref, mod);
-  if (!is_nil (o2)) o2->announce (ref, mod);
+  if (interested (o1, OBSERVE_ANNOUNCE)) o1->announce (ref, mod);
+  if (interested (o2, OBSERVE_ANNOUNCE)) o2->announce (ref, mod);
 }
 
 void
 list_observer_rep::done (tree& ref, modification mod) {
-  if (!is_nil (o1)) o1->done (ref, mod);
-  if (!is_nil (o2)) o2->done (ref, mod);
+  if (interested (o1, OBSERVE_DONE)) o1->done (ref, mod);
+  if (interested (o2, OBSERVE_DONE)) o2->done (ref, mod);
 }
 
 void
 list_observer_rep::touched (tree& ref, path p) {
-  if (!is_nil (o1)) o1->touched (ref, p);
-  if (!is_nil (o2)) o2->touched (ref, p);
+  if (interested (o1, OBSERVE_DONE)) o1->touched (ref, p);
+  if (interested (o2, OBSERVE_DONE)) o2->touched (ref, p);
 }
 
 /******************************************************************************
@@ -90,74 +100,74 @@ list_observer_rep::touched (tree& ref, path p) {
 
 void
 list_observer_rep::notify_assign (tree& ref, tree t) {
-  if (!is_nil (o1)) o1->notify_assign (ref, t);
-  if (!is_nil (o2)) o2->notify_assign (ref, t);
+  if (interested (o1, OBSERVE_NOTIFY)) o1->notify_assign (ref, t);
+  if (interested (o2, OBSERVE_NOTIFY)) o2->notify_assign (ref, t);
 }
 
 void
 list_observer_rep::notify_insert (tree& ref, int pos, int nr) {
-  if (!is_nil (o1)) o1->notify_insert (ref, pos, nr);
-  if (!is_nil (o2)) o2->notify_insert (ref, pos, nr);
+  if (interested (o1, OBSERVE_NOTIFY)) o1->notify_insert (ref, pos, nr);
+  if (interested (o2, OBSERVE_NOTIFY)) o2->notify_insert (ref, pos, nr);
 }
 
 void
 list_observer_rep::notify_remove (tree& ref, int pos, int nr) {
-  if (!is_nil (o1)) o1->notify_remove (ref, pos, nr);
-  if (!is_nil (o2)) o2->notify_remove (ref, pos, nr);
+  if (interested (o1, OBSERVE_NOTIFY)) o1->notify_remove (ref, pos, nr);
+  if (interested (o2, OBSERVE_NOTIFY)) o2->notify_remove (ref, pos, nr);
 }
 
 void
 list_observer_rep::notify_split (tree& ref, int pos, tree prev) {
-  if (!is_nil (o1)) o1->notify_split (ref, pos, prev);
-  if (!is_nil (o2)) o2->notify_split (ref, pos, prev);
+  if (interested (o1, OBSERVE_NOTIFY)) o1->notify_split (ref, pos, prev);
+  if (interested (o2, OBSERVE_NOTIFY)) o2->notify_split (ref, pos, prev);
 }
 
 void
 list_observer_rep::notify_var_split (tree& ref, tree t1, tree t2) {
-  if (!is_nil (o1)) o1->notify_var_split (ref, t1, t2);
-  if (!is_nil (o2)) o2->notify_var_split (ref, t1, t2);
+  if (interested (o1, OBSERVE_NOTIFY)) o1->notify_var_split (ref, t1, t2);
+  if (interested (o2, OBSERVE_NOTIFY)) o2->notify_var_split (ref, t1, t2);
 }
 
 void
 list_observer_rep::notify_join (tree& ref, int pos, tree next) {
-  if (!is_nil (o1)) o1->notify_join (ref, pos, next);
-  if (!is_nil (o2)) o2->notify_join (ref, pos, next);
+  if (interested (o1, OBSERVE_NOTIFY)) o1->notify_join (ref, pos, next);
+  if (interested (o2, OBSERVE_NOTIFY)) o2->notify_join (ref, pos, next);
 }
 
 void
 list_observer_rep::notify_var_join (tree& ref, tree t, int offset) {
-  if (!is_nil (o1)) o1->notify_var_join (ref, t, offset);
-  if (!is_nil (o2)) o2->notify_var_join (ref, t, offset);
+  if (interested (o1, OBSERVE_NOTIFY)) o1->notify_var_join (ref, t, offset);
+  if (interested (o2, OBSERVE_NOTIFY)) o2->notify_var_join (ref, t, offset);
 }
 
 void
 list_observer_rep::notify_assign_node (tree& ref, tree_label op) {
-  if (!is_nil (o1)) o1->notify_assign_node (ref, op);
-  if (!is_nil (o2)) o2->notify_assign_node (ref, op);
+  if (interested (o1, OBSERVE_NOTIFY)) o1->notify_assign_node (ref, op);
+  if (interested (o2, OBSERVE_NOTIFY)) o2->notify_assign_node (ref, op);
 }
 
 void
 list_observer_rep::notify_insert_node (tree& ref, int pos) {
-  if (!is_nil (o1)) o1->notify_insert_node (ref, pos);
-  if (!is_nil (o2)) o2->notify_insert_node (ref, pos);
+  if (interested (o1, OBSERVE_NOTIFY)) o1->notify_insert_node (ref, pos);
+  if (interested (o2, OBSERVE_NOTIFY)) o2->notify_insert_node (ref, pos);
 }
 
 void
 list_observer_rep::notify_remove_node (tree& ref, int pos) {
-  if (!is_nil (o1)) o1->notify_remove_node (ref, pos);
-  if (!is_nil (o2)) o2->notify_remove_node (ref, pos);
+  if (interested (o1, OBSERVE_NOTIFY)) o1->notify_remove_node (ref, pos);
+  if (interested (o2, OBSERVE_NOTIFY)) o2->notify_remove_node (ref, pos);
 }
 
 void
 list_observer_rep::notify_set_cursor (tree& ref, int pos, tree data) {
-  if (!is_nil (o1)) o1->notify_set_cursor (ref, pos, data);
-  if (!is_nil (o2)) o2->notify_set_cursor (ref, pos, data);
+  if (interested (o1, OBSERVE_NOTIFY)) o1->notify_set_cursor (ref, pos, data);
+  if (interested (o2, OBSERVE_NOTIFY)) o2->notify_set_cursor (ref, pos, data);
 }
 
 void
 list_observer_rep::notify_detach (tree& ref, tree closest, bool right) {
-  if (!is_nil (o1)) o1->notify_detach (ref, closest, right);
-  if (!is_nil (o2)) o2->notify_detach (ref, closest, right);
+  if (interested (o1, OBSERVE_NOTIFY)) o1->notify_detach (ref, closest, right);
+  if (interested (o2, OBSERVE_NOTIFY)) o2->notify_detach (ref, closest, right);
 }
 
 /******************************************************************************
@@ -226,6 +236,30 @@ list_observer_rep::get_highlight (int lan, array<int>& cols) {
          (!is_nil (o2) && o2->get_highlight (lan, cols));
 }
 
+bool
+list_observer_rep::get_signature (DN& sig) {
+  return (!is_nil (o1) && o1->get_signature (sig)) ||
+         (!is_nil (o2) && o2->get_signature (sig));
+}
+
+bool
+list_observer_rep::get_content_hash (DN& h1, DN& h2) {
+  return (!is_nil (o1) && o1->get_content_hash (h1, h2)) ||
+         (!is_nil (o2) && o2->get_content_hash (h1, h2));
+}
+
+bool
+list_observer_rep::get_line_states (array<int>& st, int& valid, int& dirty) {
+  return (!is_nil (o1) && o1->get_line_states (st, valid, dirty)) ||
+         (!is_nil (o2) && o2->get_line_states (st, valid, dirty));
+}
+
+bool
+list_observer_rep::set_line_states (array<int> st, int valid, int dirty) {
+  return (!is_nil (o1) && o1->set_line_states (st, valid, dirty)) ||
+         (!is_nil (o2) && o2->set_line_states (st, valid, dirty));
+}
+
 /******************************************************************************
 * Creation of list observers
 ******************************************************************************/
@@ -0,0 +1,70 @@
+
+/******************************************************************************
+* MODULE     : signature_observer.cpp
+* DESCRIPTION: Attach search signatures to trees
+* COPYRIGHT  : (C) 2020  Joris van der Hoeven
+*******************************************************************************
+* A signature observer caches a summary of the strings inside a tree,
+* which allows searches to skip the tree when it cannot contain a match.
+* The signature is discarded as soon as the tree is modified.
+*******************************************************************************
+* This software falls under the GNU general public license version 3 or later.
+* It comes WITHOUT ANY WARRANTY WHATSOEVER. For details, see the file LICENSE
+* in the root directory or <http://www.gnu.org/licenses/gpl-3.0.html>.
+******************************************************************************/
+
+#include "modification.hpp"
+
+/******************************************************************************
+* Definition of the signature_observer_rep class
+******************************************************************************/
+
+class signature_observer_rep: public observer_rep {
+  DN sig;
+public:
+  signature_observer_rep (DN sig2): sig (sig2) {
+    interests= OBSERVE_ANNOUNCE; }
+  int get_type () { return OBSERVER_SIGNATURE; }
+  tm_ostream& print (tm_ostream& out) { return out << " signature"; }
+
+  void announce (tree& ref, modification mod);
+  bool get_signature (DN& sig);
+};
+
+/******************************************************************************
+* Call back routines and signature methods
+******************************************************************************/
+
+void
+signature_observer_rep::announce (tree& ref, modification mod) {
+  (void) mod;
+  remove_observer (ref->obs, observer (this));
+}
+
+bool
+signature_observer_rep::get_signature (DN& s) {
+  s= sig;
+  return true;
+}
+
+/******************************************************************************
+* Attaching and retrieving signatures
+******************************************************************************/
+
+observer
+signature_observer (DN sig) {
+  return tm_new<signature_observer_rep> (sig);
+}
+
+void
+attach_signature (tree& ref, DN sig) {
+  // signatures are only reliable for trees inside the global meta-tree,
+  // for which the modifications of subtrees are announced to the ancestors
+  if (!ip_attached (obtain_ip (ref))) return;
+  attach_observer (ref, signature_observer (sig));
+}
+
+bool
+obtain_signature (tree& ref, DN& sig) {
+  return !is_nil (ref->obs) && ref->obs->get_signature (sig);
+}
@@ -0,0 +1,94 @@
+
+/******************************************************************************
+* MODULE     : snapshot_observer.cpp
+* DESCRIPTION: Report the modifications of a document to its snapshot
+* COPYRIGHT  : (C) 2020  Joris van der Hoeven
+*******************************************************************************
+* This software falls under the GNU general public license version 3 or later.
+* It comes WITHOUT ANY WARRANTY WHATSOEVER. For details, see the file LICENSE
+* in the root directory or <http://www.gnu.org/licenses/gpl-3.0.html>.
+******************************************************************************/
+
+#include "modification.hpp"
+
+/******************************************************************************
+* Definition of the snapshot_observer_rep class
+******************************************************************************/
+
+class snapshot_observer_rep: public observer_rep {
+  snapshot_rep* snap;
+public:
+  snapshot_observer_rep (snapshot_rep* snap2): snap (snap2) {
+    interests= OBSERVE_ANNOUNCE | OBSERVE_NOTIFY; }
+  int get_type () { return OBSERVER_SNAPSHOT; }
+  tm_ostream& print (tm_ostream& out) {
+    return out << " snapshot<" << snap << ">"; }
+  void announce (tree& ref, modification mod);
+
+  void reattach           (tree& ref, tree t);
+  void notify_assign      (tree& ref, tree t);
+  void notify_var_split   (tree& ref, tree t1, tree t2);
+  void notify_var_join    (tree& ref, tree t, int offset);
+  void notify_remove_node (tree& ref, int pos);
+  void notify_detach      (tree& ref, tree closest, bool right);
+};
+
+/******************************************************************************
+* Call back routines for announcements
+******************************************************************************/
+
+void
+snapshot_observer_rep::announce (tree& ref, modification mod) {
+  if (mod->k == MOD_ASSIGN && mod->p == path () && mod->t == ref) return;
+  if (!ip_attached (obtain_ip (ref))) return;
+  snapshot_announce (snap, reverse (obtain_ip (ref)) * mod);
+}
+
+/******************************************************************************
+* Reattach when necessary
+******************************************************************************/
+
+void
+snapshot_observer_rep::reattach (tree& ref, tree t) {
+  if (ref.rep != t.rep) {
+    remove_observer (ref->obs, observer (this));
+    insert_observer (t->obs, observer (this));
+  }
+}
+
+void
+snapshot_observer_rep::notify_assign (tree& ref, tree t) {
+  reattach (ref, t);
+}
+
+void
+snapshot_observer_rep::notify_var_split (tree& ref, tree t1, tree t2) {
+  (void) t2;
+  reattach (ref, t1); // always at the left
+}
+
+void
+snapshot_observer_rep::notify_var_join (tree& ref, tree t, int offset) {
+  (void) offset;
+  reattach (ref, t);
+}
+
+void
+snapshot_observer_rep::notify_remove_node (tree& ref, int pos) {
+  reattach (ref, ref[pos]);
+}
+
+void
+snapshot_observer_rep::notify_detach (tree& ref, tree closest, bool right) {
+  (void) right;
+  reattach (ref, closest);
+}
+
+/******************************************************************************
+* Creation of snapshot observers
+******************************************************************************/
+
+observer
+snapshot_observer (snapshot_rep* snap) {
+  return tm_new<snapshot_observer_rep> (snap);
+}
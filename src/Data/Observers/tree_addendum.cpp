@@ -29,7 +29,8 @@ private:
 
 public:
   tree_addendum_rep (tree ref, int kind2, blackbox contents2, bool keep2):
-    ptr (ref.rep), kind (kind2), contents (contents2), keep (keep2) {}
+    ptr (ref.rep), kind (kind2), contents (contents2), keep (keep2) {
+      interests= OBSERVE_NOTIFY; }
   int get_type () { return OBSERVER_ADDENDUM; }
   tm_ostream& print (tm_ostream& out) {
     return out << " addendum (" << kind << ", " << contents << ")"; }
@@ -26,7 +26,8 @@ class tree_position_rep: public observer_rep {
   int index;
 
 public:
-  tree_position_rep (tree ref, int index2): ptr (ref.rep), index (index2) {}
+  tree_position_rep (tree ref, int index2): ptr (ref.rep), index (index2) {
+    interests= OBSERVE_NOTIFY; }
   int get_type () { return OBSERVER_POSITION; }
   tm_ostream& print (tm_ostream& out) { return out << " " << index; }
 
@@ -21,7 +21,8 @@
 class undo_observer_rep: public observer_rep {
   archiver_rep* arch;
 public:
-  undo_observer_rep (archiver_rep* arch2): arch (arch2) {}
+  undo_observer_rep (archiver_rep* arch2): arch (arch2) {
+    interests= OBSERVE_ANNOUNCE | OBSERVE_NOTIFY; }
   int get_type () { return OBSERVER_UNDO; }
   tm_ostream& print (tm_ostream& out) { return out << " undoer<" << arch << ">"; }
   void announce (tree& ref, modification mod);
@@ -14,6 +14,7 @@
 #include "converter.hpp"
 #include "scheme.hpp"
 #include "ntuple.hpp"
+#include <string.h>
 
 /******************************************************************************
 * Tests for characters
@@ -524,6 +525,58 @@ from_hexadecimal (string s) {
   return res;
 }
 
+/******************************************************************************
+* Marshalling of numbers and strings into binary strings
+******************************************************************************/
+
+static int
+get_byte_length (unsigned long int i) {
+  int l= 0;
+  while (i != 0) { l++; i >>= 8; }
+  return l;
+}
+
+void
+marshall_number (string& s, unsigned long int i) {
+  if (i < 248) s << ((char) ((unsigned char) (i + 8)));
+  else {
+    s << ((char) get_byte_length (i));
+    while (i != 0) {
+      s << ((char) ((unsigned char) (i & 0xff)));
+      i >>= 8;
+    }
+  }
+}
+
+unsigned long int
+unmarshall_number (string s, int& pos) {
+  if (pos >= N(s)) return 0;
+  int n= (int) ((unsigned char) s[pos++]);
+  if (n >= 8) return n - 8;
+  unsigned long int r= 0;
+  unsigned long int p= 1;
+  for (int k=0; k<n && pos<N(s); k++) {
+    unsigned long int next= (unsigned long int) ((unsigned char) s[pos++]);
+    r += next * p;
+    p <<= 8;
+  }
+  return r;
+}
+
+void
+marshall_string (string& s, string x) {
+  marshall_number (s, N(x));
+  s << x;
+}
+
+string
+unmarshall_string (string s, int& pos) {
+  int n= unmarshall_number (s, pos);
+  string r= s (pos, pos+n);
+  pos += N(r);
+  return r;
+}
+
 /******************************************************************************
 * Routines for the TeXmacs encoding
 ******************************************************************************/
@@ -690,11 +743,18 @@ tm_recompose (array<string> a) {
 
 int
 tm_search_forwards (string s, int pos, string in) {
-  int k= N(s), n= N(in);
+  // the matches of search_forwards are only accepted at character
+  // boundaries, which can only be missed behind a '<'
+  int k= N(s), n= N(in), next= -1;
   if (k == 0) return pos;
-  char c= s[0];
   while (pos+k <= n) {
-    if (in[pos] == c && test (in, pos, s)) return pos;
+    if (next < pos) {
+      next= search_forwards (s, pos, in);
+      if (next < 0) return -1;
+    }
+    int lt= search_forwards ('<', pos, next, in);
+    if (lt < 0) return next;
+    pos= lt;
     tm_char_forwards (in, pos);
   }
   return -1;
@@ -1205,13 +1265,31 @@ search_forwards (array<string> a, int pos, string in) {
   return -1;
 }
 
+int
+search_forwards (char c, int pos, int end, string in) {
+  // search c inside in (pos, end)
+  if (pos < 0) pos= 0;
+  if (end > N(in)) end= N(in);
+  if (pos >= end) return -1;
+  const char* a= &in[0];
+  const char* p= (const char*) memchr (a + pos, c, end - pos);
+  return p == NULL? -1: (int) (p - a);
+}
+
 int
 search_forwards (string s, int pos, string in) {
+  // the candidates are located using memchr on the first character
   int k= N(s), n= N(in);
   if (k == 0) return pos;
-  char c= s[0];
-  while (pos+k <= n) {
-    if (in[pos] == c && test (in, pos, s)) return pos;
+  if (pos < 0) pos= 0;
+  if (pos+k > n) return -1;
+  const char* a= &in[0];
+  const char* b= &s[0];
+  int last= n - k + 1;
+  while (pos < last) {
+    pos= search_forwards (b[0], pos, last, in);
+    if (pos < 0) return -1;
+    if (memcmp (a + pos + 1, b + 1, k - 1) == 0) return pos;
     pos++;
   }
   return -1;
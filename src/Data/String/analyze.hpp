@@ -88,6 +88,10 @@ string as_hexadecimal (int i);
 string as_hexadecimal (pointer ptr);
 string as_hexadecimal (int i, int length);
 int    from_hexadecimal (string s);
+void   marshall_number (string& s, unsigned long int i);
+unsigned long int unmarshall_number (string s, int& pos);
+void   marshall_string (string& s, string x);
+string unmarshall_string (string s, int& pos);
 
 string tm_encode (string s);
 string tm_decode (string s);
@@ -143,6 +147,7 @@ void parse (string s, int& pos, HN& ret);
 void parse (string s, int& pos, SI& ret);
 void parse (string s, int& pos, SI*& a, int len);
 
+int    search_forwards (char c, int pos, int end, string in);
 int    search_forwards (string what, string in);
 int    search_forwards (string what, int pos, string in);
 int    search_forwards (array<string> what_list, int pos, string in);
@@ -1,4 +1,3 @@
-
 /******************************************************************************
 * MODULE     : base64.hpp
 * DESCRIPTION: Implementation of the base64 coding as described by RFC-3548.
@@ -9,95 +8,217 @@
 * in the root directory or <http://www.gnu.org/licenses/gpl-3.0.html>.
 ******************************************************************************/
 
-#include "array.hpp"
 #include "string.hpp"
 #include "base64.hpp"
 
+// Blocks of 12 bytes are encoded into 16 characters and conversely using
+// SSSE3 or NEON instructions, when available.  The lines of the encoding
+// consist of 60 bytes, which are precisely 5 such blocks.  The remaining
+// bytes and the blocks with line breaks or padding are handled one group
+// of 3 bytes at a time.
+
+#if defined(__SSSE3__)
+#include <tmmintrin.h>
+#define BASE64_VECTORS
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define BASE64_VECTORS
+#endif
+
 // 0 maps to 'A', 1 maps to 'B', and so on ...
 static const char
 int_to_b64[]= "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
 
-inline static string
-encode_base64 (char c1, char c2, char c3) {
-  string r(4);
-  int idx0, idx1, idx2, idx3;
+// 'A' maps to (64+0), 'B' maps to (64+1), and so on, until '/' maps to (64+63)
+// Others maps to 43 ('?')
+static const char
+b64_to_int[]= "???????????????????????????????????????????~???\177tuvwxyz{|}??\
+?????@ABCDEFGHIJKLMNOPQRSTUVWXY??????Z[\\]^_`abcdefghijklmnopqrs?????";
+
+/******************************************************************************
+* Encoding
+******************************************************************************/
 
-  idx0= ((c1 >> 2) & 0x3F);
-  idx1= (((c1 << 4) & 0x30) + ((c2 >> 4) & 0x0F));
-  idx2= (((c2 << 2) & 0x3C) + ((c3 >> 6) & 0x03));
-  idx3= (c3 & 0x3F);
+static inline void
+encode_group (unsigned char c1, unsigned char c2, unsigned char c3, char* r) {
+  r[0]= int_to_b64[c1 >> 2];
+  r[1]= int_to_b64[((c1 << 4) & 0x30) + (c2 >> 4)];
+  r[2]= int_to_b64[((c2 << 2) & 0x3C) + (c3 >> 6)];
+  r[3]= int_to_b64[c3 & 0x3F];
+}
 
-  r[0]= int_to_b64[idx0];
-  r[1]= int_to_b64[idx1];
-  r[2]= int_to_b64[idx2];
-  r[3]= int_to_b64[idx3];
-  return r;
+#if defined(__SSSE3__)
+static inline void
+encode_block (const unsigned char* in, char* out) {
+  // reads 16 bytes of in and writes 16 characters
+  __m128i v= _mm_loadu_si128 ((const __m128i*) in);
+  v= _mm_shuffle_epi8 (v, _mm_set_epi8 (10, 11, 9, 10, 7, 8, 6, 7,
+                                        4, 5, 3, 4, 1, 2, 0, 1));
+  __m128i t0= _mm_and_si128 (v, _mm_set1_epi32 (0x0fc0fc00));
+  __m128i t1= _mm_mulhi_epu16 (t0, _mm_set1_epi32 (0x04000040));
+  __m128i t2= _mm_and_si128 (v, _mm_set1_epi32 (0x003f03f0));
+  __m128i t3= _mm_mullo_epi16 (t2, _mm_set1_epi32 (0x01000010));
+  __m128i idx= _mm_or_si128 (t1, t3);
+  // add the offset of the range of each index to obtain the characters
+  __m128i rng= _mm_subs_epu8 (idx, _mm_set1_epi8 (51));
+  __m128i low= _mm_cmpgt_epi8 (_mm_set1_epi8 (26), idx);
+  rng= _mm_or_si128 (rng, _mm_and_si128 (low, _mm_set1_epi8 (13)));
+  __m128i shift= _mm_setr_epi8 ('a' - 26, '0' - 52, '0' - 52, '0' - 52,
+                                '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                                '0' - 52, '0' - 52, '0' - 52, '+' - 62,
+                                '/' - 63, 'A', 0, 0);
+  v= _mm_add_epi8 (_mm_shuffle_epi8 (shift, rng), idx);
+  _mm_storeu_si128 ((__m128i*) out, v);
+}
+#elif defined(BASE64_VECTORS)
+static inline void
+encode_block (const unsigned char* in, char* out) {
+  // reads 16 bytes of in and writes 16 characters
+  static const unsigned char order[16]=
+    { 2, 1, 0, 255, 5, 4, 3, 255, 8, 7, 6, 255, 11, 10, 9, 255 };
+  uint32x4_t w= vreinterpretq_u32_u8 (vqtbl1q_u8 (vld1q_u8 (in),
+                                                 vld1q_u8 (order)));
+  uint32x4_t m= vdupq_n_u32 (0x3f);
+  uint32x4_t idx= vandq_u32 (vshrq_n_u32 (w, 18), m);
+  idx= vorrq_u32 (idx, vshlq_n_u32 (vandq_u32 (vshrq_n_u32 (w, 12), m), 8));
+  idx= vorrq_u32 (idx, vshlq_n_u32 (vandq_u32 (vshrq_n_u32 (w, 6), m), 16));
+  idx= vorrq_u32 (idx, vshlq_n_u32 (vandq_u32 (w, m), 24));
+  uint8x16x4_t table;
+  table.val[0]= vld1q_u8 ((const unsigned char*) int_to_b64);
+  table.val[1]= vld1q_u8 ((const unsigned char*) int_to_b64 + 16);
+  table.val[2]= vld1q_u8 ((const unsigned char*) int_to_b64 + 32);
+  table.val[3]= vld1q_u8 ((const unsigned char*) int_to_b64 + 48);
+  vst1q_u8 ((unsigned char*) out,
+            vqtbl4q_u8 (table, vreinterpretq_u8_u32 (idx)));
 }
+#endif
 
 string
 encode_base64 (string s) {
-  string r;
-  int i, n= N(s);
-  for (i=0; i+2<n; i+=3) {
-    if (i > 0 && i % 60 == 0) r << "\n";
-    r << encode_base64 (s[i], s[i+1], s[i+2]);
+  int n= N(s);
+  int lines= (n == 0? 0: (n - 1) / 60);
+  string r (4 * ((n + 2) / 3) + lines);
+  const unsigned char* in= (const unsigned char*) &s[0];
+  char* out= &r[0];
+  int i= 0;
+  while (i+2 < n) {
+    if (i > 0 && i % 60 == 0) *out++= '\n';
+#ifdef BASE64_VECTORS
+    if (i % 12 == 0 && i + 16 <= n) {
+      encode_block (in + i, out);
+      i += 12; out += 16;
+      continue;
+    }
+#endif
+    encode_group (in[i], in[i+1], in[i+2], out);
+    i += 3; out += 4;
   }
 
-  if (i == n-1) {
-    if (i > 0 && i % 60 == 0) r << "\n";
-    r << encode_base64 (s[i], '\0', '\0')(0,2) << "==";
-  }
-  else if (i == n-2) {
-    if (i > 0 && i % 60 == 0) r << "\n";
-    r << encode_base64 (s[i], s[i+1], '\0')(0,3) << "=";
+  if (i == n-1 || i == n-2) {
+    if (i > 0 && i % 60 == 0) *out++= '\n';
+    encode_group (in[i], i == n-2? in[i+1]: 0, 0, out);
+    out[3]= '=';
+    if (i == n-1) out[2]= '=';
   }
   return r;
 }
 
-// 'A' maps to (64+0), 'B' maps to (64+1), and so on, until '/' maps to (64+63)
-// Others maps to 43 ('?')
-static const char
-b64_to_int[]= "???????????????????????????????????????????~???\177tuvwxyz{|}??\
-?????@ABCDEFGHIJKLMNOPQRSTUVWXY??????Z[\\]^_`abcdefghijklmnopqrs?????";
-
-
-string
-decode_base64 (array<int> ac) {
-  string r(3);
-  int n= N(ac), n1, n2, n3, n4;
-
-  n1= b64_to_int[(int)ac[0]] - 64;
-  n2= b64_to_int[(int)ac[1]] - 64;
-  n3= (n>2)? b64_to_int[(int)ac[2]] - 64 : 0;
-  n4= (n>3)? b64_to_int[(int)ac[3]] - 64 : 0;
-
-  r[0]= ((n1 << 2) & 0xFC) + ((n2 >> 4) & 0x03);
-  r[1]= ((n2 << 4) & 0xF0) + ((n3 >> 2) & 0x0F);
-  r[2]= ((n3 << 6) & 0xC0) + (n4 & 0x3F);
+/******************************************************************************
+* Decoding
+******************************************************************************/
 
-  return r(0,n-1);
+#if defined(__SSSE3__)
+static inline bool
+decode_block (const unsigned char* in, unsigned char* out) {
+  // reads 16 characters and writes 16 bytes, of which the first 12 are
+  // the result, unless one of the characters is not in the alphabet
+  __m128i v = _mm_loadu_si128 ((const __m128i*) in);
+  __m128i hi= _mm_and_si128 (_mm_srli_epi32 (v, 4), _mm_set1_epi8 (0x0f));
+  __m128i lo= _mm_and_si128 (v, _mm_set1_epi8 (0x0f));
+  __m128i lut_lo= _mm_setr_epi8 (0x15, 0x11, 0x11, 0x11, 0x11, 0x11,
+                                 0x11, 0x11, 0x11, 0x11, 0x13, 0x1a,
+                                 0x1b, 0x1b, 0x1b, 0x1a);
+  __m128i lut_hi= _mm_setr_epi8 (0x10, 0x10, 0x01, 0x02, 0x04, 0x08,
+                                 0x04, 0x08, 0x10, 0x10, 0x10, 0x10,
+                                 0x10, 0x10, 0x10, 0x10);
+  __m128i bad= _mm_and_si128 (_mm_shuffle_epi8 (lut_lo, lo),
+                              _mm_shuffle_epi8 (lut_hi, hi));
+  if (_mm_movemask_epi8 (_mm_cmpeq_epi8 (bad, _mm_setzero_si128 ()))
+      != 0xffff) return false;
+  __m128i lut_roll= _mm_setr_epi8 (0, 16, 19, 4, -65, -65, -71, -71,
+                                   0, 0, 0, 0, 0, 0, 0, 0);
+  __m128i slash= _mm_cmpeq_epi8 (v, _mm_set1_epi8 ('/'));
+  v= _mm_add_epi8 (v, _mm_shuffle_epi8 (lut_roll, _mm_add_epi8 (slash, hi)));
+  v= _mm_maddubs_epi16 (v, _mm_set1_epi32 (0x01400140));
+  v= _mm_madd_epi16 (v, _mm_set1_epi32 (0x00011000));
+  v= _mm_shuffle_epi8 (v, _mm_setr_epi8 (2, 1, 0, 6, 5, 4, 10, 9, 8,
+                                         14, 13, 12, -1, -1, -1, -1));
+  _mm_storeu_si128 ((__m128i*) out, v);
+  return true;
 }
+#elif defined(BASE64_VECTORS)
+static inline bool
+decode_block (const unsigned char* in, unsigned char* out) {
+  // reads 16 characters and writes 16 bytes, of which the first 12 are
+  // the result, unless one of the characters is not in the alphabet
+  const unsigned char* t= (const unsigned char*) b64_to_int;
+  uint8x16x4_t t1, t2;
+  for (int k=0; k<4; k++) {
+    t1.val[k]= vld1q_u8 (t + 16*k);
+    t2.val[k]= vld1q_u8 (t + 64 + 16*k);
+  }
+  uint8x16_t c= vld1q_u8 (in);
+  uint8x16_t x= vorrq_u8 (vqtbl4q_u8 (t1, c),
+                          vqtbl4q_u8 (t2, vsubq_u8 (c, vdupq_n_u8 (64))));
+  // valid characters map to 64 + their value, others to '?' or zero
+  if (vminvq_u8 (vandq_u8 (x, vdupq_n_u8 (64))) == 0) return false;
+  uint32x4_t w= vreinterpretq_u32_u8 (vandq_u8 (x, vdupq_n_u8 (63)));
+  uint32x4_t m= vdupq_n_u32 (0xff);
+  uint32x4_t r= vshlq_n_u32 (vandq_u32 (w, m), 18);
+  r= vorrq_u32 (r, vshlq_n_u32 (vandq_u32 (vshrq_n_u32 (w, 8), m), 12));
+  r= vorrq_u32 (r, vshlq_n_u32 (vandq_u32 (vshrq_n_u32 (w, 16), m), 6));
+  r= vorrq_u32 (r, vshrq_n_u32 (w, 24));
+  static const unsigned char order[16]=
+    { 2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, 255, 255, 255, 255 };
+  vst1q_u8 (out, vqtbl1q_u8 (vreinterpretq_u8_u32 (r), vld1q_u8 (order)));
+  return true;
+}
+#endif
 
 string
 decode_base64 (string s) {
-  string r;
-  bool end= false;
-  array<int> tmp;
-  int i, n= N(s), cnt=0;
-  for (i=0; i<n && !end; i++) {
-    if (b64_to_int[(int)s[i]] != '?') {
-      tmp << (int)s[i];
-      cnt++;
+  int n= N(s);
+  string r (3 * (n / 4) + 8);
+  const unsigned char* in= (const unsigned char*) &s[0];
+  unsigned char* start= (unsigned char*) &r[0];
+  unsigned char* out= start;
+  int v[4], cnt= 0;
+  int i= 0;
+  while (i < n) {
+#ifdef BASE64_VECTORS
+    if (cnt == 0 && i + 16 <= n && decode_block (in + i, out)) {
+      i += 16; out += 12;
+      continue;
     }
-    else if (s[i] == '=') {
-      end= true;
+#endif
+    unsigned char c= in[i++];
+    int x= (c < 128? b64_to_int[c]: '?');
+    if (x != '?') {
+      v[cnt++]= x - 64;
+      if (cnt == 4) {
+        out[0]= (v[0] << 2) + (v[1] >> 4);
+        out[1]= (v[1] << 4) + (v[2] >> 2);
+        out[2]= (v[2] << 6) + v[3];
+        out += 3; cnt= 0;
+      }
     }
-
-    if (cnt == 4 || end) {
-      r << decode_base64 (tmp);
-      cnt= 0;
-      tmp= array<int> ();
+    else if (c == '=') {
+      // incomplete groups at the end are only decoded in case of padding
+      if (cnt >= 2) *out++= (v[0] << 2) + (v[1] >> 4);
+      if (cnt == 3) *out++= (v[1] << 4) + (v[2] >> 2);
+      break;
     }
   }
+  r->resize (out - start);
   return r;
 }
@@ -24,9 +24,23 @@ RESOURCE_CODE (converter);
 
 void
 operator << (converter c, string str) {
-  int index = 0;
-  while (index < N(str))
-    c->match(str, index);
+  int index = 0, n= N(str);
+  while (index < n) {
+    int start= index;
+    while (index < n && c->kind[(unsigned char) str[index]] == NO_MATCH)
+      index++;
+    if (index > start && c->copy_unmatched) {
+      if (start == 0 && index == n) c->output << str;
+      else c->output << str (start, index);
+    }
+    if (index == n) break;
+    unsigned char b= (unsigned char) str[index];
+    if (c->kind[b] == SINGLE_MATCH) {
+      c->output << c->single[b];
+      index++;
+    }
+    else c->match(str, index);
+  }
 }
 
 string
@@ -208,6 +222,20 @@ converter_rep::load () {
   }
 }
 
+void
+converter_rep::load_tables () {
+  for (int c=0; c<256; c++) {
+    kind[c]= NO_MATCH;
+    if (!ht->contains ((char) c)) continue;
+    hashtree<char,string> node= ht ((char) c);
+    if (N(node) == 0 && has_value (node)) {
+      kind[c]= SINGLE_MATCH;
+      single[c]= node->label;
+    }
+    else kind[c]= LONG_MATCH;
+  }
+}
+
 /******************************************************************************
 * convenience functions
 ******************************************************************************/
@@ -314,6 +342,11 @@ utf8_to_cork (string input) {
   int start, i, n= N(input);
   string output;
   for (i=0; i<n; ) {
+    unsigned char c= (unsigned char) input[i];
+    if (c < 0x80 && conv->kind[c] == NO_MATCH) {
+      output << input[i++];
+      continue;
+    }
     start= i;
     unsigned int code= decode_from_utf8 (input, i);
     string s= input (start, i);
@@ -331,6 +364,11 @@ sourcecode_to_cork (string input) {
   int start, i, n= N(input);
   string output;
   for (i=0; i<n; ) {
+    unsigned char c= (unsigned char) input[i];
+    if (c < 0x80 && conv->kind[c] == NO_MATCH) {
+      output << input[i++];
+      continue;
+    }
     start= i;
     unsigned int code= decode_from_utf8 (input, i);
     string s= input (start, i);
@@ -399,6 +437,11 @@ utf8_to_t2a (string input) {
   int start, i, n= N(input);
   string output;
   for (i=0; i<n; ) {
+    unsigned char c= (unsigned char) input[i];
+    if (c < 0x80 && conv->kind[c] == NO_MATCH) {
+      output << input[i++];
+      continue;
+    }
     start= i;
     unsigned int code= decode_from_utf8 (input, i);
     string s= input (start, i);
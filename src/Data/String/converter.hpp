@@ -24,19 +24,28 @@ RESOURCE(converter);
 * It does so by iterating over a string, finding the longest matching key
 * in the dictionary and replacing the matched substring with the translation.
 * The hashtree and converter classes are used.
+* Since most bytes of typical documents do not start any key, the kind of
+* each possible first byte is tabulated, so that runs of bytes without keys
+* are copied at once, and keys of a single byte are translated directly.
 ******************************************************************************/
 
+enum first_byte_kind { NO_MATCH, SINGLE_MATCH, LONG_MATCH };
+
 struct converter_rep: rep<converter> {
   hashtree<char,string> ht;
   string output, nil_string, from, to;
   bool copy_unmatched;
+  char kind[256];     // first_byte_kind of each byte, given the dictionary
+  string single[256]; // translations of the bytes of kind SINGLE_MATCH
   void match (string& str, int& index);
   void load ();
+  void load_tables ();
 
 public:
   inline converter_rep(string from2, string to2) : 
     rep<converter>(from2*"-"*to2), ht(), output(), 
-    nil_string(), from(from2), to(to2), copy_unmatched(true) { load(); }
+    nil_string(), from(from2), to(to2), copy_unmatched(true) {
+      load(); load_tables (); }
 
   inline bool has_value(hashtree<char,string> node);
 
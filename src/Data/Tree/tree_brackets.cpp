@@ -592,6 +592,24 @@ downgrade_big (tree t) {
   return r;
 }
 
+bool
+needs_downgrade_big (tree t) {
+  // does downgrade_big modify t? (without copying anything)
+  if (is_atomic (t)) return false;
+  int i, n= N(t);
+  if (is_func (t, BIG_AROUND, 2)) return true;
+  if (is_concat (t)) {
+    if (n < 2) return true;
+    for (i=0; i<n; i++)
+      if (t[i] == "" || is_concat (t[i]) ||
+          (i>0 && is_atomic (t[i]) && is_atomic (t[i-1])))
+        return true;
+  }
+  for (i=0; i<n; i++)
+    if (needs_downgrade_big (t[i])) return true;
+  return false;
+}
+
 /******************************************************************************
 * Moving wrongly brackets across 'math' tag boundary
 ******************************************************************************/
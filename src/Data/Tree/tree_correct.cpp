@@ -1068,7 +1068,7 @@ automatic_correct (tree t, string version) {
     if (enabled_preference ("zealous invisible correct"))
       t= missing_invisible_correct (t, 1);
   }
-  t= downgrade_big (t);
+  if (needs_downgrade_big (t)) t= downgrade_big (t);
   return t;
 }
 
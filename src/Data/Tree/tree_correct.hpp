@@ -23,6 +23,7 @@ tree upgrade_brackets (tree t, string mode= "text");
 tree upgrade_big (tree t);
 tree downgrade_brackets (tree t, bool del_miss= false, bool big_dot= true);
 tree downgrade_big (tree t);
+bool needs_downgrade_big (tree t);
 tree move_brackets (tree t);
 
 int  count_math_errors (tree t, int mode= 0);
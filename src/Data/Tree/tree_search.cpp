@@ -13,6 +13,7 @@
 #include "analyze.hpp"
 #include "boot.hpp"
 #include "drd_mode.hpp"
+#include "modification.hpp"
 
 int  search_max_hits= 1000000;
 bool blank_match_flag= false;
@@ -21,6 +22,7 @@ bool partial_match_flag= false;
 bool injective_match_flag= false;
 bool cascaded_match_flag= false;
 bool case_insensitive_match_flag= false;
+DN   search_signature= 0;
 
 void search (range_set& sel, tree t, tree what, path p);
 bool match (tree t, tree what);
@@ -74,6 +76,68 @@ is_accessible_for_search (tree t, int i) {
   return i >= 0 && i < N(t);
 }
 
+/******************************************************************************
+* Signatures for skipping subtrees which cannot contain a string
+******************************************************************************/
+
+#define SIGNATURE_MIN_SIZE 256
+
+static inline DN
+signature_bit (char c1, char c2) {
+  // all pairs of consecutive characters are recorded up to case
+  unsigned int h= 31 * ((unsigned int) (unsigned char) locase (c1)) +
+                  ((unsigned int) (unsigned char) locase (c2));
+  return ((DN) 1) << (h & 63);
+}
+
+static DN
+string_signature (string s) {
+  DN sig= 0;
+  for (int i=0; i+1<N(s); i++)
+    sig |= signature_bit (s[i], s[i+1]);
+  return sig;
+}
+
+static DN
+tree_signature (tree t, int& size) {
+  // signatures of large subtrees are cached until they are modified
+  if (is_atomic (t)) {
+    size= N(t->label);
+    return string_signature (t->label);
+  }
+  DN sig= 0;
+  if (obtain_signature (t, sig)) {
+    size= SIGNATURE_MIN_SIZE;
+    return sig;
+  }
+  size= 0;
+  for (int i=0; i<N(t); i++) {
+    int sub_size;
+    sig |= tree_signature (t[i], sub_size);
+    size += sub_size;
+  }
+  if (size >= SIGNATURE_MIN_SIZE) attach_signature (t, sig);
+  return sig;
+}
+
+static void
+initialize_signature (tree t, tree what) {
+  // matches of plain strings never extend over several strings
+  search_signature= 0;
+  if (is_atomic (what) && N(what->label) >= 2) {
+    int size;
+    search_signature= string_signature (what->label);
+    (void) tree_signature (t, size);
+  }
+}
+
+static inline bool
+may_contain_match (tree t) {
+  DN sig;
+  return search_signature == 0 || !obtain_signature (t, sig) ||
+         (sig & search_signature) == search_signature;
+}
+
 /******************************************************************************
 * Matching complex patterns inside strings
 ******************************************************************************/
@@ -353,6 +417,7 @@ search (range_set& sel, tree t, tree what, path p) {
   if (N(sel) > search_max_hits) return;
   if (is_atomic (t))
     search_string (sel, t->label, what, p);
+  else if (!may_contain_match (t)) return;
   else if (is_func (t, CONCAT) && is_func (what, CONCAT))
     search_concat (sel, t, what, p);
   else if (is_func (t, DOCUMENT) && is_func (what, DOCUMENT))
@@ -465,7 +530,11 @@ search (tree t, tree what, path p, int limit) {
   range_set sel;
   //cout << "Search " << what << ", " << contains_select_region (what) << "\n";
   if (contains_select_region (what)) select (sel, t, what, p);
-  else search (sel, t, what, p);
+  else {
+    initialize_signature (t, what);
+    search (sel, t, what, p);
+    search_signature= 0;
+  }
   //cout << "Selected " << sel << "\n";
   search_max_hits= 1000000;
   return sel;
@@ -478,7 +547,11 @@ search (tree t, tree what, path p, path pos, int limit) {
   range_set sel;
   //cout << "Search " << what << ", " << contains_select_region (what) << "\n";
   if (contains_select_region (what)) select (sel, t, what, p);
-  else search (sel, t, what, p, pos);
+  else {
+    initialize_signature (t, what);
+    search (sel, t, what, p, pos);
+    search_signature= 0;
+  }
   //cout << "Selected " << sel << "\n";
   search_max_hits= 1000000;
   return sel;
@@ -14,6 +14,7 @@
 #include "file.hpp"
 #include "sys_utils.hpp"
 #include "printer.hpp"
+#include "checksum_renderer.hpp"
 #include "convert.hpp"
 #include "connect.hpp"
 #include "typesetter.hpp"
@@ -22,6 +23,7 @@
 #include <setjmp.h>
 #include "image_files.hpp"
 #include "iterator.hpp"
+#include "tm_timer.hpp"
 
 #ifdef EXPERIMENTAL
 #include "../../Style/Memorizer/clean_copy.hpp"
@@ -216,8 +218,18 @@ edit_main_rep::nr_pages () {
   return N (the_box[0]);
 }
 
+static void
+print_page (renderer ren, box b, tree bg, double w, double h) {
+  ren->set_background (bg);
+  if (bg != "white" && bg != "#ffffff")
+    ren->clear_pattern (0, (SI) -h, (SI) w, 0);
+  rectangles rs;
+  b->redraw (ren, path (0), rs);
+}
+
 void
 edit_main_rep::print_doc (url name, bool conform, int first, int last) {
+  PROFILE_SCOPE ("print document");
   bool ps  = (suffix (name) == "ps");
   bool pdf = (suffix (name) == "pdf");
   url  orig= resolve (name, "");
@@ -286,14 +298,19 @@ edit_main_rep::print_doc (url name, bool conform, int first, int last) {
     ren->set_metadata ("subject", get_metadata ("subject"));
     for (i=start; i<end; i++) {
       tree bg= env->read (BG_COLOR);
-      ren->set_background (bg);
-      if (bg != "white" && bg != "#ffffff")
-        ren->clear_pattern (0, (SI) -h, (SI) w, 0);
-
-      rectangles rs;
       the_box[0]->sx(i)= 0;
       the_box[0]->sy(i)= 0;
-      the_box[0][i]->redraw (ren, path (0), rs);
+      if (ren->is_incremental ()) {
+        // pages which did not change since the previous export are reused
+        checksum_renderer_rep chk (ren);
+        print_page (&chk, the_box[0][i], bg, w, h);
+        if (ren->reuse_page (chk.get_checksum ())) {
+          chk.replay_links ();
+          if (i<end-1) ren->next_page ();
+          continue;
+        }
+      }
+      print_page (ren, the_box[0][i], bg, w, h);
       if (i<end-1) ren->next_page ();
     }
   }
@@ -364,6 +381,70 @@ edit_main_rep::export_ps (url name, string first, string last) {
   print_doc (name, true, as_int (first), as_int (last));
 }
 
+/******************************************************************************
+* Exporting pages as raster images
+******************************************************************************/
+
+static url
+raster_page_name (url name, int page) {
+  // page 3 of out.png is saved as out-3.png
+  string s= suffix (name);
+  return glue (unglue (name, N(s) + 1), "-" * as_string (page) * "." * s);
+}
+
+box
+edit_main_rep::typeset_on_paper (int dpi) {
+  typeset_preamble ();
+  typeset_prepare ();
+  env->write (DPI, as_string (dpi));
+  env->write (PAGE_SHOW_HF, "true");
+  env->write (PAGE_SCREEN_MARGIN, "false");
+  env->write (PAGE_BORDER, "none");
+  env->write (PAGE_MEDIUM, "paper");
+  env->write (PAGE_PRINTED, "true");
+  if (is_func (env->read (BG_COLOR), PATTERN))
+    env->write (BG_COLOR, env->exec (env->read (BG_COLOR)));
+  return typeset_as_document (env, subtree (et, rp), reverse (rp));
+}
+
+int
+edit_main_rep::typeset_pages () {
+  // typeset the whole buffer as for printing, without rendering it,
+  // so that the typesetter can be timed in isolation
+  PROFILE_SCOPE ("typeset pages");
+  box the_box= typeset_on_paper (as_int (printing_dpi));
+  return N(the_box[0]);
+}
+
+void
+edit_main_rep::export_raster (url name, int dpi, string first, string last) {
+  // the pages are rendered in software into pictures which are saved
+  // directly, so that neither a window nor an external converter is needed
+  PROFILE_SCOPE ("export raster");
+  box the_box= typeset_on_paper (dpi);
+
+  tree   bg   = env->read (BG_COLOR);
+  double w    = env->page_real_width;
+  double h    = env->page_real_height;
+  double zoomf= 5.0;  // as for snippets, the typesetting dpi fixes the size
+  SI     pixel= 5*PIXEL;
+  int    pxw  = max (1, ((SI) round (zoomf * w) + pixel-1) / pixel);
+  int    pxh  = max (1, ((SI) round (zoomf * h) + pixel-1) / pixel);
+  int    start= max (0, as_int (first) - 1);
+  int    end  = min (N(the_box[0]), as_int (last));
+  for (int i=start; i<end; i++) {
+    the_box[0]->sx(i)= 0;
+    the_box[0]->sy(i)= 0;
+    picture pic= native_picture (pxw, pxh, 0, 0);
+    renderer ren= picture_renderer (pic, zoomf);
+    ren->set_background (white);
+    ren->clear (0, (SI) -h, (SI) w, 0);
+    print_page (ren, the_box[0][i], bg, w, h);
+    tm_delete (ren);
+    save_picture (raster_page_name (name, i+1), pic);
+  }
+}
+
 array<int>
 edit_main_rep::print_snippet (url name, tree t, bool conserve_preamble) {
   tree buft= subtree (et, rp);
@@ -40,7 +40,8 @@ edit_typeset_rep::edit_typeset_rep ():
        buf->data->ref, (buf->prj==NULL? grefs: buf->prj->data->ref),
        buf->data->aux, (buf->prj==NULL? buf->data->aux: buf->prj->data->aux),
        buf->data->att, (buf->prj==NULL? buf->data->att: buf->prj->data->att)),
-  ttt (new_typesetter (env, subtree (et, rp), reverse (rp))) {
+  ttt (new_typesetter (env, subtree (et, rp), reverse (rp))),
+  released (false) {
     init_update ();
 }
 
@@ -166,6 +167,7 @@ use_modules (tree t) {
 
 void
 edit_typeset_rep::typeset_style_use_cache (tree style) {
+  PROFILE_SCOPE ("typeset style");
   style= preprocess_style (style, buf->buf->master);
   //cout << "Typesetting style using cache " << style << LF;
   bool ok;
@@ -843,6 +845,7 @@ void
 edit_typeset_rep::typeset_sub (SI& x1, SI& y1, SI& x2, SI& y2) {
   //time_t t1= texmacs_time ();
   typeset_prepare ();
+  released= false;
   eb= empty_box (reverse (rp));
   // saves memory, also necessary for change_log update
   bench_start ("typeset");
@@ -892,37 +895,76 @@ report_redefined (array<tree> redefined) {
 static void
 clean_unused (hashmap<string,tree>& refs, hashmap<string,bool> used) {
   array<string> a;
-  for (iterator<string> it= iterate (refs); it->busy(); ) {
-    string key= it->next ();
+  for (string key: refs)
     if (!used->contains (key)) a << key;
-  }
   for (int i=0; i<N(a); i++)
     refs->reset (a[i]);
 }
 
+static array<int>
+outdated_paragraphs (edit_env env, int n, bool& all) {
+  // the top-level paragraphs which read references whose values changed;
+  // all is set if the whole document has to be typeset again
+  all= false;
+  array<bool> flags (n);
+  for (int i=0; i<n; i++) flags[i]= false;
+  for (string key: env->changed) {
+    if (!env->local_ref->contains (key) && !env->global_ref->contains (key))
+      continue;
+    array<int> a= env->ref_readers [key];
+    for (int i=0; i<N(a); i++)
+      if (a[i] < 0 || a[i] >= n) all= true;
+      else flags[a[i]]= true;
+  }
+  array<int> r;
+  for (int i=0; i<n; i++)
+    if (all || flags[i]) r << i;
+  return r;
+}
+
 void
 edit_typeset_rep::typeset (SI& x1, SI& y1, SI& x2, SI& y2) {
-  int missing_nr= INT_MAX;
-  int redefined_nr= INT_MAX;
+  // After a complete typesetting pass, only the paragraphs which read
+  // references with changed values are typeset again, until the number
+  // of such paragraphs no longer decreases.
+  MEM_TAG_SCOPE (MEM_BOXES);
+  int outdated_nr= INT_MAX;
   x1= MAX_SI; y1= MAX_SI; x2= MIN_SI; y2= MIN_SI;
-  while (true) {
+  env->refining= false;
+  for (int pass= 1; true; pass++) {
     SI sx1, sy1, sx2, sy2;
     typeset_sub (sx1, sy1, sx2, sy2);
     x1= min (x1, sx1); y1= min (y1, sy1);
     x2= max (x2, sx2); y2= max (y2, sy2);
-    if (!env->complete) break;
+    if (!env->complete && !env->refining) break;
+    if (env->complete) clean_unused (env->local_ref, env->touched);
+    tree st= ttt->br->st;
+    bool all;
+    array<int> outdated= outdated_paragraphs (env, N(st), all);
+    debug_typeset << "Reference pass " << pass
+                  << (env->complete? " (complete)": "") << ": "
+                  << N(env->changed) << " changed references, "
+                  << N(outdated) << " of " << N(st)
+                  << " paragraphs outdated\n";
     env->complete= false;
-    clean_unused (env->local_ref, env->touched);
-    if (N(env->missing) == 0 && N(env->redefined) == 0) break;
-    if ((N(env->missing) == missing_nr && N(env->redefined) == redefined_nr) ||
-        (N(env->missing) > missing_nr || N(env->redefined) > redefined_nr)) {
+    env->refining= false;
+    if (N(outdated) == 0) {
+      if (N(env->missing) != 0) report_missing (env->missing);
+      break;
+    }
+    if (N(outdated) >= outdated_nr) {
       report_missing (env->missing);
       report_redefined (env->redefined);
       break;
     }
-    missing_nr= N(env->missing);
-    redefined_nr= N(env->redefined);
-    ::notify_assign (ttt, path(), ttt->br->st);
+    outdated_nr= N(outdated);
+    if (all || !is_func (st, DOCUMENT))
+      ::notify_assign (ttt, path(), st);
+    else {
+      for (int i=0; i<N(outdated); i++)
+        ::notify_assign (ttt, path (outdated[i]), st[outdated[i]]);
+      env->refining= true;
+    }
   }
 }
 
@@ -950,6 +992,23 @@ edit_typeset_rep::typeset_invalidate_all () {
   ::notify_assign (ttt, path(), subtree (et, rp));
 }
 
+void
+edit_typeset_rep::typeset_release () {
+  // Free the box tree and the bridges of a view which is not displayed;
+  // the document is typeset again as soon as the view is shown again
+  delete_typesetter (ttt);
+  ttt= new_typesetter (env, subtree (et, rp), reverse (rp));
+  eb= empty_box (reverse (rp));
+  typeset_invalidate_env ();
+  notify_change (THE_TREE + THE_ENVIRONMENT);
+  released= true;
+}
+
+bool
+edit_typeset_rep::typeset_released () {
+  return released;
+}
+
 void
 edit_typeset_rep::typeset_invalidate_players (path p, bool reattach) {
   if (rp <= p) {
@@ -28,6 +28,7 @@ protected:
   hashmap<string,tree> grefs;             // global references
   edit_env env;                           // the environment for typesetting
   typesetter ttt;                         // the (not) yet typesetted document
+  bool released;                          // ttt was freed to save memory
 
 protected:
   typesetter           get_typesetter ();
@@ -113,6 +114,8 @@ public:
   void     typeset_exec_until (path p);
   void     typeset_invalidate (path p);
   void     typeset_invalidate_all ();
+  void     typeset_release ();
+  bool     typeset_released ();
   void     typeset_invalidate_players (path p, bool reattach);
   void     typeset_sub (SI& x1, SI& y1, SI& x2, SI& y2);
   void     typeset (SI& x1, SI& y1, SI& x2, SI& y2);
@@ -14,6 +14,7 @@
 #include "analyze.hpp"
 #include "connect.hpp"
 #include "dictionary.hpp"
+#include "modification.hpp"
 
 /******************************************************************************
 * Finding completions in text
@@ -45,10 +46,64 @@ find_completions (
   }
 }
 
-static array<string>
-find_completions (drd_info drd, tree t, string prefix= "") {
+static void
+find_completions (drd_info drd, tree t, path skip, hashset<string>& h) {
+  // All words in t, except for those in the subtree at skip
+  if (is_nil (skip)) return;
+  if (is_atomic (t)) find_completions (drd, t, h);
+  else {
+    int i, n= N(t);
+    for (i=0; i<n; i++)
+      if (drd->is_accessible_child (t, i)) {
+        if (i == skip->item) find_completions (drd, t[i], skip->next, h);
+        else find_completions (drd, t[i], h);
+      }
+  }
+}
+
+/******************************************************************************
+* Index with the words of the document
+******************************************************************************/
+
+// Finding the completions of a word used to require a full traversal of
+// the document.  We now maintain a sorted index with all words, except
+// for those in the string at the cursor, which is rescanned each time.
+// Typing inside that string leaves the index valid; any other change
+// of the document invalidates it.
+
+void
+edit_interface_rep::complete_notify (modification mod) {
+  if (!completion_valid) return;
+  if ((mod->k == MOD_INSERT || mod->k == MOD_REMOVE) &&
+      path_up (mod->p) == completion_atom) return;
+  if (mod->k == MOD_ASSIGN && is_atomic (mod->t) &&
+      mod->p == completion_atom) return;
+  completion_valid= false;
+}
+
+array<string>
+edit_interface_rep::find_completions (string prefix) {
+  path p= path_up (tp);
+  if (!completion_valid || completion_atom != p) {
+    hashset<string> all;
+    ::find_completions (drd, et, p, all);
+    completion_index= as_completions (all);
+    completion_atom = p;
+    completion_valid= true;
+  }
   hashset<string> h;
-  find_completions (drd, t, h, prefix);
+  ::find_completions (drd, subtree (et, p), h, prefix);
+  int lo= 0, hi= N(completion_index);
+  while (lo < hi) {
+    int mid= (lo + hi) >> 1;
+    if (completion_index[mid] < prefix) lo= mid + 1;
+    else hi= mid;
+  }
+  for (; lo < N(completion_index); lo++) {
+    string r= completion_index[lo];
+    if (!starts (r, prefix)) break;
+    if (r != prefix) h->insert (r (N(prefix), N(r)));
+  }
   return as_completions (h);
 }
 
@@ -79,7 +134,7 @@ edit_interface_rep::complete_try () {
     int start= end-1;
     while ((start>0) && is_iso_alpha (s[start-1])) start--;
     ss= s (start, end);
-    a= find_completions (drd, et, ss);
+    a= find_completions (ss);
   }
   if (N(a) == 0) return false;
   complete_start (ss, a);
@@ -16,6 +16,7 @@
 #include "tm_window.hpp"
 #include "Metafont/tex_files.hpp"
 #include "data_cache.hpp"
+#include "metric_cache.hpp"
 #include "drd_mode.hpp"
 #include "message.hpp"
 #include "tree_traverse.hpp"
@@ -65,7 +66,7 @@ edit_interface_rep::edit_interface_rep ():
   pixel ((SI) tm_round ((std_shrinkf * PIXEL) / zoomf)), copy_always (),
   last_x (0), last_y (0), last_t (0),
   table_selection (false), mouse_adjusting (false),
-  oc (0, 0), temp_invalid_cursor (false),
+  oc (0, 0), temp_invalid_cursor (false), completion_valid (false),
   shadow (NULL), stored (NULL),
   cur_sb (2), cur_wb (2)
 {
@@ -507,6 +508,23 @@ edit_interface_rep::compute_env_rects (path p, rectangles& rs, bool recurse) {
 * handling changes
 ******************************************************************************/
 
+static void
+invalidate_delta (edit_interface_rep* ed, rectangles l1, rectangles l2) {
+  // Invalidate the rectangles which differ between l1 and l2. When a large
+  // selection is extended or shrunk, only its ends change, so that the
+  // common head and tail of both lists need not be repainted.
+  array<rectangle> a1, a2;
+  for (; !is_nil (l1); l1= l1->next) a1 << l1->item;
+  for (; !is_nil (l2); l2= l2->next) a2 << l2->item;
+  int n1= N(a1), n2= N(a2), h= 0, t= 0;
+  while (h < n1 && h < n2 && a1[h] == a2[h]) h++;
+  while (t < n1 - h && t < n2 - h && a1[n1-1-t] == a2[n2-1-t]) t++;
+  rectangles d;
+  for (int i= h; i < n1 - t; i++) d= rectangles (a1[i], d);
+  for (int i= h; i < n2 - t; i++) d= rectangles (a2[i], d);
+  ed->invalidate (d);
+}
+
 void
 edit_interface_rep::notify_change (int change) {
   env_change= env_change | change;
@@ -557,6 +575,7 @@ edit_interface_rep::update_menus () {
   }
   if (!gui_interrupted ()) drd_update ();
   cache_memorize ();
+  save_metric_caches ();
   last_update= last_change;
   save_user_preferences ();
 }
@@ -676,13 +695,21 @@ edit_interface_rep::apply_changes () {
   }
   
   // cout << "Handling selection\n";
+  rectangles old_selection_rects;
+  bool selection_delta= false;
   if (env_change & (THE_TREE+THE_ENVIRONMENT+THE_SELECTION)) {
     if (!is_nil (selection_rects)) {
-      invalidate (selection_rects);
       if (!selection_active_any ()) {
+        invalidate (selection_rects);
         set_selection (tp, tp);
         selection_rects= rectangles ();
       }
+      else if ((env_change & (THE_TREE+THE_ENVIRONMENT)) == 0 &&
+               (env_change & THE_SELECTION) != 0) {
+        old_selection_rects= selection_rects;
+        selection_delta= true;
+      }
+      else invalidate (selection_rects);
     }
     if (N (alt_selection_rects) != 0) {
       rectangles visible (rectangle (vx1, vy1, vx2, vy2));
@@ -703,7 +730,9 @@ edit_interface_rep::apply_changes () {
   if (env_change & (THE_TREE+THE_ENVIRONMENT)) {
     typeset_invalidate_env ();
     SI x1, y1, x2, y2;
+    LATENCY_STAGE ("wait");
     typeset (x1, y1, x2, y2);
+    LATENCY_STAGE ("typeset");
     invalidate (x1- 2*pixel, y1- 2*pixel, x2+ 2*pixel, y2+ 2*pixel);
     // check_data_integrety ();
     the_ghost_cursor()= eb->find_check_cursor (tp);
@@ -859,8 +888,9 @@ edit_interface_rep::apply_changes () {
 #ifndef QTTEXMACS
       rs= simplify (::correct (rs - thicken (rs, -pixel, -pixel)));
 #endif
+      if (selection_delta) invalidate_delta (this, old_selection_rects, rs);
+      else invalidate (rs);
       selection_rects= rs;
-      invalidate (selection_rects);
     }
   }
 
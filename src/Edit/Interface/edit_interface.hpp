@@ -66,6 +66,9 @@ protected:
   array<string> completions;
   string        completion_prefix;
   int           completion_pos;
+  array<string> completion_index; // sorted words outside completion_atom
+  path          completion_atom;  // string at the cursor, not indexed
+  bool          completion_valid; // whether completion_index is up to date
   renderer      shadow;
   SI            vx1, vy1, vx2, vy2;
   rectangles    stored_rects;
@@ -153,10 +156,13 @@ public:
   tree kbd_shortcut (string s);
   void key_press (string key);
   void emulate_keyboard (string keys, string action= "");
+  void replay_keys (url trace);
   bool complete_try ();
   void complete_message ();
   void complete_start (string prefix, array<string> compls);
   bool complete_keypress (string key);
+  void complete_notify (modification mod);
+  array<string> find_completions (string prefix);
   string session_complete_command (tree t);
   void custom_complete (tree t);
 
@@ -202,6 +208,7 @@ public:
   void handle_set_zoom_factor (double zoomf);
   void handle_clear (renderer win, SI x1, SI y1, SI x2, SI y2);
   void handle_repaint (renderer win, SI x1, SI y1, SI x2, SI y2);
+  void repaint_offscreen ();
 
   friend class interactive_command_rep;
   friend class tm_window_rep;
@@ -13,6 +13,8 @@
 #include "analyze.hpp"
 #include "tm_buffer.hpp"
 #include "archiver.hpp"
+#include "file.hpp"
+#include "tm_timer.hpp"
 
 /******************************************************************************
 * Showing the keystrokes while typing
@@ -28,6 +30,50 @@ int           kbd_hide_delay = 3000;
 bool get_show_kbd () { return kbd_show_keys; }
 void set_show_kbd (bool flag) { kbd_show_keys= flag; }
 
+/******************************************************************************
+* Recording the keystrokes, so that editing sessions can be replayed
+******************************************************************************/
+
+static bool          kbd_recording= false;
+static array<string> kbd_record_keys;
+static array<time_t> kbd_record_times;
+
+void
+start_recording_keys () {
+  kbd_recording   = true;
+  kbd_record_keys = array<string> ();
+  kbd_record_times= array<time_t> ();
+}
+
+bool
+stop_recording_keys (url trace) {
+  // one line for each keystroke, with the delay in ms since the previous one
+  kbd_recording= false;
+  string s;
+  for (int i=0; i<N(kbd_record_keys); i++) {
+    time_t d= (i == 0? 0: kbd_record_times[i] - kbd_record_times[i-1]);
+    s << as_string ((int) d) << " " << kbd_record_keys[i] << "\n";
+  }
+  return save_string (trace, s);
+}
+
+void
+edit_interface_rep::replay_keys (url trace) {
+  // the keystrokes are replayed without delays and each of them is
+  // typeset and repainted offscreen before handling the next one
+  string s;
+  if (load_string (trace, s, false)) return;
+  array<string> lines= tokenize (s, "\n");
+  for (int i=0; i<N(lines); i++) {
+    int pos= search_forwards (" ", lines[i]);
+    if (pos <= 0) continue;
+    handle_keypress (lines[i] (pos+1, N(lines[i])), texmacs_time ());
+    apply_changes ();
+    repaint_offscreen ();
+    LATENCY_END ();
+  }
+}
+
 /******************************************************************************
 * Basic subroutines for keyboard handling
 ******************************************************************************/
@@ -261,6 +307,8 @@ edit_interface_rep::kbd_shortcut (string cmd) {
 void
 edit_interface_rep::handle_keypress (string key, time_t t) {
   bool started= false;
+  LATENCY_BEGIN ();
+  LATENCY_STAGE ("queue");
 #ifdef USE_EXCEPTIONS
   try {
 #endif
@@ -275,6 +323,10 @@ edit_interface_rep::handle_keypress (string key, time_t t) {
         kbd_last_times << t;
       }
     }
+    if (kbd_recording && search_forwards ("\n", key) < 0) {
+      kbd_record_keys  << key;
+      kbd_record_times << t;
+    }
     if (DEBUG_KEYBOARD) {
       //for (int i=0; i<N(key); i++)
       //  cout << ((int) (unsigned char) key[i]) << " ";
@@ -293,11 +345,13 @@ edit_interface_rep::handle_keypress (string key, time_t t) {
     string gkey= replace (key, zero, "<#0>");
     if (gkey == "<#3000>") gkey= "space";
     call ("keyboard-press", object (gkey), object ((double) t));
+    LATENCY_STAGE ("scheme");
     update_focus_loci ();
     if (!is_nil (focus_ids))
       call ("link-follow-ids", object (focus_ids), object ("focus"));
     notify_change (THE_DECORATIONS);
     end_editing ();
+    LATENCY_STAGE ("editing");
     //time_t t2= texmacs_time ();
     //if (t2 - t1 >= 10) cout << "handle_keypress took " << t2-t1 << "ms\n";
 #ifdef USE_EXCEPTIONS
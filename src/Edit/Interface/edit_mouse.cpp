@@ -272,6 +272,23 @@ edit_interface_rep::set_pointer (
 * Active loci
 ******************************************************************************/
 
+static list<string>
+upward_ids (tree et, path rp, path p) {
+  // identifiers of the loci at p and its ancestors below rp, innermost first
+  list<string> ids;
+  if (!(rp <= p)) return ids;
+  array<tree> ts;
+  tree t= et;
+  int k= 0, n= N(rp);
+  for (path q= p; true; q= q->next, k++) {
+    if (k >= n) ts << t;
+    if (is_nil (q)) break;
+    t= t[q->item];
+  }
+  for (int i=N(ts)-1; i>=0; i--) ids << get_ids (ts[i]);
+  return ids;
+}
+
 void
 edit_interface_rep::update_mouse_loci () {
   if (is_nil (eb)) {
@@ -284,14 +301,10 @@ edit_interface_rep::update_mouse_loci () {
   path cp= path_up (tree_path (path (), last_x, last_y, 0));
   set_access_mode (old_mode);
   tree mt= subtree (et, cp);
-  path p = cp;
   list<string> ids1, ids2;
   rectangles rs1, rs2;
   eb->loci (last_x, last_y, 0, ids1, rs1);
-  while (rp <= p) {
-    ids2 << get_ids (subtree (et, p));
-    p= path_up (p);
-  }
+  ids2= upward_ids (et, rp, cp);
 
   locus_new_rects= rectangles ();
   mouse_ids= list<string> ();
@@ -316,12 +329,7 @@ edit_interface_rep::update_mouse_loci () {
 
 void
 edit_interface_rep::update_focus_loci () {
-  path p= path_up (tp);
-  list<string> ids;
-  while (rp <= p) {
-    ids << get_ids (subtree (et, p));
-    p= path_up (p);
-  }
+  list<string> ids= upward_ids (et, rp, path_up (tp));
   focus_ids= list<string> ();
   if (!is_nil (ids) && !has_changed (THE_FOCUS)) {
     ids= as_list_string (call ("link-active-ids", object (ids)));
@@ -12,6 +12,7 @@
 #include "Interface/edit_interface.hpp"
 #include "message.hpp"
 #include "gui.hpp" // for gui_interrupted
+#include "picture.hpp"
 
 extern int nr_painted;
 extern void clear_pattern_rectangles (renderer ren, rectangle m, rectangles l);
@@ -389,8 +390,32 @@ edit_interface_rep::handle_repaint (renderer win, SI x1, SI y1, SI x2, SI y2) {
   */
 
   // cout << "Repainting\n";
+  LATENCY_STAGE ("update");
   draw_with_stored (win, rectangle (x1, y1, x2, y2) /magf);
+  LATENCY_END ();
   if (last_change-last_update > 0)
     last_change = texmacs_time ();
   // cout << "Repainted\n";
 }
+
+void
+edit_interface_rep::repaint_offscreen () {
+  // repaint the visible part of the document into a picture, in the same
+  // way as the widget does, e.g. for replaying keystrokes without display
+#ifdef QTTEXMACS
+  update_visible ();
+  SI  X1= (SI) (vx1 * magf), Y1= (SI) (vy1 * magf);
+  SI  X2= (SI) (vx2 * magf), Y2= (SI) (vy2 * magf);
+  int w = max (1, (X2 - X1) / PIXEL);
+  int h = max (1, (Y2 - Y1) / PIXEL);
+  picture pic= native_picture (w, h, 0, 0);
+  renderer ren= picture_renderer (pic, 1.0);
+  rectangle r (0, 0, w, h);
+  ren->set_origin (-X1, -Y2);
+  ren->encode (r->x1, r->y1);
+  ren->encode (r->x2, r->y2);
+  ren->set_clipping (r->x1, r->y2, r->x2, r->y1);
+  handle_repaint (ren, r->x1, r->y2, r->x2, r->y1);
+  tm_delete (ren);
+#endif
+}
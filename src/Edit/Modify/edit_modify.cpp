@@ -248,8 +248,10 @@ void
 edit_done (editor_rep* ed, modification mod) {
   path p= copy (mod->p);
   ASSERT (ed->the_buffer_path() <= p, "invalid modification");
-  if (mod->k != MOD_SET_CURSOR)
+  if (mod->k != MOD_SET_CURSOR) {
+    ed->complete_notify (mod);
     ed->post_notify (p);
+  }
 #ifdef EXPERIMENTAL
   copy_announce (subtree (ed->et, ed->rp), ed->cct, mod / ed->rp);
 #endif
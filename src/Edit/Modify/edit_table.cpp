@@ -228,10 +228,46 @@ edit_table_rep::with_read (tree with, int nr_rows, int nr_cols,
   with_decode (nr_rows, nr_cols, i1, j1, i2, j2);
 }
 
+bool
+edit_table_rep::with_inside (tree with, int nr_rows, int nr_cols,
+                             int i1, int j1, int i2, int j2, string var)
+{
+  if (!is_func (with, CWITH, 6)) return false;
+  if ((var != "") && (var != with[4])) return false;
+  int row1, col1, row2, col2;
+  with_read (with, nr_rows, nr_cols, row1, col1, row2, col2);
+  return (row1>=i1) && (col1>=j1) && (row2<=i2) && (col2<=j2);
+}
+
 /******************************************************************************
 * Formatting primitives
 ******************************************************************************/
 
+// The formatting instructions of large tables are modified as a whole:
+// the new instructions are computed first and table_assign_format then
+// replaces the range of instructions which actually changed, using
+// a single removal and a single insertion.  This avoids one modification
+// (with its undo entry and typesetter notification) per instruction.
+
+static tree
+with_assign (tree with, int i, int val) {
+  int k, n= N(with);
+  tree r (with, n);
+  for (k=0; k<n; k++) r[k]= with[k];
+  r[i]= as_string (val);
+  return r;
+}
+
+void
+edit_table_rep::table_assign_format (path fp, tree fm) {
+  tree st= subtree (et, fp);
+  int n= N(st) - 1, m= N(fm), i1= 0, i2= 0;
+  while (i1 < n && i1 < m && st[i1] == fm[i1]) i1++;
+  while (i2 < n-i1 && i2 < m-i1 && st[n-1-i2] == fm[m-1-i2]) i2++;
+  if (n-i1-i2 > 0) remove (fp * i1, n-i1-i2);
+  if (m-i1-i2 > 0) insert (fp * i1, fm (i1, m-i2));
+}
+
 tree
 edit_table_rep::table_get_format (path fp) {
   tree fm= get_env_value (CELL_FORMAT, fp * 0);
@@ -241,10 +277,14 @@ edit_table_rep::table_get_format (path fp) {
 
 void
 edit_table_rep::table_set_format (path fp, string var, tree val) {
-  table_del_format (fp, var);
-  tree with (TWITH, var, val);
   tree st= subtree (et, fp);
-  insert (fp * (N(st)-1), tree (TFORMAT, with));
+  tree fm (TFORMAT);
+  int k, n= N(st);
+  for (k=0; k<n-1; k++)
+    if (!is_func (st[k], TWITH, 2) || (var != st[k][0]))
+      fm << st[k];
+  fm << tree (TWITH, var, val);
+  table_assign_format (fp, fm);
 }
 
 tree
@@ -261,24 +301,35 @@ edit_table_rep::table_get_format (path fp, string var) {
 void
 edit_table_rep::table_del_format (path fp, string var) {
   tree st= subtree (et, fp);
+  tree fm (TFORMAT);
   int k, n= N(st);
-  for (k=n-2; k>=0; k--)
-    if (is_func (st[k], TWITH, 2))
-      if ((var == "") || (var == st[k][0]))
-        remove (fp * k, 1);
+  for (k=0; k<n-1; k++)
+    if (!is_func (st[k], TWITH, 2) || ((var != "") && (var != st[k][0])))
+      fm << st[k];
+  table_assign_format (fp, fm);
 }
 
 void
 edit_table_rep::table_set_format (
   path fp, int I1, int J1, int I2, int J2, string var, tree val)
 {
-  table_del_format (fp, I1, J1, I2, J2, var);
+  int i1, j1, i2, j2;
+  int nr_rows, nr_cols;
+  tree st= subtree (et, fp);
+  table_get_extents (fp, nr_rows, nr_cols);
+  with_decode (nr_rows, nr_cols, I1, J1, I2, J2, i1, j1, i2, j2);
+
+  tree fm (TFORMAT);
+  int k, n= N(st);
+  for (k=0; k<n-1; k++)
+    if (!with_inside (st[k], nr_rows, nr_cols, i1, j1, i2, j2, var))
+      fm << st[k];
   tree with (CWITH);
   with << as_string (I1) << as_string (I2)
        << as_string (J1) << as_string (J2)
        << var << val;
-  tree st= subtree (et, fp);
-  insert (fp * (N(st)-1), tree (TFORMAT, with));
+  fm << with;
+  table_assign_format (fp, fm);
 }
 
 tree
@@ -313,15 +364,12 @@ edit_table_rep::table_del_format (
   table_get_extents (fp, nr_rows, nr_cols);
   with_decode (nr_rows, nr_cols, I1, J1, I2, J2, i1, j1, i2, j2);
 
+  tree fm (TFORMAT);
   int k, n= N(st);
-  for (k=n-2; k>=0; k--)
-    if (is_func (st[k], CWITH, 6))
-      if ((var == "") || (var == st[k][4])) {
-        int row1, col1, row2, col2;
-        with_read (st[k], nr_rows, nr_cols, row1, col1, row2, col2);
-        if ((row1>=i1) && (col1>=j1) && (row2<=i2) && (col2<=j2))
-          remove (fp * k, 1);
-      }
+  for (k=0; k<n-1; k++)
+    if (!with_inside (st[k], nr_rows, nr_cols, i1, j1, i2, j2, var))
+      fm << st[k];
+  table_assign_format (fp, fm);
 }
 
 void
@@ -352,27 +400,30 @@ edit_table_rep::table_individualize (path fp, string var) {
   tree st= subtree (et, fp);
   table_get_extents (fp, nr_rows, nr_cols);
 
+  tree fm (TFORMAT);
   int k, n= N(st);
-  for (k=n-2; k>=0; k--)
+  for (k=0; k<n-1; k++) {
     if (is_func (st[k], CWITH, 6))
       if ((var == "") || (var == st[k][4])) {
         int i, j, row1, col1, row2, col2;
         with_read (st[k], nr_rows, nr_cols, row1, col1, row2, col2);
-        if ((row1==row2) && (col1==col2)) continue;
-        row1= max (row1, 0); row2= min (row2, nr_rows-1);
-        col1= max (col1, 0); col2= min (col2, nr_cols-1);
-        tree ins_format (TFORMAT);
-        for (i=row1; i<=row2; i++)
-          for (j=col1; j<=col2; j++) {
-            tree with (CWITH);
-            with << as_string (i+1) << as_string (i+1)
-                 << as_string (j+1) << as_string (j+1)
-                 << copy (st[k][4]) << copy (st[k][5]) << copy (st[k][6]);
-            ins_format << with;
-          }
-        remove (fp * k, 1);
-        insert (fp * k, ins_format);
+        if ((row1!=row2) || (col1!=col2)) {
+          row1= max (row1, 0); row2= min (row2, nr_rows-1);
+          col1= max (col1, 0); col2= min (col2, nr_cols-1);
+          for (i=row1; i<=row2; i++)
+            for (j=col1; j<=col2; j++) {
+              tree with (CWITH);
+              with << as_string (i+1) << as_string (i+1)
+                   << as_string (j+1) << as_string (j+1)
+                   << copy (st[k][4]) << copy (st[k][5]) << copy (st[k][6]);
+              fm << with;
+            }
+          continue;
+        }
       }
+    fm << st[k];
+  }
+  table_assign_format (fp, fm);
 }
 
 void
@@ -385,9 +436,11 @@ edit_table_rep::table_format_center (path fp, int row, int col) {
   int Row2= row-nr_rows;
   int Col2= col-nr_cols;
 
+  tree fm (TFORMAT);
   int k, n= N(st);
-  for (k=n-2; k>=0; k--)
-    if (is_func (st[k], CWITH, 6)) {
+  for (k=0; k<n-1; k++)
+    if (!is_func (st[k], CWITH, 6)) fm << st[k];
+    else {
       int I1, I2, J1, J2, i1, i2, j1, j2;
       with_read (st[k], nr_rows, nr_cols, I1, J1, I2, J2, i1, j1, i2, j2);
 
@@ -405,11 +458,14 @@ edit_table_rep::table_format_center (path fp, int row, int col) {
       else if (j2 < col) J2= j2+1;
       else J2= j2-nr_cols;
 
-      assign (fp * path (k, 0), as_string (I1));
-      assign (fp * path (k, 1), as_string (I2));
-      assign (fp * path (k, 2), as_string (J1));
-      assign (fp * path (k, 3), as_string (J2));
+      tree w= st[k];
+      w= with_assign (w, 0, I1);
+      w= with_assign (w, 1, I2);
+      w= with_assign (w, 2, J1);
+      w= with_assign (w, 3, J2);
+      fm << w;
     }
+  table_assign_format (fp, fm);
 }
 
 /******************************************************************************
@@ -478,34 +534,39 @@ edit_table_rep::table_remove (path fp, int row, int col, int delr, int delc) {
 
   tree st= subtree (et, fp);
   if (!is_func (st, TFORMAT)) return;
+  tree fm (TFORMAT);
   int k, n= N(st);
-  for (k=n-2; k>=0; k--)
-    if (is_func (st[k], CWITH, 6)) {
+  for (k=0; k<n-1; k++)
+    if (!is_func (st[k], CWITH, 6)) fm << st[k];
+    else {
       int I1, I2, J1, J2, i1, i2, j1, j2;
-      with_read (st[k], nr_rows, nr_cols, I1, J1, I2, J2, i1, j1, i2, j2);
+      tree w= st[k];
+      with_read (w, nr_rows, nr_cols, I1, J1, I2, J2, i1, j1, i2, j2);
       if (delr>0) {
-        if ((row<=i1) && (i2<row+delr)) { remove (fp * k, 1); continue; }
+        if ((row<=i1) && (i2<row+delr)) continue;
         if ((I1>0) && (i1>=row))
-          assign (fp * path (k, 0), as_string (I1- min (delr, i1- row)));
+          w= with_assign (w, 0, I1- min (delr, i1- row));
         if ((I1<0) && (i1<row+delr))
-          assign (fp * path (k, 0), as_string (I1+ delr+ min (0, row- 1- i1)));
+          w= with_assign (w, 0, I1+ delr+ min (0, row- 1- i1));
         if ((I2>0) && (i2>=row))
-          assign (fp * path (k, 1), as_string (I2- min (delr, i2- row)));
+          w= with_assign (w, 1, I2- min (delr, i2- row));
         if ((I2<0) && (i2<row+delr))
-          assign (fp * path (k, 1), as_string (I2+ delr+ min (0, row- 1- i2)));
+          w= with_assign (w, 1, I2+ delr+ min (0, row- 1- i2));
       }
       if (delc>0) {
-        if ((col<=j1) && (j2<col+delc)) { remove (fp * k, 1); continue; }
+        if ((col<=j1) && (j2<col+delc)) continue;
         if ((J1>0) && (j1>=col))
-          assign (fp * path (k, 2), as_string (J1- min (delc, j1- col)));
+          w= with_assign (w, 2, J1- min (delc, j1- col));
         if ((J1<0) && (j1<col+delc))
-          assign (fp * path (k, 2), as_string (J1+ delc+ min (0, col- 1- j1)));
+          w= with_assign (w, 2, J1+ delc+ min (0, col- 1- j1));
         if ((J2>0) && (j2>=col))
-          assign (fp * path (k, 3), as_string (J2- min (delc, j2- col)));
+          w= with_assign (w, 3, J2- min (delc, j2- col));
         if ((J2<0) && (j2<col+delc))
-          assign (fp * path (k, 3), as_string (J2+ delc+ min (0, col- 1- j2)));
+          w= with_assign (w, 3, J2+ delc+ min (0, col- 1- j2));
       }
+      fm << w;
     }
+  table_assign_format (fp, fm);
 }
 
 void
@@ -529,34 +590,39 @@ edit_table_rep::table_insert (path fp, int row, int col, int insr, int insc) {
 
   tree st= subtree (et, fp);
   if (!is_func (st, TFORMAT)) return;
+  tree fm (TFORMAT);
   int k, n= N(st);
-  for (k=n-2; k>=0; k--)
-    if (is_func (st[k], CWITH, 6)) {
+  for (k=0; k<n-1; k++)
+    if (!is_func (st[k], CWITH, 6)) fm << st[k];
+    else {
       int I1, I2, J1, J2, i1, i2, j1, j2;
-      with_read (st[k], nr_rows, nr_cols, I1, J1, I2, J2, i1, j1, i2, j2);
+      tree w= st[k];
+      with_read (w, nr_rows, nr_cols, I1, J1, I2, J2, i1, j1, i2, j2);
       if (insr>0) {
         bool flag= (I1<=0) || (I2>=0);
         if ((I1>0) && ((i1>row) || (flag && (i1==row))))
-          assign (fp* path (k,0), as_string (I1+insr));
+          w= with_assign (w, 0, I1+insr);
         if ((I1<0) && (i1<row))
-          assign (fp* path (k,0), as_string (I1-insr));
+          w= with_assign (w, 0, I1-insr);
         if ((I2>0) && (i2>=row))
-          assign (fp* path (k,1), as_string (I2+insr));
+          w= with_assign (w, 1, I2+insr);
         if ((I2<0) && ((i2<row-1) || (flag && (i2==row-1))))
-          assign (fp* path (k,1), as_string (I2-insr));
+          w= with_assign (w, 1, I2-insr);
       }
       if (insc>0) {
         bool flag= (J1<=0) || (J2>=0);
         if ((J1>0) && ((j1>col) || (flag && (j1==col))))
-          assign (fp * path (k,2), as_string (J1+insc));
+          w= with_assign (w, 2, J1+insc);
         if ((J1<0) && (j1<col))
-          assign (fp * path (k,2), as_string (J1-insc));
+          w= with_assign (w, 2, J1-insc);
         if ((J2>0) && (j2>=col))
-          assign (fp * path (k,3), as_string (J2+insc));
+          w= with_assign (w, 3, J2+insc);
         if ((J2<0) && ((j2<col-1) || (flag && (j2==col-1))))
-          assign (fp * path (k,3), as_string (J2-insc));
+          w= with_assign (w, 3, J2-insc);
       }
+      fm << w;
     }
+  table_assign_format (fp, fm);
 }
 
 /******************************************************************************
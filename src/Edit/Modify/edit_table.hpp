@@ -41,11 +41,14 @@ protected:
   void with_read (tree with, int nr_rows, int nr_cols,
 		  int& I1, int& J1, int& I2, int& J2,
 		  int& i1, int& j1, int& i2, int& j2);
+  bool with_inside (tree with, int nr_rows, int nr_cols,
+		    int i1, int j1, int i2, int j2, string var);
   
   // Routines for formatting tables
   tree table_get_format (path fp);
   void table_set_format (path fp, string var, tree val);
   tree table_get_format (path fp, string var);
+  void table_assign_format (path fp, tree fm);
   void table_del_format (path fp, string var);
   void table_set_format (path fp, int I1, int J1, int I2, int J2,
 			 string var, tree val);
@@ -13,6 +13,7 @@
 #include "analyze.hpp"
 #include "tm_buffer.hpp"
 #include "merge_sort.hpp"
+#include "hashset.hpp"
 #include "Bibtex/bibtex.hpp"
 #include "Bibtex/bibtex_functions.hpp"
 #include "Sqlite3/sqlite3.hpp"
@@ -149,14 +150,11 @@ edit_process_rep::generate_bibliography (
         for (int i=0; i<N(bib_t); i++)
           if (bib_t[i] != "*") new_t << bib_t[i];
           else {
-            string sbib;
-            if (load_string (bib_file, sbib, false))
+            if (!is_regular (bib_file))
               std_error << "Could not load BibTeX file " << fname;
-            tree pt= parse_bib (sbib);
-            if (is_document (pt))
-              for (int j=0; j<N(pt); j++)
-                if (is_compound (pt[j], "bib-entry") && N(pt[j]) >= 2)
-                  new_t << pt[j][1];
+            array<string> keys= bib_entry_keys (bib_file);
+            for (int j=0; j<N(keys); j++)
+              new_t << keys[j];
           }
         bib_t= new_t;
       }
@@ -183,13 +181,25 @@ edit_process_rep::generate_bibliography (
       t= as_tree (call (string ("bib-compile"), args));
     }
     else if (starts (style, "tm-")) {
-      string sbib;
-      if (load_string (bib_file, sbib, false))
+      // only parse the cited entries, first from the bibliography file,
+      // and then the remaining ones from texmacs.bib
+      array<string> keys;
+      for (int i=0; i<N(bib_t); i++)
+        if (is_atomic (bib_t[i])) keys << bib_t[i]->label;
+      if (!is_regular (bib_file))
         std_error << "Could not load BibTeX file " << fname;
-      string xsbib;
-      if (!load_string (xbib_file, xsbib, false))
-        sbib << "\n" << xsbib;
-      tree te= bib_entries (parse_bib (sbib), bib_t);
+      tree pt= parse_bib_entries (bib_file, keys);
+      if (is_regular (xbib_file)) {
+        hashset<string> found;
+        for (int i=0; i<N(pt); i++)
+          if (is_compound (pt[i], "bib-entry", 3) && is_atomic (pt[i][1]))
+            found->insert (pt[i][1]->label);
+        array<string> rest;
+        for (int i=0; i<N(keys); i++)
+          if (!found->contains (keys[i])) rest << keys[i];
+        pt << A(parse_bib_entries (xbib_file, rest));
+      }
+      tree te= bib_entries (pt, bib_t);
       object ot= tree_to_stree (te);
       eval ("(use-modules (bibtex " * style (3, N(style)) * "))");
       t= stree_to_tree (call (string ("bib-process"),
@@ -421,26 +431,26 @@ edit_process_rep::generate_index (string idx) {
     R= buf->prj->data->ref;
   }
   if (N(I)>0) {
+    // The sort key of each entry is computed only once and only the
+    // distinct keys are sorted; entries with the same key are grouped in h
     followup= hashmap<string,tree> (TUPLE);
     int i, n= N(I);
-    array<string> entry (n);
-    for (i=0; i<n; i++)
-      entry[i]= index_name (I[i]);
-    merge_sort (entry);
-
+    array<string> entry;
     hashmap<string,tree> h (TUPLE);
     for (i=0; i<n; i++) {
       string name = index_name  (I[i]);
       tree   value= index_value (I[i]);
-      if (!h->contains (name)) h (name)= tuple (value);
+      if (!h->contains (name)) {
+        h (name)= tuple (value);
+        entry << name;
+      }
       else h (name) << value;
     }
+    merge_sort (entry);
 
     array<string> new_entry;
-    for (i=0; i<n; i++) {
-      if ((i>0) && (entry[i] == entry[i-1])) continue;
+    for (i=0; i<N(entry); i++)
       insert_recursively (new_entry, entry[i], h);
-    }
     entry= new_entry;
     n= N(entry);
 
@@ -467,33 +477,33 @@ edit_process_rep::generate_glossary (string gly) {
   if (N(G)>0) {
     int i, n= N(G);
     tree D (DOCUMENT);
+    hashmap<tree,array<int> > pos (array<int> (0));
     for (i=0; i<n; i++)
       if (is_func (G[i], TUPLE, 1)) D << G[i][0];
       else if (is_func (G[i], TUPLE, 3) && (G[i][0] == "normal")) {
         tree content= G[i][1];
         if (is_document (content) && N(content) == 1) content= content[0];;
         tree L= compound ("glossary-1", content, G[i][2]);
+        pos (content) << N(D);
         D << L;
       }
       else if (is_func (G[i], TUPLE, 4) && (G[i][0] == "normal")) {
         tree content= G[i][1];
         if (is_document (content) && N(content) == 1) content= content[0];;
         tree L= compound ("glossary-2", content, G[i][2], G[i][3]);
+        pos (content) << N(D);
         D << L;
       }
       else if (is_func (G[i], TUPLE, 3) && (G[i][0] == "dup")) {
-        int j;
-        for (j=0; j<N(D); j++)
-          if ((is_compound (D[j], "glossary-1") ||
-               is_compound (D[j], "glossary-2")) &&
-              (D[j][0] == G[i][1]))
-            {
-              tree C= D[j][N(D[j])-1];
-              if (!is_concat (C)) C= tree (CONCAT, C);
-              C << ", ";
-              C << G[i][2];
-              D[j][N(D[j])-1]= C;
-            }
+        array<int> a= pos[G[i][1]];
+        for (int k=0; k<N(a); k++) {
+          int j= a[k];
+          tree C= D[j][N(D[j])-1];
+          if (!is_concat (C)) C= tree (CONCAT, C);
+          C << ", ";
+          C << G[i][2];
+          D[j][N(D[j])-1]= C;
+        }
       }
     insert_tree (remove_labels (D));
   }
@@ -69,6 +69,7 @@ public:
   void replace_start (tree what, tree by, bool forward= true);
   void replace_next ();
   bool replace_keypress (string s);
+  int  replace_all (range_set sels, tree by);
 
   /* spell */
   path test_spellable (path p);
@@ -569,3 +569,42 @@ edit_replace_rep::replace_keypress (string s) {
   }
   return true;
 }
+
+int
+edit_replace_rep::replace_all (range_set sels, tree by) {
+  // replace the sorted and disjoint ranges in sels by by and return
+  // the number of replacements; the ranges are handled backwards, so that
+  // the paths of the remaining ones stay valid, and all ranges inside
+  // a same string are replaced through a single assignment of the string
+  int nr= 0, i= N(sels) - 2;
+  while (i >= 0) {
+    path p1= sels[i], p2= sels[i+1];
+    path q = path_up (p1);
+    if (is_atomic (by) && path_up (p2) == q && is_atomic (subtree (et, q))) {
+      array<int> starts, ends;
+      while (i >= 0 && path_up (sels[i]) == q && path_up (sels[i+1]) == q) {
+        starts << last_item (sels[i]);
+        ends   << last_item (sels[i+1]);
+        i -= 2;
+      }
+      string s= subtree (et, q)->label, r;
+      int pos= 0;
+      for (int k= N(starts)-1; k>=0; k--)
+        if (starts[k] >= pos && ends[k] <= N(s)) {
+          r << s (pos, starts[k]) << by->label;
+          pos= ends[k];
+          nr++;
+        }
+      r << s (pos, N(s));
+      if (r != s) assign (q, r);
+    }
+    else {
+      go_to (copy (p2));
+      cut (p1, p2);
+      insert_tree (copy (by));
+      nr++;
+      i -= 2;
+    }
+  }
+  return nr;
+}
@@ -174,9 +174,11 @@ public:
   virtual bool kbd_get_command (string cmd_s, string& help, command& cmd) = 0;
   virtual void key_press (string key) = 0;
   virtual void emulate_keyboard (string keys, string action= "") = 0;
+  virtual void replay_keys (url trace) = 0;
   virtual bool complete_try () = 0;
   virtual void complete_start (string prefix, array<string> compls) = 0;
   virtual bool complete_keypress (string key) = 0;
+  virtual void complete_notify (modification mod) = 0;
   virtual string session_complete_command (tree t) = 0;
   virtual void custom_complete (tree t) = 0;
   virtual void mouse_any (string s, SI x, SI y, int mods, time_t t) = 0;
@@ -310,6 +312,8 @@ public:
   virtual void     typeset_forced () = 0;
   virtual void     typeset_invalidate (path p) = 0;
   virtual void     typeset_invalidate_all () = 0;
+  virtual void     typeset_release () = 0;
+  virtual bool     typeset_released () = 0;
   virtual void     typeset_invalidate_players (path p, bool reattach) = 0;
 
   /* public routines from edit_modify */
@@ -543,6 +547,7 @@ public:
   virtual bool search_keypress (string s) = 0;
   virtual void replace_start (tree what, tree by, bool forward= true) = 0;
   virtual bool replace_keypress (string s) = 0;
+  virtual int  replace_all (range_set sels, tree by) = 0;
   virtual void spell_start () = 0;
   virtual void spell_replace (string by) = 0;
   virtual bool spell_keypress (string s) = 0;
@@ -565,6 +570,9 @@ public:
   virtual void print_buffer (string first="1", string last="1000000") = 0;
   virtual void export_ps (url ps_name,
 			  string first="1", string last="1000000") = 0;
+  virtual int  typeset_pages () = 0;
+  virtual void export_raster (url name, int dpi,
+			      string first="1", string last="1000000") = 0;
   virtual array<int> print_snippet (url u, tree t, bool conserve_preamble) = 0;
   virtual bool graphics_file_to_clipboard (url output) = 0;
   virtual void footer_eval (string s) = 0;
@@ -623,5 +631,7 @@ extern int           kbd_hide_delay;
 
 bool get_show_kbd ();
 void set_show_kbd (bool flag);
+void start_recording_keys ();
+bool stop_recording_keys (url trace);
 
 #endif // defined EDITOR_H
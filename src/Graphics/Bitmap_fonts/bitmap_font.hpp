@@ -29,6 +29,12 @@ struct metric_struct {
 
 typedef metric_struct metric[1];
 
+#define SPAN_COPY     0
+#define SPAN_JOIN     1
+#define SPAN_MEET     2
+#define SPAN_EXCLUDE  3
+#define SPAN_FLIP     4
+
 /******************************************************************************
 * The glyph structure
 ******************************************************************************/
@@ -51,6 +57,10 @@ struct glyph_rep: concrete_struct {
   void set_x (int i, int j, int with);
   int  get (int i, int j);
   void set (int i, int j, int with);
+  void copy_span (int i, int j, glyph_rep* src, int si, int sj, int n,
+                  int op= SPAN_COPY);
+  int  first_in_span (int i, int j, int n);
+  int  last_in_span (int i, int j, int n);
   void adjust_bot ();
   void adjust_top ();
 };
@@ -78,22 +78,176 @@ glyph_rep::set (int i, int j, int with) {
   set_x (i+xoff, yoff-j, with);
 }
 
+/******************************************************************************
+* Operations on spans of pixels inside rows
+******************************************************************************/
+
+// packed rows are processed by chunks of bits which fit into a word,
+// whatever the alignment of the spans with respect to the bytes
+
+#define SPAN_CHUNK 56
+typedef unsigned long long int span_word;
+
+static inline span_word
+read_bits (QN* r, int bit, int n) {
+  int b= bit >> 3, s= bit & 7, k= (s + n + 7) >> 3;
+  span_word w= 0;
+  for (int t=0; t<k; t++) w |= ((span_word) r[b+t]) << (t << 3);
+  return (w >> s) & ((((span_word) 1) << n) - 1);
+}
+
+static inline void
+write_bits (QN* r, int bit, int n, span_word v) {
+  int b= bit >> 3, s= bit & 7, k= (s + n + 7) >> 3;
+  span_word m= ((((span_word) 1) << n) - 1) << s, w= v << s;
+  for (int t=0; t<k; t++) {
+    int sh= t << 3;
+    r[b+t]= (QN) ((r[b+t] & ~(m >> sh)) | (w >> sh));
+  }
+}
+
+static inline span_word
+reverse_bits (span_word w, int n) {
+  w= ((w >>  1) & 0x5555555555555555ULL) | ((w & 0x5555555555555555ULL) <<  1);
+  w= ((w >>  2) & 0x3333333333333333ULL) | ((w & 0x3333333333333333ULL) <<  2);
+  w= ((w >>  4) & 0x0F0F0F0F0F0F0F0FULL) | ((w & 0x0F0F0F0F0F0F0F0FULL) <<  4);
+  w= ((w >>  8) & 0x00FF00FF00FF00FFULL) | ((w & 0x00FF00FF00FF00FFULL) <<  8);
+  w= ((w >> 16) & 0x0000FFFF0000FFFFULL) | ((w & 0x0000FFFF0000FFFFULL) << 16);
+  w= (w >> 32) | (w << 32);
+  return w >> (64 - n);
+}
+
+static inline span_word
+combine_bits (span_word d, span_word s, int op) {
+  switch (op) {
+  case SPAN_JOIN: return d | s;
+  case SPAN_MEET: return d & s;
+  case SPAN_EXCLUDE: return d & ~s;
+  default: return s;
+  }
+}
+
+static inline int
+combine_pixel (int d, int s, int op) {
+  switch (op) {
+  case SPAN_JOIN: return max (d, s);
+  case SPAN_MEET: return min (d, s);
+  case SPAN_EXCLUDE: return (s != 0? 0: d);
+  default: return s;
+  }
+}
+
+void
+glyph_rep::copy_span (int i, int j, glyph_rep* src, int si, int sj, int n,
+                      int op) {
+  // combine the pixels (i..i+n-1, j) with the pixels (si..si+n-1, sj)
+  // of src, taken in reverse order for SPAN_FLIP; the spans should lie
+  // inside the glyphs and should not overlap
+  if (n <= 0) return;
+  if (depth == 1 && src->depth == 1) {
+    int bit= j*width + i, sbit= sj*src->width + si;
+    for (int k=0; k<n; k+=SPAN_CHUNK) {
+      int m= min (SPAN_CHUNK, n-k);
+      span_word w;
+      if (op == SPAN_FLIP)
+        w= reverse_bits (read_bits (src->raster, sbit+n-k-m, m), m);
+      else {
+        w= read_bits (src->raster, sbit+k, m);
+        if (op != SPAN_COPY)
+          w= combine_bits (read_bits (raster, bit+k, m), w, op);
+      }
+      write_bits (raster, bit+k, m, w);
+    }
+  }
+  else if (depth > 1 && src->depth > 1) {
+    QN* d= raster + j*width + i;
+    QN* s= src->raster + sj*src->width + si;
+    int k;
+    switch (op) {
+    case SPAN_JOIN:
+      for (k=0; k<n; k++) d[k]= max (d[k], s[k]);
+      break;
+    case SPAN_MEET:
+      for (k=0; k<n; k++) d[k]= min (d[k], s[k]);
+      break;
+    case SPAN_EXCLUDE:
+      for (k=0; k<n; k++) if (s[k] != 0) d[k]= 0;
+      break;
+    case SPAN_FLIP:
+      for (k=0; k<n; k++) d[k]= s[n-1-k];
+      break;
+    default:
+      for (k=0; k<n; k++) d[k]= s[k];
+      break;
+    }
+  }
+  else
+    for (int k=0; k<n; k++) {
+      int c= src->get_x (op == SPAN_FLIP? si+n-1-k: si+k, sj);
+      set_x (i+k, j, combine_pixel (get_x (i+k, j), c, op));
+    }
+}
+
+int
+glyph_rep::first_in_span (int i, int j, int n) {
+  // first non zero pixel among (i..i+n-1, j), or i+n
+  if (depth == 1) {
+    int bit= j*width + i;
+    for (int k=0; k<n; k+=SPAN_CHUNK) {
+      int m= min (SPAN_CHUNK, n-k);
+      span_word w= read_bits (raster, bit+k, m);
+      if (w != 0) {
+        int t= 0;
+        while (((w >> t) & 1) == 0) t++;
+        return i+k+t;
+      }
+    }
+  }
+  else {
+    QN* r= raster + j*width + i;
+    for (int k=0; k<n; k++)
+      if (r[k] != 0) return i+k;
+  }
+  return i+n;
+}
+
+int
+glyph_rep::last_in_span (int i, int j, int n) {
+  // last non zero pixel among (i..i+n-1, j), or i-1
+  if (depth == 1) {
+    int bit= j*width + i;
+    for (int k=n; k>0; k-=SPAN_CHUNK) {
+      int m= min (SPAN_CHUNK, k);
+      span_word w= read_bits (raster, bit+k-m, m);
+      if (w != 0) {
+        int t= m-1;
+        while (((w >> t) & 1) == 0) t--;
+        return i+k-m+t;
+      }
+    }
+  }
+  else {
+    QN* r= raster + j*width + i;
+    for (int k=n-1; k>=0; k--)
+      if (r[k] != 0) return i+k;
+  }
+  return i-1;
+}
+
 /******************************************************************************
 * Adjusting top and bottom lines for extensible characters
 ******************************************************************************/
 
 void
 glyph_rep::adjust_bot () {
-  int i;
   if (height<=2) return;
-  for (i=0; i<width; i++) set_x (i, height-1, get_x (i, height-2));
+  copy_span (0, height-1, this, 0, height-2, width);
 }
 
 void
 glyph_rep::adjust_top () {
-  int i;
   if (height<=2) return;
-  for (i=0; i<width; i++) set_x (i, 0, get_x (i, 1));
+  copy_span (0, 0, this, 0, 1, width);
 }
 
 /******************************************************************************
@@ -11,6 +11,7 @@
 
 #include "bitmap_font.hpp"
 #include "renderer.hpp"
+#include <string.h>
 
 /******************************************************************************
 * Information about glyphs
@@ -35,20 +36,14 @@ empty_column (glyph gl, int i) {
 
 bool
 empty_row (glyph gl, int j) {
-  int ww= gl->width;
-  for (int i=0; i<ww; i++)
-    if (gl->get_x (i, j) != 0)
-      return false;
-  return true;
+  return first_in_row (gl, j) == gl->width;
 }
 
 int
 first_in_row (glyph gl, int j) {
   int ww= gl->width;
-  for (int i=0; i<ww; i++)
-    if (gl->get_x (i, j) != 0)
-      return i;
-  return ww;
+  if (j < 0 || j >= gl->height) return ww;
+  return gl->first_in_span (0, j, ww);
 }
 
 int
@@ -61,11 +56,8 @@ first_in_rows (glyph gl, int j1, int j2) {
 
 int
 last_in_row (glyph gl, int j) {
-  int ww= gl->width;
-  for (int i=ww-1; i>=0; i--)
-    if (gl->get_x (i, j) != 0)
-      return i;
-  return -1;
+  if (j < 0 || j >= gl->height) return -1;
+  return gl->last_in_span (0, j, gl->width);
 }
 
 int
@@ -149,17 +141,14 @@ join (glyph gl1, glyph gl2) {
   int y2= max (gl1->yoff, gl2->yoff);
   glyph bmr (x2-x1, y2-y1, -x1, y2, max (gl1->depth, gl2->depth));
 
-  int i, j, dx, dy;
+  int j, dx, dy;
   dx= -gl1->xoff- x1, dy= y2- gl1->yoff;
   for (j=0; j<gl1->height; j++)
-    for (i=0; i<gl1->width; i++)
-      bmr->set_x (i+dx, j+dy, gl1->get_x (i, j));
+    bmr->copy_span (dx, j+dy, gl1.rep, 0, j, gl1->width);
 
   dx= -gl2->xoff- x1; dy= y2- gl2->yoff;
   for (j=0; j<gl2->height; j++)
-    for (i=0; i<gl2->width; i++)
-      bmr->set_x (i+dx, j+dy,
-		  max (bmr->get_x (i+dx, j+dy), gl2->get_x (i, j)));
+    bmr->copy_span (dx, j+dy, gl2.rep, 0, j, gl2->width, SPAN_JOIN);
 
   int lo= min (-gl1->xoff, -gl2->xoff);
   int hi= max (gl1->lwidth - gl1->xoff, gl2->lwidth - gl2->xoff);
@@ -169,37 +158,28 @@ join (glyph gl1, glyph gl2) {
 
 glyph
 intersect (glyph gl1, glyph gl2) {
-  int i, j;
+  int j;
   int ww= gl1->width, hh= gl1->height, ww2= gl2->width, hh2= gl2->height;
+  int di= gl2->xoff - gl1->xoff, dj= gl2->yoff - gl1->yoff;
+  int i1= max (0, -di), i2= min (ww, ww2 - di);
   glyph bmr (ww, hh, gl1->xoff, gl1->yoff, gl1->depth);
-  for (j=0; j<hh; j++)
-    for (i=0; i<ww; i++) {
-      int c = gl1->get_x (i, j);
-      int i2= i - gl1->xoff + gl2->xoff;
-      int j2= j - gl1->yoff + gl2->yoff;
-      if (i2 >= 0 && ww2 > i2 && j2 >= 0 && hh2 > j2)
-        c= min (c, gl2->get_x (i2, j2));
-      else c= 0;
-      bmr->set_x (i, j, c);
-    }
+  for (j= max (0, -dj); j < min (hh, hh2 - dj); j++) {
+    bmr->copy_span (i1, j, gl1.rep, i1, j, i2 - i1);
+    bmr->copy_span (i1, j, gl2.rep, i1 + di, j + dj, i2 - i1, SPAN_MEET);
+  }
   bmr->lwidth= gl1->lwidth;
   return simplify (bmr);
 }
 
 glyph
 exclude (glyph gl1, glyph gl2) {
-  int i, j;
+  int j;
   int ww= gl1->width, hh= gl1->height, ww2= gl2->width, hh2= gl2->height;
-  glyph bmr (ww, hh, gl1->xoff, gl1->yoff, gl1->depth);
-  for (j=0; j<hh; j++)
-    for (i=0; i<ww; i++) {
-      int c = gl1->get_x (i, j);
-      int i2= i - gl1->xoff + gl2->xoff;
-      int j2= j - gl1->yoff + gl2->yoff;
-      if (i2 >= 0 && ww2 > i2 && j2 >= 0 && hh2 > j2)
-        if (gl2->get_x (i2, j2) != 0) c= 0;
-      bmr->set_x (i, j, c);
-    }
+  int di= gl2->xoff - gl1->xoff, dj= gl2->yoff - gl1->yoff;
+  int i1= max (0, -di), i2= min (ww, ww2 - di);
+  glyph bmr= copy (gl1);
+  for (j= max (0, -dj); j < min (hh, hh2 - dj); j++)
+    bmr->copy_span (i1, j, gl2.rep, i1 + di, j + dj, i2 - i1, SPAN_EXCLUDE);
   bmr->lwidth= gl1->lwidth;
   return simplify (bmr);
 }
@@ -246,46 +226,48 @@ bar_bottom (glyph gl1, glyph gl2) {
 * Operating on glyphs
 ******************************************************************************/
 
+static void
+copy_raster (glyph bmr, glyph gl) {
+  // both glyphs should have the same size and depth
+  int n= gl->width * gl->height;
+  if (gl->depth == 1) n= (n + 7) >> 3;
+  if (n > 0) memcpy (bmr->raster, gl->raster, n);
+}
+
 glyph
 copy (glyph gl) {
-  int i, j;
   int ww= gl->width, hh= gl->height;
   glyph bmr (ww, hh, gl->xoff, gl->yoff, gl->depth);
-  for (j=0; j<hh; j++)
-    for (i=0; i<ww; i++)
-      bmr->set_x (i, j, gl->get_x (i, j));
+  copy_raster (bmr, gl);
   return bmr;
 }
 
 glyph
 simplify (glyph gl) {
-  int i, j;
+  int j;
   int ww= gl->width, hh= gl->height;
-  int i1= 0, i2= ww-1, j1= 0, j2= hh-1;
-  while (i1 < ww && empty_column (gl, i1)) i1++;
-  while (i2 >= 0 && empty_column (gl, i2)) i2--;
+  int i1= ww, i2= -1, j1= 0, j2= hh-1;
   while (j1 < hh && empty_row (gl, j1)) j1++;
   while (j2 >= 0 && empty_row (gl, j2)) j2--;
-  if (i1 == ww) { i1= j1= 0; i2= j2= -1; }
+  for (j=j1; j<=j2; j++) {
+    i1= min (i1, first_in_row (gl, j));
+    i2= max (i2, last_in_row (gl, j));
+  }
+  if (j1 == hh) { i1= j1= 0; i2= j2= -1; }
   glyph bmr (i2-i1+1, j2-j1+1, gl->xoff-i1, gl->yoff-j1, gl->depth);
   for (j=j1; j<=j2; j++)
-    for (i=i1; i<=i2; i++)
-      bmr->set_x (i-i1, j-j1, gl->get_x (i, j));
+    bmr->copy_span (0, j-j1, gl.rep, i1, j, i2-i1+1);
   bmr->lwidth= gl->lwidth;
   return bmr;
 }
 
 glyph
 padded (glyph gl, int l, int t, int r, int b) {
-  int i, j;
+  int j;
   int ww= gl->width, hh= gl->height;
   glyph bmr (ww+l+r, hh+t+b, gl->xoff+l, gl->yoff+t, gl->depth);
-  for (j=0; j<hh+t+b; j++)
-    for (i=0; i<ww+l+r; i++)
-      bmr->set_x (i, j, 0);
   for (j=0; j<hh; j++)
-    for (i=0; i<ww; i++)
-      bmr->set_x (i + l, j + t, gl->get_x (i, j));
+    bmr->copy_span (l, j + t, gl.rep, 0, j, ww);
   bmr->lwidth= gl->lwidth;
   return bmr;
 }
@@ -296,11 +278,7 @@ move (glyph gl, SI x, SI y) {
   int xx= x/PIXEL, yy= y/PIXEL;
   int ww= gl->width, hh= gl->height;
   glyph bmr (ww, hh, gl->xoff- xx, gl->yoff+ yy, gl->depth);
-
-  int i, j;
-  for (j=0; j<hh; j++)
-    for (i=0; i<ww; i++)
-      bmr->set_x (i, j, gl->get_x (i, j));
+  copy_raster (bmr, gl);
   bmr->lwidth= gl->lwidth;
   return bmr;
 }
@@ -311,39 +289,35 @@ clip (glyph gl, SI x1, SI y1, SI x2, SI y2) {
   abs_round (x2, y2);
   x1= x1/PIXEL; y1= y1/PIXEL;
   x2= x2/PIXEL; y2= y2/PIXEL;
-  int i, j;
+  int j;
   int ww= gl->width, hh= gl->height;
+  int i1= max (0, x1 + gl->xoff), i2= min (ww, x2 + gl->xoff);
+  int j1= max (0, gl->yoff - y2 + 1), j2= min (hh, gl->yoff - y1 + 1);
   glyph bmr (ww, hh, gl->xoff, gl->yoff, gl->depth);
-  for (j=0; j<hh; j++)
-    for (i=0; i<ww; i++) {
-      bool x_ok= (i-gl->xoff >= x1) && (i-gl->xoff < x2);
-      bool y_ok= (gl->yoff-j >= y1) && (gl->yoff-j < y2);
-      bmr->set_x (i, j, x_ok && y_ok? gl->get_x (i, j): 0);
-    }
+  for (j=j1; j<j2; j++)
+    bmr->copy_span (i1, j, gl.rep, i1, j, i2 - i1);
   bmr->lwidth= gl->lwidth;
   return simplify (bmr);
 }
 
 glyph
 hor_flip (glyph gl) {
-  int i, j;
+  int j;
   int ww= gl->width, hh= gl->height;
   glyph bmr (ww, hh, gl->xoff, gl->yoff, gl->depth);
   for (j=0; j<hh; j++)
-    for (i=0; i<ww; i++)
-      bmr->set_x (ww-1-i, j, gl->get_x (i, j));
+    bmr->copy_span (0, j, gl.rep, 0, j, ww, SPAN_FLIP);
   bmr->lwidth= gl->lwidth;
   return bmr;
 }
 
 glyph
 ver_flip (glyph gl) {
-  int i, j;
+  int j;
   int ww= gl->width, hh= gl->height;
   glyph bmr (ww, hh, gl->xoff, gl->yoff, gl->depth);
   for (j=0; j<hh; j++)
-    for (i=0; i<ww; i++)
-      bmr->set_x (i, hh-1-j, gl->get_x (i, j));
+    bmr->copy_span (0, hh-1-j, gl.rep, 0, j, ww);
   bmr->lwidth= gl->lwidth;
   return bmr;
 }
@@ -383,9 +357,15 @@ hor_extend (glyph gl, int pos, int by) {
     if (pos >= (ww>>2) && pos < (3*ww>>2)) break;
   }
   glyph bmr (ww+ by, hh, gl->xoff, gl->yoff, gl->depth);
-  for (j=0; j<hh; j++)
-    for (i=0; i<(ww+by); i++)
-      bmr->set_x (i, j, gl->get_x (i<pos? i: (i<pos+by? pos: i-by), j));
+  int l= max (min (pos, ww), 0), r= max (pos, 0);
+  for (j=0; j<hh; j++) {
+    bmr->copy_span (0, j, gl.rep, 0, j, l);
+    int c= gl->get_x (pos, j);
+    if (c != 0)
+      for (i=r; i<min (pos+by, ww+by); i++)
+        bmr->set_x (i, j, c);
+    bmr->copy_span (r+by, j, gl.rep, r, j, ww-r);
+  }
   return bmr;
 }
 
@@ -409,24 +389,25 @@ hor_take (glyph gl, int pos, int nr) {
 
 glyph
 ver_extend (glyph gl, int pos, int by) {
-  int i, j;
+  int j;
   int ww= gl->width, hh= gl->height;
   glyph bmr (ww, hh+by, gl->xoff, gl->yoff, gl->depth);
-  for (j=0; j<(hh+by); j++)
-    for (i=0; i<ww; i++)
-      bmr->set_x (i, j, gl->get_x (i, j<pos? j: (j<pos+by? pos: j-by)));
+  for (j=0; j<(hh+by); j++) {
+    int sj= (j<pos? j: (j<pos+by? pos: j-by));
+    if (sj >= 0 && sj < hh) bmr->copy_span (0, j, gl.rep, 0, sj, ww);
+  }
   bmr->lwidth= gl->lwidth;
   return bmr;
 }
 
 glyph
 ver_take (glyph gl, int pos, int nr) {
-  int i, j;
+  int j;
   int ww= gl->width;
   glyph bmr (ww, nr, gl->xoff, 0, gl->depth);
-  for (j=0; j<nr; j++)
-    for (i=0; i<ww; i++)
-      bmr->set_x (i, j, gl->get_x (i, pos));
+  if (pos >= 0 && pos < gl->height)
+    for (j=0; j<nr; j++)
+      bmr->copy_span (0, j, gl.rep, 0, pos, ww);
   bmr->lwidth= gl->lwidth;
   return simplify (bmr);
 }
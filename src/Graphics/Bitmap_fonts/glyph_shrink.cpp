@@ -11,6 +11,7 @@
 
 #include "bitmap_font.hpp"
 #include "renderer.hpp"
+#include <string.h>
 
 static int
 log2i (int i) {
@@ -179,17 +180,18 @@ shrink (glyph gl, int xfactor, int yfactor,
   int i, j, x, y;
   int index, indey, entry;
   int ww=(X2-X1)*xfactor, hh=(Y2-Y1)*yfactor;
-  int* bitmap= tm_new_array<int> (ww*hh);
-  //STACK_NEW_ARRAY (bitmap, int, ww*hh);
-  for (i=0; i<ww*hh; i++) bitmap[i]=0;
+  QN* bitmap= tm_new_array<QN> (ww*hh);
+  //STACK_NEW_ARRAY (bitmap, QN, ww*hh);
+  memset (bitmap, 0, ww*hh);
+  // each run of black pixels is thickened by tx and ty as a whole
+  int w= gl->width;
   for (y=0, index= ww*frac_y+ frac_x; y<gl->height; y++, index-=ww)
-    for (x=0; x<gl->width; x++)
-      if (gl->get_1(x,y))
-        for (j=0, indey=ww*ty; j<=ty; j++, indey-=ww) {
-	  entry = index+indey+x;
-	  for (i=0; i<=tx; i++, entry++)
-	    bitmap[entry]= 1;
-	}
+    for (x= gl->first_in_span (0, y, w); x<w;
+	 x= gl->first_in_span (entry, y, w-entry)) {
+      for (entry= x+1; entry<w && gl->get_1 (entry, y); entry++) {}
+      for (j=0, indey=ww*ty; j<=ty; j++, indey-=ww)
+	memset (bitmap+ index+ indey+ x, 1, entry- x+ tx);
+    }
 
   int X, Y, sum, nr= xfactor*yfactor;
   int new_depth= gl->depth+ log2i (nr);
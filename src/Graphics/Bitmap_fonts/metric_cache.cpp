@@ -0,0 +1,328 @@
+/******************************************************************************
+* MODULE     : metric_cache.cpp
+* DESCRIPTION: persistent caches for glyphs and their metrics
+* COPYRIGHT  : (C) 2020  Joris van der Hoeven
+*******************************************************************************
+* This software falls under the GNU general public license version 3 or later.
+* It comes WITHOUT ANY WARRANTY WHATSOEVER. For details, see the file LICENSE
+* in the root directory or <http://www.gnu.org/licenses/gpl-3.0.html>.
+******************************************************************************/
+
+#include "metric_cache.hpp"
+#include "file.hpp"
+#include "sys_utils.hpp"
+#include "merge_sort.hpp"
+#include "iterator.hpp"
+#include "tm_configure.hpp"
+#include <string.h>
+#include <unistd.h>
+
+/******************************************************************************
+* A cache file consists of the magic string "TMMC", the format number, the
+* modification date of the font file and the number of metrics, followed
+* by the metrics. Each metric is stored as its character code followed
+* by its eight coordinates. All numbers are 32 bit integers in the byte
+* order of the machine, since caches are not meant to be moved around.
+******************************************************************************/
+
+#define METRIC_MAGIC  "TMMC"
+#define METRIC_FORMAT 1
+#define METRIC_HEADER 16
+#define METRIC_RECORD 36
+
+static array<metric_cache> all_metric_caches;
+static array<glyph_cache> all_glyph_caches;
+
+static inline int
+read_int (const char* p) {
+  int r;
+  memcpy (&r, p, 4);
+  return r;
+}
+
+static inline void
+write_int (string& r, int i) {
+  r << string ((const char*) &i, 4);
+}
+
+static string
+cache_name (string name) {
+  string r;
+  for (int i=0; i<N(name); i++)
+    if (is_alpha (name[i]) || is_digit (name[i]) ||
+        name[i] == '@' || name[i] == '-') r << name[i];
+    else r << '_';
+  return r;
+}
+
+/******************************************************************************
+* Routines for metric caches
+******************************************************************************/
+
+metric_cache_rep::metric_cache_rep (string name2, url font_file):
+  name (name2),
+  file (get_texmacs_home_path () * url ("system/cache/metrics") *
+        url (cache_name (name2) * ".bin")),
+  stamp (last_modified (font_file)), loaded (false), nr (0), added (NULL) {}
+
+metric_cache::metric_cache (string name, url font_file):
+  rep (tm_new<metric_cache_rep> (name, font_file))
+{
+  all_metric_caches << *this;
+}
+
+void
+metric_cache_rep::load () {
+  loaded= true;
+  nr= 0;
+  if (load_mapped (file, data)) return;
+  int n= N(data);
+  const char* a= data.data ();
+  if (n < METRIC_HEADER || string (a, 4) != string (METRIC_MAGIC, 4) ||
+      read_int (a + 4) != METRIC_FORMAT || read_int (a + 8) != stamp) {
+    data= mapped_string ();
+    return;
+  }
+  int k= read_int (a + 12);
+  if (k < 0 || k > (n - METRIC_HEADER) / METRIC_RECORD) {
+    data= mapped_string ();
+    return;
+  }
+  nr= k;
+}
+
+bool
+metric_cache_rep::get (int c, metric_struct& m) {
+  if (!loaded) load ();
+  const char* a= data.data () + METRIC_HEADER;
+  int lo= 0, hi= nr;
+  while (lo < hi) {
+    int mid= (lo + hi) >> 1;
+    const char* p= a + mid * METRIC_RECORD;
+    int code= read_int (p);
+    if (code < c) lo= mid + 1;
+    else if (code > c) hi= mid;
+    else {
+      m.x1= read_int (p +  4); m.y1= read_int (p +  8);
+      m.x2= read_int (p + 12); m.y2= read_int (p + 16);
+      m.x3= read_int (p + 20); m.y3= read_int (p + 24);
+      m.x4= read_int (p + 28); m.y4= read_int (p + 32);
+      return true;
+    }
+  }
+  return false;
+}
+
+void
+metric_cache_rep::set (int c, metric_struct* m) {
+  // m should remain valid until the cache has been saved
+  added (c)= (pointer) m;
+}
+
+void
+metric_cache_rep::save () {
+  if (N(added) == 0) return;
+  if (!loaded) load ();
+  array<int> codes;
+  array<int> where;  // -1 for added metrics, record number otherwise
+  const char* a= data.data () + METRIC_HEADER;
+  for (int i=0; i<nr; i++) {
+    int code= read_int (a + i * METRIC_RECORD);
+    if (!added->contains (code)) { codes << code; where << i; }
+  }
+  iterator<int> it= iterate (added);
+  while (it->busy ()) { codes << it->next (); where << -1; }
+  merge_sort_leq<int,int,less_eq_operator<int> > (codes, where);
+
+  string r (METRIC_MAGIC, 4);
+  write_int (r, METRIC_FORMAT);
+  write_int (r, stamp);
+  write_int (r, N(codes));
+  for (int i=0; i<N(codes); i++) {
+    if (where[i] >= 0)
+      r << string (a + where[i] * METRIC_RECORD, METRIC_RECORD);
+    else {
+      metric_struct* m= (metric_struct*) added[codes[i]];
+      write_int (r, codes[i]);
+      write_int (r, m->x1); write_int (r, m->y1);
+      write_int (r, m->x2); write_int (r, m->y2);
+      write_int (r, m->x3); write_int (r, m->y3);
+      write_int (r, m->x4); write_int (r, m->y4);
+    }
+  }
+
+  // other processes may be reading the old file, so we replace it at once
+  mkdir (head (file));
+  url tmp= glue (file, "-" * as_string ((int) getpid ()));
+  if (!save_string (tmp, r)) move (tmp, file);
+  else remove (tmp);
+  added= hashmap<int,pointer> (NULL);
+  loaded= false;
+}
+
+/******************************************************************************
+* A glyph cache file consists of the magic string "TMGC", the format number,
+* the modification date of the defining file, the TeXmacs version and the
+* number of glyphs, followed by the glyphs. Each glyph is stored as the
+* length and the characters of its name, its metric, the nine fields of
+* the glyph structure and its raster.
+******************************************************************************/
+
+#define GLYPH_MAGIC  "TMGC"
+#define GLYPH_FORMAT 1
+#define GLYPH_FIELDS (8 + 9)
+
+static int
+raster_size (int w, int h, int depth) {
+  return depth == 1? (w * h + 7) / 8: w * h;
+}
+
+glyph_cache_rep::glyph_cache_rep (string name2, url def_file):
+  name (name2),
+  file (get_texmacs_home_path () * url ("system/cache/glyphs") *
+        url (cache_name (name2) * ".bin")),
+  stamp (last_modified (def_file)), loaded (false), where (-1),
+  added_metric (metric_struct ()), added_glyph (glyph ()) {}
+
+glyph_cache::glyph_cache (string name, url def_file):
+  rep (tm_new<glyph_cache_rep> (name, def_file))
+{
+  all_glyph_caches << *this;
+}
+
+void
+glyph_cache_rep::load () {
+  loaded= true;
+  where= hashmap<string,int> (-1);
+  if (load_mapped (file, data)) return;
+  int n= N(data), pos= 0;
+  const char* a= data.data ();
+  string version= TEXMACS_VERSION;
+  int vn= N(version), header= 16 + vn;
+  if (n < header + 4 || string (a, 4) != string (GLYPH_MAGIC, 4) ||
+      read_int (a + 4) != GLYPH_FORMAT || read_int (a + 8) != stamp ||
+      read_int (a + 12) != vn || string (a + 16, vn) != version) {
+    data= mapped_string ();
+    return;
+  }
+  int k= read_int (a + header);
+  pos= header + 4;
+  for (int i=0; i<k; i++) {
+    if (n - pos < 4) break;
+    int l= read_int (a + pos);
+    if (l < 0 || n - pos - 4 < l + 4 * GLYPH_FIELDS) break;
+    const char* p= a + pos + 4 + l + 4 * 8;
+    int w= read_int (p + 8), h= read_int (p + 12), depth= read_int (p + 4);
+    if (w < 0 || h < 0 || depth < 1) break;
+    int size= 4 + l + 4 * GLYPH_FIELDS + raster_size (w, h, depth);
+    if (n - pos < size) break;
+    where (string (a + pos + 4, l))= pos;
+    pos += size;
+  }
+}
+
+bool
+glyph_cache_rep::get (string c, metric_struct& m, glyph& gl) {
+  if (added_glyph->contains (c)) {
+    m = added_metric[c];
+    gl= added_glyph[c];
+    return true;
+  }
+  if (!loaded) load ();
+  if (!where->contains (c)) return false;
+  MEM_TAG_SCOPE (MEM_GLYPHS);
+  const char* p= data.data () + where[c] + 4 + N(c);
+  m.x1= read_int (p +  0); m.y1= read_int (p +  4);
+  m.x2= read_int (p +  8); m.y2= read_int (p + 12);
+  m.x3= read_int (p + 16); m.y3= read_int (p + 20);
+  m.x4= read_int (p + 24); m.y4= read_int (p + 28);
+  p += 4 * 8;
+  int w= read_int (p + 8), h= read_int (p + 12), depth= read_int (p + 4);
+  gl= glyph (w, h, read_int (p + 16), read_int (p + 20), depth);
+  gl->index   = (unsigned int) read_int (p);
+  gl->lwidth  = read_int (p + 24);
+  gl->status  = read_int (p + 28);
+  gl->artistic= read_int (p + 32);
+  int size= raster_size (w, h, depth);
+  if (size > 0) memcpy (gl->raster, p + 4 * 9, size);
+  return true;
+}
+
+void
+glyph_cache_rep::set (string c, metric_struct m, glyph gl) {
+  if (is_nil (gl)) return;
+  MEM_TAG_SCOPE (MEM_GLYPHS);
+  added_metric (c)= m;
+  added_glyph (c)= gl;
+}
+
+void
+glyph_cache_rep::save () {
+  if (N(added_glyph) == 0) return;
+  if (!loaded) load ();
+  string version= TEXMACS_VERSION;
+  string r (GLYPH_MAGIC, 4);
+  write_int (r, GLYPH_FORMAT);
+  write_int (r, stamp);
+  write_int (r, N(version));
+  r << version;
+  string body;
+  int count= 0;
+  const char* a= data.data ();
+  iterator<string> it= iterate (where);
+  while (it->busy ()) {
+    string c= it->next ();
+    if (added_glyph->contains (c)) continue;
+    const char* p= a + where[c] + 4 + N(c) + 4 * 8;
+    int w= read_int (p + 8), h= read_int (p + 12), depth= read_int (p + 4);
+    int size= 4 + N(c) + 4 * GLYPH_FIELDS + raster_size (w, h, depth);
+    body << string (a + where[c], size);
+    count++;
+  }
+  it= iterate (added_glyph);
+  while (it->busy ()) {
+    string c= it->next ();
+    metric_struct m= added_metric[c];
+    glyph gl= added_glyph[c];
+    write_int (body, N(c));
+    body << c;
+    write_int (body, m.x1); write_int (body, m.y1);
+    write_int (body, m.x2); write_int (body, m.y2);
+    write_int (body, m.x3); write_int (body, m.y3);
+    write_int (body, m.x4); write_int (body, m.y4);
+    write_int (body, (int) gl->index);
+    write_int (body, gl->depth);
+    write_int (body, gl->width);
+    write_int (body, gl->height);
+    write_int (body, gl->xoff);
+    write_int (body, gl->yoff);
+    write_int (body, gl->lwidth);
+    write_int (body, gl->status);
+    write_int (body, gl->artistic);
+    body << string ((const char*) gl->raster,
+                    raster_size (gl->width, gl->height, gl->depth));
+    count++;
+  }
+  write_int (r, count);
+  r << body;
+
+  mkdir (head (file));
+  url tmp= glue (file, "-" * as_string ((int) getpid ()));
+  if (!save_string (tmp, r)) move (tmp, file);
+  else remove (tmp);
+  added_metric= hashmap<string,metric_struct> (metric_struct ());
+  added_glyph = hashmap<string,glyph> (glyph ());
+  loaded= false;
+}
+
+/******************************************************************************
+* Saving all caches
+******************************************************************************/
+
+void
+save_metric_caches () {
+  for (int i=0; i<N(all_metric_caches); i++)
+    all_metric_caches[i]->save ();
+  for (int i=0; i<N(all_glyph_caches); i++)
+    all_glyph_caches[i]->save ();
+}
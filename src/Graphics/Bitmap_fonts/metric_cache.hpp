@@ -0,0 +1,93 @@
+/******************************************************************************
+* MODULE     : metric_cache.hpp
+* DESCRIPTION: persistent caches for glyphs and their metrics
+* COPYRIGHT  : (C) 2020  Joris van der Hoeven
+*******************************************************************************
+* This software falls under the GNU general public license version 3 or later.
+* It comes WITHOUT ANY WARRANTY WHATSOEVER. For details, see the file LICENSE
+* in the root directory or <http://www.gnu.org/licenses/gpl-3.0.html>.
+******************************************************************************/
+
+#ifndef METRIC_CACHE_H
+#define METRIC_CACHE_H
+#include "bitmap_font.hpp"
+#include "mapped_string.hpp"
+#include "hashmap.hpp"
+
+/******************************************************************************
+* A metric_cache stores the metrics of the glyphs of one font at one size
+* and resolution in the file system/cache/metrics/<name>.bin of the TeXmacs
+* home directory, so that they can be reused by later sessions and by other
+* processes. The file is mapped into memory when a first metric is
+* requested and contains the metrics sorted by character code, so that
+* lookups are binary searches in the mapped file. The cache is invalidated
+* when the modification date of the font file changes.
+******************************************************************************/
+
+class metric_cache;
+class metric_cache_rep: concrete_struct {
+  string        name;     // name of the font, size and resolution
+  url           file;     // the cache file
+  int           stamp;    // modification date of the font file
+  bool          loaded;   // has the cache file been mapped?
+  mapped_string data;     // the metrics stored in the cache file
+  int           nr;       // number of metrics in data
+  hashmap<int,pointer> added;  // metrics found during this session
+
+  void load ();
+
+public:
+  metric_cache_rep (string name, url font_file);
+  bool get (int c, metric_struct& m);
+  void set (int c, metric_struct* m);
+  void save ();
+
+  friend class metric_cache;
+};
+
+class metric_cache {
+  CONCRETE_NULL(metric_cache);
+  metric_cache (string name, url font_file);
+};
+CONCRETE_NULL_CODE(metric_cache);
+
+/******************************************************************************
+* A glyph_cache stores the glyphs and metrics of characters which are costly
+* to compute, such as the characters of virtual fonts, in the file
+* system/cache/glyphs/<name>.bin. Characters are identified by strings.
+* The cache is invalidated when the defining file changes or when another
+* version of TeXmacs is used, since glyphs depend on the algorithms which
+* compute them. The caches are saved by save_metric_caches.
+******************************************************************************/
+
+class glyph_cache;
+class glyph_cache_rep: concrete_struct {
+  string        name;     // name of the font, size and resolution
+  url           file;     // the cache file
+  int           stamp;    // modification date of the defining file
+  bool          loaded;   // has the cache file been mapped?
+  mapped_string data;     // the glyphs stored in the cache file
+  hashmap<string,int> where;  // positions of the records in data
+  hashmap<string,metric_struct> added_metric;  // found during this session
+  hashmap<string,glyph> added_glyph;
+
+  void load ();
+
+public:
+  glyph_cache_rep (string name, url def_file);
+  bool get (string c, metric_struct& m, glyph& gl);
+  void set (string c, metric_struct m, glyph gl);
+  void save ();
+
+  friend class glyph_cache;
+};
+
+class glyph_cache {
+  CONCRETE_NULL(glyph_cache);
+  glyph_cache (string name, url def_file);
+};
+CONCRETE_NULL_CODE(glyph_cache);
+
+void save_metric_caches ();
+
+#endif // defined METRIC_CACHE_H
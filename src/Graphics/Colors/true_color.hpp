@@ -93,7 +93,6 @@ operator -= (true_color& c1, const true_color& c2) {
 
 inline true_color&
 operator *= (true_color& c1, const true_color& c2) {
-  cout << c1 << ", " << c2 << "\n";
   c1.r *= c2.r; c1.g *= c2.g; c1.b *= c2.b; c1.a *= c2.a;
   return c1;
 }
@@ -253,6 +252,24 @@ true_color mix (const true_color& c1, double a1,
 		const true_color& c3, double a3,
 		const true_color& c4, double a4);
 
+/******************************************************************************
+* Kernels on rows of pixels
+******************************************************************************/
+
+// These kernels compute the same results as the above operators on each
+// pixel, but use vector instructions when available
+
+void source_over_pixels (true_color* d, const true_color* s, int n);
+void mul_pixels (true_color* d, const true_color* s, int n);
+void mul_alpha_pixels (true_color* d, const true_color* s, int n);
+void apply_alpha_pixels (true_color* d, const true_color* s,
+                         const double* a, int n);
+void apply_alpha_pixels (true_color* d, const true_color& c,
+                         const double* a, int n);
+
+// Conversion into 8 bit premultiplied ARGB values, as used for the screen
+void premultiplied_pixels (unsigned int* d, const true_color* s, int n);
+
 /******************************************************************************
 * Color transformations
 ******************************************************************************/
@@ -12,6 +12,7 @@
 #ifndef CHARMAP_H
 #define CHARMAP_H
 #include "resource.hpp"
+#include "flat_hashmap.hpp"
 
 RESOURCE(charmap);
 
@@ -20,9 +21,9 @@ RESOURCE(charmap);
 ******************************************************************************/
 
 struct charmap_rep: rep<charmap> {
-  int                    fast_map[256];
-  hashmap<string,int>    slow_map;
-  hashmap<string,string> slow_subst;
+  int                         fast_map[256];
+  flat_hashmap<string,int>    slow_map;
+  flat_hashmap<string,string> slow_subst;
 
 public:
   charmap_rep (string name);
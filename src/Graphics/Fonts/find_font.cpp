@@ -208,6 +208,7 @@ find_font_bis (tree t) {
 
 font
 find_font (tree t) {
+  MEM_TAG_SCOPE (MEM_FONTS);
   bench_start ("find font");
   font fn= find_font_bis (t);
   bench_cumul ("find font");
@@ -234,6 +235,7 @@ find_font (string family, string variant,
     series * "-" * shape * "-" *
     as_string (sz) * "-" * as_string (dpi);
   if (font::instances->contains (s)) return font (s);
+  MEM_TAG_SCOPE (MEM_FONTS);
 
   if (ends (shape, "-poorit")) {
     string shape2= shape (0, N(shape) - 7);
@@ -297,6 +297,18 @@ font_rep::get_extents (string s, metric& ex, SI xk) {
   STACK_DELETE_ARRAY (xpos);
 }
 
+void
+font_rep::get_extents (array<string> a, array<metric_struct>& exs) {
+  // the extents of a run of strings, such as the words of a paragraph
+  int i, n= N(a);
+  exs= array<metric_struct> (n);
+  for (i=0; i<n; i++) {
+    metric ex;
+    get_extents (a[i], ex);
+    exs[i]= ex[0];
+  }
+}
+
 void
 font_rep::get_xpositions (string s, SI* xpos) {
   int i= 0;
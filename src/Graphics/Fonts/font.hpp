@@ -90,6 +90,7 @@ struct font_rep: rep<font> {
   hashmap<string,double> above_correct;    // wide accent above adjustments
   hashmap<string,double> below_correct;    // wide accent above adjustments
   hashmap<int,int>       protrusion_maps;  // tables for protrusion
+  hashmap<int,array<SI> > protrusion_chars; // protrusion of 8-bit characters
   array<array<space> >   narrow_spacing;   // narrow spacing table
   array<array<space> >   normal_spacing;   // normal spacing table
   array<array<space> >   wide_spacing;     // wide spacing table
@@ -102,6 +103,7 @@ struct font_rep: rep<font> {
   virtual void   get_extents (string s, metric& ex) = 0;
   virtual void   get_extents (string s, metric& ex, bool ligf);
   virtual void   get_extents (string s, metric& ex, SI xk);
+  virtual void   get_extents (array<string> a, array<metric_struct>& exs);
   virtual void   get_xpositions (string s, SI* xpos);
   virtual void   get_xpositions (string s, SI* xpos, bool ligf);
   virtual void   get_xpositions (string s, SI* xpos, SI xk);
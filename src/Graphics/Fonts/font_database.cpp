@@ -18,10 +18,12 @@
 #include "Freetype/tt_tools.hpp"
 #include "Metafont/tex_files.hpp"
 #include "data_cache.hpp"
+#include "tm_timer.hpp"
 
 void font_database_filter_features ();
 void font_database_filter_characteristics ();
 static array<string> font_database_families (hashmap<tree,tree> ftab);
+static void font_database_build_styles ();
 
 #define GLOBAL_DATABASE "$TEXMACS_PATH/fonts/font-database.scm"
 #define GLOBAL_FEATURES "$TEXMACS_PATH/fonts/font-features.scm"
@@ -32,6 +34,7 @@ static array<string> font_database_families (hashmap<tree,tree> ftab);
 #define LOCAL_FEATURES "$TEXMACS_HOME_PATH/fonts/font-features.scm"
 #define LOCAL_CHARACTERISTICS \
   "$TEXMACS_HOME_PATH/fonts/font-characteristics.scm"
+#define LOCAL_INDEX "$TEXMACS_HOME_PATH/fonts/font-index.tmb"
 #define DELTA_DATABASE "$TEXMACS_HOME_PATH/fonts/delta-database.scm"
 #define DELTA_FEATURES "$TEXMACS_HOME_PATH/fonts/delta-features.scm"
 #define DELTA_CHARACTERISTICS \
@@ -83,6 +86,10 @@ hashmap<tree,tree> font_features (UNINIT);
 hashmap<tree,tree> font_variants (UNINIT);
 hashmap<tree,tree> font_characteristics (UNINIT);
 hashmap<string,tree> font_substitutions (UNINIT);
+static hashmap<string,tree> font_styles (UNINIT);
+static bool font_styles_valid= false;
+static hashmap<tree,bool> font_locations (false);
+static bool font_locations_valid= false;
 
 void set_new_fonts (bool new_val) { new_fonts= new_val; }
 bool get_new_fonts () { return new_fonts; }
@@ -97,6 +104,8 @@ tuple_insert (tree& t, tree x) {
 void
 font_database_load_database (url u, hashmap<tree,tree>& ftab= font_table) {
   if (!exists (u)) return;
+  font_styles_valid= false;
+  font_locations_valid= false;
   string s;
   if (!load_string (u, s, false)) {
     tree t= block_to_scheme_tree (s);
@@ -210,7 +219,8 @@ font_database_load_substitutions (url u) {
           is_atomic (t[i][1][0])) {
         string key= t[i][0][0]->label;
         string im = t[i][1][0]->label;
-        if (N(font_database_styles (im, font_table)) != 0) {
+        font_database_build_styles ();
+        if (font_styles->contains (im)) {
           if (!font_substitutions->contains (key))
             font_substitutions (key)= tree (TUPLE);
           font_substitutions (key) << t[i];
@@ -219,9 +229,101 @@ font_database_load_substitutions (url u) {
   }
 }
 
+/******************************************************************************
+* Binary index of the local database
+******************************************************************************/
+
+static tree
+font_database_stamps () {
+  // the index is only valid as long as the local database did not change
+  url us[3]= { LOCAL_DATABASE, LOCAL_FEATURES, LOCAL_CHARACTERISTICS };
+  tree t (TUPLE);
+  for (int i=0; i<3; i++) {
+    if (!exists (us[i])) return tree (TUPLE);
+    t << as_string (last_modified (us[i], false))
+      << as_string (file_size (us[i]));
+  }
+  return t;
+}
+
+static tree
+font_database_pack (hashmap<tree,tree> h) {
+  tree t (TUPLE, N(h));
+  int i= 0;
+  iterator<tree> it= iterate (h);
+  while (it->busy ()) {
+    tree key= it->next ();
+    t[i++]= tuple (key, h[key]);
+  }
+  return t;
+}
+
+static void
+font_database_unpack (tree t, hashmap<tree,tree>& h) {
+  for (int i=0; i<N(t); i++)
+    if (is_func (t[i], TUPLE, 2))
+      h (t[i][0])= t[i][1];
+}
+
+static bool
+font_database_load_index () {
+  // reading the binary index is much faster than parsing the local database
+  tree stamps= font_database_stamps ();
+  if (N(stamps) == 0 || !exists (LOCAL_INDEX)) return false;
+  string s;
+  if (load_string (LOCAL_INDEX, s, false)) return false;
+  tree t= binary_to_tree (s);
+  if (!is_func (t, TUPLE, 5) || t[0] != stamps || N(t[1]) == 0) return false;
+  font_database_unpack (t[1], font_table);
+  font_database_unpack (t[2], font_features);
+  font_database_unpack (t[3], font_variants);
+  font_database_unpack (t[4], font_characteristics);
+  font_styles_valid= false;
+  font_locations_valid= false;
+  return true;
+}
+
+static void
+font_database_save_index () {
+  tree stamps= font_database_stamps ();
+  if (N(stamps) == 0) return;
+  tree t= tuple (stamps,
+                 font_database_pack (font_table),
+                 font_database_pack (font_features),
+                 font_database_pack (font_variants),
+                 font_database_pack (font_characteristics));
+  save_string (LOCAL_INDEX, tree_to_binary (t));
+}
+
+static void
+font_database_build_styles () {
+  // index the styles of the families in the font table
+  if (font_styles_valid) return;
+  font_styles= hashmap<string,tree> (UNINIT);
+  iterator<tree> it= iterate (font_table);
+  while (it->busy ()) {
+    tree key= it->next ();
+    if (is_func (key, TUPLE, 2) && is_atomic (key[0])) {
+      if (!font_styles->contains (key[0]->label))
+        font_styles (key[0]->label)= tree (TUPLE);
+      font_styles (key[0]->label) << key[1];
+    }
+  }
+  font_styles_valid= true;
+}
+
+/******************************************************************************
+* Loading and saving the database
+******************************************************************************/
+
 void
 font_database_load () {
   if (fonts_loaded) return;
+  if (font_database_load_index ()) {
+    font_database_load_substitutions (GLOBAL_SUBSTITUTIONS);
+    fonts_loaded= true;
+    return;
+  }
   font_database_load_database (LOCAL_DATABASE);
   if (N (font_table) == 0) {
     font_database_load_database (GLOBAL_DATABASE);
@@ -240,6 +342,7 @@ font_database_load () {
     font_database_filter_characteristics ();
     font_database_save_characteristics (LOCAL_CHARACTERISTICS);
   }
+  font_database_save_index ();
   font_database_load_substitutions (GLOBAL_SUBSTITUTIONS);
   fonts_loaded= true;
 }
@@ -260,6 +363,7 @@ font_database_save () {
   font_database_save_database (LOCAL_DATABASE);
   font_database_save_features (LOCAL_FEATURES);
   font_database_save_characteristics (LOCAL_CHARACTERISTICS);
+  font_database_save_index ();
 }
 
 /******************************************************************************
@@ -278,12 +382,59 @@ on_blacklist (string name) {
     starts (name, "FonetikaDania");
 }
 
-void
-font_database_build (url u) {
+static bool
+font_database_knows (string name, int sz) {
+  // was the font file already processed by an earlier build?
+  if (!font_locations_valid) {
+    font_locations= hashmap<tree,bool> (false);
+    iterator<tree> it= iterate (font_table);
+    while (it->busy ()) {
+      tree im= font_table [it->next ()];
+      for (int i=0; i<N(im); i++)
+        if (is_func (im[i], TUPLE, 3))
+          font_locations (tuple (im[i][0], im[i][2]))= true;
+    }
+    font_locations_valid= true;
+  }
+  return font_locations [tuple (name, as_string (sz))];
+}
+
+/******************************************************************************
+* Analyzing the fonts
+******************************************************************************/
+
+// The jobs are run one after the other: the database is built from within
+// the running TeXmacs, which cannot safely be forked, and neither FreeType
+// faces nor the font resources and reference counts are thread safe.
+
+typedef tree (*font_job) (tree);
+
+static array<tree>
+font_database_run (array<tree> jobs, font_job job, string what) {
+  time_t start= texmacs_time ();
+  int i, n= N(jobs);
+  array<tree> r (n);
+  for (i=0; i<n; i++) r[i]= job (jobs[i]);
+  cout << "TeXmacs] " << what << " " << n << " fonts in "
+       << (int) (texmacs_time () - start) << " ms\n";
+  return r;
+}
+
+/******************************************************************************
+* Building the database
+******************************************************************************/
+
+static tree
+font_name_job (tree file) {
+  return tt_font_name (url_system (file->label));
+}
+
+static void
+font_database_collect_files (url u, array<tree>& files) {
   if (is_none (u));
   else if (is_or (u)) {
-    font_database_build (u[1]);
-    font_database_build (u[2]);
+    font_database_collect_files (u[1], files);
+    font_database_collect_files (u[2], files);
   }
   else if (is_directory (u)) {
     bool err;
@@ -293,25 +444,41 @@ font_database_build (url u) {
         if (ends (a[i], ".ttf") ||
             ends (a[i], ".ttc") ||
             ends (a[i], ".otf"))
-          font_database_build (u * url (a[i]));
+          font_database_collect_files (u * url (a[i]), files);
   }
   else if (is_regular (u)) {
     if (on_blacklist (as_string (tail (u)))) return;
+    // only files which are new or changed need to be opened
+    int sz= file_size (u);
+    if (font_database_knows (as_string (tail (u)), sz)) return;
     cout << "Process " << u << "\n";
-    scheme_tree t= tt_font_name (u);
+    files << tree (concretize (u));
+  }
+}
+
+void
+font_database_build (url u) {
+  array<tree> files;
+  font_database_collect_files (u, files);
+  array<tree> names= font_database_run (files, font_name_job, "Processed");
+  for (int k=0; k<N(files); k++) {
+    url f= url_system (files[k]->label);
+    scheme_tree t= names[k];
     for (int i=0; i<N(t); i++)
       if (is_func (t[i], TUPLE, 2) &&
           is_atomic (t[i][0]) &&
           is_atomic (t[i][1]))
         {
-          int  sz = file_size (u);
+          int  sz = file_size (f);
           tree key= t[i];
-          tree im = tuple (as_string (tail (u)), as_string (i), as_string (sz));
+          tree im = tuple (as_string (tail (f)), as_string (i), as_string (sz));
           tree all= tree (TUPLE);
           if (font_table->contains (key))
             all= font_table [key];
           tuple_insert (all, im);
           font_table (key)= all;
+          font_styles_valid= false;
+          font_locations (tuple (im[0], im[2]))= true;
         }
   }
 }
@@ -351,6 +518,8 @@ void
 font_database_build_global (url u) {
   fonts_loaded= fonts_global_loaded= false;
   font_table= hashmap<tree,tree> (UNINIT);
+  font_styles_valid= false;
+  font_locations_valid= false;
   font_database_load_database (GLOBAL_DATABASE);
   font_database_load_features (GLOBAL_FEATURES);
   font_database_load_characteristics (GLOBAL_CHARACTERISTICS);
@@ -417,6 +586,8 @@ font_database_save_local_delta () {
   font_features= hashmap<tree,tree> (UNINIT);
   font_variants= hashmap<tree,tree> (UNINIT);
   font_characteristics= hashmap<tree,tree> (UNINIT);
+  font_styles_valid= false;
+  font_locations_valid= false;
   fonts_loaded= fonts_global_loaded= false;
 }
 
@@ -531,6 +702,8 @@ font_database_filter () {
   font_database_collect (tt_font_path ());
   font_database_collect (tfm_font_path ());
   font_table= new_font_table;
+  font_styles_valid= false;
+  font_locations_valid= false;
   new_font_table = hashmap<tree,tree> (UNINIT);
   back_font_table= hashmap<tree,tree> (UNINIT);
 }
@@ -571,16 +744,26 @@ font_database_filter_characteristics () {
 * Additional font characteristics (automatically generated)
 ******************************************************************************/
 
+static tree
+font_analyze_job (tree name) {
+  array<string> a= tt_analyze (name->label);
+  tree t (TUPLE, N(a));
+  for (int j=0; j<N(a); j++) t[j]= a[j];
+  return t;
+}
+
 void
 font_database_build_characteristics (bool force) {
+  array<tree> keys, names;
   iterator<tree> it= iterate (font_table);
   while (it->busy ()) {
     tree key= it->next ();
     tree im = font_table[key];
     if (!(is_func (key, TUPLE) && N(key) >= 2)) continue;
     cout << "Analyzing " << key[0] << " " << key[1] << "\n";
-    for (int i=0; i<N(im); i++)
-      if (force || !font_characteristics->contains (key))
+    for (int i=0; i<N(im); i++) {
+      bool found= N(keys) > 0 && keys[N(keys)-1] == key;
+      if (force || (!font_characteristics->contains (key) && !found))
         if (is_func (im[i], TUPLE, 3)) {
           string name= as_string (im[i][0]);
           string nr  = as_string (im[i][1]);
@@ -594,14 +777,18 @@ font_database_build_characteristics (bool force) {
             if (!tt_font_exists (name) && ends (name, "10"))
               name= name (0, N(name)-2);
             if (tt_font_exists (name)) {
-              array<string> a= tt_analyze (name);
-              cout << name << " ~> " << a << "\n";
-              tree t (TUPLE, N(a));
-              for (int j=0; j<N(a); j++) t[j]= a[j];
-              font_characteristics (key)= t;
+              // as before, the last analyzed face of a key wins
+              if (found) names[N(names)-1]= name;
+              else { keys << key; names << tree (name); }
             }
           }
         }
+    }
+  }
+  array<tree> r= font_database_run (names, font_analyze_job, "Analyzed");
+  for (int k=0; k<N(keys); k++) {
+    cout << names[k] << " ~> " << r[k] << "\n";
+    font_characteristics (keys[k])= r[k];
   }
 }
 
@@ -655,7 +842,14 @@ font_database_styles (string family, hashmap<tree,tree> ftab) {
 array<string>
 font_database_styles (string family) {
   font_database_load ();
-  return font_database_styles (family, font_table);
+  font_database_build_styles ();
+  array<string> r;
+  if (font_styles->contains (family)) {
+    tree t= font_styles [family];
+    for (int i=0; i<N(t); i++) r << t[i]->label;
+  }
+  merge_sort_leq<string,locase_less_eq_operator> (r);
+  return r;
 }
 
 array<string>
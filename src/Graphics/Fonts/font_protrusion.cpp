@@ -256,6 +256,28 @@ init_protrusion_table (string font_name, int mode, bool right) {
   return protrusion_index_table [key];
 }
 
+static SI
+protrusion (font_rep* fn, hashmap<string,double> t, string c) {
+  if (!t->contains (c)) return 0;
+  metric ex;
+  fn->get_extents (c, ex);
+  return (SI) tm_round (t[c] * ex->x2);
+}
+
+static SI
+protrusion (font_rep* fn, hashmap<string,double> t, array<SI>& a, int c) {
+  // protrusions of 8-bit characters are computed once for each font
+  if (a[c] == MAX_SI) a[c]= protrusion (fn, t, string ((char) c));
+  return a[c];
+}
+
+static array<SI>
+protrusion_chars_table () {
+  array<SI> a (256);
+  for (int c=0; c<256; c++) a[c]= MAX_SI;
+  return a;
+}
+
 /******************************************************************************
 * User interface
 ******************************************************************************/
@@ -281,19 +303,16 @@ font_rep::get_left_protrusion (string s, int mode) {
   if (!protrusion_maps->contains (index)) {
     int code= init_protrusion_table (res_name, mode, false);
     protrusion_maps (index)= code;
+    protrusion_chars (index)= protrusion_chars_table ();
   }
-  hashmap<string,double> t= protrusion_tables [protrusion_maps [index]];
 
   int pos= 0;
   tm_char_forwards (s, pos);
-  string first= s (0, pos);
-  if (t->contains (first)) {
-    metric ex;
-    get_extents (first, ex);
-    double factor= t[first];
-    return (SI) tm_round (factor * ex->x2);
-  }
-  return 0;
+  hashmap<string,double> t= protrusion_tables [protrusion_maps [index]];
+  if (pos == 1)
+    return protrusion (this, t, protrusion_chars (index),
+                       (int) (unsigned char) s[0]);
+  return protrusion (this, t, s (0, pos));
 }
 
 SI
@@ -303,17 +322,14 @@ font_rep::get_right_protrusion (string s, int mode) {
   if (!protrusion_maps->contains (index)) {
     int code= init_protrusion_table (res_name, mode, true);
     protrusion_maps (index)= code;
+    protrusion_chars (index)= protrusion_chars_table ();
   }
-  hashmap<string,double> t= protrusion_tables [protrusion_maps [index]];
 
   int pos= N(s);
   tm_char_backwards (s, pos);
-  string last= s (pos, N(s));
-  if (t->contains (last)) {
-    metric ex;
-    get_extents (last, ex);
-    double factor= t[last];
-    return (SI) tm_round (factor * ex->x2);
-  }
-  return 0;
+  hashmap<string,double> t= protrusion_tables [protrusion_maps [index]];
+  if (pos == N(s) - 1)
+    return protrusion (this, t, protrusion_chars (index),
+                       (int) (unsigned char) s[pos]);
+  return protrusion (this, t, s (pos, N(s)));
 }
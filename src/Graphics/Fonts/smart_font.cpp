@@ -41,8 +41,25 @@ RESOURCE(smart_map);
 #define REWRITE_UPRIGHT         9
 #define REWRITE_IGNORE         10
 
+static inline int
+unicode_index (string s, int pos, int end) {
+  // the code of a character <#XXXX> in canonical form, or -1
+  int n= end - pos;
+  if (n < 4 || n > 7 || s[pos+1] != '#' || s[pos+2] == '0' || s[end-1] != '>')
+    return -1;
+  int code= 0;
+  for (int i=pos+2; i<end-1; i++) {
+    char c= s[i];
+    if (c >= '0' && c <= '9') code= (code << 4) + (c - '0');
+    else if (c >= 'A' && c <= 'F') code= (code << 4) + (c - 'A' + 10);
+    else return -1;
+  }
+  return code;
+}
+
 struct smart_map_rep: rep<smart_map> {
   int chv[256];
+  int* chu[256];  // unicode characters below 0x10000, by pages of 256
   hashmap<string,int> cht;
   hashmap<tree,int> fn_nr;
   array<tree> fn_spec;
@@ -54,6 +71,7 @@ public:
   {
     (void) fn;
     for (int i=0; i<256; i++) chv[i]= -1;
+    for (int i=0; i<256; i++) chu[i]= NULL;
     fn_nr (tuple ("main" ))= SUBFONT_MAIN;
     fn_nr (tuple ("error"))= SUBFONT_ERROR;
     fn_spec[SUBFONT_MAIN ]= tuple ("main");
@@ -62,6 +80,29 @@ public:
     fn_rewr[SUBFONT_ERROR]= REWRITE_NONE;
   }
 
+  ~smart_map_rep () {
+    for (int i=0; i<256; i++)
+      if (chu[i] != NULL) tm_delete_array (chu[i]);
+  }
+
+  inline int
+  get_unicode (int code) {
+    int* page= chu[code >> 8];
+    return page == NULL? -1: page[code & 255];
+  }
+
+  void
+  set_unicode (int code, int nr) {
+    int*& page= chu[code >> 8];
+    if (page == NULL) {
+      page= tm_new_array<int> (256);
+      for (int i=0; i<256; i++) page[i]= -1;
+    }
+    int& entry= page[code & 255];
+    if (entry == -1) entry= nr;
+    else entry= min (nr, entry);
+  }
+
   int
   add_font (tree fn, int rewr) {
     if (!fn_nr->contains (fn)) {
@@ -79,7 +120,9 @@ public:
     //cout << "Add " << c << " to " << fn << "\n";
     add_font (fn, REWRITE_NONE);
     int nr= fn_nr [fn];
-    if (starts (c, "<")) {
+    int code= (starts (c, "<")? unicode_index (c, 0, N(c)): -1);
+    if (code >= 0) set_unicode (code, nr);
+    else if (starts (c, "<")) {
       if (!cht->contains (c)) cht (c)= nr;
       else cht (c)= min (nr, cht [c]);
     }
@@ -669,6 +712,8 @@ struct smart_font_rep: font_rep {
 
   array<font> fn;
   smart_map   sm;
+  hashmap<string,metric_struct> word_ext;  // extents of recent words
+  hashmap<string,array<SI> > word_corr;    // corrections of recent words
 
   smart_font_rep (string name, font base_fn, font err_fn,
                   string family, string variant,
@@ -705,6 +750,8 @@ struct smart_font_rep: font_rep {
   SI     get_rsub_correction  (string s);
   SI     get_rsup_correction  (string s);
   SI     get_wide_correction  (string s, int mode);
+  SI     compute_correction   (string s, int kind);
+  SI     get_correction       (string s, int kind);
 };
 
 smart_font_rep::smart_font_rep (
@@ -715,7 +762,8 @@ smart_font_rep::smart_font_rep (
     series (series2), shape (shape2), rshape (shape2),
     sz (sz2), hdpi (hdpi2), dpi (vdpi2),
     math_kind (0), italic_nr (-1),
-    fn (2), sm (get_smart_map (tuple (family2, variant2, series2, shape2)))
+    fn (2), sm (get_smart_map (tuple (family2, variant2, series2, shape2))),
+    word_ext (metric_struct ()), word_corr (array<SI> ())
 {
   fn[SUBFONT_MAIN ]= adjust_subfont (base_fn);
   fn[SUBFONT_ERROR]= adjust_subfont (err_fn);
@@ -888,7 +936,8 @@ smart_font_rep::advance (string s, int& pos, string& r, int& nr) {
     else {
       int end= pos;
       tm_char_forwards (s, end);
-      int next= cht[s (pos, end)];
+      int code= unicode_index (s, pos, end);
+      int next= (code >= 0? sm->get_unicode (code): cht[s (pos, end)]);
       if (next == -1) next= resolve (s (pos, end));
       if (count == 1 && nr != -1 && next == nr) {
         if (N(fn) <= nr || is_nil (fn[nr])) initialize_font (nr);
@@ -1381,10 +1430,18 @@ smart_font_rep::supports (string c) {
   return true;
 }
 
+#define MAX_WORD_LENGTH 64
+#define MAX_WORD_EXTENTS 16384
+
 void
 smart_font_rep::get_extents (string s, metric& ex) {
   //cout << "Extents of " << s << " for " << res_name << "\n";
+  // words recur a lot in text, so we remember their extents
   int i=0, n= N(s);
+  if (n <= MAX_WORD_LENGTH && word_ext->contains (s)) {
+    ex[0]= word_ext[s];
+    return;
+  }
   if (n == 0) fn[0]->get_extents (empty_string, ex);
   else {
     int nr;
@@ -1417,6 +1474,11 @@ smart_font_rep::get_extents (string s, metric& ex) {
       }
     }
   }
+  if (n <= MAX_WORD_LENGTH) {
+    if (N(word_ext) >= MAX_WORD_EXTENTS)
+      word_ext= hashmap<string,metric_struct> (metric_struct ());
+    word_ext (s)= ex[0];
+  }
 }
 
 void
@@ -1579,65 +1641,76 @@ smart_font_rep::get_right_slope (string s) {
   return fn[nr]->get_right_slope (r);
 }
 
+/******************************************************************************
+* Italic corrections
+******************************************************************************/
+
+#define LEFT_CORRECTION  0
+#define RIGHT_CORRECTION 1
+#define LSUB_CORRECTION  2
+#define LSUP_CORRECTION  3
+#define RSUB_CORRECTION  4
+#define RSUP_CORRECTION  5
+
 SI
-smart_font_rep::get_left_correction  (string s) {
-  int i=0, n= N(s), nr;
-  if (n == 0) return fn[0]->get_left_correction (s);
+smart_font_rep::compute_correction (string s, int kind) {
+  int i=0, n= N(s), nr= 0;
   string r= s;
-  advance (s, i, r, nr);
-  nr= max (nr, 0);
-  return fn[nr]->get_left_correction (r);
+  if (n == 0);
+  else if (kind == LEFT_CORRECTION ||
+           kind == LSUB_CORRECTION || kind == LSUP_CORRECTION) {
+    advance (s, i, r, nr);
+    nr= max (nr, 0);
+  }
+  else {
+    while (i<n) advance (s, i, r, nr);
+    nr= max (nr, 0);
+  }
+  switch (kind) {
+  case LEFT_CORRECTION : return fn[nr]->get_left_correction (r);
+  case RIGHT_CORRECTION: return fn[nr]->get_right_correction (r);
+  case LSUB_CORRECTION : return fn[nr]->get_lsub_correction (r);
+  case LSUP_CORRECTION : return fn[nr]->get_lsup_correction (r);
+  case RSUB_CORRECTION : return fn[nr]->get_rsub_correction (r);
+  default              : return fn[nr]->get_rsup_correction (r);
+  }
 }
 
 SI
-smart_font_rep::get_right_correction (string s) {
-  int i=0, n= N(s), nr;
-  if (n == 0) return fn[0]->get_right_correction (s);
-  string r= s;
-  while (i<n) advance (s, i, r, nr);
-  nr= max (nr, 0);
-  return fn[nr]->get_right_correction (r);
+smart_font_rep::get_correction (string s, int kind) {
+  // the same scripts and operators recur a lot in formulas,
+  // so we remember the corrections of their symbols
+  if (N(s) > MAX_WORD_LENGTH) return compute_correction (s, kind);
+  if (!word_corr->contains (s)) {
+    if (N(word_corr) >= MAX_WORD_EXTENTS)
+      word_corr= hashmap<string,array<SI> > (array<SI> ());
+    array<SI> a (6);
+    for (int k=0; k<6; k++) a[k]= MAX_SI;
+    word_corr (s)= a;
+  }
+  array<SI> a= word_corr[s];
+  if (a[kind] == MAX_SI) a[kind]= compute_correction (s, kind);
+  return a[kind];
 }
 
+SI
+smart_font_rep::get_left_correction  (string s) {
+  return get_correction (s, LEFT_CORRECTION); }
+SI
+smart_font_rep::get_right_correction (string s) {
+  return get_correction (s, RIGHT_CORRECTION); }
 SI
 smart_font_rep::get_lsub_correction  (string s) {
-  int i=0, n= N(s), nr;
-  if (n == 0) return fn[0]->get_lsub_correction (s);
-  string r= s;
-  advance (s, i, r, nr);
-  nr= max (nr, 0);
-  return fn[nr]->get_lsub_correction (r);
-}
-
+  return get_correction (s, LSUB_CORRECTION); }
 SI
 smart_font_rep::get_lsup_correction  (string s) {
-  int i=0, n= N(s), nr;
-  if (n == 0) return fn[0]->get_lsup_correction (s);
-  string r= s;
-  advance (s, i, r, nr);
-  nr= max (nr, 0);
-  return fn[nr]->get_lsup_correction (r);
-}
-
+  return get_correction (s, LSUP_CORRECTION); }
 SI
 smart_font_rep::get_rsub_correction (string s) {
-  int i=0, n= N(s), nr;
-  if (n == 0) return fn[0]->get_rsub_correction (s);
-  string r= s;
-  while (i<n) advance (s, i, r, nr);
-  nr= max (nr, 0);
-  return fn[nr]->get_rsub_correction (r);
-}
-
+  return get_correction (s, RSUB_CORRECTION); }
 SI
 smart_font_rep::get_rsup_correction (string s) {
-  int i=0, n= N(s), nr;
-  if (n == 0) return fn[0]->get_rsup_correction (s);
-  string r= s;
-  while (i<n) advance (s, i, r, nr);
-  nr= max (nr, 0);
-  return fn[nr]->get_rsup_correction (r);
-}
+  return get_correction (s, RSUP_CORRECTION); }
 
 SI
 smart_font_rep::get_wide_correction (string s, int mode) {
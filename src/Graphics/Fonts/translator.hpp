@@ -13,6 +13,7 @@
 #define TRANSLATOR_H
 #include "resource.hpp"
 #include "tree.hpp"
+#include "flat_hashmap.hpp"
 
 RESOURCE(translator);
 
@@ -21,9 +22,9 @@ RESOURCE(translator);
 ******************************************************************************/
 
 struct translator_rep: rep<translator> {
-  int                  cur_c;
-  hashmap<string,int>  dict;
-  array<tree>          virt_def;
+  int                      cur_c;
+  flat_hashmap<string,int> dict;
+  array<tree>              virt_def;
 
   inline translator_rep (string s);
 };
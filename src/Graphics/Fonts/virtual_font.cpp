@@ -15,6 +15,7 @@
 #include "analyze.hpp"
 #include "frame.hpp"
 #include "iterator.hpp"
+#include "metric_cache.hpp"
 
 int get_utf8_code (string c);
 
@@ -39,6 +40,7 @@ struct virtual_font_rep: font_rep {
   hashmap<scheme_tree,glyph> trg;
   hashmap<string,bool> sup_bit;
   hashmap<string,bool> sup_svg;
+  glyph_cache  cache;
 
   virtual_font_rep (string name, font base, string vname, int size,
                     int hdpi, int vdpi, bool extend);
@@ -47,6 +49,7 @@ struct virtual_font_rep: font_rep {
   bool   supported (string c, bool svg);
   glyph  compile_bis (scheme_tree t, metric& ex);
   glyph  compile (scheme_tree t, metric& ex);
+  glyph  compile_char (string s, scheme_tree t, metric& ex);
   void   get_metric (scheme_tree t, metric& ex);
   tree   get_tree (string s);
   void   draw_tree (renderer ren, scheme_tree t, SI x, SI y);
@@ -1145,6 +1148,21 @@ virtual_font_rep::compile (scheme_tree t, metric& ex) {
   return r;
 }
 
+glyph
+virtual_font_rep::compile_char (string s, scheme_tree t, metric& ex) {
+  // the glyphs of characters are kept from one session to another
+  if (is_nil (cache)) {
+    url def ("$TEXMACS_HOME_PATH/fonts/virtual:$TEXMACS_PATH/fonts/virtual",
+             fn_name * ".vfn");
+    cache= glyph_cache (res_name, resolve (def));
+  }
+  glyph gl;
+  if (cache->get (s, ex[0], gl)) return gl;
+  gl= compile (t, ex);
+  cache->set (s, ex[0], gl);
+  return gl;
+}
+
 void
 virtual_font_rep::get_metric (scheme_tree t, metric& ex) {
   if (trm->contains (t)) ex[0]= trm[t];
@@ -1769,7 +1787,7 @@ virtual_font_rep::get_char (string s, font_metric& cfnm, font_glyphs& cfng) {
     cfnm= fnm;
     cfng= fng;
     if (is_nil (fng->get(c)))
-      fng->get(c)= compile (virt->virt_def[c], fnm->get(c));
+      fng->get(c)= compile_char (s, virt->virt_def[c], fnm->get(c));
     return c;
   }
   else if (s[0] == '<' && s[n-1] == '>') {
@@ -1788,7 +1806,7 @@ virtual_font_rep::get_char (string s, font_metric& cfnm, font_glyphs& cfng) {
     cfnm= fnm;
     cfng= fng;
     if (is_nil (fng->get(c2)))
-      fng->get(c2)= compile (virt->virt_def[c2], fnm->get(c2));
+      fng->get(c2)= compile_char (s, virt->virt_def[c2], fnm->get(c2));
     return c2;
   }
   else {
@@ -1798,7 +1816,7 @@ virtual_font_rep::get_char (string s, font_metric& cfnm, font_glyphs& cfng) {
     make_char_font (res_name * sub, cfnm, cfng);
     tree t= subst_sharp (virt->virt_def[c], s(1,n));
     if (is_nil (cfng->get(0)))
-      cfng->get(0)= compile (t, cfnm->get(0));
+      cfng->get(0)= compile_char (s, t, cfnm->get(0));
     return 0;
   }
 }
@@ -10,6 +10,7 @@
 ******************************************************************************/
 
 #include "poly_line.hpp"
+#include "hashmap.hpp"
 
 extern array<contours>       learned_glyphs;
 extern array<string>         learned_names;
@@ -17,6 +18,10 @@ extern array<array<tree> >   learned_disc1;
 extern array<array<double> > learned_cont1;
 extern array<array<tree> >   learned_disc2;
 extern array<array<double> > learned_cont2;
+extern hashmap<tree,array<int> > learned_index1;
+extern hashmap<tree,array<int> > learned_index2;
+
+tree learned_key (contours gl, array<tree> disc);
 
 void register_glyph (string name, contours gl);
 string recognize_glyph (contours gl);
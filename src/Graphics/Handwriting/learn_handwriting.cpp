@@ -21,6 +21,22 @@ array<array<tree> >   learned_disc1;
 array<array<double> > learned_cont1;
 array<array<tree> >   learned_disc2;
 array<array<double> > learned_cont2;
+hashmap<tree,array<int> > learned_index1;  // learned glyphs by invariants
+hashmap<tree,array<int> > learned_index2;
+
+tree
+learned_key (contours gl, array<tree> disc) {
+  // only glyphs with the same discrete invariants need to be compared
+  tree key (TUPLE, as_string (N(gl)));
+  for (int i=0; i<N(disc); i++) key << disc[i];
+  return key;
+}
+
+static void
+learned_index (hashmap<tree,array<int> >& h, tree key, int i) {
+  if (!h->contains (key)) h (key)= array<int> ();
+  h (key) << i;
+}
 
 void
 register_glyph (string name, contours gl) {
@@ -36,5 +52,7 @@ register_glyph (string name, contours gl) {
   learned_cont1  << cont1;
   learned_disc2  << disc2;
   learned_cont2  << cont2;
+  learned_index (learned_index1, learned_key (gl, disc1), N(learned_names)-1);
+  learned_index (learned_index2, learned_key (gl, disc2), N(learned_names)-1);
   //cout << "Added " << name << ", " << disc1 << "\n";
 }
@@ -15,6 +15,30 @@
 * Recognize one glyph
 ******************************************************************************/
 
+static void
+recognize_among (array<int> ids, array<array<double> > learned_cont,
+                 array<double> cont1, string& best, double& best_rec) {
+  // the distance to a learned glyph is abandoned as soon as
+  // it exceeds the distance to the best glyph found so far
+  int n= N(cont1);
+  for (int k=0; k<N(ids); k++) {
+    int i= ids[k];
+    array<double>& cont= learned_cont[i];
+    if (N(cont) != n) continue;
+    double bound= (1.0 - best_rec) * (1.0 - best_rec) * n;
+    double sum= 0.0;
+    int j;
+    for (j=0; j<n && sum < bound; j++) {
+      double d= cont[j] - cont1[j];
+      sum += d * d;
+    }
+    if (j < n || sum >= bound) continue;
+    double dist= sqrt (sum) / sqrt (n);
+    double rec = 1.0 - dist;
+    if (rec > best_rec) { best_rec= rec; best= learned_names[i]; }
+  }
+}
+
 void
 recognize_glyph_one (contours gl, int& level, string& best, double& best_rec) {
   array<tree>   disc1;
@@ -26,31 +50,15 @@ recognize_glyph_one (contours gl, int& level, string& best, double& best_rec) {
 
   best= "";
   best_rec= -100.0;
-  for (int i=0; i<N(learned_names); i++)
-    if (N(learned_glyphs[i]) == N(gl) && disc1 == learned_disc1[i]) {
-      string        name= learned_names[i];
-      array<double> cont= learned_cont1[i];
-      double        dist= l2_norm (cont - cont1) / sqrt (N(cont1));
-      double        rec = 1.0 - dist;
-      if (rec > best_rec) { best_rec= rec; best= name; }
-      //cout << name << ": " << 100.0 * rec << "%\n";
-    }
+  recognize_among (learned_index1[learned_key (gl, disc1)],
+                   learned_cont1, cont1, best, best_rec);
   if (best != "") {
-    //cout << "disc= " << disc1 << "\n";
-    //cout << "cont= " << cont1 << "\n";
     level= 1;
     return;
   }
 
-  for (int i=0; i<N(learned_names); i++)
-    if (N(learned_glyphs[i]) == N(gl) && disc2 == learned_disc2[i]) {
-      string        name= learned_names[i];
-      array<double> cont= learned_cont2[i];
-      double        dist= l2_norm (cont - cont2) / sqrt (N(cont2));
-      double        rec = 1.0 - dist;
-      if (rec > best_rec) { best_rec= rec; best= name; }
-      //cout << name << ": " << 100.0 * rec << "%\n";
-    }
+  recognize_among (learned_index2[learned_key (gl, disc2)],
+                   learned_cont2, cont2, best, best_rec);
   level= 2;
 }
 
@@ -186,6 +186,13 @@ picture_cache_reset () {
   picture_stamp= hashmap<tree,int> ();
 }
 
+void
+picture_cache_forget (url file_name, int w, int h, tree eff) {
+  tree key= tuple (file_name->t, as_string (w), as_string (h), eff);
+  picture_cache->reset (key);
+  picture_stamp->reset (key);
+}
+
 static bool
 picture_is_cached (url file_name, int w, int h, tree eff, int pixel) {
   (void) pixel;
@@ -205,12 +212,13 @@ picture_is_cached (url file_name, int w, int h, tree eff, int pixel) {
 
 picture
 cached_load_picture (url file_name, int w, int h, tree eff,
-                     int pixel, bool permanent) {
+                     int pixel, bool permanent, bool async) {
   tree key= tuple (file_name->t, as_string (w), as_string (h), eff);
   if (picture_is_cached (file_name, w, h, eff, pixel))
     return picture_cache [key];
   //cout << "Loading " << key << "\n";
-  picture pic= load_picture (file_name, w, h, eff, pixel);
+  MEM_TAG_SCOPE (MEM_PICTURES);
+  picture pic= load_picture (file_name, w, h, eff, pixel, async);
   if (permanent || picture_count[key] > 0) {
     int pic_modif= last_modified (file_name, false);
     picture_cache (key)= pic;
@@ -13,6 +13,7 @@
 #define RASTER_H
 #include "raster_operators.hpp"
 #include "unary_function.hpp"
+#include "parallel.hpp"
 
 /******************************************************************************
 * Raster class
@@ -77,6 +78,27 @@ print (raster<C> r) {
       cout << x << ", " << y << " -> " << r->a[y*r->w+x] << "\n";
 }
 
+/******************************************************************************
+* Tiled evaluation
+******************************************************************************/
+
+// Tiles of RASTER_TILE pixels fit into the L2 cache, also for true colors.
+// The jobs only manipulate the raw pixel arrays, which can therefore be
+// processed in parallel and without touching any reference counters.
+#define RASTER_TILE 4096
+
+template<typename T> inline void
+raster_tiles (T& job, int n) {
+  parallel_for (T::run, (void*) &job, n, RASTER_TILE);
+}
+
+template<typename T> inline void
+raster_rows (T& job, int row_cost, int h) {
+  // row_cost is the number of pixel operations needed for each row
+  int grain= max (1, RASTER_TILE / max (1, row_cost));
+  parallel_for (T::run, (void*) &job, h, grain);
+}
+
 /******************************************************************************
 * Simple operations
 ******************************************************************************/
@@ -144,21 +166,38 @@ extend_border (raster<C> r, int b) {
 * Mappers
 ******************************************************************************/
 
+template<typename Op, typename C>
+struct foreach_job {
+  C* a;
+  static void run (void* data, int start, int end) {
+    C* a= ((foreach_job*) data)->a;
+    for (int i=start; i<end; i++)
+      Op::set_op (a[i]); }
+};
+
 template<typename Op, typename C> void
 foreach (raster<C>& r) {
-  int w= r->w, h= r->h, n= w*h;
-  for (int i=0; i<n; i++)
-    Op::set_op (r->a[i]);
+  foreach_job<Op,C> job= { r->a };
+  raster_tiles (job, r->w * r->h);
 }
 
+template<typename Op, typename C, typename Ret>
+struct map_job {
+  const C* src;
+  Ret* dest;
+  static void run (void* data, int start, int end) {
+    map_job* job= (map_job*) data;
+    row_op<Op>::op (job->dest + start, job->src + start, end - start); }
+};
+
 template<typename Op, typename C>
 raster<Unary_return_type(Op,C) >
 map (raster<C> r) {
   typedef Unary_return_type(Op,C) Ret;
   int w= r->w, h= r->h, n= w*h;
   raster<Ret> ret (w, h, r->ox, r->oy);
-  for (int i=0; i<n; i++)
-    ret->a[i]= Op::op (r->a[i]);
+  map_job<Op,C,Ret> job= { r->a, ret->a };
+  raster_tiles (job, n);
   return ret;
 }
 
@@ -171,23 +210,48 @@ map (unary_function<C,S> fun, raster<S> r) {
   return ret;
 }
 
+template<typename Op, typename C, typename S>
+struct map2_job {
+  const C* src1;
+  const S* src2;
+  C* dest;
+  static void run (void* data, int start, int end) {
+    map2_job* job= (map2_job*) data;
+    row_op<Op>::op (job->dest + start, job->src1 + start, job->src2 + start,
+                    end - start); }
+};
+
 template<typename Op, typename C, typename S> raster<C>
 map (raster<C> r1, raster<S> r2) {
   int w= r1->w, h= r1->h, n= w*h;
   ASSERT (r2->w == w && r2->h == h, "sizes don't match");
   ASSERT (r2->ox == r1->ox && r2->oy == r1->oy, "offsets don't match");
   raster<C> ret (w, h, r1->ox, r1->oy);
-  for (int i=0; i<n; i++)
-    ret->a[i]= Op::op (r1->a[i], r2->a[i]);
+  map2_job<Op,C,S> job= { r1->a, r2->a, ret->a };
+  raster_tiles (job, n);
   return ret;
 }
 
+template<typename Op, typename C, typename S>
+struct map_scalar_job {
+  const C* src;
+  S sc;
+  C* dest;
+  static void run (void* data, int start, int end) {
+    map_scalar_job* job= (map_scalar_job*) data;
+    const C* src= job->src;
+    C* dest= job->dest;
+    S sc= job->sc;
+    for (int i=start; i<end; i++)
+      dest[i]= Op::op (src[i], sc); }
+};
+
 template<typename Op, typename C, typename S> raster<C>
 map_scalar (raster<C> r, S sc) {
   int w= r->w, h= r->h, n= w*h;
   raster<C> ret (w, h, r->ox, r->oy);
-  for (int i=0; i<n; i++)
-    ret->a[i]= Op::op (r->a[i], sc);
+  map_scalar_job<Op,C,S> job= { r->a, sc, ret->a };
+  raster_tiles (job, n);
   return ret;
 }
 
@@ -254,12 +318,29 @@ template<typename C> inline raster<C>
 max (const raster<C>& r1, const raster<C>& r2) {
   return map<max_op> (r1, r2); }
 
+template<typename C, typename S> inline void
+apply_alpha_pixels (C* d, const C& col, const S* a, int n) {
+  for (int i=0; i<n; i++)
+    d[i]= apply_alpha (col, a[i]);
+}
+
+template<typename C, typename S>
+struct apply_alpha_job {
+  C col;
+  const S* src;
+  C* dest;
+  static void run (void* data, int start, int end) {
+    apply_alpha_job* job= (apply_alpha_job*) data;
+    apply_alpha_pixels (job->dest + start, job->col, job->src + start,
+                        end - start); }
+};
+
 template<typename C, typename S> raster<C>
 apply_alpha (C col, raster<S> r) {
   int w= r->w, h= r->h, n= w*h;
   raster<C> ret (w, h, r->ox, r->oy);
-  for (int i=0; i<n; i++)
-    ret->a[i]= apply_alpha (col, r->a[i]);
+  apply_alpha_job<C,S> job= { col, r->a, ret->a };
+  raster_tiles (job, n);
   return ret;
 }
 
@@ -267,19 +348,44 @@ apply_alpha (C col, raster<S> r) {
 * Composition
 ******************************************************************************/
 
+template<composition_mode M, typename C, typename S>
+struct draw_on_job {
+  C* dest;
+  S s;
+  static void run (void* data, int start, int end) {
+    draw_on_job* job= (draw_on_job*) data;
+    C* dest= job->dest;
+    S s= job->s;
+    for (int i=start; i<end; i++)
+      composition_op<M>::set_op (dest[i], s); }
+};
+
 template<composition_mode M, typename C, typename S> void
 draw_on (raster<C>& r, S s) {
-  int w= r->w, h= r->h, n=w*h;
-  for (int i=0; i<n; i++)
-    composition_op<M>::set_op (r->a[i], s);
-}
+  draw_on_job<M,C,S> job= { r->a, s };
+  raster_tiles (job, r->w * r->h);
+}
+
+template<composition_mode M, typename C, typename S>
+struct compose_job {
+  const C* src;
+  S s;
+  C* dest;
+  static void run (void* data, int start, int end) {
+    compose_job* job= (compose_job*) data;
+    const C* src= job->src;
+    C* dest= job->dest;
+    S s= job->s;
+    for (int i=start; i<end; i++)
+      dest[i]= composition_op<M>::op (src[i], s); }
+};
 
 template<composition_mode M, typename C, typename S> raster<C>
 compose (raster<C> r, S s) {
   int w= r->w, h= r->h, n=w*h;
   raster<C> ret (w, h, r->ox, r->oy);
-  for (int i=0; i<n; i++)
-    ret->a[i]= composition_op<M>::op (r->a[i], s);
+  compose_job<M,C,S> job= { r->a, s, ret->a };
+  raster_tiles (job, n);
   return ret;
 }
 
@@ -328,6 +434,19 @@ compose (raster<C> r, S s, composition_mode mode) {
   return ret;
 }
 
+template<composition_mode M, typename C, typename S>
+struct draw_on_raster_job {
+  C* d;
+  const S* s;
+  int dw, sw, w;
+  static void run (void* data, int start, int end) {
+    draw_on_raster_job* job= (draw_on_raster_job*) data;
+    int w= job->w;
+    for (int yy=start; yy<end; yy++)
+      composition_row<M>::set_op (job->d + yy * job->dw,
+                                  job->s + yy * job->sw, w); }
+};
+
 template<composition_mode M, typename C, typename S> void
 draw_on (raster<C>& dest, raster<S> src, int x, int y) {
   x -= src->ox - dest->ox;
@@ -344,9 +463,8 @@ draw_on (raster<C>& dest, raster<S> src, int x, int y) {
   int h = min (sh2, dh - y);
   if (w <= 0 || h <= 0) return;
   d += y * dw + x;
-  for (int yy=0; yy<h; yy++, d += dw, s +=sw)
-    for (int xx=0; xx<w; xx++)
-      composition_op<M>::set_op (d[xx], s[xx]);
+  draw_on_raster_job<M,C,S> job= { d, s, dw, sw, w };
+  raster_rows (job, w, h);
 }
 
 template<typename C, typename S> void
@@ -719,6 +837,77 @@ gaussian_pen (double rx, double ry, double phi, double order= 2.5) {
 * Convolution and blur
 ******************************************************************************/
 
+// The convolution jobs below compute the rows of the destination
+// independently; the terms of each sum are added in the same order as
+// for a direct evaluation, so that the result does not depend on the tiling.
+// The innermost loops are plain multiply-adds over contiguous pixels,
+// which are vectorized by the compiler.
+
+template<typename C, typename S>
+struct convolute_job {
+  const C* s1;
+  const S* s2;
+  C* d;
+  int s1w, s1h, s2w, s2h, dw;
+  static void run (void* data, int start, int end) {
+    convolute_job* job= (convolute_job*) data;
+    int s1w= job->s1w, s1h= job->s1h, s2w= job->s2w, s2h= job->s2h;
+    for (int y=start; y<end; y++) {
+      int ya= max (0, y - s2h + 1), yb= min (s1h, y + 1);
+      for (int y1=ya; y1<yb; y1++) {
+        const C* src= job->s1 + y1 * s1w;
+        const S* pen= job->s2 + (y - y1) * s2w;
+        for (int x2=s2w-1; x2>=0; x2--) {
+          S f= pen[x2];
+          C* dest= job->d + y * job->dw + x2;
+          for (int x1=0; x1<s1w; x1++)
+            dest[x1] += src[x1] * f;
+        }
+      }
+    } }
+};
+
+template<typename C, typename S>
+struct convolute_rows_job {
+  const C* s1;
+  const S* xs;
+  C* d;
+  int s1w, s2w, dw;
+  static void run (void* data, int start, int end) {
+    convolute_rows_job* job= (convolute_rows_job*) data;
+    int s1w= job->s1w, s2w= job->s2w;
+    for (int y=start; y<end; y++) {
+      const C* src= job->s1 + y * s1w;
+      for (int x2=s2w-1; x2>=0; x2--) {
+        S f= job->xs[x2];
+        C* dest= job->d + y * job->dw + x2;
+        for (int x1=0; x1<s1w; x1++)
+          dest[x1] += src[x1] * f;
+      }
+    } }
+};
+
+template<typename C, typename S>
+struct convolute_columns_job {
+  const C* s1;
+  const S* ys;
+  C* d;
+  int s1h, s2h, dw;
+  static void run (void* data, int start, int end) {
+    convolute_columns_job* job= (convolute_columns_job*) data;
+    int s1h= job->s1h, s2h= job->s2h, dw= job->dw;
+    for (int y=start; y<end; y++) {
+      int ya= max (0, y - s2h + 1), yb= min (s1h, y + 1);
+      C* dest= job->d + y * dw;
+      for (int y1=ya; y1<yb; y1++) {
+        const C* src= job->s1 + y1 * dw;
+        S f= job->ys[y - y1];
+        for (int x=0; x<dw; x++)
+          dest[x] += src[x] * f;
+      }
+    } }
+};
+
 template<typename C, typename S> raster<C>
 convolute (raster<C> s1, raster<S> s2) {
   if (s1->w * s1->h == 0) return s1;
@@ -728,13 +917,8 @@ convolute (raster<C> s1, raster<S> s2) {
   raster<C> d (dw, dh, s1->ox + s2->ox, s1->oy + s2->oy);
   clear (d);
   raster<C> temp= mul_alpha (s1);
-  for (int y1=0; y1<s1h; y1++)
-    for (int y2=0; y2<s2h; y2++) {
-      int o1= y1 * s1w, o2= y2 * s2w, o= (y1 + y2) * dw;
-      for (int x1=0; x1<s1w; x1++)
-        for (int x2=0; x2<s2w; x2++)
-          d->a[o+x1+x2] += temp->a[o1+x1] * s2->a[o2+x2];
-    }
+  convolute_job<C,S> job= { temp->a, s2->a, d->a, s1w, s1h, s2w, s2h, dw };
+  raster_rows (job, s1w * s2w * s2h, dh);
   return div_alpha (d);
 }
 
@@ -777,20 +961,12 @@ factored_convolute (raster<C> s1, raster<S> s2) {
   raster<C> temp= mul_alpha (s1);
   raster<C> aux (dw, s1h, s1->ox + s2->ox, s1->oy);
   clear (aux);
-  for (int y1=0; y1<s1h; y1++) {
-    int o1= y1 * s1w, o= y1 * dw;
-    for (int x1=0; x1<s1w; x1++)
-      for (int x2=0; x2<s2w; x2++)
-        aux->a[o+x1+x2] += temp->a[o1+x1] * xs->a[x2];
-  }
+  convolute_rows_job<C,S> hjob= { temp->a, xs->a, aux->a, s1w, s2w, dw };
+  raster_rows (hjob, dw * s2w, s1h);
   raster<C> d (dw, dh, s1->ox + s2->ox, s1->oy + s2->oy);
   clear (d);
-  for (int y1=0; y1<s1h; y1++)
-    for (int y2=0; y2<s2h; y2++) {
-      int o1= y1 * dw, o= (y1 + y2) * dw;
-      for (int x1=0; x1<dw; x1++)
-        d->a[o+x1] += aux->a[o1+x1] * ys->a[y2];
-    }
+  convolute_columns_job<C,S> vjob= { aux->a, ys->a, d->a, s1h, s2h, dw };
+  raster_rows (vjob, dw * s2h, dh);
   return div_alpha (d);
 }
 
@@ -895,29 +1071,45 @@ erode (raster<C> s1, raster<S> s2) {
 * Inner variation
 ******************************************************************************/
 
+template<typename C, typename F, typename S>
+struct variation_job {
+  const F* temp;
+  const S* pen;
+  C* d;
+  int tw, th, s2w, s2h, s2ox, s2oy, dw;
+  inline F get (int x, int y) {
+    if (x >= 0 && tw > x && y >= 0 && th > y) return temp[y*tw+x];
+    else { F r; clear (r); return r; } }
+  static void run (void* data, int start, int end) {
+    variation_job* job= (variation_job*) data;
+    int s2w= job->s2w, s2h= job->s2h, dw= job->dw;
+    int s2ox= job->s2ox, s2oy= job->s2oy;
+    for (int y0=start; y0<end; y0++)
+      for (int x0=0; x0<dw; x0++) {
+        int x1= x0 - s2ox, y1= y0 - s2oy;
+        F ref= job->get (x1, y1);
+        F min_v= 0, max_v= 0;
+        for (int y2=0; y2<s2h; y2++)
+          for (int x2=0; x2<s2w; x2++) {
+            F cur= job->get (x1 - (x2 - s2ox), y1 - (y2 - s2oy));
+            F v= (cur - ref) * job->pen[y2*s2w + x2];
+            max_v= max (max_v, v);
+            min_v= min (min_v, v);
+          }
+        get_alpha (job->d[y0*dw + x0]) = max_v - min_v;
+      } }
+};
+
 template<typename C, typename S> raster<C>
 variation (raster<C> s1, raster<S> s2) {
   typedef typename C::scalar_type F;
   if (s1->w * s1->h == 0) return s1;
   ASSERT (s2->w * s2->h != 0, "empty pen");
   raster<C> d= convolute (s1, s2);
-  int s2w= s2->w, s2h= s2->h, dw= d->w, dh= d->h;
-  int s2ox= s2->ox, s2oy= s2->oy;
   raster<F> temp= get_alpha (s1);
-  for (int y0=0; y0<dh; y0++)
-    for (int x0=0; x0<dw; x0++) {
-      int x1= x0 - s2ox, y1= y0 - s2oy;
-      F ref= temp->internal_get_pixel (x1, y1);
-      F min_v= 0, max_v= 0;
-      for (int y2=0; y2<s2h; y2++)
-        for (int x2=0; x2<s2w; x2++) {
-          F cur= temp->internal_get_pixel (x1 - (x2 - s2ox), y1 - (y2 - s2oy));
-          F v= (cur - ref) * s2->a[y2*s2w + x2];
-          max_v= max (max_v, v);
-          min_v= min (min_v, v);
-        }
-      get_alpha (d->a[y0*dw + x0]) = max_v - min_v;
-    }
+  variation_job<C,F,S> job= { temp->a, s2->a, d->a, temp->w, temp->h,
+                              s2->w, s2->h, s2->ox, s2->oy, d->w };
+  raster_rows (job, d->w * s2->w * s2->h, d->h);
   return d;
 }
 
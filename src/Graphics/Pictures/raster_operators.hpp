@@ -13,6 +13,7 @@
 #define RASTER_OPERATORS_HPP
 #include "picture.hpp"
 #include "operators.hpp"
+#include "true_color.hpp"
 
 /******************************************************************************
 * Default implementations
@@ -203,6 +204,69 @@ struct composition_op<compose_max> {
   set_op (C& x, const S& y) { x= max (x, y); }
 };
 
+/******************************************************************************
+* Operators on rows of pixels
+******************************************************************************/
+
+// By default, operators on rows of pixels are applied pixel by pixel;
+// vectorized kernels are used for the most common operators on true colors
+
+template<typename Op>
+struct pixelwise_row_op {
+  template<typename C, typename R> static inline void
+  op (R* d, const C* s, int n) {
+    for (int i=0; i<n; i++) d[i]= Op::op (s[i]); }
+  template<typename C, typename S, typename R> static inline void
+  op (R* d, const C* s1, const S* s2, int n) {
+    for (int i=0; i<n; i++) d[i]= Op::op (s1[i], s2[i]); }
+};
+
+template<typename Op>
+struct row_op: public pixelwise_row_op<Op> {};
+
+template<>
+struct row_op<mul_alpha_op>: public pixelwise_row_op<mul_alpha_op> {
+  using pixelwise_row_op<mul_alpha_op>::op;
+  static inline void
+  op (true_color* d, const true_color* s, int n) {
+    mul_alpha_pixels (d, s, n); }
+};
+
+template<>
+struct row_op<apply_alpha_op>: public pixelwise_row_op<apply_alpha_op> {
+  using pixelwise_row_op<apply_alpha_op>::op;
+  static inline void
+  op (true_color* d, const true_color* s1, const double* s2, int n) {
+    apply_alpha_pixels (d, s1, s2, n); }
+};
+
+template<composition_mode M>
+struct composition_row {
+  template<typename C, typename S> static inline void
+  set_op (C* d, const S* s, int n) {
+    for (int i=0; i<n; i++) composition_op<M>::set_op (d[i], s[i]); }
+};
+
+template<>
+struct composition_row<compose_source_over> {
+  template<typename C, typename S> static inline void
+  set_op (C* d, const S* s, int n) {
+    for (int i=0; i<n; i++) d[i]= source_over (d[i], s[i]); }
+  static inline void
+  set_op (true_color* d, const true_color* s, int n) {
+    source_over_pixels (d, s, n); }
+};
+
+template<>
+struct composition_row<compose_mul> {
+  template<typename C, typename S> static inline void
+  set_op (C* d, const S* s, int n) {
+    for (int i=0; i<n; i++) d[i] *= s[i]; }
+  static inline void
+  set_op (true_color* d, const true_color* s, int n) {
+    mul_pixels (d, s, n); }
+};
+
 typedef composition_op<compose_source> source_op;
 typedef composition_op<compose_source_over> source_over_op;
 typedef composition_op<compose_towards_source> towards_source_op;
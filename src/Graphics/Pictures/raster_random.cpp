@@ -243,21 +243,53 @@ perlin_rep::turbulence (int nColorChannel,
 * Public interface
 ******************************************************************************/
 
+// The perlin tables are only read while computing the noise, so that the
+// rows of the turbulence can be computed in parallel
+
+static inline void
+set_turbulence (double& c, double* v) { c= v[0]; }
+static inline void
+set_turbulence (true_color& c, double* v) {
+  c= true_color (v[0], v[1], v[2], v[3]); }
+
+template<typename C>
+struct turbulence_job {
+  perlin_rep* p;
+  long seed;
+  double wavelen_x, wavelen_y;
+  int nNumOctaves;
+  bool bFractalSum;
+  int w, nr_channels;
+  C* a;
+  static void run (void* data, int start, int end) {
+    turbulence_job* job= (turbulence_job*) data;
+    int w= job->w, nr= job->nr_channels;
+    for (int y=start; y<end; y++)
+      for (int x=0; x<w; x++) {
+        double v[4];
+        for (int ch=0; ch<nr; ch++) {
+          v[ch]= job->p->turbulence (nr == 1? 3: ch, (double) x, (double) y,
+                                     1.0 / job->wavelen_x,
+                                     1.0 / job->wavelen_y,
+                                     job->nNumOctaves, job->bFractalSum,
+                                     job->seed<0, 0.0, 0.0,
+                                     job->wavelen_x, job->wavelen_y);
+          if (job->bFractalSum) v[ch]= (v[ch] + 1.0) / 2.0;
+        }
+        set_turbulence (job->a[y*w+x], v);
+      }
+  }
+};
+
 raster<double>
 turbulence (int w, int h, int ox, int oy, long seed,
             double wavelen_x, double wavelen_y, 
             int nNumOctaves, bool bFractalSum) {
   perlin p= perlin_generator (seed);
   raster<double> ret (w, h, ox, oy);
-  for (int y=0; y<h; y++)
-    for (int x=0; x<w; x++) {
-      double v= p->turbulence (3, (double) x, (double) y,
-                               1.0 / wavelen_x, 1.0 / wavelen_y,
-                               nNumOctaves, bFractalSum, seed<0,
-                               0.0, 0.0, wavelen_x, wavelen_y);
-      if (bFractalSum) v= (v + 1.0) / 2.0;
-      ret->a[y*w+x]= v;
-    }
+  turbulence_job<double> job= { p.rep, seed, wavelen_x, wavelen_y,
+                                nNumOctaves, bFractalSum, w, 1, ret->a };
+  raster_rows (job, w * nNumOctaves, h);
   return ret;
 }
 
@@ -276,17 +308,9 @@ turbulence (raster<true_color> ras, long seed,
   int w= ras->w, h= ras->h, ox= ras->ox, oy= ras->oy;
   perlin p= perlin_generator (seed);
   raster<true_color> ret (w, h, ox, oy);
-  for (int y=0; y<h; y++)
-    for (int x=0; x<w; x++) {
-      double v[4];
-      for (int ch=0; ch<4; ch++) {
-        v[ch]= p->turbulence (ch, (double) x, (double) y,
-                              1.0 / wavelen_x, 1.0 / wavelen_y,
-                              nNumOctaves, bFractalSum, seed<0,
-                              0.0, 0.0, wavelen_x, wavelen_y);
-        if (bFractalSum) v[ch]= (v[ch] + 1.0) / 2.0;
-      }
-      ret->a[y*w+x]= true_color (v[0], v[1], v[2], v[3]);
-    }
+  turbulence_job<true_color> job= { p.rep, seed,
+                                    wavelen_x, wavelen_y,
+                                    nNumOctaves, bFractalSum, w, 4, ret->a };
+  raster_rows (job, 4 * w * nNumOctaves, h);
   return ret;
 }
@@ -65,7 +65,8 @@ public:
       picture_cache_reserve (u, w/px, h/px, eff, px);
     }
     picture pict=
-      cached_load_picture (u, w/ren->pixel, h/ren->pixel, eff, px, false);
+      cached_load_picture (u, w/ren->pixel, h/ren->pixel, eff, px,
+                           false, ren->is_screen);
     ren->draw_picture (pict, x, y, alpha); }
 };
 
@@ -19,6 +19,7 @@
 #include "iterator.hpp"
 #include "convert.hpp"
 #include "file.hpp"
+#include "sys_utils.hpp"
 #include <string.h>
 
 /******************************************************************************
@@ -50,6 +51,15 @@ hash (basic_character xc) {
   return xc->c ^ ((intptr_t) xc->fng.rep) ^ xc->fg ^ xc->bg ^ xc->sf;
 }
 
+long
+character_cache_budget () {
+  // maximal number of bytes for the images of characters of a renderer,
+  // which may be set in megabytes using TEXMACS_CHARACTER_CACHE
+  string s= get_env ("TEXMACS_CHARACTER_CACHE");
+  if (is_int (s) && as_int (s) > 0) return ((long) as_int (s)) << 20;
+  return 32L << 20;
+}
+
 /******************************************************************************
 * Conversion between window and postscript coordinates
 ******************************************************************************/
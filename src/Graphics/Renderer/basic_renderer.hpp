@@ -43,6 +43,7 @@ CONCRETE_CODE(basic_character);
 bool operator == (basic_character xc1, basic_character xc2);
 bool operator != (basic_character xc1, basic_character xc2);
 int hash (basic_character xc);
+long character_cache_budget ();
 
 /******************************************************************************
 * basic_renderer_rep
@@ -0,0 +1,373 @@
+
+/******************************************************************************
+* MODULE     : checksum_renderer.cpp
+* DESCRIPTION: renderers which compute a checksum of what is drawn
+* COPYRIGHT  : (C) 2020  Joris van der Hoeven
+*******************************************************************************
+* This software falls under the GNU general public license version 3 or later.
+* It comes WITHOUT ANY WARRANTY WHATSOEVER. For details, see the file LICENSE
+* in the root directory or <http://www.gnu.org/licenses/gpl-3.0.html>.
+******************************************************************************/
+
+#include "checksum_renderer.hpp"
+#include "frame.hpp"
+#include "rectangles.hpp"
+#include "analyze.hpp"
+#include "file.hpp"
+#include "colors.hpp"
+#include "fast_hash.hpp"
+
+/******************************************************************************
+* Constructors and destructors
+******************************************************************************/
+
+checksum_renderer_rep::checksum_renderer_rep (renderer ref2):
+  renderer_rep (false), ref (ref2), h (0),
+  pen (black), bgb (white)
+{
+  ox      = ref->ox;
+  oy      = ref->oy;
+  cx1     = ref->cx1;
+  cy1     = ref->cy1;
+  cx2     = ref->cx2;
+  cy2     = ref->cy2;
+  zoomf   = ref->zoomf;
+  shrinkf = ref->shrinkf;
+  pixel   = ref->pixel;
+  retina_pixel= ref->retina_pixel;
+  brushpx = ref->brushpx;
+  thicken = ref->thicken;
+  cur_page= ref->cur_page;
+}
+
+checksum_renderer_rep::~checksum_renderer_rep () {}
+
+/******************************************************************************
+* Accumulating the checksum
+******************************************************************************/
+
+void
+checksum_renderer_rep::mix_bytes (const char* s, int n) {
+  // the checksum so far serves as the seed for hashing the next bytes
+  h= fast_hash (s, n, h);
+}
+
+void
+checksum_renderer_rep::mix (string s) {
+  mix ((long long int) N(s));
+  mix_bytes (&s[0], N(s));
+}
+
+void
+checksum_renderer_rep::tag (const char* s) {
+  mix (string (s));
+}
+
+void
+checksum_renderer_rep::mix (long long int i) {
+  char buf[8];
+  for (int k=0; k<8; k++) buf[k]= (char) ((i >> (8*k)) & 255);
+  mix_bytes (buf, 8);
+}
+
+void
+checksum_renderer_rep::mix_point (SI x, SI y) {
+  // drawing requests are expressed with respect to the current origin
+  mix ((long long int) (x + ox));
+  mix ((long long int) (y + oy));
+}
+
+void
+checksum_renderer_rep::mix (brush b) {
+  if (is_nil (b)) { tag ("nil"); return; }
+  mix ((long long int) b->get_type ());
+  mix ((long long int) b->get_color ());
+  mix ((long long int) b->get_alpha ());
+  tree pat= b->get_pattern ();
+  if (pat != "") mix (as_string (pat));
+}
+
+void
+checksum_renderer_rep::mix (pencil p) {
+  if (is_nil (p)) { tag ("nil"); return; }
+  mix ((long long int) p->get_type ());
+  mix ((long long int) p->get_color ());
+  mix ((long long int) p->get_width ());
+  mix ((long long int) p->get_cap ());
+  mix ((long long int) p->get_join ());
+  mix ((long long int) (1000.0 * p->get_miter_lim ()));
+  if (p->get_type () == pencil_brush) mix (p->get_brush ());
+}
+
+void
+checksum_renderer_rep::mix (picture pic) {
+  // pictures loaded from files are identified by their name, the others
+  // (such as the results of graphical effects) by their pixels
+  int w= pic->get_width (), ht= pic->get_height ();
+  mix ((long long int) w);
+  mix ((long long int) ht);
+  mix ((long long int) pic->get_origin_x ());
+  mix ((long long int) pic->get_origin_y ());
+  url name= pic->get_name ();
+  if (!is_none (name)) {
+    mix (as_string (name));
+    mix ((long long int) last_modified (name, false));
+  }
+  else {
+    int x0= pic->get_origin_x (), y0= pic->get_origin_y ();
+    for (int y=0; y<ht; y++)
+      for (int x=0; x<w; x++)
+        mix ((long long int) pic->get_pixel (x - x0, y - y0));
+  }
+}
+
+string
+checksum_renderer_rep::get_checksum () {
+  unsigned long long int r= h;
+  string s;
+  for (int k=0; k<16; k++) {
+    s= string ("0123456789abcdef"[(int) (r & 15)]) * s;
+    r >>= 4;
+  }
+  return s;
+}
+
+/******************************************************************************
+* Device specific
+******************************************************************************/
+
+bool
+checksum_renderer_rep::is_printer () {
+  return ref->is_printer ();
+}
+
+void
+checksum_renderer_rep::get_extents (int& w, int& ht) {
+  ref->get_extents (w, ht);
+}
+
+void
+checksum_renderer_rep::set_transformation (frame fr) {
+  tag ("transform");
+  mix (as_string ((tree) fr));
+}
+
+void
+checksum_renderer_rep::reset_transformation () {
+  tag ("reset");
+}
+
+void
+checksum_renderer_rep::set_clipping (SI x1, SI y1, SI x2, SI y2, bool restore)
+{
+  tag ("clip");
+  mix_point (x1, y1);
+  mix_point (x2, y2);
+  mix ((long long int) restore);
+  renderer_rep::set_clipping (x1, y1, x2, y2, restore);
+}
+
+/******************************************************************************
+* Graphical state
+******************************************************************************/
+
+pencil
+checksum_renderer_rep::get_pencil () {
+  return pen;
+}
+
+brush
+checksum_renderer_rep::get_background () {
+  return bgb;
+}
+
+void
+checksum_renderer_rep::set_pencil (pencil p) {
+  tag ("pencil");
+  mix (p);
+  pen= p;
+}
+
+void
+checksum_renderer_rep::set_brush (brush b) {
+  tag ("brush");
+  mix (b);
+  pen= pencil (b);
+}
+
+void
+checksum_renderer_rep::set_background (brush b) {
+  tag ("background");
+  mix (b);
+  bgb= b;
+}
+
+/******************************************************************************
+* Drawing
+******************************************************************************/
+
+void
+checksum_renderer_rep::draw (int c, font_glyphs fn, SI x, SI y) {
+  tag ("char");
+  mix (fn->res_name);
+  mix ((long long int) c);
+  mix_point (x, y);
+}
+
+void
+checksum_renderer_rep::line (SI x1, SI y1, SI x2, SI y2) {
+  tag ("line");
+  mix_point (x1, y1);
+  mix_point (x2, y2);
+}
+
+void
+checksum_renderer_rep::lines (array<SI> x, array<SI> y) {
+  tag ("lines");
+  int i, n= min (N(x), N(y));
+  for (i=0; i<n; i++) mix_point (x[i], y[i]);
+}
+
+void
+checksum_renderer_rep::clear (SI x1, SI y1, SI x2, SI y2) {
+  tag ("clear");
+  mix_point (x1, y1);
+  mix_point (x2, y2);
+}
+
+void
+checksum_renderer_rep::fill (SI x1, SI y1, SI x2, SI y2) {
+  tag ("fill");
+  mix_point (x1, y1);
+  mix_point (x2, y2);
+}
+
+void
+checksum_renderer_rep::arc (SI x1, SI y1, SI x2, SI y2, int a, int d) {
+  tag ("arc");
+  mix_point (x1, y1);
+  mix_point (x2, y2);
+  mix ((long long int) a);
+  mix ((long long int) d);
+}
+
+void
+checksum_renderer_rep::fill_arc (SI x1, SI y1, SI x2, SI y2, int a, int d) {
+  tag ("fill-arc");
+  mix_point (x1, y1);
+  mix_point (x2, y2);
+  mix ((long long int) a);
+  mix ((long long int) d);
+}
+
+void
+checksum_renderer_rep::polygon (array<SI> x, array<SI> y, bool convex) {
+  tag ("polygon");
+  int i, n= min (N(x), N(y));
+  for (i=0; i<n; i++) mix_point (x[i], y[i]);
+  mix ((long long int) convex);
+}
+
+void
+checksum_renderer_rep::draw_picture (picture pic, SI x, SI y, int alpha) {
+  tag ("picture");
+  mix (pic);
+  mix_point (x, y);
+  mix ((long long int) alpha);
+}
+
+void
+checksum_renderer_rep::draw_scalable (scalable im, SI x, SI y, int alpha) {
+  url name= im->get_name ();
+  if (is_none (name)) {
+    renderer_rep::draw_scalable (im, x, y, alpha);
+    return;
+  }
+  tag ("scalable");
+  mix (as_string (name));
+  mix ((long long int) last_modified (name, false));
+  mix (as_string (im->get_effect ()));
+  rectangle r= im->get_logical_extents ();
+  mix_point (x + r->x1, y + r->y1);
+  mix_point (x + r->x2, y + r->y2);
+  mix ((long long int) alpha);
+}
+
+/******************************************************************************
+* Shadows are not used on printers
+******************************************************************************/
+
+void
+checksum_renderer_rep::fetch (SI x1, SI y1, SI x2, SI y2,
+                              renderer ren, SI x, SI y) {
+  (void) x1; (void) y1; (void) x2; (void) y2;
+  (void) ren; (void) x; (void) y;
+}
+
+void
+checksum_renderer_rep::new_shadow (renderer& ren) {
+  (void) ren;
+}
+
+void
+checksum_renderer_rep::delete_shadow (renderer& ren) {
+  (void) ren;
+}
+
+void
+checksum_renderer_rep::get_shadow (renderer ren, SI x1, SI y1, SI x2, SI y2) {
+  (void) ren; (void) x1; (void) y1; (void) x2; (void) y2;
+}
+
+void
+checksum_renderer_rep::put_shadow (renderer ren, SI x1, SI y1, SI x2, SI y2) {
+  (void) ren; (void) x1; (void) y1; (void) x2; (void) y2;
+}
+
+void
+checksum_renderer_rep::apply_shadow (SI x1, SI y1, SI x2, SI y2) {
+  (void) x1; (void) y1; (void) x2; (void) y2;
+}
+
+/******************************************************************************
+* Recording and replaying hyperlinks
+******************************************************************************/
+
+static checksum_link
+make_link (int kind, string s1, string s2,
+           SI ox, SI oy, SI x1, SI y1, SI x2, SI y2) {
+  checksum_link l;
+  l.kind= kind; l.s1= s1; l.s2= s2;
+  l.ox= ox; l.oy= oy;
+  l.x1= x1; l.y1= y1; l.x2= x2; l.y2= y2;
+  return l;
+}
+
+void
+checksum_renderer_rep::anchor (string label, SI x1, SI y1, SI x2, SI y2) {
+  links << make_link (0, label, "", ox, oy, x1, y1, x2, y2);
+}
+
+void
+checksum_renderer_rep::href (string label, SI x1, SI y1, SI x2, SI y2) {
+  links << make_link (1, label, "", ox, oy, x1, y1, x2, y2);
+}
+
+void
+checksum_renderer_rep::toc_entry (string kind, string title, SI x, SI y) {
+  links << make_link (2, kind, title, ox, oy, x, y, 0, 0);
+}
+
+void
+checksum_renderer_rep::replay_links () {
+  // replay the recorded calls on the reference renderer, at the same origin
+  SI old_ox= ref->ox, old_oy= ref->oy;
+  for (int i=0; i<N(links); i++) {
+    checksum_link l= links[i];
+    ref->set_origin (l.ox, l.oy);
+    if (l.kind == 0) ref->anchor (l.s1, l.x1, l.y1, l.x2, l.y2);
+    else if (l.kind == 1) ref->href (l.s1, l.x1, l.y1, l.x2, l.y2);
+    else ref->toc_entry (l.s1, l.s2, l.x1, l.y1);
+  }
+  ref->set_origin (old_ox, old_oy);
+}
@@ -0,0 +1,88 @@
+
+/******************************************************************************
+* MODULE     : checksum_renderer.hpp
+* DESCRIPTION: renderers which compute a checksum of what is drawn
+* COPYRIGHT  : (C) 2020  Joris van der Hoeven
+*******************************************************************************
+* This software falls under the GNU general public license version 3 or later.
+* It comes WITHOUT ANY WARRANTY WHATSOEVER. For details, see the file LICENSE
+* in the root directory or <http://www.gnu.org/licenses/gpl-3.0.html>.
+******************************************************************************/
+
+#ifndef CHECKSUM_RENDERER_H
+#define CHECKSUM_RENDERER_H
+#include "renderer.hpp"
+
+/******************************************************************************
+* A checksum renderer draws nothing, but accumulates a checksum of the
+* drawing requests, expressed in the coordinates of a reference renderer.
+* Two pages with the same checksum are drawn in the same way, which allows
+* printers to reuse pages from previous exports. The hyperlinks, anchors
+* and table of contents entries are not part of the drawing; they are
+* recorded so that they can be replayed on the reference renderer.
+******************************************************************************/
+
+struct checksum_link {
+  int    kind;   // 0 for anchors, 1 for hyperlinks, 2 for toc entries
+  string s1, s2;
+  SI     ox, oy, x1, y1, x2, y2;
+};
+
+class checksum_renderer_rep: public renderer_rep {
+  renderer ref;
+  unsigned long long int h;
+  pencil   pen;
+  brush    bgb;
+  array<checksum_link> links;
+
+  void mix_bytes (const char* s, int n);
+  void mix (string s);
+  void tag (const char* s);
+  void mix (long long int i);
+  void mix_point (SI x, SI y);
+  void mix (pencil p);
+  void mix (brush b);
+  void mix (picture p);
+
+public:
+  checksum_renderer_rep (renderer ref);
+  ~checksum_renderer_rep ();
+  string get_checksum ();
+  void replay_links ();
+
+  bool is_printer ();
+  void get_extents (int& w, int& h);
+  void set_transformation (frame fr);
+  void reset_transformation ();
+  void set_clipping (SI x1, SI y1, SI x2, SI y2, bool restore= false);
+
+  pencil get_pencil ();
+  brush get_background ();
+  void set_pencil (pencil p);
+  void set_brush (brush b);
+  void set_background (brush b);
+
+  void draw (int char_code, font_glyphs fn, SI x, SI y);
+  void line (SI x1, SI y1, SI x2, SI y2);
+  void lines (array<SI> x, array<SI> y);
+  void clear (SI x1, SI y1, SI x2, SI y2);
+  void fill (SI x1, SI y1, SI x2, SI y2);
+  void arc (SI x1, SI y1, SI x2, SI y2, int alpha, int delta);
+  void fill_arc (SI x1, SI y1, SI x2, SI y2, int alpha, int delta);
+  void polygon (array<SI> x, array<SI> y, bool convex=true);
+  void draw_picture (picture pic, SI x, SI y, int alpha= 255);
+  void draw_scalable (scalable im, SI x, SI y, int alpha= 255);
+
+  void fetch (SI x1, SI y1, SI x2, SI y2, renderer ren, SI x, SI y);
+  void new_shadow (renderer& ren);
+  void delete_shadow (renderer& ren);
+  void get_shadow (renderer ren, SI x1, SI y1, SI x2, SI y2);
+  void put_shadow (renderer ren, SI x1, SI y1, SI x2, SI y2);
+  void apply_shadow (SI x1, SI y1, SI x2, SI y2);
+
+  void anchor (string label, SI x1, SI y1, SI x2, SI y2);
+  void href (string label, SI x1, SI y1, SI x2, SI y2);
+  void toc_entry (string kind, string title, SI x, SI y);
+};
+
+#endif // defined CHECKSUM_RENDERER_H
@@ -41,6 +41,23 @@ string PS_POL_END ("ep");
 string PS1 ("u");
 string PS2 ("z");
 
+/******************************************************************************
+* The standard prologue files are only loaded once
+******************************************************************************/
+
+static string
+standard_prologue () {
+  static string pro;
+  if (N(pro) == 0) {
+    string tex_pro, special_pro, texps_pro;
+    load_string ("$TEXMACS_PATH/misc/convert/tex.pro", tex_pro, true);
+    load_string ("$TEXMACS_PATH/misc/convert/special.pro", special_pro, true);
+    load_string ("$TEXMACS_PATH/misc/convert/texps.pro", texps_pro, true);
+    pro= tex_pro * "\n" * special_pro * "\n" * texps_pro * "\n";
+  }
+  return pro;
+}
+
 /******************************************************************************
 * constructors and destructors
 ******************************************************************************/
@@ -60,12 +77,12 @@ printer_rep::printer_rep (
     defs ("?"), tex_chars ("?"), tex_width ("?"),
     tex_fonts ("?"), tex_font_chars (array<int>(0)), metadata ("")
 {
-  string tex_pro, special_pro, color_pro, texps_pro;
-  load_string ("$TEXMACS_PATH/misc/convert/tex.pro", tex_pro, true);
-  load_string ("$TEXMACS_PATH/misc/convert/special.pro", special_pro, true);
-  load_string ("$TEXMACS_PATH/misc/convert/color.pro", color_pro, true);
-  load_string ("$TEXMACS_PATH/misc/convert/texps.pro", texps_pro, true);
-  
+  // the body is written page by page into a temporary file; it is kept
+  // in memory only if this file cannot be created
+  body_file= url_temp (".ps");
+  c_string _body_file (concretize (body_file));
+  body_out= fopen (_body_file, "wb");
+
   prologue   << "%!PS-Adobe-2.0";
   if (suffix (ps_file_name) == "eps")
     prologue << " EPSF-2.0";
@@ -90,9 +107,7 @@ printer_rep::printer_rep (
   if (landscape)
     prologue << "%%Orientation: Landscape\n";
   prologue   << "%%EndComments\n\n"
-             << tex_pro << "\n"
-             << special_pro << "\n"
-             << texps_pro << "\n"
+             << standard_prologue ()
              << "TeXDict begin\n"
              << as_string ((int) (1864680.0*paper_w+ 0.5)) << " "
              << as_string ((int) (1864680.0*paper_h+ 0.5)) << " 1000 "
@@ -155,8 +170,32 @@ printer_rep::~printer_rep () {
     prologue << "@landscape\n";
   prologue << "%%EndSetup\n";
 
-  string ps_text= prologue * "\n" * body;
-  save_string (ps_file_name, ps_text);
+  if (body_out == NULL) {
+    string ps_text= prologue * "\n" * body;
+    save_string (ps_file_name, ps_text);
+    return;
+  }
+  flush_body ();
+  fclose (body_out);
+  c_string _ps_file_name (concretize (ps_file_name));
+  c_string _body_file (concretize (body_file));
+  FILE* out= fopen (_ps_file_name, "wb");
+  FILE* in = fopen (_body_file, "rb");
+  if (out == NULL || in == NULL)
+    convert_error << "Could not write " << ps_file_name << LF;
+  else {
+    prologue << "\n";
+    fwrite (&prologue[0], 1, N(prologue), out);
+    char buf[65536];
+    while (true) {
+      size_t n= fread (buf, 1, sizeof (buf), in);
+      if (n == 0) break;
+      fwrite (buf, 1, n, out);
+    }
+  }
+  if (out != NULL) fclose (out);
+  if (in  != NULL) fclose (in);
+  remove (body_file);
 }
 
 bool
@@ -167,6 +206,7 @@ printer_rep::is_printer () {
 void
 printer_rep::next_page () {
   if (cur_page > 0) print ("eop\n");
+  flush_body ();
   if (cur_page >= nr_pages) return;
   cur_page++;
   body << "\n%%Page: " << as_string (cur_page) << " "
@@ -189,6 +229,15 @@ printer_rep::next_page () {
 * subroutines for printing
 ******************************************************************************/
 
+void
+printer_rep::flush_body () {
+  // only called at the end of pages, so that print, sep and move_to
+  // never need to modify the flushed characters
+  if (body_out == NULL || N(body) == 0) return;
+  fwrite (&body[0], 1, N(body), body_out);
+  body= string ();
+}
+
 void
 printer_rep::define (string s, string defn) {
   if (defs->contains (s)) return;
@@ -414,7 +463,7 @@ static SI parse_length (string pfb, int& pos) {
   return (((((((SI) c1)<<8)+ ((SI) c2))<<8)+ ((SI) c3))<<8)+ c4;
 }
 
-static string pfb_to_pfa (url file) {
+static string pfb_to_pfa_sub (url file) {
   //cout << "pfb_to_pfa :" << file << LF;
   string pfb, pfa;
   QN magic, type = 0;
@@ -474,6 +523,15 @@ static string pfb_to_pfa (url file) {
 
 #undef HEX_PER_LINE
 
+static hashmap<string,string> pfa_cache ("");
+
+static string pfb_to_pfa (url file) {
+  // the conversions are shared by all documents printed during a session
+  string key= as_string (file) * ":" * as_string (last_modified (file));
+  if (!pfa_cache->contains (key)) pfa_cache (key)= pfb_to_pfa_sub (file);
+  return pfa_cache [key];
+}
+
 void
 printer_rep::generate_tex_fonts () {
   hashset<string> done;
@@ -28,7 +28,9 @@ class printer_rep: public renderer_rep {
   int      psh;
   bool     use_alpha;
   string   prologue;
-  string   body;
+  string   body;      // the part of the body since the last flush
+  url      body_file; // temporary file with the flushed parts of the body
+  FILE*    body_out;
   int      cur_page;
   int      linelen;
 
@@ -61,6 +63,7 @@ public:
 
   /*********************** subroutines for printing **************************/
 
+  void flush_body ();
   void define (string comm, string defn);
   void sep ();
   void cr ();
@@ -84,6 +84,19 @@ void
 renderer_rep::next_page () {
 }
 
+bool
+renderer_rep::is_incremental () {
+  return false;
+}
+
+bool
+renderer_rep::reuse_page (string checksum) {
+  // the current page will be drawn with the given checksum; return true
+  // if it can be taken from a previous rendering instead
+  (void) checksum;
+  return false;
+}
+
 void
 renderer_rep::anchor (string label, SI x1, SI y1, SI x2, SI y2) {
   (void) label;
@@ -318,6 +331,14 @@ abs_outer_round (SI& x1, SI& y1, SI& x2, SI& y2) {
 * Default property selection and rendering routines
 ******************************************************************************/
 
+void
+renderer_rep::draw_characters (int* cs, SI* xs, int n, font_glyphs fn, SI y) {
+  // draw the characters cs[i] at the positions (xs[i], y), for 0 <= i < n;
+  // renderers may override this routine in order to batch the drawing
+  for (int i=0; i<n; i++)
+    draw (cs[i], fn, xs[i], y);
+}
+
 void
 renderer_rep::draw_triangle (SI x1, SI y1, SI x2, SI y2, SI x3, SI y3) {
   array<SI> x (3), y (3);
@@ -532,8 +553,8 @@ picture_renderer (picture p, double zoomf) {
 }
 
 picture
-load_picture (url u, int w, int h, tree eff, int pixel) {
-  (void) u; (void) w; (void) h; (void) eff; (void) pixel;
+load_picture (url u, int w, int h, tree eff, int pixel, bool async) {
+  (void) u; (void) w; (void) h; (void) eff; (void) pixel; (void) async;
   FAILED ("not yet implemented");
   return picture ();
 }
@@ -99,6 +99,7 @@ public:
 
   /* drawing */
   virtual void draw (int char_code, font_glyphs fn, SI x, SI y) = 0;
+  virtual void draw_characters (int* cs, SI* xs, int n, font_glyphs fn, SI y);
   virtual void line (SI x1, SI y1, SI x2, SI y2) = 0;
   virtual void lines (array<SI> x, array<SI> y) = 0;
   virtual void clear (SI x1, SI y1, SI x2, SI y2) = 0;
@@ -133,6 +134,8 @@ public:
   virtual void get_extents (int& w, int& h);
   virtual void set_page_nr (int nr);
   virtual void next_page ();
+  virtual bool is_incremental ();
+  virtual bool reuse_page (string checksum);
   virtual void anchor (string label, SI x1, SI y1, SI x2, SI y2);
   virtual void href (string label, SI x1, SI y1, SI x2, SI y2);
   virtual void toc_entry (string kind, string title, SI x, SI y);
@@ -84,21 +84,59 @@ triangulated_rep::get_extents () {
 
 void
 triangulated_rep::draw (renderer ren) {
+  // triangles outside the visible region are skipped and the brush
+  // is only changed when the color of the next triangle differs
   sort ();
+  bool first= true;
+  color cur= 0;
   for (int i=0; i<N(ts); i++) {
-    ren->set_brush (cs[i]);
-    ren->draw_triangle (as_int (ts[i][0][0]), as_int (ts[i][0][1]),
-                        as_int (ts[i][1][0]), as_int (ts[i][1][1]),
-                        as_int (ts[i][2][0]), as_int (ts[i][2][1]));
+    SI x1= as_int (ts[i][0][0]), y1= as_int (ts[i][0][1]);
+    SI x2= as_int (ts[i][1][0]), y2= as_int (ts[i][1][1]);
+    SI x3= as_int (ts[i][2][0]), y3= as_int (ts[i][2][1]);
+    if (!ren->is_visible (min (x1, min (x2, x3)), min (y1, min (y2, y3)),
+                          max (x1, max (x2, x3)), max (y1, max (y2, y3))))
+      continue;
+    if (first || cs[i] != cur) {
+      ren->set_brush (cs[i]);
+      cur= cs[i];
+      first= false;
+    }
+    ren->draw_triangle (x1, y1, x2, y2, x3, y3);
   }
 }
 
+static inline point
+projective_apply_3 (double* m, point p) {
+  // projective transformation of a 3D point by a 4x4 matrix
+  double w= m[12] * p[0] + m[13] * p[1] + m[14] * p[2] + m[15];
+  point r (3);
+  for (int k=0; k<3; k++)
+    r[k]= (m[4*k] * p[0] + m[4*k+1] * p[1] + m[4*k+2] * p[2] + m[4*k+3]) / w;
+  return r;
+}
+
 spacial
 triangulated_rep::transform (matrix<double> m) {
   array<triangle> ts2 (N(ts));
-  for (int i=0; i<N(ts); i++)
-    ts2[i]= projective_apply (m, ts[i]);
-  return triangulated (ts2, cs);  
+  if (NR (m) != 4 || NC (m) != 4) {
+    for (int i=0; i<N(ts); i++)
+      ts2[i]= projective_apply (m, ts[i]);
+    return triangulated (ts2, cs);
+  }
+  // avoid the generic matrix products for the usual 3D case
+  double a[16];
+  for (int r=0; r<4; r++)
+    for (int c=0; c<4; c++)
+      a[4*r+c]= m (r, c);
+  for (int i=0; i<N(ts); i++) {
+    int n= N(ts[i]);
+    ts2[i]= triangle (n);
+    for (int j=0; j<n; j++) {
+      ASSERT (N(ts[i][j]) == 3, "dimensions don't match");
+      ts2[i][j]= projective_apply_3 (a, ts[i][j]);
+    }
+  }
+  return triangulated (ts2, cs);
 }
 
 /******************************************************************************
@@ -21,11 +21,17 @@
 * General routines
 ******************************************************************************/
 
+#define RECTIFY_REUSE 4.0
+
 array<point>
 curve_rep::rectify (double eps) {
+  if (rect_eps > 0.0 && rect_eps <= eps && eps <= RECTIFY_REUSE * rect_eps)
+    return rect_pts;
   array<point> a (1);
   a[0]= evaluate (0.0);
   rectify_cumul (a, eps);
+  rect_eps= eps;
+  rect_pts= a;
   return a;
 }
 
@@ -14,8 +14,10 @@
 #include "point.hpp"
 
 class curve_rep: public abstract_struct {
+  double rect_eps;        // precision of the cached rectification
+  array<point> rect_pts;  // the cached rectification
 public:
-  inline curve_rep () {}
+  inline curve_rep (): rect_eps (0.0) {}
   inline virtual ~curve_rep () {}
 
   inline virtual int nr_components () { return 1; }
@@ -28,7 +30,9 @@ public:
 
   array<point> rectify (double eps);
   // returns a rectification of the curve, which, modulo reparameterization
-  // has a uniform distance of at most 'eps' to the original curve
+  // has a uniform distance of at most 'eps' to the original curve;
+  // curves being immutable, the last rectification is cached and reused
+  // for coarser precisions which remain close to the cached one
 
   virtual void rectify_cumul (array<point>& a, double eps) = 0;
   // add rectification of the curve  (except for the starting point)
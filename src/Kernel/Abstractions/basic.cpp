@@ -100,6 +100,20 @@ tree debug_messages (TUPLE);
 bool debug_lf_flag= false;
 extern bool texmacs_started;
 
+// only the most recent messages are kept; the oldest ones are dropped in
+// batches, so that heavy tracing does not make the history grow unboundedly
+#define MAX_DEBUG_MESSAGES 10000
+
+static void
+forget_old_debug_messages () {
+  int n= N(debug_messages);
+  if (n <= 2 * MAX_DEBUG_MESSAGES) return;
+  tree r (TUPLE, MAX_DEBUG_MESSAGES);
+  for (int i=0; i<MAX_DEBUG_MESSAGES; i++)
+    r[i]= debug_messages[n - MAX_DEBUG_MESSAGES + i];
+  debug_messages= r;
+}
+
 void
 debug_message_sub (string channel, string msg) {
   if (occurs ("\n", msg)) {
@@ -119,6 +133,7 @@ debug_message_sub (string channel, string msg) {
     }
     else {
       debug_messages << tuple (channel, msg, "");
+      forget_old_debug_messages ();
       debug_lf_flag= false;
       if (channel != "debug-boot") {
         cout << "TeXmacs] ";
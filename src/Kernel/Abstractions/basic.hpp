@@ -13,6 +13,7 @@
 #define BASIC_H
 #include "fast_alloc.hpp"
 #include <math.h>
+#include <utility>
 
 #ifdef HAVE_INTPTR_T
 #ifdef HAVE_INTTYPES_H
@@ -187,69 +188,107 @@ struct abstract_struct {
 * indirect structures
 ******************************************************************************/
 
-#define INC_COUNT(R) { (R)->ref_count++; }
-#define DEC_COUNT(R) { if(0==--((R)->ref_count)) { tm_delete (R);}}
+// With ATOMIC_REF_COUNT, reference counts are updated atomically,
+// so that trees, strings and arrays can be shared between threads
+#ifdef ATOMIC_REF_COUNT
+#define REF_INC(c) __atomic_add_fetch (&(c), 1, __ATOMIC_RELAXED)
+#define REF_DEC(c) __atomic_sub_fetch (&(c), 1, __ATOMIC_ACQ_REL)
+#else
+#define REF_INC(c) (++(c))
+#define REF_DEC(c) (--(c))
+#endif
+
+#define INC_COUNT(R) { REF_INC ((R)->ref_count); }
+#define DEC_COUNT(R) { if(0==REF_DEC ((R)->ref_count)) { tm_delete (R);}}
 //#define DEC_COUNT(R) { if(0==--((R)->ref_count)) { tm_delete (R); R=NULL;}}
-#define INC_COUNT_NULL(R) { if ((R)!=NULL) (R)->ref_count++; }
+#define INC_COUNT_NULL(R) { if ((R)!=NULL) REF_INC ((R)->ref_count); }
 /*#define DEC_COUNT_NULL(R) \
   { if ((R)!=NULL && 0==--((R)->ref_count)) { tm_delete (R); } } */
 #define DEC_COUNT_NULL(R) \
-  { if ((R)!=NULL && 0==--((R)->ref_count)) { tm_delete (R); R=NULL;} }
+  { if ((R)!=NULL && 0==REF_DEC ((R)->ref_count)) { tm_delete (R); R=NULL;} }
 
 // concrete
-#define CONCRETE(PTR)               \
-  PTR##_rep *rep;                   \
-public:                             \
-  inline PTR (const PTR&);          \
-  inline ~PTR ();                   \
-  inline PTR##_rep* operator -> (); \
-  inline PTR& operator = (PTR x)
-#define CONCRETE_CODE(PTR)                       \
-  inline PTR::PTR (const PTR& x):                \
-    rep(x.rep) { INC_COUNT (this->rep); }        \
-  inline PTR::~PTR () { DEC_COUNT (this->rep); } \
-  inline PTR##_rep* PTR::operator -> () {        \
-    return rep; }                                \
-  inline PTR& PTR::operator = (PTR x) {          \
-    INC_COUNT (x.rep); DEC_COUNT (this->rep);    \
-    this->rep=x.rep; return *this; }
+//   handles may be moved; a moved-from handle has a NULL rep and
+//   may only be destroyed or assigned to
+#define CONCRETE(PTR)                     \
+  PTR##_rep *rep;                         \
+public:                                   \
+  inline PTR (const PTR&);                \
+  inline PTR (PTR&&);                     \
+  inline ~PTR ();                         \
+  inline PTR##_rep* operator -> ();       \
+  inline PTR& operator = (const PTR& x);  \
+  inline PTR& operator = (PTR&& x)
+#define CONCRETE_CODE(PTR)                            \
+  inline PTR::PTR (const PTR& x):                     \
+    rep(x.rep) { INC_COUNT (this->rep); }             \
+  inline PTR::PTR (PTR&& x):                          \
+    rep(x.rep) { x.rep= NULL; }                       \
+  inline PTR::~PTR () { DEC_COUNT_NULL (this->rep); } \
+  inline PTR##_rep* PTR::operator -> () {             \
+    return rep; }                                     \
+  inline PTR& PTR::operator = (const PTR& x) {        \
+    PTR##_rep* r= x.rep; INC_COUNT (r);               \
+    DEC_COUNT_NULL (this->rep);                       \
+    this->rep= r; return *this; }                     \
+  inline PTR& PTR::operator = (PTR&& x) {             \
+    PTR##_rep* r= this->rep; this->rep= x.rep;        \
+    x.rep= r; return *this; }
 
 // definition for 1 parameter template classes
-#define CONCRETE_TEMPLATE(PTR,T)      \
-  PTR##_rep<T> *rep;                  \
-public:                               \
-  inline PTR (const PTR<T>&);         \
-  inline ~PTR ();                     \
-  inline PTR##_rep<T>* operator -> (); \
-  inline PTR<T>& operator = (PTR<T> x)
-#define CONCRETE_TEMPLATE_CODE(PTR,TT,T)                          \
-  template<TT T> inline PTR<T>::PTR (const PTR<T>& x):            \
-    rep(x.rep) { INC_COUNT (this->rep); }                         \
-  template<TT T> inline PTR<T>::~PTR() { DEC_COUNT (this->rep); } \
-  template<TT T> inline PTR##_rep<T>* PTR<T>::operator -> () {    \
-    return this->rep; }                                           \
-  template<TT T> inline PTR<T>& PTR<T>::operator = (PTR<T> x) {   \
-    INC_COUNT (x.rep); DEC_COUNT (this->rep);                     \
-    this->rep=x.rep; return *this; }
+#define CONCRETE_TEMPLATE(PTR,T)              \
+  PTR##_rep<T> *rep;                          \
+public:                                       \
+  inline PTR (const PTR<T>&);                 \
+  inline PTR (PTR<T>&&);                      \
+  inline ~PTR ();                             \
+  inline PTR##_rep<T>* operator -> ();        \
+  inline PTR<T>& operator = (const PTR<T>& x); \
+  inline PTR<T>& operator = (PTR<T>&& x)
+#define CONCRETE_TEMPLATE_CODE(PTR,TT,T)                               \
+  template<TT T> inline PTR<T>::PTR (const PTR<T>& x):                 \
+    rep(x.rep) { INC_COUNT (this->rep); }                              \
+  template<TT T> inline PTR<T>::PTR (PTR<T>&& x):                      \
+    rep(x.rep) { x.rep= NULL; }                                        \
+  template<TT T> inline PTR<T>::~PTR() { DEC_COUNT_NULL (this->rep); } \
+  template<TT T> inline PTR##_rep<T>* PTR<T>::operator -> () {         \
+    return this->rep; }                                                \
+  template<TT T> inline PTR<T>& PTR<T>::operator = (const PTR<T>& x) { \
+    PTR##_rep<T>* r= x.rep; INC_COUNT (r);                             \
+    DEC_COUNT_NULL (this->rep);                                        \
+    this->rep= r; return *this; }                                      \
+  template<TT T> inline PTR<T>& PTR<T>::operator = (PTR<T>&& x) {      \
+    PTR##_rep<T>* r= this->rep; this->rep= x.rep;                      \
+    x.rep= r; return *this; }
 
 // definition for 2 parameter template classes
-#define CONCRETE_TEMPLATE_2(PTR,T1,T2)     \
-  PTR##_rep<T1,T2> *rep;                   \
-public:                                    \
-  inline PTR (const PTR<T1,T2>&);          \
-  inline ~PTR ();                          \
-  inline PTR##_rep<T1,T2>* operator -> (); \
-  inline PTR<T1,T2>& operator = (PTR<T1,T2> x)
+#define CONCRETE_TEMPLATE_2(PTR,T1,T2)                  \
+  PTR##_rep<T1,T2> *rep;                                \
+public:                                                 \
+  inline PTR (const PTR<T1,T2>&);                       \
+  inline PTR (PTR<T1,T2>&&);                            \
+  inline ~PTR ();                                       \
+  inline PTR##_rep<T1,T2>* operator -> ();              \
+  inline PTR<T1,T2>& operator = (const PTR<T1,T2>& x);  \
+  inline PTR<T1,T2>& operator = (PTR<T1,T2>&& x)
 #define CONCRETE_TEMPLATE_2_CODE(PTR,TT1,T1,TT2,T2)                           \
   template<TT1 T1,TT2 T2> inline PTR<T1,T2>::PTR (const PTR<T1,T2>& x):       \
     rep(x.rep) { INC_COUNT (this->rep); }                                     \
-  template<TT1 T1,TT2 T2> inline PTR<T1,T2>::~PTR () { DEC_COUNT(this->rep);} \
+  template<TT1 T1,TT2 T2> inline PTR<T1,T2>::PTR (PTR<T1,T2>&& x):            \
+    rep(x.rep) { x.rep= NULL; }                                               \
+  template<TT1 T1,TT2 T2> inline PTR<T1,T2>::~PTR () {                        \
+    DEC_COUNT_NULL (this->rep); }                                             \
   template<TT1 T1,TT2 T2> inline PTR##_rep<T1,T2>* PTR<T1,T2>::operator -> () \
     { return this->rep; }                                                     \
   template <TT1 T1,TT2 T2>                                                    \
-  inline PTR<T1,T2>& PTR<T1,T2>::operator = (PTR<T1,T2> x) {                  \
-    INC_COUNT (x.rep); DEC_COUNT (this->rep);                                 \
-    this->rep=x.rep; return *this; }
+  inline PTR<T1,T2>& PTR<T1,T2>::operator = (const PTR<T1,T2>& x) {           \
+    PTR##_rep<T1,T2>* r= x.rep; INC_COUNT (r);                                \
+    DEC_COUNT_NULL (this->rep);                                               \
+    this->rep= r; return *this; }                                             \
+  template <TT1 T1,TT2 T2>                                                    \
+  inline PTR<T1,T2>& PTR<T1,T2>::operator = (PTR<T1,T2>&& x) {                \
+    PTR##_rep<T1,T2>* r= this->rep; this->rep= x.rep;                         \
+    x.rep= r; return *this; }
 // end concrete
 
 // abstract
@@ -284,9 +323,15 @@ public:                                    \
   inline PTR::~PTR() { DEC_COUNT_NULL (this->rep); }    \
   inline PTR##_rep* PTR::operator -> () {               \
     return this->rep; }                                 \
-  inline PTR& PTR::operator = (PTR x) {                 \
-    INC_COUNT_NULL (x.rep); DEC_COUNT_NULL (this->rep); \
-    this->rep=x.rep; return *this; }                    \
+  inline PTR::PTR (PTR&& x):                            \
+    rep(x.rep) { x.rep= NULL; }                         \
+  inline PTR& PTR::operator = (const PTR& x) {          \
+    PTR##_rep* r= x.rep; INC_COUNT_NULL (r);            \
+    DEC_COUNT_NULL (this->rep);                         \
+    this->rep= r; return *this; }                       \
+  inline PTR& PTR::operator = (PTR&& x) {               \
+    PTR##_rep* r= this->rep; this->rep= x.rep;          \
+    x.rep= r; return *this; }                           \
   inline bool is_nil (PTR x) { return x.rep==NULL; }
 #define CONCRETE_NULL_TEMPLATE(PTR,T) \
   CONCRETE_TEMPLATE(PTR,T);           \
@@ -299,9 +344,15 @@ public:                                    \
   template<TT T> inline PTR<T>::~PTR () { DEC_COUNT_NULL (this->rep); } \
   template<TT T> inline PTR##_rep<T>* PTR<T>::operator -> () {          \
     return this->rep; }                                                 \
-  template<TT T> inline PTR<T>& PTR<T>::operator = (PTR<T> x) {         \
-    INC_COUNT_NULL (x.rep); DEC_COUNT_NULL (this->rep);                 \
-    this->rep=x.rep; return *this; }                                    \
+  template<TT T> inline PTR<T>::PTR (PTR<T>&& x):                      \
+    rep(x.rep) { x.rep= NULL; }                                         \
+  template<TT T> inline PTR<T>& PTR<T>::operator = (const PTR<T>& x) {  \
+    PTR##_rep<T>* r= x.rep; INC_COUNT_NULL (r);                         \
+    DEC_COUNT_NULL (this->rep);                                         \
+    this->rep= r; return *this; }                                       \
+  template<TT T> inline PTR<T>& PTR<T>::operator = (PTR<T>&& x) {       \
+    PTR##_rep<T>* r= this->rep; this->rep= x.rep;                       \
+    x.rep= r; return *this; }                                           \
   template<TT T> inline bool is_nil (PTR<T> x) { return x.rep==NULL; }
 
 #define CONCRETE_NULL_TEMPLATE_2(PTR,T1,T2) \
@@ -316,10 +367,17 @@ public:                                    \
     DEC_COUNT_NULL (this->rep); }                                         \
   template<TT1 T1, TT2 T2> PTR##_rep<T1,T2>* PTR<T1,T2>::operator -> () { \
     return this->rep; }                                                   \
+  template<TT1 T1, TT2 T2> inline PTR<T1,T2>::PTR (PTR<T1,T2>&& x):       \
+    rep(x.rep) { x.rep= NULL; }                                           \
+  template<TT1 T1, TT2 T2>                                                \
+  inline PTR<T1,T2>& PTR<T1,T2>::operator = (const PTR<T1,T2>& x) {       \
+    PTR##_rep<T1,T2>* r= x.rep; INC_COUNT_NULL (r);                       \
+    DEC_COUNT_NULL (this->rep);                                           \
+    this->rep= r; return *this; }                                         \
   template<TT1 T1, TT2 T2>                                                \
-  inline PTR<T1,T2>& PTR<T1,T2>::operator = (PTR<T1,T2> x) {              \
-    INC_COUNT_NULL (x.rep); DEC_COUNT_NULL (this->rep);                   \
-    this->rep=x.rep; return *this; }                                      \
+  inline PTR<T1,T2>& PTR<T1,T2>::operator = (PTR<T1,T2>&& x) {            \
+    PTR##_rep<T1,T2>* r= this->rep; this->rep= x.rep;                     \
+    x.rep= r; return *this; }                                             \
   template<TT1 T1, TT2 T2> inline bool is_nil (PTR<T1,T2> x) {               \
     return x.rep==NULL; }
 // end concrete_null
@@ -138,7 +138,7 @@ raw_insert (tree& ref, int pos, tree t) {
   if (!is_nil (ref->obs))
     ref->obs->announce (ref, mod);
   if (is_atomic (ref) && is_atomic (t))
-    ref->label= ref->label (0, pos) *t->label* ref->label (pos, N(ref->label));
+    insert (ref->label, pos, t->label);
   else {
     int i, n= N(ref), nr= N(t);
     AR(ref)->resize (n+nr);
@@ -177,7 +177,7 @@ raw_remove (tree& ref, int pos, int nr) {
   }
 
   if (is_atomic (ref))
-    ref->label= ref->label (0, pos) * ref->label (pos+nr, N(ref->label));
+    remove (ref->label, pos, nr);
   else {
     int i, n= N(ref)-nr;
     for (i=pos; i<n; i++)
@@ -388,6 +388,7 @@ busy_tree (tree& ref) {
 
 void
 apply (tree& ref, modification mod) {
+  MEM_TAG_SCOPE (MEM_TREES);
   if (!is_applicable (ref, mod)) {
     failed_error << "mod= " << mod << "\n";
     failed_error << "ref= " << ref << "\n";
@@ -746,3 +747,23 @@ bool
 observer_rep::get_highlight (int lan, array<int>& cols) {
   (void) lan; (void) cols; return false;
 }
+
+bool
+observer_rep::get_signature (DN& sig) {
+  (void) sig; return false;
+}
+
+bool
+observer_rep::get_content_hash (DN& h1, DN& h2) {
+  (void) h1; (void) h2; return false;
+}
+
+bool
+observer_rep::get_line_states (array<int>& states, int& valid, int& dirty) {
+  (void) states; (void) valid; (void) dirty; return false;
+}
+
+bool
+observer_rep::set_line_states (array<int> states, int valid, int dirty) {
+  (void) states; (void) valid; (void) dirty; return false;
+}
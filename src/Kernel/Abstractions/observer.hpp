@@ -33,9 +33,20 @@ typedef list<int> path;
 #define OBSERVER_UNDO       7
 #define OBSERVER_HIGHLIGHT  8
 #define OBSERVER_WIDGET     9
+#define OBSERVER_JOURNAL   10
+#define OBSERVER_SIGNATURE 11
+#define OBSERVER_LINES     12
+#define OBSERVER_SNAPSHOT  13
+#define OBSERVER_HASH      14
 
 #define ADDENDUM_PLAYER     1
 
+// the kinds of call back routines an observer is interested in
+#define OBSERVE_ANNOUNCE    1   // announce
+#define OBSERVE_DONE        2   // done and touched
+#define OBSERVE_NOTIFY      4   // notify_*
+#define OBSERVE_ALL         7
+
 /******************************************************************************
 * The observer class
 ******************************************************************************/
@@ -43,7 +54,10 @@ typedef list<int> path;
 extern int observer_count;
 class observer_rep: public abstract_struct {
 public:
-  inline observer_rep () { TM_DEBUG(observer_count++); }
+  int interests; // the OBSERVE_* call backs which need to be invoked
+
+  inline observer_rep (): interests (OBSERVE_ALL) {
+    TM_DEBUG(observer_count++); }
   inline virtual ~observer_rep () { TM_DEBUG(observer_count--); }
   inline virtual int get_type () { return OBSERVER_UNKNOWN; }
   inline virtual tm_ostream& print (tm_ostream& out) { return out; }
@@ -87,6 +101,10 @@ public:
   virtual bool get_contents (int kind, blackbox& bb);
   virtual bool set_highlight (int lan, int col, int start, int end);
   virtual bool get_highlight (int lan, array<int>& cols);
+  virtual bool get_signature (DN& sig);
+  virtual bool get_content_hash (DN& h1, DN& h2);
+  virtual bool get_line_states (array<int>& states, int& valid, int& dirty);
+  virtual bool set_line_states (array<int> states, int valid, int dirty);
 };
 
 class observer {
@@ -105,6 +123,8 @@ tm_ostream& operator << (tm_ostream& out, observer o);
 
 class editor_rep;
 class archiver_rep;
+class journal_rep;
+class snapshot_rep;
 
 extern observer nil_observer;
 observer ip_observer (path ip);
@@ -114,7 +134,12 @@ observer scheme_observer (tree t, string cb);
 observer tree_position (tree t, int index);
 observer edit_observer (editor_rep* ed);
 observer undo_observer (archiver_rep* arch);
+observer journal_observer (journal_rep* jour);
+observer snapshot_observer (snapshot_rep* snap);
 observer highlight_observer (int lan, array<int> cols);
+observer signature_observer (DN sig);
+observer content_hash_observer (DN h1, DN h2);
+observer line_state_observer (array<int> states, int valid, int dirty);
 
 /******************************************************************************
 * Modification routines for trees and other observer-related facilities
@@ -176,6 +201,15 @@ bool has_highlight (tree& ref, int lan);
 array<int> obtain_highlight (tree& ref, int lan);
 void detach_highlight (tree& ref, int lan);
 
+void attach_signature (tree& ref, DN sig);
+bool obtain_signature (tree& ref, DN& sig);
+
+void attach_content_hash (tree& ref, DN h1, DN h2);
+bool obtain_content_hash (tree& ref, DN& h1, DN& h2);
+
+void attach_line_states (tree& ref, array<int> states, int valid, int dirty);
+bool obtain_line_states (tree& ref, array<int>& states, int& valid, int& dirty);
+
 void stretched_print (tree t, bool ips= false, int indent= 0);
 
 #endif // defined OBSERVER_H
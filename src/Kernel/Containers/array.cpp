@@ -28,24 +28,41 @@ round_length (int n, size_t s) {
 
 template<class T>
 array_rep<T>::array_rep (int n2):
-  n(n2), a((n==0)?((T*) NULL):(tm_new_array<T> (round_length(n, sizeof (T))))) {}
+  n(n2), l(n2), a((n==0)?((T*) NULL):(tm_new_array<T> (n))) {}
+
+template<class T> void
+array_rep<T>::reserve (int m) {
+  // allocate room for m elements, without changing the length
+  if (m <= l) return;
+  T* b= tm_new_array<T> (m);
+  for (int i=0; i<n; i++) b[i]= std::move (a[i]);
+  if (l != 0) tm_delete_array (a);
+  a= b;
+  l= m;
+}
 
 template<class T> void
 array_rep<T>::resize (int m) {
-  int nn= round_length (n, sizeof (T));
-  int mm= round_length (m, sizeof (T));
-  if (mm != nn) {
-    if (mm != 0) {
-      int i, k= (m<n? m: n);
-      T* b= tm_new_array<T> (mm);
-      for (i=0; i<k; i++) b[i]= a[i];
-      if (nn != 0) tm_delete_array (a);
-      a= b;
-    }
-    else {
-      if (nn != 0) tm_delete_array (a);
-      a= NULL;
-    }
+  // the allocated length is at least doubled when growing, so that
+  // repeated appends take amortized constant time; it is only given
+  // back when the array shrinks to a quarter of it, so that alternating
+  // growth and shrinking around some length does not reallocate each time
+  if (m > l) {
+    int k= max (m, l<<1);
+    reserve (round_length (k, sizeof (T)));
+  }
+  else if (m == 0) {
+    if (l != 0) tm_delete_array (a);
+    a= NULL;
+    l= 0;
+  }
+  else if ((m<<2) <= l && l > 8) {
+    int mm= round_length (m, sizeof (T));
+    T* b= tm_new_array<T> (mm);
+    for (int i=0; i<m; i++) b[i]= std::move (a[i]);
+    tm_delete_array (a);
+    a= b;
+    l= mm;
   }
   n= m;
 }
@@ -61,35 +78,35 @@ array<T>::array (T* a, int n) {
 template<class T>
 array<T>::array (T x1, T x2) {
   rep= tm_new<array_rep<T> > (2);
-  rep->a[0]= x1;
-  rep->a[1]= x2;
+  rep->a[0]= std::move (x1);
+  rep->a[1]= std::move (x2);
 }
 
 template<class T>
 array<T>::array (T x1, T x2, T x3) {
   rep= tm_new<array_rep<T> > (3);
-  rep->a[0]= x1;
-  rep->a[1]= x2;
-  rep->a[2]= x3;
+  rep->a[0]= std::move (x1);
+  rep->a[1]= std::move (x2);
+  rep->a[2]= std::move (x3);
 }
 
 template<class T>
 array<T>::array (T x1, T x2, T x3, T x4) {
   rep= tm_new<array_rep<T> > (4);
-  rep->a[0]= x1;
-  rep->a[1]= x2;
-  rep->a[2]= x3;
-  rep->a[3]= x4;
+  rep->a[0]= std::move (x1);
+  rep->a[1]= std::move (x2);
+  rep->a[2]= std::move (x3);
+  rep->a[3]= std::move (x4);
 }
 
 template<class T>
 array<T>::array (T x1, T x2, T x3, T x4, T x5) {
   rep= tm_new<array_rep<T> > (5);
-  rep->a[0]= x1;
-  rep->a[1]= x2;
-  rep->a[2]= x3;
-  rep->a[3]= x4;
-  rep->a[4]= x5;
+  rep->a[0]= std::move (x1);
+  rep->a[1]= std::move (x2);
+  rep->a[2]= std::move (x3);
+  rep->a[3]= std::move (x4);
+  rep->a[4]= std::move (x5);
 }
 
 /******************************************************************************
@@ -130,7 +147,7 @@ operator << (tm_ostream& out, array<T> a) {
 template<class T> array<T>&
 operator << (array<T>& a, T x) {
   a->resize (N(a)+ 1);
-  a[N(a)-1]=x;
+  a[N(a)-1]= std::move (x);
   return a;
 }
 
@@ -22,13 +22,15 @@ template<class T> array<T> copy (array<T> x);
 
 template<class T> class array_rep: concrete_struct {
   int n;
+  int l;  // allocated length
   T* a;
 
 public:
-  inline array_rep (): n(0), a(NULL) {}
+  inline array_rep (): n(0), l(0), a(NULL) {}
          array_rep (int n);
-  inline ~array_rep () { if (n!=0) tm_delete_array (a); }
+  inline ~array_rep () { if (l!=0) tm_delete_array (a); }
   void resize (int n);
+  void reserve (int n);
   friend class array<T>;
   friend int N LESSGTR (array<T> a);
   friend T*  A LESSGTR (array<T> a);
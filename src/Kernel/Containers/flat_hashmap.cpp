@@ -0,0 +1,202 @@
+/******************************************************************************
+* MODULE     : flat_hashmap.cpp
+* DESCRIPTION: open addressing hashmaps with reference counting
+* COPYRIGHT  : (C) 2020  Joris van der Hoeven
+*******************************************************************************
+* This software falls under the GNU general public license version 3 or later.
+* It comes WITHOUT ANY WARRANTY WHATSOEVER. For details, see the file LICENSE
+* in the root directory or <http://www.gnu.org/licenses/gpl-3.0.html>.
+******************************************************************************/
+
+#ifndef FLAT_HASHMAP_CC
+#define FLAT_HASHMAP_CC
+#include "flat_hashmap.hpp"
+#define TMPL template<class T, class U>
+#define R flat_hashmap_rep<T,U>
+
+/******************************************************************************
+* Low level routines
+******************************************************************************/
+
+static inline int
+flat_slot (int hv, int mask) {
+  // linear probing is sensitive to clustering, so that we scramble
+  // the hash codes, which are often weak in their lower bits
+  unsigned int h= (unsigned int) hv;
+  h ^= h >> 16; h *= 0x45d9f3b; h ^= h >> 16;
+  return (int) (h & ((unsigned int) mask));
+}
+
+TMPL int
+R::find (T x, int hv) {
+  int mask= n-1, i= flat_slot (hv, mask), d= 1;
+  while (dist[i] >= d) {
+    if (dist[i] == d && code[i] == hv && key[i] == x) return i;
+    i= (i+1) & mask; d++;
+  }
+  return -1;
+}
+
+TMPL int
+R::insert (T x, int hv) {
+  // Insert a key which is known not to be present and return its slot;
+  // entries which are closer to their home slot are pushed further away
+  int mask= n-1, i= flat_slot (hv, mask), d= 1, pos= -1;
+  T k= x;
+  U v= init;
+  while (dist[i] != 0) {
+    if (dist[i] < d) {
+      int d2= dist[i]; dist[i]= d; d= d2;
+      int c2= code[i]; code[i]= hv; hv= c2;
+      T   k2= key[i] ; key[i] = k ; k = k2;
+      U   v2= im[i]  ; im[i]  = v ; v = v2;
+      if (pos < 0) pos= i;
+    }
+    i= (i+1) & mask; d++;
+  }
+  dist[i]= d; code[i]= hv; key[i]= k; im[i]= v;
+  size++;
+  return pos < 0? i: pos;
+}
+
+TMPL void
+R::remove_at (int i) {
+  // Backward shift deletion: no tombstones are needed
+  int mask= n-1, j= (i+1) & mask;
+  while (dist[j] > 1) {
+    dist[i]= dist[j] - 1; code[i]= code[j]; key[i]= key[j]; im[i]= im[j];
+    i= j; j= (j+1) & mask;
+  }
+  dist[i]= 0; key[i]= T (); im[i]= init;
+  size--;
+}
+
+/******************************************************************************
+* Routines for hashmaps
+******************************************************************************/
+
+TMPL void
+R::resize (int n2) {
+  int i, oldn= n;
+  if (n2 < 1) n2= 1;
+  while (4*size > 3*n2) n2 <<= 1;
+  int* oldd= dist;
+  int* oldc= code;
+  T*   oldk= key;
+  U*   oldi= im;
+  n= 1; while (n < n2) n <<= 1;
+  dist= tm_new_array<int> (n);
+  code= tm_new_array<int> (n);
+  key = tm_new_array<T> (n);
+  im  = tm_new_array<U> (n);
+  for (i=0; i<n; i++) dist[i]= 0;
+  size= 0;
+  for (i=0; i<oldn; i++)
+    if (oldd[i] != 0) im[insert (oldk[i], oldc[i])]= oldi[i];
+  tm_delete_array (oldd); tm_delete_array (oldc);
+  tm_delete_array (oldk); tm_delete_array (oldi);
+}
+
+TMPL bool
+R::contains (T x) {
+  return find (x, hash (x)) >= 0;
+}
+
+TMPL bool
+R::empty () {
+  return size==0;
+}
+
+TMPL U&
+R::bracket_rw (T x) {
+  int hv= hash (x);
+  int i = find (x, hv);
+  if (i >= 0) return im[i];
+  if (4*(size+1) > 3*n) resize (n<<1);
+  return im[insert (x, hv)];
+}
+
+TMPL U
+R::bracket_ro (T x) {
+  int i= find (x, hash (x));
+  if (i >= 0) return im[i];
+  return init;
+}
+
+TMPL void
+R::reset (T x) {
+  int i= find (x, hash (x));
+  if (i < 0) return;
+  remove_at (i);
+  if (n > 8 && 8*size < n) resize (n>>1);
+}
+
+TMPL void
+R::generate (void (*routine) (T)) {
+  int i;
+  for (i=0; i<n; i++)
+    if (dist[i] != 0) routine (key[i]);
+}
+
+TMPL tm_ostream&
+operator << (tm_ostream& out, flat_hashmap<T,U> h) {
+  int i= 0, j= 0, n= h->n, size= h->size;
+  out << "{ ";
+  for (; i<n; i++)
+    if (h->dist[i] != 0) {
+      out << h->key[i] << "->" << h->im[i];
+      if (j != size-1) out << ", ";
+      j++;
+    }
+  out << " }";
+  return out;
+}
+
+TMPL flat_hashmap<T,U>::operator tree () {
+  int i=0, j=0, n=rep->n, size=rep->size;
+  tree t (COLLECTION, size);
+  for (; i<n; i++)
+    if (rep->dist[i] != 0)
+      t[j++]= tree (ASSOCIATE, as_tree (rep->key[i]), as_tree (rep->im[i]));
+  return t;
+}
+
+TMPL void
+R::join (flat_hashmap<T,U> h) {
+  int i= 0, n= h->n;
+  for (; i<n; i++)
+    if (h->dist[i] != 0)
+      bracket_rw (h->key[i])= copy (h->im[i]);
+}
+
+TMPL flat_hashmap<T,U>
+copy (flat_hashmap<T,U> h) {
+  int i, n= h->n;
+  flat_hashmap<T,U> h2 (h->init, n);
+  h2->size= h->size;
+  for (i=0; i<n; i++) {
+    h2->dist[i]= h->dist[i];
+    h2->code[i]= h->code[i];
+    h2->key [i]= h->key [i];
+    h2->im  [i]= h->im  [i];
+  }
+  return h2;
+}
+
+TMPL bool
+operator == (flat_hashmap<T,U> h1, flat_hashmap<T,U> h2) {
+  if (h1->size != h2->size) return false;
+  int i= 0, n= h1->n;
+  for (; i<n; i++)
+    if (h1->dist[i] != 0 && h2[h1->key[i]] != h1->im[i]) return false;
+  return true;
+}
+
+TMPL bool
+operator != (flat_hashmap<T,U> h1, flat_hashmap<T,U> h2) {
+  return !(h1 == h2);
+}
+
+#undef R
+#undef TMPL
+#endif // defined FLAT_HASHMAP_CC
@@ -0,0 +1,98 @@
+/******************************************************************************
+* MODULE     : flat_hashmap.hpp
+* DESCRIPTION: open addressing hashmaps with reference counting
+* COPYRIGHT  : (C) 2020  Joris van der Hoeven
+*******************************************************************************
+* This software falls under the GNU general public license version 3 or later.
+* It comes WITHOUT ANY WARRANTY WHATSOEVER. For details, see the file LICENSE
+* in the root directory or <http://www.gnu.org/licenses/gpl-3.0.html>.
+******************************************************************************/
+
+#ifndef FLAT_HASHMAP_H
+#define FLAT_HASHMAP_H
+#include "hashmap.hpp"
+
+/******************************************************************************
+* The flat_hashmap class has the same interface as hashmap, but stores
+* its entries in a single array using Robin Hood linear probing.
+* Lookups therefore do not chase list cells and insertions do not
+* allocate, except when the table needs to grow.
+******************************************************************************/
+
+template<class T,class U> class flat_hashmap;
+template<class T,class U> class flat_hashmap_iterator_rep;
+
+template<class T,class U> int N (flat_hashmap<T,U> a);
+template<class T,class U> tm_ostream&
+  operator << (tm_ostream& out, flat_hashmap<T,U> h);
+template<class T,class U> flat_hashmap<T,U> copy (flat_hashmap<T,U> h);
+template<class T,class U> bool
+  operator == (flat_hashmap<T,U> h1, flat_hashmap<T,U> h2);
+template<class T,class U> bool
+  operator != (flat_hashmap<T,U> h1, flat_hashmap<T,U> h2);
+
+template<class T, class U> class flat_hashmap_rep: concrete_struct {
+  int  size;   // size of hashmap (nr of entries)
+  int  n;      // nr of slots (a power of two)
+  U    init;   // default entry
+  int* dist;   // probe distance plus one of each slot (0 for empty slots)
+  int* code;   // hash codes of the keys
+  T*   key;    // the keys
+  U*   im;     // the images
+
+  int  find (T x, int hv);
+  int  insert (T x, int hv);
+  void remove_at (int i);
+
+public:
+  inline flat_hashmap_rep<T,U> (U init2, int n2=1, int max2=1):
+    size (0), n (1), init (init2) {
+      (void) max2; // accepted for compatibility with hashmap
+      while (n < n2) n <<= 1;
+      dist= tm_new_array<int> (n);
+      code= tm_new_array<int> (n);
+      key = tm_new_array<T> (n);
+      im  = tm_new_array<U> (n);
+      for (int i=0; i<n; i++) dist[i]= 0; }
+  inline ~flat_hashmap_rep<T,U> () {
+    tm_delete_array (dist); tm_delete_array (code);
+    tm_delete_array (key); tm_delete_array (im); }
+  void resize (int n);
+  void reset (T x);
+  void generate (void (*routine) (T));
+  bool contains (T x);
+  bool empty ();
+  U    bracket_ro (T x);
+  U&   bracket_rw (T x);
+  void join (flat_hashmap<T,U> H);
+
+  friend class flat_hashmap<T,U>;
+  friend class flat_hashmap_iterator_rep<T,U>;
+  friend int N LESSGTR (flat_hashmap<T,U> h);
+  friend tm_ostream& operator << LESSGTR (tm_ostream& out,
+                                          flat_hashmap<T,U> h);
+  friend flat_hashmap<T,U> copy LESSGTR (flat_hashmap<T,U> h);
+  friend bool operator == LESSGTR (flat_hashmap<T,U> h1,
+                                   flat_hashmap<T,U> h2);
+  friend bool operator != LESSGTR (flat_hashmap<T,U> h1,
+                                   flat_hashmap<T,U> h2);
+};
+
+template<class T, class U> class flat_hashmap {
+CONCRETE_TEMPLATE_2(flat_hashmap,T,U);
+  inline flat_hashmap ():
+    rep (tm_new<flat_hashmap_rep<T,U> > (type_helper<U>::init_val (), 1, 1)) {}
+  inline flat_hashmap (U init, int n=1, int max=1):
+    rep (tm_new<flat_hashmap_rep<T,U> > (init, n, max)) {}
+  inline U  operator [] (T x) { return rep->bracket_ro (x); }
+  inline U& operator () (T x) { return rep->bracket_rw (x); }
+  operator tree ();
+};
+CONCRETE_TEMPLATE_2_CODE(flat_hashmap,class,T,class,U);
+
+template<class T, class U> inline int
+N (flat_hashmap<T,U> h) { return h->size; }
+
+#include "flat_hashmap.cpp"
+
+#endif // defined FLAT_HASHMAP_H
@@ -19,6 +19,7 @@ template<class T,class U> class hashmap;
 template<class T,class U> class rel_hashmap;
 template<class T,class U> class rel_hashmap_rep;
 template<class T,class U> class hashmap_iterator_rep;
+template<class T,class U> class hashmap_walker;
 
 template<class T,class U> int N (hashmap<T,U> a);
 template<class T,class U> tm_ostream& operator << (tm_ostream& out, hashmap<T,U> h);
@@ -80,6 +81,33 @@ public:
   friend bool operator != LESSGTR (hashmap<T,U> h1, hashmap<T,U> h2);
 };
 
+/******************************************************************************
+* Range-based iteration over the keys, as with iterate (h), but without
+* any allocation.  The hashmap must not be modified during the loop, except
+* for assigning existing entries: new entries and resets may resize the
+* underlying array of entries.
+******************************************************************************/
+
+template<class T, class U> class hashmap_walker {
+  list<hashentry<T,U> >*     a;
+  int                        n, i;
+  list_rep<hashentry<T,U> >* l;
+
+  inline void spool () {
+    while (l == NULL && i < n)
+      if ((++i) < n) l= a[i].operator -> (); }
+
+public:
+  inline hashmap_walker (list<hashentry<T,U> >* a2, int n2, int i2):
+    a (a2), n (n2), i (i2), l (i2 < n2? a2[i2].operator -> (): NULL) {
+      spool (); }
+  inline T& operator * () { return l->item.key; }
+  inline hashmap_walker<T,U>& operator ++ () {
+    l= l->next.operator -> (); spool (); return *this; }
+  inline bool operator != (const hashmap_walker<T,U>& w) const {
+    return i != w.i || l != w.l; }
+};
+
 template<class T, class U> class hashmap {
 CONCRETE_TEMPLATE_2(hashmap,T,U);
   static hashmap<T,U> init;
@@ -93,6 +121,10 @@ CONCRETE_TEMPLATE_2(hashmap,T,U);
   inline U  operator [] (T x) { return rep->bracket_ro (x); }
   inline U& operator () (T x) { return rep->bracket_rw (x); }
   operator tree ();
+  inline hashmap_walker<T,U> begin () {
+    return hashmap_walker<T,U> (rep->a, rep->n, 0); }
+  inline hashmap_walker<T,U> end () {
+    return hashmap_walker<T,U> (rep->a, rep->n, rep->n); }
 };
 CONCRETE_TEMPLATE_2_CODE(hashmap,class,T,class,U);
 
@@ -15,6 +15,7 @@
 
 template<class T> class hashset;
 template<class T> class hashset_iterator_rep;
+template<class T> class hashset_walker;
 template<class T> int N (hashset<T> h);
 template<class T> tm_ostream& operator << (tm_ostream& out, hashset<T> h);
 template<class T> bool operator <= (hashset<T> h1, hashset<T> h2);
@@ -46,11 +47,41 @@ public:
   friend class hashset_iterator_rep<T>;
 };
 
+/******************************************************************************
+* Range-based iteration over the elements; unlike iterate (h), this does
+* not allocate anything.  The hashset must not be modified during the loop:
+* insertions and removals may resize the underlying array of entries.
+******************************************************************************/
+
+template<class T> class hashset_walker {
+  list<T>*     a;
+  int          n, i;
+  list_rep<T>* l;
+
+  inline void spool () {
+    while (l == NULL && i < n)
+      if ((++i) < n) l= a[i].operator -> (); }
+
+public:
+  inline hashset_walker (list<T>* a2, int n2, int i2):
+    a (a2), n (n2), i (i2), l (i2 < n2? a2[i2].operator -> (): NULL) {
+      spool (); }
+  inline T& operator * () { return l->item; }
+  inline hashset_walker<T>& operator ++ () {
+    l= l->next.operator -> (); spool (); return *this; }
+  inline bool operator != (const hashset_walker<T>& w) const {
+    return i != w.i || l != w.l; }
+};
+
 template<class T> class hashset {
 CONCRETE_TEMPLATE(hashset,T);
   inline hashset (int n=1, int max=1):
     rep (tm_new<hashset_rep<T> > (n, max)) {}
   operator tree ();
+  inline hashset_walker<T> begin () {
+    return hashset_walker<T> (rep->a, rep->n, 0); }
+  inline hashset_walker<T> end () {
+    return hashset_walker<T> (rep->a, rep->n, rep->n); }
 };
 CONCRETE_TEMPLATE_CODE(hashset,class,T);
 
@@ -13,6 +13,7 @@
 #define ITERATOR_H
 #include "hashset.hpp"
 #include "hashmap.hpp"
+#include "flat_hashmap.hpp"
 
 extern int iterator_count;
 
@@ -34,6 +35,7 @@ ABSTRACT_TEMPLATE_CODE(iterator,class,T);
 template<class T> tm_ostream& operator << (tm_ostream& out, iterator<T> it);
 
 template<class T, class U> iterator<T> iterate (hashmap<T,U> h);
+template<class T, class U> iterator<T> iterate (flat_hashmap<T,U> h);
 template<class T> iterator<T> iterate (hashset<T> h);
 
 #include "iterator.cpp"
@@ -110,8 +110,13 @@ strong_equal (list<T> l1, list<T> l2) {
 
 template<class T> bool
 operator == (list<T> l1, list<T> l2) {
-  if (is_nil (l1) || is_nil (l2)) return (is_nil (l1) == is_nil (l2));
-  return (l1->item==l2->item) && (l1->next==l2->next);
+  list<T> *a= &l1, *b= &l2;
+  while (!is_nil (*a) && !is_nil (*b)) {
+    if (strong_equal (*a, *b)) return true;
+    if (!((*a)->item == (*b)->item)) return false;
+    a= &((*a)->next); b= &((*b)->next);
+  }
+  return is_nil (*a) == is_nil (*b);
 }
 
 template<class T> bool
@@ -138,8 +143,9 @@ operator <= (list<T> l1, list<T> l2) {
 
 template<class T> int
 N (list<T> l) {
-  if (is_nil (l)) return 0;
-  else return N (l->next) + 1;
+  int n= 0;
+  for (list<T>* p= &l; !is_nil (*p); p= &((*p)->next)) n++;
+  return n;
 }
 
 template<class T> list<T>
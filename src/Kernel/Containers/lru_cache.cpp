@@ -0,0 +1,121 @@
+/******************************************************************************
+* MODULE     : lru_cache.cpp
+* DESCRIPTION: caches with a memory budget and least recently used eviction
+* COPYRIGHT  : (C) 2020  Joris van der Hoeven
+*******************************************************************************
+* This software falls under the GNU general public license version 3 or later.
+* It comes WITHOUT ANY WARRANTY WHATSOEVER. For details, see the file LICENSE
+* in the root directory or <http://www.gnu.org/licenses/gpl-3.0.html>.
+******************************************************************************/
+
+#ifndef LRU_CACHE_CC
+#define LRU_CACHE_CC
+#include "lru_cache.hpp"
+#define TMPL template<class T, class U>
+#define R lru_cache_rep<T,U>
+#define E lru_entry<T,U>
+
+/******************************************************************************
+* The list of entries by recency
+******************************************************************************/
+
+TMPL void
+R::unlink (E* e) {
+  if (e->prev == NULL) first= e->next; else e->prev->next= e->next;
+  if (e->next == NULL) last = e->prev; else e->next->prev= e->prev;
+  e->prev= e->next= NULL;
+}
+
+TMPL void
+R::push_front (E* e) {
+  e->next= first;
+  if (first != NULL) first->prev= e;
+  first= e;
+  if (last == NULL) last= e;
+}
+
+TMPL void
+R::remove (E* e, bool evicted) {
+  unlink (e);
+  index->reset (e->key);
+  used -= e->size;
+  if (evicted) evictions++;
+  if (release != NULL) release (e->key, e->im);
+  tm_delete (e);
+}
+
+TMPL void
+R::shrink (E* keep) {
+  // the entry which was just added is kept, even if it exceeds the budget
+  while (used > budget && last != NULL && last != keep)
+    remove (last, true);
+}
+
+/******************************************************************************
+* Routines for caches
+******************************************************************************/
+
+TMPL
+R::~lru_cache_rep () {
+  E* e= first;
+  while (e != NULL) {
+    E* next= e->next;
+    tm_delete (e);
+    e= next;
+  }
+}
+
+TMPL bool
+R::contains (T x) {
+  return index->contains (x);
+}
+
+TMPL U
+R::get (T x) {
+  E* e= (E*) index[x];
+  if (e == NULL) { misses++; return init; }
+  hits++;
+  if (e != first) { unlink (e); push_front (e); }
+  return e->im;
+}
+
+TMPL void
+R::set (T x, U y, long size) {
+  E* e= (E*) index[x];
+  if (e != NULL) remove (e, false);
+  e= tm_new<E> (x, y, size);
+  index (x)= (pointer) e;
+  push_front (e);
+  used += size;
+  shrink (e);
+}
+
+TMPL void
+R::reset (T x) {
+  E* e= (E*) index[x];
+  if (e != NULL) remove (e, false);
+}
+
+TMPL void
+R::clear () {
+  while (first != NULL) remove (first, false);
+}
+
+TMPL void
+R::set_budget (long b) {
+  budget= b;
+  shrink (NULL);
+}
+
+TMPL tm_ostream&
+operator << (tm_ostream& out, lru_cache<T,U> c) {
+  out << N(c) << " entries, " << (c->used >> 10) << " of "
+      << (c->budget >> 10) << " Kb, " << c->hits << " hits, "
+      << c->misses << " misses, " << c->evictions << " evictions";
+  return out;
+}
+
+#undef TMPL
+#undef R
+#undef E
+#endif // defined LRU_CACHE_CC
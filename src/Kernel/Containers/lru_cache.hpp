@@ -0,0 +1,89 @@
+/******************************************************************************
+* MODULE     : lru_cache.hpp
+* DESCRIPTION: caches with a memory budget and least recently used eviction
+* COPYRIGHT  : (C) 2020  Joris van der Hoeven
+*******************************************************************************
+* This software falls under the GNU general public license version 3 or later.
+* It comes WITHOUT ANY WARRANTY WHATSOEVER. For details, see the file LICENSE
+* in the root directory or <http://www.gnu.org/licenses/gpl-3.0.html>.
+******************************************************************************/
+
+#ifndef LRU_CACHE_H
+#define LRU_CACHE_H
+#include "hashmap.hpp"
+
+/******************************************************************************
+* An lru_cache associates images to keys, like a hashmap, together with
+* the number of bytes taken by each image. When the total size exceeds
+* the budget, the least recently used entries are evicted. The optional
+* release routine is called for entries which are evicted or removed,
+* but not when the cache itself is destroyed, so that it may free
+* resources which are not reference counted, such as X pixmaps.
+* The cache counts its hits, misses and evictions.
+******************************************************************************/
+
+template<class T,class U> class lru_cache;
+template<class T,class U> int N (lru_cache<T,U> c);
+template<class T,class U> tm_ostream&
+  operator << (tm_ostream& out, lru_cache<T,U> c);
+
+template<class T, class U> struct lru_entry {
+  T          key;
+  U          im;
+  long       size;
+  lru_entry* prev;  // more recently used entry
+  lru_entry* next;  // less recently used entry
+  lru_entry (T key2, U im2, long size2):
+    key (key2), im (im2), size (size2), prev (NULL), next (NULL) {}
+};
+
+template<class T, class U> class lru_cache_rep: concrete_struct {
+  hashmap<T,pointer> index;   // the entries by key
+  lru_entry<T,U>*    first;   // most recently used entry
+  lru_entry<T,U>*    last;    // least recently used entry
+  U    init;                  // default image
+  long budget;                // maximal number of bytes
+  long used;                  // number of bytes of all entries
+  void (*release) (T, U);     // routine for evicted entries
+
+  void unlink (lru_entry<T,U>* e);
+  void push_front (lru_entry<T,U>* e);
+  void remove (lru_entry<T,U>* e, bool evicted);
+  void shrink (lru_entry<T,U>* keep);
+
+public:
+  int hits, misses, evictions;
+
+  inline lru_cache_rep<T,U> (U init2, long budget2, void (*release2) (T, U)):
+    index (NULL), first (NULL), last (NULL), init (init2),
+    budget (budget2), used (0), release (release2),
+    hits (0), misses (0), evictions (0) {}
+  ~lru_cache_rep<T,U> ();
+  bool contains (T x);
+  U    get (T x);
+  void set (T x, U y, long size);
+  void reset (T x);
+  void clear ();
+  void set_budget (long b);
+  inline long get_budget () { return budget; }
+  inline long get_used () { return used; }
+
+  friend class lru_cache<T,U>;
+  friend int N LESSGTR (lru_cache<T,U> c);
+  friend tm_ostream& operator << LESSGTR (tm_ostream& out, lru_cache<T,U> c);
+};
+
+template<class T, class U> class lru_cache {
+CONCRETE_TEMPLATE_2(lru_cache,T,U);
+  inline lru_cache (U init, long budget, void (*release) (T, U)= NULL):
+    rep (tm_new<lru_cache_rep<T,U> > (init, budget, release)) {}
+  inline U operator [] (T x) { return rep->get (x); }
+};
+CONCRETE_TEMPLATE_2_CODE(lru_cache,class,T,class,U);
+
+template<class T, class U> inline int
+N (lru_cache<T,U> c) { return N (c->index); }
+
+#include "lru_cache.cpp"
+
+#endif // defined LRU_CACHE_H
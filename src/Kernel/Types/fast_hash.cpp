@@ -0,0 +1,215 @@
+
+/******************************************************************************
+* MODULE     : fast_hash.cpp
+* DESCRIPTION: fast non cryptographic hashes of contents
+* COPYRIGHT  : (C) 2020  Joris van der Hoeven
+*******************************************************************************
+* This software falls under the GNU general public license version 3 or later.
+* It comes WITHOUT ANY WARRANTY WHATSOEVER. For details, see the file LICENSE
+* in the root directory or <http://www.gnu.org/licenses/gpl-3.0.html>.
+******************************************************************************/
+
+#include "fast_hash.hpp"
+
+#define P1 0x9E3779B185EBCA87ULL
+#define P2 0xC2B2AE3D27D4EB4FULL
+#define P3 0x165667B19E3779F9ULL
+#define P4 0x85EBCA77C2B2AE63ULL
+#define P5 0x27D4EB2F165667C5ULL
+
+#define FAST_HASH_MIN_SIZE 256
+
+/******************************************************************************
+* Hashing byte buffers
+******************************************************************************/
+
+static inline DN
+rotl (DN x, int r) {
+  return (x << r) | (x >> (64 - r));
+}
+
+static inline DN
+read32 (const unsigned char* p) {
+  // little endian, so that the hashes do not depend on the platform
+  return ((DN) p[0]) | (((DN) p[1]) << 8) |
+         (((DN) p[2]) << 16) | (((DN) p[3]) << 24);
+}
+
+static inline DN
+read64 (const unsigned char* p) {
+  return read32 (p) | (read32 (p + 4) << 32);
+}
+
+static inline DN
+fh_round (DN acc, DN in) {
+  acc += in * P2;
+  acc  = rotl (acc, 31);
+  return acc * P1;
+}
+
+static inline DN
+fh_merge (DN h, DN v) {
+  h ^= fh_round (0, v);
+  return h * P1 + P4;
+}
+
+static inline DN
+fh_mix (DN h, DN v) {
+  h ^= fh_round (0, v);
+  return rotl (h, 27) * P1 + P4;
+}
+
+static inline DN
+fh_avalanche (DN h) {
+  h ^= h >> 33; h *= P2;
+  h ^= h >> 29; h *= P3;
+  h ^= h >> 32;
+  return h;
+}
+
+DN
+fast_hash (const char* s, int n, DN seed) {
+  const unsigned char* p= (const unsigned char*) s;
+  const unsigned char* end= p + n;
+  DN h;
+  if (n >= 32) {
+    DN v1= seed + P1 + P2, v2= seed + P2, v3= seed, v4= seed - P1;
+    const unsigned char* limit= end - 32;
+    do {
+      v1= fh_round (v1, read64 (p     ));
+      v2= fh_round (v2, read64 (p +  8));
+      v3= fh_round (v3, read64 (p + 16));
+      v4= fh_round (v4, read64 (p + 24));
+      p += 32;
+    } while (p <= limit);
+    h= rotl (v1, 1) + rotl (v2, 7) + rotl (v3, 12) + rotl (v4, 18);
+    h= fh_merge (h, v1); h= fh_merge (h, v2);
+    h= fh_merge (h, v3); h= fh_merge (h, v4);
+  }
+  else h= seed + P5;
+  h += (DN) n;
+  for (; p + 8 <= end; p += 8) h= fh_mix (h, read64 (p));
+  if (p + 4 <= end) {
+    h ^= read32 (p) * P1;
+    h  = rotl (h, 23) * P2 + P3;
+    p += 4;
+  }
+  for (; p < end; p++) {
+    h ^= ((DN) *p) * P5;
+    h  = rotl (h, 11) * P1;
+  }
+  return fh_avalanche (h);
+}
+
+DN
+fast_hash (string s, DN seed) {
+  return fast_hash (&s[0], N(s), seed);
+}
+
+static string
+as_key (DN h1, DN h2) {
+  static const char* digits= "0123456789abcdef";
+  string r (32);
+  for (int i=0; i<16; i++) {
+    r[15-i]= digits[h1 & 15]; h1 >>= 4;
+    r[31-i]= digits[h2 & 15]; h2 >>= 4;
+  }
+  return r;
+}
+
+string
+fast_hash_key (string s) {
+  return as_key (fast_hash (s), fast_hash (s, FAST_HASH_SEED2));
+}
+
+/******************************************************************************
+* Hashing trees
+******************************************************************************/
+
+static DN
+label_hash (tree_label l) {
+  // the numbers of the labels depend on the version and on the session,
+  // so we rather hash their names, which are remembered
+  static array<DN> hashes;
+  if (l >= N(hashes)) {
+    int old= N(hashes);
+    hashes->resize (l + 1);
+    for (int i= old; i <= l; i++) hashes[i]= 0;
+  }
+  if (hashes[l] == 0) {
+    string name= as_string (l);
+    if (name == "?") hashes[l]= fh_mix (P5, (DN) l) | 1;
+    else hashes[l]= fast_hash (name) | 1;
+  }
+  return hashes[l];
+}
+
+static void
+tree_hash (tree t, DN& h1, DN& h2, int& size, bool attach) {
+  if (is_atomic (t)) {
+    // the halves of the keys of trees only differ by their structure
+    size= N(t->label);
+    h1= fast_hash (t->label);
+    h2= fh_avalanche (fh_mix (FAST_HASH_SEED2, h1));
+    return;
+  }
+  if (obtain_content_hash (t, h1, h2)) {
+    size= FAST_HASH_MIN_SIZE;
+    return;
+  }
+  int n= N(t);
+  DN l= label_hash (L(t));
+  DN a1= fh_mix (P5 + (DN) n, l);
+  DN a2= fh_mix (FAST_HASH_SEED2 + P5 + (DN) n, l);
+  size= 0;
+  for (int i=0; i<n; i++) {
+    DN c1, c2;
+    int sub_size;
+    tree_hash (t[i], c1, c2, sub_size, attach);
+    a1= fh_mix (a1, c1);
+    a2= fh_mix (a2, c2);
+    size += sub_size;
+  }
+  h1= fh_avalanche (a1);
+  h2= fh_avalanche (a2);
+  if (attach && size >= FAST_HASH_MIN_SIZE) attach_content_hash (t, h1, h2);
+}
+
+void
+fast_hash (tree t, DN& h1, DN& h2) {
+  int size;
+  tree_hash (t, h1, h2, size, true);
+}
+
+DN
+fast_hash_cached (tree t) {
+  DN h1, h2;
+  int size;
+  tree_hash (t, h1, h2, size, false);
+  return h1;
+}
+
+bool
+fast_unequal (tree t, tree u) {
+  // the cached hashes are only reliable for trees which are modified
+  // through the announce mechanism, such as the subtrees of documents
+  if (is_atomic (t) || is_atomic (u)) return false;
+  if (is_nil (t->obs) || is_nil (u->obs)) return false;
+  DN t1, t2, u1, u2;
+  return obtain_content_hash (t, t1, t2) && obtain_content_hash (u, u1, u2) &&
+         (t1 != u1 || t2 != u2);
+}
+
+DN
+fast_hash (tree t) {
+  DN h1, h2;
+  fast_hash (t, h1, h2);
+  return h1;
+}
+
+string
+fast_hash_key (tree t) {
+  DN h1, h2;
+  fast_hash (t, h1, h2);
+  return as_key (h1, h2);
+}
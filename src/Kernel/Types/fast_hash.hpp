@@ -0,0 +1,38 @@
+
+/******************************************************************************
+* MODULE     : fast_hash.hpp
+* DESCRIPTION: fast non cryptographic hashes of contents
+* COPYRIGHT  : (C) 2020  Joris van der Hoeven
+*******************************************************************************
+* This software falls under the GNU general public license version 3 or later.
+* It comes WITHOUT ANY WARRANTY WHATSOEVER. For details, see the file LICENSE
+* in the root directory or <http://www.gnu.org/licenses/gpl-3.0.html>.
+******************************************************************************/
+
+#ifndef FAST_HASH_H
+#define FAST_HASH_H
+#include "tree.hpp"
+
+/******************************************************************************
+* The fast hashes follow the xxHash64 algorithm.  Contrary to most hash
+* functions for the keys of hashmaps, they do not depend on the platform
+* or on the session, so that they can serve as keys of content addressed
+* caches, also on disk.  The 128 bit keys combine the hashes for two seeds.
+* The hashes of large subtrees of the edited documents are cached until
+* the subtrees are modified; they are also used for hashing trees as keys
+* of hashmaps, without caching new ones.  Caches of document subtrees may
+* use fast_unequal in order to recognize unequal trees at once.
+******************************************************************************/
+
+#define FAST_HASH_SEED2 0x5bd1e9955bd1e995ULL
+
+DN     fast_hash (const char* s, int n, DN seed= 0);
+DN     fast_hash (string s, DN seed= 0);
+DN     fast_hash (tree t);
+void   fast_hash (tree t, DN& h1, DN& h2);
+DN     fast_hash_cached (tree t);
+bool   fast_unequal (tree t, tree u);
+string fast_hash_key (string s);
+string fast_hash_key (tree t);
+
+#endif // defined FAST_HASH_H
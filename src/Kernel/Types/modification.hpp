@@ -123,6 +123,8 @@ void edit_announce (editor_rep* ed, modification mod);
 void edit_done (editor_rep* ed, modification mod);
 void edit_touch (editor_rep* ed, path p);
 void archive_announce (archiver_rep* buf, modification mod);
+void journal_announce (journal_rep* jour, modification mod);
+void snapshot_announce (snapshot_rep* snap, modification mod);
 void link_announce (observer obs, modification mod);
 
 #endif // defined MODIFICATION_H
@@ -19,8 +19,9 @@
 
 bool
 zero_path (path p) {
-  if (is_nil (p)) return true;
-  return (p->item == 0) && zero_path (p->next);
+  for (path* q= &p; !is_nil (*q); q= &((*q)->next))
+    if ((*q)->item != 0) return false;
+  return true;
 }
 
 int
@@ -91,20 +92,37 @@ path_up (path p, int times) {
   return head (p, N(p)-times);
 }
 
+/******************************************************************************
+* Comparison of paths
+*******************************************************************************
+* The comparisons below are iterative, so that they use constant stack space
+* and do not copy the tails of the paths at each level.  Since paths are
+* usually built by prefixing a common tail, we also stop as soon as
+* both paths share the same remaining tail, in which case they are equal.
+******************************************************************************/
+
 bool
 path_inf (path p1, path p2) {
-  if (is_nil (p1) || is_nil (p2)) return false;
-  if (p1->item<p2->item) return true;
-  if (p1->item>p2->item) return false;
-  return path_inf (p1->next, p2->next);
+  path *a= &p1, *b= &p2;
+  while (!is_nil (*a) && !is_nil (*b)) {
+    if (strong_equal (*a, *b)) return false;
+    if ((*a)->item < (*b)->item) return true;
+    if ((*a)->item > (*b)->item) return false;
+    a= &((*a)->next); b= &((*b)->next);
+  }
+  return false;
 }
 
 bool
 path_inf_eq (path p1, path p2) {
-  if (is_nil (p1) || is_nil (p2)) return (p1 == p2);
-  if (p1->item<p2->item) return true;
-  if (p1->item>p2->item) return false;
-  return path_inf_eq (p1->next, p2->next);
+  path *a= &p1, *b= &p2;
+  while (!is_nil (*a) && !is_nil (*b)) {
+    if (strong_equal (*a, *b)) return true;
+    if ((*a)->item < (*b)->item) return true;
+    if ((*a)->item > (*b)->item) return false;
+    a= &((*a)->next); b= &((*b)->next);
+  }
+  return is_nil (*a) && is_nil (*b);
 }
 
 bool
@@ -114,25 +132,31 @@ path_less (path p1, path p2) {
 
 bool
 path_less_eq (path p1, path p2) {
-  if (is_nil (p1) || is_nil (p2)) return p1 == p2;
-  if (is_atom (p1) || is_atom (p2)) {
-    if (is_atom (p1) && is_atom (p2)) return p1->item <= p2->item;
-    if ((p1->item == 0) && is_nil (p1->next)) return true;
-    if ((p2->item == 1) && is_nil (p2->next)) return true;
-    return false;
+  path *a= &p1, *b= &p2;
+  while (!is_nil (*a) && !is_nil (*b)) {
+    if (strong_equal (*a, *b)) return true;
+    if (is_atom (*a) || is_atom (*b)) {
+      if (is_atom (*a) && is_atom (*b)) return (*a)->item <= (*b)->item;
+      if (is_atom (*a) && (*a)->item == 0) return true;
+      if (is_atom (*b) && (*b)->item == 1) return true;
+      return false;
+    }
+    if ((*a)->item < (*b)->item) return true;
+    if ((*a)->item > (*b)->item) return false;
+    a= &((*a)->next); b= &((*b)->next);
   }
-  if (p1->item<p2->item) return true;
-  if (p1->item>p2->item) return false;
-  return path_less_eq (p1->next, p2->next);
+  return is_nil (*a) && is_nil (*b);
 }
 
 path
 operator / (path p, path q) {
-  if (is_nil (q)) return p;
-  else if (is_nil (p) || (p->item != q->item)) {
-    FAILED ("path did not start with required path"); }
-  else return p->next / q->next;
-  return path (); // NOT REACHED
+  path *a= &p, *b= &q;
+  while (!is_nil (*b)) {
+    if (is_nil (*a) || ((*a)->item != (*b)->item)) {
+      FAILED ("path did not start with required path"); }
+    a= &((*a)->next); b= &((*b)->next);
+  }
+  return *a;
 }
 
 path
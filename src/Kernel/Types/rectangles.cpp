@@ -11,6 +11,7 @@
 ******************************************************************************/
 
 #include "rectangles.hpp"
+#include "array.hpp"
 
 /******************************************************************************
 * Routines for rectangles
@@ -89,30 +90,6 @@ area (rectangle r) {
 #define min(x,y) ((x)<=(y)?(x):(y))
 #define max(x,y) ((x)<=(y)?(y):(x))
 
-void
-complement (rectangle r1, rectangle r2, rectangles& l) {
-  if (!intersect (r1, r2)) { r1 >> l; return; }
-  if (r1->x1 < r2->x1) rectangle (r1->x1, r1->y1, r2->x1, r1->y2) >> l;
-  if (r1->x2 > r2->x2) rectangle (r2->x2, r1->y1, r1->x2, r1->y2) >> l;
-  if (r1->y1 < r2->y1) rectangle (max (r1->x1, r2->x1), r1->y1,
-				  min (r1->x2, r2->x2), r2->y1) >> l;
-  if (r1->y2 > r2->y2) rectangle (max (r1->x1, r2->x1), r2->y2,
-				  min (r1->x2, r2->x2), r1->y2) >> l;
-}
-
-void
-complement (rectangles l1, rectangle r2, rectangles& l) {
-  for (; !is_nil (l1); l1= l1->next)
-    complement (l1->item, r2, l);
-}
-
-void
-intersection (rectangle r1, rectangle r2, rectangles& l) {
-  if (!intersect (r1, r2)) return;
-  rectangle (max (r1->x1, r2->x1), max (r1->y1, r2->y1),
-	     min (r1->x2, r2->x2), min (r1->y2, r2->y2)) >> l;
-}
-
 rectangle
 least_upper_bound (rectangle r1, rectangle r2) {
   return rectangle (min (r1->x1, r2->x1), min (r1->y1, r2->y1),
@@ -148,55 +125,180 @@ thicken (rectangle r, SI width, SI height) {
 }
 
 /******************************************************************************
-* Exported routines for rectangles
+* Regions
+*******************************************************************************
+* The set operations on lists of rectangles are performed on regions,
+* which are unions of horizontal bands, as in X11 or pixman.  The bands
+* are sorted by increasing y and do not overlap; each band contains a
+* sorted list of disjoint and non adjacent spans [x1, x2).  Adjacent bands
+* are merged whenever they have the same spans.  The combination of two
+* regions is therefore linear in the number of their spans.
 ******************************************************************************/
 
-rectangles
-operator - (rectangles l1, rectangles l2) {
-  rectangles a=l1;
-  for (; !is_nil (l2); l2= l2->next) {
-    rectangles b;
-    complement (a, l2->item, b);
-    a=b;
+#define REGION_OR   0
+#define REGION_AND  1
+#define REGION_DIFF 2
+
+struct region {
+  array<SI>  ys;     // y1 and y2 of each band
+  array<int> first;  // index in xs of the first span of each band, plus end
+  array<SI>  xs;     // x1 and x2 of each span
+  region () { first << 0; }
+};
+
+static void
+combine_spans (array<SI>& xs, region& a, int i, region& b, int j, int op) {
+  // combine the spans of the bands i of a and j of b, where -1 means none
+  int ia= 0, ea= 0, ib= 0, eb= 0;
+  if (i >= 0) { ia= a.first[i]; ea= a.first[i+1]; }
+  if (j >= 0) { ib= b.first[j]; eb= b.first[j+1]; }
+  bool in_a= false, in_b= false, in= false;
+  SI start= 0;
+  while (ia < ea || ib < eb) {
+    SI xa= ia < ea? a.xs[ia]: MAX_SI;
+    SI xb= ib < eb? b.xs[ib]: MAX_SI;
+    SI x = min (xa, xb);
+    if (ia < ea && xa == x) { in_a= !in_a; ia++; }
+    if (ib < eb && xb == x) { in_b= !in_b; ib++; }
+    bool now= (op == REGION_OR? (in_a || in_b):
+               op == REGION_AND? (in_a && in_b): (in_a && !in_b));
+    if (now && !in) start= x;
+    if (!now && in) xs << start << x;
+    in= now;
   }
-  return a;
 }
 
-rectangles
-operator & (rectangles l1, rectangles l2) {
-  rectangles l, lc1, lc2;
-  for (lc1= l1; !is_nil (lc1); lc1= lc1->next)
-    for (lc2= l2; !is_nil (lc2); lc2= lc2->next)
-      intersection (lc1->item, lc2->item, l);
+static void
+close_band (region& r, SI y1, SI y2, int start) {
+  // the spans of the new band were appended to r.xs from start on
+  int n= N(r.xs) - start;
+  if (n == 0) return;
+  int k= N(r.ys) >> 1;
+  if (k > 0 && r.ys[2*k-1] == y1 && r.first[k] - r.first[k-1] == n) {
+    int i, prev= r.first[k-1];
+    for (i=0; i<n; i++)
+      if (r.xs[prev+i] != r.xs[start+i]) break;
+    if (i == n) {
+      r.ys[2*k-1]= y2;
+      r.xs->resize (start);
+      return;
+    }
+  }
+  r.ys << y1 << y2;
+  r.first << N(r.xs);
+}
+
+static region
+combine (region& a, region& b, int op) {
+  region r;
+  int na= N(a.ys) >> 1, nb= N(b.ys) >> 1, i= 0, j= 0;
+  SI y= MIN_SI;
+  while (i < na || j < nb) {
+    if (op != REGION_OR && i >= na) break;
+    if (op == REGION_AND && j >= nb) break;
+    SI a1= i < na? max (a.ys[2*i], y): MAX_SI;
+    SI b1= j < nb? max (b.ys[2*j], y): MAX_SI;
+    SI top= min (a1, b1), bot;
+    bool in_a= i < na && a1 == top;
+    bool in_b= j < nb && b1 == top;
+    if (in_a && in_b) bot= min (a.ys[2*i+1], b.ys[2*j+1]);
+    else if (in_a) bot= min (a.ys[2*i+1], b1);
+    else bot= min (b.ys[2*j+1], a1);
+    int start= N(r.xs);
+    combine_spans (r.xs, a, in_a? i: -1, b, in_b? j: -1, op);
+    close_band (r, top, bot, start);
+    y= bot;
+    if (i < na && a.ys[2*i+1] <= y) i++;
+    if (j < nb && b.ys[2*j+1] <= y) j++;
+  }
+  return r;
+}
+
+static region
+as_region (array<rectangle>& a, int i1, int i2) {
+  // union of the rectangles i1 until i2 of a, by divide and conquer
+  region r;
+  if (i1 + 1 == i2) {
+    r.ys << a[i1]->y1 << a[i1]->y2;
+    r.xs << a[i1]->x1 << a[i1]->x2;
+    r.first << 2;
+  }
+  else if (i1 + 1 < i2) {
+    int m= (i1 + i2) >> 1;
+    region r1= as_region (a, i1, m);
+    region r2= as_region (a, m, i2);
+    r= combine (r1, r2, REGION_OR);
+  }
+  return r;
+}
+
+static bool
+is_banded (array<rectangle>& a) {
+  // are the rectangles the bands and spans of a region, in order?
+  for (int i=1; i<N(a); i++) {
+    rectangle r= a[i-1], s= a[i];
+    if (s->y1 == r->y1 && s->y2 == r->y2) {
+      if (s->x1 <= r->x2) return false;
+    }
+    else if (s->y1 < r->y2) return false;
+  }
+  return true;
+}
+
+static region
+as_region (rectangles l) {
+  array<rectangle> a;
+  for (; !is_nil (l); l= l->next)
+    if (l->item->x1 < l->item->x2 && l->item->y1 < l->item->y2)
+      a << l->item;
+  if (!is_banded (a)) return as_region (a, 0, N(a));
+  region r;
+  for (int i=0; i<N(a); i++) {
+    if (i == 0 || a[i]->y1 != a[i-1]->y1 || a[i]->y2 != a[i-1]->y2) {
+      if (i > 0) r.first << N(r.xs);
+      r.ys << a[i]->y1 << a[i]->y2;
+    }
+    r.xs << a[i]->x1 << a[i]->x2;
+  }
+  if (N(a) > 0) r.first << N(r.xs);
+  return r;
+}
+
+static rectangles
+as_rectangles (region& r) {
+  rectangles l;
+  for (int k= (N(r.ys) >> 1) - 1; k >= 0; k--)
+    for (int i= r.first[k+1] - 2; i >= r.first[k]; i -= 2)
+      l= rectangles (rectangle (r.xs[i], r.ys[2*k], r.xs[i+1], r.ys[2*k+1]),
+                     l);
   return l;
 }
 
-bool
-adjacent (rectangle r1, rectangle r2) {
-  return
-    (((r1->x2==r2->x1) || (r1->x1==r2->x2)) &&
-     ((r1->y1==r2->y1) && (r1->y2==r2->y2))) ||
-    (((r1->y2==r2->y1) || (r1->y1==r2->y2)) &&
-     ((r1->x1==r2->x1) && (r1->x2==r2->x2)));
+static rectangles
+combine (rectangles l1, rectangles l2, int op) {
+  region r1= as_region (l1), r2= as_region (l2);
+  region r = combine (r1, r2, op);
+  return as_rectangles (r);
 }
 
+/******************************************************************************
+* Exported routines for rectangles
+******************************************************************************/
+
 rectangles
-disjoint_union (rectangles l, rectangle r) {
-  if (is_nil (l)) return r;
-  if (adjacent (l->item, r))
-    return disjoint_union (l->next,
-			   least_upper_bound (rectangles (l->item, r)));
-  return rectangles (l->item, disjoint_union (l->next, r));
+operator - (rectangles l1, rectangles l2) {
+  if (is_nil (l2)) return l1;
+  return combine (l1, l2, REGION_DIFF);
+}
+
+rectangles
+operator & (rectangles l1, rectangles l2) {
+  return combine (l1, l2, REGION_AND);
 }
 
 rectangles
 operator | (rectangles l1, rectangles l2) {
-  rectangles l (l1-l2);
-  while (!is_nil (l2)) {
-    l = disjoint_union (l, l2->item);
-    l2= l2->next;
-  }
-  return l;
+  return combine (l1, l2, REGION_OR);
 }
 
 rectangles
@@ -242,16 +344,10 @@ correct (rectangles l) {
   return rectangles (l->item, correct (l->next));
 }
 
-rectangles
-simplify_bis (rectangles l) {
-  if (is_nil (l) || is_atom (l)) return l;
-  return simplify_bis (l->next) | rectangles (l->item);
-}
-
 rectangles
 simplify (rectangles l) {
-  if (N(l) > 25) return copy (l);
-  else return simplify_bis (l);
+  region r= as_region (l);
+  return as_rectangles (r);
 }
 
 rectangle
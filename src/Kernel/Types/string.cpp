@@ -29,21 +29,19 @@ round_length (int n) {
 }
 
 string_rep::string_rep (int n2):
-  n(n2), a ((n==0)?((char*) NULL):tm_new_array<char> (round_length(n))) {}
+  n(n2), a ((round_length(n) <= STRING_INLINE)?
+	    b: tm_new_array<char> (round_length(n))) {}
 
 void
 string_rep::resize (int m) {
   int nn= round_length (n);
   int mm= round_length (m);
-  if (mm != nn) {
-    if (mm != 0) {
-      int i, k= (m<n? m: n);
-      char* b= tm_new_array<char> (mm);
-      for (i=0; i<k; i++) b[i]= a[i];
-      if (nn != 0) tm_delete_array (a);
-      a= b;
-    }
-    else if (nn != 0) tm_delete_array (a);
+  if (mm != nn && (nn > STRING_INLINE || mm > STRING_INLINE)) {
+    int i, k= (m<n? m: n);
+    char* c= (mm <= STRING_INLINE? b: tm_new_array<char> (mm));
+    for (i=0; i<k; i++) c[i]= a[i];
+    if (a != b) tm_delete_array (a);
+    a= c;
   }
   n= m;
 }
@@ -152,6 +150,44 @@ operator << (string& a, string b) {
   return a;
 }
 
+void
+insert (string& s, int pos, string t) {
+  // the characters are moved in place when nobody else holds s;
+  // otherwise s is rebuilt by a single copy
+  int n= N(s), m= N(t);
+  if (m == 0) return;
+  if (s->ref_count == 1) {
+    s->resize (n+m);
+    char* a= s->a;
+    memmove (a+pos+m, a+pos, n-pos);
+    memcpy (a+pos, t->a, m);
+  }
+  else {
+    string r (n+m);
+    memcpy (r->a, s->a, pos);
+    memcpy (r->a+pos, t->a, m);
+    memcpy (r->a+pos+m, s->a+pos, n-pos);
+    s= r;
+  }
+}
+
+void
+remove (string& s, int pos, int nr) {
+  int n= N(s);
+  if (nr == 0) return;
+  if (s->ref_count == 1) {
+    char* a= s->a;
+    memmove (a+pos, a+pos+nr, n-pos-nr);
+    s->resize (n-nr);
+  }
+  else {
+    string r (n-nr);
+    memcpy (r->a, s->a, pos);
+    memcpy (r->a+pos, s->a+pos+nr, n-pos-nr);
+    s= r;
+  }
+}
+
 string
 operator * (string a, string b) {
   int i, n1=N(a), n2=N(b);
@@ -14,19 +14,24 @@
 #define STRING_H
 #include "basic.hpp"
 
+#define STRING_INLINE 8 // short strings are stored inside string_rep
+
 class string;
 class string_rep: concrete_struct {
   int n;
   char* a;
+  char b[STRING_INLINE];
 
 public:
-  inline string_rep (): n(0), a(NULL) {}
+  inline string_rep (): n(0), a(b) {}
          string_rep (int n);
-  inline ~string_rep () { if (n!=0) tm_delete_array (a); }
+  inline ~string_rep () { if (a!=b) tm_delete_array (a); }
   void resize (int n);
 
   friend class string;
   friend inline int N (string a);
+  friend void insert (string& s, int pos, string t);
+  friend void remove (string& s, int pos, int nr);
 };
 
 class string {
@@ -51,6 +56,8 @@ string   copy (string a);
 tm_ostream& operator << (tm_ostream& out, string a);
 string&  operator << (string& a, char);
 string&  operator << (string& a, string b);
+void     insert (string& s, int pos, string t);
+void     remove (string& s, int pos, int nr);
 string   operator * (const char* a, string b);
 string   operator * (string a, string b);
 string   operator * (string a, const char* b);
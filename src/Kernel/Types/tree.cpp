@@ -12,6 +12,8 @@
 #include "generic_tree.hpp"
 #include "drd_std.hpp"
 #include "hashset.hpp"
+#include "hashmap.hpp"
+#include "fast_hash.hpp"
 
 /******************************************************************************
 * Main routines for trees
@@ -30,66 +32,66 @@ destroy_tree_rep (tree_rep* rep) {
 tree::tree (tree_label l, tree t1):
   rep (tm_new<compound_rep> (l, array<tree> (1)))
 {
-  (static_cast<compound_rep*> (rep))->a[0]=t1;
+  (static_cast<compound_rep*> (rep))->a[0]= std::move (t1);
 }
 
 tree::tree (tree_label l, tree t1, tree t2):
   rep (tm_new<compound_rep> (l, array<tree> (2)))
 {
-  (static_cast<compound_rep*> (rep))->a[0]=t1;
-  (static_cast<compound_rep*> (rep))->a[1]=t2;
+  (static_cast<compound_rep*> (rep))->a[0]= std::move (t1);
+  (static_cast<compound_rep*> (rep))->a[1]= std::move (t2);
 }
 
 tree::tree (tree_label l, tree t1, tree t2, tree t3):
   rep (tm_new<compound_rep> (l, array<tree> (3)))
 {
-  (static_cast<compound_rep*> (rep))->a[0]=t1;
-  (static_cast<compound_rep*> (rep))->a[1]=t2;
-  (static_cast<compound_rep*> (rep))->a[2]=t3;
+  (static_cast<compound_rep*> (rep))->a[0]= std::move (t1);
+  (static_cast<compound_rep*> (rep))->a[1]= std::move (t2);
+  (static_cast<compound_rep*> (rep))->a[2]= std::move (t3);
 }
 
 tree::tree (tree_label l, tree t1, tree t2, tree t3, tree t4):
   rep (tm_new<compound_rep> (l, array<tree> (4)))
 {
-  (static_cast<compound_rep*> (rep))->a[0]=t1;
-  (static_cast<compound_rep*> (rep))->a[1]=t2;
-  (static_cast<compound_rep*> (rep))->a[2]=t3;
-  (static_cast<compound_rep*> (rep))->a[3]=t4;
+  (static_cast<compound_rep*> (rep))->a[0]= std::move (t1);
+  (static_cast<compound_rep*> (rep))->a[1]= std::move (t2);
+  (static_cast<compound_rep*> (rep))->a[2]= std::move (t3);
+  (static_cast<compound_rep*> (rep))->a[3]= std::move (t4);
 }
 
 tree::tree (tree_label l, tree t1, tree t2, tree t3, tree t4, tree t5):
   rep (tm_new<compound_rep> (l, array<tree> (5)))
 {
-  (static_cast<compound_rep*> (rep))->a[0]=t1;
-  (static_cast<compound_rep*> (rep))->a[1]=t2;
-  (static_cast<compound_rep*> (rep))->a[2]=t3;
-  (static_cast<compound_rep*> (rep))->a[3]=t4;
-  (static_cast<compound_rep*> (rep))->a[4]=t5;
+  (static_cast<compound_rep*> (rep))->a[0]= std::move (t1);
+  (static_cast<compound_rep*> (rep))->a[1]= std::move (t2);
+  (static_cast<compound_rep*> (rep))->a[2]= std::move (t3);
+  (static_cast<compound_rep*> (rep))->a[3]= std::move (t4);
+  (static_cast<compound_rep*> (rep))->a[4]= std::move (t5);
 }
 
 tree::tree (tree_label l,
 	    tree t1, tree t2, tree t3, tree t4, tree t5, tree t6):
   rep (tm_new<compound_rep> (l, array<tree> (6)))
 {
-  (static_cast<compound_rep*> (rep))->a[0]=t1;
-  (static_cast<compound_rep*> (rep))->a[1]=t2;
-  (static_cast<compound_rep*> (rep))->a[2]=t3;
-  (static_cast<compound_rep*> (rep))->a[3]=t4;
-  (static_cast<compound_rep*> (rep))->a[4]=t5;
-  (static_cast<compound_rep*> (rep))->a[5]=t6;
+  (static_cast<compound_rep*> (rep))->a[0]= std::move (t1);
+  (static_cast<compound_rep*> (rep))->a[1]= std::move (t2);
+  (static_cast<compound_rep*> (rep))->a[2]= std::move (t3);
+  (static_cast<compound_rep*> (rep))->a[3]= std::move (t4);
+  (static_cast<compound_rep*> (rep))->a[4]= std::move (t5);
+  (static_cast<compound_rep*> (rep))->a[5]= std::move (t6);
 }
 
 tree::tree (tree_label l,
 	    tree t1, tree t2, tree t3, tree t4, tree t5, tree t6, tree t7):
   rep (tm_new<compound_rep> (l, array<tree> (7)))
 {
-  (static_cast<compound_rep*> (rep))->a[0]=t1;
-  (static_cast<compound_rep*> (rep))->a[1]=t2;
-  (static_cast<compound_rep*> (rep))->a[2]=t3;
-  (static_cast<compound_rep*> (rep))->a[3]=t4;
-  (static_cast<compound_rep*> (rep))->a[4]=t5;
-  (static_cast<compound_rep*> (rep))->a[5]=t6;
-  (static_cast<compound_rep*> (rep))->a[6]=t7;
+  (static_cast<compound_rep*> (rep))->a[0]= std::move (t1);
+  (static_cast<compound_rep*> (rep))->a[1]= std::move (t2);
+  (static_cast<compound_rep*> (rep))->a[2]= std::move (t3);
+  (static_cast<compound_rep*> (rep))->a[3]= std::move (t4);
+  (static_cast<compound_rep*> (rep))->a[4]= std::move (t5);
+  (static_cast<compound_rep*> (rep))->a[5]= std::move (t6);
+  (static_cast<compound_rep*> (rep))->a[6]= std::move (t7);
 }
 
 tree::tree (tree_label l,
@@ -97,14 +99,14 @@ tree::tree (tree_label l,
 	    tree t5, tree t6, tree t7, tree t8):
   rep (tm_new<compound_rep> (l, array<tree> (8)))
 {
-  (static_cast<compound_rep*> (rep))->a[0]=t1;
-  (static_cast<compound_rep*> (rep))->a[1]=t2;
-  (static_cast<compound_rep*> (rep))->a[2]=t3;
-  (static_cast<compound_rep*> (rep))->a[3]=t4;
-  (static_cast<compound_rep*> (rep))->a[4]=t5;
-  (static_cast<compound_rep*> (rep))->a[5]=t6;
-  (static_cast<compound_rep*> (rep))->a[6]=t7;
-  (static_cast<compound_rep*> (rep))->a[7]=t8;
+  (static_cast<compound_rep*> (rep))->a[0]= std::move (t1);
+  (static_cast<compound_rep*> (rep))->a[1]= std::move (t2);
+  (static_cast<compound_rep*> (rep))->a[2]= std::move (t3);
+  (static_cast<compound_rep*> (rep))->a[3]= std::move (t4);
+  (static_cast<compound_rep*> (rep))->a[4]= std::move (t5);
+  (static_cast<compound_rep*> (rep))->a[5]= std::move (t6);
+  (static_cast<compound_rep*> (rep))->a[6]= std::move (t7);
+  (static_cast<compound_rep*> (rep))->a[7]= std::move (t8);
 }
 
 tree
@@ -154,6 +156,52 @@ freeze (tree t) {
   }
 }
 
+/******************************************************************************
+* Sharing short atomic trees
+*
+* Trees whose short atoms have been shared using share_atoms may only be
+* modified by assigning new subtrees; in particular, they should not be
+* edited in place nor be attached to observers.
+*
+* The pool of shared atoms is not protected by a lock, so that these
+* routines may only be called from the main thread.  Its size is bounded
+* by MAX_SHARED_ATOMS, beyond which new atoms are no longer shared, and
+* it should be cleared using clear_shared_atoms once the shared trees
+* are no longer needed.
+******************************************************************************/
+
+#define MAX_SHARED_ATOM 16
+#define MAX_SHARED_ATOMS 65536
+
+static hashmap<string,tree> shared_atoms (UNINIT);
+
+tree
+shared_atom (string s) {
+  if (N(s) > MAX_SHARED_ATOM) return tree (s);
+  if (N(shared_atoms) >= MAX_SHARED_ATOMS && !shared_atoms->contains (s))
+    return tree (s);
+  tree& r= shared_atoms (s);
+  if (r == UNINIT) r= tree (s);
+  return r;
+}
+
+void
+share_atoms (tree& t) {
+  if (is_atomic (t)) {
+    if (N(t->label) <= MAX_SHARED_ATOM) t= shared_atom (t->label);
+  }
+  else if (is_compound (t)) {
+    int i, n= N(t);
+    for (i=0; i<n; i++)
+      share_atoms (t[i]);
+  }
+}
+
+void
+clear_shared_atoms () {
+  shared_atoms= hashmap<string,tree> (UNINIT);
+}
+
 tree
 operator * (tree t1, tree t2) {
   int i;
@@ -219,8 +267,9 @@ hash (array<tree> a) {
 
 int
 hash (tree t) {
-  if (is_atomic (t)) return hash (t->label);
-  else return ((int) L(t)) ^ hash (A(t));
+  // the cached hashes of large subtrees of documents are used,
+  // but looking up trees in hashmaps does not cache new ones
+  return (int) fast_hash_cached (t);
 }
 
 string
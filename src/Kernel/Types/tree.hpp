@@ -33,9 +33,11 @@ class tree {
 
 public:
   inline tree (const tree& x);
+  inline tree (tree&& x);
   inline ~tree ();
   inline atomic_rep* operator -> ();
-  inline tree& operator = (tree x);
+  inline tree& operator = (const tree& x);
+  inline tree& operator = (tree&& x);
 
   inline tree ();
   inline tree (string l);
@@ -91,6 +93,8 @@ public:
   friend class tree_addendum_rep;
   friend class edit_observer_rep;
   friend class undo_observer_rep;
+  friend class journal_observer_rep;
+  friend class snapshot_observer_rep;
   friend class tree_links_rep;
   friend class link_repository_rep;
 #ifdef QTTEXMACS
@@ -117,7 +121,8 @@ public:
 class compound_rep: public tree_rep {
 public:
   array<tree> a;
-  inline compound_rep (tree_label l, array<tree> a2): tree_rep (l), a (a2) {}
+  inline compound_rep (tree_label l, array<tree> a2):
+    tree_rep (l), a (std::move (a2)) {}
   friend class tree;
 };
 
@@ -152,17 +157,24 @@ typedef tree scheme_tree;
 #endif
 
 void destroy_tree_rep (tree_rep* rep);
-inline tree::tree (tree_rep* rep2): rep (rep2) { rep->ref_count++; }
-inline tree::tree (const tree& x): rep (x.rep) { rep->ref_count++; }
+inline tree::tree (tree_rep* rep2): rep (rep2) { REF_INC (rep->ref_count); }
+inline tree::tree (const tree& x): rep (x.rep) { REF_INC (rep->ref_count); }
+inline tree::tree (tree&& x): rep (x.rep) { x.rep= NULL; }
 inline tree::~tree () {
-  if ((--rep->ref_count)==0) { destroy_tree_rep (rep); rep= NULL; } }
+  if (rep != NULL && REF_DEC (rep->ref_count)==0) {
+    destroy_tree_rep (rep); rep= NULL; } }
 inline atomic_rep* tree::operator -> () {
   CHECK_ATOMIC (*this);
   return static_cast<atomic_rep*> (rep); }
-inline tree& tree::operator = (tree x) {
-  x.rep->ref_count++;
-  if ((--rep->ref_count)==0) destroy_tree_rep (rep);
-  rep= x.rep;
+inline tree& tree::operator = (const tree& x) {
+  // x may be a subtree of the tree being replaced
+  tree_rep* r= x.rep;
+  REF_INC (r->ref_count);
+  if (rep != NULL && REF_DEC (rep->ref_count)==0) destroy_tree_rep (rep);
+  rep= r;
+  return *this; }
+inline tree& tree::operator = (tree&& x) {
+  tree_rep* r= rep; rep= x.rep; x.rep= r;
   return *this; }
 
 inline tree::tree ():
@@ -249,6 +261,9 @@ inline string as_string (tree t) {
   else return ""; }
 string tree_as_string (tree t);
 tree replace (tree t, tree w, tree b);
+tree shared_atom (string s);
+void share_atoms (tree& t);
+void clear_shared_atoms ();
 template<class T> inline tree as_tree (T x) { return (tree) x; }
 template<> inline tree as_tree (int x) { return as_string (x); }
 template<> inline tree as_tree (long int x) { return as_string (x); }
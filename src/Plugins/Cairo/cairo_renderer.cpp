@@ -255,26 +255,14 @@ cairo_renderer_rep::polygon (array<SI> x, array<SI> y, bool convex) {
 * Image rendering
 ******************************************************************************/
 
-void
-cairo_renderer_rep::image (url u, SI w, SI h, SI x, SI y, int alpha) {
-  // Given an image of original size (W, H),
-  // we display it at position (x, y) in a rectangle of size (w, h)
+#define IMAGE_CACHE_MAX 64
 
-  // if (DEBUG_EVENTS) debug_events << "cairo_renderer_rep::image " << as_string(u) << LF;
-  (void) alpha; // FIXME
-
-  w= w/pixel; h= h/pixel;
-  decode (x, y);
-  
-  //painter.setRenderHints (0);
-  //painter.drawRect (QRect (x, y-h, w, h));
-  
+static cairo_surface_t*
+load_image_surface (url u) {
   cairo_surface_t* pm = NULL;  
   if (suffix (u) == "png") {
-    // rendering
     string suu = as_string (u);
     c_string buf (suu);
-    //cout << suu << LF;
     pm = tm_cairo_image_surface_create_from_png(buf);
   }
   else if (suffix (u) == "ps" ||
@@ -284,12 +272,51 @@ cairo_renderer_rep::image (url u, SI w, SI h, SI x, SI y, int alpha) {
     system ("convert", u, temp);
     string suu = as_string (temp);
     c_string buf (suu);
-    //cout << suu << LF;
     pm = tm_cairo_image_surface_create_from_png(buf);
     remove (temp);
   }
+  if (pm != NULL && tm_cairo_image_surface_get_width (pm) == 0) {
+    // cairo returns an error surface without pixels on failure
+    tm_cairo_surface_destroy (pm);
+    pm= NULL;
+  }
+  return pm;
+}
+
+static cairo_surface_t*
+image_surface (url u) {
+  // the decoded surfaces are reused as long as the files do not change,
+  // which avoids reloading PNG files and rerunning convert at each redraw
+  string key= as_string (u) * ":" * as_string (last_modified (u));
+  cairo_image ci= images [key];
+  if (!is_nil (ci)) return ci->img;
+  cairo_surface_t* pm= load_image_surface (u);
+  if (pm == NULL) return NULL;
+  if (N(images) >= IMAGE_CACHE_MAX) images= hashmap<string,cairo_image> ();
+  int iw= tm_cairo_image_surface_get_width (pm);
+  int ih= tm_cairo_image_surface_get_height (pm);
+  cairo_image ci2 (pm, 0, 0, iw, ih);
+  tm_cairo_surface_destroy (pm); // cairo_image retains pm
+  images (key)= ci2;
+  return pm;
+}
+
+void
+cairo_renderer_rep::image (url u, SI w, SI h, SI x, SI y, int alpha) {
+  // Given an image of original size (W, H),
+  // we display it at position (x, y) in a rectangle of size (w, h)
+
+  // if (DEBUG_EVENTS) debug_events << "cairo_renderer_rep::image " << as_string(u) << LF;
+  (void) alpha; // FIXME
+
+  w= w/pixel; h= h/pixel;
+  decode (x, y);
   
-  if (pm == NULL ) {
+  //painter.setRenderHints (0);
+  //painter.drawRect (QRect (x, y-h, w, h));
+  
+  cairo_surface_t* pm= image_surface (u);
+  if (pm == NULL) {
     cout << "TeXmacs] warning: cannot render " << as_string (u) << "\n";
     return;
   }
@@ -425,20 +452,20 @@ cairo_renderer_rep::draw (int c, font_glyphs fng, SI x, SI y) {
     glyph gl= shrink (pre_gl, std_shrinkf, std_shrinkf, xo, yo);
     int i, j, w= gl->width, h= gl->height;
     cairo_surface_t *im = tm_cairo_image_surface_create(CAIRO_FORMAT_A8,w,h);
-    //FIXME: release the surface when done
     {
-      cairo_t* ic = tm_cairo_create(im);
+      // write the coverage values directly into the mask
+      // instead of filling one rectangle per pixel
       int nr_cols= std_shrinkf*std_shrinkf;
       if (nr_cols >= 64) nr_cols= 64;
-      tm_cairo_set_operator(ic, CAIRO_OPERATOR_SOURCE);
-      for (j=0; j<h; j++)
-	for (i=0; i<w; i++) {
-	  int col = gl->get_x (i, j);
-	  tm_cairo_set_source_rgba(ic, 0.0, 0.0, 0.0, ((255*col)/(nr_cols+1))/255.0);
-	  tm_cairo_rectangle(ic,i,j,1,1);
-          tm_cairo_fill(ic);
-	}
-      tm_cairo_destroy (ic);
+      tm_cairo_surface_flush (im);
+      unsigned char* data= tm_cairo_image_surface_get_data (im);
+      int stride= tm_cairo_image_surface_get_stride (im);
+      for (j=0; j<h; j++) {
+        unsigned char* row= data + j * stride;
+	for (i=0; i<w; i++)
+          row[i]= (unsigned char) ((255 * gl->get_x (i, j)) / (nr_cols+1));
+      }
+      tm_cairo_surface_mark_dirty (im);
     }
     cairo_image mi2 (im, xo, yo, w, h);
     mi = mi2;
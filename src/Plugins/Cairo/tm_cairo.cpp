@@ -60,6 +60,10 @@ static bool tm_cairo_error      = true;
  void (*tm_cairo_set_source) (cairo_t *cr, cairo_pattern_t *source);
  int (*tm_cairo_image_surface_get_height) (cairo_surface_t *surface);
  void (*tm_cairo_mask_surface) (cairo_t *cr, cairo_surface_t *surface, double surface_x, double surface_y);
+ unsigned char * (*tm_cairo_image_surface_get_data) (cairo_surface_t *surface);
+ int (*tm_cairo_image_surface_get_stride) (cairo_surface_t *surface);
+ void (*tm_cairo_surface_flush) (cairo_surface_t *surface);
+ void (*tm_cairo_surface_mark_dirty) (cairo_surface_t *surface);
 
 
 #ifdef CAIRO_HAS_FT_FONT
@@ -135,6 +139,10 @@ tm_cairo_initialize () {
   CAIRO_LINK(cairo_set_source, tm_cairo_set_source);
   CAIRO_LINK(cairo_image_surface_get_height, tm_cairo_image_surface_get_height);
   CAIRO_LINK(cairo_mask_surface, tm_cairo_mask_surface);
+  CAIRO_LINK(cairo_image_surface_get_data, tm_cairo_image_surface_get_data);
+  CAIRO_LINK(cairo_image_surface_get_stride, tm_cairo_image_surface_get_stride);
+  CAIRO_LINK(cairo_surface_flush, tm_cairo_surface_flush);
+  CAIRO_LINK(cairo_surface_mark_dirty, tm_cairo_surface_mark_dirty);
 
 #ifdef CAIRO_HAS_FT_FONT
   CAIRO_LINK(cairo_ft_font_face_create_for_ft_face, tm_cairo_ft_font_face_create_for_ft_face);
@@ -81,6 +81,10 @@ extern void (*tm_cairo_save) (cairo_t *cr);
 extern void (*tm_cairo_set_source) (cairo_t *cr, cairo_pattern_t *source);
 extern int (*tm_cairo_image_surface_get_height) (cairo_surface_t *surface);
 extern void (*tm_cairo_mask_surface) (cairo_t *cr, cairo_surface_t *surface, double surface_x, double surface_y);
+extern unsigned char * (*tm_cairo_image_surface_get_data) (cairo_surface_t *surface);
+extern int (*tm_cairo_image_surface_get_stride) (cairo_surface_t *surface);
+extern void (*tm_cairo_surface_flush) (cairo_surface_t *surface);
+extern void (*tm_cairo_surface_mark_dirty) (cairo_surface_t *surface);
 
 #ifdef CAIRO_HAS_FT_FONT
 extern cairo_font_face_t * (*tm_cairo_ft_font_face_create_for_ft_face) (FT_Face face, int load_flags);
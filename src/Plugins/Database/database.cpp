@@ -36,7 +36,8 @@ database_rep::database_rep (url u, bool clone):
   start_pending (0), time_stamp (0),
   key_encode (-1), key_decode (),
   atom_indexed (), key_occurrences (),
-  key_completions (), name_completions ()
+  key_completions (), name_completions (),
+  pending_index (), pending_names (), encoded ()
 {
   if (is_none (db_name)) error_flag= false;
   else if (!clone) initialize ();
@@ -78,8 +79,8 @@ database_rep::extend_field (db_atom id, db_atom attr, db_atom val, db_time t) {
     ids_list << id;
   }
   string dec= atom_decode[attr];
-  if (dec != "contributor") indexate (val);
-  if (dec == "name") indexate_name (val);
+  if (dec != "contributor" && !atom_indexed[val]) pending_index << val;
+  if (dec == "name" && !name_indexed[val]) pending_names << val;
   //cout << "l. " << nr << ":\t" << id << ", " << attr << ", " << val << LF;
   //cout << "l. " << nr << ":\t" << from_atom (id) << ", " << from_atom (attr) << ", " << from_atom (val) << LF;
   return nr;
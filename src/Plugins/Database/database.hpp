@@ -86,6 +86,9 @@ private:
   array<db_atoms> key_occurrences;
   hashmap<string,db_keys> key_completions;
   hashmap<string,db_atoms> name_completions;
+  db_atoms pending_index;
+  db_atoms pending_names;
+  hashmap<tree,db_constraint> encoded;
 
 public:
   bool atom_exists (string s);
@@ -105,6 +108,7 @@ private:
   bool id_satisfies (db_atom id, db_constraints cs, db_time t);
   db_constraint encode_constraint (tree q);
   db_constraints encode_constraints (tree q);
+  void plan_constraints (db_constraints& cs);
   db_atoms filter (db_atoms ids, tree qt, db_time t, int limit);
   int compute_complexity (tree q);
   int ansatz_index (tree q);
@@ -120,6 +124,7 @@ private:
   database compress ();
   void initialize ();
   void purge ();
+  bool update_from_disk ();
 
 private:
   db_key as_key (string s);
@@ -127,6 +132,7 @@ private:
   void add_completed_as (db_key k);
   void indexate (db_atom val);
   void indexate_name (db_atom val);
+  void flush_index ();
   db_constraint encode_keywords_constraint (tree q);
   strings compute_completions (string s);
   strings compute_name_completions (string s);
@@ -134,7 +140,7 @@ private:
 
 private:
   array<strings> build_sort_tuples (db_atoms ids, db_atoms attrs, db_time t);
-  db_atoms sort_results (db_atoms ids, tree q, db_time t);
+  db_atoms sort_results (db_atoms ids, tree q, db_time t, int limit);
 
 public:
   database_rep (url u, bool clone= false);
@@ -11,6 +11,7 @@
 
 #include "Database/database.hpp"
 #include "file.hpp"
+#include "analyze.hpp"
 
 #define DB_CREATE_ATOM   1
 #define DB_CREATE_FIELD  2
@@ -20,57 +21,6 @@
 #define random rand
 #endif
 
-/******************************************************************************
-* Marshalling and unmarshalling
-******************************************************************************/
-
-inline int
-get_byte_length (unsigned long int i) {
-  int l= 0;
-  while (i != 0) { l++; i >>= 8; }
-  return l;
-}
-
-static void
-marshall_number (string& s, unsigned long int i) {
-  if (i < 248) s << ((char) ((unsigned char) (i + 8)));
-  else {
-    s << ((char) get_byte_length (i));
-    while (i != 0) {
-      s << ((char) ((unsigned char) (i & 0xff)));
-      i >>= 8;
-    }
-  }
-}
-
-static unsigned long int
-unmarshall_number (string s, int& pos) {
-  int n= (int) ((unsigned char) s[pos++]);
-  if (n >= 8) return n - 8;
-  unsigned long int r= 0;
-  unsigned long int p= 1;
-  for (int k=0; k<n; k++) {
-    unsigned int next= (unsigned int) ((unsigned char) s[pos++]);
-    r += next * p;
-    p <<= 8;
-  }
-  return r;
-}
-
-static void
-marshall_string (string& s, string x) {
-  marshall_number (s, N(x));
-  s << x;
-}
-
-static string
-unmarshall_string (string s, int& pos) {
-  int n= unmarshall_number (s, pos);
-  string r= s (pos, pos+n);
-  pos += n;
-  return r;
-}
-
 /******************************************************************************
 * Writing to disk cache
 ******************************************************************************/
@@ -262,6 +212,21 @@ database_rep::purge () {
   error_flag= true;
 }
 
+bool
+database_rep::update_from_disk () {
+  // When other instances only appended to the file since we last saw it,
+  // then replay their changes instead of reloading the whole database.
+  if (error_flag || pending != "") return false;
+  string s;
+  if (load_string (db_name, s, false)) return false;
+  if (N(s) < N(loaded) || !starts (s, loaded)) return false;
+  replay (s (N(loaded), N(s)));
+  loaded= s;
+  start_pending= N(db);
+  time_stamp= last_modified (db_name);
+  return true;
+}
+
 extern array<database> dbs;
 bool require_check= false;
 
@@ -300,10 +265,11 @@ void
 check_for_updates () {
   if (!require_check) return;
   for (int i=0; i<N(dbs); i++)
-    if (last_modified (dbs[i]->db_name) > dbs[i]->time_stamp) {
+    if (last_modified (dbs[i]->db_name) > dbs[i]->time_stamp &&
+        !dbs[i]->update_from_disk ()) {
       //cout << "Updating from disk\n";
       database db (dbs[i]->db_name);
-      // FIXME: a more incremental form of updating would be better
+      // the file was rewritten or we have pending changes, so reload it
       //if (dbs[i]->pending != "") cout << "Replay pending";
       dbs[i]->replay (db, dbs[i]->start_pending, true);
       db->purge ();
@@ -127,6 +127,16 @@ database_rep::indexate_name (db_atom val) {
   name_indexed[val]= true;
 }
 
+void
+database_rep::flush_index () {
+  // the values are only indexed when the index is needed for the first time,
+  // since computing their keywords is expensive for large databases
+  for (int i=0; i<N(pending_index); i++) indexate (pending_index[i]);
+  for (int i=0; i<N(pending_names); i++) indexate_name (pending_names[i]);
+  pending_index= db_atoms ();
+  pending_names= db_atoms ();
+}
+
 /******************************************************************************
 * Using the index
 ******************************************************************************/
@@ -134,6 +144,7 @@ database_rep::indexate_name (db_atom val) {
 db_constraint
 database_rep::encode_keywords_constraint (tree q) {
   //cout << "Encoding " << q << LF;
+  flush_index ();
   hashset<db_atom> done;
   db_constraint r;
   r << -1;
@@ -164,10 +175,11 @@ database_rep::encode_keywords_constraint (tree q) {
 
 strings
 database_rep::compute_completions (string s) {
+  flush_index ();
   int pos=0, n=N(s);
   for (int i=0; i<MAX_PREFIX_LENGTH && pos<n; i++)
     tm_char_forwards (s, pos);
-  db_keys ks= key_completions (s (0, pos));
+  db_keys ks= key_completions [s (0, pos)];
   strings r;
   for (int i=0; i<N(ks); i++)
     if (pos == n || starts (from_key (ks[i]), s))
@@ -177,10 +189,11 @@ database_rep::compute_completions (string s) {
 
 strings
 database_rep::compute_name_completions (string s) {
+  flush_index ();
   int pos=0, n=N(s);
   for (int i=0; i<MAX_PREFIX_LENGTH && pos<n; i++)
     tm_char_forwards (s, pos);
-  db_atoms vals= name_completions (s (0, pos));
+  db_atoms vals= name_completions [s (0, pos)];
   strings r;
   for (int i=0; i<N(vals); i++)
     if (pos == n || starts (from_atom (vals[i]), s))
@@ -11,6 +11,7 @@
 
 #include "Database/database.hpp"
 #include "analyze.hpp"
+#include "merge_sort.hpp"
 
 /******************************************************************************
 * Fast filtering of lines which satisfy a list of constraints
@@ -24,9 +25,14 @@ database_rep::line_satisfies (db_line_nr nr, db_constraint c, db_time t) {
   if ((t != 0) && (t < l->created || t >= l->expires)) return false;
   db_atom attr= c[0];
   if (l->attr != attr && attr != -1) return false;
-  for (int j=1; j<N(c); j++)
-    if (l->val == c[j]) return true;
-  return false;
+  // the values of the constraint are sorted, see sorted_constraint
+  int lo= 1, hi= N(c);
+  while (lo < hi) {
+    int mid= (lo + hi) >> 1;
+    if (c[mid] < l->val) lo= mid + 1;
+    else hi= mid;
+  }
+  return lo < N(c) && c[lo] == l->val;
 }
 
 bool
@@ -45,16 +51,32 @@ database_rep::id_satisfies (db_atom id, db_constraints cs, db_time t) {
   return true;
 }
 
+static db_constraint
+sorted_constraint (db_constraint c) {
+  // the attribute followed by the values in increasing order
+  if (N(c) <= 2) return c;
+  db_atoms vals= range (c, 1, N(c));
+  merge_sort (vals);
+  db_constraint r;
+  r << c[0] << vals;
+  return r;
+}
+
 db_constraint
 database_rep::encode_constraint (tree q) {
+  // the encodings are remembered for the duration of a query
+  if (encoded->contains (q)) return encoded[q];
   db_constraint r;
   if (!is_tuple (q)) return db_constraint ();
   if (N(q) <= 1 || !is_atomic (q[0])) return db_constraint ();
   string attr= q[0]->label;
   if (attr == "any")
     r << -1;
-  else if (attr == "keywords")
-    return encode_keywords_constraint (q);
+  else if (attr == "keywords") {
+    r= encode_keywords_constraint (q);
+    encoded (q)= r;
+    return r;
+  }
   else if (attr == "order") {
     r << -2; return r; }
   else if (attr == "modified") {
@@ -67,6 +89,7 @@ database_rep::encode_constraint (tree q) {
   for (int i=1; i<N(q); i++)
     if (atom_encode->contains (scm_unquote (q[i]->label)))
       r << atom_encode [scm_unquote (q[i]->label)];
+  encoded (q)= r;
   return r;
 }
 
@@ -79,7 +102,7 @@ database_rep::encode_constraints (tree ql) {
     db_constraint c= encode_constraint (ql[i]);
     if (N(c) == 1 && c[0] == -2);
     else if (N(c) <= 1) failed= true;
-    else r << c;
+    else r << sorted_constraint (c);
   }
   if (failed) {
     r= db_constraints ();
@@ -88,12 +111,28 @@ database_rep::encode_constraints (tree ql) {
   return r;
 }
 
+void
+database_rep::plan_constraints (db_constraints& cs) {
+  // test the most selective constraints first, so that id_satisfies
+  // rejects most of the candidates after a single test
+  if (N(cs) <= 1) return;
+  array<int> costs;
+  for (int i=0; i<N(cs); i++) {
+    int c= 0;
+    for (int j=1; j<N(cs[i]); j++)
+      c += N (val_lines[cs[i][j]]);
+    costs << c;
+  }
+  merge_sort_leq<int,db_constraint,less_eq_operator<int> > (costs, cs);
+}
+
 db_atoms
 database_rep::filter (db_atoms ids, tree qt, db_time t, int limit) {
   //cout << "Query " << qt << "\n";
   db_constraints cs= encode_constraints (qt);
   //cout << "Encoded as " << cs << "\n";
   if (N(cs) == 1 && N(cs) == 0) return db_atoms ();
+  plan_constraints (cs);
   db_atoms r;
   for (int i=0; i<N(ids); i++)
     if (id_satisfies (ids[i], cs, t)) {
@@ -196,6 +235,7 @@ database_rep::filter_modified (db_atoms ids, db_time t1, db_time t2) {
 db_atoms
 database_rep::query (tree ql, db_time t, int limit) {
   //cout << "query " << ql << ", " << t << ", " << limit << LF;
+  encoded= hashmap<tree,db_constraint> ();
   ql= normalize_query (ql);
   //cout << "normalized query " << ql << ", " << t << ", " << limit << LF;
   db_atoms ids= ansatz (ql, t);
@@ -218,8 +258,9 @@ database_rep::query (tree ql, db_time t, int limit) {
     }
   }
   //cout << "filtered on modified ids= " << ids << LF;
-  ids= sort_results (ids, ql, t);
+  ids= sort_results (ids, ql, t, limit);
   //cout << "sorted ids= " << ids << LF;
   if (N(ids) > limit) ids= range (ids, 0, limit);
+  encoded= hashmap<tree,db_constraint> ();
   return ids;
 }
@@ -34,6 +34,46 @@ lex_sort (array<strings>& a) {
   merge_sort (a);
 }
 
+/******************************************************************************
+* Selection of the first tuples using a heap
+******************************************************************************/
+
+static inline bool
+tuple_before (strings a1, strings a2, bool up) {
+  return up? !(a2 <= a1): !(a1 <= a2);
+}
+
+static void
+sift_down (array<strings>& h, int i, bool up) {
+  // the root of the heap h is the last of its tuples in the chosen order
+  int n= N(h);
+  while (true) {
+    int l= 2*i + 1, r= l + 1, m= i;
+    if (l < n && tuple_before (h[m], h[l], up)) m= l;
+    if (r < n && tuple_before (h[m], h[r], up)) m= r;
+    if (m == i) return;
+    strings tmp= h[i]; h[i]= h[m]; h[m]= tmp;
+    i= m;
+  }
+}
+
+static array<strings>
+first_tuples (array<strings> a, int k, bool up) {
+  // the k first tuples of a, in increasing order if up and decreasing otherwise
+  if (k < N(a)) {
+    array<strings> h= range (a, 0, k);
+    for (int i= (k >> 1) - 1; i >= 0; i--) sift_down (h, i, up);
+    for (int i=k; i<N(a); i++)
+      if (k > 0 && tuple_before (a[i], h[0], up)) {
+        h[0]= a[i];
+        sift_down (h, 0, up);
+      }
+    a= h;
+  }
+  lex_sort (a);
+  return up? a: reverse (a);
+}
+
 /******************************************************************************
 * A posteriori sorting
 ******************************************************************************/
@@ -61,7 +101,7 @@ database_rep::build_sort_tuples (db_atoms ids, db_atoms attrs, db_time t) {
 }
 
 db_atoms
-database_rep::sort_results (db_atoms ids, tree q, db_time t) {
+database_rep::sort_results (db_atoms ids, tree q, db_time t, int limit) {
   if (!is_tuple (q)) return ids;
   db_atoms attrs;
   array<bool> dirs;
@@ -78,13 +118,11 @@ database_rep::sort_results (db_atoms ids, tree q, db_time t) {
   if (N(attrs) == 0) return ids;
   array<strings> a= build_sort_tuples (ids, attrs, t);
   //cout << "Tuples " << a << LF;
-  lex_sort (a);
+  a= first_tuples (a, max (limit, 0), dirs[0]);
   //cout << "Sorted " << a << LF;
   db_atoms r;
-  for (int i=0; i<N(a); i++) {
-    int j= (dirs[0]? i: (N(a) - 1 - i));
-    r << as_atom (a[j][N(a[j]) - 1]);
-  }
+  for (int i=0; i<N(a); i++)
+    r << as_atom (a[i][N(a[i]) - 1]);
   //cout << "Result " << r << LF;
   return r;
 }
@@ -26,8 +26,12 @@ struct rubber_assemble_font_rep: font_rep {
   array<font> larger;
   translator virt;
 
+  hashmap<string,int> mapper;
+  hashmap<string,string> rewriter;
+
   rubber_assemble_font_rep (string name, font base);
   font get_font (int nr);
+  int search_font_sub (string s, string& r);
   int search_font (string s, string& r);
 
   bool  supports (string c);
@@ -72,7 +76,7 @@ rubber_assemble_font_rep::get_font (int nr) {
 }
 
 int
-rubber_assemble_font_rep::search_font (string s, string& r) {
+rubber_assemble_font_rep::search_font_sub (string s, string& r) {
   if (starts (s, "<mid-")) s= "<left-" * s (5, N(s));
   if (starts (s, "<right-")) s= "<left-" * s (7, N(s));
   if (starts (s, "<large-")) s= "<left-" * s (7, N(s));
@@ -127,6 +131,18 @@ rubber_assemble_font_rep::search_font (string s, string& r) {
   return 0;
 }
 
+int
+rubber_assemble_font_rep::search_font (string s, string& r) {
+  if (mapper->contains (s)) {
+    r= rewriter[s];
+    return mapper[s];
+  }
+  int nr= search_font_sub (s, r);
+  mapper(s)= nr;
+  rewriter(s)= r;
+  return nr;
+}
+
 /******************************************************************************
 * Getting extents and drawing strings
 ******************************************************************************/
@@ -36,7 +36,9 @@ decode_index (FT_Face face, int i) {
 * Freetype faces
 ******************************************************************************/
 
-tt_face_rep::tt_face_rep (string name): rep<tt_face> (name) {
+tt_face_rep::tt_face_rep (string name):
+  rep<tt_face> (name), size (-1), hdpi (-1), vdpi (-1)
+{
   bad_face= true;
   if (ft_initialize ()) return;
   if (DEBUG_VERBOSE)
@@ -49,6 +51,19 @@ tt_face_rep::tt_face_rep (string name): rep<tt_face> (name) {
   bad_face= false;
 }
 
+bool
+tt_face_rep::set_char_size (int size2, int hdpi2, int vdpi2) {
+  // the face is shared by all sizes, so only change its size when needed,
+  // since this reinitializes the scaled metrics and the hinting
+  if (size2 == size && hdpi2 == hdpi && vdpi2 == vdpi) return false;
+  if (ft_set_char_size (ft_face, 0, size2<<6, hdpi2, vdpi2)) {
+    size= hdpi= vdpi= -1;
+    return true;
+  }
+  size= size2; hdpi= hdpi2; vdpi= vdpi2;
+  return false;
+}
+
 tt_face
 load_tt_face (string name) {
   bench_start ("load tt face");
@@ -69,8 +84,9 @@ tt_font_metric_rep::tt_font_metric_rep (
 {
   face= load_tt_face (family);
   bad_font_metric= face->bad_face ||
-    ft_set_char_size (face->ft_face, 0, size<<6, hdpi, vdpi);
+    face->set_char_size (size, hdpi, vdpi);
   if (bad_font_metric) return;
+  cache= metric_cache (name, tt_font_find (family));
 
   error_metric->x1= error_metric->y1= 0;
   error_metric->x2= error_metric->y2= 0;
@@ -89,7 +105,14 @@ tt_font_metric_rep::exists (int i) {
 metric&
 tt_font_metric_rep::get (int i) {
   if (!face->bad_face && !fnm->contains(i)) {
-    ft_set_char_size (face->ft_face, 0, size<<6, hdpi, vdpi);
+    // rendering glyphs in order to measure them is expensive,
+    // so we first look whether an earlier session already did it
+    metric_struct cached;
+    if (cache->get (i, cached)) {
+      fnm(i)= (pointer) tm_new<metric_struct> (cached);
+      return *((metric*) ((void*) fnm [i]));
+    }
+    face->set_char_size (size, hdpi, vdpi);
     FT_UInt glyph_index= decode_index (face->ft_face, i);
     if (ft_load_glyph (face->ft_face, glyph_index, FT_LOAD_DEFAULT))
       return error_metric;
@@ -97,6 +120,7 @@ tt_font_metric_rep::get (int i) {
     if (ft_render_glyph (slot, ft_render_mode_mono)) return error_metric;
     metric_struct* M= tm_new<metric_struct> ();
     fnm(i)= (pointer) M;
+    cache->set (i, M);
     int w= slot->bitmap.width;
     int h= slot->bitmap.rows;
     SI ww= w * PIXEL;
@@ -130,7 +154,7 @@ tt_font_metric_rep::kerning (int left, int right) {
   FT_Vector k;
   FT_UInt l= decode_index (face->ft_face, left);
   FT_UInt r= decode_index (face->ft_face, right);
-  ft_set_char_size (face->ft_face, 0, size<<6, hdpi, vdpi);
+  face->set_char_size (size, hdpi, vdpi);
   if (ft_get_kerning (face->ft_face, l, r, FT_KERNING_DEFAULT, &k)) return 0;
   return tt_si (k.x);
 }
@@ -156,14 +180,15 @@ tt_font_glyphs_rep::tt_font_glyphs_rep (
 {
   face= load_tt_face (family);
   bad_font_glyphs= face->bad_face ||
-    ft_set_char_size (face->ft_face, 0, size<<6, hdpi, vdpi);
+    face->set_char_size (size, hdpi, vdpi);
   if (bad_font_glyphs) return;
 }
 
 glyph&
 tt_font_glyphs_rep::get (int i) {
   if (!face->bad_face && !fng->contains(i)) {
-    ft_set_char_size (face->ft_face, 0, size<<6, hdpi, vdpi);
+    MEM_TAG_SCOPE (MEM_GLYPHS);
+    face->set_char_size (size, hdpi, vdpi);
     FT_UInt glyph_index= decode_index (face->ft_face, i);
     if (ft_load_glyph (face->ft_face, glyph_index, FT_LOAD_DEFAULT))
       return error_glyph;
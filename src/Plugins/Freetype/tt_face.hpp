@@ -14,6 +14,7 @@
 #include "bitmap_font.hpp"
 #include "Freetype/free_type.hpp"
 #include "hashmap.hpp"
+#include "metric_cache.hpp"
 
 #ifdef USE_FREETYPE
 
@@ -22,7 +23,9 @@ RESOURCE(tt_face);
 struct tt_face_rep: rep<tt_face> {
   bool bad_face;
   FT_Face ft_face;
+  int size, hdpi, vdpi; // current character size of ft_face
   tt_face_rep (string name);
+  bool set_char_size (int size, int hdpi, int vdpi);
 };
 
 struct tt_font_metric_rep: font_metric_rep {
@@ -30,6 +33,7 @@ struct tt_font_metric_rep: font_metric_rep {
   tt_face face;
   int size, hdpi, vdpi;
   hashmap<int,pointer> fnm;
+  metric_cache cache;
   //metric* fnm;
   //bool* done;
   tt_font_metric_rep (string name, string family, int size, int hdpi, int vdpi);
@@ -184,6 +184,77 @@ tt_extract_subfont (string tt, int i) {
   return r;
 }
 
+/******************************************************************************
+* Reading from memory mapped font files
+******************************************************************************/
+
+static U16
+get_U16 (mapped_string tt, int i) {
+  return get_U16 (tt (i, i+2), 0);
+}
+
+static U32
+get_U32 (mapped_string tt, int i) {
+  return get_U32 (tt (i, i+4), 0);
+}
+
+static string
+tt_header (mapped_string tt) {
+  // copy the font headers and table directories at the start of the file,
+  // so that the ordinary routines can be used to locate the tables
+  int end= 12 + 16 * get_U16 (tt, 4);
+  if (tt (0, 4) == "ttcf") {
+    int nr= get_U32 (tt, 8);
+    end= 12 + 4 * nr;
+    for (int i=0; i<nr; i++) {
+      int h= get_U32 (tt, 12 + 4*i);
+      end= max (end, h + 12 + 16 * ((int) get_U16 (tt, h + 4)));
+    }
+  }
+  return tt (0, end);
+}
+
+static string
+tt_table (mapped_string tt, string hd, int i, string tag) {
+  // only copy the requested table
+  for (int k=0; k<tt_nr_tables (hd, i); k++)
+    if (tt_table_tag (hd, i, k) == tag) {
+      int h= tt_header_index (hd, i);
+      int start= get_U32 (hd, h + 20 + 16 * k);
+      int len  = get_U32 (hd, h + 24 + 16 * k);
+      return tt (start, start + len);
+    }
+  return "";
+}
+
+static string
+tt_extract_subfont (mapped_string tt, int i) {
+  string hd= tt_header (tt);
+  ASSERT (i >= 0 && i < tt_nr_fonts (hd), "index out of range");
+  if (!tt_is_collection (hd)) return as_string (tt);
+  string r;
+  int h= tt_header_index (hd, i);
+  r << get_sub (hd, h, h + 12);
+  int nr_tabs= tt_nr_tables (hd, i);
+  int offset= 12 + 16 * nr_tabs;
+  for (int k=0; k < nr_tabs; k++) {
+    int taboff= h + 12 + 16 * k;
+    r << get_sub (hd, taboff, taboff + 8);
+    r << pack_U32 (offset);
+    r << get_sub (hd, taboff + 12, taboff + 16);
+    int len= get_U32 (hd, taboff + 12);
+    offset += (((len + 3) >> 2) << 2);
+  }
+  for (int k=0; k < nr_tabs; k++) {
+    int taboff= h + 12 + 16 * k;
+    int start= get_U32 (hd, taboff + 8);
+    int len  = get_U32 (hd, taboff + 12);
+    int plen = (((len + 3) >> 2) << 2);
+    r << tt (start, start + plen);
+  }
+  return r;
+}
+
 /******************************************************************************
 * Name table
 ******************************************************************************/
@@ -320,12 +391,13 @@ move_to_shape (string& fam, string& shape, string what, string by) {
 
 scheme_tree
 tt_font_name (url u) {
-  string tt;
+  mapped_string tt;
   tree r (TUPLE);
-  if (load_string (u, tt, false)) return r;
-  for (int i=0; i < tt_nr_fonts (tt); i++) {
-    if (!tt_correct_version (tt, i)) return tree (TUPLE);
-    string nt = tt_table (tt, i, "name");
+  if (load_mapped (u, tt, false) || N(tt) < 12) return r;
+  string hd= tt_header (tt);
+  for (int i=0; i < tt_nr_fonts (hd); i++) {
+    if (!tt_correct_version (hd, i)) return tree (TUPLE);
+    string nt = tt_table (tt, hd, i, "name");
     string fam= name_record_family (nt);
     string sh = name_record_shape (nt);
 
@@ -381,8 +453,8 @@ tt_unpack (string s) {
   s= strip_suffix (s);
   url u= tt_font_find (s);
   if (is_none (u)) return url_none ();
-  string ttc;
-  if (load_string (u, ttc, false)) return url_none ();
+  mapped_string ttc;
+  if (load_mapped (u, ttc, false) || N(ttc) < 12) return url_none ();
   string tt= tt_extract_subfont (ttc, i);
   if (save_string (name, tt, false)) return url_none ();
   return name;
@@ -708,7 +708,9 @@ unicode_font_rep::get_xpositions (string s, SI* xpos) {
 
 void
 unicode_font_rep::draw_fixed (renderer ren, string s, SI x, SI y, bool ligf) {
-  int i= 0, n= N(s);
+  int i= 0, k= 0, n= N(s);
+  STACK_NEW_ARRAY (cs, int, n);
+  STACK_NEW_ARRAY (xs, SI, n);
   unsigned int uc= 0xffffffff;
   while (i<n) {
     unsigned int pc= uc;
@@ -716,12 +718,16 @@ unicode_font_rep::draw_fixed (renderer ren, string s, SI x, SI y, bool ligf) {
     if (ligs > 0 && ligf && (((char) uc) == 'f' || ((char) uc) == 's'))
       uc= ligature_replace (uc, s, i);
     if (pc != 0xffffffff) x += ROUND (fnm->kerning (pc, uc));
-    ren->draw (uc, fng, x, y);
+    cs[k]= (int) uc;
+    xs[k++]= x;
     metric_struct* ex= fnm->get (uc);
     x += ROUND (ex->x2);
     //if (fnm->kerning (pc, uc) != 0)
     //cout << "Kerning " << ((char) pc) << ((char) uc) << " " << ROUND (fnm->kerning (pc, uc)) << ", " << ROUND (ex->x2) << "\n";
   }
+  ren->draw_characters (cs, xs, k, fng, y);
+  STACK_DELETE_ARRAY (cs);
+  STACK_DELETE_ARRAY (xs);
 }
 
 void
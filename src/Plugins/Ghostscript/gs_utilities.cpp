@@ -16,6 +16,7 @@
 #include "analyze.hpp"
 #include "file.hpp"
 #include "image_files.hpp"
+#include "data_cache.hpp"
 #include "scheme.hpp" 
 
 string
@@ -89,6 +90,40 @@ gs_supports (url image) {
   return false;
 }
 
+/******************************************************************************
+* Persistent cache for the sizes computed by Ghostscript
+******************************************************************************/
+
+static tree
+gs_size_key (url image, string kind) {
+  return tuple (kind, concretize (image));
+}
+
+static bool
+gs_size_cached (url image, string kind, int& x1, int& y1, int& x2, int& y2) {
+  // sizes are only reused as long as the image file remains unchanged
+  tree key= gs_size_key (image, kind);
+  if (!is_cached ("image_cache.scm", key)) return false;
+  tree t= cache_get ("image_cache.scm", key);
+  if (!is_tuple (t) || N(t) != 5 ||
+      t[0] != as_string (last_modified (image, false))) return false;
+  x1= as_int (t[1]); y1= as_int (t[2]);
+  x2= as_int (t[3]); y2= as_int (t[4]);
+  return true;
+}
+
+static void
+gs_size_cache (url image, string kind, int x1, int y1, int x2, int y2) {
+  tree t= tuple (as_string (last_modified (image, false)),
+                 as_string (x1), as_string (y1),
+                 as_string (x2), as_string (y2));
+  cache_set ("image_cache.scm", gs_size_key (image, kind), t);
+}
+
+/******************************************************************************
+* Image sizes
+******************************************************************************/
+
 void
 gs_image_size (url image, int& w_pt, int& h_pt) {
   bool ok;
@@ -102,7 +137,8 @@ gs_image_size (url image, int& w_pt, int& h_pt) {
     if (ok) {
       //try finding Bounding box in file:
       ok= ps_read_bbox (buf, x1, y1, x2, y2);
-      if (!ok) {
+      if (!ok && gs_size_cached (image, "bbox", x1, y1, x2, y2)) ok= true;
+      else if (!ok) {
         // bbox not found ask gs to compute one :
         string cmd= gs_prefix ();
         cmd << "-dQUIET -dNOPAUSE -dBATCH -dSAFER -sDEVICE=bbox ";
@@ -114,6 +150,7 @@ gs_image_size (url image, int& w_pt, int& h_pt) {
         if (DEBUG_CONVERT) debug_convert << "gs cmd :"<<cmd<<LF
           <<"answer :"<< buf ;
         ok= ps_read_bbox (buf, x1, y1, x2, y2);
+        if (ok) gs_size_cache (image, "bbox", x1, y1, x2, y2);
       }
       if (ok) {
         w_pt= x2-x1;
@@ -190,8 +227,8 @@ pdf_version (url image) {
   return v;
 }
 
-bool
-gs_PDFimage_size (url image, int& w_pt, int& h_pt) {
+static bool
+gs_compute_PDFimage_size (url image, int& w_pt, int& h_pt) {
   if (DEBUG_CONVERT) debug_convert << "gs PDF image size :"<<LF;
   string buf;
   string cmd= gs_prefix ();
@@ -257,6 +294,15 @@ gs_PDFimage_size (url image, int& w_pt, int& h_pt) {
   return true;
 }
 
+bool
+gs_PDFimage_size (url image, int& w_pt, int& h_pt) {
+  int x1, y1;
+  if (gs_size_cached (image, "pdf", x1, y1, w_pt, h_pt)) return true;
+  if (!gs_compute_PDFimage_size (image, w_pt, h_pt)) return false;
+  gs_size_cache (image, "pdf", 0, 0, w_pt, h_pt);
+  return true;
+}
+
 bool
 gs_PDF_EmbedAllFonts (url image, url pdf) {
   if (DEBUG_CONVERT) debug_convert << "gs_PDF_EmbedAllFonts" << LF;
@@ -371,11 +417,9 @@ gs_to_eps (url image, url eps) { //this should be used mostly for pdf->eps conve
 
 // This conversion is appropriate for eps images
 // (originally implemented in pdf_image_rep::flush)
-void  
-gs_to_pdf (url image, url pdf, int w, int h) {
+string
+gs_to_pdf_command (url image, url pdf, int w, int h) {
   string cmd;
-  if (DEBUG_CONVERT) debug_convert << "(eps) gs_to_pdf"<<LF;
-  string s= suffix (image);    
   // take care of properly handling the bounding box
   // the resulting pdf image will always start at 0,0.
 
@@ -395,6 +439,13 @@ gs_to_pdf (url image, url pdf, int w, int h) {
     << as_string(scale_x) << " " << as_string(scale_y) << " scale \"";
   cmd << " -f " << sys_concretize (image);
   cmd << " -c \" grestore \"  ";
+  return cmd;
+}
+
+void
+gs_to_pdf (url image, url pdf, int w, int h) {
+  if (DEBUG_CONVERT) debug_convert << "(eps) gs_to_pdf"<<LF;
+  string cmd= gs_to_pdf_command (image, pdf, w, h);
   // debug_convert << cmd << LF;
   system(cmd);
   if (DEBUG_CONVERT)
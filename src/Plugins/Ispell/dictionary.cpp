@@ -0,0 +1,306 @@
+
+/******************************************************************************
+* MODULE     : dictionary.cpp
+* DESCRIPTION: resident word lists in hunspell format
+* COPYRIGHT  : (C) 2020  Joris van der Hoeven
+*******************************************************************************
+* This software falls under the GNU general public license version 3 or later.
+* It comes WITHOUT ANY WARRANTY WHATSOEVER. For details, see the file LICENSE
+* in the root directory or <http://www.gnu.org/licenses/gpl-3.0.html>.
+******************************************************************************/
+
+#include "Ispell/dictionary.hpp"
+#include "file.hpp"
+#include "hashset.hpp"
+#include "analyze.hpp"
+#include "converter.hpp"
+#include "universal.hpp"
+#include "locale.hpp"
+#include "sys_utils.hpp"
+#include "tm_timer.hpp"
+
+static hashset<string> dictionary_words;        // "lan:word" in utf8
+static hashmap<string,int> dictionary_state (0);  // 1 loaded, -1 missing
+
+/******************************************************************************
+* Affix rules
+******************************************************************************/
+
+struct affix_rule {
+  string flag;
+  bool prefix;
+  bool cross;                  // may be combined with affixes of other kind
+  string strip;
+  string add;
+  array<array<int> > cls;      // character classes of the condition
+  array<bool> neg;             // negated classes
+};
+
+static array<int>
+code_points (string s) {
+  array<int> r;
+  int i= 0;
+  while (i < N(s)) r << (int) decode_from_utf8 (s, i);
+  return r;
+}
+
+static void
+parse_condition (affix_rule& r, string s) {
+  array<int> a= code_points (s);
+  for (int i=0; i<N(a); i++) {
+    array<int> cl;
+    bool neg= false;
+    if (a[i] == '.') neg= true;
+    else if (a[i] == '[') {
+      i++;
+      if (i < N(a) && a[i] == '^') { neg= true; i++; }
+      while (i < N(a) && a[i] != ']') cl << a[i++];
+    }
+    else cl << a[i];
+    r.cls << cl;
+    r.neg << neg;
+  }
+}
+
+static bool
+matches (affix_rule& r, array<int> w) {
+  int n= N(r.cls);
+  if (n > N(w)) return false;
+  int d= r.prefix? 0: N(w) - n;
+  for (int i=0; i<n; i++) {
+    bool found= false;
+    for (int j=0; j<N(r.cls[i]); j++)
+      found= found || r.cls[i][j] == w[i+d];
+    if (found == r.neg[i]) return false;
+  }
+  return true;
+}
+
+static bool
+apply (affix_rule& r, string w, array<int> cp, string& res) {
+  if (r.prefix) {
+    if (!starts (w, r.strip) || !matches (r, cp)) return false;
+    res= r.add * w (N(r.strip), N(w));
+  }
+  else {
+    if (!ends (w, r.strip) || !matches (r, cp)) return false;
+    res= w (0, N(w) - N(r.strip)) * r.add;
+  }
+  return N(res) > 0;
+}
+
+/******************************************************************************
+* Flags
+******************************************************************************/
+
+static array<string>
+parse_flags (string s, string mode, array<string> aliases) {
+  if (N(aliases) > 0 && is_int (s)) {
+    int i= as_int (s) - 1;
+    if (i < 0 || i >= N(aliases)) return array<string> ();
+    s= aliases[i];
+  }
+  array<string> r;
+  if (mode == "num") r= tokenize (s, ",");
+  else if (mode == "long")
+    for (int i=0; i+1<N(s); i+=2) r << s (i, i+2);
+  else if (mode == "UTF-8")
+    for (int i=0; i<N(s); ) {
+      int start= i;
+      decode_from_utf8 (s, i);
+      r << s (start, i);
+    }
+  else
+    for (int i=0; i<N(s); i++) r << s (i, i+1);
+  return r;
+}
+
+static array<string>
+fields (string s) {
+  array<string> r;
+  int i= 0;
+  while (i < N(s)) {
+    while (i < N(s) && (s[i] == ' ' || s[i] == '\t')) i++;
+    int start= i;
+    while (i < N(s) && s[i] != ' ' && s[i] != '\t') i++;
+    if (i > start) r << s (start, i);
+  }
+  return r;
+}
+
+static array<string>
+lines (string s) {
+  array<string> r= tokenize (s, "\n");
+  for (int i=0; i<N(r); i++)
+    if (ends (r[i], "\r")) r[i]= r[i] (0, N(r[i]) - 1);
+  return r;
+}
+
+static string
+latin1_to_utf8 (string s) {
+  string r;
+  for (int i=0; i<N(s); i++)
+    if (((unsigned char) s[i]) < 128) r << s[i];
+    else r << encode_as_utf8 ((unsigned char) s[i]);
+  return r;
+}
+
+/******************************************************************************
+* Loading dictionaries
+******************************************************************************/
+
+static string
+affix_field (string s) {
+  int i= search_forwards ("/", s);
+  if (i >= 0) s= s (0, i);
+  return s == "0"? string (""): s;
+}
+
+bool
+dictionary_load (string lan, url dic, url aff) {
+  string dic_s, aff_s;
+  if (load_string (dic, dic_s, false) || load_string (aff, aff_s, false))
+    return false;
+  array<string> ls= lines (aff_s);
+  string set= "ISO8859-1", mode;
+  for (int i=0; i<N(ls); i++) {
+    array<string> f= fields (ls[i]);
+    if (N(f) >= 2 && f[0] == "SET") set= f[1];
+    if (N(f) >= 2 && f[0] == "FLAG") mode= f[1];
+  }
+  if (set == "ISO8859-1") {
+    aff_s= latin1_to_utf8 (aff_s);
+    dic_s= latin1_to_utf8 (dic_s);
+    ls= lines (aff_s);
+  }
+  else if (set != "UTF-8") return false;
+
+  array<string> aliases;
+  array<affix_rule> rules;
+  hashmap<string,bool> cross;
+  string needaffix, forbidden, compound;
+  for (int i=0; i<N(ls); i++) {
+    array<string> f= fields (ls[i]);
+    if (N(f) < 2) continue;
+    if (f[0] == "AF" && !is_int (f[1])) aliases << f[1];
+    else if (f[0] == "NEEDAFFIX" || f[0] == "PSEUDOROOT") needaffix= f[1];
+    else if (f[0] == "FORBIDDENWORD") forbidden= f[1];
+    else if (f[0] == "ONLYINCOMPOUND") compound= f[1];
+    else if ((f[0] == "PFX" || f[0] == "SFX") && N(f) >= 4) {
+      if (!cross->contains (f[1])) cross (f[1])= (f[2] == "Y");
+      else {
+        affix_rule r;
+        r.flag  = f[1];
+        r.prefix= (f[0] == "PFX");
+        r.cross = cross[f[1]];
+        r.strip = affix_field (f[2]);
+        r.add   = affix_field (f[3]);
+        if (N(f) >= 5) parse_condition (r, f[4]);
+        rules << r;
+      }
+    }
+  }
+
+  hashmap<string,array<int> > by_flag;
+  for (int i=0; i<N(rules); i++) {
+    if (!by_flag->contains (rules[i].flag))
+      by_flag (rules[i].flag)= array<int> ();
+    by_flag (rules[i].flag) << i;
+  }
+  array<string> ds= lines (dic_s);
+  string prefix= lan * ":";
+  for (int k= (N(ds) > 0 && is_int (trim_spaces (ds[0])))? 1: 0; k<N(ds); k++) {
+    array<string> f= fields (ds[k]);
+    if (N(f) == 0) continue;
+    string w= f[0], flags_s;
+    int i= search_forwards ("/", 1, w);
+    if (i > 0) { flags_s= w (i+1, N(w)); w= w (0, i); }
+    array<string> flags= parse_flags (flags_s, mode, aliases);
+    bool base= true, forbid= false;
+    for (int j=0; j<N(flags); j++) {
+      forbid= forbid || flags[j] == forbidden;
+      base= base && flags[j] != needaffix && flags[j] != compound;
+    }
+    if (forbid) continue;
+    if (base) dictionary_words->insert (prefix * w);
+    array<int> cp= code_points (w);
+    array<string> crossed;
+    for (int pass=0; pass<2; pass++)
+      for (int j=0; j<N(flags); j++) {
+        array<int> ids= by_flag[flags[j]];
+        for (int l=0; l<N(ids); l++) {
+          affix_rule& r= rules[ids[l]];
+          if (r.prefix != (pass == 1)) continue;
+          string res;
+          if (apply (r, w, cp, res)) {
+            dictionary_words->insert (prefix * res);
+            if (!r.prefix && r.cross) crossed << res;
+          }
+          if (r.prefix && r.cross)
+            for (int m=0; m<N(crossed); m++)
+              if (apply (r, crossed[m], code_points (crossed[m]), res))
+                dictionary_words->insert (prefix * res);
+        }
+      }
+  }
+  dictionary_state (lan)= 1;
+  return true;
+}
+
+static array<url>
+dictionary_dirs () {
+  array<url> r;
+  string p= get_env ("DICPATH");
+  if (p != "") {
+    array<string> a= tokenize (p, ":");
+    for (int i=0; i<N(a); i++) r << url_system (a[i]);
+  }
+  r << url_system ("$HOME/.hunspell")
+    << url_system ("/usr/share/hunspell")
+    << url_system ("/usr/local/share/hunspell")
+    << url_system ("/usr/share/myspell")
+    << url_system ("/usr/share/myspell/dicts")
+    << url_system ("/Library/Spelling");
+  return r;
+}
+
+bool
+dictionary_load (string lan) {
+  if (dictionary_state[lan] != 0) return dictionary_state[lan] == 1;
+  dictionary_state (lan)= -1;
+  string locale= language_to_locale (lan);
+  array<url> dirs= dictionary_dirs ();
+  for (int i=0; i<N(dirs); i++) {
+    url dic= dirs[i] * (locale * ".dic");
+    url aff= dirs[i] * (locale * ".aff");
+    if (!is_regular (dic) || !is_regular (aff)) continue;
+    bench_start ("load dictionary");
+    bool ok= dictionary_load (lan, dic, aff);
+    bench_cumul ("load dictionary");
+    if (ok) {
+      debug_spell << "loaded " << as_string (dic)
+                  << " as resident dictionary for " << lan << "\n";
+      return true;
+    }
+  }
+  return false;
+}
+
+/******************************************************************************
+* Looking up words
+******************************************************************************/
+
+bool
+dictionary_contains (string lan, string s) {
+  if (dictionary_state[lan] != 1) return false;
+  string prefix= lan * ":";
+  if (dictionary_words->contains (prefix * cork_to_utf8 (s))) return true;
+  string l= uni_locase_all (s);
+  return l != s && dictionary_words->contains (prefix * cork_to_utf8 (l));
+}
+
+void
+dictionary_insert (string lan, string s) {
+  if (dictionary_state[lan] != 1) return;
+  dictionary_words->insert (lan * ":" * cork_to_utf8 (s));
+}
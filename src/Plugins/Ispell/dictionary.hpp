@@ -0,0 +1,28 @@
+
+/******************************************************************************
+* MODULE     : dictionary.hpp
+* DESCRIPTION: resident word lists in hunspell format
+* COPYRIGHT  : (C) 2020  Joris van der Hoeven
+*******************************************************************************
+* This software falls under the GNU general public license version 3 or later.
+* It comes WITHOUT ANY WARRANTY WHATSOEVER. For details, see the file LICENSE
+* in the root directory or <http://www.gnu.org/licenses/gpl-3.0.html>.
+******************************************************************************/
+
+#ifndef DICTIONARY_H
+#define DICTIONARY_H
+#include "url.hpp"
+
+/******************************************************************************
+* The hunspell dictionary of a language is loaded once into memory, together
+* with the words which can be derived from it using the simple affix rules.
+* Words found in this way are accepted without asking the external spell
+* checker, which remains responsible for unknown words and suggestions.
+******************************************************************************/
+
+bool dictionary_load (string lan);
+bool dictionary_load (string lan, url dic, url aff);
+bool dictionary_contains (string lan, string s);
+void dictionary_insert (string lan, string s);
+
+#endif // DICTIONARY_H
@@ -10,11 +10,15 @@
 ******************************************************************************/
 
 #include "Ispell/ispell.hpp"
+#include "Ispell/dictionary.hpp"
 #include "file.hpp"
 #include "resource.hpp"
 #include "tm_link.hpp"
 #include "convert.hpp"
 #include "locale.hpp"
+#include "analyze.hpp"
+
+#define ISPELL_BATCH 64
 
 string ispell_encode (string lan, string s);
 string ispell_decode (string lan, string s);
@@ -33,6 +37,7 @@ public:
   ispeller_rep (string lan);
   string start ();
   string retrieve ();
+  array<string> retrieve (int n);
   void   send (string cmd);
 private:
   bool connect_spellchecker (string cmd);
@@ -168,6 +173,37 @@ ispeller_rep::retrieve () {
   return ispell_decode (lan, ret);
 }
 
+array<string>
+ispeller_rep::retrieve (int n) {
+  // the answers to n lines, each of which ends with an empty line
+  array<string> r;
+  string ret, cur;
+  int pos= 0;
+  while (N(r) < n) {
+    int i= search_forwards ("\n", pos, ret);
+    if (i < 0) {
+      ln->listen (10000);
+      string mess = ln->read (LINK_ERR);
+      string extra= ln->read (LINK_OUT);
+      if (mess  != "") io_error << "Spellchecker error: " << mess << "\n";
+      if (extra == "") {
+        ln->stop ();
+        return array<string> ();
+      }
+      ret << extra;
+      continue;
+    }
+    string line= ret (pos, i+1);
+    pos= i+1;
+    cur << line;
+    if (line == "\n" || line == "\r\n") {
+      r << ispell_decode (lan, cur);
+      cur= "";
+    }
+  }
+  return r;
+}
+
 void
 ispeller_rep::send (string cmd) {
   ln->write (ispell_encode (lan, cmd) * "\n", LINK_IN);
@@ -247,12 +283,14 @@ ispell_start (string lan) {
   if (DEBUG_IO) debug_spell << "Start " << lan << "\n";
   ispeller sc= ispeller (lan);
   if (is_nil (sc)) sc= tm_new<ispeller_rep> (lan);
+  dictionary_load (lan);
   return sc->start ();
 }
 
 tree
 ispell_check (string lan, string s) {
   if (DEBUG_IO) debug_spell << "Check " << s << "\n";
+  if (dictionary_contains (lan, s)) return "ok";
   ispeller sc= ispeller (lan);
   if (is_nil (sc) || (!sc->ln->alive)) {
     string message= ispell_start (lan);
@@ -264,6 +302,46 @@ ispell_check (string lan, string s) {
   return parse_ispell (ret_s);
 }
 
+array<tree>
+ispell_check (string lan, array<string> a) {
+  // words found in the resident dictionary are accepted at once;
+  // the others are sent to the spell checker by batches
+  if (DEBUG_IO) debug_spell << "Check " << N(a) << " words\n";
+  array<tree> r (N(a));
+  array<int> todo;
+  for (int i=0; i<N(a); i++)
+    if (dictionary_contains (lan, a[i])) r[i]= "ok";
+    else todo << i;
+  if (N(todo) == 0) return r;
+  ispeller sc= ispeller (lan);
+  if (is_nil (sc) || (!sc->ln->alive)) {
+    string message= ispell_start (lan);
+    sc= ispeller (lan);
+    if (starts (message, "Error: ")) {
+      for (int i=0; i<N(todo); i++) r[todo[i]]= message;
+      return r;
+    }
+  }
+  for (int k=0; k<N(todo); k+=ISPELL_BATCH) {
+    int n= min (N(todo) - k, ISPELL_BATCH);
+    if (sc->unavailable || !sc->ln->alive) {
+      for (int i=k; i<k+n; i++) r[todo[i]]= "Error: unavailable";
+      continue;
+    }
+    string cmd;
+    for (int i=k; i<k+n; i++) {
+      if (i > k) cmd << "\n";
+      cmd << "^" << a[todo[i]];
+    }
+    sc->send (cmd);
+    array<string> ret= sc->retrieve (n);
+    for (int i=0; i<n; i++)
+      if (i < N(ret)) r[todo[k+i]]= parse_ispell (ret[i]);
+      else r[todo[k+i]]= "Error: spellchecker does not respond";
+  }
+  return r;
+}
+
 void
 ispell_accept (string lan, string s) {
   if (DEBUG_IO) debug_spell << "Accept " << s << "\n";
@@ -273,6 +351,7 @@ ispell_accept (string lan, string s) {
 void
 ispell_insert (string lan, string s) {
   if (DEBUG_IO) debug_spell << "Insert " << s << "\n";
+  dictionary_insert (lan, s);
   ispell_send (lan, "*" * s);
 }
 
@@ -13,6 +13,7 @@
 #include "Ghostscript/gs_utilities.hpp"
 #include "Tex/convert_tex.hpp"
 #include "analyze.hpp"
+#include "convert.hpp"
 #include "file.hpp"
 #include "sys_utils.hpp"
 
@@ -179,6 +180,52 @@ latex_load_preview (url wdir, bool dvips= false) {
   return r;
 }
 
+/******************************************************************************
+* Persistent previews
+******************************************************************************/
+
+static bool
+latex_preview_cacheable (string s) {
+  // previews depending on other files might change without s changing
+  return search_forwards ("\\input", s) < 0 &&
+         search_forwards ("\\include", s) < 0 &&
+         search_forwards ("\\bibliography", s) < 0;
+}
+
+static url
+latex_preview_cache_file (string key) {
+  return url ("$TEXMACS_HOME_PATH/system/cache/latex") *
+         (as_hexadecimal (hash (key)) * ".tmb");
+}
+
+static bool
+latex_preview_load (string key, array<tree>& r) {
+  string s;
+  if (load_string (latex_preview_cache_file (key), s, false)) return false;
+  int pos= 0;
+  if (unmarshall_string (s, pos) != key) return false;
+  tree t= binary_to_tree (s (pos, N(s)));
+  if (!is_tuple (t)) return false;
+  r= A(t);
+  return true;
+}
+
+static void
+latex_preview_save (string key, array<tree> r) {
+  url dir ("$TEXMACS_HOME_PATH/system/cache/latex");
+  if (!exists (dir)) mkdir (dir);
+  string s;
+  marshall_string (s, key);
+  tree t (TUPLE);
+  t << r;
+  s << tree_to_binary (t);
+  (void) save_string (latex_preview_cache_file (key), s);
+}
+
+/******************************************************************************
+* Compiling the previews
+******************************************************************************/
+
 array<tree>
 latex_preview (string s, tree t) {
   if (!latex_present () && !exists_in_path ("latex")) {
@@ -191,11 +238,18 @@ latex_preview (string s, tree t) {
   }
   // FIXME: ./Texmacs/Window/tm_frame.cpp:191 seems to crash here if we launch
   // system_wait ("LaTeX: compiling document, ", "please wait");
+  string document_root= as_string (head (get_file_focus ()));
+  string key= latex_command * "\n" * document_root * "\n" * s;
+  array<tree> cached;
+  bool cacheable= latex_preview_cacheable (s);
+  if (cacheable && latex_preview_load (key, cached)) {
+    dbg ("LaTeX preview: reusing the previous pictures");
+    return cached;
+  }
   url wdir= url_temp ("_latex_preview");
   mkdir (wdir);
   bool dvips= false;
   latex_install_preview (s, t, wdir, dvips);
-  string document_root= as_string (head (get_file_focus ()));
   string cmdln= "cd " * document_root;
   cmdln << "; " << latex_command
         << " -interaction nonstopmode -halt-on-error -file-line-error "
@@ -229,6 +283,7 @@ latex_preview (string s, tree t) {
       << " importation might have failed";
     dbg (msg);
   }
+  else if (cacheable) latex_preview_save (key, r);
   latex_clean_tmp_directory (wdir);
   return r;
 } 
@@ -27,7 +27,7 @@ pk_loader::pk_loader (url pk_file_name, tex_font_metric tfm2, int dpi2):
   inputbyte (0), flagbyte (0), bitweight (0), dynf (0),
   repeatcount (0), remainder (0), real_func_flag (true),
   bc (tfm->bc), ec (tfm->ec),
-  char_pos(0), char_flag(0), unpacked(0)
+  char_pos(0), char_flag(0), unpacked(0), char_extents(0)
 {
   (void) load_string (pk_file_name, input_s, true);
   input_pos= 0;
@@ -289,6 +289,7 @@ pk_loader::load_pk () {
   char_pos = tm_new_array<int> (ec+1-bc);
   unpacked = tm_new_array<bool> (ec+1-bc);
   char_flag = tm_new_array<HN> (ec+1-bc);
+  char_extents = tm_new_array<SI> (4*(ec+1-bc));
   for(i=0;i<ec+1-bc;i++) {
     char_pos[i] = 0;
     char_flag[i] = 0;
@@ -382,18 +383,17 @@ pk_loader::load_pk () {
 	// cout << "---> unpacking " << charcode
 	//     << " at " << input_pos 
 	//     << " (start " << startpos << ", length " << length << ")!\n";
-	glyph gl (cwidth, cheight, xoff, yoff);
-
-	/* needed for lazy unpacking */
-	char_pos[((QN) charcode)- bc] = input_pos;
-	char_flag[((QN) charcode)- bc] = flagbyte;
-	unpacked[((QN) charcode)- bc] = false;
+	/* needed for lazy unpacking; glyphs are allocated on first use */
+	int c= ((QN) charcode)- bc;
+	char_pos[c] = input_pos;
+	char_flag[c] = flagbyte;
+	unpacked[c] = false;
+	char_extents[4*c  ] = cwidth;
+	char_extents[4*c+1] = cheight;
+	char_extents[4*c+2] = xoff;
+	char_extents[4*c+3] = yoff;
 	/* skip packed bitmap */
 	input_pos = startpos + length;
-
-	fng [((QN) charcode)- bc]= gl;
-	// cout << "---> " << charcode << " done !\n";
-	// cout << fng [((QN) charcode)- bc] << "\n";
       }
     }
 
@@ -417,16 +417,21 @@ pk_loader::load_pk () {
     }
   }
 
-  int c;
-  for (c=0; c<=ec-bc; c++)
-    if (!is_nil (fng[c])) {
-      SI design_size = tfm->design_size () >> 12;
-      SI display_size= (((design_size*dpi)/72)*PIXEL) >> 8;
-      double unit    = ((double) display_size) / ((double) (1<<20));
-      SI lwidth= (SI) (((double) (tfm->w(c+bc))) * unit);
-      fng[c]->lwidth= ((lwidth+(PIXEL>>1)) / PIXEL);
-    }
-
   bench_cumul ("decode pk");
   return fng;
 }
+
+void
+pk_loader::unpack (glyph& gl, int c) {
+  gl= glyph (char_extents[4*c  ], char_extents[4*c+1],
+             char_extents[4*c+2], char_extents[4*c+3]);
+  SI design_size = tfm->design_size () >> 12;
+  SI display_size= (((design_size*dpi)/72)*PIXEL) >> 8;
+  double unit    = ((double) display_size) / ((double) (1<<20));
+  SI lwidth= (SI) (((double) (tfm->w(c+bc))) * unit);
+  gl->lwidth= ((lwidth+(PIXEL>>1)) / PIXEL);
+  input_pos = char_pos[c];
+  flagbyte  = char_flag[c];
+  unpack (gl);
+  unpacked[c] = true;
+}
@@ -37,6 +37,7 @@ struct pk_loader {
   int*  char_pos;
   HN*   char_flag;
   bool* unpacked;
+  SI*   char_extents; // width, height, xoff and yoff of the characters
   
   pk_loader (url pk_file_name, tex_font_metric tfm, int dpi);
   HI pkbyte ();
@@ -50,6 +51,7 @@ struct pk_loader {
   HN realfunc ();
   HN handlehuge (HN i, HN k);
   void unpack (glyph& gl);
+  void unpack (glyph& gl, int c);
   glyph* load_pk ();
 };
 
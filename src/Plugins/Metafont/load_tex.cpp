@@ -179,13 +179,7 @@ glyph&
 pk_font_glyphs_rep::get(int c)
 {
   if ((c<bc) || (c>ec)) return error_glyph;
-  if (pkl && !pkl->unpacked[c-bc]) {
-    pkl->input_pos = pkl->char_pos[c-bc];
-    pkl->flagbyte  = pkl->char_flag[c-bc];
-    pkl->unpack(fng[c-bc]);
-
-    pkl->unpacked[c-bc] = true;
-  }
+  if (pkl && !pkl->unpacked[c-bc]) pkl->unpack (fng[c-bc], c-bc);
   return fng [c-bc];
 }
 
@@ -18,20 +18,162 @@
 #include "analyze.hpp"
 #include "tm_timer.hpp"
 #include "data_cache.hpp"
+#include "mapped_string.hpp"
+#include "convert.hpp"
+#include "iterator.hpp"
 
 static url the_tfm_path= url_none ();
 static url the_pk_path = url_none ();
 static url the_pfb_path= url_none ();
+static bool tex_paths_pending= false;
+
+static void
+tex_paths_require () {
+  // the font paths are only computed when they are first needed,
+  // since this involves scanning directories and running kpsepath
+  if (!tex_paths_pending) return;
+  tex_paths_pending= false;
+  bench_start ("tex paths");
+  reset_tfm_path (false);
+  reset_pk_path (false);
+  reset_pfb_path ();
+  bench_cumul ("tex paths");
+}
+
+void
+reset_tex_paths () {
+  tex_paths_pending= true;
+}
+
+/******************************************************************************
+* Native index of the font files in the ls-R databases of the TeX trees.
+* Keys are names in the format accepted by kpsewhich; ambiguous names are
+* mapped to the empty string, so that kpsewhich is still asked about them.
+* The index is cached in the TeXmacs home directory and rebuilt whenever
+* one of the ls-R databases is modified, for instance by mktexlsr.
+******************************************************************************/
+
+#define TEX_INDEX "$TEXMACS_HOME_PATH/system/cache/tex_index.tmb"
+
+static hashmap<string,string> tex_index ("");
+static bool tex_index_loaded= false;
+
+static array<string>
+tex_databases () {
+  // the list of ls-R databases is determined once and for all
+  tree t;
+  if (is_cached ("font_cache.scm", "ls-R databases"))
+    t= cache_get ("font_cache.scm", "ls-R databases");
+  else {
+    string r= var_eval_system ("kpsewhich -all ls-R");
+    t= tree (TUPLE);
+    array<string> a= tokenize (r, "\n");
+    for (int i=0; i<N(a); i++)
+      if (a[i] != "") t << tree (a[i]);
+    cache_set ("font_cache.scm", "ls-R databases", t);
+  }
+  array<string> dbs;
+  for (int i=0; i<N(t); i++)
+    if (is_atomic (t[i])) dbs << t[i]->label;
+  return dbs;
+}
+
+static void
+tex_index_insert (hashmap<string,string>& h, string key, string file) {
+  if (!h->contains (key)) h (key)= file;
+  else if (h[key] != file) h (key)= "";
+}
+
+static void
+tex_index_parse (string db, hashmap<string,string>& h) {
+  mapped_string s;
+  if (load_mapped (url_system (db), s)) return;
+  string root= as_string (head (url_system (db)));
+  string dir = root;
+  int i= 0, n= N(s);
+  while (i < n) {
+    int start= i;
+    while (i < n && s[i] != '\n') i++;
+    int end= i++;
+    if (end > start && s[end-1] == '\r') end--;
+    if (end == start || s[start] == '%') continue;
+    char c= s[end-1];
+    if (c == ':') {
+      string d= s (start, end-1);
+      if (d == "." || d == "./") dir= root;
+      else if (starts (d, "./")) dir= root * "/" * d (2, N(d));
+      else if (starts (d, "/")) dir= d;
+      else dir= root * "/" * d;
+      continue;
+    }
+    // only look at the names of tfm, pk, pfb and mf files
+    if (c != 'm' && c != 'k' && c != 'b' && c != 'f') continue;
+    string name= s (start, end);
+    if (ends (name, ".tfm") || ends (name, ".pfb") || ends (name, ".mf"))
+      tex_index_insert (h, name, dir * "/" * name);
+    else if (ends (name, ".pk")) {
+      // pk fonts are looked up as name.dpipk, but stored as dpi/name.pk
+      int k= N(dir);
+      while (k > 0 && dir[k-1] != '/') k--;
+      string sub= dir (k, N(dir));
+      if (starts (sub, "dpi") && is_int (sub (3, N(sub))))
+        tex_index_insert (h, name (0, N(name)-3) * "." * sub (3, N(sub)) * "pk",
+                          dir * "/" * name);
+    }
+    else if (ends (name, "pk"))
+      tex_index_insert (h, name, dir * "/" * name);
+  }
+}
+
+static void
+tex_index_load () {
+  if (tex_index_loaded) return;
+  tex_index_loaded= true;
+  array<string> dbs= tex_databases ();
+  tree stamps (TUPLE);
+  for (int i=0; i<N(dbs); i++)
+    stamps << tuple (dbs[i],
+                     as_string (last_modified (url_system (dbs[i]), false)));
+  string cached;
+  if (exists (TEX_INDEX) && !load_string (TEX_INDEX, cached, false)) {
+    tree t= binary_to_tree (cached);
+    if (is_func (t, TUPLE, 3) && t[0] == stamps && N(t[1]) == N(t[2])) {
+      for (int i=0; i<N(t[1]); i++)
+        tex_index (t[1][i]->label)= t[2][i]->label;
+      return;
+    }
+  }
+  bench_start ("index tex");
+  for (int i=0; i<N(dbs); i++)
+    tex_index_parse (dbs[i], tex_index);
+  tree keys (TUPLE), vals (TUPLE);
+  iterator<string> it= iterate (tex_index);
+  while (it->busy ()) {
+    string key= it->next ();
+    keys << tree (key);
+    vals << tree (tex_index [key]);
+  }
+  (void) save_string (TEX_INDEX, tree_to_binary (tuple (stamps, keys, vals)));
+  bench_cumul ("index tex");
+}
 
 /******************************************************************************
 * Finding a TeX font
 ******************************************************************************/
 
+static hashmap<string,bool> kpsewhich_missed (false);
+
 static string
 kpsewhich (string name) {
+  // only spawn kpsewhich for names which are not in the native index
+  tex_index_load ();
+  string which= tex_index [name];
+  if (which != "" && exists (url_system (which))) return which;
+  if (kpsewhich_missed [name]) return "";
   bench_start ("kpsewhich");
-  string which= var_eval_system ("kpsewhich " * name);
+  which= cached_eval_system ("kpsewhich " * name);
   bench_cumul ("kpsewhich");
+  if (which == "") kpsewhich_missed (name)= true;
   return which;
 }
 
@@ -42,6 +184,7 @@ resolve_tfm (url name) {
     if ((which!="") && exists (url_system (which))) return url_system (which);
     // cout << "Missed " << name << "\n";
   }
+  tex_paths_require ();
   return resolve (the_tfm_path * name);
 }
 
@@ -54,6 +197,7 @@ resolve_pk (url name) {
     // cout << "Missed " << name << "\n";
   }
 #endif
+  tex_paths_require ();
   return resolve (the_pk_path * name);
 }
 
@@ -66,11 +210,13 @@ resolve_pfb (url name) {
     // cout << "Missed " << name << "\n";
   }
 #endif
+  tex_paths_require ();
   return resolve (the_pfb_path * name);
 }
 
 url
 tfm_font_path () {
+  tex_paths_require ();
   return the_tfm_path;
 }
 
@@ -19,6 +19,7 @@ url  tfm_font_path ();
 void reset_tfm_path (bool rehash= true);
 void reset_pk_path  (bool rehash= true);
 void reset_pfb_path ();
+void reset_tex_paths ();
 url  resolve_tex (url name);
 bool exists_in_tex (url font_name);
 
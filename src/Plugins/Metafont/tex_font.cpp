@@ -803,16 +803,21 @@ tex_font_rep::draw_fixed (renderer ren, string s, SI ox, SI y) {
     }
   }
 
+  int k= 0;
+  STACK_NEW_ARRAY (xs, SI, m);
   for (i=0; i<m; i++) {
     int c= buf[i];
     glyph gl= pk->get (c);
     if (is_nil (gl)) continue;
-    ren->draw (c, pk, x, y);
+    buf[k]= c;
+    xs[k++]= x;
     x += conv (tfm->w(c)+ ker[i]);
   }
+  ren->draw_characters (buf, xs, k, pk, y);
   STACK_DELETE_ARRAY (str);
   STACK_DELETE_ARRAY (buf);
   STACK_DELETE_ARRAY (ker);
+  STACK_DELETE_ARRAY (xs);
 }
 
 font
@@ -145,7 +145,5 @@ setup_tex () {
 
 void
 init_tex () {
-  reset_tfm_path (false);
-  reset_pk_path (false);
-  reset_pfb_path ();
+  reset_tex_paths ();
 }
@@ -19,6 +19,7 @@
    
 */
 #include "CFFEmbeddedFontWriter.h"
+#include "EmbeddedFontCache.h"
 #include "ObjectsContext.h"
 #include "InputStringBufferStream.h"
 #include "OutputStreamTraits.h"
@@ -75,7 +76,23 @@ EStatusCode CFFEmbeddedFontWriter::WriteEmbeddedFont(
 
 	do
 	{
-		status = CreateCFFSubset(inFontInfo,inSubsetGlyphIDs,inCIDMapping,inSubsetFontName,notEmbedded,rawFontProgram);
+		// TeXmacs: reuse the subsets of previous exports (see EmbeddedFontCache.h)
+		IEmbeddedFontCache* cache = GetEmbeddedFontCache();
+		std::string cacheKey, cachedProgram;
+		if(cache)
+			cacheKey = MakeEmbeddedFontKey("CFF",inFontInfo,inSubsetGlyphIDs,inSubsetFontName,inCIDMapping);
+		if(cache && cache->GetFontProgram(inFontInfo.GetFontFilePath(),cacheKey,cachedProgram))
+		{
+			rawFontProgram.sputn(cachedProgram.data(),cachedProgram.size());
+			notEmbedded = false;
+			status = PDFHummus::eSuccess;
+		}
+		else
+		{
+			status = CreateCFFSubset(inFontInfo,inSubsetGlyphIDs,inCIDMapping,inSubsetFontName,notEmbedded,rawFontProgram);
+			if(cache && status == PDFHummus::eSuccess && !notEmbedded)
+				cache->SetFontProgram(inFontInfo.GetFontFilePath(),cacheKey,rawFontProgram.str());
+		}
 		if(status != PDFHummus::eSuccess)
 		{
 			TRACE_LOG("CFFEmbeddedFontWriter::WriteEmbeddedFont, failed to write embedded font program");
@@ -59,6 +59,7 @@ DocumentContext::DocumentContext()
 	mObjectsContext = NULL;
 	mParserExtender = NULL;
     mModifiedDocumentIDExists = false;
+	mWriteXrefAsXrefStream = false;
 }
 
 DocumentContext::~DocumentContext(void)
@@ -84,6 +85,10 @@ void DocumentContext::SetEmbedFonts(bool inEmbedFonts) {
 	mUsedFontsRepository.SetEmbedFonts(inEmbedFonts);
 }
 
+void DocumentContext::SetWriteXrefAsXrefStream(bool inWriteXrefAsXrefStream) {
+	mWriteXrefAsXrefStream = inWriteXrefAsXrefStream;
+}
+
 void DocumentContext::SetOutputFileInformation(OutputFile* inOutputFile)
 {
 	// just save the output file path for the ID generation in the end
@@ -215,13 +220,23 @@ EStatusCode	DocumentContext::FinalizeNewPDF()
 		// write encryption dictionary, if encrypting
 		WriteEncryptionDictionary();
 
-		status = mObjectsContext->WriteXrefTable(xrefTablePosition);
-		if(status != 0)
-			break;
+		if(mWriteXrefAsXrefStream)
+		{
+			// TeXmacs: required when objects were written in object streams
+			status = WriteXrefStream(xrefTablePosition);
+			if(status != 0)
+				break;
+		}
+		else
+		{
+			status = mObjectsContext->WriteXrefTable(xrefTablePosition);
+			if(status != 0)
+				break;
 
-		status = WriteTrailerDictionary();
-		if(status != 0)
-			break;
+			status = WriteTrailerDictionary();
+			if(status != 0)
+				break;
+		}
 
 		WriteXrefReference(xrefTablePosition);
 		WriteFinalEOF();
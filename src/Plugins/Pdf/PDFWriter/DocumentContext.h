@@ -115,6 +115,8 @@ namespace PDFHummus
 		void SetObjectsContext(ObjectsContext* inObjectsContext);
 		void SetOutputFileInformation(OutputFile* inOutputFile);
 		void SetEmbedFonts(bool inEmbedFonts);
+		// TeXmacs: end new documents with an xref stream instead of an xref table (PDF 1.5)
+		void SetWriteXrefAsXrefStream(bool inWriteXrefAsXrefStream);
 		PDFHummus::EStatusCode	WriteHeader(EPDFVersion inPDFVersion);
 		PDFHummus::EStatusCode	FinalizeNewPDF();
         PDFHummus::EStatusCode	FinalizeModifiedPDF(PDFParser* inModifiedFileParser,EPDFVersion inModifiedPDFVersion);
@@ -379,6 +381,7 @@ namespace PDFHummus
 		IPDFParserExtender* mParserExtender;
 		PDFDocumentCopyingContextSet mCopyingContexts;
         bool mModifiedDocumentIDExists;
+		bool mWriteXrefAsXrefStream;
         std::string mModifiedDocumentID;
 		std::string mNewPDFID;
 		ObjectIDType mCurrentPageTreeIDInState;
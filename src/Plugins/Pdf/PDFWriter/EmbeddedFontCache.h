@@ -0,0 +1,67 @@
+/*
+   Source File : EmbeddedFontCache.h
+
+
+   This file has been added to PDFWriter for TeXmacs: it allows the
+   embedded font writers to reuse the font subsets of previous exports.
+   The cache itself is provided by the application using SetEmbeddedFontCache;
+   by default there is no cache and the subsets are always recomputed.
+
+*/
+#pragma once
+
+#include "FreeTypeFaceWrapper.h"
+
+#include <string>
+#include <vector>
+#include <sstream>
+
+class IEmbeddedFontCache
+{
+public:
+	virtual ~IEmbeddedFontCache(void) {}
+
+	// inKey determines the font program for the font file at inFontFilePath,
+	// which should be invalidated by the cache when the file is modified
+	virtual bool GetFontProgram(const std::string& inFontFilePath,
+								const std::string& inKey,
+								std::string& outProgram) = 0;
+	virtual void SetFontProgram(const std::string& inFontFilePath,
+								const std::string& inKey,
+								const std::string& inProgram) = 0;
+};
+
+inline IEmbeddedFontCache*& EmbeddedFontCacheInstance()
+{
+	static IEmbeddedFontCache* sCache = NULL;
+	return sCache;
+}
+
+inline void SetEmbeddedFontCache(IEmbeddedFontCache* inCache)
+{
+	EmbeddedFontCacheInstance() = inCache;
+}
+
+inline IEmbeddedFontCache* GetEmbeddedFontCache()
+{
+	return EmbeddedFontCacheInstance();
+}
+
+inline std::string MakeEmbeddedFontKey(const std::string& inKind,
+									   FreeTypeFaceWrapper& inFontInfo,
+									   const std::vector<unsigned int>& inSubsetGlyphIDs,
+									   const std::string& inSubsetFontName,
+									   const std::vector<unsigned short>* inCIDMapping)
+{
+	std::ostringstream key;
+	key << inKind << '\n' << inFontInfo.GetFontIndex() << '\n' << inSubsetFontName << '\n';
+	for (size_t i = 0; i < inSubsetGlyphIDs.size(); ++i)
+		key << inSubsetGlyphIDs[i] << ' ';
+	if (inCIDMapping)
+	{
+		key << '\n';
+		for (size_t i = 0; i < inCIDMapping->size(); ++i)
+			key << (*inCIDMapping)[i] << ' ';
+	}
+	return key.str();
+}
@@ -48,6 +48,8 @@ void IndirectObjectsReferenceRegistry::SetupInitialFreeObject()
     singleFreeObjectInformation.mIsDirty = true;
     singleFreeObjectInformation.mGenerationNumber = 65535;
     singleFreeObjectInformation.mWritePosition = 0;
+	singleFreeObjectInformation.mObjectStream = 0;
+	singleFreeObjectInformation.mObjectStreamIndex = 0;
 	mObjectsWritesRegistry.push_back(singleFreeObjectInformation);
 }
 
@@ -65,6 +67,8 @@ ObjectIDType IndirectObjectsReferenceRegistry::AllocateNewObjectID()
 	newObjectInformation.mObjectReferenceType = ObjectWriteInformation::Used;
     newObjectInformation.mGenerationNumber = 0;
     newObjectInformation.mIsDirty = true;
+	newObjectInformation.mObjectStream = 0;
+	newObjectInformation.mObjectStreamIndex = 0;
 	
 	mObjectsWritesRegistry.push_back(newObjectInformation);
 	return newObjectID;
@@ -98,6 +102,29 @@ EStatusCode IndirectObjectsReferenceRegistry::MarkObjectAsWritten(ObjectIDType i
 	return PDFHummus::eSuccess;
 }
 
+EStatusCode IndirectObjectsReferenceRegistry::MarkObjectAsCompressed(ObjectIDType inObjectID,ObjectIDType inObjectStreamID,unsigned long inIndex)
+{
+	// TeXmacs: the object is part of an object stream, and will be referred to from an xref stream
+	if(mObjectsWritesRegistry.size() <= inObjectID)
+	{
+		TRACE_LOG1("IndirectObjectsReferenceRegistry::MarkObjectAsCompressed, Out of range failure. An Object ID is marked as written, which was not allocated before. ID = %ld",inObjectID);
+		return PDFHummus::eFailure; 
+	}
+
+	if(mObjectsWritesRegistry[inObjectID].mObjectWritten)
+	{
+		TRACE_LOG1("IndirectObjectsReferenceRegistry::MarkObjectAsCompressed, Object rewrite failure. The object %ld was already marked as written",inObjectID);
+		return PDFHummus::eFailure;
+	}
+
+    mObjectsWritesRegistry[inObjectID].mIsDirty = true;
+	mObjectsWritesRegistry[inObjectID].mWritePosition = 0;
+	mObjectsWritesRegistry[inObjectID].mObjectStream = inObjectStreamID;
+	mObjectsWritesRegistry[inObjectID].mObjectStreamIndex = inIndex;
+	mObjectsWritesRegistry[inObjectID].mObjectWritten = true;
+	return PDFHummus::eSuccess;
+}
+
 GetObjectWriteInformationResult IndirectObjectsReferenceRegistry::GetObjectWriteInformation(ObjectIDType inObjectID) const
 {
 	GetObjectWriteInformationResult result;
@@ -271,6 +298,8 @@ EStatusCode IndirectObjectsReferenceRegistry::ReadState(PDFParser* inStateReader
         
         PDFObjectCastPtr<PDFInteger> generationNumber(objectWriteInformationDictionary->QueryDirectObject("mGenerationNumber"));
         newObjectInformation.mGenerationNumber = (unsigned long)generationNumber->GetValue();
+		newObjectInformation.mObjectStream = 0;
+		newObjectInformation.mObjectStreamIndex = 0;
 
 		mObjectsWritesRegistry.push_back(newObjectInformation);
 	}
@@ -298,6 +327,8 @@ void IndirectObjectsReferenceRegistry::AppendExistingItem(
     newObjectInformation.mGenerationNumber = inGenerationNumber;
     newObjectInformation.mIsDirty = false;
     newObjectInformation.mWritePosition = (inObjectReferenceType == ObjectWriteInformation::Used) ? inWritePosition:0;
+	newObjectInformation.mObjectStream = 0;
+	newObjectInformation.mObjectStreamIndex = 0;
 	
 	mObjectsWritesRegistry.push_back(newObjectInformation);
     
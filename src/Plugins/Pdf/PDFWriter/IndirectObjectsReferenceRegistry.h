@@ -56,6 +56,10 @@ struct ObjectWriteInformation
 	EObjectReferenceType mObjectReferenceType;
     // object generation number
     unsigned long mGenerationNumber;
+	// TeXmacs: the object stream which contains the object, or 0. the object
+	// is then the mObjectStreamIndex-th object of that stream
+	ObjectIDType mObjectStream;
+	unsigned long mObjectStreamIndex;
 };
 
 typedef std::pair<bool,ObjectWriteInformation> GetObjectWriteInformationResult;
@@ -70,6 +74,8 @@ public:
 	ObjectIDType AllocateNewObjectID();
 	
 	PDFHummus::EStatusCode MarkObjectAsWritten(ObjectIDType inObjectID,LongFilePositionType inWritePosition);
+	// TeXmacs: objects written inside object streams (see ObjectsContext::WriteObjectStream)
+	PDFHummus::EStatusCode MarkObjectAsCompressed(ObjectIDType inObjectID,ObjectIDType inObjectStreamID,unsigned long inIndex);
 	GetObjectWriteInformationResult GetObjectWriteInformation(ObjectIDType inObjectID) const;
 
 	ObjectIDType GetObjectsCount() const;
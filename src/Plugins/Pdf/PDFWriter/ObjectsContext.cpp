@@ -35,6 +35,8 @@
 #include "EncryptionHelper.h"
 #include "PDFObjectParser.h"
 
+#include <sstream>
+
 using namespace PDFHummus;
 
 ObjectsContext::ObjectsContext(void)
@@ -193,7 +195,13 @@ EStatusCode ObjectsContext::WriteXrefTable(LongFilePositionType& outWritePositio
             {
                 // used object
                 
-                if(objectReference.mObjectWritten)
+                if(objectReference.mObjectWritten && objectReference.mObjectStream != 0)
+                {
+                    // TeXmacs: objects inside object streams require an xref stream
+                    status = PDFHummus::eFailure;
+                    TRACE_LOG1("ObjectsContext::WriteXrefTable, Unexpected Failure. Object of ID = %ld was written in an object stream",i);
+                }
+                else if(objectReference.mObjectWritten)
                 {
                     SAFE_SPRINTF_2(entryBuffer,21,"%010lld %05ld n\r\n",objectReference.mWritePosition,objectReference.mGenerationNumber);
                     mOutputStream->Write((const IOBasicTypes::Byte *)entryBuffer,20);
@@ -599,6 +607,46 @@ void ObjectsContext::Cleanup()
 	mReferencesRegistry.Reset();
 }
 
+EStatusCode ObjectsContext::WriteObjectStream(const ObjectIDTypeAndStringList& inObjects)
+{
+	// TeXmacs: the stream starts with pairs of object numbers and offsets in
+	// the stream data, followed by the objects themselves
+	if(inObjects.empty())
+		return eSuccess;
+
+	std::ostringstream header;
+	std::string data;
+	ObjectIDTypeAndStringList::const_iterator it = inObjects.begin();
+	for(; it != inObjects.end(); ++it)
+	{
+		header<<it->first<<" "<<data.size()<<" ";
+		data.append(it->second);
+		data.append("\n");
+	}
+	header<<"\n";
+	std::string headerString = header.str();
+
+	ObjectIDType streamID = StartNewIndirectObject();
+	DictionaryContext* streamDictionary = StartDictionary();
+	streamDictionary->WriteKey("Type");
+	streamDictionary->WriteNameValue("ObjStm");
+	streamDictionary->WriteKey("N");
+	streamDictionary->WriteIntegerValue(inObjects.size());
+	streamDictionary->WriteKey("First");
+	streamDictionary->WriteIntegerValue(headerString.size());
+	PDFStream* aStream = StartPDFStream(streamDictionary,true);
+	aStream->GetWriteStream()->Write((const Byte*)headerString.data(),headerString.size());
+	aStream->GetWriteStream()->Write((const Byte*)data.data(),data.size());
+	EndPDFStream(aStream);
+	delete aStream;
+
+	EStatusCode status = eSuccess;
+	unsigned long index = 0;
+	for(it = inObjects.begin(); it != inObjects.end() && eSuccess == status; ++it, ++index)
+		status = mReferencesRegistry.MarkObjectAsCompressed(it->first,streamID,index);
+	return status;
+}
+
 void ObjectsContext::SetupModifiedFile(PDFParser* inModifiedFileParser)
 {
     mReferencesRegistry.SetupXrefFromModifiedFile(inModifiedFileParser);
@@ -674,7 +722,14 @@ EStatusCode ObjectsContext::WriteXrefStream(DictionaryContext* inDictionaryConte
             {
                 // used object
                 
-                if(objectReference.mObjectWritten)
+                if(objectReference.mObjectWritten && objectReference.mObjectStream != 0)
+                {
+                    // TeXmacs: object inside an object stream
+                    WriteXrefNumber(aStream->GetWriteStream(),2,typeSize);
+                    WriteXrefNumber(aStream->GetWriteStream(),objectReference.mObjectStream,locationSize);
+                    WriteXrefNumber(aStream->GetWriteStream(),objectReference.mObjectStreamIndex,generationSize);
+                }
+                else if(objectReference.mObjectWritten)
                 {
                     WriteXrefNumber(aStream->GetWriteStream(),1,typeSize);
                     WriteXrefNumber(aStream->GetWriteStream(),objectReference.mWritePosition,locationSize);
@@ -39,6 +39,8 @@ class PDFParser;
 class EncryptionHelper;
 
 typedef std::list<DictionaryContext*> DictionaryContextList;
+typedef std::pair<ObjectIDType,std::string> ObjectIDTypeAndString;
+typedef std::list<ObjectIDTypeAndString> ObjectIDTypeAndStringList;
 
 class ObjectsContext
 {
@@ -57,6 +59,10 @@ public:
 	PDFHummus::EStatusCode WriteXrefTable(LongFilePositionType& outWritePosition);
     // post 1.5 xref writing (only used now for modified files)
     PDFHummus::EStatusCode WriteXrefStream(DictionaryContext* inDictionaryContext);
+	// TeXmacs: write objects, given by their IDs and their serializations, in a
+	// single object stream. the document must then end with an xref stream.
+	// only objects which are not streams and of generation 0 may be written this way
+	PDFHummus::EStatusCode WriteObjectStream(const ObjectIDTypeAndStringList& inObjects);
     
 	// Free Context, for direct writing to output stream
 	IByteWriterWithPosition* StartFreeContext();
@@ -174,6 +174,7 @@ void PDFWriter::SetupCreationSettings(const PDFCreationSettings& inPDFCreationSe
 {
 	mObjectsContext.SetCompressStreams(inPDFCreationSettings.CompressStreams);
 	mDocumentContext.SetEmbedFonts(inPDFCreationSettings.EmbedFonts);
+	mDocumentContext.SetWriteXrefAsXrefStream(inPDFCreationSettings.WriteXrefAsXrefStream);
 }
 
 void PDFWriter::ReleaseLog()
@@ -19,6 +19,7 @@
    
 */
 #include "TrueTypeEmbeddedFontWriter.h"
+#include "EmbeddedFontCache.h"
 #include "FreeTypeFaceWrapper.h"
 #include "ObjectsContext.h"
 #include "DictionaryContext.h"
@@ -56,7 +57,23 @@ EStatusCode TrueTypeEmbeddedFontWriter::WriteEmbeddedFont(
 
 	do
 	{
-		status = CreateTrueTypeSubset(inFontInfo,inSubsetGlyphIDs,notEmbedded,rawFontProgram);
+		// TeXmacs: reuse the subsets of previous exports (see EmbeddedFontCache.h)
+		IEmbeddedFontCache* cache = GetEmbeddedFontCache();
+		std::string cacheKey, cachedProgram;
+		if(cache)
+			cacheKey = MakeEmbeddedFontKey("TrueType",inFontInfo,inSubsetGlyphIDs,"",NULL);
+		if(cache && cache->GetFontProgram(inFontInfo.GetFontFilePath(),cacheKey,cachedProgram))
+		{
+			rawFontProgram.sputn(cachedProgram.data(),cachedProgram.size());
+			notEmbedded = false;
+			status = PDFHummus::eSuccess;
+		}
+		else
+		{
+			status = CreateTrueTypeSubset(inFontInfo,inSubsetGlyphIDs,notEmbedded,rawFontProgram);
+			if(cache && status == PDFHummus::eSuccess && !notEmbedded)
+				cache->SetFontProgram(inFontInfo.GetFontFilePath(),cacheKey,rawFontProgram.str());
+		}
 		if(status != PDFHummus::eSuccess)
 		{
 			TRACE_LOG("TrueTypeEmbeddedFontWriter::WriteEmbeddedFont, failed to write embedded font program");
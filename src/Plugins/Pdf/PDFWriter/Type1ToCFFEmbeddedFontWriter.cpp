@@ -19,6 +19,7 @@
    
 */
 #include "Type1ToCFFEmbeddedFontWriter.h"
+#include "EmbeddedFontCache.h"
 #include "FreeTypeFaceWrapper.h"
 #include "ObjectsContext.h"
 #include "DictionaryContext.h"
@@ -151,7 +152,23 @@ EStatusCode Type1ToCFFEmbeddedFontWriter::WriteEmbeddedFont(
 
 	do
 	{
-		status = CreateCFFSubset(inFontInfo,inSubsetGlyphIDs,inSubsetFontName,notEmbedded,rawFontProgram);
+		// TeXmacs: reuse the subsets of previous exports (see EmbeddedFontCache.h)
+		IEmbeddedFontCache* cache = GetEmbeddedFontCache();
+		std::string cacheKey, cachedProgram;
+		if(cache)
+			cacheKey = MakeEmbeddedFontKey("Type1",inFontInfo,inSubsetGlyphIDs,inSubsetFontName,NULL);
+		if(cache && cache->GetFontProgram(inFontInfo.GetFontFilePath(),cacheKey,cachedProgram))
+		{
+			rawFontProgram.sputn(cachedProgram.data(),cachedProgram.size());
+			notEmbedded = false;
+			status = PDFHummus::eSuccess;
+		}
+		else
+		{
+			status = CreateCFFSubset(inFontInfo,inSubsetGlyphIDs,inSubsetFontName,notEmbedded,rawFontProgram);
+			if(cache && status == PDFHummus::eSuccess && !notEmbedded)
+				cache->SetFontProgram(inFontInfo.GetFontFilePath(),cacheKey,rawFontProgram.str());
+		}
 		if(status != PDFHummus::eSuccess)
 		{
 			TRACE_LOG("Type1ToCFFEmbeddedFontWriter::WriteEmbeddedFont, failed to write embedded font program");
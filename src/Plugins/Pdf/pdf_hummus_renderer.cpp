@@ -26,6 +26,8 @@
 #include "frame.hpp"
 #include "Ghostscript/gs_utilities.hpp" // for gs_prefix
 #include "wencoding.hpp"
+#include "tm_timer.hpp"
+#include "background.hpp"
 
 #ifdef QT_CORE_LIB
 #include <QtCore>
@@ -53,6 +55,8 @@
 #include "PDFWriter/PDFTiledPattern.h"
 #include "PDFWriter/TiledPatternContentContext.h"
 #include "PDFWriter/PDFUsedFont.h"
+#include "PDFWriter/MD5Generator.h"
+#include "PDFWriter/EmbeddedFontCache.h"
  
 /******************************************************************************
  * pdf_hummus_renderer
@@ -106,6 +110,7 @@ class pdf_hummus_renderer_rep : public renderer_rep {
   hashset<string> EuropeanComputerModern_fonts;
   hashmap<string,pdf_raw_image> pdf_glyphs;
   hashmap<tree,pdf_image> image_pool;
+  hashmap<string,pdf_image> content_pool;
   hashmap<tree,pdf_image> pattern_image_pool;
   hashmap<tree,pdf_pattern> pattern_pool;
   hashmap<unsigned long long int,url> picture_cache;
@@ -115,6 +120,8 @@ class pdf_hummus_renderer_rep : public renderer_rep {
   hashmap<int,ObjectIDType> page_id;
   int t3font_registry_id;
   hashmap<string,t3font> t3font_list;
+  hashmap<string,ObjectIDType> glyph_procs; // shared glyph procedures
+  bool trace_glyphs; // draw bitmap glyphs as vector outlines
   
   // link annotation support
   hashmap<ObjectIDType,string> annot_list;
@@ -132,6 +139,23 @@ class pdf_hummus_renderer_rep : public renderer_rep {
   PDFWriter pdfWriter;
   PDFPage* page;
   PageContentContext* contentContext;
+  bool streaming; // write resources as soon as they are first used
+
+  // incremental export
+  bool incremental;
+  hashmap<int,string> page_checksum;
+  hashmap<string,int> previous_pages; // checksums of the previous export
+  url previous_file;                  // copy of the previous export
+  PDFDocumentCopyingContext* previous;
+  int reused_page;                    // page of the previous export or -1
+
+  // small objects such as annotations and destinations may be written
+  // in compressed object streams (PDF 1.5)
+  bool object_streams;
+  ObjectIDTypeAndStringList pending_objects;
+
+  // reorder the finished file for fast web view
+  bool linearize;
   
   // geometry
   
@@ -165,6 +189,12 @@ class pdf_hummus_renderer_rep : public renderer_rep {
   
   void begin_page();
   void end_page();
+  void pause_page ();
+  string pages_header ();
+  void load_previous_pages ();
+  void save_page_checksums ();
+  void write_object (ObjectIDType id, string payload);
+  void flush_objects ();
   
   int get_label_id(string label);
 
@@ -220,6 +250,8 @@ public:
   bool is_printer ();
   bool is_started ();
   void next_page ();
+  bool is_incremental ();
+  bool reuse_page (string checksum);
   
   void set_transformation (frame fr);
   void reset_transformation ();
@@ -277,6 +309,82 @@ write_indirect_obj(ObjectsContext&  objectsContext, ObjectIDType destId, string
 void pdf_image_info (url image, int& w, int& h, PDFRectangle& cropBox, double (&tMat)[6], PDFPageInput& pageInput);
   
 
+/******************************************************************************
+* Caching the font subsets across exports
+*******************************************************************************
+* The font subsets are stored in $TEXMACS_HOME_PATH/system/cache/pdf_fonts,
+* under the MD5 digest of the font file and the key built by PDFWriter from
+* the used glyphs and the subset name. Each entry starts with the font file
+* and its modification time, so that subsets of modified fonts are ignored.
+******************************************************************************/
+
+#define PDF_FONT_MAGIC "TMFS"
+
+class pdf_font_cache: public IEmbeddedFontCache {
+  url file (const std::string& path, const std::string& key) {
+    MD5Generator md5;
+    md5.Accumulate (path);
+    md5.Accumulate (key);
+    string name (md5.ToHexString ().c_str ());
+    return get_texmacs_home_path () * url ("system/cache/pdf_fonts") *
+           url (name * ".bin"); }
+  string header (const std::string& path, const std::string& key) {
+    string h (PDF_FONT_MAGIC);
+    marshall_string (h, TEXMACS_VERSION);
+    marshall_string (h, string (path.c_str ()));
+    int stamp= last_modified (url_system (path.c_str ()), false);
+    marshall_number (h, (unsigned long int) stamp);
+    marshall_string (h, string (key.data (), (int) key.size ()));
+    return h; }
+
+public:
+  bool GetFontProgram (const std::string& path, const std::string& key,
+                       std::string& program) {
+    string s, h= header (path, key);
+    if (load_string (file (path, key), s, false)) return false;
+    if (N(s) < N(h) || s (0, N(h)) != h) return false;
+    c_string buf (s (N(h), N(s)));
+    program.assign ((char*) buf, N(s) - N(h));
+    return true; }
+  void SetFontProgram (const std::string& path, const std::string& key,
+                       const std::string& program) {
+    url u= file (path, key);
+    mkdir (head (u));
+    string s= header (path, key);
+    s << string (program.data (), (int) program.size ());
+    (void) save_string (u, s); }
+};
+
+static pdf_font_cache the_pdf_font_cache;
+
+/******************************************************************************
+* Object streams
+******************************************************************************/
+
+#define PDF_OBJECTS_PER_STREAM 200
+
+void
+pdf_hummus_renderer_rep::write_object (ObjectIDType id, string payload) {
+  if (!object_streams) {
+    write_indirect_obj (pdfWriter.GetObjectsContext(), id, payload);
+    return;
+  }
+  c_string buf (payload);
+  pending_objects.push_back (ObjectIDTypeAndString (id, std::string ((char*) buf, N(payload))));
+  if (pending_objects.size () >= PDF_OBJECTS_PER_STREAM) flush_objects ();
+}
+
+void
+pdf_hummus_renderer_rep::flush_objects () {
+  // object streams are kept small, so that viewers do not need to
+  // decompress large streams for accessing a single object
+  if (pending_objects.empty ()) return;
+  EStatusCode status= pdfWriter.GetObjectsContext().WriteObjectStream (pending_objects);
+  if (status != PDFHummus::eSuccess)
+    convert_error << "Failed to write object stream\n";
+  pending_objects.clear ();
+}
+
 /******************************************************************************
 * constructors and destructors
 ******************************************************************************/
@@ -297,8 +405,17 @@ pdf_hummus_renderer_rep::pdf_hummus_renderer_rep (
     native_fonts (NULL),
     destId(0),
     t3font_registry_id(-1),
+    glyph_procs (0),
+    trace_glyphs (get_preference ("texmacs->pdf:trace glyphs", "off") == "on"),
     label_count(0),
-    outlineId(0)
+    outlineId(0),
+    page (NULL), contentContext (NULL),
+    streaming (get_preference ("texmacs->pdf:streaming", "off") == "on"),
+    incremental (get_preference ("texmacs->pdf:incremental", "off") == "on"),
+    page_checksum (""), previous_pages (-1),
+    previous_file (url_none ()), previous (NULL), reused_page (-1),
+    object_streams (get_preference ("texmacs->pdf:object streams", "off") == "on"),
+  linearize (get_preference ("texmacs->pdf:linearize", "off") == "on")
 {
   width = default_dpi * paper_w / 2.54;
   height= default_dpi * paper_h / 2.54;
@@ -311,10 +428,13 @@ pdf_hummus_renderer_rep::pdf_hummus_renderer_rep (
   if (version == "1.5") ePDFVersion= ePDFVersion15;
   if (version == "1.6") ePDFVersion= ePDFVersion16;
   if (version == "1.7") ePDFVersion= ePDFVersion17;
+  if (object_streams && ePDFVersion < ePDFVersion15) ePDFVersion= ePDFVersion15;
+  // the previous export is overwritten by StartPDF
+  if (incremental) load_previous_pages ();
   // LogConfiguration log (true, true, "PDFWriterLog.txt");
   LogConfiguration log= LogConfiguration::DefaultLogConfiguration();
   bool compress= true;
-  PDFCreationSettings settings (compress, true); //, EncryptionOptions("user", 4, "owner"));
+  PDFCreationSettings settings (compress, true, EncryptionOptions::DefaultEncryptionOptions(), object_streams); //, EncryptionOptions("user", 4, "owner"));
     status = pdfWriter.StartPDF(as_charp(concretize (pdf_file_name)), ePDFVersion, log, settings);
 	if (status != PDFHummus::eSuccess) {
 		convert_error << "failed to start PDF\n";
@@ -357,9 +477,29 @@ pdf_hummus_renderer_rep::pdf_hummus_renderer_rep (
 	}
 }
 
+static void
+linearize_pdf (url u) {
+  // PDFHummus only writes non linearized files, which viewers have to
+  // download entirely before showing the first page.  qpdf rewrites them
+  // with the first page objects and the hint tables in front.
+  if (!exists_in_path ("qpdf")) {
+    convert_warning << "qpdf not found, " << u << " was not linearized\n";
+    return;
+  }
+  url tmp= url_temp (".pdf");
+  string cmd= "qpdf --linearize --warning-exit-0 ";
+  cmd << sys_concretize (u) << " " << sys_concretize (tmp);
+  if (system (cmd) == 0 && exists (tmp)) move (tmp, u);
+  else {
+    convert_error << "failed to linearize " << u << "\n";
+    if (exists (tmp)) remove (tmp);
+  }
+}
+
 pdf_hummus_renderer_rep::~pdf_hummus_renderer_rep () {
   if (!started) return; // no cleanup to do
   end_page();
+  if (previous != NULL) delete previous;
   
   flush_images();
   flush_patterns();
@@ -372,35 +512,37 @@ pdf_hummus_renderer_rep::~pdf_hummus_renderer_rep () {
   {
     // flush alphas
     iterator<int> it = iterate(alpha_id);
-    ObjectsContext& objectsContext = pdfWriter.GetObjectsContext();
     while (it->busy()) {
       int a = it->next();
       double da = ((double) a)/1000.0;
-      objectsContext.StartNewIndirectObject(alpha_id(a));
-      {
-        std::stringstream buf;
-        buf << "<< /Type /ExtGState /CA "<< da << "  /ca "<< da << " >>\r\n";
-        objectsContext.StartFreeContext()->Write((const IOBasicTypes::Byte* )(buf.str().c_str()),buf.str().size());
-        objectsContext.EndFreeContext();
-      }
-      objectsContext.EndIndirectObject();
+      std::stringstream buf;
+      buf << "<< /Type /ExtGState /CA "<< da << "  /ca "<< da << " >>\r\n";
+      write_object (alpha_id(a), string (buf.str().c_str()));
     }
   }
   
   {
     // flush annotations
     iterator<ObjectIDType> it = iterate(annot_list);
-    ObjectsContext& objectsContext = pdfWriter.GetObjectsContext();
     while (it->busy()) {
       ObjectIDType id = it->next();
-      write_indirect_obj(objectsContext, id, annot_list(id));
+      write_object (id, annot_list(id));
     }
   }
+  flush_objects ();
   
+  // the font subsets are written when ending the document
+  SetEmbeddedFontCache (&the_pdf_font_cache);
   EStatusCode status = pdfWriter.EndPDF();
+  SetEmbeddedFontCache (NULL);
   if (status != PDFHummus::eSuccess) {
     convert_error << "Failed in end PDF\n";
   }
+  else {
+    if (incremental) save_page_checksums ();
+    if (linearize) linearize_pdf (pdf_file_name);
+  }
+  if (!is_none (previous_file)) remove (previous_file);
 
   // remove temporary pictures
   for (int i=0; i<N(temp_images); i++)
@@ -425,6 +567,93 @@ pdf_hummus_renderer_rep::next_page () {
   begin_page();
 }
 
+/******************************************************************************
+* Incremental export
+*******************************************************************************
+* When exporting incrementally, the checksums of the pages are stored in
+* $TEXMACS_HOME_PATH/system/cache/pdf_pages, under the MD5 digest of the
+* name of the exported file, together with its modification time. Pages
+* with the same checksum in the next export of the same file are copied
+* from the previous version of the file instead of being written again.
+******************************************************************************/
+
+#define PDF_PAGES_MAGIC "TMPC"
+
+static url
+pdf_pages_file (url u) {
+  MD5Generator md5;
+  c_string buf (as_string (u));
+  md5.Accumulate (std::string ((char*) buf));
+  string name (md5.ToHexString ().c_str ());
+  return get_texmacs_home_path () * url ("system/cache/pdf_pages") *
+         url (name * ".bin");
+}
+
+string
+pdf_hummus_renderer_rep::pages_header () {
+  string h (PDF_PAGES_MAGIC);
+  marshall_string (h, TEXMACS_VERSION);
+  marshall_string (h, as_string (dpi) * ":" * page_type * ":" *
+                      as_string (paper_w) * "x" * as_string (paper_h));
+  return h;
+}
+
+void
+pdf_hummus_renderer_rep::load_previous_pages () {
+  string s, h= pages_header ();
+  if (load_string (pdf_pages_file (pdf_file_name), s, false)) return;
+  if (N(s) < N(h) || s (0, N(h)) != h) return;
+  int pos= N(h);
+  int stamp= (int) unmarshall_number (s, pos);
+  if (!is_regular (pdf_file_name) ||
+      last_modified (pdf_file_name, false) != stamp) return;
+  int i, n= (int) unmarshall_number (s, pos);
+  for (i=0; i<n && pos<N(s); i++) {
+    string chk= unmarshall_string (s, pos);
+    if (chk != "" && !previous_pages->contains (chk)) previous_pages (chk)= i;
+  }
+  if (N(previous_pages) == 0) return;
+  previous_file= url_temp (".pdf");
+  copy (pdf_file_name, previous_file);
+  if (!is_regular (previous_file)) {
+    previous_file= url_none ();
+    previous_pages= hashmap<string,int> (-1);
+  }
+}
+
+void
+pdf_hummus_renderer_rep::save_page_checksums () {
+  url u= pdf_pages_file (pdf_file_name);
+  string s= pages_header ();
+  marshall_number (s, (unsigned long int) last_modified (pdf_file_name, false));
+  marshall_number (s, (unsigned long int) page_num);
+  for (int i=0; i<page_num; i++)
+    marshall_string (s, page_checksum[i]);
+  mkdir (head (u));
+  (void) save_string (u, s);
+}
+
+bool
+pdf_hummus_renderer_rep::is_incremental () {
+  return incremental;
+}
+
+bool
+pdf_hummus_renderer_rep::reuse_page (string checksum) {
+  page_checksum (page_num)= checksum;
+  if (!previous_pages->contains (checksum)) return false;
+  if (previous == NULL) {
+    c_string path (concretize (previous_file));
+    previous= pdfWriter.CreatePDFCopyingContext ((char*) path);
+    if (previous == NULL) {
+      previous_pages= hashmap<string,int> (-1);
+      return false;
+    }
+  }
+  reused_page= previous_pages[checksum];
+  return true;
+}
+
 void
 pdf_hummus_renderer_rep::begin_page() {
   //EStatusCode status;
@@ -476,7 +705,16 @@ pdf_hummus_renderer_rep::end_page(){
     convert_error << "Failed to end page content context\n";
   }
   
-  EStatusCodeAndObjectIDType res = pdfWriter.GetDocumentContext().WritePageAndRelease(page);
+  EStatusCodeAndObjectIDType res;
+  if (reused_page >= 0) {
+    // copy the page from the previous export; its hyperlinks have been
+    // registered again for the copy
+    delete page;
+    res = previous->AppendPDFPageFromPDF(reused_page);
+    reused_page = -1;
+  }
+  else
+    res = pdfWriter.GetDocumentContext().WritePageAndRelease(page);
   status = res.first;
   if (status != PDFHummus::eSuccess) {
     convert_error << "Failed to write page and release\n";
@@ -506,6 +744,14 @@ pdf_hummus_renderer_rep::end_text () {
   }
 }
 
+void
+pdf_hummus_renderer_rep::pause_page () {
+  // flush the current content stream, so that other objects can be written
+  // (the page content may be split anywhere between two operators)
+  if (contentContext != NULL)
+    pdfWriter.PausePageContentContext (contentContext);
+}
+
 /******************************************************************************
  * Transformed rendering
  ******************************************************************************/
@@ -581,14 +827,21 @@ public:
   url u;
   int w,h;
   ObjectIDType id;
+  string digest; // of the contents of the image file
+  url converted; // conversion to PDF which was done beforehand
+  bool flushed;  // the image has already been written
   
-  pdf_image_rep(url _u, ObjectIDType _id)
-    : u(_u), id(_id)
+  pdf_image_rep(url _u, ObjectIDType _id, string _digest= "")
+    : u(_u), id(_id), digest (_digest), converted (url_none ()),
+      flushed (false)
   { image_size (u, w, h); } 
   ~pdf_image_rep() {}
 
+  url  source ();
+  url  cached ();
+  bool needs_conversion ();
   bool flush_jpg (PDFWriter& pdfw, url image);
-  bool flush_raster (PDFWriter& pdfw, url image);
+  bool flush_png (PDFWriter& pdfw, url image);
   void flush (PDFWriter& pdfw);
 
   bool flush_for_pattern (PDFWriter& pdfw);
@@ -596,8 +849,8 @@ public:
 
 class pdf_image {
   CONCRETE_NULL(pdf_image);
-  pdf_image (url _u, ObjectIDType _id):
-    rep (tm_new<pdf_image_rep> (_u,_id)) {};
+  pdf_image (url _u, ObjectIDType _id, string _digest= ""):
+    rep (tm_new<pdf_image_rep> (_u,_id,_digest)) {};
 };
 
 CONCRETE_NULL_CODE(pdf_image);
@@ -1060,28 +1313,37 @@ public:
   ObjectIDType fontId;
   ObjectsContext &objectsContext;
   hashmap<int, int> used_chars;
+  hashmap<int, ObjectIDType> char_ids; // glyphs which were already written
+  hashmap<string, ObjectIDType> procs; // procedures shared by all t3 fonts
+  bool trace; // draw the glyphs as vector outlines instead of bitmaps
   int firstchar;
   int lastchar;
   int b0,b1,b2,b3; // glyph bounding box
   bool first_glyph;
   
   t3font_rep (font_glyphs _fn, int _font_chunk,
-	      ObjectsContext &_objectsContext)
+	      ObjectsContext &_objectsContext,
+	      hashmap<string, ObjectIDType> _procs, bool _trace)
     : fn (_fn), font_chunk (_font_chunk),
-      objectsContext (_objectsContext), first_glyph (true) {
+      objectsContext (_objectsContext), char_ids (0),
+      procs (_procs), trace (_trace), first_glyph (true) {
     fontId = objectsContext.GetInDirectObjectsRegistry()
                .AllocateNewObjectID(); }  
   void update_bbox (int llx, int lly, int urx, int ury);
   void add_glyph (int ch) {  used_chars (ch) = 1; }
-  void write_char (glyph gl, ObjectIDType inCharID);
+  void write_glyph (int ch);
+  string char_procedure (glyph gl);
+  void write_char (string data, ObjectIDType inCharID);
   void write_definition (int& registry_id);
 };
 
 class t3font {
   CONCRETE_NULL(t3font);
   t3font (font_glyphs _fn, int _font_chunk,
-	  ObjectsContext &_objectsContext)
-    : rep (tm_new<t3font_rep> (_fn, _font_chunk,_objectsContext)) {};
+	  ObjectsContext &_objectsContext,
+	  hashmap<string, ObjectIDType> _procs, bool _trace)
+    : rep (tm_new<t3font_rep> (_fn, _font_chunk,_objectsContext,
+                               _procs, _trace)) {};
 };
 
 CONCRETE_NULL_CODE(t3font);
@@ -1099,8 +1361,53 @@ t3font_rep::update_bbox (int llx, int lly, int urx, int ury) {
   }
 }
 
-void
-t3font_rep::write_char (glyph gl, ObjectIDType inCharID) {
+static string
+glyph_outline (glyph gl, int llx, int lly) {
+  // the ink of a bitmap glyph as a union of rectangles in glyph space,
+  // where runs of pixels with the same extent in consecutive rows are
+  // merged into a single rectangle
+  string r;
+  int w= gl->width, h= gl->height;
+  array<int> start, end, top; // rectangles which are still open
+  for (int j=0; j<=h; j++) {
+    array<int> s, e;
+    if (j < h)
+      for (int i=0; i<w; i++)
+        if (gl->get_x (i, j) != 0) {
+          int k= i;
+          while (k < w && gl->get_x (k, j) != 0) k++;
+          s << i; e << k;
+          i= k;
+        }
+    array<int> nstart, nend, ntop;
+    int k;
+    for (int l=0; l<N(start); l++) {
+      for (k=0; k<N(s); k++)
+        if (s[k] == start[l] && e[k] == end[l]) break;
+      if (k < N(s)) {
+        nstart << start[l]; nend << end[l]; ntop << top[l];
+        s[k]= -1;
+      }
+      else
+        r << as_string (llx + start[l]) << " " << as_string (lly + h - j)
+          << " " << as_string (end[l] - start[l])
+          << " " << as_string (j - top[l]) << " re\r\n";
+    }
+    for (k=0; k<N(s); k++)
+      if (s[k] >= 0) { nstart << s[k]; nend << e[k]; ntop << j; }
+    start= nstart; end= nend; top= ntop;
+  }
+  return r;
+}
+
+string
+t3font_rep::char_procedure (glyph gl) {
+  string data;
+  if (is_nil (gl)) {
+    // write d0 command
+    data  << "0 0 d0\r\n";
+    return data;
+  }
   int llx, lly, urx, ury, cwidth, cheight, lwidth;
   llx = -gl->xoff;
   lly = gl->yoff-gl->height+1;
@@ -1109,50 +1416,69 @@ t3font_rep::write_char (glyph gl, ObjectIDType inCharID) {
   cwidth = gl->width;
   cheight = gl->height;
   lwidth = gl->lwidth;
-  
+  update_bbox (llx, lly, urx, ury);
+  data << as_string (lwidth) << " 0 ";
+  data << as_string (llx) << " " << as_string (lly) << " "
+       << as_string (urx) << " " << as_string (ury) << " d1\r\n";
+  if (trace) {
+    string outline= glyph_outline (gl, llx, lly);
+    if (N(outline) != 0) data << outline << "f\r\n";
+    return data;
+  }
+  data << "q\r\n";
+  data  << as_string ((double)(cwidth)) << " 0 0 "
+        << as_string ((double)(cheight)) << " "
+        << as_string ((double)(llx)) << " "
+        << as_string (lly) << " cm\r\n";
+  data << "BI\r\n/W " << as_string (cwidth)
+       << "\r\n/H " << as_string (cheight) << "\r\n";
+  data << "/CS /G /BPC 1 /F /AHx /D [0.0 1.0] /IM true\r\nID\r\n";
+  static const char* hex_string= "0123456789ABCDEF";
+  string hex_code;
+  int i, j, count= 0, cur= 0;
+  for (j= 0; j < cheight; j++)
+    for ( i= 0; i < ((cwidth+7) & (-8)); i++) {
+      cur= cur << 1;
+      if ((i < cwidth) && (gl->get_x(i,j) == 0)) cur++;
+      count++;
+      if (count == 4) {
+        hex_code << hex_string[cur];
+        cur  = 0;
+        count= 0;
+      }
+    }
+  data << hex_code;
+  data << ">\r\nEI\r\nQ\r\n"; // ">" is the EOD char for ASCIIHex
+  return data;
+}
+
+void
+t3font_rep::write_char (string data, ObjectIDType inCharID) {
   objectsContext.StartNewIndirectObject(inCharID);
   // write char stream
   PDFStream *charStream = objectsContext.StartPDFStream(NULL, true);
-  string data;
-  if (is_nil (gl)) {
-    // write d0 command
-    data  << "0 0 d0\r\n";
-  } else {
-    update_bbox (llx, lly, urx, ury);
-    data << as_string (lwidth) << " 0 ";
-    data << as_string (llx) << " " << as_string (lly) << " "
-	 << as_string (urx) << " " << as_string (ury) << " d1\r\n";
-    data << "q\r\n";
-    data  << as_string ((double)(cwidth)) << " 0 0 "
-	  << as_string ((double)(cheight)) << " "
-	  << as_string ((double)(llx)) << " "
-	  << as_string (lly) << " cm\r\n";
-    data << "BI\r\n/W " << as_string (cwidth)
-	 << "\r\n/H " << as_string (cheight) << "\r\n";
-    data << "/CS /G /BPC 1 /F /AHx /D [0.0 1.0] /IM true\r\nID\r\n";
-    static const char* hex_string= "0123456789ABCDEF";
-    string hex_code;
-    int i, j, count= 0, cur= 0;
-    for (j= 0; j < cheight; j++)
-      for ( i= 0; i < ((cwidth+7) & (-8)); i++) {
-	cur= cur << 1;
-	if ((i < cwidth) && (gl->get_x(i,j) == 0)) cur++;
-	count++;
-	if (count == 4) {
-	  hex_code << hex_string[cur];
-	  cur  = 0;
-	  count= 0;
-	}
-      }
-    data << hex_code;
-    data << ">\r\nEI\r\nQ\r\n"; // ">" is the EOD char for ASCIIHex
-  }
   c_string buf (data);
   charStream->GetWriteStream()->Write((unsigned char *)(char*)buf, N(data));
   objectsContext.EndPDFStream(charStream); // It does the EndIndirectObject()
   delete charStream;
 }
 
+void
+t3font_rep::write_glyph (int ch) {
+  // write the procedure of a glyph at once, keeping only its identifier;
+  // identical procedures for other fonts and sizes are written only once
+  if (char_ids->contains (ch)) return;
+  string data= char_procedure (fn->get (ch));
+  if (!procs->contains (data)) {
+    ObjectIDType id=
+      objectsContext.GetInDirectObjectsRegistry().AllocateNewObjectID();
+    write_char (data, id);
+    procs (data)= id;
+  }
+  char_ids (ch)= procs[data];
+  add_glyph (ch);
+}
+
 void
 t3font_rep::write_definition (int& registry_id) {
   array <int> glyph_list;
@@ -1176,11 +1502,8 @@ t3font_rep::write_definition (int& registry_id) {
   for (int i = 0; i < N(glyph_list); ++i) {
     int ch = t3font_get_global_glyph (glyph_list[i],
 				      font_chunk, fn->res_name);
-    glyph gl = fn->get (ch);
-    ObjectIDType temp=
-      objectsContext.GetInDirectObjectsRegistry().AllocateNewObjectID();
-    charIds << temp;
-    write_char (gl, temp);
+    if (!char_ids->contains (ch)) write_glyph (ch);
+    charIds << char_ids[ch];
   }
   ObjectIDType tounicodeId;
   // create font dictionary
@@ -1453,7 +1776,8 @@ pdf_hummus_renderer_rep::draw (int ch, font_glyphs fn, SI x, SI y) {
       if (!t3font_list->contains (fontname)) {
 	//cout << "create t3font for chunk " << fontchunk
 	//     << " of " << fn->res_name << LF;
-	t3font f (fn, fontchunk, pdfWriter.GetObjectsContext());
+	t3font f (fn, fontchunk, pdfWriter.GetObjectsContext(),
+		  glyph_procs, trace_glyphs);
 	t3font_list (fontchunkname) = f;
       }
     }
@@ -1478,6 +1802,10 @@ pdf_hummus_renderer_rep::draw (int ch, font_glyphs fn, SI x, SI y) {
   }
   else
     cfid= native_fonts (fontname);
+  if (streaming && cfid == NULL && !t3font_list(cfn)->char_ids->contains (ch)) {
+    pause_page ();
+    t3font_list(cfn)->write_glyph (ch);
+  }
   begin_text ();
   contentContext->Td (to_x(x) - prev_text_x, to_y(y) - prev_text_y);
   prev_text_x = to_x(x);
@@ -1681,13 +2009,39 @@ pdf_hummus_renderer_rep::polygon (array<SI> x, array<SI> y, bool convex) {
     contentContext->fStar(); // nonzero winding
 }
 
-void
-pdf_image_rep::flush (PDFWriter& pdfw)
-{
+url
+pdf_image_rep::source () {
   url name= resolve (u);
   if (is_none (name))
     name= "$TEXMACS_PATH/misc/pixmaps/unknown.ps";
-  
+  return name;
+}
+
+url
+pdf_image_rep::cached () {
+  // the conversion to PDF of the image in the disk cache
+  if (digest == "") return url_none ();
+  string name= digest * "-" * as_string (w) * "x" * as_string (h) * ".pdf";
+  return get_texmacs_home_path () * url ("system/cache/pdf_images") *
+         url (name);
+}
+
+static bool png_passthrough (url image);
+
+bool
+pdf_image_rep::needs_conversion () {
+  // images which are converted to PDF by image_to_pdf
+  string s= suffix (source ());
+  if (s == "pdf" || s == "jpg" || s == "jpeg") return false;
+  if (s == "png" && png_passthrough (source ())) return false;
+  url c= cached ();
+  return is_none (c) || !is_regular (c);
+}
+
+void
+pdf_image_rep::flush (PDFWriter& pdfw)
+{
+  url name= source ();
   url temp;
   string s= suffix (name);
   // debug_convert << "flushing :" << fname << LF;
@@ -1713,14 +2067,28 @@ pdf_image_rep::flush (PDFWriter& pdfw)
   else {
     temp= url_temp (".pdf");
     // first try to work out inclusion using our own tools
-    // note that we have to return since flush_raster and flush_jpg
+    // note that we have to return since flush_png and flush_jpg
     // already build the appopriate Form XObject into the PDF
   
     if ((s == "jpg") || (s == "jpeg")) 
       if (flush_jpg(pdfw, name)) return;
+    if (s == "png" && is_none (converted))
+      if (flush_png(pdfw, name)) return;
           
     // other formats we generate a pdf (with available converters) that we'll embbed
-    image_to_pdf (name, temp, w, h, 300);
+    url c= cached ();
+    if (!is_none (c) && is_regular (c)) {
+      temp= c;
+      name= url_none ();
+    }
+    else {
+      if (!is_none (converted)) temp= converted;
+      else image_to_pdf (name, temp, w, h, 300);
+      if (!is_none (c) && is_regular (temp)) {
+        mkdir (head (c));
+        copy (temp, c);
+      }
+    }
     // the 300 dpi setting is the maximum dpi of raster images that will be generated:
     // images that are to dense will de downsampled to keep file small
     // (other are not up-sampled) 
@@ -1964,14 +2332,200 @@ pdf_image_rep::flush_jpg (PDFWriter& pdfw, url image) {
   return status == eSuccess;
 }
 
+/******************************************************************************
+* PNG images are embedded without decompressing them whenever their data
+* stream can be read by the PDF FlateDecode filter with the PNG predictors,
+* that is for non interlaced images without alpha channel
+******************************************************************************/
+
+static const std::string scDecodeParms = "DecodeParms";
+static const std::string scFlateDecode = "FlateDecode";
+
+static inline unsigned int
+png_uint (string s, int i) {
+  return (((unsigned int) (unsigned char) s[i  ]) << 24) |
+         (((unsigned int) (unsigned char) s[i+1]) << 16) |
+         (((unsigned int) (unsigned char) s[i+2]) <<  8) |
+          ((unsigned int) (unsigned char) s[i+3]);
+}
+
+static inline int
+png_short (string s, int i) {
+  return (((int) (unsigned char) s[i]) << 8) | ((int) (unsigned char) s[i+1]);
+}
+
+static bool
+png_header (string s, int& w, int& h, int& depth, int& colors, int& type) {
+  if (N(s) < 33 || s (0, 8) != "\211PNG\r\n\032\n" || s (12, 16) != "IHDR")
+    return false;
+  w= (int) png_uint (s, 16);
+  h= (int) png_uint (s, 20);
+  depth= (int) (unsigned char) s[24];
+  type = (int) (unsigned char) s[25];
+  // compression, filter and interlace methods
+  if (s[26] != 0 || s[27] != 0 || s[28] != 0) return false;
+  if (w <= 0 || h <= 0) return false;
+  if (depth == 16 && (type == 3 || ePDFVersion < ePDFVersion15)) return false;
+  if (type == 0 || type == 3) colors= 1;
+  else if (type == 2) colors= 3;
+  else return false; // images with an alpha channel need a soft mask
+  return true;
+}
+
+static bool
+png_passthrough (url image) {
+  // only the header is inspected; flush_png falls back on image_to_pdf
+  // if the chunks cannot be embedded either
+  string s;
+  if (load_string (image, s, false)) return false;
+  int w, h, depth, colors, type;
+  return png_header (s, w, h, depth, colors, type);
+}
+
+bool
+pdf_image_rep::flush_png (PDFWriter& pdfw, url image) {
+  string s;
+  if (load_string (image, s, false)) return false;
+  int iw, ih, depth, colors, type;
+  if (!png_header (s, iw, ih, depth, colors, type)) return false;
+  string data, palette, trns;
+  int i= 8;
+  while (i + 12 <= N(s)) {
+    unsigned int len= png_uint (s, i);
+    if (len > (unsigned int) (N(s) - i - 12)) return false;
+    string tag= s (i+4, i+8);
+    if (tag == "IDAT") data << s (i+8, i+8+len);
+    else if (tag == "PLTE") palette= s (i+8, i+8+len);
+    else if (tag == "tRNS") trns= s (i+8, i+8+len);
+    else if (tag == "IEND") break;
+    i += 12 + len;
+  }
+  if (N(data) == 0) return false;
+  if (type == 3 && (N(palette) < 3 || N(palette) % 3 != 0)) return false;
+  // transparent palette entries need a soft mask
+  if (type == 3 && N(trns) != 0) return false;
+  if (N(trns) != 0 && N(trns) != 2 * colors) return false;
+
+  ObjectsContext& objectsContext = pdfw.GetObjectsContext();
+  ObjectIDType imageId= objectsContext.GetInDirectObjectsRegistry()
+                                      .AllocateNewObjectID();
+  objectsContext.StartNewIndirectObject(imageId);
+  DictionaryContext* imageContext = objectsContext.StartDictionary();
+  imageContext->WriteKey(scType);
+  imageContext->WriteNameValue(scXObject);
+  imageContext->WriteKey(scSubType);
+  imageContext->WriteNameValue(scImage);
+  imageContext->WriteKey(scWidth);
+  imageContext->WriteIntegerValue(iw);
+  imageContext->WriteKey(scHeight);
+  imageContext->WriteIntegerValue(ih);
+  imageContext->WriteKey(scBitsPerComponent);
+  imageContext->WriteIntegerValue(depth);
+  imageContext->WriteKey(scColorSpace);
+  if (type == 0) imageContext->WriteNameValue(scDeviceGray);
+  else if (type == 2) imageContext->WriteNameValue(scDeviceRGB);
+  else {
+    objectsContext.StartArray();
+    objectsContext.WriteName("Indexed");
+    objectsContext.WriteName(scDeviceRGB);
+    objectsContext.WriteInteger(N(palette) / 3 - 1);
+    objectsContext.WriteHexString(std::string ((char*) &palette[0], N(palette)));
+    objectsContext.EndArray();
+    objectsContext.EndLine();
+  }
+  if (N(trns) != 0) {
+    // a single transparent color is a color key mask
+    imageContext->WriteKey("Mask");
+    objectsContext.StartArray();
+    for (int c=0; c<colors; c++) {
+      objectsContext.WriteInteger(png_short (trns, 2*c));
+      objectsContext.WriteInteger(png_short (trns, 2*c));
+    }
+    objectsContext.EndArray();
+    objectsContext.EndLine();
+  }
+  imageContext->WriteKey(scFilter);
+  imageContext->WriteNameValue(scFlateDecode);
+  imageContext->WriteKey(scDecodeParms);
+  DictionaryContext* parmsContext = objectsContext.StartDictionary();
+  parmsContext->WriteKey("Predictor");
+  parmsContext->WriteIntegerValue(15);
+  parmsContext->WriteKey("Colors");
+  parmsContext->WriteIntegerValue(colors);
+  parmsContext->WriteKey(scBitsPerComponent);
+  parmsContext->WriteIntegerValue(depth);
+  parmsContext->WriteKey("Columns");
+  parmsContext->WriteIntegerValue(iw);
+  objectsContext.EndDictionary(parmsContext);
+  PDFStream* imageStream = objectsContext.StartUnfilteredPDFStream(imageContext);
+  OutputStreamTraits outputTraits(imageStream->GetWriteStream());
+  c_string buf (data);
+  InputByteArrayStream reader((IOBasicTypes::Byte*)(char *)buf, N(data));
+  EStatusCode status = outputTraits.CopyToOutputStream(&reader);
+  objectsContext.EndPDFStream(imageStream); // It does EndIndirectObject();
+  delete imageStream;
+  if (status != PDFHummus::eSuccess) return false;
+
+  PDFFormXObject* xobjectForm = pdfw.StartFormXObject(PDFRectangle(0, 0, w, h), id);
+  XObjectContentContext* xobjectContentContext = xobjectForm->GetContentContext();
+  xobjectContentContext->q();
+  xobjectContentContext->cm(w, 0, 0, h, 0, 0);
+  std::string pdfImageName = xobjectForm->GetResourcesDictionary().AddImageXObjectMapping(imageId);
+  xobjectContentContext->Do(pdfImageName);
+  xobjectContentContext->Q();
+  status = pdfw.EndFormXObjectAndRelease(xobjectForm);
+  return status == eSuccess;
+}
+
+/******************************************************************************
+* Converting images in the background
+******************************************************************************/
+
+static void
+pdf_convert_images (array<pdf_image> ims) {
+  // the conversions by external programs are started together on the pool
+  // of background_system, so that flushing the images merely has to copy
+  // the results into the document; the other images are converted
+  // when they are flushed
+  int i, n= N(ims);
+  if (n < 2) return;
+  time_t start= texmacs_time ();
+  array<url> out (n);
+  int nr= 0;
+  for (i=0; i<n; i++) {
+    out[i]= url_temp (".pdf");
+    if (image_to_pdf_background (ims[i]->source (), out[i],
+                                 ims[i]->w, ims[i]->h, 300, command ())) nr++;
+    else out[i]= url_none ();
+  }
+  if (nr == 0) return;
+  background_wait ();
+  for (i=0; i<n; i++)
+    if (!is_none (out[i]) && is_regular (out[i])) ims[i]->converted= out[i];
+  if (DEBUG_CONVERT)
+    debug_convert << "converted " << nr << " images in "
+                  << (int) (texmacs_time () - start) << " ms"
+                  << " in the background\n";
+}
+
 void
 pdf_hummus_renderer_rep::flush_images ()
 {
-  // flush all images
+  array<pdf_image> ims;
   iterator<tree> it = iterate (image_pool);
   while (it->busy()) {
     pdf_image im = image_pool[it->next()];
+    if (!im->flushed && im->needs_conversion ()) ims << im;
+  }
+  pdf_convert_images (ims);
+
+  // flush all images which were not yet written
+  it = iterate (image_pool);
+  while (it->busy()) {
+    pdf_image im = image_pool[it->next()];
+    if (im->flushed) continue;
     im->flush(pdfWriter);
+    im->flushed= true;
   }
 }
 
@@ -1992,6 +2546,19 @@ pdf_hummus_renderer_rep::flush_patterns ()
   }
 }
 
+static string
+image_digest (url u) {
+  // MD5 digest of the contents of an image file, or "" if it cannot be read
+  url name= resolve (u);
+  string data;
+  if (is_none (name) || load_string (name, data, false)) return "";
+  MD5Generator md5;
+  c_string buf (data);
+  md5.Accumulate ((const IOBasicTypes::Byte*) (char*) buf,
+                  (IOBasicTypes::LongBufferSizeType) N(data));
+  return suffix (name) * "-" * string (md5.ToHexString ().c_str ());
+}
+
 void
 pdf_hummus_renderer_rep::image (
   url u, double w, double h, SI x, SI y, int alpha)
@@ -2002,8 +2569,21 @@ pdf_hummus_renderer_rep::image (
   pdf_image im = ( image_pool->contains(lookup) ? image_pool[lookup] : pdf_image() );
   
   if (is_nil(im)) {
-    im = pdf_image(u, pdfWriter.GetObjectsContext().GetInDirectObjectsRegistry().AllocateNewObjectID());
+    // identical images under different names share their XObject
+    string digest= image_digest (u);
+    if (digest != "" && content_pool->contains (digest))
+      im = content_pool[digest];
+    else {
+      im = pdf_image(u, pdfWriter.GetObjectsContext().GetInDirectObjectsRegistry().AllocateNewObjectID(), digest);
+      if (digest != "") content_pool(digest) = im;
+    }
     image_pool(lookup) = im;
+    if (streaming && !im->flushed) {
+      end_text ();
+      pause_page ();
+      im->flush (pdfWriter);
+      im->flushed= true;
+    }
   }
 
   if (is_nil(im)) return;
@@ -2054,7 +2634,7 @@ pdf_hummus_renderer_rep::draw_picture (picture p, SI x, SI y, int alpha) {
     qt_picture_rep* pict= (qt_picture_rep*) q->get_handle ();
     temp= url_temp (".png");
     pict->pict.save (utf8_to_qstring (concretize (temp)), "PNG");
-    temp_images << temp;	
+    if (!streaming) temp_images << temp;	
 #else
     convert_error << "pdf renderer, draw_picture: "
       << "cannot export picture " << p->get_name() << LF;
@@ -2065,6 +2645,8 @@ pdf_hummus_renderer_rep::draw_picture (picture p, SI x, SI y, int alpha) {
   int w= p->get_width (), h= p->get_height ();
   int ox= p->get_origin_x (), oy= p->get_origin_y ();
   image (temp, w, h, x - ox * _pixel, y - oy * _pixel, alpha);
+  // in streaming mode, the image has been written and is only referred to
+  if (streaming && !is_none (temp) && exists (temp)) remove (temp);
 }
 
 void
@@ -2251,7 +2833,7 @@ pdf_hummus_renderer_rep::flush_dests()
     // flush the buffer
     ObjectsContext& objectsContext = pdfWriter.GetObjectsContext();
     destId = objectsContext.GetInDirectObjectsRegistry().AllocateNewObjectID();
-    write_indirect_obj(objectsContext, destId, dict);
+    write_object (destId, dict);
   }
 }
 
@@ -2323,7 +2905,7 @@ void pdf_hummus_renderer_rep::recurse (ObjectsContext& objectsContext, int paren
            << as_string(((double)default_dpi / dpi)*((oitem).x3))
            << " " << as_string(((double)default_dpi / dpi)*((oitem).x4)) << " null ]\r\n"
            << ">>\r\n";
-      write_indirect_obj(objectsContext, curId, dict);
+      write_object (curId, dict);
     }
     prevId = curId; curId = nextId;
   }
@@ -2351,7 +2933,7 @@ pdf_hummus_renderer_rep::flush_outlines()
     dict << "\t/Last " << as_string(lastId) << " 0 R \r\n";
     dict << "\t/Count " << as_string(count) << "\r\n";
     dict << ">>\r\n";
-    write_indirect_obj(objectsContext, outlineId, dict);
+    write_object (outlineId, dict);
   }
 }
 
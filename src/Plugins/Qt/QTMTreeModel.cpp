@@ -82,6 +82,8 @@ QTMTreeModel::item_from_index (const QModelIndex& index) const {
 inline QModelIndex
 QTMTreeModel::index_from_item (const tree& tref) const {
   tree& t = const_cast<tree&> (tref);
+  if (_parents.contains (t.rep))
+    return createIndex (_parents[t.rep].second, 0, t.rep);
   tree _t = tree (_t_rep);
   path ip = obtain_ip (t);
   if (ipath_has_parent (ip)) {
@@ -106,8 +108,12 @@ QTMTreeModel::index (int row, int column, const QModelIndex& parent) const {
   if (!hasIndex (row, column, parent)) return QModelIndex();
   tree t = item_from_index (parent);
 
-  if (is_compound (t) && row + row_offset(t) < N(t))
-    return createIndex (row, column, t[row + row_offset(t)].rep);
+  if (is_compound (t) && row + row_offset(t) < N(t)) {
+    tree_rep* rep = t[row + row_offset(t)].rep;
+      // remember the parent, so that parent() needs no inverse paths
+    _parents[rep] = qMakePair (t.rep, row);
+    return createIndex (row, column, rep);
+  }
   else
     return QModelIndex();
 }
@@ -115,6 +121,13 @@ QTMTreeModel::index (int row, int column, const QModelIndex& parent) const {
 QModelIndex
 QTMTreeModel::parent (const QModelIndex& index) const {
   if (!index.isValid()) return QModelIndex();
+  tree_rep* rep = static_cast<tree_rep*> (index.internalPointer());
+  if (_parents.contains (rep)) {
+    tree_rep* prep = _parents[rep].first;
+    if (prep == _t_rep) return QModelIndex();
+    if (_parents.contains (prep))
+      return createIndex (_parents[prep].second, 0, prep);
+  }
   tree  t = item_from_index (index);
   path ip = obtain_ip (t);
   if (ipath_has_parent (ip)) {
@@ -292,7 +305,9 @@ qt_tree_observer_rep::announce (tree& ref, modification mod) {
 
 void
 qt_tree_observer_rep::done (tree& ref, modification mod) {
-  (void) ref; (void) mod;
+  (void) ref;
+    // rows and parents may have changed, recompute them from inverse paths
+  if (mod->k != MOD_SET_CURSOR) model->_parents.clear();
   //if (mod->k != MOD_SET_CURSOR)
   //  model->endResetModel();
 }
@@ -106,8 +106,11 @@ class QTMTreeModel : public QAbstractItemModel {
     //typedef hashmap<tree_label, hashmap <int, int> > roles_t;
   typedef QHash<tree_label, QHash<int, int> > roles_t;
   
+  typedef QHash<tree_rep*, QPair<tree_rep*, int> > parents_t;
+
   tree_rep* _t_rep;  //!< Our data. Must be tree_rep* or we have a cycle!
   roles_t   _roles;  //!< Where in the data tree each data role is.
+  mutable parents_t _parents;  //!< Parents and rows of the indexed nodes.
   
   QTMTreeModel (const tree& data, const tree& roles, QObject* parent = 0);
   QTMTreeModel (const QTMTreeModel& _other);
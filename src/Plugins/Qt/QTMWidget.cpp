@@ -267,6 +267,7 @@ get_shift_preference (char key_code) {
 void
 QTMWidget::keyPressEvent (QKeyEvent* event) {
   if (is_nil (tmwid)) return;
+  LATENCY_BEGIN ();
   initkeymap();
 
   if (DEBUG_QT && DEBUG_KEYBOARD) debug_qt << "keypressed\n";
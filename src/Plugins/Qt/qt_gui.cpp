@@ -549,6 +549,20 @@ gui_refresh () {
 
 static int keyboard_events = 0;
 static int keyboard_special= 0;
+static time_t keyboard_postponed= 0; // first postponed treatment, or 0
+
+// Typesetting and repainting are postponed while ordinary keys keep
+// arriving, but never for more than KEYBOARD_DEADLINE ms.
+#define KEYBOARD_DEADLINE 50
+
+static bool
+input_pending () {
+#if QT_VERSION < 0x060000
+  return QCoreApplication::hasPendingEvents ();
+#else
+  return false;
+#endif
+}
 
 void
 qt_gui_rep::process_queued_events (int max) {
@@ -803,7 +817,14 @@ qt_gui_rep::update () {
     //if (the_interpose_handler) the_interpose_handler();
   }
   // Repaint invalid regions and redraw
-  bool postpone_treatment= (keyboard_events > 0 && keyboard_special == 0);
+  bool postpone_treatment= false;
+  if (keyboard_events > 0 && keyboard_special == 0) {
+    if (keyboard_postponed == 0) keyboard_postponed= now;
+    postpone_treatment=
+      (waiting_events.size() > 0 || input_pending ()) &&
+      now - keyboard_postponed < KEYBOARD_DEADLINE;
+  }
+  if (!postpone_treatment) keyboard_postponed= 0;
   keyboard_events = 0;
   keyboard_special= 0;
   count_events    = 0;
@@ -823,7 +844,7 @@ qt_gui_rep::update () {
   time_t delay = delayed_commands.lapse - texmacs_time();
   if (needing_update) delay = 0;
   else                delay = max (0, min (std_delay, delay));
-  if (postpone_treatment) delay= 100; // NOTE: force occasional display
+  if (postpone_treatment) delay= 0; // NOTE: display at the deadline
  
   updatetimer->start (delay);
   updating = false;
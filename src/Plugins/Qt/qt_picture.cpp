@@ -18,11 +18,18 @@
 #include "scheme.hpp"
 #include "frame.hpp"
 #include "effect.hpp"
+#include "raster_picture.hpp"
+#include "editor.hpp"
+#include "new_view.hpp"
 
 #include <QObject>
 #include <QWidget>
 #include <QPaintDevice>
 #include <QPixmap>
+#include <QEvent>
+#include <QRunnable>
+#include <QThreadPool>
+#include <QCoreApplication>
 
 /******************************************************************************
 * Abstract Qt pictures
@@ -61,10 +68,33 @@ as_qt_picture (picture pic) {
   picture ret= qt_picture (QImage (pic->get_width (), pic->get_height (),
                                    QImage::Format_ARGB32),
                            pic->get_origin_x (), pic->get_origin_y ());
-  ret->copy_from (pic);
+  if (pic->get_type () == picture_raster) {
+    // copy the rows directly instead of going through get/set_pixel
+    raster<true_color> r= as_raster<true_color> (pic);
+    QImage& im (((qt_picture_rep*) ret->get_handle ())->pict);
+    int w= r->w, h= r->h;
+    for (int y=0; y<h; y++) {
+      QRgb* row= (QRgb*) im.scanLine (h - 1 - y);
+      true_color* src= r->a + y * w;
+      for (int x=0; x<w; x++) row[x]= (QRgb) (color) src[x];
+    }
+  }
+  else ret->copy_from (pic);
   return ret;
 }
 
+static QImage
+premultiplied_image (picture pic) {
+  // raster pictures are drawn on the screen in the native format of Qt
+  raster<true_color> r= as_raster<true_color> (pic);
+  int w= r->w, h= r->h;
+  QImage im (w, h, QImage::Format_ARGB32_Premultiplied);
+  for (int y=0; y<h; y++)
+    premultiplied_pixels ((unsigned int*) im.scanLine (h - 1 - y),
+                          r->a + y * w, w);
+  return im;
+}
+
 picture
 as_native_picture (picture pict) {
   return as_qt_picture (pict);
@@ -84,13 +114,17 @@ native_picture (int w, int h, int ox, int oy) {
 
 void
 qt_renderer_rep::draw_picture (picture p, SI x, SI y, int alpha) {
-  p= as_qt_picture (p);
-  qt_picture_rep* pict= (qt_picture_rep*) p->get_handle ();
-  int x0= pict->ox, y0= pict->h - 1 - pict->oy;
+  int x0= p->get_origin_x (), y0= p->get_height () - 1 - p->get_origin_y ();
   decode (x, y);
   qreal old_opacity= painter->opacity ();
   painter->setOpacity (qreal (alpha) / qreal (255));
-  painter->drawImage (x - x0, y - y0, pict->pict);
+  if (p->get_type () == picture_raster)
+    painter->drawImage (x - x0, y - y0, premultiplied_image (p));
+  else {
+    p= as_qt_picture (p);
+    qt_picture_rep* pict= (qt_picture_rep*) p->get_handle ();
+    painter->drawImage (x - x0, y - y0, pict->pict);
+  }
   painter->setOpacity (old_opacity);
 }
 
@@ -204,8 +238,107 @@ get_image (url u, int w, int h, tree eff, SI pixel) {
   return qt_pic_cache[key];
 }
 
+/******************************************************************************
+* Asynchronous loading of pictures
+******************************************************************************/
+
+// Decoding and scaling large bitmaps may take a noticeable amount of time.
+// Pictures which are displayed on the screen are therefore decoded by
+// a worker thread, while a placeholder is drawn in the meantime.
+// The worker only manipulates QString and QImage objects, since
+// the TeXmacs strings and trees are not thread-safe.
+
+static const QEvent::Type qt_image_loaded_type=
+  (QEvent::Type) QEvent::registerEventType ();
+
+class qt_image_loaded_event: public QEvent {
+public:
+  int id;
+  QImage im;
+  qt_image_loaded_event (int id2, const QImage& im2):
+    QEvent (qt_image_loaded_type), id (id2), im (im2) {}
+};
+
+class qt_image_receiver: public QObject {
+protected:
+  void customEvent (QEvent* ev);
+};
+
+static qt_image_receiver* the_image_receiver= NULL;
+
+class qt_image_loader: public QRunnable {
+  int id;
+  QString file;
+  int w, h;
+public:
+  qt_image_loader (int id2, const QString& file2, int w2, int h2):
+    id (id2), file (file2), w (w2), h (h2) {}
+  void run () {
+    QImage im (file);
+    if (!im.isNull () && (im.width () != w || im.height () != h))
+      im= im.scaled (w, h);
+    QCoreApplication::postEvent (the_image_receiver,
+                                 new qt_image_loaded_event (id, im));
+  }
+};
+
+static int qt_pic_job_id= 0;
+static hashmap<tree,int> qt_pic_pending (0);
+static hashmap<int,tree> qt_pic_jobs;
+
+static bool
+qt_image_pending (tree key, url u, int w, int h) {
+  // Returns true while the image is being decoded in the background
+  if (qt_pic_pending->contains (key)) return true;
+  if (qt_pic_cache->contains (key)) return false;
+  if (!qt_supports (u) || prefer_inkscape (suffix (u))) return false;
+  if (the_image_receiver == NULL) the_image_receiver= new qt_image_receiver ();
+  int id= ++qt_pic_job_id;
+  qt_pic_pending (key)= id;
+  qt_pic_jobs (id)= key;
+  QString file= utf8_to_qstring (concretize (u));
+  QThreadPool::globalInstance ()->start (new qt_image_loader (id, file, w, h));
+  return true;
+}
+
+void
+qt_image_receiver::customEvent (QEvent* ev) {
+  if (ev->type () != qt_image_loaded_type) return;
+  qt_image_loaded_event* e= (qt_image_loaded_event*) ev;
+  if (!qt_pic_jobs->contains (e->id)) return;
+  tree key= qt_pic_jobs [e->id];
+  qt_pic_jobs->reset (e->id);
+  qt_pic_pending->reset (key);
+  url u= as_url (key[0]);
+  int w= as_int (key[1]), h= as_int (key[2]);
+  if (!qt_pic_cache->contains (key)) {
+    // NOTE: the image may have been loaded synchronously in the meantime
+    if (e->im.isNull ()) {
+      cout << "TeXmacs] warning: cannot render " << concretize (u) << "\n";
+      qt_pic_cache (key)= NULL;
+    }
+    else qt_pic_cache (key)= new QImage (e->im);
+  }
+  picture_cache_forget (u, w, h, "");
+  array<url> vs= get_all_views ();
+  for (int i=0; i<N(vs); i++)
+    view_to_editor (vs[i]) -> invalidate_all ();
+  needs_update ();
+}
+
+static picture
+pending_picture (int w, int h) {
+  picture pic= raster_picture (w, h);
+  draw_on (pic, 0x10808080, compose_source);
+  return pic;
+}
+
 picture
-load_picture (url u, int w, int h, tree eff, int pixel) {
+load_picture (url u, int w, int h, tree eff, int pixel, bool async) {
+  if (async && eff == "") {
+    tree key= tuple (as_tree (u), as_tree (w), as_tree (h));
+    if (qt_image_pending (key, u, w, h)) return pending_picture (w, h);
+  }
   QImage* im= get_image (u, w, h, eff, pixel);
   if (im == NULL) return error_picture (w, h);
   return qt_picture (*im, 0, 0);
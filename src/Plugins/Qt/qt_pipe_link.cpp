@@ -124,7 +124,8 @@ qt_pipe_link_rep::listen (int msecs) {
   if (!alive) return;
   time_t wait_until= texmacs_time () + msecs;
   while ((PipeLink.getOutbuf() == "") && (PipeLink.getErrbuf() == "")) {
-    PipeLink.listenChannel (QProcess::StandardOutput, 0);
+    // block for a short while on the output rather than polling
+    PipeLink.listenChannel (QProcess::StandardOutput, min (msecs, 10));
     PipeLink.listenChannel (QProcess::StandardError, 0);
     if (texmacs_time () - wait_until > 0) break;
   }
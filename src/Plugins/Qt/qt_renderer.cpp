@@ -17,6 +17,7 @@
 #include "image_files.hpp"
 #include "scheme.hpp"
 #include "frame.hpp"
+#include "lru_cache.hpp"
 
 #include <QObject>
 #include <QWidget>
@@ -73,18 +74,101 @@ CONCRETE_NULL_CODE(qt_pixmap);
 * Global support variables for all qt_renderers
 ******************************************************************************/
 
-// bitmaps of all characters
-static hashmap<basic_character,qt_image> character_image;  
+// bitmaps of the recently used characters
+static lru_cache<basic_character,qt_image>
+  character_image (qt_image (), character_cache_budget ());
 // image cache
 static hashmap<string,qt_pixmap> images;
 
+/******************************************************************************
+* Atlas of character images
+*******************************************************************************
+* Small characters are rendered into a few large pixmaps, so that the
+* characters of a string can be drawn using a single call to
+* drawPixmapFragments. The characters are packed into shelves and the
+* whole atlas is reset once it exceeds the character cache budget.
+******************************************************************************/
+
+#define ATLAS_SIZE  1024
+#define ATLAS_GLYPH 128
+
+struct qt_atlas_slot {
+  int page, x, y, w, h; // location in the atlas
+  SI  xo, yo;           // origin of the character
+};
+
+static array<QPixmap*> atlas_pages;
+static array<qt_atlas_slot> atlas_slots;
+static hashmap<basic_character,int> atlas_index (-1);
+static int atlas_x= 0, atlas_y= 0, atlas_row= 0;
+
+static void
+atlas_reset () {
+  for (int i=0; i<N(atlas_pages); i++) delete atlas_pages[i];
+  atlas_pages= array<QPixmap*> ();
+  atlas_slots= array<qt_atlas_slot> ();
+  atlas_index= hashmap<basic_character,int> (-1);
+  atlas_x= atlas_y= atlas_row= 0;
+}
+
+static void
+render_glyph (QImage& im, glyph gl, int r, int g, int b, int a, int sf) {
+  int nr_cols= sf*sf;
+  if (nr_cols >= 64) nr_cols= 64;
+  for (int j=0; j<gl->height; j++)
+    for (int i=0; i<gl->width; i++) {
+      int col = gl->get_x (i, j);
+      im.setPixel (i, j, qRgba (r, g, b, (a*col)/nr_cols));
+    }
+}
+
+static int
+atlas_add (glyph gl, SI xo, SI yo, int r, int g, int b, int a, int sf) {
+  // render gl into the atlas and return its slot or -2 if gl is too large
+  int w= gl->width, h= gl->height;
+  if (w > ATLAS_GLYPH || h > ATLAS_GLYPH) return -2;
+  if (N(atlas_pages) != 0 && atlas_x + w > ATLAS_SIZE) {
+    atlas_x  = 0;
+    atlas_y += atlas_row;
+    atlas_row= 0;
+  }
+  if (N(atlas_pages) == 0 || atlas_y + h > ATLAS_SIZE) {
+    long page_size= 4L * ATLAS_SIZE * ATLAS_SIZE;
+    if ((N(atlas_pages) + 1) * page_size > character_cache_budget ())
+      atlas_reset ();
+    QPixmap* page= new QPixmap (ATLAS_SIZE, ATLAS_SIZE);
+    page->fill (Qt::transparent);
+    atlas_pages << page;
+    atlas_x= atlas_y= atlas_row= 0;
+  }
+  qt_atlas_slot slot;
+  slot.page= N(atlas_pages) - 1;
+  slot.x= atlas_x; slot.y= atlas_y; slot.w= w; slot.h= h;
+  slot.xo= xo; slot.yo= yo;
+  atlas_x  += w + 1;
+  atlas_row = max (atlas_row, h + 1);
+
+  QImage im (max (w, 1), max (h, 1), QImage::Format_ARGB32);
+  im.fill (0);
+  render_glyph (im, gl, r, g, b, a, sf);
+  QPainter pp (atlas_pages[slot.page]);
+  pp.setCompositionMode (QPainter::CompositionMode_Source);
+  pp.drawImage (slot.x, slot.y, im, 0, 0, w, h);
+  pp.end ();
+  atlas_slots << slot;
+  return N(atlas_slots) - 1;
+}
+
 /*
 ** hash contents must be removed because 
 ** the underlying objects are destroyed during 
 ** Qt exit function
 */
 void del_obj_qt_renderer(void)  {
-  character_image= hashmap<basic_character,qt_image> ();  
+  if (DEBUG_BENCH)
+    std_bench << "Character images: " << character_image << "\n";
+  character_image->clear ();
+  atlas_reset ();
   images= hashmap<string,qt_pixmap>() ;
 }
 
@@ -542,26 +626,17 @@ qt_renderer_rep::draw (int c, font_glyphs fng, SI x, SI y) {
     QTMImage *im= new QImage (w, h, QImage::Format_ARGB32);
     //QTMImage *im= new QImage (w, h, QImage::Format_ARGB32_Premultiplied);
     {
-      int nr_cols= std_shrinkf*std_shrinkf;
-      if (nr_cols >= 64) nr_cols= 64;
-
       // the following line is disabled because
       // it causes a crash on Qt/X11 4.4.3
       //im->fill (Qt::transparent);
 
-      for (j=0; j<h; j++)
-        for (i=0; i<w; i++) {
-          int col = gl->get_x (i, j);
-          im->setPixel (i, j, qRgba (r, g, b, (a*col)/nr_cols));
-        }
+      render_glyph (*im, gl, r, g, b, a, std_shrinkf);
     }
 #endif
     qt_image mi2 (im, xo, yo, w, h);
     mi = mi2;
     //[im release]; // qt_image retains im
-    character_image (xc)= mi;
-    // FIXME: we must release the image at some point 
-    //        (this should be ok now, see qt_image)
+    character_image->set (xc, mi, (4L * w) * h + sizeof (qt_image_rep));
   }
 
   // draw the character
@@ -570,6 +645,59 @@ qt_renderer_rep::draw (int c, font_glyphs fng, SI x, SI y) {
   draw_clipped (mi->img, mi->w, mi->h, x- mi->xo*std_shrinkf, y+ mi->yo*std_shrinkf);
 }
 
+void
+qt_renderer_rep::draw_characters (int* cs, SI* xs, int n,
+                                  font_glyphs fng, SI y) {
+  if (n == 0) return;
+  if (pen->get_type () == pencil_brush) {
+    renderer_rep::draw_characters (cs, xs, n, fng, y);
+    return;
+  }
+
+  color fgc= pen->get_color ();
+  int r, g, b, a;
+  get_rgb (fgc, r, g, b, a);
+  if (get_reverse_colors ()) reverse (r, g, b);
+  painter->setRenderHints (0);
+  STACK_NEW_ARRAY (frags, QPainter::PixmapFragment, n);
+  int nr= 0, page= -1;
+  for (int i=0; i<n; i++) {
+    basic_character xc (cs[i], fng, std_shrinkf, fgc, 0);
+    int k= atlas_index[xc];
+    if (k == -1) {
+      // adding characters may reset the atlas, so draw the pending ones
+      if (nr != 0) painter->drawPixmapFragments (frags, nr, *atlas_pages[page]);
+      nr= 0;
+      SI xo, yo;
+      glyph pre_gl= fng->get (cs[i]);
+      if (is_nil (pre_gl)) continue;
+      glyph gl= shrink (pre_gl, std_shrinkf, std_shrinkf, xo, yo);
+      k= atlas_add (gl, xo, yo, r, g, b, a, std_shrinkf);
+      atlas_index (xc)= k;
+    }
+    if (k == -2) {
+      if (nr != 0) painter->drawPixmapFragments (frags, nr, *atlas_pages[page]);
+      nr= 0;
+      draw (cs[i], fng, xs[i], y);
+      continue;
+    }
+    qt_atlas_slot slot= atlas_slots[k];
+    if (slot.page != page && nr != 0) {
+      painter->drawPixmapFragments (frags, nr, *atlas_pages[page]);
+      nr= 0;
+    }
+    page= slot.page;
+    SI x1= xs[i] - slot.xo*std_shrinkf, y1= y + slot.yo*std_shrinkf;
+    decode (x1, y1);
+    y1--; // top-left origin to bottom-left origin conversion
+    frags[nr++]= QPainter::PixmapFragment::create
+      (QPointF (x1 + 0.5 * slot.w, y1 + 0.5 * slot.h),
+       QRectF (slot.x, slot.y, slot.w, slot.h));
+  }
+  if (nr != 0) painter->drawPixmapFragments (frags, nr, *atlas_pages[page]);
+  STACK_DELETE_ARRAY (frags);
+}
+
 void
 qt_renderer_rep::draw (const QFont& qfn, const QString& qs,
                        SI x, SI y, double zoom) {
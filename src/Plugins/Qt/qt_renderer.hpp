@@ -59,6 +59,7 @@ public:
 
   void  draw_bis (int char_code, font_glyphs fn, SI x, SI y);
   void  draw (int char_code, font_glyphs fn, SI x, SI y);
+  void  draw_characters (int* cs, SI* xs, int n, font_glyphs fn, SI y);
   void  draw (const QFont& qfn, const QString& s, SI x, SI y, double zoom);
   void  set_pencil (pencil p);
   void  set_brush (brush b);
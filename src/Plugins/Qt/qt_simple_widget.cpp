@@ -34,10 +34,13 @@ extern const QX11Info *qt_x11Info (const QPaintDevice *pd);
 #endif // Q_WS_X11
 #endif // USE_CAIRO
 
+#define TILE_SIZE 256
+#define TILE_BUDGET (64 << 20)
 
 
 qt_simple_widget_rep::qt_simple_widget_rep ()
- : qt_widget_rep (simple_widget),  sequencer (0) { }
+ : qt_widget_rep (simple_widget),  sequencer (0),
+   tiles (QPixmap (), TILE_BUDGET), backing_zoom (0.0), preview_scale (0.0) { }
 
 qt_simple_widget_rep::~qt_simple_widget_rep () {
   all_widgets->remove ((pointer) this);
@@ -218,6 +221,9 @@ qt_simple_widget_rep::send (slot s, blackbox val) {
     {
       check_type<double> (val, s);
       double new_zoom = open_box<double> (val);
+      if (backing_zoom > 0.0 && new_zoom != backing_zoom)
+        preview_scale= new_zoom / backing_zoom;
+      backing_zoom= new_zoom;
       canvas()->tm_widget()->handle_set_zoom_factor (new_zoom);
     }
       break;
@@ -397,8 +403,27 @@ qt_simple_widget_rep::as_qaction () {
  ******************************************************************************/
 
 
+/******************************************************************************
+* The painted parts of the document are also kept in tiles of TILE_SIZE
+* pixels, at fixed positions with respect to the document, so that parts
+* which were scrolled out of view can be restored without being repainted.
+* Tiles are only taken from valid parts of the backing store and they are
+* dropped as soon as an overlapping region is invalidated.
+******************************************************************************/
+
+static inline int
+tile_index (int x) {
+  return x >= 0? x / TILE_SIZE: -((TILE_SIZE - 1 - x) / TILE_SIZE);
+}
+
+static inline int
+tile_key (int i, int j) {
+  return ((i & 0xffff) << 16) | (j & 0xffff);
+}
+
 void
-qt_simple_widget_rep::invalidate_rect (int x1, int y1, int x2, int y2) {
+qt_simple_widget_rep::invalidate_rect (int x1, int y1, int x2, int y2,
+                                       bool drop) {
 #ifdef Q_OS_MAC
   //HACK: for unknown reasons we need to enlarge the invalid rect to prevent
   //artifacts while moving the cursor (for example at the end of a formula like
@@ -409,6 +434,15 @@ qt_simple_widget_rep::invalidate_rect (int x1, int y1, int x2, int y2) {
 #endif
   // cout << "invalidating " << r << LF;
   invalid_regions = invalid_regions | rectangles (r);  
+  if (drop && N (tiles) > 0) {
+    int bx= retina_factor * backing_pos.x ();
+    int by= retina_factor * backing_pos.y ();
+    int i1= tile_index (r->x1 + bx), i2= tile_index (r->x2 + bx - 1);
+    int j1= tile_index (r->y1 + by), j2= tile_index (r->y2 + by - 1);
+    for (int i=i1; i<=i2; i++)
+      for (int j=j1; j<=j2; j++)
+        tiles->reset (tile_key (i, j));
+  }
 }
 
 void
@@ -417,10 +451,57 @@ qt_simple_widget_rep::invalidate_all () {
   // QPoint pt = QAbstractScrollArea::viewport()->pos();
   //cout << "invalidate all " << LF;
   invalid_regions = rectangles();
+  tiles->clear ();
   invalidate_rect (0, 0, retina_factor * sz.width(),
                    retina_factor * sz.height());
 }
 
+void
+qt_simple_widget_rep::store_tiles () {
+  // store the tiles which are entirely inside the valid part of the backing
+  int bx= retina_factor * backing_pos.x ();
+  int by= retina_factor * backing_pos.y ();
+  QSize sz= backingPixmap.size ();
+  int i1= tile_index (bx + TILE_SIZE - 1), i2= tile_index (bx + sz.width ());
+  int j1= tile_index (by + TILE_SIZE - 1), j2= tile_index (by + sz.height ());
+  for (int i=i1; i<i2; i++)
+    for (int j=j1; j<j2; j++) {
+      int key= tile_key (i, j);
+      if (tiles->contains (key)) continue;
+      rectangle r (i * TILE_SIZE - bx, j * TILE_SIZE - by,
+                   (i+1) * TILE_SIZE - bx, (j+1) * TILE_SIZE - by);
+      if (!is_nil (invalid_regions & rectangles (r))) continue;
+      QPixmap px= backingPixmap.copy (r->x1, r->y1, TILE_SIZE, TILE_SIZE);
+      tiles->set (key, px, 4 * TILE_SIZE * TILE_SIZE);
+    }
+}
+
+void
+qt_simple_widget_rep::restore_tiles (int x1, int y1, int x2, int y2) {
+  // restore the exposed region from the tiles and invalidate the rest
+  rectangles l (rectangle (x1, y1, x2, y2));
+  if (x1 < x2 && y1 < y2 && N (tiles) > 0) {
+    int bx= retina_factor * backing_pos.x ();
+    int by= retina_factor * backing_pos.y ();
+    int i1= tile_index (x1 + bx), i2= tile_index (x2 + bx - 1);
+    int j1= tile_index (y1 + by), j2= tile_index (y2 + by - 1);
+    QPainter p (&backingPixmap);
+    for (int i=i1; i<=i2; i++)
+      for (int j=j1; j<=j2; j++) {
+        int key= tile_key (i, j);
+        if (!tiles->contains (key)) continue;
+        rectangle r (i * TILE_SIZE - bx, j * TILE_SIZE - by,
+                     (i+1) * TILE_SIZE - bx, (j+1) * TILE_SIZE - by);
+        p.drawPixmap (r->x1, r->y1, tiles[key]);
+        l= l - rectangles (r);
+      }
+    p.end ();
+  }
+  for (; !is_nil (l); l= l->next)
+    invalidate_rect (l->item->x1, l->item->y1, l->item->x2, l->item->y2,
+                     false);
+}
+
 bool
 qt_simple_widget_rep::is_invalid () {
   return !is_nil (invalid_regions);
@@ -459,6 +540,38 @@ qt_simple_widget_rep::get_renderer() {
   return ren;
 }
 
+/******************************************************************************
+* When the zoom factor changes, the backing store is first rescaled and shown
+* as a preview; it is then refined band by band at the new resolution.  Since
+* repainting is interrupted by pending events, the preview remains visible
+* for the bands which could not yet be repainted.
+******************************************************************************/
+
+void
+qt_simple_widget_rep::show_preview (QPoint origin) {
+  double sc= preview_scale;
+  preview_scale= 0.0;
+  tiles->clear ();
+  QSize sz= backingPixmap.size ();
+  QPixmap newBackingPixmap (sz);
+  newBackingPixmap.fill (Qt::gray);
+  QPainter p (&newBackingPixmap);
+  p.translate (-retina_factor * origin.x (), -retina_factor * origin.y ());
+  p.scale (sc, sc);
+  p.drawPixmap (retina_factor * backing_pos.x (),
+                retina_factor * backing_pos.y (), backingPixmap);
+  p.end ();
+  backingPixmap= newBackingPixmap;
+  backing_pos= origin;
+  canvas()->surface()->repaint (QRect (QPoint (0, 0), sz / retina_factor));
+  invalid_regions= rectangles ();
+  for (int y= ((sz.height () - 1) / TILE_SIZE) * TILE_SIZE; y >= 0;
+       y -= TILE_SIZE)
+    invalid_regions= rectangles (rectangle (0, y, sz.width (),
+                                            min (sz.height (), y + TILE_SIZE)),
+                                 invalid_regions);
+}
+
 /*
  This function is called by the qt_gui::update method (via repaint_all) to keep
  the backing store in sync and propagate the changes to the surface on screen.
@@ -477,8 +590,18 @@ qt_simple_widget_rep::repaint_invalid_regions () {
   QPoint origin = canvas()->origin();
   // qrgn is to keep track of the area on the screen which needs to be updated
   
+  // rescale the backing store after a change of the zoom factor
+  bool refine= false;
+  if (preview_scale != 0.0 && !backingPixmap.isNull ()) {
+    show_preview (origin);
+    refine= true;
+    qrgn += QRect (QPoint (0,0), backingPixmap.size ());
+  }
+  preview_scale= 0.0;
+  
   // update backing store origin wrt. TeXmacs document
   if (backing_pos != origin) {
+    store_tiles ();
     
     int dx =  retina_factor * (origin.x() - backing_pos.x());
     int dy =  retina_factor * (origin.y() - backing_pos.y());
@@ -509,14 +632,14 @@ qt_simple_widget_rep::repaint_invalid_regions () {
                                                       sz.width(),sz.height()));
     
     if (dy<0)
-      invalidate_rect (0,0,sz.width(),min (sz.height(),-dy));
+      restore_tiles (0,0,sz.width(),min (sz.height(),-dy));
     else if (dy>0)
-      invalidate_rect (0,max (0,sz.height()-dy),sz.width(),sz.height());
+      restore_tiles (0,max (0,sz.height()-dy),sz.width(),sz.height());
     
     if (dx<0)
-      invalidate_rect (0,0,min (-dx,sz.width()),sz.height());
+      restore_tiles (0,0,min (-dx,sz.width()),sz.height());
     else if (dx>0)
-      invalidate_rect (max (0,sz.width()-dx),0,sz.width(),sz.height());
+      restore_tiles (max (0,sz.width()-dx),0,sz.width(),sz.height());
     
     // we call update now to allow repainting of invalid regions
     // this cannot be done directly since interpose_handler needs
@@ -543,6 +666,7 @@ qt_simple_widget_rep::repaint_invalid_regions () {
     
     if (_newSize != _oldSize) {
       // cout << "RESIZING BITMAP"<< LF;
+      tiles->clear ();
       QPixmap newBackingPixmap (_newSize);
       QPainter p (&newBackingPixmap);
       p.drawPixmap (0,0,backingPixmap);
@@ -565,7 +689,7 @@ qt_simple_widget_rep::repaint_invalid_regions () {
     rectangles new_regions;
     if (!is_nil (invalid_regions)) {
       rectangle lub= least_upper_bound (invalid_regions);
-      if (area (lub) < 1.2 * area (invalid_regions))
+      if (!refine && area (lub) < 1.2 * area (invalid_regions))
         invalid_regions= rectangles (lub);
       
       basic_renderer_rep* ren = get_renderer();
@@ -13,6 +13,7 @@
 #define QT_SIMPLE_WIDGET_HPP
 
 #include "hashset.hpp"
+#include "lru_cache.hpp"
 #include "basic_renderer.hpp"
 
 #include "qt_widget.hpp"
@@ -94,10 +95,16 @@ protected:
   rectangles   invalid_regions;
   QPixmap      backingPixmap;  
   QPoint       backing_pos;
+  lru_cache<int,QPixmap> tiles;  // painted tiles, also outside the view
+  double       backing_zoom;   // zoom factor of the backing store
+  double       preview_scale;  // pending rescaling of the backing, or 0
 
 
-  void invalidate_rect (int x1, int y1, int x2, int y2);
+  void invalidate_rect (int x1, int y1, int x2, int y2, bool drop= true);
   void invalidate_all ();
+  void store_tiles ();
+  void restore_tiles (int x1, int y1, int x2, int y2);
+  void show_preview (QPoint origin);
   bool is_invalid ();
   void repaint_invalid_regions ();
   basic_renderer get_renderer();
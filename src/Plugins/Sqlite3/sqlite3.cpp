@@ -13,6 +13,7 @@
 #include "dyn_link.hpp"
 #include "hashmap.hpp"
 #include "analyze.hpp"
+#include "iterator.hpp"
 #include "config.h"
 
 #ifdef USE_SQLITE3
@@ -33,16 +34,22 @@ int (*SQLITE3_open) (
 
 int (*SQLITE3_close) (sqlite3 *db);
 
-int (*SQLITE3_get_table) (
-  sqlite3 *db,          /* An open database */
-  const char *zSql,     /* SQL to be evaluated */
-  char ***pazResult,    /* Results of the query */
-  int *pnRow,           /* Number of result rows written here */
-  int *pnColumn,        /* Number of result columns written here */
-  char **pzErrmsg       /* Error msg written here */
+int (*SQLITE3_prepare_v2) (
+  sqlite3 *db,            /* Database handle */
+  const char *zSql,       /* SQL statement, UTF-8 encoded */
+  int nByte,              /* Maximum length of zSql in bytes. */
+  sqlite3_stmt **ppStmt,  /* OUT: Statement handle */
+  const char **pzTail     /* OUT: Pointer to unused portion of zSql */
 );
 
-void (*SQLITE3_free_table) (char **result);
+int (*SQLITE3_step) (sqlite3_stmt *stmt);
+int (*SQLITE3_reset) (sqlite3_stmt *stmt);
+int (*SQLITE3_finalize) (sqlite3_stmt *stmt);
+int (*SQLITE3_column_count) (sqlite3_stmt *stmt);
+int (*SQLITE3_column_type) (sqlite3_stmt *stmt, int col);
+const char* (*SQLITE3_column_name) (sqlite3_stmt *stmt, int col);
+const unsigned char* (*SQLITE3_column_text) (sqlite3_stmt *stmt, int col);
+const char* (*SQLITE3_errmsg) (sqlite3 *db);
 
 /******************************************************************************
 * Initialization
@@ -74,8 +81,15 @@ tm_sqlite3_initialize () {
   int status= debug_off ();
   sqlite3_bind (sqlite3_open, SQLITE3_open);
   sqlite3_bind (sqlite3_close, SQLITE3_close);
-  sqlite3_bind (sqlite3_get_table, SQLITE3_get_table);
-  sqlite3_bind (sqlite3_free_table, SQLITE3_free_table);
+  sqlite3_bind (sqlite3_prepare_v2, SQLITE3_prepare_v2);
+  sqlite3_bind (sqlite3_step, SQLITE3_step);
+  sqlite3_bind (sqlite3_reset, SQLITE3_reset);
+  sqlite3_bind (sqlite3_finalize, SQLITE3_finalize);
+  sqlite3_bind (sqlite3_column_count, SQLITE3_column_count);
+  sqlite3_bind (sqlite3_column_type, SQLITE3_column_type);
+  sqlite3_bind (sqlite3_column_name, SQLITE3_column_name);
+  sqlite3_bind (sqlite3_column_text, SQLITE3_column_text);
+  sqlite3_bind (sqlite3_errmsg, SQLITE3_errmsg);
   debug_on (status);
 
 #ifdef LINKED_SQLITE3
@@ -112,15 +126,28 @@ sql_unescape (string s) {
   return s;
 }
 
-tree
-sql_exec (url db_name, string cmd) {
+/******************************************************************************
+* Execution of SQL commands
+*******************************************************************************
+* Commands which consist of a single statement are prepared only once and
+* kept in a cache for subsequent executions.  The result of a command is
+* returned in the same format as by sqlite3_get_table: a first row with
+* the column names, followed by the rows of the result.
+******************************************************************************/
+
+#define SQL_MAX_STATEMENTS 256
+#define SQL_MAX_ATTEMPTS   100
+
+hashmap<string,pointer> sqlite3_statements (NULL);
+
+static sqlite3*
+sql_database (string name) {
   if (!sqlite3_initialized)
     tm_sqlite3_initialize ();
   if (sqlite3_error) {
     cout << "TeXmacs] ERROR: SQLite support not properly configured.\n";
-    return tree (TUPLE);
+    return NULL;
   }
-  string name= concretize (db_name);
   if (!sqlite3_connections->contains (name)) {
     c_string _name (name);
     sqlite3* db= NULL;
@@ -131,51 +158,136 @@ sql_exec (url db_name, string cmd) {
   }
   if (!sqlite3_connections->contains (name)) {
     cout << "TeXmacs] SQL error: database " << name << " could not be opened\n";
-    return tree (TUPLE);
-  }
-  tree ret (TUPLE);
-  sqlite3* db= (sqlite3*) sqlite3_connections [name];
-  c_string _cmd (sql_escape (cmd));
-  char** tab;
-  int rows, cols;
-  char* err;
-  //cout << "Executing " << _cmd << "\n";
-  int status= SQLITE3_get_table (db, _cmd, &tab, &rows, &cols, &err);
-
-  int attempt= 0;
-  while (status != SQLITE_OK &&
-         string (err) == string ("database is locked") &&
-         attempt < 100) {
-    usleep (100000);
-    attempt++;
-    status= SQLITE3_get_table (db, _cmd, &tab, &rows, &cols, &err);
+    return NULL;
   }
+  return (sqlite3*) sqlite3_connections [name];
+}
 
-  if (status != SQLITE_OK) {
-    // TODO: improve error handling
-    cout << "TeXmacs] SQL error\n";
-    if (err != NULL) cout << "TeXmacs] " << err << "\n";
-  }
+static void
+sql_clear_statements () {
+  iterator<string> it= iterate (sqlite3_statements);
+  while (it->busy ())
+    SQLITE3_finalize ((sqlite3_stmt*) sqlite3_statements [it->next ()]);
+  sqlite3_statements= hashmap<string,pointer> (NULL);
+}
 
-  for (int r=0; r<=rows; r++) {
-    tree row (TUPLE);
-    //cout << "  Row " << r << LF;
-    for (int c=0; c<cols; c++) {
-      int i= r*cols + c;
-      if (tab[i] == NULL) row << tree (TUPLE);
-      else {
-        row << tree (scm_quote (sql_unescape (tab[i])));
-        //cout << "    Column " << c << ": " << tab[i] << LF;
+static bool
+sql_blank (const char* s) {
+  for (; *s != '\0'; s++)
+    if (*s != ' ' && *s != '\t' && *s != '\n' && *s != '\r' && *s != ';')
+      return false;
+  return true;
+}
+
+static tree
+sql_field (const char* s) {
+  if (s == NULL) return tree (TUPLE);
+  return tree (scm_quote (sql_unescape (string ((char*) s))));
+}
+
+static bool
+sql_run (sqlite3* db, string name, string cmd, tree& ret) {
+  // execute cmd on db and append the rows of its result to ret
+  string key= name * "\n" * cmd;
+  c_string _cmd (sql_escape (cmd));
+  const char* sql= _cmd;
+  bool ok= true, header= false;
+  while (ok && sql != NULL && !sql_blank (sql)) {
+    sqlite3_stmt* stmt= NULL;
+    const char* tail= NULL;
+    bool cached= false;
+    if (sql == (const char*) _cmd && sqlite3_statements->contains (key)) {
+      stmt  = (sqlite3_stmt*) sqlite3_statements [key];
+      tail  = NULL;
+      cached= true;
+    }
+    else {
+      int status= SQLITE3_prepare_v2 (db, sql, -1, &stmt, &tail);
+      for (int attempt= 0; status == SQLITE_BUSY &&
+                           attempt < SQL_MAX_ATTEMPTS; attempt++) {
+        usleep (100000);
+        status= SQLITE3_prepare_v2 (db, sql, -1, &stmt, &tail);
+      }
+      if (status != SQLITE_OK) {
+        cout << "TeXmacs] SQL error\n";
+        cout << "TeXmacs] " << SQLITE3_errmsg (db) << "\n";
+        return false;
+      }
+      if (stmt == NULL) { sql= tail; continue; }
+      if (sql == (const char*) _cmd && sql_blank (tail)) {
+        if (N (sqlite3_statements) >= SQL_MAX_STATEMENTS)
+          sql_clear_statements ();
+        sqlite3_statements (key)= (pointer) stmt;
+        cached= true;
+      }
+    }
+
+    int status= SQLITE3_step (stmt);
+    for (int attempt= 0; status == SQLITE_BUSY &&
+                         attempt < SQL_MAX_ATTEMPTS; attempt++) {
+      usleep (100000);
+      status= SQLITE3_step (stmt);
+    }
+    int cols= SQLITE3_column_count (stmt);
+    for (; status == SQLITE_ROW; status= SQLITE3_step (stmt)) {
+      if (!header) {
+        tree row (TUPLE);
+        for (int c=0; c<cols; c++)
+          row << sql_field (SQLITE3_column_name (stmt, c));
+        ret << row;
+        header= true;
       }
+      tree row (TUPLE);
+      for (int c=0; c<cols; c++)
+        if (SQLITE3_column_type (stmt, c) == SQLITE_NULL) row << tree (TUPLE);
+        else row << sql_field ((const char*) SQLITE3_column_text (stmt, c));
+      ret << row;
+    }
+    if (status != SQLITE_DONE) {
+      // TODO: improve error handling
+      cout << "TeXmacs] SQL error\n";
+      cout << "TeXmacs] " << SQLITE3_errmsg (db) << "\n";
+      ok= false;
     }
-    ret << row;
+    if (cached) SQLITE3_reset (stmt);
+    else SQLITE3_finalize (stmt);
+    sql= tail;
   }
+  if (!header) ret << tree (TUPLE);
+  return ok;
+}
 
-  SQLITE3_free_table (tab);
+tree
+sql_exec (url db_name, string cmd) {
+  string name= concretize (db_name);
+  sqlite3* db= sql_database (name);
+  tree ret (TUPLE);
+  if (db == NULL) return ret;
+  //cout << "Executing " << cmd << "\n";
+  (void) sql_run (db, name, cmd, ret);
   //cout << "Return " << ret << "\n";
   return ret;
 }
 
+tree
+sql_exec_all (url db_name, array<string> cmds) {
+  // execute the commands within a single transaction, which is only
+  // committed if all of them succeed, and return the list of their results
+  string name= concretize (db_name);
+  sqlite3* db= sql_database (name);
+  tree ret (TUPLE), dummy (TUPLE);
+  if (db == NULL) return ret;
+  bool begun= sql_run (db, name, "BEGIN", dummy);
+  bool ok= true;
+  for (int i=0; ok && i<N(cmds); i++) {
+    tree r (TUPLE);
+    ok= sql_run (db, name, cmds[i], r);
+    ret << r;
+  }
+  if (begun) (void) sql_run (db, name, ok? "COMMIT": "ROLLBACK", dummy);
+  return ret;
+}
+
 #else // USE_SQLITE3
 
 /******************************************************************************
@@ -186,6 +298,8 @@ bool sqlite3_present () {
   return false; }
 tree sql_exec (url db_name, string cmd) {
   (void) db_name; (void) cmd; return tree (TUPLE); }
+tree sql_exec_all (url db_name, array<string> cmds) {
+  (void) db_name; (void) cmds; return tree (TUPLE); }
 
 #endif // USE_SQLITE3
 
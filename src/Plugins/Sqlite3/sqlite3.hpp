@@ -15,6 +15,7 @@
 
 bool sqlite3_present ();
 tree sql_exec (url db_name, string cmd);
+tree sql_exec_all (url db_name, array<string> cmds);
 string sql_quote (string s);
 
 #endif // TM_SQLITE3_H
@@ -27,35 +27,6 @@ unix_system (string s) {
   return ret;
 }
 
-int
-unix_system (string cmd, string& result) {
-  url temp= url_temp ();
-  string temp_s= escape_sh (concretize (temp));
-  c_string _cmd (cmd * " > " * temp_s * " 2>&1");
-  int ret= system (_cmd);
-  bool flag= load_string (temp, result, false);
-  remove (temp);
-  if (flag) result= "";
-  return ret;
-}
-
-int
-unix_system (string cmd, string& result, string& error) {
-  url temps= url_temp ();
-  url tempe= url_temp ();
-  string temp_s= escape_sh (concretize (temps));
-  string temp_e= escape_sh (concretize (tempe));
-  c_string _cmd (cmd * " > " * temp_s * " 2> " * temp_e);
-  int ret= system (_cmd);
-  bool flag= load_string (temps, result, false);
-  remove (temps);
-  if (flag) result= "";
-  flag= load_string (tempe, error, false);
-  remove (tempe);
-  if (flag) error= "";
-  return ret;
-}
-
 /******************************************************************************
 * Evaluation via specified file descriptors
 ******************************************************************************/
@@ -329,6 +300,34 @@ unix_system (array<string> arg,
   return WEXITSTATUS(status);
 }
 
+/******************************************************************************
+* Evaluation of shell commands with output capture
+******************************************************************************/
+
+int
+unix_system (string cmd, string& result) {
+  // capture the output of the command through a pipe,
+  // instead of redirecting it to a temporary file
+  array<string> arg;
+  arg << string ("/bin/sh") << string ("-c") << (cmd * " 2>&1");
+  array<int> fd_out; fd_out << 1;
+  array<string*> str_out; str_out << &result;
+  int ret= unix_system (arg, array<int> (), array<string> (), fd_out, str_out);
+  if (ret < 0) result= "";
+  return ret;
+}
+
+int
+unix_system (string cmd, string& result, string& error) {
+  array<string> arg;
+  arg << string ("/bin/sh") << string ("-c") << cmd;
+  array<int> fd_out; fd_out << 1 << 2;
+  array<string*> str_out; str_out << &result << &error;
+  int ret= unix_system (arg, array<int> (), array<string> (), fd_out, str_out);
+  if (ret < 0) result= error= "";
+  return ret;
+}
+
 #else
 
 int
@@ -339,4 +338,33 @@ unix_system (array<string> arg,
   FAILED ("unsupported system call");
 }
 
+int
+unix_system (string cmd, string& result) {
+  url temp= url_temp ();
+  string temp_s= escape_sh (concretize (temp));
+  c_string _cmd (cmd * " > " * temp_s * " 2>&1");
+  int ret= system (_cmd);
+  bool flag= load_string (temp, result, false);
+  remove (temp);
+  if (flag) result= "";
+  return ret;
+}
+
+int
+unix_system (string cmd, string& result, string& error) {
+  url temps= url_temp ();
+  url tempe= url_temp ();
+  string temp_s= escape_sh (concretize (temps));
+  string temp_e= escape_sh (concretize (tempe));
+  c_string _cmd (cmd * " > " * temp_s * " 2> " * temp_e);
+  int ret= system (_cmd);
+  bool flag= load_string (temps, result, false);
+  remove (temps);
+  if (flag) result= "";
+  flag= load_string (tempe, error, false);
+  remove (tempe);
+  if (flag) error= "";
+  return ret;
+}
+
 #endif
@@ -23,13 +23,20 @@ SI get_dy (gravity grav, SI h);
 
 basic_widget_rep::basic_widget_rep (gravity grav):
   wk_widget_rep (array<wk_widget> (0), array<string> (0), grav),
-  ptr_focus (-1) {}
+  ptr_focus (-1) { forget_sizes (); }
 basic_widget_rep::basic_widget_rep (
   array<wk_widget> a, gravity grav):
-    wk_widget_rep (a, array<string> (N(a)), grav), ptr_focus (-1) {}
+    wk_widget_rep (a, array<string> (N(a)), grav), ptr_focus (-1) {
+      forget_sizes (); }
 basic_widget_rep::basic_widget_rep (
   array<wk_widget> a2, array<string> name2, gravity grav2):
-    wk_widget_rep (a2, name2, grav2), ptr_focus (-1) {}
+    wk_widget_rep (a2, name2, grav2), ptr_focus (-1) {
+      forget_sizes (); }
+
+void
+basic_widget_rep::forget_sizes () {
+  for (int i=0; i<3; i++) size_epoch[i]= -1;
+}
 
 /******************************************************************************
 * Generating events in local coordinates
@@ -271,9 +278,23 @@ basic_widget_rep::handle (event ev) {
   if (DEBUG_EVENTS) debug_events << ev << "\n";
   // " ---> " << wk_widget (this) << "\n";
   switch (ev->type) {
-  case GET_SIZE_EVENT:
+  case GET_SIZE_EVENT: {
+    get_size_event e (ev);
+    int i= max (-1, min (1, e->mode)) + 1;
+    if (size_epoch[i] == wk_layout_epoch &&
+        size_in_w[i] == e->w && size_in_h[i] == e->h) {
+      e->w= size_out_w[i];
+      e->h= size_out_h[i];
+      return true;
+    }
+    SI in_w= e->w, in_h= e->h;
     handle_get_size (ev);
+    // nested events may have advanced the epoch during the computation
+    size_epoch[i]= wk_layout_epoch;
+    size_in_w [i]= in_w; size_in_h [i]= in_h;
+    size_out_w[i]= e->w; size_out_h[i]= e->h;
     return true;
+  }
   case GET_WIDGET_EVENT:
     handle_get_widget (ev);
     return true;
@@ -354,18 +375,21 @@ basic_widget_rep::handle (event ev) {
     SI ry1= max (e->y1, y1())- oy;
     SI rx2= min (e->x2, x2())- ox;
     SI ry2= min (e->y2, y2())- oy;
-    if ((rx2 > rx1) && (ry2 > ry1)) {
-      event ev= ::emit_repaint (e->win, rx1, ry1, rx2, ry2, e->stop);
-      e->win->set_origin (ox, oy);
-      e->win->clip (rx1, ry1, rx2, ry2);
-      handle_repaint (ev);
-      e->win->unclip ();
-      e->win->set_origin (0, 0);
-    }
-
+    if ((rx2 <= rx1) || (ry2 <= ry1)) return true;
+    event ev= ::emit_repaint (e->win, rx1, ry1, rx2, ry2, e->stop);
+    e->win->set_origin (ox, oy);
+    e->win->clip (rx1, ry1, rx2, ry2);
+    handle_repaint (ev);
+    e->win->unclip ();
+    e->win->set_origin (0, 0);
+
+    // only descend into the children which meet the damaged rectangle
     int i;
     ev= emit_repaint (e->win, rx1, ry1, rx2, ry2, e->stop);
-    for (i=0; i<N(a); i++) a[i] << ev;
+    for (i=0; i<N(a); i++)
+      if ((a[i]->x1() < ox+ rx2) && (a[i]->x2() > ox+ rx1) &&
+          (a[i]->y1() < oy+ ry2) && (a[i]->y2() > oy+ ry1))
+        a[i] << ev;
     return true;
   }
   case UPDATE_EVENT:
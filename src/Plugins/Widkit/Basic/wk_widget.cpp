@@ -139,9 +139,47 @@ wk_widget_rep::wk_error (string message) {
   widkit_error << message << "\n";
 }
 
+/******************************************************************************
+* Event dispatching
+******************************************************************************/
+
+int wk_layout_epoch= 0;
+static int dispatch_depth= 0;
+
+static inline bool
+is_layout_query (int type) {
+  // events which do not alter the size hints of any widget
+  switch (type) {
+  case GET_SIZE_EVENT:
+  case GET_WIDGET_EVENT:
+  case POSITION_EVENT:
+  case CLEAR_EVENT:
+  case REPAINT_EVENT:
+  case INVALIDATE_EVENT:
+  case FIND_CHILD_EVENT:
+  case GET_INTEGER_EVENT:
+  case GET_DOUBLE_EVENT:
+  case GET_STRING_EVENT:
+  case GET_COORD1_EVENT:
+  case GET_COORD2_EVENT:
+  case GET_COORD3_EVENT:
+  case GET_COORD4_EVENT:
+    return true;
+  default:
+    return false;
+  }
+}
+
 wk_widget
 operator << (wk_widget w, event ev) {
-  if (!w->handle (ev))
+  // size hints may depend on state outside widkit (such as the contents
+  // of an editor), so cached layouts never survive a toplevel event
+  if (dispatch_depth == 0 || !is_layout_query (ev->type))
+    wk_invalidate_layouts ();
+  dispatch_depth++;
+  bool ok= w->handle (ev);
+  dispatch_depth--;
+  if (!ok)
     widkit_warning << ((tree) ev) << " cannot be handled by\n" << w << "\n";
   return w;
 }
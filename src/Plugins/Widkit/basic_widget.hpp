@@ -18,11 +18,18 @@ class basic_widget_rep: public wk_widget_rep {
 protected:
   int ptr_focus; // subwidget where the pointer is (-1 if none)
 
+  // cached answers to get_size events for the modes -1, 0 and 1,
+  // valid as long as wk_layout_epoch equals size_epoch
+  int size_epoch[3];
+  SI  size_in_w[3], size_in_h[3];
+  SI  size_out_w[3], size_out_h[3];
+
 public:
   basic_widget_rep (gravity grav= north_west);
   basic_widget_rep (array<wk_widget> a, gravity grav= north_west);
   basic_widget_rep (array<wk_widget> a, array<string> name,
 		    gravity grav= north_west);
+  void forget_sizes ();
 
   event emit_position   (SI ox, SI oy, SI w, SI h, gravity grav= north_west);
   event emit_invalidate (SI x1, SI y1, SI x2, SI y2);
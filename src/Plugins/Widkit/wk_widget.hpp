@@ -71,6 +71,9 @@ array<wk_widget> concrete (array<widget> a);
 tm_ostream& operator << (tm_ostream& out, wk_widget w);
 wk_widget operator << (wk_widget w, event ev);
 
+extern int wk_layout_epoch;  // advanced whenever widget state may change
+inline void wk_invalidate_layouts () { wk_layout_epoch++; }
+
 void wk_grab_pointer (wk_widget w);
 void wk_ungrab_pointer (wk_widget w);
 bool wk_has_pointer_grab (wk_widget w);
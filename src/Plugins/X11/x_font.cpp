@@ -13,6 +13,7 @@
 #include "X11/x_font.hpp"
 #include "analyze.hpp"
 #include "dictionary.hpp"
+#include <stdlib.h>
 
 /******************************************************************************
 * Displaying characters
@@ -20,6 +21,19 @@
 
 bool char_clip= true;
 
+void
+release_character_pixmap (x_character xc, pointer pm) {
+  (void) xc;
+  XFreePixmap (the_gui->dpy, (Pixmap) pm);
+}
+
+void
+release_character_bitmap (x_character xc, pointer bm) {
+  (void) xc;
+  XFreePixmap (the_gui->dpy, ((Bitmap) bm)->bm);
+  tm_delete ((Bitmap) bm);
+}
+
 #define conv(x) ((SI) (((double) (x))*(fn->unit)))
 
 void
@@ -82,13 +96,28 @@ x_drawable_rep::draw (int c, font_glyphs fng, SI x, SI y) {
     glyph gl= shrink (pre_gl, std_shrinkf, std_shrinkf, xo, yo);
     int i, j, w= gl->width, h= gl->height;
     pm= XCreatePixmap (gui->dpy, gui->root, w, h, gui->depth);
-    for (j=0; j<h; j++)
-      for (i=0; i<w; i++) {
-	color col= cols [gl->get_x(i,j)];
-	XSetForeground (gui->dpy, gui->pixmap_gc, CONVERT (col));
-	XDrawPoint (gui->dpy, (Drawable) pm, gui->pixmap_gc, i, j);
-      }
-    gui->character_pixmap (xc)= (pointer) pm;
+    // compose the pixels on the client side and transfer them in a single
+    // request, rather than sending two requests for each pixel
+    Visual* vis= DefaultVisual (gui->dpy, gui->scr);
+    XImage* im= XCreateImage (gui->dpy, vis, gui->depth, ZPixmap, 0, NULL,
+                              w, h, 32, 0);
+    if (im != NULL) im->data= (char*) malloc (im->bytes_per_line * h);
+    if (im != NULL && im->data != NULL) {
+      for (j=0; j<h; j++)
+        for (i=0; i<w; i++)
+          XPutPixel (im, i, j, CONVERT (cols [gl->get_x(i,j)]));
+      XPutImage (gui->dpy, (Drawable) pm, gui->pixmap_gc, im, 0, 0, 0, 0, w, h);
+    }
+    else
+      for (j=0; j<h; j++)
+        for (i=0; i<w; i++) {
+          color col= cols [gl->get_x(i,j)];
+          XSetForeground (gui->dpy, gui->pixmap_gc, CONVERT (col));
+          XDrawPoint (gui->dpy, (Drawable) pm, gui->pixmap_gc, i, j);
+        }
+    if (im != NULL) XDestroyImage (im);
+    gui->character_pixmap->set (xc, (pointer) pm,
+                                ((((long) w) * h * gui->depth) >> 3) + 1);
   }
 
   // get the bitmap
@@ -115,7 +144,8 @@ x_drawable_rep::draw (int c, font_glyphs fng, SI x, SI y) {
     bm->height= gl->height;
     bm->xoff  = xo;
     bm->yoff  = yo;
-    gui->character_bitmap (xc)= (pointer) bm;
+    gui->character_bitmap->set (xc, (pointer) bm,
+                                ((long) byte_width) * h + sizeof (Bitmap_rep));
     tm_delete_array (data);
   }
 
@@ -16,6 +16,7 @@
 #include "widget.hpp"
 #include "array.hpp"
 #include "hashmap.hpp"
+#include "lru_cache.hpp"
 #include "colors.hpp"
 
 class x_gui_rep;
@@ -62,6 +63,8 @@ CONCRETE_CODE(x_character);
 bool operator == (x_character xc1, x_character xc2);
 bool operator != (x_character xc1, x_character xc2);
 int hash (x_character xc);
+void release_character_pixmap (x_character xc, pointer pm);
+void release_character_bitmap (x_character xc, pointer bm);
 
 /******************************************************************************
 * Delayed messages
@@ -117,8 +120,8 @@ public:
   time_t          interrupt_time;
 
   hashmap<x_character,pointer> color_scale;       // for anti-aliasing
-  hashmap<x_character,pointer> character_bitmap;  // bitmaps of all characters
-  hashmap<x_character,pointer> character_pixmap;  // pixmaps of all characters
+  lru_cache<x_character,pointer> character_bitmap;  // recent char bitmaps
+  lru_cache<x_character,pointer> character_pixmap;  // recent char pixmaps
   hashmap<int,string>          lower_key;
   hashmap<int,string>          upper_key;
 
@@ -10,6 +10,7 @@
 ******************************************************************************/
 
 #include "X11/x_window.hpp"
+#include "basic_renderer.hpp"
 #include "language.hpp"
 #include "font.hpp"
 #include "analyze.hpp"
@@ -627,7 +628,10 @@ x_gui_rep::get_max_size (SI& width, SI& height) {
 
 x_gui_rep::x_gui_rep (int& argc2, char** argv2):
   color_scale ((void*) NULL),
-  character_bitmap (NULL), character_pixmap ((pointer) 0),
+  character_bitmap (NULL, character_cache_budget (),
+                    release_character_bitmap),
+  character_pixmap ((pointer) 0, character_cache_budget (),
+                    release_character_pixmap),
   lower_key (""), upper_key (""),
   selection_t ("none"), selection_s (""), selection_w ((Window) 0)
 {
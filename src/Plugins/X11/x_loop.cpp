@@ -14,6 +14,7 @@
 #include "iterator.hpp"
 #include "converter.hpp"
 #include "tm_link.hpp"
+#include "socket_notifier.hpp"
 #include "message.hpp"
 
 #ifdef OS_WIN32
@@ -374,10 +375,8 @@ x_gui_rep::event_loop () {
     // Wait for events on all channels and interpose
     //time_t t1= texmacs_time ();
     if (wait) {
-      struct timeval tv;
-      tv.tv_sec  = delay/1000;
-      tv.tv_usec = 1000 * (delay%1000);
-      select (0, NULL, NULL, NULL, &tv);
+      // wake up as soon as an X event arrives or a link has new input
+      wait_for_notifiers (ConnectionNumber (dpy), delay);
       count += delay;
       if (count >= SLEEP_AFTER) delay= MAX_DELAY;
     }
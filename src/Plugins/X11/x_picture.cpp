@@ -285,7 +285,8 @@ load_picture (url u, int w, int h) {
 }
 
 picture
-load_picture (url u, int w, int h, tree eff, int pixel) {
+load_picture (url u, int w, int h, tree eff, int pixel, bool async) {
+  (void) async;
   picture pic= load_picture (u, w, h);
   if (eff != "") {
     effect e= build_effect (eff);
@@ -70,9 +70,23 @@
   (texmacs-memory mem_used (int))
   (bench-print bench_print (void string))
   (bench-print-all bench_print (void))
+  (texmacs-peak-memory peak_memory (int))
+  (texmacs-memory-report memory_report (string))
+  (profile-start profile_start (void))
+  (profile-stop profile_stop (void))
+  (profile-reset profile_reset (void))
+  (profile-time profile_time (double string))
   (system-wait system_wait (void string string))
+  (system-async background_system (void string command))
   (get-show-kbd get_show_kbd (bool))
   (set-show-kbd set_show_kbd (void bool))
+  (keyboard-record-start start_recording_keys (void))
+  (keyboard-record-stop stop_recording_keys (bool url))
+  (latency-start latency_start (void int))
+  (latency-stop latency_stop (void))
+  (latency-reset latency_reset (void))
+  (latency-report latency_report (string))
+  (latency-distribution latency_distribution (string))
   (set-latex-command set_latex_command (void string))
   (set-bibtex-command set_bibtex_command (void string))
   (number-latex-errors number_latex_errors (int url))
@@ -185,7 +199,7 @@
   (anim-control-times get_control_times (array_double content))
 
   ;; routines for trees
-  (tree->stree tree_to_scheme_tree (scheme_tree tree))
+  (tree->stree tree_to_stree (object tree))
   (stree->tree scheme_tree_to_tree (tree scheme_tree))
   (tree->string coerce_tree_string (string tree))
   (string->tree coerce_string_tree (tree string))
@@ -511,6 +525,8 @@
   (try-latex-export try_latex_export (tree content object url url))
   (parse-xml parse_xml (scheme_tree string))
   (parse-html parse_html (scheme_tree string))
+  (cpp-serialize-html serialize_html (string scheme_tree))
+  (cpp-serialize-html-file serialize_html (bool scheme_tree url))
   (parse-bib parse_bib (tree string))
   (conservative-bib-import conservative_bib_import
                            (tree string content string))
@@ -595,6 +611,7 @@
   (url-scratch url_scratch (url string string int))
   (url-scratch? is_scratch (bool url))
   (url-cache-invalidate web_cache_invalidate (void url))
+  (url-prefetch web_prefetch (void url command))
   (string-save string_save (void string url))
   (string-load string_load (string url))
   (string-append-to-file string_append_to_file (void string url))
@@ -604,6 +621,7 @@
   (system-mkdir mkdir (void url))
   (system-rmdir rmdir (void url))
   (system-search-score search_score (int url array_string))
+  (system-search-scores search_scores (array_int array_url array_string))
   (system-1 system (void string url))
   (system-2 system (void string url url))
   (system-url->string sys_concretize (string url))
@@ -635,6 +653,7 @@
   ;; SQL interface
   (supports-sql? sqlite3_present (bool))
   (sql-exec sql_exec (scheme_tree url string))
+  (sql-exec-all sql_exec_all (scheme_tree url array_string))
   (sql-quote sql_quote (string string))
 
   ;; TeXmacs servers and clients
@@ -736,7 +755,12 @@
   (buffer-pretend-modified pretend_buffer_modified (void url))
   (buffer-pretend-saved pretend_buffer_saved (void url))
   (buffer-pretend-autosaved pretend_buffer_autosaved (void url))
+  (buffer-journaled? buffer_journaled (bool url))
+  (buffer-flush-journal flush_buffer_journal (void url))
+  (buffer-recoverable? buffer_recoverable (bool url))
+  (buffer-recover buffer_recover (bool url))
   (buffer-attach-notifier attach_buffer_notifier (void url))
+  (buffer-snapshot buffer_snapshot (tree url))
   (buffer-has-name? buffer_has_name (bool url))
   (buffer-aux? is_aux_buffer (bool url))
   (buffer-embedded? is_embedded_buffer (bool url))
@@ -812,7 +836,7 @@
   (bib-purify bib_purify (string scheme_tree))
   (bib-text-length bib_text_length (int scheme_tree))
   (bib-prefix bib_prefix (string scheme_tree int))
-  (bib-empty? bib_empty (bool scheme_tree string))
-  (bib-field bib_field (scheme_tree scheme_tree string))
+  (cpp-bib-empty? bib_empty (bool scheme_tree string))
+  (cpp-bib-field bib_field (scheme_tree scheme_tree string))
   (bib-abbreviate bib_abbreviate
 		  (scheme_tree scheme_tree scheme_tree scheme_tree)))
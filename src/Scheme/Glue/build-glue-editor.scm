@@ -163,6 +163,7 @@
   ;; keyboard and mouse handling
   (key-press key_press (void string))
   (raw-emulate-keyboard emulate_keyboard (void string))
+  (keyboard-replay replay_keys (void url))
   (complete-try? complete_try (bool))
   (get-input-mode get_input_mode (int))
   (key-press-search search_keypress (bool string))
@@ -279,6 +280,7 @@
   (search-start search_start (void bool))
   (search-button-next search_button_next (void))
   (replace-start replace_start (void string string bool))
+  (replace-all-occurrences replace_all (int array_path content))
   (spell-start spell_start (void))
   (spell-replace spell_replace (void string))
 
@@ -314,6 +316,8 @@
   (graphics-file-to-clipboard graphics_file_to_clipboard (bool url))
   (export-postscript export_ps (void url))
   (export-pages-postscript export_ps (void url string string))
+  (typeset-pages typeset_pages (int))
+  (export-pages-raster export_raster (void url int string string))
   (footer-eval footer_eval (void string))
   (texmacs-exec texmacs_exec (tree content))
   (texmacs-exec* var_texmacs_exec (tree content))
@@ -108,7 +108,8 @@
   (output "\ntmscm\n" (translate-name name) " (")
   (if (not (null? type))
       (build-header-args type 1))
-  (output ") {\n"))
+  (output ") {\n")
+  (output "  PROFILE_TALLY (\"glue " name "\");\n"))
 
 ;; Type checking
 
@@ -13,6 +13,7 @@
 
 tmscm
 tmg_texmacs_version_release (tmscm arg1) {
+  PROFILE_TALLY ("glue texmacs-version-release");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "texmacs-version-release");
 
   string in1= tmscm_to_string (arg1);
@@ -26,6 +27,7 @@ tmg_texmacs_version_release (tmscm arg1) {
 
 tmscm
 tmg_version_beforeP (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue version-before?");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "version-before?");
   TMSCM_ASSERT_STRING (arg2, TMSCM_ARG2, "version-before?");
 
@@ -41,6 +43,7 @@ tmg_version_beforeP (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_updater_supportedP () {
+  PROFILE_TALLY ("glue updater-supported?");
   // TMSCM_DEFER_INTS;
   bool out= updater_supported ();
   // TMSCM_ALLOW_INTS;
@@ -50,6 +53,7 @@ tmg_updater_supportedP () {
 
 tmscm
 tmg_updater_runningP () {
+  PROFILE_TALLY ("glue updater-running?");
   // TMSCM_DEFER_INTS;
   bool out= updater_is_running ();
   // TMSCM_ALLOW_INTS;
@@ -59,6 +63,7 @@ tmg_updater_runningP () {
 
 tmscm
 tmg_updater_check_background () {
+  PROFILE_TALLY ("glue updater-check-background");
   // TMSCM_DEFER_INTS;
   bool out= updater_check_background ();
   // TMSCM_ALLOW_INTS;
@@ -68,6 +73,7 @@ tmg_updater_check_background () {
 
 tmscm
 tmg_updater_check_foreground () {
+  PROFILE_TALLY ("glue updater-check-foreground");
   // TMSCM_DEFER_INTS;
   bool out= updater_check_foreground ();
   // TMSCM_ALLOW_INTS;
@@ -77,6 +83,7 @@ tmg_updater_check_foreground () {
 
 tmscm
 tmg_updater_last_check () {
+  PROFILE_TALLY ("glue updater-last-check");
   // TMSCM_DEFER_INTS;
   long out= updater_last_check ();
   // TMSCM_ALLOW_INTS;
@@ -86,6 +93,7 @@ tmg_updater_last_check () {
 
 tmscm
 tmg_updater_set_interval (tmscm arg1) {
+  PROFILE_TALLY ("glue updater-set-interval");
   TMSCM_ASSERT_INT (arg1, TMSCM_ARG1, "updater-set-interval");
 
   int in1= tmscm_to_int (arg1);
@@ -99,6 +107,7 @@ tmg_updater_set_interval (tmscm arg1) {
 
 tmscm
 tmg_get_original_path () {
+  PROFILE_TALLY ("glue get-original-path");
   // TMSCM_DEFER_INTS;
   string out= get_original_path ();
   // TMSCM_ALLOW_INTS;
@@ -108,6 +117,7 @@ tmg_get_original_path () {
 
 tmscm
 tmg_os_win32P () {
+  PROFILE_TALLY ("glue os-win32?");
   // TMSCM_DEFER_INTS;
   bool out= os_win32 ();
   // TMSCM_ALLOW_INTS;
@@ -117,6 +127,7 @@ tmg_os_win32P () {
 
 tmscm
 tmg_os_mingwP () {
+  PROFILE_TALLY ("glue os-mingw?");
   // TMSCM_DEFER_INTS;
   bool out= os_mingw ();
   // TMSCM_ALLOW_INTS;
@@ -126,6 +137,7 @@ tmg_os_mingwP () {
 
 tmscm
 tmg_os_macosP () {
+  PROFILE_TALLY ("glue os-macos?");
   // TMSCM_DEFER_INTS;
   bool out= os_macos ();
   // TMSCM_ALLOW_INTS;
@@ -135,6 +147,7 @@ tmg_os_macosP () {
 
 tmscm
 tmg_has_printing_cmdP () {
+  PROFILE_TALLY ("glue has-printing-cmd?");
   // TMSCM_DEFER_INTS;
   bool out= has_printing_cmd ();
   // TMSCM_ALLOW_INTS;
@@ -144,6 +157,7 @@ tmg_has_printing_cmdP () {
 
 tmscm
 tmg_x_guiP () {
+  PROFILE_TALLY ("glue x-gui?");
   // TMSCM_DEFER_INTS;
   bool out= gui_is_x ();
   // TMSCM_ALLOW_INTS;
@@ -153,6 +167,7 @@ tmg_x_guiP () {
 
 tmscm
 tmg_qt_guiP () {
+  PROFILE_TALLY ("glue qt-gui?");
   // TMSCM_DEFER_INTS;
   bool out= gui_is_qt ();
   // TMSCM_ALLOW_INTS;
@@ -162,6 +177,7 @@ tmg_qt_guiP () {
 
 tmscm
 tmg_default_look_and_feel () {
+  PROFILE_TALLY ("glue default-look-and-feel");
   // TMSCM_DEFER_INTS;
   string out= default_look_and_feel ();
   // TMSCM_ALLOW_INTS;
@@ -171,6 +187,7 @@ tmg_default_look_and_feel () {
 
 tmscm
 tmg_default_chinese_font () {
+  PROFILE_TALLY ("glue default-chinese-font");
   // TMSCM_DEFER_INTS;
   string out= default_chinese_font_name ();
   // TMSCM_ALLOW_INTS;
@@ -180,6 +197,7 @@ tmg_default_chinese_font () {
 
 tmscm
 tmg_default_japanese_font () {
+  PROFILE_TALLY ("glue default-japanese-font");
   // TMSCM_DEFER_INTS;
   string out= default_japanese_font_name ();
   // TMSCM_ALLOW_INTS;
@@ -189,6 +207,7 @@ tmg_default_japanese_font () {
 
 tmscm
 tmg_default_korean_font () {
+  PROFILE_TALLY ("glue default-korean-font");
   // TMSCM_DEFER_INTS;
   string out= default_korean_font_name ();
   // TMSCM_ALLOW_INTS;
@@ -198,6 +217,7 @@ tmg_default_korean_font () {
 
 tmscm
 tmg_get_retina_factor () {
+  PROFILE_TALLY ("glue get-retina-factor");
   // TMSCM_DEFER_INTS;
   int out= get_retina_factor ();
   // TMSCM_ALLOW_INTS;
@@ -207,6 +227,7 @@ tmg_get_retina_factor () {
 
 tmscm
 tmg_get_retina_zoom () {
+  PROFILE_TALLY ("glue get-retina-zoom");
   // TMSCM_DEFER_INTS;
   int out= get_retina_zoom ();
   // TMSCM_ALLOW_INTS;
@@ -216,6 +237,7 @@ tmg_get_retina_zoom () {
 
 tmscm
 tmg_get_retina_icons () {
+  PROFILE_TALLY ("glue get-retina-icons");
   // TMSCM_DEFER_INTS;
   int out= get_retina_icons ();
   // TMSCM_ALLOW_INTS;
@@ -225,6 +247,7 @@ tmg_get_retina_icons () {
 
 tmscm
 tmg_get_retina_scale () {
+  PROFILE_TALLY ("glue get-retina-scale");
   // TMSCM_DEFER_INTS;
   double out= get_retina_scale ();
   // TMSCM_ALLOW_INTS;
@@ -234,6 +257,7 @@ tmg_get_retina_scale () {
 
 tmscm
 tmg_set_retina_factor (tmscm arg1) {
+  PROFILE_TALLY ("glue set-retina-factor");
   TMSCM_ASSERT_INT (arg1, TMSCM_ARG1, "set-retina-factor");
 
   int in1= tmscm_to_int (arg1);
@@ -247,6 +271,7 @@ tmg_set_retina_factor (tmscm arg1) {
 
 tmscm
 tmg_set_retina_zoom (tmscm arg1) {
+  PROFILE_TALLY ("glue set-retina-zoom");
   TMSCM_ASSERT_INT (arg1, TMSCM_ARG1, "set-retina-zoom");
 
   int in1= tmscm_to_int (arg1);
@@ -260,6 +285,7 @@ tmg_set_retina_zoom (tmscm arg1) {
 
 tmscm
 tmg_set_retina_icons (tmscm arg1) {
+  PROFILE_TALLY ("glue set-retina-icons");
   TMSCM_ASSERT_INT (arg1, TMSCM_ARG1, "set-retina-icons");
 
   int in1= tmscm_to_int (arg1);
@@ -273,6 +299,7 @@ tmg_set_retina_icons (tmscm arg1) {
 
 tmscm
 tmg_set_retina_scale (tmscm arg1) {
+  PROFILE_TALLY ("glue set-retina-scale");
   TMSCM_ASSERT_DOUBLE (arg1, TMSCM_ARG1, "set-retina-scale");
 
   double in1= tmscm_to_double (arg1);
@@ -286,6 +313,7 @@ tmg_set_retina_scale (tmscm arg1) {
 
 tmscm
 tmg_tm_output (tmscm arg1) {
+  PROFILE_TALLY ("glue tm-output");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "tm-output");
 
   string in1= tmscm_to_string (arg1);
@@ -299,6 +327,7 @@ tmg_tm_output (tmscm arg1) {
 
 tmscm
 tmg_tm_errput (tmscm arg1) {
+  PROFILE_TALLY ("glue tm-errput");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "tm-errput");
 
   string in1= tmscm_to_string (arg1);
@@ -312,6 +341,7 @@ tmg_tm_errput (tmscm arg1) {
 
 tmscm
 tmg_win32_display (tmscm arg1) {
+  PROFILE_TALLY ("glue win32-display");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "win32-display");
 
   string in1= tmscm_to_string (arg1);
@@ -325,6 +355,7 @@ tmg_win32_display (tmscm arg1) {
 
 tmscm
 tmg_cpp_error () {
+  PROFILE_TALLY ("glue cpp-error");
   // TMSCM_DEFER_INTS;
   cpp_error ();
   // TMSCM_ALLOW_INTS;
@@ -334,6 +365,7 @@ tmg_cpp_error () {
 
 tmscm
 tmg_supports_native_pdfP () {
+  PROFILE_TALLY ("glue supports-native-pdf?");
   // TMSCM_DEFER_INTS;
   bool out= supports_native_pdf ();
   // TMSCM_ALLOW_INTS;
@@ -343,6 +375,7 @@ tmg_supports_native_pdfP () {
 
 tmscm
 tmg_supports_ghostscriptP () {
+  PROFILE_TALLY ("glue supports-ghostscript?");
   // TMSCM_DEFER_INTS;
   bool out= supports_ghostscript ();
   // TMSCM_ALLOW_INTS;
@@ -352,6 +385,7 @@ tmg_supports_ghostscriptP () {
 
 tmscm
 tmg_rescue_modeP () {
+  PROFILE_TALLY ("glue rescue-mode?");
   // TMSCM_DEFER_INTS;
   bool out= in_rescue_mode ();
   // TMSCM_ALLOW_INTS;
@@ -361,6 +395,7 @@ tmg_rescue_modeP () {
 
 tmscm
 tmg_scheme_dialect () {
+  PROFILE_TALLY ("glue scheme-dialect");
   // TMSCM_DEFER_INTS;
   string out= scheme_dialect ();
   // TMSCM_ALLOW_INTS;
@@ -370,6 +405,7 @@ tmg_scheme_dialect () {
 
 tmscm
 tmg_get_texmacs_path () {
+  PROFILE_TALLY ("glue get-texmacs-path");
   // TMSCM_DEFER_INTS;
   url out= get_texmacs_path ();
   // TMSCM_ALLOW_INTS;
@@ -379,6 +415,7 @@ tmg_get_texmacs_path () {
 
 tmscm
 tmg_get_texmacs_home_path () {
+  PROFILE_TALLY ("glue get-texmacs-home-path");
   // TMSCM_DEFER_INTS;
   url out= get_texmacs_home_path ();
   // TMSCM_ALLOW_INTS;
@@ -388,6 +425,7 @@ tmg_get_texmacs_home_path () {
 
 tmscm
 tmg_plugin_list () {
+  PROFILE_TALLY ("glue plugin-list");
   // TMSCM_DEFER_INTS;
   scheme_tree out= plugin_list ();
   // TMSCM_ALLOW_INTS;
@@ -397,6 +435,7 @@ tmg_plugin_list () {
 
 tmscm
 tmg_set_fast_environments (tmscm arg1) {
+  PROFILE_TALLY ("glue set-fast-environments");
   TMSCM_ASSERT_BOOL (arg1, TMSCM_ARG1, "set-fast-environments");
 
   bool in1= tmscm_to_bool (arg1);
@@ -410,6 +449,7 @@ tmg_set_fast_environments (tmscm arg1) {
 
 tmscm
 tmg_font_exists_in_ttP (tmscm arg1) {
+  PROFILE_TALLY ("glue font-exists-in-tt?");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "font-exists-in-tt?");
 
   string in1= tmscm_to_string (arg1);
@@ -423,6 +463,7 @@ tmg_font_exists_in_ttP (tmscm arg1) {
 
 tmscm
 tmg_eval_system (tmscm arg1) {
+  PROFILE_TALLY ("glue eval-system");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "eval-system");
 
   string in1= tmscm_to_string (arg1);
@@ -436,6 +477,7 @@ tmg_eval_system (tmscm arg1) {
 
 tmscm
 tmg_var_eval_system (tmscm arg1) {
+  PROFILE_TALLY ("glue var-eval-system");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "var-eval-system");
 
   string in1= tmscm_to_string (arg1);
@@ -449,6 +491,7 @@ tmg_var_eval_system (tmscm arg1) {
 
 tmscm
 tmg_evaluate_system (tmscm arg1, tmscm arg2, tmscm arg3, tmscm arg4) {
+  PROFILE_TALLY ("glue evaluate-system");
   TMSCM_ASSERT_ARRAY_STRING (arg1, TMSCM_ARG1, "evaluate-system");
   TMSCM_ASSERT_ARRAY_INT (arg2, TMSCM_ARG2, "evaluate-system");
   TMSCM_ASSERT_ARRAY_STRING (arg3, TMSCM_ARG3, "evaluate-system");
@@ -468,6 +511,7 @@ tmg_evaluate_system (tmscm arg1, tmscm arg2, tmscm arg3, tmscm arg4) {
 
 tmscm
 tmg_get_locale_language () {
+  PROFILE_TALLY ("glue get-locale-language");
   // TMSCM_DEFER_INTS;
   string out= get_locale_language ();
   // TMSCM_ALLOW_INTS;
@@ -477,6 +521,7 @@ tmg_get_locale_language () {
 
 tmscm
 tmg_get_locale_charset () {
+  PROFILE_TALLY ("glue get-locale-charset");
   // TMSCM_DEFER_INTS;
   string out= get_locale_charset ();
   // TMSCM_ALLOW_INTS;
@@ -486,6 +531,7 @@ tmg_get_locale_charset () {
 
 tmscm
 tmg_locale_to_language (tmscm arg1) {
+  PROFILE_TALLY ("glue locale-to-language");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "locale-to-language");
 
   string in1= tmscm_to_string (arg1);
@@ -499,6 +545,7 @@ tmg_locale_to_language (tmscm arg1) {
 
 tmscm
 tmg_language_to_locale (tmscm arg1) {
+  PROFILE_TALLY ("glue language-to-locale");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "language-to-locale");
 
   string in1= tmscm_to_string (arg1);
@@ -512,6 +559,7 @@ tmg_language_to_locale (tmscm arg1) {
 
 tmscm
 tmg_texmacs_time () {
+  PROFILE_TALLY ("glue texmacs-time");
   // TMSCM_DEFER_INTS;
   int out= texmacs_time ();
   // TMSCM_ALLOW_INTS;
@@ -521,6 +569,7 @@ tmg_texmacs_time () {
 
 tmscm
 tmg_pretty_time (tmscm arg1) {
+  PROFILE_TALLY ("glue pretty-time");
   TMSCM_ASSERT_INT (arg1, TMSCM_ARG1, "pretty-time");
 
   int in1= tmscm_to_int (arg1);
@@ -534,6 +583,7 @@ tmg_pretty_time (tmscm arg1) {
 
 tmscm
 tmg_texmacs_memory () {
+  PROFILE_TALLY ("glue texmacs-memory");
   // TMSCM_DEFER_INTS;
   int out= mem_used ();
   // TMSCM_ALLOW_INTS;
@@ -543,6 +593,7 @@ tmg_texmacs_memory () {
 
 tmscm
 tmg_bench_print (tmscm arg1) {
+  PROFILE_TALLY ("glue bench-print");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "bench-print");
 
   string in1= tmscm_to_string (arg1);
@@ -556,6 +607,7 @@ tmg_bench_print (tmscm arg1) {
 
 tmscm
 tmg_bench_print_all () {
+  PROFILE_TALLY ("glue bench-print-all");
   // TMSCM_DEFER_INTS;
   bench_print ();
   // TMSCM_ALLOW_INTS;
@@ -563,8 +615,73 @@ tmg_bench_print_all () {
   return TMSCM_UNSPECIFIED;
 }
 
+tmscm
+tmg_texmacs_peak_memory () {
+  PROFILE_TALLY ("glue texmacs-peak-memory");
+  // TMSCM_DEFER_INTS;
+  int out= peak_memory ();
+  // TMSCM_ALLOW_INTS;
+
+  return int_to_tmscm (out);
+}
+
+tmscm
+tmg_texmacs_memory_report () {
+  PROFILE_TALLY ("glue texmacs-memory-report");
+  // TMSCM_DEFER_INTS;
+  string out= memory_report ();
+  // TMSCM_ALLOW_INTS;
+
+  return string_to_tmscm (out);
+}
+
+tmscm
+tmg_profile_start () {
+  PROFILE_TALLY ("glue profile-start");
+  // TMSCM_DEFER_INTS;
+  profile_start ();
+  // TMSCM_ALLOW_INTS;
+
+  return TMSCM_UNSPECIFIED;
+}
+
+tmscm
+tmg_profile_stop () {
+  PROFILE_TALLY ("glue profile-stop");
+  // TMSCM_DEFER_INTS;
+  profile_stop ();
+  // TMSCM_ALLOW_INTS;
+
+  return TMSCM_UNSPECIFIED;
+}
+
+tmscm
+tmg_profile_reset () {
+  PROFILE_TALLY ("glue profile-reset");
+  // TMSCM_DEFER_INTS;
+  profile_reset ();
+  // TMSCM_ALLOW_INTS;
+
+  return TMSCM_UNSPECIFIED;
+}
+
+tmscm
+tmg_profile_time (tmscm arg1) {
+  PROFILE_TALLY ("glue profile-time");
+  TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "profile-time");
+
+  string in1= tmscm_to_string (arg1);
+
+  // TMSCM_DEFER_INTS;
+  double out= profile_time (in1);
+  // TMSCM_ALLOW_INTS;
+
+  return double_to_tmscm (out);
+}
+
 tmscm
 tmg_system_wait (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue system-wait");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "system-wait");
   TMSCM_ASSERT_STRING (arg2, TMSCM_ARG2, "system-wait");
 
@@ -578,8 +695,25 @@ tmg_system_wait (tmscm arg1, tmscm arg2) {
   return TMSCM_UNSPECIFIED;
 }
 
+tmscm
+tmg_system_async (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue system-async");
+  TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "system-async");
+  TMSCM_ASSERT_COMMAND (arg2, TMSCM_ARG2, "system-async");
+
+  string in1= tmscm_to_string (arg1);
+  command in2= tmscm_to_command (arg2);
+
+  // TMSCM_DEFER_INTS;
+  background_system (in1, in2);
+  // TMSCM_ALLOW_INTS;
+
+  return TMSCM_UNSPECIFIED;
+}
+
 tmscm
 tmg_get_show_kbd () {
+  PROFILE_TALLY ("glue get-show-kbd");
   // TMSCM_DEFER_INTS;
   bool out= get_show_kbd ();
   // TMSCM_ALLOW_INTS;
@@ -589,6 +723,7 @@ tmg_get_show_kbd () {
 
 tmscm
 tmg_set_show_kbd (tmscm arg1) {
+  PROFILE_TALLY ("glue set-show-kbd");
   TMSCM_ASSERT_BOOL (arg1, TMSCM_ARG1, "set-show-kbd");
 
   bool in1= tmscm_to_bool (arg1);
@@ -600,8 +735,87 @@ tmg_set_show_kbd (tmscm arg1) {
   return TMSCM_UNSPECIFIED;
 }
 
+tmscm
+tmg_keyboard_record_start () {
+  PROFILE_TALLY ("glue keyboard-record-start");
+  // TMSCM_DEFER_INTS;
+  start_recording_keys ();
+  // TMSCM_ALLOW_INTS;
+
+  return TMSCM_UNSPECIFIED;
+}
+
+tmscm
+tmg_keyboard_record_stop (tmscm arg1) {
+  PROFILE_TALLY ("glue keyboard-record-stop");
+  TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "keyboard-record-stop");
+
+  url in1= tmscm_to_url (arg1);
+
+  // TMSCM_DEFER_INTS;
+  bool out= stop_recording_keys (in1);
+  // TMSCM_ALLOW_INTS;
+
+  return bool_to_tmscm (out);
+}
+
+tmscm
+tmg_latency_start (tmscm arg1) {
+  PROFILE_TALLY ("glue latency-start");
+  TMSCM_ASSERT_INT (arg1, TMSCM_ARG1, "latency-start");
+
+  int in1= tmscm_to_int (arg1);
+
+  // TMSCM_DEFER_INTS;
+  latency_start (in1);
+  // TMSCM_ALLOW_INTS;
+
+  return TMSCM_UNSPECIFIED;
+}
+
+tmscm
+tmg_latency_stop () {
+  PROFILE_TALLY ("glue latency-stop");
+  // TMSCM_DEFER_INTS;
+  latency_stop ();
+  // TMSCM_ALLOW_INTS;
+
+  return TMSCM_UNSPECIFIED;
+}
+
+tmscm
+tmg_latency_reset () {
+  PROFILE_TALLY ("glue latency-reset");
+  // TMSCM_DEFER_INTS;
+  latency_reset ();
+  // TMSCM_ALLOW_INTS;
+
+  return TMSCM_UNSPECIFIED;
+}
+
+tmscm
+tmg_latency_report () {
+  PROFILE_TALLY ("glue latency-report");
+  // TMSCM_DEFER_INTS;
+  string out= latency_report ();
+  // TMSCM_ALLOW_INTS;
+
+  return string_to_tmscm (out);
+}
+
+tmscm
+tmg_latency_distribution () {
+  PROFILE_TALLY ("glue latency-distribution");
+  // TMSCM_DEFER_INTS;
+  string out= latency_distribution ();
+  // TMSCM_ALLOW_INTS;
+
+  return string_to_tmscm (out);
+}
+
 tmscm
 tmg_set_latex_command (tmscm arg1) {
+  PROFILE_TALLY ("glue set-latex-command");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "set-latex-command");
 
   string in1= tmscm_to_string (arg1);
@@ -615,6 +829,7 @@ tmg_set_latex_command (tmscm arg1) {
 
 tmscm
 tmg_set_bibtex_command (tmscm arg1) {
+  PROFILE_TALLY ("glue set-bibtex-command");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "set-bibtex-command");
 
   string in1= tmscm_to_string (arg1);
@@ -628,6 +843,7 @@ tmg_set_bibtex_command (tmscm arg1) {
 
 tmscm
 tmg_number_latex_errors (tmscm arg1) {
+  PROFILE_TALLY ("glue number-latex-errors");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "number-latex-errors");
 
   url in1= tmscm_to_url (arg1);
@@ -641,6 +857,7 @@ tmg_number_latex_errors (tmscm arg1) {
 
 tmscm
 tmg_number_latex_pages (tmscm arg1) {
+  PROFILE_TALLY ("glue number-latex-pages");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "number-latex-pages");
 
   url in1= tmscm_to_url (arg1);
@@ -654,6 +871,7 @@ tmg_number_latex_pages (tmscm arg1) {
 
 tmscm
 tmg_math_symbol_group (tmscm arg1) {
+  PROFILE_TALLY ("glue math-symbol-group");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "math-symbol-group");
 
   string in1= tmscm_to_string (arg1);
@@ -667,6 +885,7 @@ tmg_math_symbol_group (tmscm arg1) {
 
 tmscm
 tmg_math_group_members (tmscm arg1) {
+  PROFILE_TALLY ("glue math-group-members");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "math-group-members");
 
   string in1= tmscm_to_string (arg1);
@@ -680,6 +899,7 @@ tmg_math_group_members (tmscm arg1) {
 
 tmscm
 tmg_math_symbol_type (tmscm arg1) {
+  PROFILE_TALLY ("glue math-symbol-type");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "math-symbol-type");
 
   string in1= tmscm_to_string (arg1);
@@ -693,6 +913,7 @@ tmg_math_symbol_type (tmscm arg1) {
 
 tmscm
 tmg_object_2command (tmscm arg1) {
+  PROFILE_TALLY ("glue object->command");
   TMSCM_ASSERT_OBJECT (arg1, TMSCM_ARG1, "object->command");
 
   object in1= tmscm_to_object (arg1);
@@ -706,6 +927,7 @@ tmg_object_2command (tmscm arg1) {
 
 tmscm
 tmg_exec_delayed (tmscm arg1) {
+  PROFILE_TALLY ("glue exec-delayed");
   TMSCM_ASSERT_OBJECT (arg1, TMSCM_ARG1, "exec-delayed");
 
   object in1= tmscm_to_object (arg1);
@@ -719,6 +941,7 @@ tmg_exec_delayed (tmscm arg1) {
 
 tmscm
 tmg_exec_delayed_pause (tmscm arg1) {
+  PROFILE_TALLY ("glue exec-delayed-pause");
   TMSCM_ASSERT_OBJECT (arg1, TMSCM_ARG1, "exec-delayed-pause");
 
   object in1= tmscm_to_object (arg1);
@@ -732,6 +955,7 @@ tmg_exec_delayed_pause (tmscm arg1) {
 
 tmscm
 tmg_protected_call (tmscm arg1) {
+  PROFILE_TALLY ("glue protected-call");
   TMSCM_ASSERT_OBJECT (arg1, TMSCM_ARG1, "protected-call");
 
   object in1= tmscm_to_object (arg1);
@@ -745,6 +969,7 @@ tmg_protected_call (tmscm arg1) {
 
 tmscm
 tmg_notify_preferences_booted () {
+  PROFILE_TALLY ("glue notify-preferences-booted");
   // TMSCM_DEFER_INTS;
   notify_preferences_booted ();
   // TMSCM_ALLOW_INTS;
@@ -754,6 +979,7 @@ tmg_notify_preferences_booted () {
 
 tmscm
 tmg_cpp_has_preferenceP (tmscm arg1) {
+  PROFILE_TALLY ("glue cpp-has-preference?");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "cpp-has-preference?");
 
   string in1= tmscm_to_string (arg1);
@@ -767,6 +993,7 @@ tmg_cpp_has_preferenceP (tmscm arg1) {
 
 tmscm
 tmg_cpp_get_preference (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue cpp-get-preference");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "cpp-get-preference");
   TMSCM_ASSERT_STRING (arg2, TMSCM_ARG2, "cpp-get-preference");
 
@@ -782,6 +1009,7 @@ tmg_cpp_get_preference (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_cpp_set_preference (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue cpp-set-preference");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "cpp-set-preference");
   TMSCM_ASSERT_STRING (arg2, TMSCM_ARG2, "cpp-set-preference");
 
@@ -797,6 +1025,7 @@ tmg_cpp_set_preference (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_cpp_reset_preference (tmscm arg1) {
+  PROFILE_TALLY ("glue cpp-reset-preference");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "cpp-reset-preference");
 
   string in1= tmscm_to_string (arg1);
@@ -810,6 +1039,7 @@ tmg_cpp_reset_preference (tmscm arg1) {
 
 tmscm
 tmg_save_preferences () {
+  PROFILE_TALLY ("glue save-preferences");
   // TMSCM_DEFER_INTS;
   save_user_preferences ();
   // TMSCM_ALLOW_INTS;
@@ -819,6 +1049,7 @@ tmg_save_preferences () {
 
 tmscm
 tmg_get_default_printing_command () {
+  PROFILE_TALLY ("glue get-default-printing-command");
   // TMSCM_DEFER_INTS;
   string out= get_printing_default ();
   // TMSCM_ALLOW_INTS;
@@ -828,6 +1059,7 @@ tmg_get_default_printing_command () {
 
 tmscm
 tmg_set_input_language (tmscm arg1) {
+  PROFILE_TALLY ("glue set-input-language");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "set-input-language");
 
   string in1= tmscm_to_string (arg1);
@@ -841,6 +1073,7 @@ tmg_set_input_language (tmscm arg1) {
 
 tmscm
 tmg_get_input_language () {
+  PROFILE_TALLY ("glue get-input-language");
   // TMSCM_DEFER_INTS;
   string out= get_input_language ();
   // TMSCM_ALLOW_INTS;
@@ -850,6 +1083,7 @@ tmg_get_input_language () {
 
 tmscm
 tmg_set_output_language (tmscm arg1) {
+  PROFILE_TALLY ("glue set-output-language");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "set-output-language");
 
   string in1= tmscm_to_string (arg1);
@@ -863,6 +1097,7 @@ tmg_set_output_language (tmscm arg1) {
 
 tmscm
 tmg_get_output_language () {
+  PROFILE_TALLY ("glue get-output-language");
   // TMSCM_DEFER_INTS;
   string out= get_output_language ();
   // TMSCM_ALLOW_INTS;
@@ -872,6 +1107,7 @@ tmg_get_output_language () {
 
 tmscm
 tmg_translate (tmscm arg1) {
+  PROFILE_TALLY ("glue translate");
   TMSCM_ASSERT_CONTENT (arg1, TMSCM_ARG1, "translate");
 
   content in1= tmscm_to_content (arg1);
@@ -885,6 +1121,7 @@ tmg_translate (tmscm arg1) {
 
 tmscm
 tmg_string_translate (tmscm arg1) {
+  PROFILE_TALLY ("glue string-translate");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "string-translate");
 
   string in1= tmscm_to_string (arg1);
@@ -898,6 +1135,7 @@ tmg_string_translate (tmscm arg1) {
 
 tmscm
 tmg_translate_from_to (tmscm arg1, tmscm arg2, tmscm arg3) {
+  PROFILE_TALLY ("glue translate-from-to");
   TMSCM_ASSERT_CONTENT (arg1, TMSCM_ARG1, "translate-from-to");
   TMSCM_ASSERT_STRING (arg2, TMSCM_ARG2, "translate-from-to");
   TMSCM_ASSERT_STRING (arg3, TMSCM_ARG3, "translate-from-to");
@@ -915,6 +1153,7 @@ tmg_translate_from_to (tmscm arg1, tmscm arg2, tmscm arg3) {
 
 tmscm
 tmg_tree_translate (tmscm arg1) {
+  PROFILE_TALLY ("glue tree-translate");
   TMSCM_ASSERT_CONTENT (arg1, TMSCM_ARG1, "tree-translate");
 
   content in1= tmscm_to_content (arg1);
@@ -928,6 +1167,7 @@ tmg_tree_translate (tmscm arg1) {
 
 tmscm
 tmg_tree_translate_from_to (tmscm arg1, tmscm arg2, tmscm arg3) {
+  PROFILE_TALLY ("glue tree-translate-from-to");
   TMSCM_ASSERT_CONTENT (arg1, TMSCM_ARG1, "tree-translate-from-to");
   TMSCM_ASSERT_STRING (arg2, TMSCM_ARG2, "tree-translate-from-to");
   TMSCM_ASSERT_STRING (arg3, TMSCM_ARG3, "tree-translate-from-to");
@@ -945,6 +1185,7 @@ tmg_tree_translate_from_to (tmscm arg1, tmscm arg2, tmscm arg3) {
 
 tmscm
 tmg_force_load_translations (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue force-load-translations");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "force-load-translations");
   TMSCM_ASSERT_STRING (arg2, TMSCM_ARG2, "force-load-translations");
 
@@ -960,6 +1201,7 @@ tmg_force_load_translations (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_color (tmscm arg1) {
+  PROFILE_TALLY ("glue color");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "color");
 
   string in1= tmscm_to_string (arg1);
@@ -973,6 +1215,7 @@ tmg_color (tmscm arg1) {
 
 tmscm
 tmg_get_hex_color (tmscm arg1) {
+  PROFILE_TALLY ("glue get-hex-color");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "get-hex-color");
 
   string in1= tmscm_to_string (arg1);
@@ -986,6 +1229,7 @@ tmg_get_hex_color (tmscm arg1) {
 
 tmscm
 tmg_named_color_2xcolormap (tmscm arg1) {
+  PROFILE_TALLY ("glue named-color->xcolormap");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "named-color->xcolormap");
 
   string in1= tmscm_to_string (arg1);
@@ -999,6 +1243,7 @@ tmg_named_color_2xcolormap (tmscm arg1) {
 
 tmscm
 tmg_rgba_2named_color (tmscm arg1) {
+  PROFILE_TALLY ("glue rgba->named-color");
   TMSCM_ASSERT_ARRAY_INT (arg1, TMSCM_ARG1, "rgba->named-color");
 
   array_int in1= tmscm_to_array_int (arg1);
@@ -1012,6 +1257,7 @@ tmg_rgba_2named_color (tmscm arg1) {
 
 tmscm
 tmg_named_color_2rgba (tmscm arg1) {
+  PROFILE_TALLY ("glue named-color->rgba");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "named-color->rgba");
 
   string in1= tmscm_to_string (arg1);
@@ -1025,6 +1271,7 @@ tmg_named_color_2rgba (tmscm arg1) {
 
 tmscm
 tmg_new_author () {
+  PROFILE_TALLY ("glue new-author");
   // TMSCM_DEFER_INTS;
   double out= new_author ();
   // TMSCM_ALLOW_INTS;
@@ -1034,6 +1281,7 @@ tmg_new_author () {
 
 tmscm
 tmg_set_author (tmscm arg1) {
+  PROFILE_TALLY ("glue set-author");
   TMSCM_ASSERT_DOUBLE (arg1, TMSCM_ARG1, "set-author");
 
   double in1= tmscm_to_double (arg1);
@@ -1047,6 +1295,7 @@ tmg_set_author (tmscm arg1) {
 
 tmscm
 tmg_get_author () {
+  PROFILE_TALLY ("glue get-author");
   // TMSCM_DEFER_INTS;
   double out= get_author ();
   // TMSCM_ALLOW_INTS;
@@ -1056,6 +1305,7 @@ tmg_get_author () {
 
 tmscm
 tmg_debug_set (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue debug-set");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "debug-set");
   TMSCM_ASSERT_BOOL (arg2, TMSCM_ARG2, "debug-set");
 
@@ -1071,6 +1321,7 @@ tmg_debug_set (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_debug_get (tmscm arg1) {
+  PROFILE_TALLY ("glue debug-get");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "debug-get");
 
   string in1= tmscm_to_string (arg1);
@@ -1084,6 +1335,7 @@ tmg_debug_get (tmscm arg1) {
 
 tmscm
 tmg_debug_message (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue debug-message");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "debug-message");
   TMSCM_ASSERT_STRING (arg2, TMSCM_ARG2, "debug-message");
 
@@ -1099,6 +1351,7 @@ tmg_debug_message (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_get_debug_messages (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue get-debug-messages");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "get-debug-messages");
   TMSCM_ASSERT_INT (arg2, TMSCM_ARG2, "get-debug-messages");
 
@@ -1114,6 +1367,7 @@ tmg_get_debug_messages (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_clear_debug_messages () {
+  PROFILE_TALLY ("glue clear-debug-messages");
   // TMSCM_DEFER_INTS;
   clear_debug_messages ();
   // TMSCM_ALLOW_INTS;
@@ -1123,6 +1377,7 @@ tmg_clear_debug_messages () {
 
 tmscm
 tmg_cout_buffer () {
+  PROFILE_TALLY ("glue cout-buffer");
   // TMSCM_DEFER_INTS;
   cout_buffer ();
   // TMSCM_ALLOW_INTS;
@@ -1132,6 +1387,7 @@ tmg_cout_buffer () {
 
 tmscm
 tmg_cout_unbuffer () {
+  PROFILE_TALLY ("glue cout-unbuffer");
   // TMSCM_DEFER_INTS;
   string out= cout_unbuffer ();
   // TMSCM_ALLOW_INTS;
@@ -1141,6 +1397,7 @@ tmg_cout_unbuffer () {
 
 tmscm
 tmg_mark_new () {
+  PROFILE_TALLY ("glue mark-new");
   // TMSCM_DEFER_INTS;
   double out= new_marker ();
   // TMSCM_ALLOW_INTS;
@@ -1150,6 +1407,7 @@ tmg_mark_new () {
 
 tmscm
 tmg_glyph_register (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue glyph-register");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "glyph-register");
   TMSCM_ASSERT_ARRAY_ARRAY_ARRAY_DOUBLE (arg2, TMSCM_ARG2, "glyph-register");
 
@@ -1165,6 +1423,7 @@ tmg_glyph_register (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_glyph_recognize (tmscm arg1) {
+  PROFILE_TALLY ("glue glyph-recognize");
   TMSCM_ASSERT_ARRAY_ARRAY_ARRAY_DOUBLE (arg1, TMSCM_ARG1, "glyph-recognize");
 
   array_array_array_double in1= tmscm_to_array_array_array_double (arg1);
@@ -1178,6 +1437,7 @@ tmg_glyph_recognize (tmscm arg1) {
 
 tmscm
 tmg_set_new_fonts (tmscm arg1) {
+  PROFILE_TALLY ("glue set-new-fonts");
   TMSCM_ASSERT_BOOL (arg1, TMSCM_ARG1, "set-new-fonts");
 
   bool in1= tmscm_to_bool (arg1);
@@ -1191,6 +1451,7 @@ tmg_set_new_fonts (tmscm arg1) {
 
 tmscm
 tmg_new_fontsP () {
+  PROFILE_TALLY ("glue new-fonts?");
   // TMSCM_DEFER_INTS;
   bool out= get_new_fonts ();
   // TMSCM_ALLOW_INTS;
@@ -1200,6 +1461,7 @@ tmg_new_fontsP () {
 
 tmscm
 tmg_tmtm_eqnumber_2nonumber (tmscm arg1) {
+  PROFILE_TALLY ("glue tmtm-eqnumber->nonumber");
   TMSCM_ASSERT_TREE (arg1, TMSCM_ARG1, "tmtm-eqnumber->nonumber");
 
   tree in1= tmscm_to_tree (arg1);
@@ -1213,6 +1475,7 @@ tmg_tmtm_eqnumber_2nonumber (tmscm arg1) {
 
 tmscm
 tmg_busy_versioningP () {
+  PROFILE_TALLY ("glue busy-versioning?");
   // TMSCM_DEFER_INTS;
   bool out= is_busy_versioning ();
   // TMSCM_ALLOW_INTS;
@@ -1222,6 +1485,7 @@ tmg_busy_versioningP () {
 
 tmscm
 tmg_players_set_elapsed (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue players-set-elapsed");
   TMSCM_ASSERT_TREE (arg1, TMSCM_ARG1, "players-set-elapsed");
   TMSCM_ASSERT_DOUBLE (arg2, TMSCM_ARG2, "players-set-elapsed");
 
@@ -1237,6 +1501,7 @@ tmg_players_set_elapsed (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_players_set_speed (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue players-set-speed");
   TMSCM_ASSERT_TREE (arg1, TMSCM_ARG1, "players-set-speed");
   TMSCM_ASSERT_DOUBLE (arg2, TMSCM_ARG2, "players-set-speed");
 
@@ -1252,6 +1517,7 @@ tmg_players_set_speed (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_apply_effect (tmscm arg1, tmscm arg2, tmscm arg3, tmscm arg4, tmscm arg5) {
+  PROFILE_TALLY ("glue apply-effect");
   TMSCM_ASSERT_CONTENT (arg1, TMSCM_ARG1, "apply-effect");
   TMSCM_ASSERT_ARRAY_URL (arg2, TMSCM_ARG2, "apply-effect");
   TMSCM_ASSERT_URL (arg3, TMSCM_ARG3, "apply-effect");
@@ -1273,6 +1539,7 @@ tmg_apply_effect (tmscm arg1, tmscm arg2, tmscm arg3, tmscm arg4, tmscm arg5) {
 
 tmscm
 tmg_tt_existsP (tmscm arg1) {
+  PROFILE_TALLY ("glue tt-exists?");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "tt-exists?");
 
   string in1= tmscm_to_string (arg1);
@@ -1286,6 +1553,7 @@ tmg_tt_existsP (tmscm arg1) {
 
 tmscm
 tmg_tt_dump (tmscm arg1) {
+  PROFILE_TALLY ("glue tt-dump");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "tt-dump");
 
   url in1= tmscm_to_url (arg1);
@@ -1299,6 +1567,7 @@ tmg_tt_dump (tmscm arg1) {
 
 tmscm
 tmg_tt_font_name (tmscm arg1) {
+  PROFILE_TALLY ("glue tt-font-name");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "tt-font-name");
 
   url in1= tmscm_to_url (arg1);
@@ -1312,6 +1581,7 @@ tmg_tt_font_name (tmscm arg1) {
 
 tmscm
 tmg_tt_analyze (tmscm arg1) {
+  PROFILE_TALLY ("glue tt-analyze");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "tt-analyze");
 
   string in1= tmscm_to_string (arg1);
@@ -1325,6 +1595,7 @@ tmg_tt_analyze (tmscm arg1) {
 
 tmscm
 tmg_font_database_build (tmscm arg1) {
+  PROFILE_TALLY ("glue font-database-build");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "font-database-build");
 
   url in1= tmscm_to_url (arg1);
@@ -1338,6 +1609,7 @@ tmg_font_database_build (tmscm arg1) {
 
 tmscm
 tmg_font_database_build_local () {
+  PROFILE_TALLY ("glue font-database-build-local");
   // TMSCM_DEFER_INTS;
   font_database_build_local ();
   // TMSCM_ALLOW_INTS;
@@ -1347,6 +1619,7 @@ tmg_font_database_build_local () {
 
 tmscm
 tmg_font_database_extend_local (tmscm arg1) {
+  PROFILE_TALLY ("glue font-database-extend-local");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "font-database-extend-local");
 
   url in1= tmscm_to_url (arg1);
@@ -1360,6 +1633,7 @@ tmg_font_database_extend_local (tmscm arg1) {
 
 tmscm
 tmg_font_database_build_global () {
+  PROFILE_TALLY ("glue font-database-build-global");
   // TMSCM_DEFER_INTS;
   font_database_build_global ();
   // TMSCM_ALLOW_INTS;
@@ -1369,6 +1643,7 @@ tmg_font_database_build_global () {
 
 tmscm
 tmg_font_database_build_characteristics (tmscm arg1) {
+  PROFILE_TALLY ("glue font-database-build-characteristics");
   TMSCM_ASSERT_BOOL (arg1, TMSCM_ARG1, "font-database-build-characteristics");
 
   bool in1= tmscm_to_bool (arg1);
@@ -1382,6 +1657,7 @@ tmg_font_database_build_characteristics (tmscm arg1) {
 
 tmscm
 tmg_font_database_insert_global (tmscm arg1) {
+  PROFILE_TALLY ("glue font-database-insert-global");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "font-database-insert-global");
 
   url in1= tmscm_to_url (arg1);
@@ -1395,6 +1671,7 @@ tmg_font_database_insert_global (tmscm arg1) {
 
 tmscm
 tmg_font_database_save_local_delta () {
+  PROFILE_TALLY ("glue font-database-save-local-delta");
   // TMSCM_DEFER_INTS;
   font_database_save_local_delta ();
   // TMSCM_ALLOW_INTS;
@@ -1404,6 +1681,7 @@ tmg_font_database_save_local_delta () {
 
 tmscm
 tmg_font_database_load () {
+  PROFILE_TALLY ("glue font-database-load");
   // TMSCM_DEFER_INTS;
   font_database_load ();
   // TMSCM_ALLOW_INTS;
@@ -1413,6 +1691,7 @@ tmg_font_database_load () {
 
 tmscm
 tmg_font_database_save () {
+  PROFILE_TALLY ("glue font-database-save");
   // TMSCM_DEFER_INTS;
   font_database_save ();
   // TMSCM_ALLOW_INTS;
@@ -1422,6 +1701,7 @@ tmg_font_database_save () {
 
 tmscm
 tmg_font_database_filter () {
+  PROFILE_TALLY ("glue font-database-filter");
   // TMSCM_DEFER_INTS;
   font_database_filter ();
   // TMSCM_ALLOW_INTS;
@@ -1431,6 +1711,7 @@ tmg_font_database_filter () {
 
 tmscm
 tmg_font_database_families () {
+  PROFILE_TALLY ("glue font-database-families");
   // TMSCM_DEFER_INTS;
   array_string out= font_database_families ();
   // TMSCM_ALLOW_INTS;
@@ -1440,6 +1721,7 @@ tmg_font_database_families () {
 
 tmscm
 tmg_font_database_delta_families () {
+  PROFILE_TALLY ("glue font-database-delta-families");
   // TMSCM_DEFER_INTS;
   array_string out= font_database_delta_families ();
   // TMSCM_ALLOW_INTS;
@@ -1449,6 +1731,7 @@ tmg_font_database_delta_families () {
 
 tmscm
 tmg_font_database_styles (tmscm arg1) {
+  PROFILE_TALLY ("glue font-database-styles");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "font-database-styles");
 
   string in1= tmscm_to_string (arg1);
@@ -1462,6 +1745,7 @@ tmg_font_database_styles (tmscm arg1) {
 
 tmscm
 tmg_font_database_search (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue font-database-search");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "font-database-search");
   TMSCM_ASSERT_STRING (arg2, TMSCM_ARG2, "font-database-search");
 
@@ -1477,6 +1761,7 @@ tmg_font_database_search (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_font_database_characteristics (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue font-database-characteristics");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "font-database-characteristics");
   TMSCM_ASSERT_STRING (arg2, TMSCM_ARG2, "font-database-characteristics");
 
@@ -1492,6 +1777,7 @@ tmg_font_database_characteristics (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_font_database_substitutions (tmscm arg1) {
+  PROFILE_TALLY ("glue font-database-substitutions");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "font-database-substitutions");
 
   string in1= tmscm_to_string (arg1);
@@ -1505,6 +1791,7 @@ tmg_font_database_substitutions (tmscm arg1) {
 
 tmscm
 tmg_font_family_2master (tmscm arg1) {
+  PROFILE_TALLY ("glue font-family->master");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "font-family->master");
 
   string in1= tmscm_to_string (arg1);
@@ -1518,6 +1805,7 @@ tmg_font_family_2master (tmscm arg1) {
 
 tmscm
 tmg_font_master_2families (tmscm arg1) {
+  PROFILE_TALLY ("glue font-master->families");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "font-master->families");
 
   string in1= tmscm_to_string (arg1);
@@ -1531,6 +1819,7 @@ tmg_font_master_2families (tmscm arg1) {
 
 tmscm
 tmg_font_master_features (tmscm arg1) {
+  PROFILE_TALLY ("glue font-master-features");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "font-master-features");
 
   string in1= tmscm_to_string (arg1);
@@ -1544,6 +1833,7 @@ tmg_font_master_features (tmscm arg1) {
 
 tmscm
 tmg_font_family_features (tmscm arg1) {
+  PROFILE_TALLY ("glue font-family-features");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "font-family-features");
 
   string in1= tmscm_to_string (arg1);
@@ -1557,6 +1847,7 @@ tmg_font_family_features (tmscm arg1) {
 
 tmscm
 tmg_font_family_strict_features (tmscm arg1) {
+  PROFILE_TALLY ("glue font-family-strict-features");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "font-family-strict-features");
 
   string in1= tmscm_to_string (arg1);
@@ -1570,6 +1861,7 @@ tmg_font_family_strict_features (tmscm arg1) {
 
 tmscm
 tmg_font_style_features (tmscm arg1) {
+  PROFILE_TALLY ("glue font-style-features");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "font-style-features");
 
   string in1= tmscm_to_string (arg1);
@@ -1583,6 +1875,7 @@ tmg_font_style_features (tmscm arg1) {
 
 tmscm
 tmg_font_guessed_features (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue font-guessed-features");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "font-guessed-features");
   TMSCM_ASSERT_STRING (arg2, TMSCM_ARG2, "font-guessed-features");
 
@@ -1598,6 +1891,7 @@ tmg_font_guessed_features (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_font_guessed_distance (tmscm arg1, tmscm arg2, tmscm arg3, tmscm arg4) {
+  PROFILE_TALLY ("glue font-guessed-distance");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "font-guessed-distance");
   TMSCM_ASSERT_STRING (arg2, TMSCM_ARG2, "font-guessed-distance");
   TMSCM_ASSERT_STRING (arg3, TMSCM_ARG3, "font-guessed-distance");
@@ -1617,6 +1911,7 @@ tmg_font_guessed_distance (tmscm arg1, tmscm arg2, tmscm arg3, tmscm arg4) {
 
 tmscm
 tmg_font_master_guessed_distance (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue font-master-guessed-distance");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "font-master-guessed-distance");
   TMSCM_ASSERT_STRING (arg2, TMSCM_ARG2, "font-master-guessed-distance");
 
@@ -1632,6 +1927,7 @@ tmg_font_master_guessed_distance (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_font_family_guessed_features (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue font-family-guessed-features");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "font-family-guessed-features");
   TMSCM_ASSERT_BOOL (arg2, TMSCM_ARG2, "font-family-guessed-features");
 
@@ -1647,6 +1943,7 @@ tmg_font_family_guessed_features (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_characteristic_distance (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue characteristic-distance");
   TMSCM_ASSERT_ARRAY_STRING (arg1, TMSCM_ARG1, "characteristic-distance");
   TMSCM_ASSERT_ARRAY_STRING (arg2, TMSCM_ARG2, "characteristic-distance");
 
@@ -1662,6 +1959,7 @@ tmg_characteristic_distance (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_trace_distance (tmscm arg1, tmscm arg2, tmscm arg3) {
+  PROFILE_TALLY ("glue trace-distance");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "trace-distance");
   TMSCM_ASSERT_STRING (arg2, TMSCM_ARG2, "trace-distance");
   TMSCM_ASSERT_DOUBLE (arg3, TMSCM_ARG3, "trace-distance");
@@ -1679,6 +1977,7 @@ tmg_trace_distance (tmscm arg1, tmscm arg2, tmscm arg3) {
 
 tmscm
 tmg_logical_font_public (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue logical-font-public");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "logical-font-public");
   TMSCM_ASSERT_STRING (arg2, TMSCM_ARG2, "logical-font-public");
 
@@ -1694,6 +1993,7 @@ tmg_logical_font_public (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_logical_font_exact (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue logical-font-exact");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "logical-font-exact");
   TMSCM_ASSERT_STRING (arg2, TMSCM_ARG2, "logical-font-exact");
 
@@ -1709,6 +2009,7 @@ tmg_logical_font_exact (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_logical_font_private (tmscm arg1, tmscm arg2, tmscm arg3, tmscm arg4) {
+  PROFILE_TALLY ("glue logical-font-private");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "logical-font-private");
   TMSCM_ASSERT_STRING (arg2, TMSCM_ARG2, "logical-font-private");
   TMSCM_ASSERT_STRING (arg3, TMSCM_ARG3, "logical-font-private");
@@ -1728,6 +2029,7 @@ tmg_logical_font_private (tmscm arg1, tmscm arg2, tmscm arg3, tmscm arg4) {
 
 tmscm
 tmg_logical_font_family (tmscm arg1) {
+  PROFILE_TALLY ("glue logical-font-family");
   TMSCM_ASSERT_ARRAY_STRING (arg1, TMSCM_ARG1, "logical-font-family");
 
   array_string in1= tmscm_to_array_string (arg1);
@@ -1741,6 +2043,7 @@ tmg_logical_font_family (tmscm arg1) {
 
 tmscm
 tmg_logical_font_variant (tmscm arg1) {
+  PROFILE_TALLY ("glue logical-font-variant");
   TMSCM_ASSERT_ARRAY_STRING (arg1, TMSCM_ARG1, "logical-font-variant");
 
   array_string in1= tmscm_to_array_string (arg1);
@@ -1754,6 +2057,7 @@ tmg_logical_font_variant (tmscm arg1) {
 
 tmscm
 tmg_logical_font_series (tmscm arg1) {
+  PROFILE_TALLY ("glue logical-font-series");
   TMSCM_ASSERT_ARRAY_STRING (arg1, TMSCM_ARG1, "logical-font-series");
 
   array_string in1= tmscm_to_array_string (arg1);
@@ -1767,6 +2071,7 @@ tmg_logical_font_series (tmscm arg1) {
 
 tmscm
 tmg_logical_font_shape (tmscm arg1) {
+  PROFILE_TALLY ("glue logical-font-shape");
   TMSCM_ASSERT_ARRAY_STRING (arg1, TMSCM_ARG1, "logical-font-shape");
 
   array_string in1= tmscm_to_array_string (arg1);
@@ -1780,6 +2085,7 @@ tmg_logical_font_shape (tmscm arg1) {
 
 tmscm
 tmg_logical_font_search (tmscm arg1) {
+  PROFILE_TALLY ("glue logical-font-search");
   TMSCM_ASSERT_ARRAY_STRING (arg1, TMSCM_ARG1, "logical-font-search");
 
   array_string in1= tmscm_to_array_string (arg1);
@@ -1793,6 +2099,7 @@ tmg_logical_font_search (tmscm arg1) {
 
 tmscm
 tmg_logical_font_search_exact (tmscm arg1) {
+  PROFILE_TALLY ("glue logical-font-search-exact");
   TMSCM_ASSERT_ARRAY_STRING (arg1, TMSCM_ARG1, "logical-font-search-exact");
 
   array_string in1= tmscm_to_array_string (arg1);
@@ -1806,6 +2113,7 @@ tmg_logical_font_search_exact (tmscm arg1) {
 
 tmscm
 tmg_search_font_families (tmscm arg1) {
+  PROFILE_TALLY ("glue search-font-families");
   TMSCM_ASSERT_ARRAY_STRING (arg1, TMSCM_ARG1, "search-font-families");
 
   array_string in1= tmscm_to_array_string (arg1);
@@ -1819,6 +2127,7 @@ tmg_search_font_families (tmscm arg1) {
 
 tmscm
 tmg_search_font_styles (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue search-font-styles");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "search-font-styles");
   TMSCM_ASSERT_ARRAY_STRING (arg2, TMSCM_ARG2, "search-font-styles");
 
@@ -1834,6 +2143,7 @@ tmg_search_font_styles (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_logical_font_patch (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue logical-font-patch");
   TMSCM_ASSERT_ARRAY_STRING (arg1, TMSCM_ARG1, "logical-font-patch");
   TMSCM_ASSERT_ARRAY_STRING (arg2, TMSCM_ARG2, "logical-font-patch");
 
@@ -1849,6 +2159,7 @@ tmg_logical_font_patch (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_logical_font_substitute (tmscm arg1) {
+  PROFILE_TALLY ("glue logical-font-substitute");
   TMSCM_ASSERT_ARRAY_STRING (arg1, TMSCM_ARG1, "logical-font-substitute");
 
   array_string in1= tmscm_to_array_string (arg1);
@@ -1862,6 +2173,7 @@ tmg_logical_font_substitute (tmscm arg1) {
 
 tmscm
 tmg_font_family_main (tmscm arg1) {
+  PROFILE_TALLY ("glue font-family-main");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "font-family-main");
 
   string in1= tmscm_to_string (arg1);
@@ -1875,6 +2187,7 @@ tmg_font_family_main (tmscm arg1) {
 
 tmscm
 tmg_image_2psdoc (tmscm arg1) {
+  PROFILE_TALLY ("glue image->psdoc");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "image->psdoc");
 
   url in1= tmscm_to_url (arg1);
@@ -1888,6 +2201,7 @@ tmg_image_2psdoc (tmscm arg1) {
 
 tmscm
 tmg_anim_control_times (tmscm arg1) {
+  PROFILE_TALLY ("glue anim-control-times");
   TMSCM_ASSERT_CONTENT (arg1, TMSCM_ARG1, "anim-control-times");
 
   content in1= tmscm_to_content (arg1);
@@ -1901,19 +2215,21 @@ tmg_anim_control_times (tmscm arg1) {
 
 tmscm
 tmg_tree_2stree (tmscm arg1) {
+  PROFILE_TALLY ("glue tree->stree");
   TMSCM_ASSERT_TREE (arg1, TMSCM_ARG1, "tree->stree");
 
   tree in1= tmscm_to_tree (arg1);
 
   // TMSCM_DEFER_INTS;
-  scheme_tree out= tree_to_scheme_tree (in1);
+  object out= tree_to_stree (in1);
   // TMSCM_ALLOW_INTS;
 
-  return scheme_tree_to_tmscm (out);
+  return object_to_tmscm (out);
 }
 
 tmscm
 tmg_stree_2tree (tmscm arg1) {
+  PROFILE_TALLY ("glue stree->tree");
   TMSCM_ASSERT_SCHEME_TREE (arg1, TMSCM_ARG1, "stree->tree");
 
   scheme_tree in1= tmscm_to_scheme_tree (arg1);
@@ -1927,6 +2243,7 @@ tmg_stree_2tree (tmscm arg1) {
 
 tmscm
 tmg_tree_2string (tmscm arg1) {
+  PROFILE_TALLY ("glue tree->string");
   TMSCM_ASSERT_TREE (arg1, TMSCM_ARG1, "tree->string");
 
   tree in1= tmscm_to_tree (arg1);
@@ -1940,6 +2257,7 @@ tmg_tree_2string (tmscm arg1) {
 
 tmscm
 tmg_string_2tree (tmscm arg1) {
+  PROFILE_TALLY ("glue string->tree");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "string->tree");
 
   string in1= tmscm_to_string (arg1);
@@ -1953,6 +2271,7 @@ tmg_string_2tree (tmscm arg1) {
 
 tmscm
 tmg_tm_2tree (tmscm arg1) {
+  PROFILE_TALLY ("glue tm->tree");
   TMSCM_ASSERT_CONTENT (arg1, TMSCM_ARG1, "tm->tree");
 
   content in1= tmscm_to_content (arg1);
@@ -1966,6 +2285,7 @@ tmg_tm_2tree (tmscm arg1) {
 
 tmscm
 tmg_tree_atomicP (tmscm arg1) {
+  PROFILE_TALLY ("glue tree-atomic?");
   TMSCM_ASSERT_TREE (arg1, TMSCM_ARG1, "tree-atomic?");
 
   tree in1= tmscm_to_tree (arg1);
@@ -1979,6 +2299,7 @@ tmg_tree_atomicP (tmscm arg1) {
 
 tmscm
 tmg_tree_compoundP (tmscm arg1) {
+  PROFILE_TALLY ("glue tree-compound?");
   TMSCM_ASSERT_TREE (arg1, TMSCM_ARG1, "tree-compound?");
 
   tree in1= tmscm_to_tree (arg1);
@@ -1992,6 +2313,7 @@ tmg_tree_compoundP (tmscm arg1) {
 
 tmscm
 tmg_tree_label (tmscm arg1) {
+  PROFILE_TALLY ("glue tree-label");
   TMSCM_ASSERT_TREE (arg1, TMSCM_ARG1, "tree-label");
 
   tree in1= tmscm_to_tree (arg1);
@@ -2005,6 +2327,7 @@ tmg_tree_label (tmscm arg1) {
 
 tmscm
 tmg_tree_children (tmscm arg1) {
+  PROFILE_TALLY ("glue tree-children");
   TMSCM_ASSERT_TREE (arg1, TMSCM_ARG1, "tree-children");
 
   tree in1= tmscm_to_tree (arg1);
@@ -2018,6 +2341,7 @@ tmg_tree_children (tmscm arg1) {
 
 tmscm
 tmg_tree_arity (tmscm arg1) {
+  PROFILE_TALLY ("glue tree-arity");
   TMSCM_ASSERT_TREE (arg1, TMSCM_ARG1, "tree-arity");
 
   tree in1= tmscm_to_tree (arg1);
@@ -2031,6 +2355,7 @@ tmg_tree_arity (tmscm arg1) {
 
 tmscm
 tmg_tree_child_ref (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue tree-child-ref");
   TMSCM_ASSERT_TREE (arg1, TMSCM_ARG1, "tree-child-ref");
   TMSCM_ASSERT_INT (arg2, TMSCM_ARG2, "tree-child-ref");
 
@@ -2046,6 +2371,7 @@ tmg_tree_child_ref (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_tree_child_setS (tmscm arg1, tmscm arg2, tmscm arg3) {
+  PROFILE_TALLY ("glue tree-child-set!");
   TMSCM_ASSERT_TREE (arg1, TMSCM_ARG1, "tree-child-set!");
   TMSCM_ASSERT_INT (arg2, TMSCM_ARG2, "tree-child-set!");
   TMSCM_ASSERT_CONTENT (arg3, TMSCM_ARG3, "tree-child-set!");
@@ -2063,6 +2389,7 @@ tmg_tree_child_setS (tmscm arg1, tmscm arg2, tmscm arg3) {
 
 tmscm
 tmg_tree_child_insert (tmscm arg1, tmscm arg2, tmscm arg3) {
+  PROFILE_TALLY ("glue tree-child-insert");
   TMSCM_ASSERT_CONTENT (arg1, TMSCM_ARG1, "tree-child-insert");
   TMSCM_ASSERT_INT (arg2, TMSCM_ARG2, "tree-child-insert");
   TMSCM_ASSERT_CONTENT (arg3, TMSCM_ARG3, "tree-child-insert");
@@ -2080,6 +2407,7 @@ tmg_tree_child_insert (tmscm arg1, tmscm arg2, tmscm arg3) {
 
 tmscm
 tmg_tree_ip (tmscm arg1) {
+  PROFILE_TALLY ("glue tree-ip");
   TMSCM_ASSERT_TREE (arg1, TMSCM_ARG1, "tree-ip");
 
   tree in1= tmscm_to_tree (arg1);
@@ -2093,6 +2421,7 @@ tmg_tree_ip (tmscm arg1) {
 
 tmscm
 tmg_tree_activeP (tmscm arg1) {
+  PROFILE_TALLY ("glue tree-active?");
   TMSCM_ASSERT_TREE (arg1, TMSCM_ARG1, "tree-active?");
 
   tree in1= tmscm_to_tree (arg1);
@@ -2106,6 +2435,7 @@ tmg_tree_activeP (tmscm arg1) {
 
 tmscm
 tmg_tree_eqP (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue tree-eq?");
   TMSCM_ASSERT_TREE (arg1, TMSCM_ARG1, "tree-eq?");
   TMSCM_ASSERT_TREE (arg2, TMSCM_ARG2, "tree-eq?");
 
@@ -2121,6 +2451,7 @@ tmg_tree_eqP (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_subtree (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue subtree");
   TMSCM_ASSERT_TREE (arg1, TMSCM_ARG1, "subtree");
   TMSCM_ASSERT_PATH (arg2, TMSCM_ARG2, "subtree");
 
@@ -2136,6 +2467,7 @@ tmg_subtree (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_tree_range (tmscm arg1, tmscm arg2, tmscm arg3) {
+  PROFILE_TALLY ("glue tree-range");
   TMSCM_ASSERT_TREE (arg1, TMSCM_ARG1, "tree-range");
   TMSCM_ASSERT_INT (arg2, TMSCM_ARG2, "tree-range");
   TMSCM_ASSERT_INT (arg3, TMSCM_ARG3, "tree-range");
@@ -2153,6 +2485,7 @@ tmg_tree_range (tmscm arg1, tmscm arg2, tmscm arg3) {
 
 tmscm
 tmg_tree_copy (tmscm arg1) {
+  PROFILE_TALLY ("glue tree-copy");
   TMSCM_ASSERT_TREE (arg1, TMSCM_ARG1, "tree-copy");
 
   tree in1= tmscm_to_tree (arg1);
@@ -2166,6 +2499,7 @@ tmg_tree_copy (tmscm arg1) {
 
 tmscm
 tmg_tree_append (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue tree-append");
   TMSCM_ASSERT_TREE (arg1, TMSCM_ARG1, "tree-append");
   TMSCM_ASSERT_TREE (arg2, TMSCM_ARG2, "tree-append");
 
@@ -2181,6 +2515,7 @@ tmg_tree_append (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_tree_right_index (tmscm arg1) {
+  PROFILE_TALLY ("glue tree-right-index");
   TMSCM_ASSERT_TREE (arg1, TMSCM_ARG1, "tree-right-index");
 
   tree in1= tmscm_to_tree (arg1);
@@ -2194,6 +2529,7 @@ tmg_tree_right_index (tmscm arg1) {
 
 tmscm
 tmg_tree_label_extensionP (tmscm arg1) {
+  PROFILE_TALLY ("glue tree-label-extension?");
   TMSCM_ASSERT_TREE_LABEL (arg1, TMSCM_ARG1, "tree-label-extension?");
 
   tree_label in1= tmscm_to_tree_label (arg1);
@@ -2207,6 +2543,7 @@ tmg_tree_label_extensionP (tmscm arg1) {
 
 tmscm
 tmg_tree_label_macroP (tmscm arg1) {
+  PROFILE_TALLY ("glue tree-label-macro?");
   TMSCM_ASSERT_TREE_LABEL (arg1, TMSCM_ARG1, "tree-label-macro?");
 
   tree_label in1= tmscm_to_tree_label (arg1);
@@ -2220,6 +2557,7 @@ tmg_tree_label_macroP (tmscm arg1) {
 
 tmscm
 tmg_tree_label_parameterP (tmscm arg1) {
+  PROFILE_TALLY ("glue tree-label-parameter?");
   TMSCM_ASSERT_TREE_LABEL (arg1, TMSCM_ARG1, "tree-label-parameter?");
 
   tree_label in1= tmscm_to_tree_label (arg1);
@@ -2233,6 +2571,7 @@ tmg_tree_label_parameterP (tmscm arg1) {
 
 tmscm
 tmg_tree_label_type (tmscm arg1) {
+  PROFILE_TALLY ("glue tree-label-type");
   TMSCM_ASSERT_TREE_LABEL (arg1, TMSCM_ARG1, "tree-label-type");
 
   tree_label in1= tmscm_to_tree_label (arg1);
@@ -2246,6 +2585,7 @@ tmg_tree_label_type (tmscm arg1) {
 
 tmscm
 tmg_tree_multi_paragraphP (tmscm arg1) {
+  PROFILE_TALLY ("glue tree-multi-paragraph?");
   TMSCM_ASSERT_TREE (arg1, TMSCM_ARG1, "tree-multi-paragraph?");
 
   tree in1= tmscm_to_tree (arg1);
@@ -2259,6 +2599,7 @@ tmg_tree_multi_paragraphP (tmscm arg1) {
 
 tmscm
 tmg_tree_simplify (tmscm arg1) {
+  PROFILE_TALLY ("glue tree-simplify");
   TMSCM_ASSERT_TREE (arg1, TMSCM_ARG1, "tree-simplify");
 
   tree in1= tmscm_to_tree (arg1);
@@ -2272,6 +2613,7 @@ tmg_tree_simplify (tmscm arg1) {
 
 tmscm
 tmg_tree_minimal_arity (tmscm arg1) {
+  PROFILE_TALLY ("glue tree-minimal-arity");
   TMSCM_ASSERT_TREE (arg1, TMSCM_ARG1, "tree-minimal-arity");
 
   tree in1= tmscm_to_tree (arg1);
@@ -2285,6 +2627,7 @@ tmg_tree_minimal_arity (tmscm arg1) {
 
 tmscm
 tmg_tree_maximal_arity (tmscm arg1) {
+  PROFILE_TALLY ("glue tree-maximal-arity");
   TMSCM_ASSERT_TREE (arg1, TMSCM_ARG1, "tree-maximal-arity");
 
   tree in1= tmscm_to_tree (arg1);
@@ -2298,6 +2641,7 @@ tmg_tree_maximal_arity (tmscm arg1) {
 
 tmscm
 tmg_tree_possible_arityP (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue tree-possible-arity?");
   TMSCM_ASSERT_TREE (arg1, TMSCM_ARG1, "tree-possible-arity?");
   TMSCM_ASSERT_INT (arg2, TMSCM_ARG2, "tree-possible-arity?");
 
@@ -2313,6 +2657,7 @@ tmg_tree_possible_arityP (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_tree_insert_point (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue tree-insert_point");
   TMSCM_ASSERT_TREE (arg1, TMSCM_ARG1, "tree-insert_point");
   TMSCM_ASSERT_INT (arg2, TMSCM_ARG2, "tree-insert_point");
 
@@ -2328,6 +2673,7 @@ tmg_tree_insert_point (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_tree_is_dynamicP (tmscm arg1) {
+  PROFILE_TALLY ("glue tree-is-dynamic?");
   TMSCM_ASSERT_TREE (arg1, TMSCM_ARG1, "tree-is-dynamic?");
 
   tree in1= tmscm_to_tree (arg1);
@@ -2341,6 +2687,7 @@ tmg_tree_is_dynamicP (tmscm arg1) {
 
 tmscm
 tmg_tree_accessible_childP (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue tree-accessible-child?");
   TMSCM_ASSERT_TREE (arg1, TMSCM_ARG1, "tree-accessible-child?");
   TMSCM_ASSERT_INT (arg2, TMSCM_ARG2, "tree-accessible-child?");
 
@@ -2356,6 +2703,7 @@ tmg_tree_accessible_childP (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_tree_accessible_children (tmscm arg1) {
+  PROFILE_TALLY ("glue tree-accessible-children");
   TMSCM_ASSERT_TREE (arg1, TMSCM_ARG1, "tree-accessible-children");
 
   tree in1= tmscm_to_tree (arg1);
@@ -2369,6 +2717,7 @@ tmg_tree_accessible_children (tmscm arg1) {
 
 tmscm
 tmg_tree_all_accessibleP (tmscm arg1) {
+  PROFILE_TALLY ("glue tree-all-accessible?");
   TMSCM_ASSERT_CONTENT (arg1, TMSCM_ARG1, "tree-all-accessible?");
 
   content in1= tmscm_to_content (arg1);
@@ -2382,6 +2731,7 @@ tmg_tree_all_accessibleP (tmscm arg1) {
 
 tmscm
 tmg_tree_none_accessibleP (tmscm arg1) {
+  PROFILE_TALLY ("glue tree-none-accessible?");
   TMSCM_ASSERT_CONTENT (arg1, TMSCM_ARG1, "tree-none-accessible?");
 
   content in1= tmscm_to_content (arg1);
@@ -2395,6 +2745,7 @@ tmg_tree_none_accessibleP (tmscm arg1) {
 
 tmscm
 tmg_tree_name (tmscm arg1) {
+  PROFILE_TALLY ("glue tree-name");
   TMSCM_ASSERT_CONTENT (arg1, TMSCM_ARG1, "tree-name");
 
   content in1= tmscm_to_content (arg1);
@@ -2408,6 +2759,7 @@ tmg_tree_name (tmscm arg1) {
 
 tmscm
 tmg_tree_long_name (tmscm arg1) {
+  PROFILE_TALLY ("glue tree-long-name");
   TMSCM_ASSERT_CONTENT (arg1, TMSCM_ARG1, "tree-long-name");
 
   content in1= tmscm_to_content (arg1);
@@ -2421,6 +2773,7 @@ tmg_tree_long_name (tmscm arg1) {
 
 tmscm
 tmg_tree_child_name (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue tree-child-name");
   TMSCM_ASSERT_CONTENT (arg1, TMSCM_ARG1, "tree-child-name");
   TMSCM_ASSERT_INT (arg2, TMSCM_ARG2, "tree-child-name");
 
@@ -2436,6 +2789,7 @@ tmg_tree_child_name (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_tree_child_long_name (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue tree-child-long-name");
   TMSCM_ASSERT_CONTENT (arg1, TMSCM_ARG1, "tree-child-long-name");
   TMSCM_ASSERT_INT (arg2, TMSCM_ARG2, "tree-child-long-name");
 
@@ -2451,6 +2805,7 @@ tmg_tree_child_long_name (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_tree_child_type (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue tree-child-type");
   TMSCM_ASSERT_CONTENT (arg1, TMSCM_ARG1, "tree-child-type");
   TMSCM_ASSERT_INT (arg2, TMSCM_ARG2, "tree-child-type");
 
@@ -2466,6 +2821,7 @@ tmg_tree_child_type (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_tree_child_env_dot (tmscm arg1, tmscm arg2, tmscm arg3) {
+  PROFILE_TALLY ("glue tree-child-env*");
   TMSCM_ASSERT_CONTENT (arg1, TMSCM_ARG1, "tree-child-env*");
   TMSCM_ASSERT_INT (arg2, TMSCM_ARG2, "tree-child-env*");
   TMSCM_ASSERT_CONTENT (arg3, TMSCM_ARG3, "tree-child-env*");
@@ -2483,6 +2839,7 @@ tmg_tree_child_env_dot (tmscm arg1, tmscm arg2, tmscm arg3) {
 
 tmscm
 tmg_tree_child_env (tmscm arg1, tmscm arg2, tmscm arg3, tmscm arg4) {
+  PROFILE_TALLY ("glue tree-child-env");
   TMSCM_ASSERT_CONTENT (arg1, TMSCM_ARG1, "tree-child-env");
   TMSCM_ASSERT_INT (arg2, TMSCM_ARG2, "tree-child-env");
   TMSCM_ASSERT_STRING (arg3, TMSCM_ARG3, "tree-child-env");
@@ -2502,6 +2859,7 @@ tmg_tree_child_env (tmscm arg1, tmscm arg2, tmscm arg3, tmscm arg4) {
 
 tmscm
 tmg_tree_descendant_env_dot (tmscm arg1, tmscm arg2, tmscm arg3) {
+  PROFILE_TALLY ("glue tree-descendant-env*");
   TMSCM_ASSERT_CONTENT (arg1, TMSCM_ARG1, "tree-descendant-env*");
   TMSCM_ASSERT_PATH (arg2, TMSCM_ARG2, "tree-descendant-env*");
   TMSCM_ASSERT_CONTENT (arg3, TMSCM_ARG3, "tree-descendant-env*");
@@ -2519,6 +2877,7 @@ tmg_tree_descendant_env_dot (tmscm arg1, tmscm arg2, tmscm arg3) {
 
 tmscm
 tmg_tree_descendant_env (tmscm arg1, tmscm arg2, tmscm arg3, tmscm arg4) {
+  PROFILE_TALLY ("glue tree-descendant-env");
   TMSCM_ASSERT_CONTENT (arg1, TMSCM_ARG1, "tree-descendant-env");
   TMSCM_ASSERT_PATH (arg2, TMSCM_ARG2, "tree-descendant-env");
   TMSCM_ASSERT_STRING (arg3, TMSCM_ARG3, "tree-descendant-env");
@@ -2538,6 +2897,7 @@ tmg_tree_descendant_env (tmscm arg1, tmscm arg2, tmscm arg3, tmscm arg4) {
 
 tmscm
 tmg_tree_load_inclusion (tmscm arg1) {
+  PROFILE_TALLY ("glue tree-load-inclusion");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "tree-load-inclusion");
 
   url in1= tmscm_to_url (arg1);
@@ -2551,6 +2911,7 @@ tmg_tree_load_inclusion (tmscm arg1) {
 
 tmscm
 tmg_tree_as_string (tmscm arg1) {
+  PROFILE_TALLY ("glue tree-as-string");
   TMSCM_ASSERT_CONTENT (arg1, TMSCM_ARG1, "tree-as-string");
 
   content in1= tmscm_to_content (arg1);
@@ -2564,6 +2925,7 @@ tmg_tree_as_string (tmscm arg1) {
 
 tmscm
 tmg_tree_extents (tmscm arg1) {
+  PROFILE_TALLY ("glue tree-extents");
   TMSCM_ASSERT_CONTENT (arg1, TMSCM_ARG1, "tree-extents");
 
   content in1= tmscm_to_content (arg1);
@@ -2577,6 +2939,7 @@ tmg_tree_extents (tmscm arg1) {
 
 tmscm
 tmg_tree_emptyP (tmscm arg1) {
+  PROFILE_TALLY ("glue tree-empty?");
   TMSCM_ASSERT_CONTENT (arg1, TMSCM_ARG1, "tree-empty?");
 
   content in1= tmscm_to_content (arg1);
@@ -2590,6 +2953,7 @@ tmg_tree_emptyP (tmscm arg1) {
 
 tmscm
 tmg_tree_multi_lineP (tmscm arg1) {
+  PROFILE_TALLY ("glue tree-multi-line?");
   TMSCM_ASSERT_CONTENT (arg1, TMSCM_ARG1, "tree-multi-line?");
 
   content in1= tmscm_to_content (arg1);
@@ -2603,6 +2967,7 @@ tmg_tree_multi_lineP (tmscm arg1) {
 
 tmscm
 tmg_tree_is_bufferP (tmscm arg1) {
+  PROFILE_TALLY ("glue tree-is-buffer?");
   TMSCM_ASSERT_TREE (arg1, TMSCM_ARG1, "tree-is-buffer?");
 
   tree in1= tmscm_to_tree (arg1);
@@ -2616,6 +2981,7 @@ tmg_tree_is_bufferP (tmscm arg1) {
 
 tmscm
 tmg_tree_search_sections (tmscm arg1) {
+  PROFILE_TALLY ("glue tree-search-sections");
   TMSCM_ASSERT_TREE (arg1, TMSCM_ARG1, "tree-search-sections");
 
   tree in1= tmscm_to_tree (arg1);
@@ -2629,6 +2995,7 @@ tmg_tree_search_sections (tmscm arg1) {
 
 tmscm
 tmg_tree_search_tree (tmscm arg1, tmscm arg2, tmscm arg3, tmscm arg4) {
+  PROFILE_TALLY ("glue tree-search-tree");
   TMSCM_ASSERT_CONTENT (arg1, TMSCM_ARG1, "tree-search-tree");
   TMSCM_ASSERT_CONTENT (arg2, TMSCM_ARG2, "tree-search-tree");
   TMSCM_ASSERT_PATH (arg3, TMSCM_ARG3, "tree-search-tree");
@@ -2648,6 +3015,7 @@ tmg_tree_search_tree (tmscm arg1, tmscm arg2, tmscm arg3, tmscm arg4) {
 
 tmscm
 tmg_tree_search_tree_at (tmscm arg1, tmscm arg2, tmscm arg3, tmscm arg4, tmscm arg5) {
+  PROFILE_TALLY ("glue tree-search-tree-at");
   TMSCM_ASSERT_CONTENT (arg1, TMSCM_ARG1, "tree-search-tree-at");
   TMSCM_ASSERT_CONTENT (arg2, TMSCM_ARG2, "tree-search-tree-at");
   TMSCM_ASSERT_PATH (arg3, TMSCM_ARG3, "tree-search-tree-at");
@@ -2669,6 +3037,7 @@ tmg_tree_search_tree_at (tmscm arg1, tmscm arg2, tmscm arg3, tmscm arg4, tmscm a
 
 tmscm
 tmg_tree_spell (tmscm arg1, tmscm arg2, tmscm arg3, tmscm arg4) {
+  PROFILE_TALLY ("glue tree-spell");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "tree-spell");
   TMSCM_ASSERT_CONTENT (arg2, TMSCM_ARG2, "tree-spell");
   TMSCM_ASSERT_PATH (arg3, TMSCM_ARG3, "tree-spell");
@@ -2688,6 +3057,7 @@ tmg_tree_spell (tmscm arg1, tmscm arg2, tmscm arg3, tmscm arg4) {
 
 tmscm
 tmg_tree_spell_at (tmscm arg1, tmscm arg2, tmscm arg3, tmscm arg4, tmscm arg5) {
+  PROFILE_TALLY ("glue tree-spell-at");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "tree-spell-at");
   TMSCM_ASSERT_CONTENT (arg2, TMSCM_ARG2, "tree-spell-at");
   TMSCM_ASSERT_PATH (arg3, TMSCM_ARG3, "tree-spell-at");
@@ -2709,6 +3079,7 @@ tmg_tree_spell_at (tmscm arg1, tmscm arg2, tmscm arg3, tmscm arg4, tmscm arg5) {
 
 tmscm
 tmg_tree_spell_selection (tmscm arg1, tmscm arg2, tmscm arg3, tmscm arg4, tmscm arg5, tmscm arg6) {
+  PROFILE_TALLY ("glue tree-spell-selection");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "tree-spell-selection");
   TMSCM_ASSERT_CONTENT (arg2, TMSCM_ARG2, "tree-spell-selection");
   TMSCM_ASSERT_PATH (arg3, TMSCM_ARG3, "tree-spell-selection");
@@ -2732,6 +3103,7 @@ tmg_tree_spell_selection (tmscm arg1, tmscm arg2, tmscm arg3, tmscm arg4, tmscm
 
 tmscm
 tmg_previous_search_hit (tmscm arg1, tmscm arg2, tmscm arg3) {
+  PROFILE_TALLY ("glue previous-search-hit");
   TMSCM_ASSERT_ARRAY_PATH (arg1, TMSCM_ARG1, "previous-search-hit");
   TMSCM_ASSERT_PATH (arg2, TMSCM_ARG2, "previous-search-hit");
   TMSCM_ASSERT_BOOL (arg3, TMSCM_ARG3, "previous-search-hit");
@@ -2749,6 +3121,7 @@ tmg_previous_search_hit (tmscm arg1, tmscm arg2, tmscm arg3) {
 
 tmscm
 tmg_next_search_hit (tmscm arg1, tmscm arg2, tmscm arg3) {
+  PROFILE_TALLY ("glue next-search-hit");
   TMSCM_ASSERT_ARRAY_PATH (arg1, TMSCM_ARG1, "next-search-hit");
   TMSCM_ASSERT_PATH (arg2, TMSCM_ARG2, "next-search-hit");
   TMSCM_ASSERT_BOOL (arg3, TMSCM_ARG3, "next-search-hit");
@@ -2766,6 +3139,7 @@ tmg_next_search_hit (tmscm arg1, tmscm arg2, tmscm arg3) {
 
 tmscm
 tmg_navigate_search_hit (tmscm arg1, tmscm arg2, tmscm arg3, tmscm arg4) {
+  PROFILE_TALLY ("glue navigate-search-hit");
   TMSCM_ASSERT_PATH (arg1, TMSCM_ARG1, "navigate-search-hit");
   TMSCM_ASSERT_BOOL (arg2, TMSCM_ARG2, "navigate-search-hit");
   TMSCM_ASSERT_BOOL (arg3, TMSCM_ARG3, "navigate-search-hit");
@@ -2785,6 +3159,7 @@ tmg_navigate_search_hit (tmscm arg1, tmscm arg2, tmscm arg3, tmscm arg4) {
 
 tmscm
 tmg_tag_minimal_arity (tmscm arg1) {
+  PROFILE_TALLY ("glue tag-minimal-arity");
   TMSCM_ASSERT_TREE_LABEL (arg1, TMSCM_ARG1, "tag-minimal-arity");
 
   tree_label in1= tmscm_to_tree_label (arg1);
@@ -2798,6 +3173,7 @@ tmg_tag_minimal_arity (tmscm arg1) {
 
 tmscm
 tmg_tag_maximal_arity (tmscm arg1) {
+  PROFILE_TALLY ("glue tag-maximal-arity");
   TMSCM_ASSERT_TREE_LABEL (arg1, TMSCM_ARG1, "tag-maximal-arity");
 
   tree_label in1= tmscm_to_tree_label (arg1);
@@ -2811,6 +3187,7 @@ tmg_tag_maximal_arity (tmscm arg1) {
 
 tmscm
 tmg_tag_possible_arityP (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue tag-possible-arity?");
   TMSCM_ASSERT_TREE_LABEL (arg1, TMSCM_ARG1, "tag-possible-arity?");
   TMSCM_ASSERT_INT (arg2, TMSCM_ARG2, "tag-possible-arity?");
 
@@ -2826,6 +3203,7 @@ tmg_tag_possible_arityP (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_set_access_mode (tmscm arg1) {
+  PROFILE_TALLY ("glue set-access-mode");
   TMSCM_ASSERT_INT (arg1, TMSCM_ARG1, "set-access-mode");
 
   int in1= tmscm_to_int (arg1);
@@ -2839,6 +3217,7 @@ tmg_set_access_mode (tmscm arg1) {
 
 tmscm
 tmg_get_access_mode () {
+  PROFILE_TALLY ("glue get-access-mode");
   // TMSCM_DEFER_INTS;
   int out= get_access_mode ();
   // TMSCM_ALLOW_INTS;
@@ -2848,6 +3227,7 @@ tmg_get_access_mode () {
 
 tmscm
 tmg_tree_assign (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue tree-assign");
   TMSCM_ASSERT_TREE (arg1, TMSCM_ARG1, "tree-assign");
   TMSCM_ASSERT_CONTENT (arg2, TMSCM_ARG2, "tree-assign");
 
@@ -2863,6 +3243,7 @@ tmg_tree_assign (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_tree_var_insert (tmscm arg1, tmscm arg2, tmscm arg3) {
+  PROFILE_TALLY ("glue tree-var-insert");
   TMSCM_ASSERT_TREE (arg1, TMSCM_ARG1, "tree-var-insert");
   TMSCM_ASSERT_INT (arg2, TMSCM_ARG2, "tree-var-insert");
   TMSCM_ASSERT_CONTENT (arg3, TMSCM_ARG3, "tree-var-insert");
@@ -2880,6 +3261,7 @@ tmg_tree_var_insert (tmscm arg1, tmscm arg2, tmscm arg3) {
 
 tmscm
 tmg_tree_remove (tmscm arg1, tmscm arg2, tmscm arg3) {
+  PROFILE_TALLY ("glue tree-remove");
   TMSCM_ASSERT_TREE (arg1, TMSCM_ARG1, "tree-remove");
   TMSCM_ASSERT_INT (arg2, TMSCM_ARG2, "tree-remove");
   TMSCM_ASSERT_INT (arg3, TMSCM_ARG3, "tree-remove");
@@ -2897,6 +3279,7 @@ tmg_tree_remove (tmscm arg1, tmscm arg2, tmscm arg3) {
 
 tmscm
 tmg_tree_split (tmscm arg1, tmscm arg2, tmscm arg3) {
+  PROFILE_TALLY ("glue tree-split");
   TMSCM_ASSERT_TREE (arg1, TMSCM_ARG1, "tree-split");
   TMSCM_ASSERT_INT (arg2, TMSCM_ARG2, "tree-split");
   TMSCM_ASSERT_INT (arg3, TMSCM_ARG3, "tree-split");
@@ -2914,6 +3297,7 @@ tmg_tree_split (tmscm arg1, tmscm arg2, tmscm arg3) {
 
 tmscm
 tmg_tree_join (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue tree-join");
   TMSCM_ASSERT_TREE (arg1, TMSCM_ARG1, "tree-join");
   TMSCM_ASSERT_INT (arg2, TMSCM_ARG2, "tree-join");
 
@@ -2929,6 +3313,7 @@ tmg_tree_join (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_tree_assign_node (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue tree-assign-node");
   TMSCM_ASSERT_TREE (arg1, TMSCM_ARG1, "tree-assign-node");
   TMSCM_ASSERT_TREE_LABEL (arg2, TMSCM_ARG2, "tree-assign-node");
 
@@ -2944,6 +3329,7 @@ tmg_tree_assign_node (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_tree_insert_node (tmscm arg1, tmscm arg2, tmscm arg3) {
+  PROFILE_TALLY ("glue tree-insert-node");
   TMSCM_ASSERT_TREE (arg1, TMSCM_ARG1, "tree-insert-node");
   TMSCM_ASSERT_INT (arg2, TMSCM_ARG2, "tree-insert-node");
   TMSCM_ASSERT_CONTENT (arg3, TMSCM_ARG3, "tree-insert-node");
@@ -2961,6 +3347,7 @@ tmg_tree_insert_node (tmscm arg1, tmscm arg2, tmscm arg3) {
 
 tmscm
 tmg_tree_remove_node (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue tree-remove-node");
   TMSCM_ASSERT_TREE (arg1, TMSCM_ARG1, "tree-remove-node");
   TMSCM_ASSERT_INT (arg2, TMSCM_ARG2, "tree-remove-node");
 
@@ -2976,6 +3363,7 @@ tmg_tree_remove_node (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_cpp_tree_correct_node (tmscm arg1) {
+  PROFILE_TALLY ("glue cpp-tree-correct-node");
   TMSCM_ASSERT_TREE (arg1, TMSCM_ARG1, "cpp-tree-correct-node");
 
   tree in1= tmscm_to_tree (arg1);
@@ -2989,6 +3377,7 @@ tmg_cpp_tree_correct_node (tmscm arg1) {
 
 tmscm
 tmg_cpp_tree_correct_downwards (tmscm arg1) {
+  PROFILE_TALLY ("glue cpp-tree-correct-downwards");
   TMSCM_ASSERT_TREE (arg1, TMSCM_ARG1, "cpp-tree-correct-downwards");
 
   tree in1= tmscm_to_tree (arg1);
@@ -3002,6 +3391,7 @@ tmg_cpp_tree_correct_downwards (tmscm arg1) {
 
 tmscm
 tmg_cpp_tree_correct_upwards (tmscm arg1) {
+  PROFILE_TALLY ("glue cpp-tree-correct-upwards");
   TMSCM_ASSERT_TREE (arg1, TMSCM_ARG1, "cpp-tree-correct-upwards");
 
   tree in1= tmscm_to_tree (arg1);
@@ -3015,6 +3405,7 @@ tmg_cpp_tree_correct_upwards (tmscm arg1) {
 
 tmscm
 tmg_concat_tokenize_math (tmscm arg1) {
+  PROFILE_TALLY ("glue concat-tokenize-math");
   TMSCM_ASSERT_CONTENT (arg1, TMSCM_ARG1, "concat-tokenize-math");
 
   content in1= tmscm_to_content (arg1);
@@ -3028,6 +3419,7 @@ tmg_concat_tokenize_math (tmscm arg1) {
 
 tmscm
 tmg_concat_decompose (tmscm arg1) {
+  PROFILE_TALLY ("glue concat-decompose");
   TMSCM_ASSERT_CONTENT (arg1, TMSCM_ARG1, "concat-decompose");
 
   content in1= tmscm_to_content (arg1);
@@ -3041,6 +3433,7 @@ tmg_concat_decompose (tmscm arg1) {
 
 tmscm
 tmg_concat_recompose (tmscm arg1) {
+  PROFILE_TALLY ("glue concat-recompose");
   TMSCM_ASSERT_ARRAY_TREE (arg1, TMSCM_ARG1, "concat-recompose");
 
   array_tree in1= tmscm_to_array_tree (arg1);
@@ -3054,6 +3447,7 @@ tmg_concat_recompose (tmscm arg1) {
 
 tmscm
 tmg_with_likeP (tmscm arg1) {
+  PROFILE_TALLY ("glue with-like?");
   TMSCM_ASSERT_CONTENT (arg1, TMSCM_ARG1, "with-like?");
 
   content in1= tmscm_to_content (arg1);
@@ -3067,6 +3461,7 @@ tmg_with_likeP (tmscm arg1) {
 
 tmscm
 tmg_with_same_typeP (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue with-same-type?");
   TMSCM_ASSERT_CONTENT (arg1, TMSCM_ARG1, "with-same-type?");
   TMSCM_ASSERT_CONTENT (arg2, TMSCM_ARG2, "with-same-type?");
 
@@ -3082,6 +3477,7 @@ tmg_with_same_typeP (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_with_similar_typeP (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue with-similar-type?");
   TMSCM_ASSERT_CONTENT (arg1, TMSCM_ARG1, "with-similar-type?");
   TMSCM_ASSERT_CONTENT (arg2, TMSCM_ARG2, "with-similar-type?");
 
@@ -3097,6 +3493,7 @@ tmg_with_similar_typeP (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_with_correct (tmscm arg1) {
+  PROFILE_TALLY ("glue with-correct");
   TMSCM_ASSERT_CONTENT (arg1, TMSCM_ARG1, "with-correct");
 
   content in1= tmscm_to_content (arg1);
@@ -3110,6 +3507,7 @@ tmg_with_correct (tmscm arg1) {
 
 tmscm
 tmg_with_correct_superfluous (tmscm arg1) {
+  PROFILE_TALLY ("glue with-correct-superfluous");
   TMSCM_ASSERT_CONTENT (arg1, TMSCM_ARG1, "with-correct-superfluous");
 
   content in1= tmscm_to_content (arg1);
@@ -3123,6 +3521,7 @@ tmg_with_correct_superfluous (tmscm arg1) {
 
 tmscm
 tmg_invisible_correct_superfluous (tmscm arg1) {
+  PROFILE_TALLY ("glue invisible-correct-superfluous");
   TMSCM_ASSERT_CONTENT (arg1, TMSCM_ARG1, "invisible-correct-superfluous");
 
   content in1= tmscm_to_content (arg1);
@@ -3136,6 +3535,7 @@ tmg_invisible_correct_superfluous (tmscm arg1) {
 
 tmscm
 tmg_invisible_correct_missing (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue invisible-correct-missing");
   TMSCM_ASSERT_CONTENT (arg1, TMSCM_ARG1, "invisible-correct-missing");
   TMSCM_ASSERT_INT (arg2, TMSCM_ARG2, "invisible-correct-missing");
 
@@ -3151,6 +3551,7 @@ tmg_invisible_correct_missing (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_automatic_correct (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue automatic-correct");
   TMSCM_ASSERT_CONTENT (arg1, TMSCM_ARG1, "automatic-correct");
   TMSCM_ASSERT_STRING (arg2, TMSCM_ARG2, "automatic-correct");
 
@@ -3166,6 +3567,7 @@ tmg_automatic_correct (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_manual_correct (tmscm arg1) {
+  PROFILE_TALLY ("glue manual-correct");
   TMSCM_ASSERT_CONTENT (arg1, TMSCM_ARG1, "manual-correct");
 
   content in1= tmscm_to_content (arg1);
@@ -3179,6 +3581,7 @@ tmg_manual_correct (tmscm arg1) {
 
 tmscm
 tmg_tree_upgrade_brackets (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue tree-upgrade-brackets");
   TMSCM_ASSERT_CONTENT (arg1, TMSCM_ARG1, "tree-upgrade-brackets");
   TMSCM_ASSERT_STRING (arg2, TMSCM_ARG2, "tree-upgrade-brackets");
 
@@ -3194,6 +3597,7 @@ tmg_tree_upgrade_brackets (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_tree_upgrade_big (tmscm arg1) {
+  PROFILE_TALLY ("glue tree-upgrade-big");
   TMSCM_ASSERT_CONTENT (arg1, TMSCM_ARG1, "tree-upgrade-big");
 
   content in1= tmscm_to_content (arg1);
@@ -3207,6 +3611,7 @@ tmg_tree_upgrade_big (tmscm arg1) {
 
 tmscm
 tmg_tree_downgrade_brackets (tmscm arg1, tmscm arg2, tmscm arg3) {
+  PROFILE_TALLY ("glue tree-downgrade-brackets");
   TMSCM_ASSERT_CONTENT (arg1, TMSCM_ARG1, "tree-downgrade-brackets");
   TMSCM_ASSERT_BOOL (arg2, TMSCM_ARG2, "tree-downgrade-brackets");
   TMSCM_ASSERT_BOOL (arg3, TMSCM_ARG3, "tree-downgrade-brackets");
@@ -3224,6 +3629,7 @@ tmg_tree_downgrade_brackets (tmscm arg1, tmscm arg2, tmscm arg3) {
 
 tmscm
 tmg_tree_downgrade_big (tmscm arg1) {
+  PROFILE_TALLY ("glue tree-downgrade-big");
   TMSCM_ASSERT_CONTENT (arg1, TMSCM_ARG1, "tree-downgrade-big");
 
   content in1= tmscm_to_content (arg1);
@@ -3237,6 +3643,7 @@ tmg_tree_downgrade_big (tmscm arg1) {
 
 tmscm
 tmg_math_status_print () {
+  PROFILE_TALLY ("glue math-status-print");
   // TMSCM_DEFER_INTS;
   math_status_print ();
   // TMSCM_ALLOW_INTS;
@@ -3246,6 +3653,7 @@ tmg_math_status_print () {
 
 tmscm
 tmg_math_status_reset () {
+  PROFILE_TALLY ("glue math-status-reset");
   // TMSCM_DEFER_INTS;
   math_status_reset ();
   // TMSCM_ALLOW_INTS;
@@ -3255,6 +3663,7 @@ tmg_math_status_reset () {
 
 tmscm
 tmg_path_strip (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue path-strip");
   TMSCM_ASSERT_PATH (arg1, TMSCM_ARG1, "path-strip");
   TMSCM_ASSERT_PATH (arg2, TMSCM_ARG2, "path-strip");
 
@@ -3270,6 +3679,7 @@ tmg_path_strip (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_path_infP (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue path-inf?");
   TMSCM_ASSERT_PATH (arg1, TMSCM_ARG1, "path-inf?");
   TMSCM_ASSERT_PATH (arg2, TMSCM_ARG2, "path-inf?");
 
@@ -3285,6 +3695,7 @@ tmg_path_infP (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_path_inf_eqP (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue path-inf-eq?");
   TMSCM_ASSERT_PATH (arg1, TMSCM_ARG1, "path-inf-eq?");
   TMSCM_ASSERT_PATH (arg2, TMSCM_ARG2, "path-inf-eq?");
 
@@ -3300,6 +3711,7 @@ tmg_path_inf_eqP (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_path_lessP (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue path-less?");
   TMSCM_ASSERT_PATH (arg1, TMSCM_ARG1, "path-less?");
   TMSCM_ASSERT_PATH (arg2, TMSCM_ARG2, "path-less?");
 
@@ -3315,6 +3727,7 @@ tmg_path_lessP (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_path_less_eqP (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue path-less-eq?");
   TMSCM_ASSERT_PATH (arg1, TMSCM_ARG1, "path-less-eq?");
   TMSCM_ASSERT_PATH (arg2, TMSCM_ARG2, "path-less-eq?");
 
@@ -3330,6 +3743,7 @@ tmg_path_less_eqP (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_path_start (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue path-start");
   TMSCM_ASSERT_CONTENT (arg1, TMSCM_ARG1, "path-start");
   TMSCM_ASSERT_PATH (arg2, TMSCM_ARG2, "path-start");
 
@@ -3345,6 +3759,7 @@ tmg_path_start (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_path_end (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue path-end");
   TMSCM_ASSERT_CONTENT (arg1, TMSCM_ARG1, "path-end");
   TMSCM_ASSERT_PATH (arg2, TMSCM_ARG2, "path-end");
 
@@ -3360,6 +3775,7 @@ tmg_path_end (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_path_next (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue path-next");
   TMSCM_ASSERT_CONTENT (arg1, TMSCM_ARG1, "path-next");
   TMSCM_ASSERT_PATH (arg2, TMSCM_ARG2, "path-next");
 
@@ -3375,6 +3791,7 @@ tmg_path_next (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_path_previous (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue path-previous");
   TMSCM_ASSERT_CONTENT (arg1, TMSCM_ARG1, "path-previous");
   TMSCM_ASSERT_PATH (arg2, TMSCM_ARG2, "path-previous");
 
@@ -3390,6 +3807,7 @@ tmg_path_previous (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_path_next_word (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue path-next-word");
   TMSCM_ASSERT_CONTENT (arg1, TMSCM_ARG1, "path-next-word");
   TMSCM_ASSERT_PATH (arg2, TMSCM_ARG2, "path-next-word");
 
@@ -3405,6 +3823,7 @@ tmg_path_next_word (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_path_previous_word (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue path-previous-word");
   TMSCM_ASSERT_CONTENT (arg1, TMSCM_ARG1, "path-previous-word");
   TMSCM_ASSERT_PATH (arg2, TMSCM_ARG2, "path-previous-word");
 
@@ -3420,6 +3839,7 @@ tmg_path_previous_word (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_path_next_node (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue path-next-node");
   TMSCM_ASSERT_CONTENT (arg1, TMSCM_ARG1, "path-next-node");
   TMSCM_ASSERT_PATH (arg2, TMSCM_ARG2, "path-next-node");
 
@@ -3435,6 +3855,7 @@ tmg_path_next_node (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_path_previous_node (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue path-previous-node");
   TMSCM_ASSERT_CONTENT (arg1, TMSCM_ARG1, "path-previous-node");
   TMSCM_ASSERT_PATH (arg2, TMSCM_ARG2, "path-previous-node");
 
@@ -3450,6 +3871,7 @@ tmg_path_previous_node (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_path_next_tag (tmscm arg1, tmscm arg2, tmscm arg3) {
+  PROFILE_TALLY ("glue path-next-tag");
   TMSCM_ASSERT_CONTENT (arg1, TMSCM_ARG1, "path-next-tag");
   TMSCM_ASSERT_PATH (arg2, TMSCM_ARG2, "path-next-tag");
   TMSCM_ASSERT_SCHEME_TREE (arg3, TMSCM_ARG3, "path-next-tag");
@@ -3467,6 +3889,7 @@ tmg_path_next_tag (tmscm arg1, tmscm arg2, tmscm arg3) {
 
 tmscm
 tmg_path_previous_tag (tmscm arg1, tmscm arg2, tmscm arg3) {
+  PROFILE_TALLY ("glue path-previous-tag");
   TMSCM_ASSERT_CONTENT (arg1, TMSCM_ARG1, "path-previous-tag");
   TMSCM_ASSERT_PATH (arg2, TMSCM_ARG2, "path-previous-tag");
   TMSCM_ASSERT_SCHEME_TREE (arg3, TMSCM_ARG3, "path-previous-tag");
@@ -3484,6 +3907,7 @@ tmg_path_previous_tag (tmscm arg1, tmscm arg2, tmscm arg3) {
 
 tmscm
 tmg_path_next_tag_same_argument (tmscm arg1, tmscm arg2, tmscm arg3) {
+  PROFILE_TALLY ("glue path-next-tag-same-argument");
   TMSCM_ASSERT_CONTENT (arg1, TMSCM_ARG1, "path-next-tag-same-argument");
   TMSCM_ASSERT_PATH (arg2, TMSCM_ARG2, "path-next-tag-same-argument");
   TMSCM_ASSERT_SCHEME_TREE (arg3, TMSCM_ARG3, "path-next-tag-same-argument");
@@ -3501,6 +3925,7 @@ tmg_path_next_tag_same_argument (tmscm arg1, tmscm arg2, tmscm arg3) {
 
 tmscm
 tmg_path_previous_tag_same_argument (tmscm arg1, tmscm arg2, tmscm arg3) {
+  PROFILE_TALLY ("glue path-previous-tag-same-argument");
   TMSCM_ASSERT_CONTENT (arg1, TMSCM_ARG1, "path-previous-tag-same-argument");
   TMSCM_ASSERT_PATH (arg2, TMSCM_ARG2, "path-previous-tag-same-argument");
   TMSCM_ASSERT_SCHEME_TREE (arg3, TMSCM_ARG3, "path-previous-tag-same-argument");
@@ -3518,6 +3943,7 @@ tmg_path_previous_tag_same_argument (tmscm arg1, tmscm arg2, tmscm arg3) {
 
 tmscm
 tmg_path_next_argument (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue path-next-argument");
   TMSCM_ASSERT_CONTENT (arg1, TMSCM_ARG1, "path-next-argument");
   TMSCM_ASSERT_PATH (arg2, TMSCM_ARG2, "path-next-argument");
 
@@ -3533,6 +3959,7 @@ tmg_path_next_argument (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_path_previous_argument (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue path-previous-argument");
   TMSCM_ASSERT_CONTENT (arg1, TMSCM_ARG1, "path-previous-argument");
   TMSCM_ASSERT_PATH (arg2, TMSCM_ARG2, "path-previous-argument");
 
@@ -3548,6 +3975,7 @@ tmg_path_previous_argument (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_path_previous_section (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue path-previous-section");
   TMSCM_ASSERT_CONTENT (arg1, TMSCM_ARG1, "path-previous-section");
   TMSCM_ASSERT_PATH (arg2, TMSCM_ARG2, "path-previous-section");
 
@@ -3563,6 +3991,7 @@ tmg_path_previous_section (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_make_modification (tmscm arg1, tmscm arg2, tmscm arg3) {
+  PROFILE_TALLY ("glue make-modification");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "make-modification");
   TMSCM_ASSERT_PATH (arg2, TMSCM_ARG2, "make-modification");
   TMSCM_ASSERT_CONTENT (arg3, TMSCM_ARG3, "make-modification");
@@ -3580,6 +4009,7 @@ tmg_make_modification (tmscm arg1, tmscm arg2, tmscm arg3) {
 
 tmscm
 tmg_modification_assign (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue modification-assign");
   TMSCM_ASSERT_PATH (arg1, TMSCM_ARG1, "modification-assign");
   TMSCM_ASSERT_CONTENT (arg2, TMSCM_ARG2, "modification-assign");
 
@@ -3595,6 +4025,7 @@ tmg_modification_assign (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_modification_insert (tmscm arg1, tmscm arg2, tmscm arg3) {
+  PROFILE_TALLY ("glue modification-insert");
   TMSCM_ASSERT_PATH (arg1, TMSCM_ARG1, "modification-insert");
   TMSCM_ASSERT_INT (arg2, TMSCM_ARG2, "modification-insert");
   TMSCM_ASSERT_CONTENT (arg3, TMSCM_ARG3, "modification-insert");
@@ -3612,6 +4043,7 @@ tmg_modification_insert (tmscm arg1, tmscm arg2, tmscm arg3) {
 
 tmscm
 tmg_modification_remove (tmscm arg1, tmscm arg2, tmscm arg3) {
+  PROFILE_TALLY ("glue modification-remove");
   TMSCM_ASSERT_PATH (arg1, TMSCM_ARG1, "modification-remove");
   TMSCM_ASSERT_INT (arg2, TMSCM_ARG2, "modification-remove");
   TMSCM_ASSERT_INT (arg3, TMSCM_ARG3, "modification-remove");
@@ -3629,6 +4061,7 @@ tmg_modification_remove (tmscm arg1, tmscm arg2, tmscm arg3) {
 
 tmscm
 tmg_modification_split (tmscm arg1, tmscm arg2, tmscm arg3) {
+  PROFILE_TALLY ("glue modification-split");
   TMSCM_ASSERT_PATH (arg1, TMSCM_ARG1, "modification-split");
   TMSCM_ASSERT_INT (arg2, TMSCM_ARG2, "modification-split");
   TMSCM_ASSERT_INT (arg3, TMSCM_ARG3, "modification-split");
@@ -3646,6 +4079,7 @@ tmg_modification_split (tmscm arg1, tmscm arg2, tmscm arg3) {
 
 tmscm
 tmg_modification_join (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue modification-join");
   TMSCM_ASSERT_PATH (arg1, TMSCM_ARG1, "modification-join");
   TMSCM_ASSERT_INT (arg2, TMSCM_ARG2, "modification-join");
 
@@ -3661,6 +4095,7 @@ tmg_modification_join (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_modification_assign_node (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue modification-assign-node");
   TMSCM_ASSERT_PATH (arg1, TMSCM_ARG1, "modification-assign-node");
   TMSCM_ASSERT_TREE_LABEL (arg2, TMSCM_ARG2, "modification-assign-node");
 
@@ -3676,6 +4111,7 @@ tmg_modification_assign_node (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_modification_insert_node (tmscm arg1, tmscm arg2, tmscm arg3) {
+  PROFILE_TALLY ("glue modification-insert-node");
   TMSCM_ASSERT_PATH (arg1, TMSCM_ARG1, "modification-insert-node");
   TMSCM_ASSERT_INT (arg2, TMSCM_ARG2, "modification-insert-node");
   TMSCM_ASSERT_CONTENT (arg3, TMSCM_ARG3, "modification-insert-node");
@@ -3693,6 +4129,7 @@ tmg_modification_insert_node (tmscm arg1, tmscm arg2, tmscm arg3) {
 
 tmscm
 tmg_modification_remove_node (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue modification-remove-node");
   TMSCM_ASSERT_PATH (arg1, TMSCM_ARG1, "modification-remove-node");
   TMSCM_ASSERT_INT (arg2, TMSCM_ARG2, "modification-remove-node");
 
@@ -3708,6 +4145,7 @@ tmg_modification_remove_node (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_modification_set_cursor (tmscm arg1, tmscm arg2, tmscm arg3) {
+  PROFILE_TALLY ("glue modification-set-cursor");
   TMSCM_ASSERT_PATH (arg1, TMSCM_ARG1, "modification-set-cursor");
   TMSCM_ASSERT_INT (arg2, TMSCM_ARG2, "modification-set-cursor");
   TMSCM_ASSERT_CONTENT (arg3, TMSCM_ARG3, "modification-set-cursor");
@@ -3725,6 +4163,7 @@ tmg_modification_set_cursor (tmscm arg1, tmscm arg2, tmscm arg3) {
 
 tmscm
 tmg_modification_kind (tmscm arg1) {
+  PROFILE_TALLY ("glue modification-kind");
   TMSCM_ASSERT_MODIFICATION (arg1, TMSCM_ARG1, "modification-kind");
 
   modification in1= tmscm_to_modification (arg1);
@@ -3738,6 +4177,7 @@ tmg_modification_kind (tmscm arg1) {
 
 tmscm
 tmg_modification_path (tmscm arg1) {
+  PROFILE_TALLY ("glue modification-path");
   TMSCM_ASSERT_MODIFICATION (arg1, TMSCM_ARG1, "modification-path");
 
   modification in1= tmscm_to_modification (arg1);
@@ -3751,6 +4191,7 @@ tmg_modification_path (tmscm arg1) {
 
 tmscm
 tmg_modification_tree (tmscm arg1) {
+  PROFILE_TALLY ("glue modification-tree");
   TMSCM_ASSERT_MODIFICATION (arg1, TMSCM_ARG1, "modification-tree");
 
   modification in1= tmscm_to_modification (arg1);
@@ -3764,6 +4205,7 @@ tmg_modification_tree (tmscm arg1) {
 
 tmscm
 tmg_modification_root (tmscm arg1) {
+  PROFILE_TALLY ("glue modification-root");
   TMSCM_ASSERT_MODIFICATION (arg1, TMSCM_ARG1, "modification-root");
 
   modification in1= tmscm_to_modification (arg1);
@@ -3777,6 +4219,7 @@ tmg_modification_root (tmscm arg1) {
 
 tmscm
 tmg_modification_index (tmscm arg1) {
+  PROFILE_TALLY ("glue modification-index");
   TMSCM_ASSERT_MODIFICATION (arg1, TMSCM_ARG1, "modification-index");
 
   modification in1= tmscm_to_modification (arg1);
@@ -3790,6 +4233,7 @@ tmg_modification_index (tmscm arg1) {
 
 tmscm
 tmg_modification_argument (tmscm arg1) {
+  PROFILE_TALLY ("glue modification-argument");
   TMSCM_ASSERT_MODIFICATION (arg1, TMSCM_ARG1, "modification-argument");
 
   modification in1= tmscm_to_modification (arg1);
@@ -3803,6 +4247,7 @@ tmg_modification_argument (tmscm arg1) {
 
 tmscm
 tmg_modification_label (tmscm arg1) {
+  PROFILE_TALLY ("glue modification-label");
   TMSCM_ASSERT_MODIFICATION (arg1, TMSCM_ARG1, "modification-label");
 
   modification in1= tmscm_to_modification (arg1);
@@ -3816,6 +4261,7 @@ tmg_modification_label (tmscm arg1) {
 
 tmscm
 tmg_modification_copy (tmscm arg1) {
+  PROFILE_TALLY ("glue modification-copy");
   TMSCM_ASSERT_MODIFICATION (arg1, TMSCM_ARG1, "modification-copy");
 
   modification in1= tmscm_to_modification (arg1);
@@ -3829,6 +4275,7 @@ tmg_modification_copy (tmscm arg1) {
 
 tmscm
 tmg_modification_applicableP (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue modification-applicable?");
   TMSCM_ASSERT_CONTENT (arg1, TMSCM_ARG1, "modification-applicable?");
   TMSCM_ASSERT_MODIFICATION (arg2, TMSCM_ARG2, "modification-applicable?");
 
@@ -3844,6 +4291,7 @@ tmg_modification_applicableP (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_modification_apply (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue modification-apply");
   TMSCM_ASSERT_CONTENT (arg1, TMSCM_ARG1, "modification-apply");
   TMSCM_ASSERT_MODIFICATION (arg2, TMSCM_ARG2, "modification-apply");
 
@@ -3859,6 +4307,7 @@ tmg_modification_apply (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_modification_inplace_apply (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue modification-inplace-apply");
   TMSCM_ASSERT_TREE (arg1, TMSCM_ARG1, "modification-inplace-apply");
   TMSCM_ASSERT_MODIFICATION (arg2, TMSCM_ARG2, "modification-inplace-apply");
 
@@ -3874,6 +4323,7 @@ tmg_modification_inplace_apply (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_modification_invert (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue modification-invert");
   TMSCM_ASSERT_MODIFICATION (arg1, TMSCM_ARG1, "modification-invert");
   TMSCM_ASSERT_CONTENT (arg2, TMSCM_ARG2, "modification-invert");
 
@@ -3889,6 +4339,7 @@ tmg_modification_invert (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_modification_commuteP (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue modification-commute?");
   TMSCM_ASSERT_MODIFICATION (arg1, TMSCM_ARG1, "modification-commute?");
   TMSCM_ASSERT_MODIFICATION (arg2, TMSCM_ARG2, "modification-commute?");
 
@@ -3904,6 +4355,7 @@ tmg_modification_commuteP (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_modification_can_pullP (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue modification-can-pull?");
   TMSCM_ASSERT_MODIFICATION (arg1, TMSCM_ARG1, "modification-can-pull?");
   TMSCM_ASSERT_MODIFICATION (arg2, TMSCM_ARG2, "modification-can-pull?");
 
@@ -3919,6 +4371,7 @@ tmg_modification_can_pullP (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_modification_pull (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue modification-pull");
   TMSCM_ASSERT_MODIFICATION (arg1, TMSCM_ARG1, "modification-pull");
   TMSCM_ASSERT_MODIFICATION (arg2, TMSCM_ARG2, "modification-pull");
 
@@ -3934,6 +4387,7 @@ tmg_modification_pull (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_modification_co_pull (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue modification-co-pull");
   TMSCM_ASSERT_MODIFICATION (arg1, TMSCM_ARG1, "modification-co-pull");
   TMSCM_ASSERT_MODIFICATION (arg2, TMSCM_ARG2, "modification-co-pull");
 
@@ -3949,6 +4403,7 @@ tmg_modification_co_pull (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_patch_pair (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue patch-pair");
   TMSCM_ASSERT_MODIFICATION (arg1, TMSCM_ARG1, "patch-pair");
   TMSCM_ASSERT_MODIFICATION (arg2, TMSCM_ARG2, "patch-pair");
 
@@ -3964,6 +4419,7 @@ tmg_patch_pair (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_patch_compound (tmscm arg1) {
+  PROFILE_TALLY ("glue patch-compound");
   TMSCM_ASSERT_ARRAY_PATCH (arg1, TMSCM_ARG1, "patch-compound");
 
   array_patch in1= tmscm_to_array_patch (arg1);
@@ -3977,6 +4433,7 @@ tmg_patch_compound (tmscm arg1) {
 
 tmscm
 tmg_patch_branch (tmscm arg1) {
+  PROFILE_TALLY ("glue patch-branch");
   TMSCM_ASSERT_ARRAY_PATCH (arg1, TMSCM_ARG1, "patch-branch");
 
   array_patch in1= tmscm_to_array_patch (arg1);
@@ -3990,6 +4447,7 @@ tmg_patch_branch (tmscm arg1) {
 
 tmscm
 tmg_patch_birth (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue patch-birth");
   TMSCM_ASSERT_DOUBLE (arg1, TMSCM_ARG1, "patch-birth");
   TMSCM_ASSERT_BOOL (arg2, TMSCM_ARG2, "patch-birth");
 
@@ -4005,6 +4463,7 @@ tmg_patch_birth (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_patch_author (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue patch-author");
   TMSCM_ASSERT_DOUBLE (arg1, TMSCM_ARG1, "patch-author");
   TMSCM_ASSERT_PATCH (arg2, TMSCM_ARG2, "patch-author");
 
@@ -4020,6 +4479,7 @@ tmg_patch_author (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_patch_pairP (tmscm arg1) {
+  PROFILE_TALLY ("glue patch-pair?");
   TMSCM_ASSERT_PATCH (arg1, TMSCM_ARG1, "patch-pair?");
 
   patch in1= tmscm_to_patch (arg1);
@@ -4033,6 +4493,7 @@ tmg_patch_pairP (tmscm arg1) {
 
 tmscm
 tmg_patch_compoundP (tmscm arg1) {
+  PROFILE_TALLY ("glue patch-compound?");
   TMSCM_ASSERT_PATCH (arg1, TMSCM_ARG1, "patch-compound?");
 
   patch in1= tmscm_to_patch (arg1);
@@ -4046,6 +4507,7 @@ tmg_patch_compoundP (tmscm arg1) {
 
 tmscm
 tmg_patch_branchP (tmscm arg1) {
+  PROFILE_TALLY ("glue patch-branch?");
   TMSCM_ASSERT_PATCH (arg1, TMSCM_ARG1, "patch-branch?");
 
   patch in1= tmscm_to_patch (arg1);
@@ -4059,6 +4521,7 @@ tmg_patch_branchP (tmscm arg1) {
 
 tmscm
 tmg_patch_birthP (tmscm arg1) {
+  PROFILE_TALLY ("glue patch-birth?");
   TMSCM_ASSERT_PATCH (arg1, TMSCM_ARG1, "patch-birth?");
 
   patch in1= tmscm_to_patch (arg1);
@@ -4072,6 +4535,7 @@ tmg_patch_birthP (tmscm arg1) {
 
 tmscm
 tmg_patch_authorP (tmscm arg1) {
+  PROFILE_TALLY ("glue patch-author?");
   TMSCM_ASSERT_PATCH (arg1, TMSCM_ARG1, "patch-author?");
 
   patch in1= tmscm_to_patch (arg1);
@@ -4085,6 +4549,7 @@ tmg_patch_authorP (tmscm arg1) {
 
 tmscm
 tmg_patch_arity (tmscm arg1) {
+  PROFILE_TALLY ("glue patch-arity");
   TMSCM_ASSERT_PATCH (arg1, TMSCM_ARG1, "patch-arity");
 
   patch in1= tmscm_to_patch (arg1);
@@ -4098,6 +4563,7 @@ tmg_patch_arity (tmscm arg1) {
 
 tmscm
 tmg_patch_ref (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue patch-ref");
   TMSCM_ASSERT_PATCH (arg1, TMSCM_ARG1, "patch-ref");
   TMSCM_ASSERT_INT (arg2, TMSCM_ARG2, "patch-ref");
 
@@ -4113,6 +4579,7 @@ tmg_patch_ref (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_patch_direct (tmscm arg1) {
+  PROFILE_TALLY ("glue patch-direct");
   TMSCM_ASSERT_PATCH (arg1, TMSCM_ARG1, "patch-direct");
 
   patch in1= tmscm_to_patch (arg1);
@@ -4126,6 +4593,7 @@ tmg_patch_direct (tmscm arg1) {
 
 tmscm
 tmg_patch_inverse (tmscm arg1) {
+  PROFILE_TALLY ("glue patch-inverse");
   TMSCM_ASSERT_PATCH (arg1, TMSCM_ARG1, "patch-inverse");
 
   patch in1= tmscm_to_patch (arg1);
@@ -4139,6 +4607,7 @@ tmg_patch_inverse (tmscm arg1) {
 
 tmscm
 tmg_patch_get_birth (tmscm arg1) {
+  PROFILE_TALLY ("glue patch-get-birth");
   TMSCM_ASSERT_PATCH (arg1, TMSCM_ARG1, "patch-get-birth");
 
   patch in1= tmscm_to_patch (arg1);
@@ -4152,6 +4621,7 @@ tmg_patch_get_birth (tmscm arg1) {
 
 tmscm
 tmg_patch_get_author (tmscm arg1) {
+  PROFILE_TALLY ("glue patch-get-author");
   TMSCM_ASSERT_PATCH (arg1, TMSCM_ARG1, "patch-get-author");
 
   patch in1= tmscm_to_patch (arg1);
@@ -4165,6 +4635,7 @@ tmg_patch_get_author (tmscm arg1) {
 
 tmscm
 tmg_patch_copy (tmscm arg1) {
+  PROFILE_TALLY ("glue patch-copy");
   TMSCM_ASSERT_PATCH (arg1, TMSCM_ARG1, "patch-copy");
 
   patch in1= tmscm_to_patch (arg1);
@@ -4178,6 +4649,7 @@ tmg_patch_copy (tmscm arg1) {
 
 tmscm
 tmg_patch_applicableP (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue patch-applicable?");
   TMSCM_ASSERT_PATCH (arg1, TMSCM_ARG1, "patch-applicable?");
   TMSCM_ASSERT_CONTENT (arg2, TMSCM_ARG2, "patch-applicable?");
 
@@ -4193,6 +4665,7 @@ tmg_patch_applicableP (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_patch_apply (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue patch-apply");
   TMSCM_ASSERT_CONTENT (arg1, TMSCM_ARG1, "patch-apply");
   TMSCM_ASSERT_PATCH (arg2, TMSCM_ARG2, "patch-apply");
 
@@ -4208,6 +4681,7 @@ tmg_patch_apply (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_patch_inplace_apply (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue patch-inplace-apply");
   TMSCM_ASSERT_TREE (arg1, TMSCM_ARG1, "patch-inplace-apply");
   TMSCM_ASSERT_PATCH (arg2, TMSCM_ARG2, "patch-inplace-apply");
 
@@ -4223,6 +4697,7 @@ tmg_patch_inplace_apply (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_patch_compactify (tmscm arg1) {
+  PROFILE_TALLY ("glue patch-compactify");
   TMSCM_ASSERT_PATCH (arg1, TMSCM_ARG1, "patch-compactify");
 
   patch in1= tmscm_to_patch (arg1);
@@ -4236,6 +4711,7 @@ tmg_patch_compactify (tmscm arg1) {
 
 tmscm
 tmg_patch_cursor_hint (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue patch-cursor-hint");
   TMSCM_ASSERT_PATCH (arg1, TMSCM_ARG1, "patch-cursor-hint");
   TMSCM_ASSERT_CONTENT (arg2, TMSCM_ARG2, "patch-cursor-hint");
 
@@ -4251,6 +4727,7 @@ tmg_patch_cursor_hint (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_patch_invert (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue patch-invert");
   TMSCM_ASSERT_PATCH (arg1, TMSCM_ARG1, "patch-invert");
   TMSCM_ASSERT_CONTENT (arg2, TMSCM_ARG2, "patch-invert");
 
@@ -4266,6 +4743,7 @@ tmg_patch_invert (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_patch_commuteP (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue patch-commute?");
   TMSCM_ASSERT_PATCH (arg1, TMSCM_ARG1, "patch-commute?");
   TMSCM_ASSERT_PATCH (arg2, TMSCM_ARG2, "patch-commute?");
 
@@ -4281,6 +4759,7 @@ tmg_patch_commuteP (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_patch_can_pullP (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue patch-can-pull?");
   TMSCM_ASSERT_PATCH (arg1, TMSCM_ARG1, "patch-can-pull?");
   TMSCM_ASSERT_PATCH (arg2, TMSCM_ARG2, "patch-can-pull?");
 
@@ -4296,6 +4775,7 @@ tmg_patch_can_pullP (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_patch_pull (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue patch-pull");
   TMSCM_ASSERT_PATCH (arg1, TMSCM_ARG1, "patch-pull");
   TMSCM_ASSERT_PATCH (arg2, TMSCM_ARG2, "patch-pull");
 
@@ -4311,6 +4791,7 @@ tmg_patch_pull (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_patch_co_pull (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue patch-co-pull");
   TMSCM_ASSERT_PATCH (arg1, TMSCM_ARG1, "patch-co-pull");
   TMSCM_ASSERT_PATCH (arg2, TMSCM_ARG2, "patch-co-pull");
 
@@ -4326,6 +4807,7 @@ tmg_patch_co_pull (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_patch_remove_set_cursor (tmscm arg1) {
+  PROFILE_TALLY ("glue patch-remove-set-cursor");
   TMSCM_ASSERT_PATCH (arg1, TMSCM_ARG1, "patch-remove-set-cursor");
 
   patch in1= tmscm_to_patch (arg1);
@@ -4339,6 +4821,7 @@ tmg_patch_remove_set_cursor (tmscm arg1) {
 
 tmscm
 tmg_patch_modifiesP (tmscm arg1) {
+  PROFILE_TALLY ("glue patch-modifies?");
   TMSCM_ASSERT_PATCH (arg1, TMSCM_ARG1, "patch-modifies?");
 
   patch in1= tmscm_to_patch (arg1);
@@ -4352,6 +4835,7 @@ tmg_patch_modifiesP (tmscm arg1) {
 
 tmscm
 tmg_tree_2ids (tmscm arg1) {
+  PROFILE_TALLY ("glue tree->ids");
   TMSCM_ASSERT_TREE (arg1, TMSCM_ARG1, "tree->ids");
 
   tree in1= tmscm_to_tree (arg1);
@@ -4365,6 +4849,7 @@ tmg_tree_2ids (tmscm arg1) {
 
 tmscm
 tmg_id_2trees (tmscm arg1) {
+  PROFILE_TALLY ("glue id->trees");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "id->trees");
 
   string in1= tmscm_to_string (arg1);
@@ -4378,6 +4863,7 @@ tmg_id_2trees (tmscm arg1) {
 
 tmscm
 tmg_vertex_2links (tmscm arg1) {
+  PROFILE_TALLY ("glue vertex->links");
   TMSCM_ASSERT_CONTENT (arg1, TMSCM_ARG1, "vertex->links");
 
   content in1= tmscm_to_content (arg1);
@@ -4391,6 +4877,7 @@ tmg_vertex_2links (tmscm arg1) {
 
 tmscm
 tmg_tree_2tree_pointer (tmscm arg1) {
+  PROFILE_TALLY ("glue tree->tree-pointer");
   TMSCM_ASSERT_TREE (arg1, TMSCM_ARG1, "tree->tree-pointer");
 
   tree in1= tmscm_to_tree (arg1);
@@ -4404,6 +4891,7 @@ tmg_tree_2tree_pointer (tmscm arg1) {
 
 tmscm
 tmg_tree_pointer_detach (tmscm arg1) {
+  PROFILE_TALLY ("glue tree-pointer-detach");
   TMSCM_ASSERT_OBSERVER (arg1, TMSCM_ARG1, "tree-pointer-detach");
 
   observer in1= tmscm_to_observer (arg1);
@@ -4417,6 +4905,7 @@ tmg_tree_pointer_detach (tmscm arg1) {
 
 tmscm
 tmg_tree_pointer_2tree (tmscm arg1) {
+  PROFILE_TALLY ("glue tree-pointer->tree");
   TMSCM_ASSERT_OBSERVER (arg1, TMSCM_ARG1, "tree-pointer->tree");
 
   observer in1= tmscm_to_observer (arg1);
@@ -4430,6 +4919,7 @@ tmg_tree_pointer_2tree (tmscm arg1) {
 
 tmscm
 tmg_current_link_types () {
+  PROFILE_TALLY ("glue current-link-types");
   // TMSCM_DEFER_INTS;
   list_string out= all_link_types ();
   // TMSCM_ALLOW_INTS;
@@ -4439,6 +4929,7 @@ tmg_current_link_types () {
 
 tmscm
 tmg_get_locus_rendering (tmscm arg1) {
+  PROFILE_TALLY ("glue get-locus-rendering");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "get-locus-rendering");
 
   string in1= tmscm_to_string (arg1);
@@ -4452,6 +4943,7 @@ tmg_get_locus_rendering (tmscm arg1) {
 
 tmscm
 tmg_set_locus_rendering (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue set-locus-rendering");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "set-locus-rendering");
   TMSCM_ASSERT_STRING (arg2, TMSCM_ARG2, "set-locus-rendering");
 
@@ -4467,6 +4959,7 @@ tmg_set_locus_rendering (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_declare_visited (tmscm arg1) {
+  PROFILE_TALLY ("glue declare-visited");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "declare-visited");
 
   string in1= tmscm_to_string (arg1);
@@ -4480,6 +4973,7 @@ tmg_declare_visited (tmscm arg1) {
 
 tmscm
 tmg_has_been_visitedP (tmscm arg1) {
+  PROFILE_TALLY ("glue has-been-visited?");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "has-been-visited?");
 
   string in1= tmscm_to_string (arg1);
@@ -4493,6 +4987,7 @@ tmg_has_been_visitedP (tmscm arg1) {
 
 tmscm
 tmg_graphics_set (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue graphics-set");
   TMSCM_ASSERT_CONTENT (arg1, TMSCM_ARG1, "graphics-set");
   TMSCM_ASSERT_CONTENT (arg2, TMSCM_ARG2, "graphics-set");
 
@@ -4508,6 +5003,7 @@ tmg_graphics_set (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_graphics_hasP (tmscm arg1) {
+  PROFILE_TALLY ("glue graphics-has?");
   TMSCM_ASSERT_CONTENT (arg1, TMSCM_ARG1, "graphics-has?");
 
   content in1= tmscm_to_content (arg1);
@@ -4521,6 +5017,7 @@ tmg_graphics_hasP (tmscm arg1) {
 
 tmscm
 tmg_graphics_ref (tmscm arg1) {
+  PROFILE_TALLY ("glue graphics-ref");
   TMSCM_ASSERT_CONTENT (arg1, TMSCM_ARG1, "graphics-ref");
 
   content in1= tmscm_to_content (arg1);
@@ -4534,6 +5031,7 @@ tmg_graphics_ref (tmscm arg1) {
 
 tmscm
 tmg_graphics_needs_updateP () {
+  PROFILE_TALLY ("glue graphics-needs-update?");
   // TMSCM_DEFER_INTS;
   bool out= graphics_needs_update ();
   // TMSCM_ALLOW_INTS;
@@ -4543,6 +5041,7 @@ tmg_graphics_needs_updateP () {
 
 tmscm
 tmg_graphics_notify_update (tmscm arg1) {
+  PROFILE_TALLY ("glue graphics-notify-update");
   TMSCM_ASSERT_CONTENT (arg1, TMSCM_ARG1, "graphics-notify-update");
 
   content in1= tmscm_to_content (arg1);
@@ -4556,6 +5055,7 @@ tmg_graphics_notify_update (tmscm arg1) {
 
 tmscm
 tmg_string_numberP (tmscm arg1) {
+  PROFILE_TALLY ("glue string-number?");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "string-number?");
 
   string in1= tmscm_to_string (arg1);
@@ -4569,6 +5069,7 @@ tmg_string_numberP (tmscm arg1) {
 
 tmscm
 tmg_string_occursP (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue string-occurs?");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "string-occurs?");
   TMSCM_ASSERT_STRING (arg2, TMSCM_ARG2, "string-occurs?");
 
@@ -4584,6 +5085,7 @@ tmg_string_occursP (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_string_count_occurrences (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue string-count-occurrences");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "string-count-occurrences");
   TMSCM_ASSERT_STRING (arg2, TMSCM_ARG2, "string-count-occurrences");
 
@@ -4599,6 +5101,7 @@ tmg_string_count_occurrences (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_string_search_forwards (tmscm arg1, tmscm arg2, tmscm arg3) {
+  PROFILE_TALLY ("glue string-search-forwards");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "string-search-forwards");
   TMSCM_ASSERT_INT (arg2, TMSCM_ARG2, "string-search-forwards");
   TMSCM_ASSERT_STRING (arg3, TMSCM_ARG3, "string-search-forwards");
@@ -4616,6 +5119,7 @@ tmg_string_search_forwards (tmscm arg1, tmscm arg2, tmscm arg3) {
 
 tmscm
 tmg_string_search_backwards (tmscm arg1, tmscm arg2, tmscm arg3) {
+  PROFILE_TALLY ("glue string-search-backwards");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "string-search-backwards");
   TMSCM_ASSERT_INT (arg2, TMSCM_ARG2, "string-search-backwards");
   TMSCM_ASSERT_STRING (arg3, TMSCM_ARG3, "string-search-backwards");
@@ -4633,6 +5137,7 @@ tmg_string_search_backwards (tmscm arg1, tmscm arg2, tmscm arg3) {
 
 tmscm
 tmg_string_overlapping (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue string-overlapping");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "string-overlapping");
   TMSCM_ASSERT_STRING (arg2, TMSCM_ARG2, "string-overlapping");
 
@@ -4648,6 +5153,7 @@ tmg_string_overlapping (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_string_replace (tmscm arg1, tmscm arg2, tmscm arg3) {
+  PROFILE_TALLY ("glue string-replace");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "string-replace");
   TMSCM_ASSERT_STRING (arg2, TMSCM_ARG2, "string-replace");
   TMSCM_ASSERT_STRING (arg3, TMSCM_ARG3, "string-replace");
@@ -4665,6 +5171,7 @@ tmg_string_replace (tmscm arg1, tmscm arg2, tmscm arg3) {
 
 tmscm
 tmg_string_alphaP (tmscm arg1) {
+  PROFILE_TALLY ("glue string-alpha?");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "string-alpha?");
 
   string in1= tmscm_to_string (arg1);
@@ -4678,6 +5185,7 @@ tmg_string_alphaP (tmscm arg1) {
 
 tmscm
 tmg_string_locase_alphaP (tmscm arg1) {
+  PROFILE_TALLY ("glue string-locase-alpha?");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "string-locase-alpha?");
 
   string in1= tmscm_to_string (arg1);
@@ -4691,6 +5199,7 @@ tmg_string_locase_alphaP (tmscm arg1) {
 
 tmscm
 tmg_upcase_first (tmscm arg1) {
+  PROFILE_TALLY ("glue upcase-first");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "upcase-first");
 
   string in1= tmscm_to_string (arg1);
@@ -4704,6 +5213,7 @@ tmg_upcase_first (tmscm arg1) {
 
 tmscm
 tmg_locase_first (tmscm arg1) {
+  PROFILE_TALLY ("glue locase-first");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "locase-first");
 
   string in1= tmscm_to_string (arg1);
@@ -4717,6 +5227,7 @@ tmg_locase_first (tmscm arg1) {
 
 tmscm
 tmg_upcase_all (tmscm arg1) {
+  PROFILE_TALLY ("glue upcase-all");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "upcase-all");
 
   string in1= tmscm_to_string (arg1);
@@ -4730,6 +5241,7 @@ tmg_upcase_all (tmscm arg1) {
 
 tmscm
 tmg_locase_all (tmscm arg1) {
+  PROFILE_TALLY ("glue locase-all");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "locase-all");
 
   string in1= tmscm_to_string (arg1);
@@ -4743,6 +5255,7 @@ tmg_locase_all (tmscm arg1) {
 
 tmscm
 tmg_string_union (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue string-union");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "string-union");
   TMSCM_ASSERT_STRING (arg2, TMSCM_ARG2, "string-union");
 
@@ -4758,6 +5271,7 @@ tmg_string_union (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_string_minus (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue string-minus");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "string-minus");
   TMSCM_ASSERT_STRING (arg2, TMSCM_ARG2, "string-minus");
 
@@ -4773,6 +5287,7 @@ tmg_string_minus (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_escape_generic (tmscm arg1) {
+  PROFILE_TALLY ("glue escape-generic");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "escape-generic");
 
   string in1= tmscm_to_string (arg1);
@@ -4786,6 +5301,7 @@ tmg_escape_generic (tmscm arg1) {
 
 tmscm
 tmg_escape_verbatim (tmscm arg1) {
+  PROFILE_TALLY ("glue escape-verbatim");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "escape-verbatim");
 
   string in1= tmscm_to_string (arg1);
@@ -4799,6 +5315,7 @@ tmg_escape_verbatim (tmscm arg1) {
 
 tmscm
 tmg_escape_shell (tmscm arg1) {
+  PROFILE_TALLY ("glue escape-shell");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "escape-shell");
 
   string in1= tmscm_to_string (arg1);
@@ -4812,6 +5329,7 @@ tmg_escape_shell (tmscm arg1) {
 
 tmscm
 tmg_escape_to_ascii (tmscm arg1) {
+  PROFILE_TALLY ("glue escape-to-ascii");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "escape-to-ascii");
 
   string in1= tmscm_to_string (arg1);
@@ -4825,6 +5343,7 @@ tmg_escape_to_ascii (tmscm arg1) {
 
 tmscm
 tmg_unescape_guile (tmscm arg1) {
+  PROFILE_TALLY ("glue unescape-guile");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "unescape-guile");
 
   string in1= tmscm_to_string (arg1);
@@ -4838,6 +5357,7 @@ tmg_unescape_guile (tmscm arg1) {
 
 tmscm
 tmg_string_quote (tmscm arg1) {
+  PROFILE_TALLY ("glue string-quote");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "string-quote");
 
   string in1= tmscm_to_string (arg1);
@@ -4851,6 +5371,7 @@ tmg_string_quote (tmscm arg1) {
 
 tmscm
 tmg_string_unquote (tmscm arg1) {
+  PROFILE_TALLY ("glue string-unquote");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "string-unquote");
 
   string in1= tmscm_to_string (arg1);
@@ -4864,6 +5385,7 @@ tmg_string_unquote (tmscm arg1) {
 
 tmscm
 tmg_string_trim_spaces_left (tmscm arg1) {
+  PROFILE_TALLY ("glue string-trim-spaces-left");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "string-trim-spaces-left");
 
   string in1= tmscm_to_string (arg1);
@@ -4877,6 +5399,7 @@ tmg_string_trim_spaces_left (tmscm arg1) {
 
 tmscm
 tmg_string_trim_spaces_right (tmscm arg1) {
+  PROFILE_TALLY ("glue string-trim-spaces-right");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "string-trim-spaces-right");
 
   string in1= tmscm_to_string (arg1);
@@ -4890,6 +5413,7 @@ tmg_string_trim_spaces_right (tmscm arg1) {
 
 tmscm
 tmg_string_trim_spaces (tmscm arg1) {
+  PROFILE_TALLY ("glue string-trim-spaces");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "string-trim-spaces");
 
   string in1= tmscm_to_string (arg1);
@@ -4903,6 +5427,7 @@ tmg_string_trim_spaces (tmscm arg1) {
 
 tmscm
 tmg_downgrade_math_letters (tmscm arg1) {
+  PROFILE_TALLY ("glue downgrade-math-letters");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "downgrade-math-letters");
 
   string in1= tmscm_to_string (arg1);
@@ -4916,6 +5441,7 @@ tmg_downgrade_math_letters (tmscm arg1) {
 
 tmscm
 tmg_string_convert (tmscm arg1, tmscm arg2, tmscm arg3) {
+  PROFILE_TALLY ("glue string-convert");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "string-convert");
   TMSCM_ASSERT_STRING (arg2, TMSCM_ARG2, "string-convert");
   TMSCM_ASSERT_STRING (arg3, TMSCM_ARG3, "string-convert");
@@ -4933,6 +5459,7 @@ tmg_string_convert (tmscm arg1, tmscm arg2, tmscm arg3) {
 
 tmscm
 tmg_encode_base64 (tmscm arg1) {
+  PROFILE_TALLY ("glue encode-base64");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "encode-base64");
 
   string in1= tmscm_to_string (arg1);
@@ -4946,6 +5473,7 @@ tmg_encode_base64 (tmscm arg1) {
 
 tmscm
 tmg_decode_base64 (tmscm arg1) {
+  PROFILE_TALLY ("glue decode-base64");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "decode-base64");
 
   string in1= tmscm_to_string (arg1);
@@ -4959,6 +5487,7 @@ tmg_decode_base64 (tmscm arg1) {
 
 tmscm
 tmg_sourcecode_2cork (tmscm arg1) {
+  PROFILE_TALLY ("glue sourcecode->cork");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "sourcecode->cork");
 
   string in1= tmscm_to_string (arg1);
@@ -4972,6 +5501,7 @@ tmg_sourcecode_2cork (tmscm arg1) {
 
 tmscm
 tmg_cork_2sourcecode (tmscm arg1) {
+  PROFILE_TALLY ("glue cork->sourcecode");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "cork->sourcecode");
 
   string in1= tmscm_to_string (arg1);
@@ -4985,6 +5515,7 @@ tmg_cork_2sourcecode (tmscm arg1) {
 
 tmscm
 tmg_utf8_2cork (tmscm arg1) {
+  PROFILE_TALLY ("glue utf8->cork");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "utf8->cork");
 
   string in1= tmscm_to_string (arg1);
@@ -4998,6 +5529,7 @@ tmg_utf8_2cork (tmscm arg1) {
 
 tmscm
 tmg_cork_2utf8 (tmscm arg1) {
+  PROFILE_TALLY ("glue cork->utf8");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "cork->utf8");
 
   string in1= tmscm_to_string (arg1);
@@ -5011,6 +5543,7 @@ tmg_cork_2utf8 (tmscm arg1) {
 
 tmscm
 tmg_utf8_2t2a (tmscm arg1) {
+  PROFILE_TALLY ("glue utf8->t2a");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "utf8->t2a");
 
   string in1= tmscm_to_string (arg1);
@@ -5024,6 +5557,7 @@ tmg_utf8_2t2a (tmscm arg1) {
 
 tmscm
 tmg_t2a_2utf8 (tmscm arg1) {
+  PROFILE_TALLY ("glue t2a->utf8");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "t2a->utf8");
 
   string in1= tmscm_to_string (arg1);
@@ -5037,6 +5571,7 @@ tmg_t2a_2utf8 (tmscm arg1) {
 
 tmscm
 tmg_utf8_2html (tmscm arg1) {
+  PROFILE_TALLY ("glue utf8->html");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "utf8->html");
 
   string in1= tmscm_to_string (arg1);
@@ -5050,6 +5585,7 @@ tmg_utf8_2html (tmscm arg1) {
 
 tmscm
 tmg_guess_wencoding (tmscm arg1) {
+  PROFILE_TALLY ("glue guess-wencoding");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "guess-wencoding");
 
   string in1= tmscm_to_string (arg1);
@@ -5063,6 +5599,7 @@ tmg_guess_wencoding (tmscm arg1) {
 
 tmscm
 tmg_tm_2xml_name (tmscm arg1) {
+  PROFILE_TALLY ("glue tm->xml-name");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "tm->xml-name");
 
   string in1= tmscm_to_string (arg1);
@@ -5076,6 +5613,7 @@ tmg_tm_2xml_name (tmscm arg1) {
 
 tmscm
 tmg_old_tm_2xml_cdata (tmscm arg1) {
+  PROFILE_TALLY ("glue old-tm->xml-cdata");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "old-tm->xml-cdata");
 
   string in1= tmscm_to_string (arg1);
@@ -5089,6 +5627,7 @@ tmg_old_tm_2xml_cdata (tmscm arg1) {
 
 tmscm
 tmg_tm_2xml_cdata (tmscm arg1) {
+  PROFILE_TALLY ("glue tm->xml-cdata");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "tm->xml-cdata");
 
   string in1= tmscm_to_string (arg1);
@@ -5102,6 +5641,7 @@ tmg_tm_2xml_cdata (tmscm arg1) {
 
 tmscm
 tmg_xml_name_2tm (tmscm arg1) {
+  PROFILE_TALLY ("glue xml-name->tm");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "xml-name->tm");
 
   string in1= tmscm_to_string (arg1);
@@ -5115,6 +5655,7 @@ tmg_xml_name_2tm (tmscm arg1) {
 
 tmscm
 tmg_old_xml_cdata_2tm (tmscm arg1) {
+  PROFILE_TALLY ("glue old-xml-cdata->tm");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "old-xml-cdata->tm");
 
   string in1= tmscm_to_string (arg1);
@@ -5128,6 +5669,7 @@ tmg_old_xml_cdata_2tm (tmscm arg1) {
 
 tmscm
 tmg_xml_unspace (tmscm arg1, tmscm arg2, tmscm arg3) {
+  PROFILE_TALLY ("glue xml-unspace");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "xml-unspace");
   TMSCM_ASSERT_BOOL (arg2, TMSCM_ARG2, "xml-unspace");
   TMSCM_ASSERT_BOOL (arg3, TMSCM_ARG3, "xml-unspace");
@@ -5145,6 +5687,7 @@ tmg_xml_unspace (tmscm arg1, tmscm arg2, tmscm arg3) {
 
 tmscm
 tmg_integer_2hexadecimal (tmscm arg1) {
+  PROFILE_TALLY ("glue integer->hexadecimal");
   TMSCM_ASSERT_INT (arg1, TMSCM_ARG1, "integer->hexadecimal");
 
   int in1= tmscm_to_int (arg1);
@@ -5158,6 +5701,7 @@ tmg_integer_2hexadecimal (tmscm arg1) {
 
 tmscm
 tmg_integer_2padded_hexadecimal (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue integer->padded-hexadecimal");
   TMSCM_ASSERT_INT (arg1, TMSCM_ARG1, "integer->padded-hexadecimal");
   TMSCM_ASSERT_INT (arg2, TMSCM_ARG2, "integer->padded-hexadecimal");
 
@@ -5173,6 +5717,7 @@ tmg_integer_2padded_hexadecimal (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_hexadecimal_2integer (tmscm arg1) {
+  PROFILE_TALLY ("glue hexadecimal->integer");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "hexadecimal->integer");
 
   string in1= tmscm_to_string (arg1);
@@ -5186,6 +5731,7 @@ tmg_hexadecimal_2integer (tmscm arg1) {
 
 tmscm
 tmg_cpp_string_tokenize (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue cpp-string-tokenize");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "cpp-string-tokenize");
   TMSCM_ASSERT_STRING (arg2, TMSCM_ARG2, "cpp-string-tokenize");
 
@@ -5201,6 +5747,7 @@ tmg_cpp_string_tokenize (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_cpp_string_recompose (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue cpp-string-recompose");
   TMSCM_ASSERT_ARRAY_STRING (arg1, TMSCM_ARG1, "cpp-string-recompose");
   TMSCM_ASSERT_STRING (arg2, TMSCM_ARG2, "cpp-string-recompose");
 
@@ -5216,6 +5763,7 @@ tmg_cpp_string_recompose (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_string_differences (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue string-differences");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "string-differences");
   TMSCM_ASSERT_STRING (arg2, TMSCM_ARG2, "string-differences");
 
@@ -5231,6 +5779,7 @@ tmg_string_differences (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_string_distance (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue string-distance");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "string-distance");
   TMSCM_ASSERT_STRING (arg2, TMSCM_ARG2, "string-distance");
 
@@ -5246,6 +5795,7 @@ tmg_string_distance (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_find_left_bracket (tmscm arg1, tmscm arg2, tmscm arg3) {
+  PROFILE_TALLY ("glue find-left-bracket");
   TMSCM_ASSERT_PATH (arg1, TMSCM_ARG1, "find-left-bracket");
   TMSCM_ASSERT_STRING (arg2, TMSCM_ARG2, "find-left-bracket");
   TMSCM_ASSERT_STRING (arg3, TMSCM_ARG3, "find-left-bracket");
@@ -5263,6 +5813,7 @@ tmg_find_left_bracket (tmscm arg1, tmscm arg2, tmscm arg3) {
 
 tmscm
 tmg_find_right_bracket (tmscm arg1, tmscm arg2, tmscm arg3) {
+  PROFILE_TALLY ("glue find-right-bracket");
   TMSCM_ASSERT_PATH (arg1, TMSCM_ARG1, "find-right-bracket");
   TMSCM_ASSERT_STRING (arg2, TMSCM_ARG2, "find-right-bracket");
   TMSCM_ASSERT_STRING (arg3, TMSCM_ARG3, "find-right-bracket");
@@ -5280,6 +5831,7 @@ tmg_find_right_bracket (tmscm arg1, tmscm arg2, tmscm arg3) {
 
 tmscm
 tmg_string_2tmstring (tmscm arg1) {
+  PROFILE_TALLY ("glue string->tmstring");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "string->tmstring");
 
   string in1= tmscm_to_string (arg1);
@@ -5293,6 +5845,7 @@ tmg_string_2tmstring (tmscm arg1) {
 
 tmscm
 tmg_tmstring_2string (tmscm arg1) {
+  PROFILE_TALLY ("glue tmstring->string");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "tmstring->string");
 
   string in1= tmscm_to_string (arg1);
@@ -5306,6 +5859,7 @@ tmg_tmstring_2string (tmscm arg1) {
 
 tmscm
 tmg_tmstring_length (tmscm arg1) {
+  PROFILE_TALLY ("glue tmstring-length");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "tmstring-length");
 
   string in1= tmscm_to_string (arg1);
@@ -5319,6 +5873,7 @@ tmg_tmstring_length (tmscm arg1) {
 
 tmscm
 tmg_tmstring_ref (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue tmstring-ref");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "tmstring-ref");
   TMSCM_ASSERT_INT (arg2, TMSCM_ARG2, "tmstring-ref");
 
@@ -5334,6 +5889,7 @@ tmg_tmstring_ref (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_tmstring_reverse_ref (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue tmstring-reverse-ref");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "tmstring-reverse-ref");
   TMSCM_ASSERT_INT (arg2, TMSCM_ARG2, "tmstring-reverse-ref");
 
@@ -5349,6 +5905,7 @@ tmg_tmstring_reverse_ref (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_tmstring_2list (tmscm arg1) {
+  PROFILE_TALLY ("glue tmstring->list");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "tmstring->list");
 
   string in1= tmscm_to_string (arg1);
@@ -5362,6 +5919,7 @@ tmg_tmstring_2list (tmscm arg1) {
 
 tmscm
 tmg_list_2tmstring (tmscm arg1) {
+  PROFILE_TALLY ("glue list->tmstring");
   TMSCM_ASSERT_ARRAY_STRING (arg1, TMSCM_ARG1, "list->tmstring");
 
   array_string in1= tmscm_to_array_string (arg1);
@@ -5375,6 +5933,7 @@ tmg_list_2tmstring (tmscm arg1) {
 
 tmscm
 tmg_string_next (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue string-next");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "string-next");
   TMSCM_ASSERT_INT (arg2, TMSCM_ARG2, "string-next");
 
@@ -5390,6 +5949,7 @@ tmg_string_next (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_string_previous (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue string-previous");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "string-previous");
   TMSCM_ASSERT_INT (arg2, TMSCM_ARG2, "string-previous");
 
@@ -5405,6 +5965,7 @@ tmg_string_previous (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_tmstring_split (tmscm arg1) {
+  PROFILE_TALLY ("glue tmstring-split");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "tmstring-split");
 
   string in1= tmscm_to_string (arg1);
@@ -5418,6 +5979,7 @@ tmg_tmstring_split (tmscm arg1) {
 
 tmscm
 tmg_tmstring_translit (tmscm arg1) {
+  PROFILE_TALLY ("glue tmstring-translit");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "tmstring-translit");
 
   string in1= tmscm_to_string (arg1);
@@ -5431,6 +5993,7 @@ tmg_tmstring_translit (tmscm arg1) {
 
 tmscm
 tmg_tmstring_locase_first (tmscm arg1) {
+  PROFILE_TALLY ("glue tmstring-locase-first");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "tmstring-locase-first");
 
   string in1= tmscm_to_string (arg1);
@@ -5444,6 +6007,7 @@ tmg_tmstring_locase_first (tmscm arg1) {
 
 tmscm
 tmg_tmstring_upcase_first (tmscm arg1) {
+  PROFILE_TALLY ("glue tmstring-upcase-first");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "tmstring-upcase-first");
 
   string in1= tmscm_to_string (arg1);
@@ -5457,6 +6021,7 @@ tmg_tmstring_upcase_first (tmscm arg1) {
 
 tmscm
 tmg_tmstring_locase_all (tmscm arg1) {
+  PROFILE_TALLY ("glue tmstring-locase-all");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "tmstring-locase-all");
 
   string in1= tmscm_to_string (arg1);
@@ -5470,6 +6035,7 @@ tmg_tmstring_locase_all (tmscm arg1) {
 
 tmscm
 tmg_tmstring_upcase_all (tmscm arg1) {
+  PROFILE_TALLY ("glue tmstring-upcase-all");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "tmstring-upcase-all");
 
   string in1= tmscm_to_string (arg1);
@@ -5483,6 +6049,7 @@ tmg_tmstring_upcase_all (tmscm arg1) {
 
 tmscm
 tmg_tmstring_unaccent_all (tmscm arg1) {
+  PROFILE_TALLY ("glue tmstring-unaccent-all");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "tmstring-unaccent-all");
 
   string in1= tmscm_to_string (arg1);
@@ -5496,6 +6063,7 @@ tmg_tmstring_unaccent_all (tmscm arg1) {
 
 tmscm
 tmg_tmstring_letterP (tmscm arg1) {
+  PROFILE_TALLY ("glue tmstring-letter?");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "tmstring-letter?");
 
   string in1= tmscm_to_string (arg1);
@@ -5509,6 +6077,7 @@ tmg_tmstring_letterP (tmscm arg1) {
 
 tmscm
 tmg_tmstring_beforeP (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue tmstring-before?");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "tmstring-before?");
   TMSCM_ASSERT_STRING (arg2, TMSCM_ARG2, "tmstring-before?");
 
@@ -5524,6 +6093,7 @@ tmg_tmstring_beforeP (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_multi_spell_start () {
+  PROFILE_TALLY ("glue multi-spell-start");
   // TMSCM_DEFER_INTS;
   spell_start ();
   // TMSCM_ALLOW_INTS;
@@ -5533,6 +6103,7 @@ tmg_multi_spell_start () {
 
 tmscm
 tmg_multi_spell_done () {
+  PROFILE_TALLY ("glue multi-spell-done");
   // TMSCM_DEFER_INTS;
   spell_done ();
   // TMSCM_ALLOW_INTS;
@@ -5542,6 +6113,7 @@ tmg_multi_spell_done () {
 
 tmscm
 tmg_single_spell_start (tmscm arg1) {
+  PROFILE_TALLY ("glue single-spell-start");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "single-spell-start");
 
   string in1= tmscm_to_string (arg1);
@@ -5555,6 +6127,7 @@ tmg_single_spell_start (tmscm arg1) {
 
 tmscm
 tmg_single_spell_done (tmscm arg1) {
+  PROFILE_TALLY ("glue single-spell-done");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "single-spell-done");
 
   string in1= tmscm_to_string (arg1);
@@ -5568,6 +6141,7 @@ tmg_single_spell_done (tmscm arg1) {
 
 tmscm
 tmg_spell_check (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue spell-check");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "spell-check");
   TMSCM_ASSERT_STRING (arg2, TMSCM_ARG2, "spell-check");
 
@@ -5583,6 +6157,7 @@ tmg_spell_check (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_spell_checkP (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue spell-check?");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "spell-check?");
   TMSCM_ASSERT_STRING (arg2, TMSCM_ARG2, "spell-check?");
 
@@ -5598,6 +6173,7 @@ tmg_spell_checkP (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_spell_accept (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue spell-accept");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "spell-accept");
   TMSCM_ASSERT_STRING (arg2, TMSCM_ARG2, "spell-accept");
 
@@ -5613,6 +6189,7 @@ tmg_spell_accept (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_spell_var_accept (tmscm arg1, tmscm arg2, tmscm arg3) {
+  PROFILE_TALLY ("glue spell-var-accept");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "spell-var-accept");
   TMSCM_ASSERT_STRING (arg2, TMSCM_ARG2, "spell-var-accept");
   TMSCM_ASSERT_BOOL (arg3, TMSCM_ARG3, "spell-var-accept");
@@ -5630,6 +6207,7 @@ tmg_spell_var_accept (tmscm arg1, tmscm arg2, tmscm arg3) {
 
 tmscm
 tmg_spell_insert (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue spell-insert");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "spell-insert");
   TMSCM_ASSERT_STRING (arg2, TMSCM_ARG2, "spell-insert");
 
@@ -5645,6 +6223,7 @@ tmg_spell_insert (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_packrat_define (tmscm arg1, tmscm arg2, tmscm arg3) {
+  PROFILE_TALLY ("glue packrat-define");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "packrat-define");
   TMSCM_ASSERT_STRING (arg2, TMSCM_ARG2, "packrat-define");
   TMSCM_ASSERT_TREE (arg3, TMSCM_ARG3, "packrat-define");
@@ -5662,6 +6241,7 @@ tmg_packrat_define (tmscm arg1, tmscm arg2, tmscm arg3) {
 
 tmscm
 tmg_packrat_property (tmscm arg1, tmscm arg2, tmscm arg3, tmscm arg4) {
+  PROFILE_TALLY ("glue packrat-property");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "packrat-property");
   TMSCM_ASSERT_STRING (arg2, TMSCM_ARG2, "packrat-property");
   TMSCM_ASSERT_STRING (arg3, TMSCM_ARG3, "packrat-property");
@@ -5681,6 +6261,7 @@ tmg_packrat_property (tmscm arg1, tmscm arg2, tmscm arg3, tmscm arg4) {
 
 tmscm
 tmg_packrat_inherit (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue packrat-inherit");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "packrat-inherit");
   TMSCM_ASSERT_STRING (arg2, TMSCM_ARG2, "packrat-inherit");
 
@@ -5696,6 +6277,7 @@ tmg_packrat_inherit (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_packrat_parse (tmscm arg1, tmscm arg2, tmscm arg3) {
+  PROFILE_TALLY ("glue packrat-parse");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "packrat-parse");
   TMSCM_ASSERT_STRING (arg2, TMSCM_ARG2, "packrat-parse");
   TMSCM_ASSERT_CONTENT (arg3, TMSCM_ARG3, "packrat-parse");
@@ -5713,6 +6295,7 @@ tmg_packrat_parse (tmscm arg1, tmscm arg2, tmscm arg3) {
 
 tmscm
 tmg_packrat_correctP (tmscm arg1, tmscm arg2, tmscm arg3) {
+  PROFILE_TALLY ("glue packrat-correct?");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "packrat-correct?");
   TMSCM_ASSERT_STRING (arg2, TMSCM_ARG2, "packrat-correct?");
   TMSCM_ASSERT_CONTENT (arg3, TMSCM_ARG3, "packrat-correct?");
@@ -5730,6 +6313,7 @@ tmg_packrat_correctP (tmscm arg1, tmscm arg2, tmscm arg3) {
 
 tmscm
 tmg_packrat_context (tmscm arg1, tmscm arg2, tmscm arg3, tmscm arg4) {
+  PROFILE_TALLY ("glue packrat-context");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "packrat-context");
   TMSCM_ASSERT_STRING (arg2, TMSCM_ARG2, "packrat-context");
   TMSCM_ASSERT_CONTENT (arg3, TMSCM_ARG3, "packrat-context");
@@ -5749,6 +6333,7 @@ tmg_packrat_context (tmscm arg1, tmscm arg2, tmscm arg3, tmscm arg4) {
 
 tmscm
 tmg_syntax_read_preferences (tmscm arg1) {
+  PROFILE_TALLY ("glue syntax-read-preferences");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "syntax-read-preferences");
 
   string in1= tmscm_to_string (arg1);
@@ -5762,6 +6347,7 @@ tmg_syntax_read_preferences (tmscm arg1) {
 
 tmscm
 tmg_parse_texmacs (tmscm arg1) {
+  PROFILE_TALLY ("glue parse-texmacs");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "parse-texmacs");
 
   string in1= tmscm_to_string (arg1);
@@ -5775,6 +6361,7 @@ tmg_parse_texmacs (tmscm arg1) {
 
 tmscm
 tmg_serialize_texmacs (tmscm arg1) {
+  PROFILE_TALLY ("glue serialize-texmacs");
   TMSCM_ASSERT_TREE (arg1, TMSCM_ARG1, "serialize-texmacs");
 
   tree in1= tmscm_to_tree (arg1);
@@ -5788,6 +6375,7 @@ tmg_serialize_texmacs (tmscm arg1) {
 
 tmscm
 tmg_parse_texmacs_snippet (tmscm arg1) {
+  PROFILE_TALLY ("glue parse-texmacs-snippet");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "parse-texmacs-snippet");
 
   string in1= tmscm_to_string (arg1);
@@ -5801,6 +6389,7 @@ tmg_parse_texmacs_snippet (tmscm arg1) {
 
 tmscm
 tmg_serialize_texmacs_snippet (tmscm arg1) {
+  PROFILE_TALLY ("glue serialize-texmacs-snippet");
   TMSCM_ASSERT_TREE (arg1, TMSCM_ARG1, "serialize-texmacs-snippet");
 
   tree in1= tmscm_to_tree (arg1);
@@ -5814,6 +6403,7 @@ tmg_serialize_texmacs_snippet (tmscm arg1) {
 
 tmscm
 tmg_texmacs_2stm (tmscm arg1) {
+  PROFILE_TALLY ("glue texmacs->stm");
   TMSCM_ASSERT_TREE (arg1, TMSCM_ARG1, "texmacs->stm");
 
   tree in1= tmscm_to_tree (arg1);
@@ -5827,6 +6417,7 @@ tmg_texmacs_2stm (tmscm arg1) {
 
 tmscm
 tmg_stm_2texmacs (tmscm arg1) {
+  PROFILE_TALLY ("glue stm->texmacs");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "stm->texmacs");
 
   string in1= tmscm_to_string (arg1);
@@ -5840,6 +6431,7 @@ tmg_stm_2texmacs (tmscm arg1) {
 
 tmscm
 tmg_stm_snippet_2texmacs (tmscm arg1) {
+  PROFILE_TALLY ("glue stm-snippet->texmacs");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "stm-snippet->texmacs");
 
   string in1= tmscm_to_string (arg1);
@@ -5853,6 +6445,7 @@ tmg_stm_snippet_2texmacs (tmscm arg1) {
 
 tmscm
 tmg_cpp_texmacs_2verbatim (tmscm arg1, tmscm arg2, tmscm arg3) {
+  PROFILE_TALLY ("glue cpp-texmacs->verbatim");
   TMSCM_ASSERT_TREE (arg1, TMSCM_ARG1, "cpp-texmacs->verbatim");
   TMSCM_ASSERT_BOOL (arg2, TMSCM_ARG2, "cpp-texmacs->verbatim");
   TMSCM_ASSERT_STRING (arg3, TMSCM_ARG3, "cpp-texmacs->verbatim");
@@ -5870,6 +6463,7 @@ tmg_cpp_texmacs_2verbatim (tmscm arg1, tmscm arg2, tmscm arg3) {
 
 tmscm
 tmg_cpp_verbatim_snippet_2texmacs (tmscm arg1, tmscm arg2, tmscm arg3) {
+  PROFILE_TALLY ("glue cpp-verbatim-snippet->texmacs");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "cpp-verbatim-snippet->texmacs");
   TMSCM_ASSERT_BOOL (arg2, TMSCM_ARG2, "cpp-verbatim-snippet->texmacs");
   TMSCM_ASSERT_STRING (arg3, TMSCM_ARG3, "cpp-verbatim-snippet->texmacs");
@@ -5887,6 +6481,7 @@ tmg_cpp_verbatim_snippet_2texmacs (tmscm arg1, tmscm arg2, tmscm arg3) {
 
 tmscm
 tmg_cpp_verbatim_2texmacs (tmscm arg1, tmscm arg2, tmscm arg3) {
+  PROFILE_TALLY ("glue cpp-verbatim->texmacs");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "cpp-verbatim->texmacs");
   TMSCM_ASSERT_BOOL (arg2, TMSCM_ARG2, "cpp-verbatim->texmacs");
   TMSCM_ASSERT_STRING (arg3, TMSCM_ARG3, "cpp-verbatim->texmacs");
@@ -5904,6 +6499,7 @@ tmg_cpp_verbatim_2texmacs (tmscm arg1, tmscm arg2, tmscm arg3) {
 
 tmscm
 tmg_parse_latex (tmscm arg1) {
+  PROFILE_TALLY ("glue parse-latex");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "parse-latex");
 
   string in1= tmscm_to_string (arg1);
@@ -5917,6 +6513,7 @@ tmg_parse_latex (tmscm arg1) {
 
 tmscm
 tmg_parse_latex_document (tmscm arg1) {
+  PROFILE_TALLY ("glue parse-latex-document");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "parse-latex-document");
 
   string in1= tmscm_to_string (arg1);
@@ -5930,6 +6527,7 @@ tmg_parse_latex_document (tmscm arg1) {
 
 tmscm
 tmg_latex_2texmacs (tmscm arg1) {
+  PROFILE_TALLY ("glue latex->texmacs");
   TMSCM_ASSERT_TREE (arg1, TMSCM_ARG1, "latex->texmacs");
 
   tree in1= tmscm_to_tree (arg1);
@@ -5943,6 +6541,7 @@ tmg_latex_2texmacs (tmscm arg1) {
 
 tmscm
 tmg_cpp_latex_document_2texmacs (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue cpp-latex-document->texmacs");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "cpp-latex-document->texmacs");
   TMSCM_ASSERT_BOOL (arg2, TMSCM_ARG2, "cpp-latex-document->texmacs");
 
@@ -5958,6 +6557,7 @@ tmg_cpp_latex_document_2texmacs (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_latex_class_document_2texmacs (tmscm arg1) {
+  PROFILE_TALLY ("glue latex-class-document->texmacs");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "latex-class-document->texmacs");
 
   string in1= tmscm_to_string (arg1);
@@ -5971,6 +6571,7 @@ tmg_latex_class_document_2texmacs (tmscm arg1) {
 
 tmscm
 tmg_tracked_latex_2texmacs (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue tracked-latex->texmacs");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "tracked-latex->texmacs");
   TMSCM_ASSERT_BOOL (arg2, TMSCM_ARG2, "tracked-latex->texmacs");
 
@@ -5986,6 +6587,7 @@ tmg_tracked_latex_2texmacs (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_conservative_texmacs_2latex (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue conservative-texmacs->latex");
   TMSCM_ASSERT_CONTENT (arg1, TMSCM_ARG1, "conservative-texmacs->latex");
   TMSCM_ASSERT_OBJECT (arg2, TMSCM_ARG2, "conservative-texmacs->latex");
 
@@ -6001,6 +6603,7 @@ tmg_conservative_texmacs_2latex (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_tracked_texmacs_2latex (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue tracked-texmacs->latex");
   TMSCM_ASSERT_CONTENT (arg1, TMSCM_ARG1, "tracked-texmacs->latex");
   TMSCM_ASSERT_OBJECT (arg2, TMSCM_ARG2, "tracked-texmacs->latex");
 
@@ -6016,6 +6619,7 @@ tmg_tracked_texmacs_2latex (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_conservative_latex_2texmacs (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue conservative-latex->texmacs");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "conservative-latex->texmacs");
   TMSCM_ASSERT_BOOL (arg2, TMSCM_ARG2, "conservative-latex->texmacs");
 
@@ -6031,6 +6635,7 @@ tmg_conservative_latex_2texmacs (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_get_line_number (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue get-line-number");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "get-line-number");
   TMSCM_ASSERT_INT (arg2, TMSCM_ARG2, "get-line-number");
 
@@ -6046,6 +6651,7 @@ tmg_get_line_number (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_get_column_number (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue get-column-number");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "get-column-number");
   TMSCM_ASSERT_INT (arg2, TMSCM_ARG2, "get-column-number");
 
@@ -6061,6 +6667,7 @@ tmg_get_column_number (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_try_latex_export (tmscm arg1, tmscm arg2, tmscm arg3, tmscm arg4) {
+  PROFILE_TALLY ("glue try-latex-export");
   TMSCM_ASSERT_CONTENT (arg1, TMSCM_ARG1, "try-latex-export");
   TMSCM_ASSERT_OBJECT (arg2, TMSCM_ARG2, "try-latex-export");
   TMSCM_ASSERT_URL (arg3, TMSCM_ARG3, "try-latex-export");
@@ -6080,6 +6687,7 @@ tmg_try_latex_export (tmscm arg1, tmscm arg2, tmscm arg3, tmscm arg4) {
 
 tmscm
 tmg_parse_xml (tmscm arg1) {
+  PROFILE_TALLY ("glue parse-xml");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "parse-xml");
 
   string in1= tmscm_to_string (arg1);
@@ -6093,6 +6701,7 @@ tmg_parse_xml (tmscm arg1) {
 
 tmscm
 tmg_parse_html (tmscm arg1) {
+  PROFILE_TALLY ("glue parse-html");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "parse-html");
 
   string in1= tmscm_to_string (arg1);
@@ -6104,8 +6713,39 @@ tmg_parse_html (tmscm arg1) {
   return scheme_tree_to_tmscm (out);
 }
 
+tmscm
+tmg_cpp_serialize_html (tmscm arg1) {
+  PROFILE_TALLY ("glue cpp-serialize-html");
+  TMSCM_ASSERT_SCHEME_TREE (arg1, TMSCM_ARG1, "cpp-serialize-html");
+
+  scheme_tree in1= tmscm_to_scheme_tree (arg1);
+
+  // TMSCM_DEFER_INTS;
+  string out= serialize_html (in1);
+  // TMSCM_ALLOW_INTS;
+
+  return string_to_tmscm (out);
+}
+
+tmscm
+tmg_cpp_serialize_html_file (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue cpp-serialize-html-file");
+  TMSCM_ASSERT_SCHEME_TREE (arg1, TMSCM_ARG1, "cpp-serialize-html-file");
+  TMSCM_ASSERT_URL (arg2, TMSCM_ARG2, "cpp-serialize-html-file");
+
+  scheme_tree in1= tmscm_to_scheme_tree (arg1);
+  url in2= tmscm_to_url (arg2);
+
+  // TMSCM_DEFER_INTS;
+  bool out= serialize_html (in1, in2);
+  // TMSCM_ALLOW_INTS;
+
+  return bool_to_tmscm (out);
+}
+
 tmscm
 tmg_parse_bib (tmscm arg1) {
+  PROFILE_TALLY ("glue parse-bib");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "parse-bib");
 
   string in1= tmscm_to_string (arg1);
@@ -6119,6 +6759,7 @@ tmg_parse_bib (tmscm arg1) {
 
 tmscm
 tmg_conservative_bib_import (tmscm arg1, tmscm arg2, tmscm arg3) {
+  PROFILE_TALLY ("glue conservative-bib-import");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "conservative-bib-import");
   TMSCM_ASSERT_CONTENT (arg2, TMSCM_ARG2, "conservative-bib-import");
   TMSCM_ASSERT_STRING (arg3, TMSCM_ARG3, "conservative-bib-import");
@@ -6136,6 +6777,7 @@ tmg_conservative_bib_import (tmscm arg1, tmscm arg2, tmscm arg3) {
 
 tmscm
 tmg_conservative_bib_export (tmscm arg1, tmscm arg2, tmscm arg3) {
+  PROFILE_TALLY ("glue conservative-bib-export");
   TMSCM_ASSERT_CONTENT (arg1, TMSCM_ARG1, "conservative-bib-export");
   TMSCM_ASSERT_STRING (arg2, TMSCM_ARG2, "conservative-bib-export");
   TMSCM_ASSERT_CONTENT (arg3, TMSCM_ARG3, "conservative-bib-export");
@@ -6153,6 +6795,7 @@ tmg_conservative_bib_export (tmscm arg1, tmscm arg2, tmscm arg3) {
 
 tmscm
 tmg_clean_html (tmscm arg1) {
+  PROFILE_TALLY ("glue clean-html");
   TMSCM_ASSERT_CONTENT (arg1, TMSCM_ARG1, "clean-html");
 
   content in1= tmscm_to_content (arg1);
@@ -6166,6 +6809,7 @@ tmg_clean_html (tmscm arg1) {
 
 tmscm
 tmg_upgrade_tmml (tmscm arg1) {
+  PROFILE_TALLY ("glue upgrade-tmml");
   TMSCM_ASSERT_SCHEME_TREE (arg1, TMSCM_ARG1, "upgrade-tmml");
 
   scheme_tree in1= tmscm_to_scheme_tree (arg1);
@@ -6179,6 +6823,7 @@ tmg_upgrade_tmml (tmscm arg1) {
 
 tmscm
 tmg_upgrade_mathml (tmscm arg1) {
+  PROFILE_TALLY ("glue upgrade-mathml");
   TMSCM_ASSERT_CONTENT (arg1, TMSCM_ARG1, "upgrade-mathml");
 
   content in1= tmscm_to_content (arg1);
@@ -6192,6 +6837,7 @@ tmg_upgrade_mathml (tmscm arg1) {
 
 tmscm
 tmg_retrieve_mathjax (tmscm arg1) {
+  PROFILE_TALLY ("glue retrieve-mathjax");
   TMSCM_ASSERT_INT (arg1, TMSCM_ARG1, "retrieve-mathjax");
 
   int in1= tmscm_to_int (arg1);
@@ -6205,6 +6851,7 @@ tmg_retrieve_mathjax (tmscm arg1) {
 
 tmscm
 tmg_vernac_2texmacs (tmscm arg1) {
+  PROFILE_TALLY ("glue vernac->texmacs");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "vernac->texmacs");
 
   string in1= tmscm_to_string (arg1);
@@ -6218,6 +6865,7 @@ tmg_vernac_2texmacs (tmscm arg1) {
 
 tmscm
 tmg_vernac_document_2texmacs (tmscm arg1) {
+  PROFILE_TALLY ("glue vernac-document->texmacs");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "vernac-document->texmacs");
 
   string in1= tmscm_to_string (arg1);
@@ -6231,6 +6879,7 @@ tmg_vernac_document_2texmacs (tmscm arg1) {
 
 tmscm
 tmg_compute_keys_string (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue compute-keys-string");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "compute-keys-string");
   TMSCM_ASSERT_STRING (arg2, TMSCM_ARG2, "compute-keys-string");
 
@@ -6246,6 +6895,7 @@ tmg_compute_keys_string (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_compute_keys_tree (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue compute-keys-tree");
   TMSCM_ASSERT_CONTENT (arg1, TMSCM_ARG1, "compute-keys-tree");
   TMSCM_ASSERT_STRING (arg2, TMSCM_ARG2, "compute-keys-tree");
 
@@ -6261,6 +6911,7 @@ tmg_compute_keys_tree (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_compute_keys_url (tmscm arg1) {
+  PROFILE_TALLY ("glue compute-keys-url");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "compute-keys-url");
 
   url in1= tmscm_to_url (arg1);
@@ -6274,6 +6925,7 @@ tmg_compute_keys_url (tmscm arg1) {
 
 tmscm
 tmg_compute_index_string (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue compute-index-string");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "compute-index-string");
   TMSCM_ASSERT_STRING (arg2, TMSCM_ARG2, "compute-index-string");
 
@@ -6289,6 +6941,7 @@ tmg_compute_index_string (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_compute_index_tree (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue compute-index-tree");
   TMSCM_ASSERT_CONTENT (arg1, TMSCM_ARG1, "compute-index-tree");
   TMSCM_ASSERT_STRING (arg2, TMSCM_ARG2, "compute-index-tree");
 
@@ -6304,6 +6957,7 @@ tmg_compute_index_tree (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_compute_index_url (tmscm arg1) {
+  PROFILE_TALLY ("glue compute-index-url");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "compute-index-url");
 
   url in1= tmscm_to_url (arg1);
@@ -6317,6 +6971,7 @@ tmg_compute_index_url (tmscm arg1) {
 
 tmscm
 tmg_url_2url (tmscm arg1) {
+  PROFILE_TALLY ("glue url->url");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "url->url");
 
   url in1= tmscm_to_url (arg1);
@@ -6330,6 +6985,7 @@ tmg_url_2url (tmscm arg1) {
 
 tmscm
 tmg_root_2url (tmscm arg1) {
+  PROFILE_TALLY ("glue root->url");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "root->url");
 
   string in1= tmscm_to_string (arg1);
@@ -6343,6 +6999,7 @@ tmg_root_2url (tmscm arg1) {
 
 tmscm
 tmg_string_2url (tmscm arg1) {
+  PROFILE_TALLY ("glue string->url");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "string->url");
 
   string in1= tmscm_to_string (arg1);
@@ -6356,6 +7013,7 @@ tmg_string_2url (tmscm arg1) {
 
 tmscm
 tmg_url_2string (tmscm arg1) {
+  PROFILE_TALLY ("glue url->string");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "url->string");
 
   url in1= tmscm_to_url (arg1);
@@ -6369,6 +7027,7 @@ tmg_url_2string (tmscm arg1) {
 
 tmscm
 tmg_url_2stree (tmscm arg1) {
+  PROFILE_TALLY ("glue url->stree");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "url->stree");
 
   url in1= tmscm_to_url (arg1);
@@ -6382,6 +7041,7 @@ tmg_url_2stree (tmscm arg1) {
 
 tmscm
 tmg_system_2url (tmscm arg1) {
+  PROFILE_TALLY ("glue system->url");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "system->url");
 
   string in1= tmscm_to_string (arg1);
@@ -6395,6 +7055,7 @@ tmg_system_2url (tmscm arg1) {
 
 tmscm
 tmg_url_2system (tmscm arg1) {
+  PROFILE_TALLY ("glue url->system");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "url->system");
 
   url in1= tmscm_to_url (arg1);
@@ -6408,6 +7069,7 @@ tmg_url_2system (tmscm arg1) {
 
 tmscm
 tmg_unix_2url (tmscm arg1) {
+  PROFILE_TALLY ("glue unix->url");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "unix->url");
 
   string in1= tmscm_to_string (arg1);
@@ -6421,6 +7083,7 @@ tmg_unix_2url (tmscm arg1) {
 
 tmscm
 tmg_url_2unix (tmscm arg1) {
+  PROFILE_TALLY ("glue url->unix");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "url->unix");
 
   url in1= tmscm_to_url (arg1);
@@ -6434,6 +7097,7 @@ tmg_url_2unix (tmscm arg1) {
 
 tmscm
 tmg_url_unix (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue url-unix");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "url-unix");
   TMSCM_ASSERT_STRING (arg2, TMSCM_ARG2, "url-unix");
 
@@ -6449,6 +7113,7 @@ tmg_url_unix (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_url_none () {
+  PROFILE_TALLY ("glue url-none");
   // TMSCM_DEFER_INTS;
   url out= url_none ();
   // TMSCM_ALLOW_INTS;
@@ -6458,6 +7123,7 @@ tmg_url_none () {
 
 tmscm
 tmg_url_any () {
+  PROFILE_TALLY ("glue url-any");
   // TMSCM_DEFER_INTS;
   url out= url_wildcard ();
   // TMSCM_ALLOW_INTS;
@@ -6467,6 +7133,7 @@ tmg_url_any () {
 
 tmscm
 tmg_url_wildcard (tmscm arg1) {
+  PROFILE_TALLY ("glue url-wildcard");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "url-wildcard");
 
   string in1= tmscm_to_string (arg1);
@@ -6480,6 +7147,7 @@ tmg_url_wildcard (tmscm arg1) {
 
 tmscm
 tmg_url_pwd () {
+  PROFILE_TALLY ("glue url-pwd");
   // TMSCM_DEFER_INTS;
   url out= url_pwd ();
   // TMSCM_ALLOW_INTS;
@@ -6489,6 +7157,7 @@ tmg_url_pwd () {
 
 tmscm
 tmg_url_parent () {
+  PROFILE_TALLY ("glue url-parent");
   // TMSCM_DEFER_INTS;
   url out= url_parent ();
   // TMSCM_ALLOW_INTS;
@@ -6498,6 +7167,7 @@ tmg_url_parent () {
 
 tmscm
 tmg_url_ancestor () {
+  PROFILE_TALLY ("glue url-ancestor");
   // TMSCM_DEFER_INTS;
   url out= url_ancestor ();
   // TMSCM_ALLOW_INTS;
@@ -6507,6 +7177,7 @@ tmg_url_ancestor () {
 
 tmscm
 tmg_url_append (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue url-append");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "url-append");
   TMSCM_ASSERT_URL (arg2, TMSCM_ARG2, "url-append");
 
@@ -6522,6 +7193,7 @@ tmg_url_append (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_url_or (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue url-or");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "url-or");
   TMSCM_ASSERT_URL (arg2, TMSCM_ARG2, "url-or");
 
@@ -6537,6 +7209,7 @@ tmg_url_or (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_url_noneP (tmscm arg1) {
+  PROFILE_TALLY ("glue url-none?");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "url-none?");
 
   url in1= tmscm_to_url (arg1);
@@ -6550,6 +7223,7 @@ tmg_url_noneP (tmscm arg1) {
 
 tmscm
 tmg_url_rootedP (tmscm arg1) {
+  PROFILE_TALLY ("glue url-rooted?");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "url-rooted?");
 
   url in1= tmscm_to_url (arg1);
@@ -6563,6 +7237,7 @@ tmg_url_rootedP (tmscm arg1) {
 
 tmscm
 tmg_url_rooted_protocolP (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue url-rooted-protocol?");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "url-rooted-protocol?");
   TMSCM_ASSERT_STRING (arg2, TMSCM_ARG2, "url-rooted-protocol?");
 
@@ -6578,6 +7253,7 @@ tmg_url_rooted_protocolP (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_url_rooted_webP (tmscm arg1) {
+  PROFILE_TALLY ("glue url-rooted-web?");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "url-rooted-web?");
 
   url in1= tmscm_to_url (arg1);
@@ -6591,6 +7267,7 @@ tmg_url_rooted_webP (tmscm arg1) {
 
 tmscm
 tmg_url_rooted_tmfsP (tmscm arg1) {
+  PROFILE_TALLY ("glue url-rooted-tmfs?");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "url-rooted-tmfs?");
 
   url in1= tmscm_to_url (arg1);
@@ -6604,6 +7281,7 @@ tmg_url_rooted_tmfsP (tmscm arg1) {
 
 tmscm
 tmg_url_rooted_tmfs_protocolP (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue url-rooted-tmfs-protocol?");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "url-rooted-tmfs-protocol?");
   TMSCM_ASSERT_STRING (arg2, TMSCM_ARG2, "url-rooted-tmfs-protocol?");
 
@@ -6619,6 +7297,7 @@ tmg_url_rooted_tmfs_protocolP (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_url_root (tmscm arg1) {
+  PROFILE_TALLY ("glue url-root");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "url-root");
 
   url in1= tmscm_to_url (arg1);
@@ -6632,6 +7311,7 @@ tmg_url_root (tmscm arg1) {
 
 tmscm
 tmg_url_unroot (tmscm arg1) {
+  PROFILE_TALLY ("glue url-unroot");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "url-unroot");
 
   url in1= tmscm_to_url (arg1);
@@ -6645,6 +7325,7 @@ tmg_url_unroot (tmscm arg1) {
 
 tmscm
 tmg_url_atomicP (tmscm arg1) {
+  PROFILE_TALLY ("glue url-atomic?");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "url-atomic?");
 
   url in1= tmscm_to_url (arg1);
@@ -6658,6 +7339,7 @@ tmg_url_atomicP (tmscm arg1) {
 
 tmscm
 tmg_url_concatP (tmscm arg1) {
+  PROFILE_TALLY ("glue url-concat?");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "url-concat?");
 
   url in1= tmscm_to_url (arg1);
@@ -6671,6 +7353,7 @@ tmg_url_concatP (tmscm arg1) {
 
 tmscm
 tmg_url_orP (tmscm arg1) {
+  PROFILE_TALLY ("glue url-or?");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "url-or?");
 
   url in1= tmscm_to_url (arg1);
@@ -6684,6 +7367,7 @@ tmg_url_orP (tmscm arg1) {
 
 tmscm
 tmg_url_ref (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue url-ref");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "url-ref");
   TMSCM_ASSERT_INT (arg2, TMSCM_ARG2, "url-ref");
 
@@ -6699,6 +7383,7 @@ tmg_url_ref (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_url_head (tmscm arg1) {
+  PROFILE_TALLY ("glue url-head");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "url-head");
 
   url in1= tmscm_to_url (arg1);
@@ -6712,6 +7397,7 @@ tmg_url_head (tmscm arg1) {
 
 tmscm
 tmg_url_tail (tmscm arg1) {
+  PROFILE_TALLY ("glue url-tail");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "url-tail");
 
   url in1= tmscm_to_url (arg1);
@@ -6725,6 +7411,7 @@ tmg_url_tail (tmscm arg1) {
 
 tmscm
 tmg_url_format (tmscm arg1) {
+  PROFILE_TALLY ("glue url-format");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "url-format");
 
   url in1= tmscm_to_url (arg1);
@@ -6738,6 +7425,7 @@ tmg_url_format (tmscm arg1) {
 
 tmscm
 tmg_url_suffix (tmscm arg1) {
+  PROFILE_TALLY ("glue url-suffix");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "url-suffix");
 
   url in1= tmscm_to_url (arg1);
@@ -6751,6 +7439,7 @@ tmg_url_suffix (tmscm arg1) {
 
 tmscm
 tmg_url_basename (tmscm arg1) {
+  PROFILE_TALLY ("glue url-basename");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "url-basename");
 
   url in1= tmscm_to_url (arg1);
@@ -6764,6 +7453,7 @@ tmg_url_basename (tmscm arg1) {
 
 tmscm
 tmg_url_glue (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue url-glue");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "url-glue");
   TMSCM_ASSERT_STRING (arg2, TMSCM_ARG2, "url-glue");
 
@@ -6779,6 +7469,7 @@ tmg_url_glue (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_url_unglue (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue url-unglue");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "url-unglue");
   TMSCM_ASSERT_INT (arg2, TMSCM_ARG2, "url-unglue");
 
@@ -6794,6 +7485,7 @@ tmg_url_unglue (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_url_relative (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue url-relative");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "url-relative");
   TMSCM_ASSERT_URL (arg2, TMSCM_ARG2, "url-relative");
 
@@ -6809,6 +7501,7 @@ tmg_url_relative (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_url_expand (tmscm arg1) {
+  PROFILE_TALLY ("glue url-expand");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "url-expand");
 
   url in1= tmscm_to_url (arg1);
@@ -6822,6 +7515,7 @@ tmg_url_expand (tmscm arg1) {
 
 tmscm
 tmg_url_factor (tmscm arg1) {
+  PROFILE_TALLY ("glue url-factor");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "url-factor");
 
   url in1= tmscm_to_url (arg1);
@@ -6835,6 +7529,7 @@ tmg_url_factor (tmscm arg1) {
 
 tmscm
 tmg_url_delta (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue url-delta");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "url-delta");
   TMSCM_ASSERT_URL (arg2, TMSCM_ARG2, "url-delta");
 
@@ -6850,6 +7545,7 @@ tmg_url_delta (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_url_secureP (tmscm arg1) {
+  PROFILE_TALLY ("glue url-secure?");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "url-secure?");
 
   url in1= tmscm_to_url (arg1);
@@ -6863,6 +7559,7 @@ tmg_url_secureP (tmscm arg1) {
 
 tmscm
 tmg_url_descendsP (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue url-descends?");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "url-descends?");
   TMSCM_ASSERT_URL (arg2, TMSCM_ARG2, "url-descends?");
 
@@ -6878,6 +7575,7 @@ tmg_url_descendsP (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_url_complete (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue url-complete");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "url-complete");
   TMSCM_ASSERT_STRING (arg2, TMSCM_ARG2, "url-complete");
 
@@ -6893,6 +7591,7 @@ tmg_url_complete (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_url_resolve (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue url-resolve");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "url-resolve");
   TMSCM_ASSERT_STRING (arg2, TMSCM_ARG2, "url-resolve");
 
@@ -6908,6 +7607,7 @@ tmg_url_resolve (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_url_resolve_in_path (tmscm arg1) {
+  PROFILE_TALLY ("glue url-resolve-in-path");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "url-resolve-in-path");
 
   url in1= tmscm_to_url (arg1);
@@ -6921,6 +7621,7 @@ tmg_url_resolve_in_path (tmscm arg1) {
 
 tmscm
 tmg_url_resolve_pattern (tmscm arg1) {
+  PROFILE_TALLY ("glue url-resolve-pattern");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "url-resolve-pattern");
 
   url in1= tmscm_to_url (arg1);
@@ -6934,6 +7635,7 @@ tmg_url_resolve_pattern (tmscm arg1) {
 
 tmscm
 tmg_url_existsP (tmscm arg1) {
+  PROFILE_TALLY ("glue url-exists?");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "url-exists?");
 
   url in1= tmscm_to_url (arg1);
@@ -6947,6 +7649,7 @@ tmg_url_existsP (tmscm arg1) {
 
 tmscm
 tmg_url_exists_in_pathP (tmscm arg1) {
+  PROFILE_TALLY ("glue url-exists-in-path?");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "url-exists-in-path?");
 
   url in1= tmscm_to_url (arg1);
@@ -6960,6 +7663,7 @@ tmg_url_exists_in_pathP (tmscm arg1) {
 
 tmscm
 tmg_url_exists_in_texP (tmscm arg1) {
+  PROFILE_TALLY ("glue url-exists-in-tex?");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "url-exists-in-tex?");
 
   url in1= tmscm_to_url (arg1);
@@ -6973,6 +7677,7 @@ tmg_url_exists_in_texP (tmscm arg1) {
 
 tmscm
 tmg_url_concretize_dot (tmscm arg1) {
+  PROFILE_TALLY ("glue url-concretize*");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "url-concretize*");
 
   url in1= tmscm_to_url (arg1);
@@ -6986,6 +7691,7 @@ tmg_url_concretize_dot (tmscm arg1) {
 
 tmscm
 tmg_url_concretize (tmscm arg1) {
+  PROFILE_TALLY ("glue url-concretize");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "url-concretize");
 
   url in1= tmscm_to_url (arg1);
@@ -6999,6 +7705,7 @@ tmg_url_concretize (tmscm arg1) {
 
 tmscm
 tmg_url_materialize (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue url-materialize");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "url-materialize");
   TMSCM_ASSERT_STRING (arg2, TMSCM_ARG2, "url-materialize");
 
@@ -7014,6 +7721,7 @@ tmg_url_materialize (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_url_testP (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue url-test?");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "url-test?");
   TMSCM_ASSERT_STRING (arg2, TMSCM_ARG2, "url-test?");
 
@@ -7029,6 +7737,7 @@ tmg_url_testP (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_url_regularP (tmscm arg1) {
+  PROFILE_TALLY ("glue url-regular?");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "url-regular?");
 
   url in1= tmscm_to_url (arg1);
@@ -7042,6 +7751,7 @@ tmg_url_regularP (tmscm arg1) {
 
 tmscm
 tmg_url_directoryP (tmscm arg1) {
+  PROFILE_TALLY ("glue url-directory?");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "url-directory?");
 
   url in1= tmscm_to_url (arg1);
@@ -7055,6 +7765,7 @@ tmg_url_directoryP (tmscm arg1) {
 
 tmscm
 tmg_url_linkP (tmscm arg1) {
+  PROFILE_TALLY ("glue url-link?");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "url-link?");
 
   url in1= tmscm_to_url (arg1);
@@ -7068,6 +7779,7 @@ tmg_url_linkP (tmscm arg1) {
 
 tmscm
 tmg_url_newerP (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue url-newer?");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "url-newer?");
   TMSCM_ASSERT_URL (arg2, TMSCM_ARG2, "url-newer?");
 
@@ -7083,6 +7795,7 @@ tmg_url_newerP (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_url_size (tmscm arg1) {
+  PROFILE_TALLY ("glue url-size");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "url-size");
 
   url in1= tmscm_to_url (arg1);
@@ -7096,6 +7809,7 @@ tmg_url_size (tmscm arg1) {
 
 tmscm
 tmg_url_last_modified (tmscm arg1) {
+  PROFILE_TALLY ("glue url-last-modified");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "url-last-modified");
 
   url in1= tmscm_to_url (arg1);
@@ -7109,6 +7823,7 @@ tmg_url_last_modified (tmscm arg1) {
 
 tmscm
 tmg_url_temp () {
+  PROFILE_TALLY ("glue url-temp");
   // TMSCM_DEFER_INTS;
   url out= url_temp ();
   // TMSCM_ALLOW_INTS;
@@ -7118,6 +7833,7 @@ tmg_url_temp () {
 
 tmscm
 tmg_url_scratch (tmscm arg1, tmscm arg2, tmscm arg3) {
+  PROFILE_TALLY ("glue url-scratch");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "url-scratch");
   TMSCM_ASSERT_STRING (arg2, TMSCM_ARG2, "url-scratch");
   TMSCM_ASSERT_INT (arg3, TMSCM_ARG3, "url-scratch");
@@ -7135,6 +7851,7 @@ tmg_url_scratch (tmscm arg1, tmscm arg2, tmscm arg3) {
 
 tmscm
 tmg_url_scratchP (tmscm arg1) {
+  PROFILE_TALLY ("glue url-scratch?");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "url-scratch?");
 
   url in1= tmscm_to_url (arg1);
@@ -7148,6 +7865,7 @@ tmg_url_scratchP (tmscm arg1) {
 
 tmscm
 tmg_url_cache_invalidate (tmscm arg1) {
+  PROFILE_TALLY ("glue url-cache-invalidate");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "url-cache-invalidate");
 
   url in1= tmscm_to_url (arg1);
@@ -7159,8 +7877,25 @@ tmg_url_cache_invalidate (tmscm arg1) {
   return TMSCM_UNSPECIFIED;
 }
 
+tmscm
+tmg_url_prefetch (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue url-prefetch");
+  TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "url-prefetch");
+  TMSCM_ASSERT_COMMAND (arg2, TMSCM_ARG2, "url-prefetch");
+
+  url in1= tmscm_to_url (arg1);
+  command in2= tmscm_to_command (arg2);
+
+  // TMSCM_DEFER_INTS;
+  web_prefetch (in1, in2);
+  // TMSCM_ALLOW_INTS;
+
+  return TMSCM_UNSPECIFIED;
+}
+
 tmscm
 tmg_string_save (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue string-save");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "string-save");
   TMSCM_ASSERT_URL (arg2, TMSCM_ARG2, "string-save");
 
@@ -7176,6 +7911,7 @@ tmg_string_save (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_string_load (tmscm arg1) {
+  PROFILE_TALLY ("glue string-load");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "string-load");
 
   url in1= tmscm_to_url (arg1);
@@ -7189,6 +7925,7 @@ tmg_string_load (tmscm arg1) {
 
 tmscm
 tmg_string_append_to_file (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue string-append-to-file");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "string-append-to-file");
   TMSCM_ASSERT_URL (arg2, TMSCM_ARG2, "string-append-to-file");
 
@@ -7204,6 +7941,7 @@ tmg_string_append_to_file (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_system_move (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue system-move");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "system-move");
   TMSCM_ASSERT_URL (arg2, TMSCM_ARG2, "system-move");
 
@@ -7219,6 +7957,7 @@ tmg_system_move (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_system_copy (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue system-copy");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "system-copy");
   TMSCM_ASSERT_URL (arg2, TMSCM_ARG2, "system-copy");
 
@@ -7234,6 +7973,7 @@ tmg_system_copy (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_system_remove (tmscm arg1) {
+  PROFILE_TALLY ("glue system-remove");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "system-remove");
 
   url in1= tmscm_to_url (arg1);
@@ -7247,6 +7987,7 @@ tmg_system_remove (tmscm arg1) {
 
 tmscm
 tmg_system_mkdir (tmscm arg1) {
+  PROFILE_TALLY ("glue system-mkdir");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "system-mkdir");
 
   url in1= tmscm_to_url (arg1);
@@ -7260,6 +8001,7 @@ tmg_system_mkdir (tmscm arg1) {
 
 tmscm
 tmg_system_rmdir (tmscm arg1) {
+  PROFILE_TALLY ("glue system-rmdir");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "system-rmdir");
 
   url in1= tmscm_to_url (arg1);
@@ -7273,6 +8015,7 @@ tmg_system_rmdir (tmscm arg1) {
 
 tmscm
 tmg_system_search_score (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue system-search-score");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "system-search-score");
   TMSCM_ASSERT_ARRAY_STRING (arg2, TMSCM_ARG2, "system-search-score");
 
@@ -7286,8 +8029,25 @@ tmg_system_search_score (tmscm arg1, tmscm arg2) {
   return int_to_tmscm (out);
 }
 
+tmscm
+tmg_system_search_scores (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue system-search-scores");
+  TMSCM_ASSERT_ARRAY_URL (arg1, TMSCM_ARG1, "system-search-scores");
+  TMSCM_ASSERT_ARRAY_STRING (arg2, TMSCM_ARG2, "system-search-scores");
+
+  array_url in1= tmscm_to_array_url (arg1);
+  array_string in2= tmscm_to_array_string (arg2);
+
+  // TMSCM_DEFER_INTS;
+  array_int out= search_scores (in1, in2);
+  // TMSCM_ALLOW_INTS;
+
+  return array_int_to_tmscm (out);
+}
+
 tmscm
 tmg_system_1 (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue system-1");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "system-1");
   TMSCM_ASSERT_URL (arg2, TMSCM_ARG2, "system-1");
 
@@ -7303,6 +8063,7 @@ tmg_system_1 (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_system_2 (tmscm arg1, tmscm arg2, tmscm arg3) {
+  PROFILE_TALLY ("glue system-2");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "system-2");
   TMSCM_ASSERT_URL (arg2, TMSCM_ARG2, "system-2");
   TMSCM_ASSERT_URL (arg3, TMSCM_ARG3, "system-2");
@@ -7320,6 +8081,7 @@ tmg_system_2 (tmscm arg1, tmscm arg2, tmscm arg3) {
 
 tmscm
 tmg_system_url_2string (tmscm arg1) {
+  PROFILE_TALLY ("glue system-url->string");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "system-url->string");
 
   url in1= tmscm_to_url (arg1);
@@ -7333,6 +8095,7 @@ tmg_system_url_2string (tmscm arg1) {
 
 tmscm
 tmg_url_grep (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue url-grep");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "url-grep");
   TMSCM_ASSERT_URL (arg2, TMSCM_ARG2, "url-grep");
 
@@ -7348,6 +8111,7 @@ tmg_url_grep (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_url_search_upwards (tmscm arg1, tmscm arg2, tmscm arg3) {
+  PROFILE_TALLY ("glue url-search-upwards");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "url-search-upwards");
   TMSCM_ASSERT_STRING (arg2, TMSCM_ARG2, "url-search-upwards");
   TMSCM_ASSERT_ARRAY_STRING (arg3, TMSCM_ARG3, "url-search-upwards");
@@ -7365,6 +8129,7 @@ tmg_url_search_upwards (tmscm arg1, tmscm arg2, tmscm arg3) {
 
 tmscm
 tmg_picture_cache_reset () {
+  PROFILE_TALLY ("glue picture-cache-reset");
   // TMSCM_DEFER_INTS;
   picture_cache_reset ();
   // TMSCM_ALLOW_INTS;
@@ -7374,6 +8139,7 @@ tmg_picture_cache_reset () {
 
 tmscm
 tmg_persistent_set (tmscm arg1, tmscm arg2, tmscm arg3) {
+  PROFILE_TALLY ("glue persistent-set");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "persistent-set");
   TMSCM_ASSERT_STRING (arg2, TMSCM_ARG2, "persistent-set");
   TMSCM_ASSERT_STRING (arg3, TMSCM_ARG3, "persistent-set");
@@ -7391,6 +8157,7 @@ tmg_persistent_set (tmscm arg1, tmscm arg2, tmscm arg3) {
 
 tmscm
 tmg_persistent_remove (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue persistent-remove");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "persistent-remove");
   TMSCM_ASSERT_STRING (arg2, TMSCM_ARG2, "persistent-remove");
 
@@ -7406,6 +8173,7 @@ tmg_persistent_remove (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_persistent_hasP (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue persistent-has?");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "persistent-has?");
   TMSCM_ASSERT_STRING (arg2, TMSCM_ARG2, "persistent-has?");
 
@@ -7421,6 +8189,7 @@ tmg_persistent_hasP (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_persistent_get (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue persistent-get");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "persistent-get");
   TMSCM_ASSERT_STRING (arg2, TMSCM_ARG2, "persistent-get");
 
@@ -7436,6 +8205,7 @@ tmg_persistent_get (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_persistent_file_name (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue persistent-file-name");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "persistent-file-name");
   TMSCM_ASSERT_STRING (arg2, TMSCM_ARG2, "persistent-file-name");
 
@@ -7451,6 +8221,7 @@ tmg_persistent_file_name (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_tmdb_keep_history (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue tmdb-keep-history");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "tmdb-keep-history");
   TMSCM_ASSERT_BOOL (arg2, TMSCM_ARG2, "tmdb-keep-history");
 
@@ -7466,6 +8237,7 @@ tmg_tmdb_keep_history (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_tmdb_set_field (tmscm arg1, tmscm arg2, tmscm arg3, tmscm arg4, tmscm arg5) {
+  PROFILE_TALLY ("glue tmdb-set-field");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "tmdb-set-field");
   TMSCM_ASSERT_STRING (arg2, TMSCM_ARG2, "tmdb-set-field");
   TMSCM_ASSERT_STRING (arg3, TMSCM_ARG3, "tmdb-set-field");
@@ -7487,6 +8259,7 @@ tmg_tmdb_set_field (tmscm arg1, tmscm arg2, tmscm arg3, tmscm arg4, tmscm arg5)
 
 tmscm
 tmg_tmdb_get_field (tmscm arg1, tmscm arg2, tmscm arg3, tmscm arg4) {
+  PROFILE_TALLY ("glue tmdb-get-field");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "tmdb-get-field");
   TMSCM_ASSERT_STRING (arg2, TMSCM_ARG2, "tmdb-get-field");
   TMSCM_ASSERT_STRING (arg3, TMSCM_ARG3, "tmdb-get-field");
@@ -7506,6 +8279,7 @@ tmg_tmdb_get_field (tmscm arg1, tmscm arg2, tmscm arg3, tmscm arg4) {
 
 tmscm
 tmg_tmdb_remove_field (tmscm arg1, tmscm arg2, tmscm arg3, tmscm arg4) {
+  PROFILE_TALLY ("glue tmdb-remove-field");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "tmdb-remove-field");
   TMSCM_ASSERT_STRING (arg2, TMSCM_ARG2, "tmdb-remove-field");
   TMSCM_ASSERT_STRING (arg3, TMSCM_ARG3, "tmdb-remove-field");
@@ -7525,6 +8299,7 @@ tmg_tmdb_remove_field (tmscm arg1, tmscm arg2, tmscm arg3, tmscm arg4) {
 
 tmscm
 tmg_tmdb_get_attributes (tmscm arg1, tmscm arg2, tmscm arg3) {
+  PROFILE_TALLY ("glue tmdb-get-attributes");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "tmdb-get-attributes");
   TMSCM_ASSERT_STRING (arg2, TMSCM_ARG2, "tmdb-get-attributes");
   TMSCM_ASSERT_DOUBLE (arg3, TMSCM_ARG3, "tmdb-get-attributes");
@@ -7542,6 +8317,7 @@ tmg_tmdb_get_attributes (tmscm arg1, tmscm arg2, tmscm arg3) {
 
 tmscm
 tmg_tmdb_set_entry (tmscm arg1, tmscm arg2, tmscm arg3, tmscm arg4) {
+  PROFILE_TALLY ("glue tmdb-set-entry");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "tmdb-set-entry");
   TMSCM_ASSERT_STRING (arg2, TMSCM_ARG2, "tmdb-set-entry");
   TMSCM_ASSERT_SCHEME_TREE (arg3, TMSCM_ARG3, "tmdb-set-entry");
@@ -7561,6 +8337,7 @@ tmg_tmdb_set_entry (tmscm arg1, tmscm arg2, tmscm arg3, tmscm arg4) {
 
 tmscm
 tmg_tmdb_get_entry (tmscm arg1, tmscm arg2, tmscm arg3) {
+  PROFILE_TALLY ("glue tmdb-get-entry");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "tmdb-get-entry");
   TMSCM_ASSERT_STRING (arg2, TMSCM_ARG2, "tmdb-get-entry");
   TMSCM_ASSERT_DOUBLE (arg3, TMSCM_ARG3, "tmdb-get-entry");
@@ -7578,6 +8355,7 @@ tmg_tmdb_get_entry (tmscm arg1, tmscm arg2, tmscm arg3) {
 
 tmscm
 tmg_tmdb_remove_entry (tmscm arg1, tmscm arg2, tmscm arg3) {
+  PROFILE_TALLY ("glue tmdb-remove-entry");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "tmdb-remove-entry");
   TMSCM_ASSERT_STRING (arg2, TMSCM_ARG2, "tmdb-remove-entry");
   TMSCM_ASSERT_DOUBLE (arg3, TMSCM_ARG3, "tmdb-remove-entry");
@@ -7595,6 +8373,7 @@ tmg_tmdb_remove_entry (tmscm arg1, tmscm arg2, tmscm arg3) {
 
 tmscm
 tmg_tmdb_query (tmscm arg1, tmscm arg2, tmscm arg3, tmscm arg4) {
+  PROFILE_TALLY ("glue tmdb-query");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "tmdb-query");
   TMSCM_ASSERT_SCHEME_TREE (arg2, TMSCM_ARG2, "tmdb-query");
   TMSCM_ASSERT_DOUBLE (arg3, TMSCM_ARG3, "tmdb-query");
@@ -7614,6 +8393,7 @@ tmg_tmdb_query (tmscm arg1, tmscm arg2, tmscm arg3, tmscm arg4) {
 
 tmscm
 tmg_tmdb_inspect_history (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue tmdb-inspect-history");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "tmdb-inspect-history");
   TMSCM_ASSERT_STRING (arg2, TMSCM_ARG2, "tmdb-inspect-history");
 
@@ -7629,6 +8409,7 @@ tmg_tmdb_inspect_history (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_tmdb_get_completions (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue tmdb-get-completions");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "tmdb-get-completions");
   TMSCM_ASSERT_STRING (arg2, TMSCM_ARG2, "tmdb-get-completions");
 
@@ -7644,6 +8425,7 @@ tmg_tmdb_get_completions (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_tmdb_get_name_completions (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue tmdb-get-name-completions");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "tmdb-get-name-completions");
   TMSCM_ASSERT_STRING (arg2, TMSCM_ARG2, "tmdb-get-name-completions");
 
@@ -7659,6 +8441,7 @@ tmg_tmdb_get_name_completions (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_supports_sqlP () {
+  PROFILE_TALLY ("glue supports-sql?");
   // TMSCM_DEFER_INTS;
   bool out= sqlite3_present ();
   // TMSCM_ALLOW_INTS;
@@ -7668,6 +8451,7 @@ tmg_supports_sqlP () {
 
 tmscm
 tmg_sql_exec (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue sql-exec");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "sql-exec");
   TMSCM_ASSERT_STRING (arg2, TMSCM_ARG2, "sql-exec");
 
@@ -7681,8 +8465,25 @@ tmg_sql_exec (tmscm arg1, tmscm arg2) {
   return scheme_tree_to_tmscm (out);
 }
 
+tmscm
+tmg_sql_exec_all (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue sql-exec-all");
+  TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "sql-exec-all");
+  TMSCM_ASSERT_ARRAY_STRING (arg2, TMSCM_ARG2, "sql-exec-all");
+
+  url in1= tmscm_to_url (arg1);
+  array_string in2= tmscm_to_array_string (arg2);
+
+  // TMSCM_DEFER_INTS;
+  scheme_tree out= sql_exec_all (in1, in2);
+  // TMSCM_ALLOW_INTS;
+
+  return scheme_tree_to_tmscm (out);
+}
+
 tmscm
 tmg_sql_quote (tmscm arg1) {
+  PROFILE_TALLY ("glue sql-quote");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "sql-quote");
 
   string in1= tmscm_to_string (arg1);
@@ -7696,6 +8497,7 @@ tmg_sql_quote (tmscm arg1) {
 
 tmscm
 tmg_server_start () {
+  PROFILE_TALLY ("glue server-start");
   // TMSCM_DEFER_INTS;
   server_start ();
   // TMSCM_ALLOW_INTS;
@@ -7705,6 +8507,7 @@ tmg_server_start () {
 
 tmscm
 tmg_server_stop () {
+  PROFILE_TALLY ("glue server-stop");
   // TMSCM_DEFER_INTS;
   server_stop ();
   // TMSCM_ALLOW_INTS;
@@ -7714,6 +8517,7 @@ tmg_server_stop () {
 
 tmscm
 tmg_server_read (tmscm arg1) {
+  PROFILE_TALLY ("glue server-read");
   TMSCM_ASSERT_INT (arg1, TMSCM_ARG1, "server-read");
 
   int in1= tmscm_to_int (arg1);
@@ -7727,6 +8531,7 @@ tmg_server_read (tmscm arg1) {
 
 tmscm
 tmg_server_write (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue server-write");
   TMSCM_ASSERT_INT (arg1, TMSCM_ARG1, "server-write");
   TMSCM_ASSERT_STRING (arg2, TMSCM_ARG2, "server-write");
 
@@ -7742,6 +8547,7 @@ tmg_server_write (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_server_startedP () {
+  PROFILE_TALLY ("glue server-started?");
   // TMSCM_DEFER_INTS;
   bool out= server_started ();
   // TMSCM_ALLOW_INTS;
@@ -7751,6 +8557,7 @@ tmg_server_startedP () {
 
 tmscm
 tmg_client_start (tmscm arg1) {
+  PROFILE_TALLY ("glue client-start");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "client-start");
 
   string in1= tmscm_to_string (arg1);
@@ -7764,6 +8571,7 @@ tmg_client_start (tmscm arg1) {
 
 tmscm
 tmg_client_stop (tmscm arg1) {
+  PROFILE_TALLY ("glue client-stop");
   TMSCM_ASSERT_INT (arg1, TMSCM_ARG1, "client-stop");
 
   int in1= tmscm_to_int (arg1);
@@ -7777,6 +8585,7 @@ tmg_client_stop (tmscm arg1) {
 
 tmscm
 tmg_client_read (tmscm arg1) {
+  PROFILE_TALLY ("glue client-read");
   TMSCM_ASSERT_INT (arg1, TMSCM_ARG1, "client-read");
 
   int in1= tmscm_to_int (arg1);
@@ -7790,6 +8599,7 @@ tmg_client_read (tmscm arg1) {
 
 tmscm
 tmg_client_write (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue client-write");
   TMSCM_ASSERT_INT (arg1, TMSCM_ARG1, "client-write");
   TMSCM_ASSERT_STRING (arg2, TMSCM_ARG2, "client-write");
 
@@ -7805,6 +8615,7 @@ tmg_client_write (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_enter_secure_mode (tmscm arg1) {
+  PROFILE_TALLY ("glue enter-secure-mode");
   TMSCM_ASSERT_INT (arg1, TMSCM_ARG1, "enter-secure-mode");
 
   int in1= tmscm_to_int (arg1);
@@ -7818,6 +8629,7 @@ tmg_enter_secure_mode (tmscm arg1) {
 
 tmscm
 tmg_connection_start (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue connection-start");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "connection-start");
   TMSCM_ASSERT_STRING (arg2, TMSCM_ARG2, "connection-start");
 
@@ -7833,6 +8645,7 @@ tmg_connection_start (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_connection_status (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue connection-status");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "connection-status");
   TMSCM_ASSERT_STRING (arg2, TMSCM_ARG2, "connection-status");
 
@@ -7848,6 +8661,7 @@ tmg_connection_status (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_connection_write_string (tmscm arg1, tmscm arg2, tmscm arg3) {
+  PROFILE_TALLY ("glue connection-write-string");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "connection-write-string");
   TMSCM_ASSERT_STRING (arg2, TMSCM_ARG2, "connection-write-string");
   TMSCM_ASSERT_STRING (arg3, TMSCM_ARG3, "connection-write-string");
@@ -7865,6 +8679,7 @@ tmg_connection_write_string (tmscm arg1, tmscm arg2, tmscm arg3) {
 
 tmscm
 tmg_connection_write (tmscm arg1, tmscm arg2, tmscm arg3) {
+  PROFILE_TALLY ("glue connection-write");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "connection-write");
   TMSCM_ASSERT_STRING (arg2, TMSCM_ARG2, "connection-write");
   TMSCM_ASSERT_CONTENT (arg3, TMSCM_ARG3, "connection-write");
@@ -7882,6 +8697,7 @@ tmg_connection_write (tmscm arg1, tmscm arg2, tmscm arg3) {
 
 tmscm
 tmg_connection_cmd (tmscm arg1, tmscm arg2, tmscm arg3) {
+  PROFILE_TALLY ("glue connection-cmd");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "connection-cmd");
   TMSCM_ASSERT_STRING (arg2, TMSCM_ARG2, "connection-cmd");
   TMSCM_ASSERT_STRING (arg3, TMSCM_ARG3, "connection-cmd");
@@ -7899,6 +8715,7 @@ tmg_connection_cmd (tmscm arg1, tmscm arg2, tmscm arg3) {
 
 tmscm
 tmg_connection_eval (tmscm arg1, tmscm arg2, tmscm arg3) {
+  PROFILE_TALLY ("glue connection-eval");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "connection-eval");
   TMSCM_ASSERT_STRING (arg2, TMSCM_ARG2, "connection-eval");
   TMSCM_ASSERT_CONTENT (arg3, TMSCM_ARG3, "connection-eval");
@@ -7916,6 +8733,7 @@ tmg_connection_eval (tmscm arg1, tmscm arg2, tmscm arg3) {
 
 tmscm
 tmg_connection_interrupt (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue connection-interrupt");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "connection-interrupt");
   TMSCM_ASSERT_STRING (arg2, TMSCM_ARG2, "connection-interrupt");
 
@@ -7931,6 +8749,7 @@ tmg_connection_interrupt (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_connection_stop (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue connection-stop");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "connection-stop");
   TMSCM_ASSERT_STRING (arg2, TMSCM_ARG2, "connection-stop");
 
@@ -7946,6 +8765,7 @@ tmg_connection_stop (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_widget_printer (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue widget-printer");
   TMSCM_ASSERT_COMMAND (arg1, TMSCM_ARG1, "widget-printer");
   TMSCM_ASSERT_URL (arg2, TMSCM_ARG2, "widget-printer");
 
@@ -7961,6 +8781,7 @@ tmg_widget_printer (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_widget_color_picker (tmscm arg1, tmscm arg2, tmscm arg3) {
+  PROFILE_TALLY ("glue widget-color-picker");
   TMSCM_ASSERT_COMMAND (arg1, TMSCM_ARG1, "widget-color-picker");
   TMSCM_ASSERT_BOOL (arg2, TMSCM_ARG2, "widget-color-picker");
   TMSCM_ASSERT_ARRAY_TREE (arg3, TMSCM_ARG3, "widget-color-picker");
@@ -7978,6 +8799,7 @@ tmg_widget_color_picker (tmscm arg1, tmscm arg2, tmscm arg3) {
 
 tmscm
 tmg_widget_extend (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue widget-extend");
   TMSCM_ASSERT_WIDGET (arg1, TMSCM_ARG1, "widget-extend");
   TMSCM_ASSERT_ARRAY_WIDGET (arg2, TMSCM_ARG2, "widget-extend");
 
@@ -7993,6 +8815,7 @@ tmg_widget_extend (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_widget_hmenu (tmscm arg1) {
+  PROFILE_TALLY ("glue widget-hmenu");
   TMSCM_ASSERT_ARRAY_WIDGET (arg1, TMSCM_ARG1, "widget-hmenu");
 
   array_widget in1= tmscm_to_array_widget (arg1);
@@ -8006,6 +8829,7 @@ tmg_widget_hmenu (tmscm arg1) {
 
 tmscm
 tmg_widget_vmenu (tmscm arg1) {
+  PROFILE_TALLY ("glue widget-vmenu");
   TMSCM_ASSERT_ARRAY_WIDGET (arg1, TMSCM_ARG1, "widget-vmenu");
 
   array_widget in1= tmscm_to_array_widget (arg1);
@@ -8019,6 +8843,7 @@ tmg_widget_vmenu (tmscm arg1) {
 
 tmscm
 tmg_widget_tmenu (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue widget-tmenu");
   TMSCM_ASSERT_ARRAY_WIDGET (arg1, TMSCM_ARG1, "widget-tmenu");
   TMSCM_ASSERT_INT (arg2, TMSCM_ARG2, "widget-tmenu");
 
@@ -8034,6 +8859,7 @@ tmg_widget_tmenu (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_widget_minibar_menu (tmscm arg1) {
+  PROFILE_TALLY ("glue widget-minibar-menu");
   TMSCM_ASSERT_ARRAY_WIDGET (arg1, TMSCM_ARG1, "widget-minibar-menu");
 
   array_widget in1= tmscm_to_array_widget (arg1);
@@ -8047,6 +8873,7 @@ tmg_widget_minibar_menu (tmscm arg1) {
 
 tmscm
 tmg_widget_separator (tmscm arg1) {
+  PROFILE_TALLY ("glue widget-separator");
   TMSCM_ASSERT_BOOL (arg1, TMSCM_ARG1, "widget-separator");
 
   bool in1= tmscm_to_bool (arg1);
@@ -8060,6 +8887,7 @@ tmg_widget_separator (tmscm arg1) {
 
 tmscm
 tmg_widget_menu_group (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue widget-menu-group");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "widget-menu-group");
   TMSCM_ASSERT_INT (arg2, TMSCM_ARG2, "widget-menu-group");
 
@@ -8075,6 +8903,7 @@ tmg_widget_menu_group (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_widget_pulldown_button (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue widget-pulldown-button");
   TMSCM_ASSERT_WIDGET (arg1, TMSCM_ARG1, "widget-pulldown-button");
   TMSCM_ASSERT_PROMISE_WIDGET (arg2, TMSCM_ARG2, "widget-pulldown-button");
 
@@ -8090,6 +8919,7 @@ tmg_widget_pulldown_button (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_widget_pullright_button (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue widget-pullright-button");
   TMSCM_ASSERT_WIDGET (arg1, TMSCM_ARG1, "widget-pullright-button");
   TMSCM_ASSERT_PROMISE_WIDGET (arg2, TMSCM_ARG2, "widget-pullright-button");
 
@@ -8105,6 +8935,7 @@ tmg_widget_pullright_button (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_widget_menu_button (tmscm arg1, tmscm arg2, tmscm arg3, tmscm arg4, tmscm arg5) {
+  PROFILE_TALLY ("glue widget-menu-button");
   TMSCM_ASSERT_WIDGET (arg1, TMSCM_ARG1, "widget-menu-button");
   TMSCM_ASSERT_COMMAND (arg2, TMSCM_ARG2, "widget-menu-button");
   TMSCM_ASSERT_STRING (arg3, TMSCM_ARG3, "widget-menu-button");
@@ -8126,6 +8957,7 @@ tmg_widget_menu_button (tmscm arg1, tmscm arg2, tmscm arg3, tmscm arg4, tmscm ar
 
 tmscm
 tmg_widget_toggle (tmscm arg1, tmscm arg2, tmscm arg3) {
+  PROFILE_TALLY ("glue widget-toggle");
   TMSCM_ASSERT_COMMAND (arg1, TMSCM_ARG1, "widget-toggle");
   TMSCM_ASSERT_BOOL (arg2, TMSCM_ARG2, "widget-toggle");
   TMSCM_ASSERT_INT (arg3, TMSCM_ARG3, "widget-toggle");
@@ -8143,6 +8975,7 @@ tmg_widget_toggle (tmscm arg1, tmscm arg2, tmscm arg3) {
 
 tmscm
 tmg_widget_balloon (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue widget-balloon");
   TMSCM_ASSERT_WIDGET (arg1, TMSCM_ARG1, "widget-balloon");
   TMSCM_ASSERT_WIDGET (arg2, TMSCM_ARG2, "widget-balloon");
 
@@ -8158,6 +8991,7 @@ tmg_widget_balloon (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_widget_empty () {
+  PROFILE_TALLY ("glue widget-empty");
   // TMSCM_DEFER_INTS;
   widget out= empty_widget ();
   // TMSCM_ALLOW_INTS;
@@ -8167,6 +9001,7 @@ tmg_widget_empty () {
 
 tmscm
 tmg_widget_text (tmscm arg1, tmscm arg2, tmscm arg3, tmscm arg4) {
+  PROFILE_TALLY ("glue widget-text");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "widget-text");
   TMSCM_ASSERT_INT (arg2, TMSCM_ARG2, "widget-text");
   TMSCM_ASSERT_INT (arg3, TMSCM_ARG3, "widget-text");
@@ -8186,6 +9021,7 @@ tmg_widget_text (tmscm arg1, tmscm arg2, tmscm arg3, tmscm arg4) {
 
 tmscm
 tmg_widget_input (tmscm arg1, tmscm arg2, tmscm arg3, tmscm arg4, tmscm arg5) {
+  PROFILE_TALLY ("glue widget-input");
   TMSCM_ASSERT_COMMAND (arg1, TMSCM_ARG1, "widget-input");
   TMSCM_ASSERT_STRING (arg2, TMSCM_ARG2, "widget-input");
   TMSCM_ASSERT_ARRAY_STRING (arg3, TMSCM_ARG3, "widget-input");
@@ -8207,6 +9043,7 @@ tmg_widget_input (tmscm arg1, tmscm arg2, tmscm arg3, tmscm arg4, tmscm arg5) {
 
 tmscm
 tmg_widget_enum (tmscm arg1, tmscm arg2, tmscm arg3, tmscm arg4, tmscm arg5) {
+  PROFILE_TALLY ("glue widget-enum");
   TMSCM_ASSERT_COMMAND (arg1, TMSCM_ARG1, "widget-enum");
   TMSCM_ASSERT_ARRAY_STRING (arg2, TMSCM_ARG2, "widget-enum");
   TMSCM_ASSERT_STRING (arg3, TMSCM_ARG3, "widget-enum");
@@ -8228,6 +9065,7 @@ tmg_widget_enum (tmscm arg1, tmscm arg2, tmscm arg3, tmscm arg4, tmscm arg5) {
 
 tmscm
 tmg_widget_choice (tmscm arg1, tmscm arg2, tmscm arg3) {
+  PROFILE_TALLY ("glue widget-choice");
   TMSCM_ASSERT_COMMAND (arg1, TMSCM_ARG1, "widget-choice");
   TMSCM_ASSERT_ARRAY_STRING (arg2, TMSCM_ARG2, "widget-choice");
   TMSCM_ASSERT_STRING (arg3, TMSCM_ARG3, "widget-choice");
@@ -8245,6 +9083,7 @@ tmg_widget_choice (tmscm arg1, tmscm arg2, tmscm arg3) {
 
 tmscm
 tmg_widget_choices (tmscm arg1, tmscm arg2, tmscm arg3) {
+  PROFILE_TALLY ("glue widget-choices");
   TMSCM_ASSERT_COMMAND (arg1, TMSCM_ARG1, "widget-choices");
   TMSCM_ASSERT_ARRAY_STRING (arg2, TMSCM_ARG2, "widget-choices");
   TMSCM_ASSERT_ARRAY_STRING (arg3, TMSCM_ARG3, "widget-choices");
@@ -8262,6 +9101,7 @@ tmg_widget_choices (tmscm arg1, tmscm arg2, tmscm arg3) {
 
 tmscm
 tmg_widget_filtered_choice (tmscm arg1, tmscm arg2, tmscm arg3, tmscm arg4) {
+  PROFILE_TALLY ("glue widget-filtered-choice");
   TMSCM_ASSERT_COMMAND (arg1, TMSCM_ARG1, "widget-filtered-choice");
   TMSCM_ASSERT_ARRAY_STRING (arg2, TMSCM_ARG2, "widget-filtered-choice");
   TMSCM_ASSERT_STRING (arg3, TMSCM_ARG3, "widget-filtered-choice");
@@ -8281,6 +9121,7 @@ tmg_widget_filtered_choice (tmscm arg1, tmscm arg2, tmscm arg3, tmscm arg4) {
 
 tmscm
 tmg_widget_tree_view (tmscm arg1, tmscm arg2, tmscm arg3) {
+  PROFILE_TALLY ("glue widget-tree-view");
   TMSCM_ASSERT_COMMAND (arg1, TMSCM_ARG1, "widget-tree-view");
   TMSCM_ASSERT_TREE (arg2, TMSCM_ARG2, "widget-tree-view");
   TMSCM_ASSERT_TREE (arg3, TMSCM_ARG3, "widget-tree-view");
@@ -8298,6 +9139,7 @@ tmg_widget_tree_view (tmscm arg1, tmscm arg2, tmscm arg3) {
 
 tmscm
 tmg_widget_xpm (tmscm arg1) {
+  PROFILE_TALLY ("glue widget-xpm");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "widget-xpm");
 
   url in1= tmscm_to_url (arg1);
@@ -8311,6 +9153,7 @@ tmg_widget_xpm (tmscm arg1) {
 
 tmscm
 tmg_widget_box (tmscm arg1, tmscm arg2, tmscm arg3, tmscm arg4, tmscm arg5) {
+  PROFILE_TALLY ("glue widget-box");
   TMSCM_ASSERT_SCHEME_TREE (arg1, TMSCM_ARG1, "widget-box");
   TMSCM_ASSERT_STRING (arg2, TMSCM_ARG2, "widget-box");
   TMSCM_ASSERT_INT (arg3, TMSCM_ARG3, "widget-box");
@@ -8332,6 +9175,7 @@ tmg_widget_box (tmscm arg1, tmscm arg2, tmscm arg3, tmscm arg4, tmscm arg5) {
 
 tmscm
 tmg_widget_glue (tmscm arg1, tmscm arg2, tmscm arg3, tmscm arg4) {
+  PROFILE_TALLY ("glue widget-glue");
   TMSCM_ASSERT_BOOL (arg1, TMSCM_ARG1, "widget-glue");
   TMSCM_ASSERT_BOOL (arg2, TMSCM_ARG2, "widget-glue");
   TMSCM_ASSERT_INT (arg3, TMSCM_ARG3, "widget-glue");
@@ -8351,6 +9195,7 @@ tmg_widget_glue (tmscm arg1, tmscm arg2, tmscm arg3, tmscm arg4) {
 
 tmscm
 tmg_widget_color (tmscm arg1, tmscm arg2, tmscm arg3, tmscm arg4, tmscm arg5) {
+  PROFILE_TALLY ("glue widget-color");
   TMSCM_ASSERT_CONTENT (arg1, TMSCM_ARG1, "widget-color");
   TMSCM_ASSERT_BOOL (arg2, TMSCM_ARG2, "widget-color");
   TMSCM_ASSERT_BOOL (arg3, TMSCM_ARG3, "widget-color");
@@ -8372,6 +9217,7 @@ tmg_widget_color (tmscm arg1, tmscm arg2, tmscm arg3, tmscm arg4, tmscm arg5) {
 
 tmscm
 tmg_widget_hlist (tmscm arg1) {
+  PROFILE_TALLY ("glue widget-hlist");
   TMSCM_ASSERT_ARRAY_WIDGET (arg1, TMSCM_ARG1, "widget-hlist");
 
   array_widget in1= tmscm_to_array_widget (arg1);
@@ -8385,6 +9231,7 @@ tmg_widget_hlist (tmscm arg1) {
 
 tmscm
 tmg_widget_vlist (tmscm arg1) {
+  PROFILE_TALLY ("glue widget-vlist");
   TMSCM_ASSERT_ARRAY_WIDGET (arg1, TMSCM_ARG1, "widget-vlist");
 
   array_widget in1= tmscm_to_array_widget (arg1);
@@ -8398,6 +9245,7 @@ tmg_widget_vlist (tmscm arg1) {
 
 tmscm
 tmg_widget_aligned (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue widget-aligned");
   TMSCM_ASSERT_ARRAY_WIDGET (arg1, TMSCM_ARG1, "widget-aligned");
   TMSCM_ASSERT_ARRAY_WIDGET (arg2, TMSCM_ARG2, "widget-aligned");
 
@@ -8413,6 +9261,7 @@ tmg_widget_aligned (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_widget_tabs (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue widget-tabs");
   TMSCM_ASSERT_ARRAY_WIDGET (arg1, TMSCM_ARG1, "widget-tabs");
   TMSCM_ASSERT_ARRAY_WIDGET (arg2, TMSCM_ARG2, "widget-tabs");
 
@@ -8428,6 +9277,7 @@ tmg_widget_tabs (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_widget_icon_tabs (tmscm arg1, tmscm arg2, tmscm arg3) {
+  PROFILE_TALLY ("glue widget-icon-tabs");
   TMSCM_ASSERT_ARRAY_URL (arg1, TMSCM_ARG1, "widget-icon-tabs");
   TMSCM_ASSERT_ARRAY_WIDGET (arg2, TMSCM_ARG2, "widget-icon-tabs");
   TMSCM_ASSERT_ARRAY_WIDGET (arg3, TMSCM_ARG3, "widget-icon-tabs");
@@ -8445,6 +9295,7 @@ tmg_widget_icon_tabs (tmscm arg1, tmscm arg2, tmscm arg3) {
 
 tmscm
 tmg_widget_scrollable (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue widget-scrollable");
   TMSCM_ASSERT_WIDGET (arg1, TMSCM_ARG1, "widget-scrollable");
   TMSCM_ASSERT_INT (arg2, TMSCM_ARG2, "widget-scrollable");
 
@@ -8460,6 +9311,7 @@ tmg_widget_scrollable (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_widget_resize (tmscm arg1, tmscm arg2, tmscm arg3, tmscm arg4, tmscm arg5, tmscm arg6, tmscm arg7, tmscm arg8, tmscm arg9, tmscm arg10) {
+  PROFILE_TALLY ("glue widget-resize");
   TMSCM_ASSERT_WIDGET (arg1, TMSCM_ARG1, "widget-resize");
   TMSCM_ASSERT_INT (arg2, TMSCM_ARG2, "widget-resize");
   TMSCM_ASSERT_STRING (arg3, TMSCM_ARG3, "widget-resize");
@@ -8491,6 +9343,7 @@ tmg_widget_resize (tmscm arg1, tmscm arg2, tmscm arg3, tmscm arg4, tmscm arg5, t
 
 tmscm
 tmg_widget_hsplit (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue widget-hsplit");
   TMSCM_ASSERT_WIDGET (arg1, TMSCM_ARG1, "widget-hsplit");
   TMSCM_ASSERT_WIDGET (arg2, TMSCM_ARG2, "widget-hsplit");
 
@@ -8506,6 +9359,7 @@ tmg_widget_hsplit (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_widget_vsplit (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue widget-vsplit");
   TMSCM_ASSERT_WIDGET (arg1, TMSCM_ARG1, "widget-vsplit");
   TMSCM_ASSERT_WIDGET (arg2, TMSCM_ARG2, "widget-vsplit");
 
@@ -8521,6 +9375,7 @@ tmg_widget_vsplit (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_widget_texmacs_output (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue widget-texmacs-output");
   TMSCM_ASSERT_CONTENT (arg1, TMSCM_ARG1, "widget-texmacs-output");
   TMSCM_ASSERT_CONTENT (arg2, TMSCM_ARG2, "widget-texmacs-output");
 
@@ -8536,6 +9391,7 @@ tmg_widget_texmacs_output (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_widget_texmacs_input (tmscm arg1, tmscm arg2, tmscm arg3) {
+  PROFILE_TALLY ("glue widget-texmacs-input");
   TMSCM_ASSERT_CONTENT (arg1, TMSCM_ARG1, "widget-texmacs-input");
   TMSCM_ASSERT_CONTENT (arg2, TMSCM_ARG2, "widget-texmacs-input");
   TMSCM_ASSERT_URL (arg3, TMSCM_ARG3, "widget-texmacs-input");
@@ -8553,6 +9409,7 @@ tmg_widget_texmacs_input (tmscm arg1, tmscm arg2, tmscm arg3) {
 
 tmscm
 tmg_widget_ink (tmscm arg1) {
+  PROFILE_TALLY ("glue widget-ink");
   TMSCM_ASSERT_COMMAND (arg1, TMSCM_ARG1, "widget-ink");
 
   command in1= tmscm_to_command (arg1);
@@ -8566,6 +9423,7 @@ tmg_widget_ink (tmscm arg1) {
 
 tmscm
 tmg_widget_refresh (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue widget-refresh");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "widget-refresh");
   TMSCM_ASSERT_STRING (arg2, TMSCM_ARG2, "widget-refresh");
 
@@ -8581,6 +9439,7 @@ tmg_widget_refresh (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_widget_refreshable (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue widget-refreshable");
   TMSCM_ASSERT_OBJECT (arg1, TMSCM_ARG1, "widget-refreshable");
   TMSCM_ASSERT_STRING (arg2, TMSCM_ARG2, "widget-refreshable");
 
@@ -8596,6 +9455,7 @@ tmg_widget_refreshable (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_object_2promise_widget (tmscm arg1) {
+  PROFILE_TALLY ("glue object->promise-widget");
   TMSCM_ASSERT_OBJECT (arg1, TMSCM_ARG1, "object->promise-widget");
 
   object in1= tmscm_to_object (arg1);
@@ -8609,6 +9469,7 @@ tmg_object_2promise_widget (tmscm arg1) {
 
 tmscm
 tmg_tree_bounding_rectangle (tmscm arg1) {
+  PROFILE_TALLY ("glue tree-bounding-rectangle");
   TMSCM_ASSERT_TREE (arg1, TMSCM_ARG1, "tree-bounding-rectangle");
 
   tree in1= tmscm_to_tree (arg1);
@@ -8622,6 +9483,7 @@ tmg_tree_bounding_rectangle (tmscm arg1) {
 
 tmscm
 tmg_widget_size (tmscm arg1) {
+  PROFILE_TALLY ("glue widget-size");
   TMSCM_ASSERT_WIDGET (arg1, TMSCM_ARG1, "widget-size");
 
   widget in1= tmscm_to_widget (arg1);
@@ -8635,6 +9497,7 @@ tmg_widget_size (tmscm arg1) {
 
 tmscm
 tmg_show_balloon (tmscm arg1, tmscm arg2, tmscm arg3) {
+  PROFILE_TALLY ("glue show-balloon");
   TMSCM_ASSERT_WIDGET (arg1, TMSCM_ARG1, "show-balloon");
   TMSCM_ASSERT_INT (arg2, TMSCM_ARG2, "show-balloon");
   TMSCM_ASSERT_INT (arg3, TMSCM_ARG3, "show-balloon");
@@ -8652,6 +9515,7 @@ tmg_show_balloon (tmscm arg1, tmscm arg2, tmscm arg3) {
 
 tmscm
 tmg_get_style_menu () {
+  PROFILE_TALLY ("glue get-style-menu");
   // TMSCM_DEFER_INTS;
   object out= get_style_menu ();
   // TMSCM_ALLOW_INTS;
@@ -8661,6 +9525,7 @@ tmg_get_style_menu () {
 
 tmscm
 tmg_hidden_packageP (tmscm arg1) {
+  PROFILE_TALLY ("glue hidden-package?");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "hidden-package?");
 
   string in1= tmscm_to_string (arg1);
@@ -8674,6 +9539,7 @@ tmg_hidden_packageP (tmscm arg1) {
 
 tmscm
 tmg_get_add_package_menu () {
+  PROFILE_TALLY ("glue get-add-package-menu");
   // TMSCM_DEFER_INTS;
   object out= get_add_package_menu ();
   // TMSCM_ALLOW_INTS;
@@ -8683,6 +9549,7 @@ tmg_get_add_package_menu () {
 
 tmscm
 tmg_get_remove_package_menu () {
+  PROFILE_TALLY ("glue get-remove-package-menu");
   // TMSCM_DEFER_INTS;
   object out= get_remove_package_menu ();
   // TMSCM_ALLOW_INTS;
@@ -8692,6 +9559,7 @@ tmg_get_remove_package_menu () {
 
 tmscm
 tmg_get_toggle_package_menu () {
+  PROFILE_TALLY ("glue get-toggle-package-menu");
   // TMSCM_DEFER_INTS;
   object out= get_toggle_package_menu ();
   // TMSCM_ALLOW_INTS;
@@ -8701,6 +9569,7 @@ tmg_get_toggle_package_menu () {
 
 tmscm
 tmg_refresh_now (tmscm arg1) {
+  PROFILE_TALLY ("glue refresh-now");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "refresh-now");
 
   string in1= tmscm_to_string (arg1);
@@ -8714,6 +9583,7 @@ tmg_refresh_now (tmscm arg1) {
 
 tmscm
 tmg_buffer_list () {
+  PROFILE_TALLY ("glue buffer-list");
   // TMSCM_DEFER_INTS;
   array_url out= get_all_buffers ();
   // TMSCM_ALLOW_INTS;
@@ -8723,6 +9593,7 @@ tmg_buffer_list () {
 
 tmscm
 tmg_current_buffer_url () {
+  PROFILE_TALLY ("glue current-buffer-url");
   // TMSCM_DEFER_INTS;
   url out= get_current_buffer_safe ();
   // TMSCM_ALLOW_INTS;
@@ -8732,6 +9603,7 @@ tmg_current_buffer_url () {
 
 tmscm
 tmg_path_to_buffer (tmscm arg1) {
+  PROFILE_TALLY ("glue path-to-buffer");
   TMSCM_ASSERT_PATH (arg1, TMSCM_ARG1, "path-to-buffer");
 
   path in1= tmscm_to_path (arg1);
@@ -8745,6 +9617,7 @@ tmg_path_to_buffer (tmscm arg1) {
 
 tmscm
 tmg_buffer_new () {
+  PROFILE_TALLY ("glue buffer-new");
   // TMSCM_DEFER_INTS;
   url out= make_new_buffer ();
   // TMSCM_ALLOW_INTS;
@@ -8754,6 +9627,7 @@ tmg_buffer_new () {
 
 tmscm
 tmg_buffer_rename (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue buffer-rename");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "buffer-rename");
   TMSCM_ASSERT_URL (arg2, TMSCM_ARG2, "buffer-rename");
 
@@ -8769,6 +9643,7 @@ tmg_buffer_rename (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_buffer_set (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue buffer-set");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "buffer-set");
   TMSCM_ASSERT_CONTENT (arg2, TMSCM_ARG2, "buffer-set");
 
@@ -8784,6 +9659,7 @@ tmg_buffer_set (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_buffer_get (tmscm arg1) {
+  PROFILE_TALLY ("glue buffer-get");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "buffer-get");
 
   url in1= tmscm_to_url (arg1);
@@ -8797,6 +9673,7 @@ tmg_buffer_get (tmscm arg1) {
 
 tmscm
 tmg_buffer_set_body (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue buffer-set-body");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "buffer-set-body");
   TMSCM_ASSERT_CONTENT (arg2, TMSCM_ARG2, "buffer-set-body");
 
@@ -8812,6 +9689,7 @@ tmg_buffer_set_body (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_buffer_get_body (tmscm arg1) {
+  PROFILE_TALLY ("glue buffer-get-body");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "buffer-get-body");
 
   url in1= tmscm_to_url (arg1);
@@ -8825,6 +9703,7 @@ tmg_buffer_get_body (tmscm arg1) {
 
 tmscm
 tmg_buffer_set_master (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue buffer-set-master");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "buffer-set-master");
   TMSCM_ASSERT_URL (arg2, TMSCM_ARG2, "buffer-set-master");
 
@@ -8840,6 +9719,7 @@ tmg_buffer_set_master (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_buffer_get_master (tmscm arg1) {
+  PROFILE_TALLY ("glue buffer-get-master");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "buffer-get-master");
 
   url in1= tmscm_to_url (arg1);
@@ -8853,6 +9733,7 @@ tmg_buffer_get_master (tmscm arg1) {
 
 tmscm
 tmg_buffer_set_title (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue buffer-set-title");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "buffer-set-title");
   TMSCM_ASSERT_STRING (arg2, TMSCM_ARG2, "buffer-set-title");
 
@@ -8868,6 +9749,7 @@ tmg_buffer_set_title (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_buffer_get_title (tmscm arg1) {
+  PROFILE_TALLY ("glue buffer-get-title");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "buffer-get-title");
 
   url in1= tmscm_to_url (arg1);
@@ -8881,6 +9763,7 @@ tmg_buffer_get_title (tmscm arg1) {
 
 tmscm
 tmg_buffer_last_save (tmscm arg1) {
+  PROFILE_TALLY ("glue buffer-last-save");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "buffer-last-save");
 
   url in1= tmscm_to_url (arg1);
@@ -8894,6 +9777,7 @@ tmg_buffer_last_save (tmscm arg1) {
 
 tmscm
 tmg_buffer_last_visited (tmscm arg1) {
+  PROFILE_TALLY ("glue buffer-last-visited");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "buffer-last-visited");
 
   url in1= tmscm_to_url (arg1);
@@ -8907,6 +9791,7 @@ tmg_buffer_last_visited (tmscm arg1) {
 
 tmscm
 tmg_buffer_modifiedP (tmscm arg1) {
+  PROFILE_TALLY ("glue buffer-modified?");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "buffer-modified?");
 
   url in1= tmscm_to_url (arg1);
@@ -8920,6 +9805,7 @@ tmg_buffer_modifiedP (tmscm arg1) {
 
 tmscm
 tmg_buffer_modified_since_autosaveP (tmscm arg1) {
+  PROFILE_TALLY ("glue buffer-modified-since-autosave?");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "buffer-modified-since-autosave?");
 
   url in1= tmscm_to_url (arg1);
@@ -8933,6 +9819,7 @@ tmg_buffer_modified_since_autosaveP (tmscm arg1) {
 
 tmscm
 tmg_buffer_pretend_modified (tmscm arg1) {
+  PROFILE_TALLY ("glue buffer-pretend-modified");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "buffer-pretend-modified");
 
   url in1= tmscm_to_url (arg1);
@@ -8946,6 +9833,7 @@ tmg_buffer_pretend_modified (tmscm arg1) {
 
 tmscm
 tmg_buffer_pretend_saved (tmscm arg1) {
+  PROFILE_TALLY ("glue buffer-pretend-saved");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "buffer-pretend-saved");
 
   url in1= tmscm_to_url (arg1);
@@ -8959,6 +9847,7 @@ tmg_buffer_pretend_saved (tmscm arg1) {
 
 tmscm
 tmg_buffer_pretend_autosaved (tmscm arg1) {
+  PROFILE_TALLY ("glue buffer-pretend-autosaved");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "buffer-pretend-autosaved");
 
   url in1= tmscm_to_url (arg1);
@@ -8970,8 +9859,65 @@ tmg_buffer_pretend_autosaved (tmscm arg1) {
   return TMSCM_UNSPECIFIED;
 }
 
+tmscm
+tmg_buffer_journaledP (tmscm arg1) {
+  PROFILE_TALLY ("glue buffer-journaled?");
+  TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "buffer-journaled?");
+
+  url in1= tmscm_to_url (arg1);
+
+  // TMSCM_DEFER_INTS;
+  bool out= buffer_journaled (in1);
+  // TMSCM_ALLOW_INTS;
+
+  return bool_to_tmscm (out);
+}
+
+tmscm
+tmg_buffer_flush_journal (tmscm arg1) {
+  PROFILE_TALLY ("glue buffer-flush-journal");
+  TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "buffer-flush-journal");
+
+  url in1= tmscm_to_url (arg1);
+
+  // TMSCM_DEFER_INTS;
+  flush_buffer_journal (in1);
+  // TMSCM_ALLOW_INTS;
+
+  return TMSCM_UNSPECIFIED;
+}
+
+tmscm
+tmg_buffer_recoverableP (tmscm arg1) {
+  PROFILE_TALLY ("glue buffer-recoverable?");
+  TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "buffer-recoverable?");
+
+  url in1= tmscm_to_url (arg1);
+
+  // TMSCM_DEFER_INTS;
+  bool out= buffer_recoverable (in1);
+  // TMSCM_ALLOW_INTS;
+
+  return bool_to_tmscm (out);
+}
+
+tmscm
+tmg_buffer_recover (tmscm arg1) {
+  PROFILE_TALLY ("glue buffer-recover");
+  TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "buffer-recover");
+
+  url in1= tmscm_to_url (arg1);
+
+  // TMSCM_DEFER_INTS;
+  bool out= buffer_recover (in1);
+  // TMSCM_ALLOW_INTS;
+
+  return bool_to_tmscm (out);
+}
+
 tmscm
 tmg_buffer_attach_notifier (tmscm arg1) {
+  PROFILE_TALLY ("glue buffer-attach-notifier");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "buffer-attach-notifier");
 
   url in1= tmscm_to_url (arg1);
@@ -8983,8 +9929,23 @@ tmg_buffer_attach_notifier (tmscm arg1) {
   return TMSCM_UNSPECIFIED;
 }
 
+tmscm
+tmg_buffer_snapshot (tmscm arg1) {
+  PROFILE_TALLY ("glue buffer-snapshot");
+  TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "buffer-snapshot");
+
+  url in1= tmscm_to_url (arg1);
+
+  // TMSCM_DEFER_INTS;
+  tree out= buffer_snapshot (in1);
+  // TMSCM_ALLOW_INTS;
+
+  return tree_to_tmscm (out);
+}
+
 tmscm
 tmg_buffer_has_nameP (tmscm arg1) {
+  PROFILE_TALLY ("glue buffer-has-name?");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "buffer-has-name?");
 
   url in1= tmscm_to_url (arg1);
@@ -8998,6 +9959,7 @@ tmg_buffer_has_nameP (tmscm arg1) {
 
 tmscm
 tmg_buffer_auxP (tmscm arg1) {
+  PROFILE_TALLY ("glue buffer-aux?");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "buffer-aux?");
 
   url in1= tmscm_to_url (arg1);
@@ -9011,6 +9973,7 @@ tmg_buffer_auxP (tmscm arg1) {
 
 tmscm
 tmg_buffer_embeddedP (tmscm arg1) {
+  PROFILE_TALLY ("glue buffer-embedded?");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "buffer-embedded?");
 
   url in1= tmscm_to_url (arg1);
@@ -9024,6 +9987,7 @@ tmg_buffer_embeddedP (tmscm arg1) {
 
 tmscm
 tmg_buffer_import (tmscm arg1, tmscm arg2, tmscm arg3) {
+  PROFILE_TALLY ("glue buffer-import");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "buffer-import");
   TMSCM_ASSERT_URL (arg2, TMSCM_ARG2, "buffer-import");
   TMSCM_ASSERT_STRING (arg3, TMSCM_ARG3, "buffer-import");
@@ -9041,6 +10005,7 @@ tmg_buffer_import (tmscm arg1, tmscm arg2, tmscm arg3) {
 
 tmscm
 tmg_buffer_load (tmscm arg1) {
+  PROFILE_TALLY ("glue buffer-load");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "buffer-load");
 
   url in1= tmscm_to_url (arg1);
@@ -9054,6 +10019,7 @@ tmg_buffer_load (tmscm arg1) {
 
 tmscm
 tmg_buffer_export (tmscm arg1, tmscm arg2, tmscm arg3) {
+  PROFILE_TALLY ("glue buffer-export");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "buffer-export");
   TMSCM_ASSERT_URL (arg2, TMSCM_ARG2, "buffer-export");
   TMSCM_ASSERT_STRING (arg3, TMSCM_ARG3, "buffer-export");
@@ -9071,6 +10037,7 @@ tmg_buffer_export (tmscm arg1, tmscm arg2, tmscm arg3) {
 
 tmscm
 tmg_buffer_save (tmscm arg1) {
+  PROFILE_TALLY ("glue buffer-save");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "buffer-save");
 
   url in1= tmscm_to_url (arg1);
@@ -9084,6 +10051,7 @@ tmg_buffer_save (tmscm arg1) {
 
 tmscm
 tmg_tree_import_loaded (tmscm arg1, tmscm arg2, tmscm arg3) {
+  PROFILE_TALLY ("glue tree-import-loaded");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "tree-import-loaded");
   TMSCM_ASSERT_URL (arg2, TMSCM_ARG2, "tree-import-loaded");
   TMSCM_ASSERT_STRING (arg3, TMSCM_ARG3, "tree-import-loaded");
@@ -9101,6 +10069,7 @@ tmg_tree_import_loaded (tmscm arg1, tmscm arg2, tmscm arg3) {
 
 tmscm
 tmg_tree_import (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue tree-import");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "tree-import");
   TMSCM_ASSERT_STRING (arg2, TMSCM_ARG2, "tree-import");
 
@@ -9116,6 +10085,7 @@ tmg_tree_import (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_tree_inclusion (tmscm arg1) {
+  PROFILE_TALLY ("glue tree-inclusion");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "tree-inclusion");
 
   url in1= tmscm_to_url (arg1);
@@ -9129,6 +10099,7 @@ tmg_tree_inclusion (tmscm arg1) {
 
 tmscm
 tmg_tree_export (tmscm arg1, tmscm arg2, tmscm arg3) {
+  PROFILE_TALLY ("glue tree-export");
   TMSCM_ASSERT_TREE (arg1, TMSCM_ARG1, "tree-export");
   TMSCM_ASSERT_URL (arg2, TMSCM_ARG2, "tree-export");
   TMSCM_ASSERT_STRING (arg3, TMSCM_ARG3, "tree-export");
@@ -9146,6 +10117,7 @@ tmg_tree_export (tmscm arg1, tmscm arg2, tmscm arg3) {
 
 tmscm
 tmg_tree_load_style (tmscm arg1) {
+  PROFILE_TALLY ("glue tree-load-style");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "tree-load-style");
 
   string in1= tmscm_to_string (arg1);
@@ -9159,6 +10131,7 @@ tmg_tree_load_style (tmscm arg1) {
 
 tmscm
 tmg_buffer_focus (tmscm arg1) {
+  PROFILE_TALLY ("glue buffer-focus");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "buffer-focus");
 
   url in1= tmscm_to_url (arg1);
@@ -9172,6 +10145,7 @@ tmg_buffer_focus (tmscm arg1) {
 
 tmscm
 tmg_view_list () {
+  PROFILE_TALLY ("glue view-list");
   // TMSCM_DEFER_INTS;
   array_url out= get_all_views ();
   // TMSCM_ALLOW_INTS;
@@ -9181,6 +10155,7 @@ tmg_view_list () {
 
 tmscm
 tmg_buffer_2views (tmscm arg1) {
+  PROFILE_TALLY ("glue buffer->views");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "buffer->views");
 
   url in1= tmscm_to_url (arg1);
@@ -9194,6 +10169,7 @@ tmg_buffer_2views (tmscm arg1) {
 
 tmscm
 tmg_current_view_url () {
+  PROFILE_TALLY ("glue current-view-url");
   // TMSCM_DEFER_INTS;
   url out= get_current_view_safe ();
   // TMSCM_ALLOW_INTS;
@@ -9203,6 +10179,7 @@ tmg_current_view_url () {
 
 tmscm
 tmg_window_2view (tmscm arg1) {
+  PROFILE_TALLY ("glue window->view");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "window->view");
 
   url in1= tmscm_to_url (arg1);
@@ -9216,6 +10193,7 @@ tmg_window_2view (tmscm arg1) {
 
 tmscm
 tmg_view_2buffer (tmscm arg1) {
+  PROFILE_TALLY ("glue view->buffer");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "view->buffer");
 
   url in1= tmscm_to_url (arg1);
@@ -9229,6 +10207,7 @@ tmg_view_2buffer (tmscm arg1) {
 
 tmscm
 tmg_view_2window_url (tmscm arg1) {
+  PROFILE_TALLY ("glue view->window-url");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "view->window-url");
 
   url in1= tmscm_to_url (arg1);
@@ -9242,6 +10221,7 @@ tmg_view_2window_url (tmscm arg1) {
 
 tmscm
 tmg_view_new (tmscm arg1) {
+  PROFILE_TALLY ("glue view-new");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "view-new");
 
   url in1= tmscm_to_url (arg1);
@@ -9255,6 +10235,7 @@ tmg_view_new (tmscm arg1) {
 
 tmscm
 tmg_view_passive (tmscm arg1) {
+  PROFILE_TALLY ("glue view-passive");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "view-passive");
 
   url in1= tmscm_to_url (arg1);
@@ -9268,6 +10249,7 @@ tmg_view_passive (tmscm arg1) {
 
 tmscm
 tmg_view_recent (tmscm arg1) {
+  PROFILE_TALLY ("glue view-recent");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "view-recent");
 
   url in1= tmscm_to_url (arg1);
@@ -9281,6 +10263,7 @@ tmg_view_recent (tmscm arg1) {
 
 tmscm
 tmg_view_delete (tmscm arg1) {
+  PROFILE_TALLY ("glue view-delete");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "view-delete");
 
   url in1= tmscm_to_url (arg1);
@@ -9294,6 +10277,7 @@ tmg_view_delete (tmscm arg1) {
 
 tmscm
 tmg_window_set_view (tmscm arg1, tmscm arg2, tmscm arg3) {
+  PROFILE_TALLY ("glue window-set-view");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "window-set-view");
   TMSCM_ASSERT_URL (arg2, TMSCM_ARG2, "window-set-view");
   TMSCM_ASSERT_BOOL (arg3, TMSCM_ARG3, "window-set-view");
@@ -9311,6 +10295,7 @@ tmg_window_set_view (tmscm arg1, tmscm arg2, tmscm arg3) {
 
 tmscm
 tmg_switch_to_buffer (tmscm arg1) {
+  PROFILE_TALLY ("glue switch-to-buffer");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "switch-to-buffer");
 
   url in1= tmscm_to_url (arg1);
@@ -9324,6 +10309,7 @@ tmg_switch_to_buffer (tmscm arg1) {
 
 tmscm
 tmg_window_list () {
+  PROFILE_TALLY ("glue window-list");
   // TMSCM_DEFER_INTS;
   array_url out= windows_list ();
   // TMSCM_ALLOW_INTS;
@@ -9333,6 +10319,7 @@ tmg_window_list () {
 
 tmscm
 tmg_windows_number () {
+  PROFILE_TALLY ("glue windows-number");
   // TMSCM_DEFER_INTS;
   int out= get_nr_windows ();
   // TMSCM_ALLOW_INTS;
@@ -9342,6 +10329,7 @@ tmg_windows_number () {
 
 tmscm
 tmg_current_window () {
+  PROFILE_TALLY ("glue current-window");
   // TMSCM_DEFER_INTS;
   url out= get_current_window ();
   // TMSCM_ALLOW_INTS;
@@ -9351,6 +10339,7 @@ tmg_current_window () {
 
 tmscm
 tmg_buffer_2windows (tmscm arg1) {
+  PROFILE_TALLY ("glue buffer->windows");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "buffer->windows");
 
   url in1= tmscm_to_url (arg1);
@@ -9364,6 +10353,7 @@ tmg_buffer_2windows (tmscm arg1) {
 
 tmscm
 tmg_window_to_buffer (tmscm arg1) {
+  PROFILE_TALLY ("glue window-to-buffer");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "window-to-buffer");
 
   url in1= tmscm_to_url (arg1);
@@ -9377,6 +10367,7 @@ tmg_window_to_buffer (tmscm arg1) {
 
 tmscm
 tmg_window_set_buffer (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue window-set-buffer");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "window-set-buffer");
   TMSCM_ASSERT_URL (arg2, TMSCM_ARG2, "window-set-buffer");
 
@@ -9392,6 +10383,7 @@ tmg_window_set_buffer (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_window_focus (tmscm arg1) {
+  PROFILE_TALLY ("glue window-focus");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "window-focus");
 
   url in1= tmscm_to_url (arg1);
@@ -9405,6 +10397,7 @@ tmg_window_focus (tmscm arg1) {
 
 tmscm
 tmg_new_buffer () {
+  PROFILE_TALLY ("glue new-buffer");
   // TMSCM_DEFER_INTS;
   url out= create_buffer ();
   // TMSCM_ALLOW_INTS;
@@ -9414,6 +10407,7 @@ tmg_new_buffer () {
 
 tmscm
 tmg_open_buffer_in_window (tmscm arg1, tmscm arg2, tmscm arg3) {
+  PROFILE_TALLY ("glue open-buffer-in-window");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "open-buffer-in-window");
   TMSCM_ASSERT_CONTENT (arg2, TMSCM_ARG2, "open-buffer-in-window");
   TMSCM_ASSERT_CONTENT (arg3, TMSCM_ARG3, "open-buffer-in-window");
@@ -9431,6 +10425,7 @@ tmg_open_buffer_in_window (tmscm arg1, tmscm arg2, tmscm arg3) {
 
 tmscm
 tmg_open_window () {
+  PROFILE_TALLY ("glue open-window");
   // TMSCM_DEFER_INTS;
   url out= open_window ();
   // TMSCM_ALLOW_INTS;
@@ -9440,6 +10435,7 @@ tmg_open_window () {
 
 tmscm
 tmg_open_window_geometry (tmscm arg1) {
+  PROFILE_TALLY ("glue open-window-geometry");
   TMSCM_ASSERT_CONTENT (arg1, TMSCM_ARG1, "open-window-geometry");
 
   content in1= tmscm_to_content (arg1);
@@ -9453,6 +10449,7 @@ tmg_open_window_geometry (tmscm arg1) {
 
 tmscm
 tmg_clone_window () {
+  PROFILE_TALLY ("glue clone-window");
   // TMSCM_DEFER_INTS;
   clone_window ();
   // TMSCM_ALLOW_INTS;
@@ -9462,6 +10459,7 @@ tmg_clone_window () {
 
 tmscm
 tmg_buffer_close (tmscm arg1) {
+  PROFILE_TALLY ("glue buffer-close");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "buffer-close");
 
   url in1= tmscm_to_url (arg1);
@@ -9475,6 +10473,7 @@ tmg_buffer_close (tmscm arg1) {
 
 tmscm
 tmg_kill_window (tmscm arg1) {
+  PROFILE_TALLY ("glue kill-window");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "kill-window");
 
   url in1= tmscm_to_url (arg1);
@@ -9488,6 +10487,7 @@ tmg_kill_window (tmscm arg1) {
 
 tmscm
 tmg_kill_current_window_and_buffer () {
+  PROFILE_TALLY ("glue kill-current-window-and-buffer");
   // TMSCM_DEFER_INTS;
   kill_current_window_and_buffer ();
   // TMSCM_ALLOW_INTS;
@@ -9497,6 +10497,7 @@ tmg_kill_current_window_and_buffer () {
 
 tmscm
 tmg_project_attach (tmscm arg1) {
+  PROFILE_TALLY ("glue project-attach");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "project-attach");
 
   string in1= tmscm_to_string (arg1);
@@ -9510,6 +10511,7 @@ tmg_project_attach (tmscm arg1) {
 
 tmscm
 tmg_project_detach () {
+  PROFILE_TALLY ("glue project-detach");
   // TMSCM_DEFER_INTS;
   project_attach ();
   // TMSCM_ALLOW_INTS;
@@ -9519,6 +10521,7 @@ tmg_project_detach () {
 
 tmscm
 tmg_project_attachedP () {
+  PROFILE_TALLY ("glue project-attached?");
   // TMSCM_DEFER_INTS;
   bool out= project_attached ();
   // TMSCM_ALLOW_INTS;
@@ -9528,6 +10531,7 @@ tmg_project_attachedP () {
 
 tmscm
 tmg_project_get () {
+  PROFILE_TALLY ("glue project-get");
   // TMSCM_DEFER_INTS;
   url out= project_get ();
   // TMSCM_ALLOW_INTS;
@@ -9537,6 +10541,7 @@ tmg_project_get () {
 
 tmscm
 tmg_alt_window_handle () {
+  PROFILE_TALLY ("glue alt-window-handle");
   // TMSCM_DEFER_INTS;
   int out= window_handle ();
   // TMSCM_ALLOW_INTS;
@@ -9546,6 +10551,7 @@ tmg_alt_window_handle () {
 
 tmscm
 tmg_alt_window_create (tmscm arg1, tmscm arg2, tmscm arg3, tmscm arg4) {
+  PROFILE_TALLY ("glue alt-window-create");
   TMSCM_ASSERT_INT (arg1, TMSCM_ARG1, "alt-window-create");
   TMSCM_ASSERT_WIDGET (arg2, TMSCM_ARG2, "alt-window-create");
   TMSCM_ASSERT_STRING (arg3, TMSCM_ARG3, "alt-window-create");
@@ -9565,6 +10571,7 @@ tmg_alt_window_create (tmscm arg1, tmscm arg2, tmscm arg3, tmscm arg4) {
 
 tmscm
 tmg_alt_window_create_quit (tmscm arg1, tmscm arg2, tmscm arg3, tmscm arg4) {
+  PROFILE_TALLY ("glue alt-window-create-quit");
   TMSCM_ASSERT_INT (arg1, TMSCM_ARG1, "alt-window-create-quit");
   TMSCM_ASSERT_WIDGET (arg2, TMSCM_ARG2, "alt-window-create-quit");
   TMSCM_ASSERT_STRING (arg3, TMSCM_ARG3, "alt-window-create-quit");
@@ -9584,6 +10591,7 @@ tmg_alt_window_create_quit (tmscm arg1, tmscm arg2, tmscm arg3, tmscm arg4) {
 
 tmscm
 tmg_alt_window_delete (tmscm arg1) {
+  PROFILE_TALLY ("glue alt-window-delete");
   TMSCM_ASSERT_INT (arg1, TMSCM_ARG1, "alt-window-delete");
 
   int in1= tmscm_to_int (arg1);
@@ -9597,6 +10605,7 @@ tmg_alt_window_delete (tmscm arg1) {
 
 tmscm
 tmg_alt_window_show (tmscm arg1) {
+  PROFILE_TALLY ("glue alt-window-show");
   TMSCM_ASSERT_INT (arg1, TMSCM_ARG1, "alt-window-show");
 
   int in1= tmscm_to_int (arg1);
@@ -9610,6 +10619,7 @@ tmg_alt_window_show (tmscm arg1) {
 
 tmscm
 tmg_alt_window_hide (tmscm arg1) {
+  PROFILE_TALLY ("glue alt-window-hide");
   TMSCM_ASSERT_INT (arg1, TMSCM_ARG1, "alt-window-hide");
 
   int in1= tmscm_to_int (arg1);
@@ -9623,6 +10633,7 @@ tmg_alt_window_hide (tmscm arg1) {
 
 tmscm
 tmg_alt_window_get_size (tmscm arg1) {
+  PROFILE_TALLY ("glue alt-window-get-size");
   TMSCM_ASSERT_INT (arg1, TMSCM_ARG1, "alt-window-get-size");
 
   int in1= tmscm_to_int (arg1);
@@ -9636,6 +10647,7 @@ tmg_alt_window_get_size (tmscm arg1) {
 
 tmscm
 tmg_alt_window_set_size (tmscm arg1, tmscm arg2, tmscm arg3) {
+  PROFILE_TALLY ("glue alt-window-set-size");
   TMSCM_ASSERT_INT (arg1, TMSCM_ARG1, "alt-window-set-size");
   TMSCM_ASSERT_INT (arg2, TMSCM_ARG2, "alt-window-set-size");
   TMSCM_ASSERT_INT (arg3, TMSCM_ARG3, "alt-window-set-size");
@@ -9653,6 +10665,7 @@ tmg_alt_window_set_size (tmscm arg1, tmscm arg2, tmscm arg3) {
 
 tmscm
 tmg_alt_window_get_position (tmscm arg1) {
+  PROFILE_TALLY ("glue alt-window-get-position");
   TMSCM_ASSERT_INT (arg1, TMSCM_ARG1, "alt-window-get-position");
 
   int in1= tmscm_to_int (arg1);
@@ -9666,6 +10679,7 @@ tmg_alt_window_get_position (tmscm arg1) {
 
 tmscm
 tmg_alt_window_set_position (tmscm arg1, tmscm arg2, tmscm arg3) {
+  PROFILE_TALLY ("glue alt-window-set-position");
   TMSCM_ASSERT_INT (arg1, TMSCM_ARG1, "alt-window-set-position");
   TMSCM_ASSERT_INT (arg2, TMSCM_ARG2, "alt-window-set-position");
   TMSCM_ASSERT_INT (arg3, TMSCM_ARG3, "alt-window-set-position");
@@ -9683,6 +10697,7 @@ tmg_alt_window_set_position (tmscm arg1, tmscm arg2, tmscm arg3) {
 
 tmscm
 tmg_alt_window_search (tmscm arg1) {
+  PROFILE_TALLY ("glue alt-window-search");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "alt-window-search");
 
   url in1= tmscm_to_url (arg1);
@@ -9696,6 +10711,7 @@ tmg_alt_window_search (tmscm arg1) {
 
 tmscm
 tmg_supports_bibtexP () {
+  PROFILE_TALLY ("glue supports-bibtex?");
   // TMSCM_DEFER_INTS;
   bool out= bibtex_present ();
   // TMSCM_ALLOW_INTS;
@@ -9705,6 +10721,7 @@ tmg_supports_bibtexP () {
 
 tmscm
 tmg_bibtex_run (tmscm arg1, tmscm arg2, tmscm arg3, tmscm arg4) {
+  PROFILE_TALLY ("glue bibtex-run");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "bibtex-run");
   TMSCM_ASSERT_STRING (arg2, TMSCM_ARG2, "bibtex-run");
   TMSCM_ASSERT_URL (arg3, TMSCM_ARG3, "bibtex-run");
@@ -9724,6 +10741,7 @@ tmg_bibtex_run (tmscm arg1, tmscm arg2, tmscm arg3, tmscm arg4) {
 
 tmscm
 tmg_bib_add_period (tmscm arg1) {
+  PROFILE_TALLY ("glue bib-add-period");
   TMSCM_ASSERT_SCHEME_TREE (arg1, TMSCM_ARG1, "bib-add-period");
 
   scheme_tree in1= tmscm_to_scheme_tree (arg1);
@@ -9737,6 +10755,7 @@ tmg_bib_add_period (tmscm arg1) {
 
 tmscm
 tmg_bib_locase_first (tmscm arg1) {
+  PROFILE_TALLY ("glue bib-locase-first");
   TMSCM_ASSERT_SCHEME_TREE (arg1, TMSCM_ARG1, "bib-locase-first");
 
   scheme_tree in1= tmscm_to_scheme_tree (arg1);
@@ -9750,6 +10769,7 @@ tmg_bib_locase_first (tmscm arg1) {
 
 tmscm
 tmg_bib_upcase_first (tmscm arg1) {
+  PROFILE_TALLY ("glue bib-upcase-first");
   TMSCM_ASSERT_SCHEME_TREE (arg1, TMSCM_ARG1, "bib-upcase-first");
 
   scheme_tree in1= tmscm_to_scheme_tree (arg1);
@@ -9763,6 +10783,7 @@ tmg_bib_upcase_first (tmscm arg1) {
 
 tmscm
 tmg_bib_locase (tmscm arg1) {
+  PROFILE_TALLY ("glue bib-locase");
   TMSCM_ASSERT_SCHEME_TREE (arg1, TMSCM_ARG1, "bib-locase");
 
   scheme_tree in1= tmscm_to_scheme_tree (arg1);
@@ -9776,6 +10797,7 @@ tmg_bib_locase (tmscm arg1) {
 
 tmscm
 tmg_bib_upcase (tmscm arg1) {
+  PROFILE_TALLY ("glue bib-upcase");
   TMSCM_ASSERT_SCHEME_TREE (arg1, TMSCM_ARG1, "bib-upcase");
 
   scheme_tree in1= tmscm_to_scheme_tree (arg1);
@@ -9789,6 +10811,7 @@ tmg_bib_upcase (tmscm arg1) {
 
 tmscm
 tmg_bib_default_preserve_case (tmscm arg1) {
+  PROFILE_TALLY ("glue bib-default-preserve-case");
   TMSCM_ASSERT_SCHEME_TREE (arg1, TMSCM_ARG1, "bib-default-preserve-case");
 
   scheme_tree in1= tmscm_to_scheme_tree (arg1);
@@ -9802,6 +10825,7 @@ tmg_bib_default_preserve_case (tmscm arg1) {
 
 tmscm
 tmg_bib_default_upcase_first (tmscm arg1) {
+  PROFILE_TALLY ("glue bib-default-upcase-first");
   TMSCM_ASSERT_SCHEME_TREE (arg1, TMSCM_ARG1, "bib-default-upcase-first");
 
   scheme_tree in1= tmscm_to_scheme_tree (arg1);
@@ -9815,6 +10839,7 @@ tmg_bib_default_upcase_first (tmscm arg1) {
 
 tmscm
 tmg_bib_purify (tmscm arg1) {
+  PROFILE_TALLY ("glue bib-purify");
   TMSCM_ASSERT_SCHEME_TREE (arg1, TMSCM_ARG1, "bib-purify");
 
   scheme_tree in1= tmscm_to_scheme_tree (arg1);
@@ -9828,6 +10853,7 @@ tmg_bib_purify (tmscm arg1) {
 
 tmscm
 tmg_bib_text_length (tmscm arg1) {
+  PROFILE_TALLY ("glue bib-text-length");
   TMSCM_ASSERT_SCHEME_TREE (arg1, TMSCM_ARG1, "bib-text-length");
 
   scheme_tree in1= tmscm_to_scheme_tree (arg1);
@@ -9841,6 +10867,7 @@ tmg_bib_text_length (tmscm arg1) {
 
 tmscm
 tmg_bib_prefix (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue bib-prefix");
   TMSCM_ASSERT_SCHEME_TREE (arg1, TMSCM_ARG1, "bib-prefix");
   TMSCM_ASSERT_INT (arg2, TMSCM_ARG2, "bib-prefix");
 
@@ -9855,9 +10882,10 @@ tmg_bib_prefix (tmscm arg1, tmscm arg2) {
 }
 
 tmscm
-tmg_bib_emptyP (tmscm arg1, tmscm arg2) {
-  TMSCM_ASSERT_SCHEME_TREE (arg1, TMSCM_ARG1, "bib-empty?");
-  TMSCM_ASSERT_STRING (arg2, TMSCM_ARG2, "bib-empty?");
+tmg_cpp_bib_emptyP (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue cpp-bib-empty?");
+  TMSCM_ASSERT_SCHEME_TREE (arg1, TMSCM_ARG1, "cpp-bib-empty?");
+  TMSCM_ASSERT_STRING (arg2, TMSCM_ARG2, "cpp-bib-empty?");
 
   scheme_tree in1= tmscm_to_scheme_tree (arg1);
   string in2= tmscm_to_string (arg2);
@@ -9870,9 +10898,10 @@ tmg_bib_emptyP (tmscm arg1, tmscm arg2) {
 }
 
 tmscm
-tmg_bib_field (tmscm arg1, tmscm arg2) {
-  TMSCM_ASSERT_SCHEME_TREE (arg1, TMSCM_ARG1, "bib-field");
-  TMSCM_ASSERT_STRING (arg2, TMSCM_ARG2, "bib-field");
+tmg_cpp_bib_field (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue cpp-bib-field");
+  TMSCM_ASSERT_SCHEME_TREE (arg1, TMSCM_ARG1, "cpp-bib-field");
+  TMSCM_ASSERT_STRING (arg2, TMSCM_ARG2, "cpp-bib-field");
 
   scheme_tree in1= tmscm_to_scheme_tree (arg1);
   string in2= tmscm_to_string (arg2);
@@ -9886,6 +10915,7 @@ tmg_bib_field (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_bib_abbreviate (tmscm arg1, tmscm arg2, tmscm arg3) {
+  PROFILE_TALLY ("glue bib-abbreviate");
   TMSCM_ASSERT_SCHEME_TREE (arg1, TMSCM_ARG1, "bib-abbreviate");
   TMSCM_ASSERT_SCHEME_TREE (arg2, TMSCM_ARG2, "bib-abbreviate");
   TMSCM_ASSERT_SCHEME_TREE (arg3, TMSCM_ARG3, "bib-abbreviate");
@@ -9955,9 +10985,23 @@ initialize_glue_basic () {
   tmscm_install_procedure ("texmacs-memory",  tmg_texmacs_memory, 0, 0, 0);
   tmscm_install_procedure ("bench-print",  tmg_bench_print, 1, 0, 0);
   tmscm_install_procedure ("bench-print-all",  tmg_bench_print_all, 0, 0, 0);
+  tmscm_install_procedure ("texmacs-peak-memory",  tmg_texmacs_peak_memory, 0, 0, 0);
+  tmscm_install_procedure ("texmacs-memory-report",  tmg_texmacs_memory_report, 0, 0, 0);
+  tmscm_install_procedure ("profile-start",  tmg_profile_start, 0, 0, 0);
+  tmscm_install_procedure ("profile-stop",  tmg_profile_stop, 0, 0, 0);
+  tmscm_install_procedure ("profile-reset",  tmg_profile_reset, 0, 0, 0);
+  tmscm_install_procedure ("profile-time",  tmg_profile_time, 1, 0, 0);
   tmscm_install_procedure ("system-wait",  tmg_system_wait, 2, 0, 0);
+  tmscm_install_procedure ("system-async",  tmg_system_async, 2, 0, 0);
   tmscm_install_procedure ("get-show-kbd",  tmg_get_show_kbd, 0, 0, 0);
   tmscm_install_procedure ("set-show-kbd",  tmg_set_show_kbd, 1, 0, 0);
+  tmscm_install_procedure ("keyboard-record-start",  tmg_keyboard_record_start, 0, 0, 0);
+  tmscm_install_procedure ("keyboard-record-stop",  tmg_keyboard_record_stop, 1, 0, 0);
+  tmscm_install_procedure ("latency-start",  tmg_latency_start, 1, 0, 0);
+  tmscm_install_procedure ("latency-stop",  tmg_latency_stop, 0, 0, 0);
+  tmscm_install_procedure ("latency-reset",  tmg_latency_reset, 0, 0, 0);
+  tmscm_install_procedure ("latency-report",  tmg_latency_report, 0, 0, 0);
+  tmscm_install_procedure ("latency-distribution",  tmg_latency_distribution, 0, 0, 0);
   tmscm_install_procedure ("set-latex-command",  tmg_set_latex_command, 1, 0, 0);
   tmscm_install_procedure ("set-bibtex-command",  tmg_set_bibtex_command, 1, 0, 0);
   tmscm_install_procedure ("number-latex-errors",  tmg_number_latex_errors, 1, 0, 0);
@@ -10354,6 +11398,8 @@ initialize_glue_basic () {
   tmscm_install_procedure ("try-latex-export",  tmg_try_latex_export, 4, 0, 0);
   tmscm_install_procedure ("parse-xml",  tmg_parse_xml, 1, 0, 0);
   tmscm_install_procedure ("parse-html",  tmg_parse_html, 1, 0, 0);
+  tmscm_install_procedure ("cpp-serialize-html",  tmg_cpp_serialize_html, 1, 0, 0);
+  tmscm_install_procedure ("cpp-serialize-html-file",  tmg_cpp_serialize_html_file, 2, 0, 0);
   tmscm_install_procedure ("parse-bib",  tmg_parse_bib, 1, 0, 0);
   tmscm_install_procedure ("conservative-bib-import",  tmg_conservative_bib_import, 3, 0, 0);
   tmscm_install_procedure ("conservative-bib-export",  tmg_conservative_bib_export, 3, 0, 0);
@@ -10433,6 +11479,7 @@ initialize_glue_basic () {
   tmscm_install_procedure ("url-scratch",  tmg_url_scratch, 3, 0, 0);
   tmscm_install_procedure ("url-scratch?",  tmg_url_scratchP, 1, 0, 0);
   tmscm_install_procedure ("url-cache-invalidate",  tmg_url_cache_invalidate, 1, 0, 0);
+  tmscm_install_procedure ("url-prefetch",  tmg_url_prefetch, 2, 0, 0);
   tmscm_install_procedure ("string-save",  tmg_string_save, 2, 0, 0);
   tmscm_install_procedure ("string-load",  tmg_string_load, 1, 0, 0);
   tmscm_install_procedure ("string-append-to-file",  tmg_string_append_to_file, 2, 0, 0);
@@ -10442,6 +11489,7 @@ initialize_glue_basic () {
   tmscm_install_procedure ("system-mkdir",  tmg_system_mkdir, 1, 0, 0);
   tmscm_install_procedure ("system-rmdir",  tmg_system_rmdir, 1, 0, 0);
   tmscm_install_procedure ("system-search-score",  tmg_system_search_score, 2, 0, 0);
+  tmscm_install_procedure ("system-search-scores",  tmg_system_search_scores, 2, 0, 0);
   tmscm_install_procedure ("system-1",  tmg_system_1, 2, 0, 0);
   tmscm_install_procedure ("system-2",  tmg_system_2, 3, 0, 0);
   tmscm_install_procedure ("system-url->string",  tmg_system_url_2string, 1, 0, 0);
@@ -10467,6 +11515,7 @@ initialize_glue_basic () {
   tmscm_install_procedure ("tmdb-get-name-completions",  tmg_tmdb_get_name_completions, 2, 0, 0);
   tmscm_install_procedure ("supports-sql?",  tmg_supports_sqlP, 0, 0, 0);
   tmscm_install_procedure ("sql-exec",  tmg_sql_exec, 2, 0, 0);
+  tmscm_install_procedure ("sql-exec-all",  tmg_sql_exec_all, 2, 0, 0);
   tmscm_install_procedure ("sql-quote",  tmg_sql_quote, 1, 0, 0);
   tmscm_install_procedure ("server-start",  tmg_server_start, 0, 0, 0);
   tmscm_install_procedure ("server-stop",  tmg_server_stop, 0, 0, 0);
@@ -10556,7 +11605,12 @@ initialize_glue_basic () {
   tmscm_install_procedure ("buffer-pretend-modified",  tmg_buffer_pretend_modified, 1, 0, 0);
   tmscm_install_procedure ("buffer-pretend-saved",  tmg_buffer_pretend_saved, 1, 0, 0);
   tmscm_install_procedure ("buffer-pretend-autosaved",  tmg_buffer_pretend_autosaved, 1, 0, 0);
+  tmscm_install_procedure ("buffer-journaled?",  tmg_buffer_journaledP, 1, 0, 0);
+  tmscm_install_procedure ("buffer-flush-journal",  tmg_buffer_flush_journal, 1, 0, 0);
+  tmscm_install_procedure ("buffer-recoverable?",  tmg_buffer_recoverableP, 1, 0, 0);
+  tmscm_install_procedure ("buffer-recover",  tmg_buffer_recover, 1, 0, 0);
   tmscm_install_procedure ("buffer-attach-notifier",  tmg_buffer_attach_notifier, 1, 0, 0);
+  tmscm_install_procedure ("buffer-snapshot",  tmg_buffer_snapshot, 1, 0, 0);
   tmscm_install_procedure ("buffer-has-name?",  tmg_buffer_has_nameP, 1, 0, 0);
   tmscm_install_procedure ("buffer-aux?",  tmg_buffer_auxP, 1, 0, 0);
   tmscm_install_procedure ("buffer-embedded?",  tmg_buffer_embeddedP, 1, 0, 0);
@@ -10624,7 +11678,7 @@ initialize_glue_basic () {
   tmscm_install_procedure ("bib-purify",  tmg_bib_purify, 1, 0, 0);
   tmscm_install_procedure ("bib-text-length",  tmg_bib_text_length, 1, 0, 0);
   tmscm_install_procedure ("bib-prefix",  tmg_bib_prefix, 2, 0, 0);
-  tmscm_install_procedure ("bib-empty?",  tmg_bib_emptyP, 2, 0, 0);
-  tmscm_install_procedure ("bib-field",  tmg_bib_field, 2, 0, 0);
+  tmscm_install_procedure ("cpp-bib-empty?",  tmg_cpp_bib_emptyP, 2, 0, 0);
+  tmscm_install_procedure ("cpp-bib-field",  tmg_cpp_bib_field, 2, 0, 0);
   tmscm_install_procedure ("bib-abbreviate",  tmg_bib_abbreviate, 3, 0, 0);
 }
@@ -13,6 +13,7 @@
 
 tmscm
 tmg_root_tree () {
+  PROFILE_TALLY ("glue root-tree");
   // TMSCM_DEFER_INTS;
   tree out= get_current_editor()->the_root ();
   // TMSCM_ALLOW_INTS;
@@ -22,6 +23,7 @@ tmg_root_tree () {
 
 tmscm
 tmg_buffer_path () {
+  PROFILE_TALLY ("glue buffer-path");
   // TMSCM_DEFER_INTS;
   path out= get_current_editor()->the_buffer_path ();
   // TMSCM_ALLOW_INTS;
@@ -31,6 +33,7 @@ tmg_buffer_path () {
 
 tmscm
 tmg_buffer_tree () {
+  PROFILE_TALLY ("glue buffer-tree");
   // TMSCM_DEFER_INTS;
   tree out= get_current_editor()->the_buffer ();
   // TMSCM_ALLOW_INTS;
@@ -40,6 +43,7 @@ tmg_buffer_tree () {
 
 tmscm
 tmg_paragraph_tree () {
+  PROFILE_TALLY ("glue paragraph-tree");
   // TMSCM_DEFER_INTS;
   tree out= get_current_editor()->the_line ();
   // TMSCM_ALLOW_INTS;
@@ -49,6 +53,7 @@ tmg_paragraph_tree () {
 
 tmscm
 tmg_cursor_path () {
+  PROFILE_TALLY ("glue cursor-path");
   // TMSCM_DEFER_INTS;
   path out= get_current_editor()->the_path ();
   // TMSCM_ALLOW_INTS;
@@ -58,6 +63,7 @@ tmg_cursor_path () {
 
 tmscm
 tmg_cursor_path_dot () {
+  PROFILE_TALLY ("glue cursor-path*");
   // TMSCM_DEFER_INTS;
   path out= get_current_editor()->the_shifted_path ();
   // TMSCM_ALLOW_INTS;
@@ -67,6 +73,7 @@ tmg_cursor_path_dot () {
 
 tmscm
 tmg_selection_tree () {
+  PROFILE_TALLY ("glue selection-tree");
   // TMSCM_DEFER_INTS;
   tree out= get_current_editor()->selection_get ();
   // TMSCM_ALLOW_INTS;
@@ -76,6 +83,7 @@ tmg_selection_tree () {
 
 tmscm
 tmg_path_2tree (tmscm arg1) {
+  PROFILE_TALLY ("glue path->tree");
   TMSCM_ASSERT_PATH (arg1, TMSCM_ARG1, "path->tree");
 
   path in1= tmscm_to_path (arg1);
@@ -89,6 +97,7 @@ tmg_path_2tree (tmscm arg1) {
 
 tmscm
 tmg_path_correct_old (tmscm arg1) {
+  PROFILE_TALLY ("glue path-correct-old");
   TMSCM_ASSERT_PATH (arg1, TMSCM_ARG1, "path-correct-old");
 
   path in1= tmscm_to_path (arg1);
@@ -102,6 +111,7 @@ tmg_path_correct_old (tmscm arg1) {
 
 tmscm
 tmg_path_insert_with (tmscm arg1, tmscm arg2, tmscm arg3) {
+  PROFILE_TALLY ("glue path-insert-with");
   TMSCM_ASSERT_PATH (arg1, TMSCM_ARG1, "path-insert-with");
   TMSCM_ASSERT_STRING (arg2, TMSCM_ARG2, "path-insert-with");
   TMSCM_ASSERT_CONTENT (arg3, TMSCM_ARG3, "path-insert-with");
@@ -119,6 +129,7 @@ tmg_path_insert_with (tmscm arg1, tmscm arg2, tmscm arg3) {
 
 tmscm
 tmg_path_remove_with (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue path-remove-with");
   TMSCM_ASSERT_PATH (arg1, TMSCM_ARG1, "path-remove-with");
   TMSCM_ASSERT_STRING (arg2, TMSCM_ARG2, "path-remove-with");
 
@@ -134,6 +145,7 @@ tmg_path_remove_with (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_position_new_path (tmscm arg1) {
+  PROFILE_TALLY ("glue position-new-path");
   TMSCM_ASSERT_PATH (arg1, TMSCM_ARG1, "position-new-path");
 
   path in1= tmscm_to_path (arg1);
@@ -147,6 +159,7 @@ tmg_position_new_path (tmscm arg1) {
 
 tmscm
 tmg_position_delete (tmscm arg1) {
+  PROFILE_TALLY ("glue position-delete");
   TMSCM_ASSERT_OBSERVER (arg1, TMSCM_ARG1, "position-delete");
 
   observer in1= tmscm_to_observer (arg1);
@@ -160,6 +173,7 @@ tmg_position_delete (tmscm arg1) {
 
 tmscm
 tmg_position_set (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue position-set");
   TMSCM_ASSERT_OBSERVER (arg1, TMSCM_ARG1, "position-set");
   TMSCM_ASSERT_PATH (arg2, TMSCM_ARG2, "position-set");
 
@@ -175,6 +189,7 @@ tmg_position_set (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_position_get (tmscm arg1) {
+  PROFILE_TALLY ("glue position-get");
   TMSCM_ASSERT_OBSERVER (arg1, TMSCM_ARG1, "position-get");
 
   observer in1= tmscm_to_observer (arg1);
@@ -188,6 +203,7 @@ tmg_position_get (tmscm arg1) {
 
 tmscm
 tmg_insideP (tmscm arg1) {
+  PROFILE_TALLY ("glue inside?");
   TMSCM_ASSERT_TREE_LABEL (arg1, TMSCM_ARG1, "inside?");
 
   tree_label in1= tmscm_to_tree_label (arg1);
@@ -201,6 +217,7 @@ tmg_insideP (tmscm arg1) {
 
 tmscm
 tmg_cpp_insert (tmscm arg1) {
+  PROFILE_TALLY ("glue cpp-insert");
   TMSCM_ASSERT_CONTENT (arg1, TMSCM_ARG1, "cpp-insert");
 
   content in1= tmscm_to_content (arg1);
@@ -214,6 +231,7 @@ tmg_cpp_insert (tmscm arg1) {
 
 tmscm
 tmg_cpp_insert_go_to (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue cpp-insert-go-to");
   TMSCM_ASSERT_CONTENT (arg1, TMSCM_ARG1, "cpp-insert-go-to");
   TMSCM_ASSERT_PATH (arg2, TMSCM_ARG2, "cpp-insert-go-to");
 
@@ -229,6 +247,7 @@ tmg_cpp_insert_go_to (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_insert_raw_go_to (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue insert-raw-go-to");
   TMSCM_ASSERT_CONTENT (arg1, TMSCM_ARG1, "insert-raw-go-to");
   TMSCM_ASSERT_PATH (arg2, TMSCM_ARG2, "insert-raw-go-to");
 
@@ -244,6 +263,7 @@ tmg_insert_raw_go_to (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_insert_raw_return () {
+  PROFILE_TALLY ("glue insert-raw-return");
   // TMSCM_DEFER_INTS;
   get_current_editor()->insert_return ();
   // TMSCM_ALLOW_INTS;
@@ -253,6 +273,7 @@ tmg_insert_raw_return () {
 
 tmscm
 tmg_remove_text (tmscm arg1) {
+  PROFILE_TALLY ("glue remove-text");
   TMSCM_ASSERT_BOOL (arg1, TMSCM_ARG1, "remove-text");
 
   bool in1= tmscm_to_bool (arg1);
@@ -266,6 +287,7 @@ tmg_remove_text (tmscm arg1) {
 
 tmscm
 tmg_remove_structure (tmscm arg1) {
+  PROFILE_TALLY ("glue remove-structure");
   TMSCM_ASSERT_BOOL (arg1, TMSCM_ARG1, "remove-structure");
 
   bool in1= tmscm_to_bool (arg1);
@@ -279,6 +301,7 @@ tmg_remove_structure (tmscm arg1) {
 
 tmscm
 tmg_remove_structure_upwards () {
+  PROFILE_TALLY ("glue remove-structure-upwards");
   // TMSCM_DEFER_INTS;
   get_current_editor()->remove_structure_upwards ();
   // TMSCM_ALLOW_INTS;
@@ -288,6 +311,7 @@ tmg_remove_structure_upwards () {
 
 tmscm
 tmg_cpp_make (tmscm arg1) {
+  PROFILE_TALLY ("glue cpp-make");
   TMSCM_ASSERT_TREE_LABEL (arg1, TMSCM_ARG1, "cpp-make");
 
   tree_label in1= tmscm_to_tree_label (arg1);
@@ -301,6 +325,7 @@ tmg_cpp_make (tmscm arg1) {
 
 tmscm
 tmg_cpp_make_arity (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue cpp-make-arity");
   TMSCM_ASSERT_TREE_LABEL (arg1, TMSCM_ARG1, "cpp-make-arity");
   TMSCM_ASSERT_INT (arg2, TMSCM_ARG2, "cpp-make-arity");
 
@@ -316,6 +341,7 @@ tmg_cpp_make_arity (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_activate () {
+  PROFILE_TALLY ("glue activate");
   // TMSCM_DEFER_INTS;
   get_current_editor()->activate ();
   // TMSCM_ALLOW_INTS;
@@ -325,6 +351,7 @@ tmg_activate () {
 
 tmscm
 tmg_insert_argument (tmscm arg1) {
+  PROFILE_TALLY ("glue insert-argument");
   TMSCM_ASSERT_BOOL (arg1, TMSCM_ARG1, "insert-argument");
 
   bool in1= tmscm_to_bool (arg1);
@@ -338,6 +365,7 @@ tmg_insert_argument (tmscm arg1) {
 
 tmscm
 tmg_remove_argument (tmscm arg1) {
+  PROFILE_TALLY ("glue remove-argument");
   TMSCM_ASSERT_BOOL (arg1, TMSCM_ARG1, "remove-argument");
 
   bool in1= tmscm_to_bool (arg1);
@@ -351,6 +379,7 @@ tmg_remove_argument (tmscm arg1) {
 
 tmscm
 tmg_insert_argument_at (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue insert-argument-at");
   TMSCM_ASSERT_PATH (arg1, TMSCM_ARG1, "insert-argument-at");
   TMSCM_ASSERT_BOOL (arg2, TMSCM_ARG2, "insert-argument-at");
 
@@ -366,6 +395,7 @@ tmg_insert_argument_at (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_remove_argument_at (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue remove-argument-at");
   TMSCM_ASSERT_PATH (arg1, TMSCM_ARG1, "remove-argument-at");
   TMSCM_ASSERT_BOOL (arg2, TMSCM_ARG2, "remove-argument-at");
 
@@ -381,6 +411,7 @@ tmg_remove_argument_at (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_cpp_make_with (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue cpp-make-with");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "cpp-make-with");
   TMSCM_ASSERT_STRING (arg2, TMSCM_ARG2, "cpp-make-with");
 
@@ -396,6 +427,7 @@ tmg_cpp_make_with (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_make_mod_active (tmscm arg1) {
+  PROFILE_TALLY ("glue make-mod-active");
   TMSCM_ASSERT_TREE_LABEL (arg1, TMSCM_ARG1, "make-mod-active");
 
   tree_label in1= tmscm_to_tree_label (arg1);
@@ -409,6 +441,7 @@ tmg_make_mod_active (tmscm arg1) {
 
 tmscm
 tmg_make_style_with (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue make-style-with");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "make-style-with");
   TMSCM_ASSERT_STRING (arg2, TMSCM_ARG2, "make-style-with");
 
@@ -424,6 +457,7 @@ tmg_make_style_with (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_cpp_make_hybrid () {
+  PROFILE_TALLY ("glue cpp-make-hybrid");
   // TMSCM_DEFER_INTS;
   get_current_editor()->make_hybrid ();
   // TMSCM_ALLOW_INTS;
@@ -433,6 +467,7 @@ tmg_cpp_make_hybrid () {
 
 tmscm
 tmg_activate_latex () {
+  PROFILE_TALLY ("glue activate-latex");
   // TMSCM_DEFER_INTS;
   get_current_editor()->activate_latex ();
   // TMSCM_ALLOW_INTS;
@@ -442,6 +477,7 @@ tmg_activate_latex () {
 
 tmscm
 tmg_activate_hybrid (tmscm arg1) {
+  PROFILE_TALLY ("glue activate-hybrid");
   TMSCM_ASSERT_BOOL (arg1, TMSCM_ARG1, "activate-hybrid");
 
   bool in1= tmscm_to_bool (arg1);
@@ -455,6 +491,7 @@ tmg_activate_hybrid (tmscm arg1) {
 
 tmscm
 tmg_activate_symbol () {
+  PROFILE_TALLY ("glue activate-symbol");
   // TMSCM_DEFER_INTS;
   get_current_editor()->activate_symbol ();
   // TMSCM_ALLOW_INTS;
@@ -464,6 +501,7 @@ tmg_activate_symbol () {
 
 tmscm
 tmg_make_return_before () {
+  PROFILE_TALLY ("glue make-return-before");
   // TMSCM_DEFER_INTS;
   get_current_editor()->make_return_before ();
   // TMSCM_ALLOW_INTS;
@@ -473,6 +511,7 @@ tmg_make_return_before () {
 
 tmscm
 tmg_make_return_after () {
+  PROFILE_TALLY ("glue make-return-after");
   // TMSCM_DEFER_INTS;
   bool out= get_current_editor()->make_return_after ();
   // TMSCM_ALLOW_INTS;
@@ -482,6 +521,7 @@ tmg_make_return_after () {
 
 tmscm
 tmg_temp_proof_fix () {
+  PROFILE_TALLY ("glue temp-proof-fix");
   // TMSCM_DEFER_INTS;
   get_current_editor()->temp_proof_fix ();
   // TMSCM_ALLOW_INTS;
@@ -491,6 +531,7 @@ tmg_temp_proof_fix () {
 
 tmscm
 tmg_get_full_env () {
+  PROFILE_TALLY ("glue get-full-env");
   // TMSCM_DEFER_INTS;
   tree out= get_current_editor()->get_full_env ();
   // TMSCM_ALLOW_INTS;
@@ -500,6 +541,7 @@ tmg_get_full_env () {
 
 tmscm
 tmg_get_all_inits () {
+  PROFILE_TALLY ("glue get-all-inits");
   // TMSCM_DEFER_INTS;
   tree out= get_current_editor()->get_init_all ();
   // TMSCM_ALLOW_INTS;
@@ -509,6 +551,7 @@ tmg_get_all_inits () {
 
 tmscm
 tmg_init_default_one (tmscm arg1) {
+  PROFILE_TALLY ("glue init-default-one");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "init-default-one");
 
   string in1= tmscm_to_string (arg1);
@@ -522,6 +565,7 @@ tmg_init_default_one (tmscm arg1) {
 
 tmscm
 tmg_init_env (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue init-env");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "init-env");
   TMSCM_ASSERT_STRING (arg2, TMSCM_ARG2, "init-env");
 
@@ -537,6 +581,7 @@ tmg_init_env (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_init_env_tree (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue init-env-tree");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "init-env-tree");
   TMSCM_ASSERT_CONTENT (arg2, TMSCM_ARG2, "init-env-tree");
 
@@ -552,6 +597,7 @@ tmg_init_env_tree (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_init_style (tmscm arg1) {
+  PROFILE_TALLY ("glue init-style");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "init-style");
 
   string in1= tmscm_to_string (arg1);
@@ -565,6 +611,7 @@ tmg_init_style (tmscm arg1) {
 
 tmscm
 tmg_get_style_tree () {
+  PROFILE_TALLY ("glue get-style-tree");
   // TMSCM_DEFER_INTS;
   tree out= get_current_editor()->get_style ();
   // TMSCM_ALLOW_INTS;
@@ -574,6 +621,7 @@ tmg_get_style_tree () {
 
 tmscm
 tmg_set_style_tree (tmscm arg1) {
+  PROFILE_TALLY ("glue set-style-tree");
   TMSCM_ASSERT_TREE (arg1, TMSCM_ARG1, "set-style-tree");
 
   tree in1= tmscm_to_tree (arg1);
@@ -587,6 +635,7 @@ tmg_set_style_tree (tmscm arg1) {
 
 tmscm
 tmg_get_env (tmscm arg1) {
+  PROFILE_TALLY ("glue get-env");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "get-env");
 
   string in1= tmscm_to_string (arg1);
@@ -600,6 +649,7 @@ tmg_get_env (tmscm arg1) {
 
 tmscm
 tmg_get_env_tree (tmscm arg1) {
+  PROFILE_TALLY ("glue get-env-tree");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "get-env-tree");
 
   string in1= tmscm_to_string (arg1);
@@ -613,6 +663,7 @@ tmg_get_env_tree (tmscm arg1) {
 
 tmscm
 tmg_get_env_tree_at (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue get-env-tree-at");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "get-env-tree-at");
   TMSCM_ASSERT_PATH (arg2, TMSCM_ARG2, "get-env-tree-at");
 
@@ -628,6 +679,7 @@ tmg_get_env_tree_at (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_get_init (tmscm arg1) {
+  PROFILE_TALLY ("glue get-init");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "get-init");
 
   string in1= tmscm_to_string (arg1);
@@ -641,6 +693,7 @@ tmg_get_init (tmscm arg1) {
 
 tmscm
 tmg_get_init_tree (tmscm arg1) {
+  PROFILE_TALLY ("glue get-init-tree");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "get-init-tree");
 
   string in1= tmscm_to_string (arg1);
@@ -654,6 +707,7 @@ tmg_get_init_tree (tmscm arg1) {
 
 tmscm
 tmg_context_hasP (tmscm arg1) {
+  PROFILE_TALLY ("glue context-has?");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "context-has?");
 
   string in1= tmscm_to_string (arg1);
@@ -667,6 +721,7 @@ tmg_context_hasP (tmscm arg1) {
 
 tmscm
 tmg_style_hasP (tmscm arg1) {
+  PROFILE_TALLY ("glue style-has?");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "style-has?");
 
   string in1= tmscm_to_string (arg1);
@@ -680,6 +735,7 @@ tmg_style_hasP (tmscm arg1) {
 
 tmscm
 tmg_init_hasP (tmscm arg1) {
+  PROFILE_TALLY ("glue init-has?");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "init-has?");
 
   string in1= tmscm_to_string (arg1);
@@ -693,6 +749,7 @@ tmg_init_hasP (tmscm arg1) {
 
 tmscm
 tmg_get_page_count () {
+  PROFILE_TALLY ("glue get-page-count");
   // TMSCM_DEFER_INTS;
   int out= get_current_editor()->get_page_count ();
   // TMSCM_ALLOW_INTS;
@@ -702,6 +759,7 @@ tmg_get_page_count () {
 
 tmscm
 tmg_get_page_width (tmscm arg1) {
+  PROFILE_TALLY ("glue get-page-width");
   TMSCM_ASSERT_BOOL (arg1, TMSCM_ARG1, "get-page-width");
 
   bool in1= tmscm_to_bool (arg1);
@@ -715,6 +773,7 @@ tmg_get_page_width (tmscm arg1) {
 
 tmscm
 tmg_get_pages_width (tmscm arg1) {
+  PROFILE_TALLY ("glue get-pages-width");
   TMSCM_ASSERT_BOOL (arg1, TMSCM_ARG1, "get-pages-width");
 
   bool in1= tmscm_to_bool (arg1);
@@ -728,6 +787,7 @@ tmg_get_pages_width (tmscm arg1) {
 
 tmscm
 tmg_get_page_height (tmscm arg1) {
+  PROFILE_TALLY ("glue get-page-height");
   TMSCM_ASSERT_BOOL (arg1, TMSCM_ARG1, "get-page-height");
 
   bool in1= tmscm_to_bool (arg1);
@@ -741,6 +801,7 @@ tmg_get_page_height (tmscm arg1) {
 
 tmscm
 tmg_get_total_width (tmscm arg1) {
+  PROFILE_TALLY ("glue get-total-width");
   TMSCM_ASSERT_BOOL (arg1, TMSCM_ARG1, "get-total-width");
 
   bool in1= tmscm_to_bool (arg1);
@@ -754,6 +815,7 @@ tmg_get_total_width (tmscm arg1) {
 
 tmscm
 tmg_get_total_height (tmscm arg1) {
+  PROFILE_TALLY ("glue get-total-height");
   TMSCM_ASSERT_BOOL (arg1, TMSCM_ARG1, "get-total-height");
 
   bool in1= tmscm_to_bool (arg1);
@@ -767,6 +829,7 @@ tmg_get_total_height (tmscm arg1) {
 
 tmscm
 tmg_get_attachment (tmscm arg1) {
+  PROFILE_TALLY ("glue get-attachment");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "get-attachment");
 
   string in1= tmscm_to_string (arg1);
@@ -780,6 +843,7 @@ tmg_get_attachment (tmscm arg1) {
 
 tmscm
 tmg_set_attachment (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue set-attachment");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "set-attachment");
   TMSCM_ASSERT_CONTENT (arg2, TMSCM_ARG2, "set-attachment");
 
@@ -795,6 +859,7 @@ tmg_set_attachment (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_reset_attachment (tmscm arg1) {
+  PROFILE_TALLY ("glue reset-attachment");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "reset-attachment");
 
   string in1= tmscm_to_string (arg1);
@@ -808,6 +873,7 @@ tmg_reset_attachment (tmscm arg1) {
 
 tmscm
 tmg_list_attachments () {
+  PROFILE_TALLY ("glue list-attachments");
   // TMSCM_DEFER_INTS;
   array_string out= get_current_editor()->list_atts ();
   // TMSCM_ALLOW_INTS;
@@ -817,6 +883,7 @@ tmg_list_attachments () {
 
 tmscm
 tmg_make_htab (tmscm arg1) {
+  PROFILE_TALLY ("glue make-htab");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "make-htab");
 
   string in1= tmscm_to_string (arg1);
@@ -830,6 +897,7 @@ tmg_make_htab (tmscm arg1) {
 
 tmscm
 tmg_make_space (tmscm arg1) {
+  PROFILE_TALLY ("glue make-space");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "make-space");
 
   string in1= tmscm_to_string (arg1);
@@ -843,6 +911,7 @@ tmg_make_space (tmscm arg1) {
 
 tmscm
 tmg_make_var_space (tmscm arg1, tmscm arg2, tmscm arg3) {
+  PROFILE_TALLY ("glue make-var-space");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "make-var-space");
   TMSCM_ASSERT_STRING (arg2, TMSCM_ARG2, "make-var-space");
   TMSCM_ASSERT_STRING (arg3, TMSCM_ARG3, "make-var-space");
@@ -860,6 +929,7 @@ tmg_make_var_space (tmscm arg1, tmscm arg2, tmscm arg3) {
 
 tmscm
 tmg_make_hspace (tmscm arg1) {
+  PROFILE_TALLY ("glue make-hspace");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "make-hspace");
 
   string in1= tmscm_to_string (arg1);
@@ -873,6 +943,7 @@ tmg_make_hspace (tmscm arg1) {
 
 tmscm
 tmg_make_var_hspace (tmscm arg1, tmscm arg2, tmscm arg3) {
+  PROFILE_TALLY ("glue make-var-hspace");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "make-var-hspace");
   TMSCM_ASSERT_STRING (arg2, TMSCM_ARG2, "make-var-hspace");
   TMSCM_ASSERT_STRING (arg3, TMSCM_ARG3, "make-var-hspace");
@@ -890,6 +961,7 @@ tmg_make_var_hspace (tmscm arg1, tmscm arg2, tmscm arg3) {
 
 tmscm
 tmg_make_vspace_before (tmscm arg1) {
+  PROFILE_TALLY ("glue make-vspace-before");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "make-vspace-before");
 
   string in1= tmscm_to_string (arg1);
@@ -903,6 +975,7 @@ tmg_make_vspace_before (tmscm arg1) {
 
 tmscm
 tmg_make_var_vspace_before (tmscm arg1, tmscm arg2, tmscm arg3) {
+  PROFILE_TALLY ("glue make-var-vspace-before");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "make-var-vspace-before");
   TMSCM_ASSERT_STRING (arg2, TMSCM_ARG2, "make-var-vspace-before");
   TMSCM_ASSERT_STRING (arg3, TMSCM_ARG3, "make-var-vspace-before");
@@ -920,6 +993,7 @@ tmg_make_var_vspace_before (tmscm arg1, tmscm arg2, tmscm arg3) {
 
 tmscm
 tmg_make_vspace_after (tmscm arg1) {
+  PROFILE_TALLY ("glue make-vspace-after");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "make-vspace-after");
 
   string in1= tmscm_to_string (arg1);
@@ -933,6 +1007,7 @@ tmg_make_vspace_after (tmscm arg1) {
 
 tmscm
 tmg_make_var_vspace_after (tmscm arg1, tmscm arg2, tmscm arg3) {
+  PROFILE_TALLY ("glue make-var-vspace-after");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "make-var-vspace-after");
   TMSCM_ASSERT_STRING (arg2, TMSCM_ARG2, "make-var-vspace-after");
   TMSCM_ASSERT_STRING (arg3, TMSCM_ARG3, "make-var-vspace-after");
@@ -950,6 +1025,7 @@ tmg_make_var_vspace_after (tmscm arg1, tmscm arg2, tmscm arg3) {
 
 tmscm
 tmg_make_image (tmscm arg1, tmscm arg2, tmscm arg3, tmscm arg4, tmscm arg5, tmscm arg6) {
+  PROFILE_TALLY ("glue make-image");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "make-image");
   TMSCM_ASSERT_BOOL (arg2, TMSCM_ARG2, "make-image");
   TMSCM_ASSERT_STRING (arg3, TMSCM_ARG3, "make-image");
@@ -973,6 +1049,7 @@ tmg_make_image (tmscm arg1, tmscm arg2, tmscm arg3, tmscm arg4, tmscm arg5, tmsc
 
 tmscm
 tmg_length_decode (tmscm arg1) {
+  PROFILE_TALLY ("glue length-decode");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "length-decode");
 
   string in1= tmscm_to_string (arg1);
@@ -986,6 +1063,7 @@ tmg_length_decode (tmscm arg1) {
 
 tmscm
 tmg_length_add (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue length-add");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "length-add");
   TMSCM_ASSERT_STRING (arg2, TMSCM_ARG2, "length-add");
 
@@ -1001,6 +1079,7 @@ tmg_length_add (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_length_mult (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue length-mult");
   TMSCM_ASSERT_DOUBLE (arg1, TMSCM_ARG1, "length-mult");
   TMSCM_ASSERT_STRING (arg2, TMSCM_ARG2, "length-mult");
 
@@ -1016,6 +1095,7 @@ tmg_length_mult (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_lengthP (tmscm arg1) {
+  PROFILE_TALLY ("glue length?");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "length?");
 
   string in1= tmscm_to_string (arg1);
@@ -1029,6 +1109,7 @@ tmg_lengthP (tmscm arg1) {
 
 tmscm
 tmg_length_divide (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue length-divide");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "length-divide");
   TMSCM_ASSERT_STRING (arg2, TMSCM_ARG2, "length-divide");
 
@@ -1044,6 +1125,7 @@ tmg_length_divide (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_cpp_make_rigid () {
+  PROFILE_TALLY ("glue cpp-make-rigid");
   // TMSCM_DEFER_INTS;
   get_current_editor()->make_rigid ();
   // TMSCM_ALLOW_INTS;
@@ -1053,6 +1135,7 @@ tmg_cpp_make_rigid () {
 
 tmscm
 tmg_cpp_make_lprime (tmscm arg1) {
+  PROFILE_TALLY ("glue cpp-make-lprime");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "cpp-make-lprime");
 
   string in1= tmscm_to_string (arg1);
@@ -1066,6 +1149,7 @@ tmg_cpp_make_lprime (tmscm arg1) {
 
 tmscm
 tmg_cpp_make_rprime (tmscm arg1) {
+  PROFILE_TALLY ("glue cpp-make-rprime");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "cpp-make-rprime");
 
   string in1= tmscm_to_string (arg1);
@@ -1079,6 +1163,7 @@ tmg_cpp_make_rprime (tmscm arg1) {
 
 tmscm
 tmg_cpp_make_below () {
+  PROFILE_TALLY ("glue cpp-make-below");
   // TMSCM_DEFER_INTS;
   get_current_editor()->make_below ();
   // TMSCM_ALLOW_INTS;
@@ -1088,6 +1173,7 @@ tmg_cpp_make_below () {
 
 tmscm
 tmg_cpp_make_above () {
+  PROFILE_TALLY ("glue cpp-make-above");
   // TMSCM_DEFER_INTS;
   get_current_editor()->make_above ();
   // TMSCM_ALLOW_INTS;
@@ -1097,6 +1183,7 @@ tmg_cpp_make_above () {
 
 tmscm
 tmg_cpp_make_script (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue cpp-make-script");
   TMSCM_ASSERT_BOOL (arg1, TMSCM_ARG1, "cpp-make-script");
   TMSCM_ASSERT_BOOL (arg2, TMSCM_ARG2, "cpp-make-script");
 
@@ -1112,6 +1199,7 @@ tmg_cpp_make_script (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_cpp_make_fraction () {
+  PROFILE_TALLY ("glue cpp-make-fraction");
   // TMSCM_DEFER_INTS;
   get_current_editor()->make_fraction ();
   // TMSCM_ALLOW_INTS;
@@ -1121,6 +1209,7 @@ tmg_cpp_make_fraction () {
 
 tmscm
 tmg_cpp_make_sqrt () {
+  PROFILE_TALLY ("glue cpp-make-sqrt");
   // TMSCM_DEFER_INTS;
   get_current_editor()->make_sqrt ();
   // TMSCM_ALLOW_INTS;
@@ -1130,6 +1219,7 @@ tmg_cpp_make_sqrt () {
 
 tmscm
 tmg_cpp_make_wide (tmscm arg1) {
+  PROFILE_TALLY ("glue cpp-make-wide");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "cpp-make-wide");
 
   string in1= tmscm_to_string (arg1);
@@ -1143,6 +1233,7 @@ tmg_cpp_make_wide (tmscm arg1) {
 
 tmscm
 tmg_cpp_make_wide_under (tmscm arg1) {
+  PROFILE_TALLY ("glue cpp-make-wide-under");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "cpp-make-wide-under");
 
   string in1= tmscm_to_string (arg1);
@@ -1156,6 +1247,7 @@ tmg_cpp_make_wide_under (tmscm arg1) {
 
 tmscm
 tmg_cpp_make_var_sqrt () {
+  PROFILE_TALLY ("glue cpp-make-var-sqrt");
   // TMSCM_DEFER_INTS;
   get_current_editor()->make_var_sqrt ();
   // TMSCM_ALLOW_INTS;
@@ -1165,6 +1257,7 @@ tmg_cpp_make_var_sqrt () {
 
 tmscm
 tmg_cpp_make_neg () {
+  PROFILE_TALLY ("glue cpp-make-neg");
   // TMSCM_DEFER_INTS;
   get_current_editor()->make_neg ();
   // TMSCM_ALLOW_INTS;
@@ -1174,6 +1267,7 @@ tmg_cpp_make_neg () {
 
 tmscm
 tmg_cpp_make_tree () {
+  PROFILE_TALLY ("glue cpp-make-tree");
   // TMSCM_DEFER_INTS;
   get_current_editor()->make_tree ();
   // TMSCM_ALLOW_INTS;
@@ -1183,6 +1277,7 @@ tmg_cpp_make_tree () {
 
 tmscm
 tmg_make_subtable () {
+  PROFILE_TALLY ("glue make-subtable");
   // TMSCM_DEFER_INTS;
   get_current_editor()->make_subtable ();
   // TMSCM_ALLOW_INTS;
@@ -1192,6 +1287,7 @@ tmg_make_subtable () {
 
 tmscm
 tmg_table_deactivate () {
+  PROFILE_TALLY ("glue table-deactivate");
   // TMSCM_DEFER_INTS;
   get_current_editor()->table_deactivate ();
   // TMSCM_ALLOW_INTS;
@@ -1201,6 +1297,7 @@ tmg_table_deactivate () {
 
 tmscm
 tmg_table_extract_format () {
+  PROFILE_TALLY ("glue table-extract-format");
   // TMSCM_DEFER_INTS;
   get_current_editor()->table_extract_format ();
   // TMSCM_ALLOW_INTS;
@@ -1210,6 +1307,7 @@ tmg_table_extract_format () {
 
 tmscm
 tmg_table_insert_row (tmscm arg1) {
+  PROFILE_TALLY ("glue table-insert-row");
   TMSCM_ASSERT_BOOL (arg1, TMSCM_ARG1, "table-insert-row");
 
   bool in1= tmscm_to_bool (arg1);
@@ -1223,6 +1321,7 @@ tmg_table_insert_row (tmscm arg1) {
 
 tmscm
 tmg_table_insert_column (tmscm arg1) {
+  PROFILE_TALLY ("glue table-insert-column");
   TMSCM_ASSERT_BOOL (arg1, TMSCM_ARG1, "table-insert-column");
 
   bool in1= tmscm_to_bool (arg1);
@@ -1236,6 +1335,7 @@ tmg_table_insert_column (tmscm arg1) {
 
 tmscm
 tmg_table_remove_row (tmscm arg1) {
+  PROFILE_TALLY ("glue table-remove-row");
   TMSCM_ASSERT_BOOL (arg1, TMSCM_ARG1, "table-remove-row");
 
   bool in1= tmscm_to_bool (arg1);
@@ -1249,6 +1349,7 @@ tmg_table_remove_row (tmscm arg1) {
 
 tmscm
 tmg_table_remove_column (tmscm arg1) {
+  PROFILE_TALLY ("glue table-remove-column");
   TMSCM_ASSERT_BOOL (arg1, TMSCM_ARG1, "table-remove-column");
 
   bool in1= tmscm_to_bool (arg1);
@@ -1262,6 +1363,7 @@ tmg_table_remove_column (tmscm arg1) {
 
 tmscm
 tmg_table_nr_rows () {
+  PROFILE_TALLY ("glue table-nr-rows");
   // TMSCM_DEFER_INTS;
   int out= get_current_editor()->table_nr_rows ();
   // TMSCM_ALLOW_INTS;
@@ -1271,6 +1373,7 @@ tmg_table_nr_rows () {
 
 tmscm
 tmg_table_nr_columns () {
+  PROFILE_TALLY ("glue table-nr-columns");
   // TMSCM_DEFER_INTS;
   int out= get_current_editor()->table_nr_columns ();
   // TMSCM_ALLOW_INTS;
@@ -1280,6 +1383,7 @@ tmg_table_nr_columns () {
 
 tmscm
 tmg_table_get_extents () {
+  PROFILE_TALLY ("glue table-get-extents");
   // TMSCM_DEFER_INTS;
   array_int out= get_current_editor()->table_get_extents ();
   // TMSCM_ALLOW_INTS;
@@ -1289,6 +1393,7 @@ tmg_table_get_extents () {
 
 tmscm
 tmg_table_set_extents (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue table-set-extents");
   TMSCM_ASSERT_INT (arg1, TMSCM_ARG1, "table-set-extents");
   TMSCM_ASSERT_INT (arg2, TMSCM_ARG2, "table-set-extents");
 
@@ -1304,6 +1409,7 @@ tmg_table_set_extents (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_table_which_row () {
+  PROFILE_TALLY ("glue table-which-row");
   // TMSCM_DEFER_INTS;
   int out= get_current_editor()->table_which_row ();
   // TMSCM_ALLOW_INTS;
@@ -1313,6 +1419,7 @@ tmg_table_which_row () {
 
 tmscm
 tmg_table_which_column () {
+  PROFILE_TALLY ("glue table-which-column");
   // TMSCM_DEFER_INTS;
   int out= get_current_editor()->table_which_column ();
   // TMSCM_ALLOW_INTS;
@@ -1322,6 +1429,7 @@ tmg_table_which_column () {
 
 tmscm
 tmg_table_which_cells () {
+  PROFILE_TALLY ("glue table-which-cells");
   // TMSCM_DEFER_INTS;
   array_int out= get_current_editor()->table_which_cells ();
   // TMSCM_ALLOW_INTS;
@@ -1331,6 +1439,7 @@ tmg_table_which_cells () {
 
 tmscm
 tmg_table_cell_path (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue table-cell-path");
   TMSCM_ASSERT_INT (arg1, TMSCM_ARG1, "table-cell-path");
   TMSCM_ASSERT_INT (arg2, TMSCM_ARG2, "table-cell-path");
 
@@ -1346,6 +1455,7 @@ tmg_table_cell_path (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_table_go_to (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue table-go-to");
   TMSCM_ASSERT_INT (arg1, TMSCM_ARG1, "table-go-to");
   TMSCM_ASSERT_INT (arg2, TMSCM_ARG2, "table-go-to");
 
@@ -1361,6 +1471,7 @@ tmg_table_go_to (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_table_set_format (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue table-set-format");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "table-set-format");
   TMSCM_ASSERT_CONTENT (arg2, TMSCM_ARG2, "table-set-format");
 
@@ -1376,6 +1487,7 @@ tmg_table_set_format (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_table_get_format_all () {
+  PROFILE_TALLY ("glue table-get-format-all");
   // TMSCM_DEFER_INTS;
   tree out= get_current_editor()->table_get_format ();
   // TMSCM_ALLOW_INTS;
@@ -1385,6 +1497,7 @@ tmg_table_get_format_all () {
 
 tmscm
 tmg_table_get_format (tmscm arg1) {
+  PROFILE_TALLY ("glue table-get-format");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "table-get-format");
 
   string in1= tmscm_to_string (arg1);
@@ -1398,6 +1511,7 @@ tmg_table_get_format (tmscm arg1) {
 
 tmscm
 tmg_table_del_format (tmscm arg1) {
+  PROFILE_TALLY ("glue table-del-format");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "table-del-format");
 
   string in1= tmscm_to_string (arg1);
@@ -1411,6 +1525,7 @@ tmg_table_del_format (tmscm arg1) {
 
 tmscm
 tmg_table_row_decoration (tmscm arg1) {
+  PROFILE_TALLY ("glue table-row-decoration");
   TMSCM_ASSERT_BOOL (arg1, TMSCM_ARG1, "table-row-decoration");
 
   bool in1= tmscm_to_bool (arg1);
@@ -1424,6 +1539,7 @@ tmg_table_row_decoration (tmscm arg1) {
 
 tmscm
 tmg_table_column_decoration (tmscm arg1) {
+  PROFILE_TALLY ("glue table-column-decoration");
   TMSCM_ASSERT_BOOL (arg1, TMSCM_ARG1, "table-column-decoration");
 
   bool in1= tmscm_to_bool (arg1);
@@ -1437,6 +1553,7 @@ tmg_table_column_decoration (tmscm arg1) {
 
 tmscm
 tmg_table_format_center () {
+  PROFILE_TALLY ("glue table-format-center");
   // TMSCM_DEFER_INTS;
   get_current_editor()->table_format_center ();
   // TMSCM_ALLOW_INTS;
@@ -1446,6 +1563,7 @@ tmg_table_format_center () {
 
 tmscm
 tmg_table_correct_block_content () {
+  PROFILE_TALLY ("glue table-correct-block-content");
   // TMSCM_DEFER_INTS;
   get_current_editor()->table_correct_block_content ();
   // TMSCM_ALLOW_INTS;
@@ -1455,6 +1573,7 @@ tmg_table_correct_block_content () {
 
 tmscm
 tmg_set_cell_mode (tmscm arg1) {
+  PROFILE_TALLY ("glue set-cell-mode");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "set-cell-mode");
 
   string in1= tmscm_to_string (arg1);
@@ -1468,6 +1587,7 @@ tmg_set_cell_mode (tmscm arg1) {
 
 tmscm
 tmg_get_cell_mode () {
+  PROFILE_TALLY ("glue get-cell-mode");
   // TMSCM_DEFER_INTS;
   string out= get_current_editor()->get_cell_mode ();
   // TMSCM_ALLOW_INTS;
@@ -1477,6 +1597,7 @@ tmg_get_cell_mode () {
 
 tmscm
 tmg_cell_set_format (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue cell-set-format");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "cell-set-format");
   TMSCM_ASSERT_CONTENT (arg2, TMSCM_ARG2, "cell-set-format");
 
@@ -1492,6 +1613,7 @@ tmg_cell_set_format (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_cell_get_format (tmscm arg1) {
+  PROFILE_TALLY ("glue cell-get-format");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "cell-get-format");
 
   string in1= tmscm_to_string (arg1);
@@ -1505,6 +1627,7 @@ tmg_cell_get_format (tmscm arg1) {
 
 tmscm
 tmg_cell_del_format (tmscm arg1) {
+  PROFILE_TALLY ("glue cell-del-format");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "cell-del-format");
 
   string in1= tmscm_to_string (arg1);
@@ -1518,6 +1641,7 @@ tmg_cell_del_format (tmscm arg1) {
 
 tmscm
 tmg_table_test () {
+  PROFILE_TALLY ("glue table-test");
   // TMSCM_DEFER_INTS;
   get_current_editor()->table_test ();
   // TMSCM_ALLOW_INTS;
@@ -1527,6 +1651,7 @@ tmg_table_test () {
 
 tmscm
 tmg_key_press (tmscm arg1) {
+  PROFILE_TALLY ("glue key-press");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "key-press");
 
   string in1= tmscm_to_string (arg1);
@@ -1540,6 +1665,7 @@ tmg_key_press (tmscm arg1) {
 
 tmscm
 tmg_raw_emulate_keyboard (tmscm arg1) {
+  PROFILE_TALLY ("glue raw-emulate-keyboard");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "raw-emulate-keyboard");
 
   string in1= tmscm_to_string (arg1);
@@ -1551,8 +1677,23 @@ tmg_raw_emulate_keyboard (tmscm arg1) {
   return TMSCM_UNSPECIFIED;
 }
 
+tmscm
+tmg_keyboard_replay (tmscm arg1) {
+  PROFILE_TALLY ("glue keyboard-replay");
+  TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "keyboard-replay");
+
+  url in1= tmscm_to_url (arg1);
+
+  // TMSCM_DEFER_INTS;
+  get_current_editor()->replay_keys (in1);
+  // TMSCM_ALLOW_INTS;
+
+  return TMSCM_UNSPECIFIED;
+}
+
 tmscm
 tmg_complete_tryP () {
+  PROFILE_TALLY ("glue complete-try?");
   // TMSCM_DEFER_INTS;
   bool out= get_current_editor()->complete_try ();
   // TMSCM_ALLOW_INTS;
@@ -1562,6 +1703,7 @@ tmg_complete_tryP () {
 
 tmscm
 tmg_get_input_mode () {
+  PROFILE_TALLY ("glue get-input-mode");
   // TMSCM_DEFER_INTS;
   int out= get_current_editor()->get_input_mode ();
   // TMSCM_ALLOW_INTS;
@@ -1571,6 +1713,7 @@ tmg_get_input_mode () {
 
 tmscm
 tmg_key_press_search (tmscm arg1) {
+  PROFILE_TALLY ("glue key-press-search");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "key-press-search");
 
   string in1= tmscm_to_string (arg1);
@@ -1584,6 +1727,7 @@ tmg_key_press_search (tmscm arg1) {
 
 tmscm
 tmg_key_press_replace (tmscm arg1) {
+  PROFILE_TALLY ("glue key-press-replace");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "key-press-replace");
 
   string in1= tmscm_to_string (arg1);
@@ -1597,6 +1741,7 @@ tmg_key_press_replace (tmscm arg1) {
 
 tmscm
 tmg_key_press_spell (tmscm arg1) {
+  PROFILE_TALLY ("glue key-press-spell");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "key-press-spell");
 
   string in1= tmscm_to_string (arg1);
@@ -1610,6 +1755,7 @@ tmg_key_press_spell (tmscm arg1) {
 
 tmscm
 tmg_key_press_complete (tmscm arg1) {
+  PROFILE_TALLY ("glue key-press-complete");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "key-press-complete");
 
   string in1= tmscm_to_string (arg1);
@@ -1623,6 +1769,7 @@ tmg_key_press_complete (tmscm arg1) {
 
 tmscm
 tmg_mouse_any (tmscm arg1, tmscm arg2, tmscm arg3, tmscm arg4, tmscm arg5) {
+  PROFILE_TALLY ("glue mouse-any");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "mouse-any");
   TMSCM_ASSERT_INT (arg2, TMSCM_ARG2, "mouse-any");
   TMSCM_ASSERT_INT (arg3, TMSCM_ARG3, "mouse-any");
@@ -1644,6 +1791,7 @@ tmg_mouse_any (tmscm arg1, tmscm arg2, tmscm arg3, tmscm arg4, tmscm arg5) {
 
 tmscm
 tmg_get_mouse_position () {
+  PROFILE_TALLY ("glue get-mouse-position");
   // TMSCM_DEFER_INTS;
   array_int out= get_current_editor()->get_mouse_position ();
   // TMSCM_ALLOW_INTS;
@@ -1653,6 +1801,7 @@ tmg_get_mouse_position () {
 
 tmscm
 tmg_set_mouse_pointer (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue set-mouse-pointer");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "set-mouse-pointer");
   TMSCM_ASSERT_STRING (arg2, TMSCM_ARG2, "set-mouse-pointer");
 
@@ -1668,6 +1817,7 @@ tmg_set_mouse_pointer (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_set_predef_mouse_pointer (tmscm arg1) {
+  PROFILE_TALLY ("glue set-predef-mouse-pointer");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "set-predef-mouse-pointer");
 
   string in1= tmscm_to_string (arg1);
@@ -1681,6 +1831,7 @@ tmg_set_predef_mouse_pointer (tmscm arg1) {
 
 tmscm
 tmg_go_to_path (tmscm arg1) {
+  PROFILE_TALLY ("glue go-to-path");
   TMSCM_ASSERT_PATH (arg1, TMSCM_ARG1, "go-to-path");
 
   path in1= tmscm_to_path (arg1);
@@ -1694,6 +1845,7 @@ tmg_go_to_path (tmscm arg1) {
 
 tmscm
 tmg_go_left () {
+  PROFILE_TALLY ("glue go-left");
   // TMSCM_DEFER_INTS;
   get_current_editor()->go_left ();
   // TMSCM_ALLOW_INTS;
@@ -1703,6 +1855,7 @@ tmg_go_left () {
 
 tmscm
 tmg_go_right () {
+  PROFILE_TALLY ("glue go-right");
   // TMSCM_DEFER_INTS;
   get_current_editor()->go_right ();
   // TMSCM_ALLOW_INTS;
@@ -1712,6 +1865,7 @@ tmg_go_right () {
 
 tmscm
 tmg_go_up () {
+  PROFILE_TALLY ("glue go-up");
   // TMSCM_DEFER_INTS;
   get_current_editor()->go_up ();
   // TMSCM_ALLOW_INTS;
@@ -1721,6 +1875,7 @@ tmg_go_up () {
 
 tmscm
 tmg_go_down () {
+  PROFILE_TALLY ("glue go-down");
   // TMSCM_DEFER_INTS;
   get_current_editor()->go_down ();
   // TMSCM_ALLOW_INTS;
@@ -1730,6 +1885,7 @@ tmg_go_down () {
 
 tmscm
 tmg_go_start () {
+  PROFILE_TALLY ("glue go-start");
   // TMSCM_DEFER_INTS;
   get_current_editor()->go_start ();
   // TMSCM_ALLOW_INTS;
@@ -1739,6 +1895,7 @@ tmg_go_start () {
 
 tmscm
 tmg_go_end () {
+  PROFILE_TALLY ("glue go-end");
   // TMSCM_DEFER_INTS;
   get_current_editor()->go_end ();
   // TMSCM_ALLOW_INTS;
@@ -1748,6 +1905,7 @@ tmg_go_end () {
 
 tmscm
 tmg_go_start_of (tmscm arg1) {
+  PROFILE_TALLY ("glue go-start-of");
   TMSCM_ASSERT_TREE_LABEL (arg1, TMSCM_ARG1, "go-start-of");
 
   tree_label in1= tmscm_to_tree_label (arg1);
@@ -1761,6 +1919,7 @@ tmg_go_start_of (tmscm arg1) {
 
 tmscm
 tmg_go_end_of (tmscm arg1) {
+  PROFILE_TALLY ("glue go-end-of");
   TMSCM_ASSERT_TREE_LABEL (arg1, TMSCM_ARG1, "go-end-of");
 
   tree_label in1= tmscm_to_tree_label (arg1);
@@ -1774,6 +1933,7 @@ tmg_go_end_of (tmscm arg1) {
 
 tmscm
 tmg_go_start_with (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue go-start-with");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "go-start-with");
   TMSCM_ASSERT_STRING (arg2, TMSCM_ARG2, "go-start-with");
 
@@ -1789,6 +1949,7 @@ tmg_go_start_with (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_go_end_with (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue go-end-with");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "go-end-with");
   TMSCM_ASSERT_STRING (arg2, TMSCM_ARG2, "go-end-with");
 
@@ -1804,6 +1965,7 @@ tmg_go_end_with (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_go_start_line () {
+  PROFILE_TALLY ("glue go-start-line");
   // TMSCM_DEFER_INTS;
   get_current_editor()->go_start_line ();
   // TMSCM_ALLOW_INTS;
@@ -1813,6 +1975,7 @@ tmg_go_start_line () {
 
 tmscm
 tmg_go_end_line () {
+  PROFILE_TALLY ("glue go-end-line");
   // TMSCM_DEFER_INTS;
   get_current_editor()->go_end_line ();
   // TMSCM_ALLOW_INTS;
@@ -1822,6 +1985,7 @@ tmg_go_end_line () {
 
 tmscm
 tmg_go_page_up () {
+  PROFILE_TALLY ("glue go-page-up");
   // TMSCM_DEFER_INTS;
   get_current_editor()->go_page_up ();
   // TMSCM_ALLOW_INTS;
@@ -1831,6 +1995,7 @@ tmg_go_page_up () {
 
 tmscm
 tmg_go_page_down () {
+  PROFILE_TALLY ("glue go-page-down");
   // TMSCM_DEFER_INTS;
   get_current_editor()->go_page_down ();
   // TMSCM_ALLOW_INTS;
@@ -1840,6 +2005,7 @@ tmg_go_page_down () {
 
 tmscm
 tmg_go_start_paragraph () {
+  PROFILE_TALLY ("glue go-start-paragraph");
   // TMSCM_DEFER_INTS;
   get_current_editor()->go_start_paragraph ();
   // TMSCM_ALLOW_INTS;
@@ -1849,6 +2015,7 @@ tmg_go_start_paragraph () {
 
 tmscm
 tmg_go_end_paragraph () {
+  PROFILE_TALLY ("glue go-end-paragraph");
   // TMSCM_DEFER_INTS;
   get_current_editor()->go_end_paragraph ();
   // TMSCM_ALLOW_INTS;
@@ -1858,6 +2025,7 @@ tmg_go_end_paragraph () {
 
 tmscm
 tmg_go_to_label (tmscm arg1) {
+  PROFILE_TALLY ("glue go-to-label");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "go-to-label");
 
   string in1= tmscm_to_string (arg1);
@@ -1871,6 +2039,7 @@ tmg_go_to_label (tmscm arg1) {
 
 tmscm
 tmg_cursor_accessibleP () {
+  PROFILE_TALLY ("glue cursor-accessible?");
   // TMSCM_DEFER_INTS;
   bool out= get_current_editor()->cursor_is_accessible ();
   // TMSCM_ALLOW_INTS;
@@ -1880,6 +2049,7 @@ tmg_cursor_accessibleP () {
 
 tmscm
 tmg_cursor_show_if_hidden () {
+  PROFILE_TALLY ("glue cursor-show-if-hidden");
   // TMSCM_DEFER_INTS;
   get_current_editor()->show_cursor_if_hidden ();
   // TMSCM_ALLOW_INTS;
@@ -1889,6 +2059,7 @@ tmg_cursor_show_if_hidden () {
 
 tmscm
 tmg_select_all () {
+  PROFILE_TALLY ("glue select-all");
   // TMSCM_DEFER_INTS;
   get_current_editor()->select_all ();
   // TMSCM_ALLOW_INTS;
@@ -1898,6 +2069,7 @@ tmg_select_all () {
 
 tmscm
 tmg_select_line () {
+  PROFILE_TALLY ("glue select-line");
   // TMSCM_DEFER_INTS;
   get_current_editor()->select_line ();
   // TMSCM_ALLOW_INTS;
@@ -1907,6 +2079,7 @@ tmg_select_line () {
 
 tmscm
 tmg_select_from_cursor () {
+  PROFILE_TALLY ("glue select-from-cursor");
   // TMSCM_DEFER_INTS;
   get_current_editor()->select_from_cursor ();
   // TMSCM_ALLOW_INTS;
@@ -1916,6 +2089,7 @@ tmg_select_from_cursor () {
 
 tmscm
 tmg_select_from_cursor_if_active () {
+  PROFILE_TALLY ("glue select-from-cursor-if-active");
   // TMSCM_DEFER_INTS;
   get_current_editor()->select_from_cursor_if_active ();
   // TMSCM_ALLOW_INTS;
@@ -1925,6 +2099,7 @@ tmg_select_from_cursor_if_active () {
 
 tmscm
 tmg_select_from_keyboard (tmscm arg1) {
+  PROFILE_TALLY ("glue select-from-keyboard");
   TMSCM_ASSERT_BOOL (arg1, TMSCM_ARG1, "select-from-keyboard");
 
   bool in1= tmscm_to_bool (arg1);
@@ -1938,6 +2113,7 @@ tmg_select_from_keyboard (tmscm arg1) {
 
 tmscm
 tmg_select_from_shift_keyboard () {
+  PROFILE_TALLY ("glue select-from-shift-keyboard");
   // TMSCM_DEFER_INTS;
   get_current_editor()->select_from_shift_keyboard ();
   // TMSCM_ALLOW_INTS;
@@ -1947,6 +2123,7 @@ tmg_select_from_shift_keyboard () {
 
 tmscm
 tmg_select_enlarge () {
+  PROFILE_TALLY ("glue select-enlarge");
   // TMSCM_DEFER_INTS;
   get_current_editor()->select_enlarge ();
   // TMSCM_ALLOW_INTS;
@@ -1956,6 +2133,7 @@ tmg_select_enlarge () {
 
 tmscm
 tmg_select_enlarge_environmental () {
+  PROFILE_TALLY ("glue select-enlarge-environmental");
   // TMSCM_DEFER_INTS;
   get_current_editor()->select_enlarge_environmental ();
   // TMSCM_ALLOW_INTS;
@@ -1965,6 +2143,7 @@ tmg_select_enlarge_environmental () {
 
 tmscm
 tmg_selection_active_anyP () {
+  PROFILE_TALLY ("glue selection-active-any?");
   // TMSCM_DEFER_INTS;
   bool out= get_current_editor()->selection_active_any ();
   // TMSCM_ALLOW_INTS;
@@ -1974,6 +2153,7 @@ tmg_selection_active_anyP () {
 
 tmscm
 tmg_selection_active_normalP () {
+  PROFILE_TALLY ("glue selection-active-normal?");
   // TMSCM_DEFER_INTS;
   bool out= get_current_editor()->selection_active_normal ();
   // TMSCM_ALLOW_INTS;
@@ -1983,6 +2163,7 @@ tmg_selection_active_normalP () {
 
 tmscm
 tmg_selection_active_tableP () {
+  PROFILE_TALLY ("glue selection-active-table?");
   // TMSCM_DEFER_INTS;
   bool out= get_current_editor()->selection_active_table ();
   // TMSCM_ALLOW_INTS;
@@ -1992,6 +2173,7 @@ tmg_selection_active_tableP () {
 
 tmscm
 tmg_selection_active_smallP () {
+  PROFILE_TALLY ("glue selection-active-small?");
   // TMSCM_DEFER_INTS;
   bool out= get_current_editor()->selection_active_small ();
   // TMSCM_ALLOW_INTS;
@@ -2001,6 +2183,7 @@ tmg_selection_active_smallP () {
 
 tmscm
 tmg_selection_active_enlargingP () {
+  PROFILE_TALLY ("glue selection-active-enlarging?");
   // TMSCM_DEFER_INTS;
   bool out= get_current_editor()->selection_active_enlarging ();
   // TMSCM_ALLOW_INTS;
@@ -2010,6 +2193,7 @@ tmg_selection_active_enlargingP () {
 
 tmscm
 tmg_selection_set_start () {
+  PROFILE_TALLY ("glue selection-set-start");
   // TMSCM_DEFER_INTS;
   get_current_editor()->selection_set_start ();
   // TMSCM_ALLOW_INTS;
@@ -2019,6 +2203,7 @@ tmg_selection_set_start () {
 
 tmscm
 tmg_selection_set_end () {
+  PROFILE_TALLY ("glue selection-set-end");
   // TMSCM_DEFER_INTS;
   get_current_editor()->selection_set_end ();
   // TMSCM_ALLOW_INTS;
@@ -2028,6 +2213,7 @@ tmg_selection_set_end () {
 
 tmscm
 tmg_selection_get_start () {
+  PROFILE_TALLY ("glue selection-get-start");
   // TMSCM_DEFER_INTS;
   path out= get_current_editor()->selection_get_start ();
   // TMSCM_ALLOW_INTS;
@@ -2037,6 +2223,7 @@ tmg_selection_get_start () {
 
 tmscm
 tmg_selection_get_end () {
+  PROFILE_TALLY ("glue selection-get-end");
   // TMSCM_DEFER_INTS;
   path out= get_current_editor()->selection_get_end ();
   // TMSCM_ALLOW_INTS;
@@ -2046,6 +2233,7 @@ tmg_selection_get_end () {
 
 tmscm
 tmg_selection_get_start_dot () {
+  PROFILE_TALLY ("glue selection-get-start*");
   // TMSCM_DEFER_INTS;
   path out= get_current_editor()->selection_var_get_start ();
   // TMSCM_ALLOW_INTS;
@@ -2055,6 +2243,7 @@ tmg_selection_get_start_dot () {
 
 tmscm
 tmg_selection_get_end_dot () {
+  PROFILE_TALLY ("glue selection-get-end*");
   // TMSCM_DEFER_INTS;
   path out= get_current_editor()->selection_var_get_end ();
   // TMSCM_ALLOW_INTS;
@@ -2064,6 +2253,7 @@ tmg_selection_get_end_dot () {
 
 tmscm
 tmg_selection_path () {
+  PROFILE_TALLY ("glue selection-path");
   // TMSCM_DEFER_INTS;
   path out= get_current_editor()->selection_get_path ();
   // TMSCM_ALLOW_INTS;
@@ -2073,6 +2263,7 @@ tmg_selection_path () {
 
 tmscm
 tmg_selection_set (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue selection-set");
   TMSCM_ASSERT_PATH (arg1, TMSCM_ARG1, "selection-set");
   TMSCM_ASSERT_PATH (arg2, TMSCM_ARG2, "selection-set");
 
@@ -2088,6 +2279,7 @@ tmg_selection_set (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_selection_set_range_set (tmscm arg1) {
+  PROFILE_TALLY ("glue selection-set-range-set");
   TMSCM_ASSERT_ARRAY_PATH (arg1, TMSCM_ARG1, "selection-set-range-set");
 
   array_path in1= tmscm_to_array_path (arg1);
@@ -2101,6 +2293,7 @@ tmg_selection_set_range_set (tmscm arg1) {
 
 tmscm
 tmg_clipboard_set (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue clipboard-set");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "clipboard-set");
   TMSCM_ASSERT_CONTENT (arg2, TMSCM_ARG2, "clipboard-set");
 
@@ -2116,6 +2309,7 @@ tmg_clipboard_set (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_clipboard_get (tmscm arg1) {
+  PROFILE_TALLY ("glue clipboard-get");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "clipboard-get");
 
   string in1= tmscm_to_string (arg1);
@@ -2129,6 +2323,7 @@ tmg_clipboard_get (tmscm arg1) {
 
 tmscm
 tmg_cpp_clipboard_copy (tmscm arg1) {
+  PROFILE_TALLY ("glue cpp-clipboard-copy");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "cpp-clipboard-copy");
 
   string in1= tmscm_to_string (arg1);
@@ -2142,6 +2337,7 @@ tmg_cpp_clipboard_copy (tmscm arg1) {
 
 tmscm
 tmg_cpp_clipboard_cut (tmscm arg1) {
+  PROFILE_TALLY ("glue cpp-clipboard-cut");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "cpp-clipboard-cut");
 
   string in1= tmscm_to_string (arg1);
@@ -2155,6 +2351,7 @@ tmg_cpp_clipboard_cut (tmscm arg1) {
 
 tmscm
 tmg_clipboard_cut_at (tmscm arg1) {
+  PROFILE_TALLY ("glue clipboard-cut-at");
   TMSCM_ASSERT_PATH (arg1, TMSCM_ARG1, "clipboard-cut-at");
 
   path in1= tmscm_to_path (arg1);
@@ -2168,6 +2365,7 @@ tmg_clipboard_cut_at (tmscm arg1) {
 
 tmscm
 tmg_clipboard_cut_between (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue clipboard-cut-between");
   TMSCM_ASSERT_PATH (arg1, TMSCM_ARG1, "clipboard-cut-between");
   TMSCM_ASSERT_PATH (arg2, TMSCM_ARG2, "clipboard-cut-between");
 
@@ -2183,6 +2381,7 @@ tmg_clipboard_cut_between (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_cpp_clipboard_paste (tmscm arg1) {
+  PROFILE_TALLY ("glue cpp-clipboard-paste");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "cpp-clipboard-paste");
 
   string in1= tmscm_to_string (arg1);
@@ -2196,6 +2395,7 @@ tmg_cpp_clipboard_paste (tmscm arg1) {
 
 tmscm
 tmg_selection_move () {
+  PROFILE_TALLY ("glue selection-move");
   // TMSCM_DEFER_INTS;
   get_current_editor()->selection_move ();
   // TMSCM_ALLOW_INTS;
@@ -2205,6 +2405,7 @@ tmg_selection_move () {
 
 tmscm
 tmg_clipboard_clear (tmscm arg1) {
+  PROFILE_TALLY ("glue clipboard-clear");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "clipboard-clear");
 
   string in1= tmscm_to_string (arg1);
@@ -2218,6 +2419,7 @@ tmg_clipboard_clear (tmscm arg1) {
 
 tmscm
 tmg_selection_cancel () {
+  PROFILE_TALLY ("glue selection-cancel");
   // TMSCM_DEFER_INTS;
   get_current_editor()->selection_cancel ();
   // TMSCM_ALLOW_INTS;
@@ -2227,6 +2429,7 @@ tmg_selection_cancel () {
 
 tmscm
 tmg_clipboard_set_import (tmscm arg1) {
+  PROFILE_TALLY ("glue clipboard-set-import");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "clipboard-set-import");
 
   string in1= tmscm_to_string (arg1);
@@ -2240,6 +2443,7 @@ tmg_clipboard_set_import (tmscm arg1) {
 
 tmscm
 tmg_clipboard_set_export (tmscm arg1) {
+  PROFILE_TALLY ("glue clipboard-set-export");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "clipboard-set-export");
 
   string in1= tmscm_to_string (arg1);
@@ -2253,6 +2457,7 @@ tmg_clipboard_set_export (tmscm arg1) {
 
 tmscm
 tmg_clipboard_get_import () {
+  PROFILE_TALLY ("glue clipboard-get-import");
   // TMSCM_DEFER_INTS;
   string out= get_current_editor()->selection_get_import ();
   // TMSCM_ALLOW_INTS;
@@ -2262,6 +2467,7 @@ tmg_clipboard_get_import () {
 
 tmscm
 tmg_clipboard_get_export () {
+  PROFILE_TALLY ("glue clipboard-get-export");
   // TMSCM_DEFER_INTS;
   string out= get_current_editor()->selection_get_export ();
   // TMSCM_ALLOW_INTS;
@@ -2271,6 +2477,7 @@ tmg_clipboard_get_export () {
 
 tmscm
 tmg_set_manual_focus_path (tmscm arg1) {
+  PROFILE_TALLY ("glue set-manual-focus-path");
   TMSCM_ASSERT_PATH (arg1, TMSCM_ARG1, "set-manual-focus-path");
 
   path in1= tmscm_to_path (arg1);
@@ -2284,6 +2491,7 @@ tmg_set_manual_focus_path (tmscm arg1) {
 
 tmscm
 tmg_get_manual_focus_path () {
+  PROFILE_TALLY ("glue get-manual-focus-path");
   // TMSCM_DEFER_INTS;
   path out= get_current_editor()->manual_focus_get ();
   // TMSCM_ALLOW_INTS;
@@ -2293,6 +2501,7 @@ tmg_get_manual_focus_path () {
 
 tmscm
 tmg_get_focus_path () {
+  PROFILE_TALLY ("glue get-focus-path");
   // TMSCM_DEFER_INTS;
   path out= get_current_editor()->focus_get ();
   // TMSCM_ALLOW_INTS;
@@ -2302,6 +2511,7 @@ tmg_get_focus_path () {
 
 tmscm
 tmg_set_alt_selection (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue set-alt-selection");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "set-alt-selection");
   TMSCM_ASSERT_ARRAY_PATH (arg2, TMSCM_ARG2, "set-alt-selection");
 
@@ -2317,6 +2527,7 @@ tmg_set_alt_selection (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_get_alt_selection (tmscm arg1) {
+  PROFILE_TALLY ("glue get-alt-selection");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "get-alt-selection");
 
   string in1= tmscm_to_string (arg1);
@@ -2330,6 +2541,7 @@ tmg_get_alt_selection (tmscm arg1) {
 
 tmscm
 tmg_cancel_alt_selection (tmscm arg1) {
+  PROFILE_TALLY ("glue cancel-alt-selection");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "cancel-alt-selection");
 
   string in1= tmscm_to_string (arg1);
@@ -2343,6 +2555,7 @@ tmg_cancel_alt_selection (tmscm arg1) {
 
 tmscm
 tmg_cancel_alt_selections () {
+  PROFILE_TALLY ("glue cancel-alt-selections");
   // TMSCM_DEFER_INTS;
   get_current_editor()->cancel_alt_selections ();
   // TMSCM_ALLOW_INTS;
@@ -2352,6 +2565,7 @@ tmg_cancel_alt_selections () {
 
 tmscm
 tmg_clear_undo_history () {
+  PROFILE_TALLY ("glue clear-undo-history");
   // TMSCM_DEFER_INTS;
   get_current_editor()->clear_undo_history ();
   // TMSCM_ALLOW_INTS;
@@ -2361,6 +2575,7 @@ tmg_clear_undo_history () {
 
 tmscm
 tmg_commit_changes () {
+  PROFILE_TALLY ("glue commit-changes");
   // TMSCM_DEFER_INTS;
   get_current_editor()->end_editing ();
   // TMSCM_ALLOW_INTS;
@@ -2370,6 +2585,7 @@ tmg_commit_changes () {
 
 tmscm
 tmg_start_slave (tmscm arg1) {
+  PROFILE_TALLY ("glue start-slave");
   TMSCM_ASSERT_DOUBLE (arg1, TMSCM_ARG1, "start-slave");
 
   double in1= tmscm_to_double (arg1);
@@ -2383,6 +2599,7 @@ tmg_start_slave (tmscm arg1) {
 
 tmscm
 tmg_mark_start (tmscm arg1) {
+  PROFILE_TALLY ("glue mark-start");
   TMSCM_ASSERT_DOUBLE (arg1, TMSCM_ARG1, "mark-start");
 
   double in1= tmscm_to_double (arg1);
@@ -2396,6 +2613,7 @@ tmg_mark_start (tmscm arg1) {
 
 tmscm
 tmg_mark_end (tmscm arg1) {
+  PROFILE_TALLY ("glue mark-end");
   TMSCM_ASSERT_DOUBLE (arg1, TMSCM_ARG1, "mark-end");
 
   double in1= tmscm_to_double (arg1);
@@ -2409,6 +2627,7 @@ tmg_mark_end (tmscm arg1) {
 
 tmscm
 tmg_mark_cancel (tmscm arg1) {
+  PROFILE_TALLY ("glue mark-cancel");
   TMSCM_ASSERT_DOUBLE (arg1, TMSCM_ARG1, "mark-cancel");
 
   double in1= tmscm_to_double (arg1);
@@ -2422,6 +2641,7 @@ tmg_mark_cancel (tmscm arg1) {
 
 tmscm
 tmg_remove_undo_mark () {
+  PROFILE_TALLY ("glue remove-undo-mark");
   // TMSCM_DEFER_INTS;
   get_current_editor()->remove_undo_mark ();
   // TMSCM_ALLOW_INTS;
@@ -2431,6 +2651,7 @@ tmg_remove_undo_mark () {
 
 tmscm
 tmg_add_undo_mark () {
+  PROFILE_TALLY ("glue add-undo-mark");
   // TMSCM_DEFER_INTS;
   get_current_editor()->add_undo_mark ();
   // TMSCM_ALLOW_INTS;
@@ -2440,6 +2661,7 @@ tmg_add_undo_mark () {
 
 tmscm
 tmg_unredoable_undo () {
+  PROFILE_TALLY ("glue unredoable-undo");
   // TMSCM_DEFER_INTS;
   get_current_editor()->unredoable_undo ();
   // TMSCM_ALLOW_INTS;
@@ -2449,6 +2671,7 @@ tmg_unredoable_undo () {
 
 tmscm
 tmg_undo_possibilities () {
+  PROFILE_TALLY ("glue undo-possibilities");
   // TMSCM_DEFER_INTS;
   int out= get_current_editor()->undo_possibilities ();
   // TMSCM_ALLOW_INTS;
@@ -2458,6 +2681,7 @@ tmg_undo_possibilities () {
 
 tmscm
 tmg_undo (tmscm arg1) {
+  PROFILE_TALLY ("glue undo");
   TMSCM_ASSERT_INT (arg1, TMSCM_ARG1, "undo");
 
   int in1= tmscm_to_int (arg1);
@@ -2471,6 +2695,7 @@ tmg_undo (tmscm arg1) {
 
 tmscm
 tmg_redo_possibilities () {
+  PROFILE_TALLY ("glue redo-possibilities");
   // TMSCM_DEFER_INTS;
   int out= get_current_editor()->redo_possibilities ();
   // TMSCM_ALLOW_INTS;
@@ -2480,6 +2705,7 @@ tmg_redo_possibilities () {
 
 tmscm
 tmg_redo (tmscm arg1) {
+  PROFILE_TALLY ("glue redo");
   TMSCM_ASSERT_INT (arg1, TMSCM_ARG1, "redo");
 
   int in1= tmscm_to_int (arg1);
@@ -2493,6 +2719,7 @@ tmg_redo (tmscm arg1) {
 
 tmscm
 tmg_show_history () {
+  PROFILE_TALLY ("glue show-history");
   // TMSCM_DEFER_INTS;
   get_current_editor()->show_history ();
   // TMSCM_ALLOW_INTS;
@@ -2502,6 +2729,7 @@ tmg_show_history () {
 
 tmscm
 tmg_archive_state () {
+  PROFILE_TALLY ("glue archive-state");
   // TMSCM_DEFER_INTS;
   get_current_editor()->archive_state ();
   // TMSCM_ALLOW_INTS;
@@ -2511,6 +2739,7 @@ tmg_archive_state () {
 
 tmscm
 tmg_start_editing () {
+  PROFILE_TALLY ("glue start-editing");
   // TMSCM_DEFER_INTS;
   get_current_editor()->start_editing ();
   // TMSCM_ALLOW_INTS;
@@ -2520,6 +2749,7 @@ tmg_start_editing () {
 
 tmscm
 tmg_end_editing () {
+  PROFILE_TALLY ("glue end-editing");
   // TMSCM_DEFER_INTS;
   get_current_editor()->end_editing ();
   // TMSCM_ALLOW_INTS;
@@ -2529,6 +2759,7 @@ tmg_end_editing () {
 
 tmscm
 tmg_cancel_editing () {
+  PROFILE_TALLY ("glue cancel-editing");
   // TMSCM_DEFER_INTS;
   get_current_editor()->cancel_editing ();
   // TMSCM_ALLOW_INTS;
@@ -2538,6 +2769,7 @@ tmg_cancel_editing () {
 
 tmscm
 tmg_in_graphicsP () {
+  PROFILE_TALLY ("glue in-graphics?");
   // TMSCM_DEFER_INTS;
   bool out= get_current_editor()->inside_graphics ();
   // TMSCM_ALLOW_INTS;
@@ -2547,6 +2779,7 @@ tmg_in_graphicsP () {
 
 tmscm
 tmg_get_graphical_x () {
+  PROFILE_TALLY ("glue get-graphical-x");
   // TMSCM_DEFER_INTS;
   double out= get_current_editor()->get_x ();
   // TMSCM_ALLOW_INTS;
@@ -2556,6 +2789,7 @@ tmg_get_graphical_x () {
 
 tmscm
 tmg_get_graphical_y () {
+  PROFILE_TALLY ("glue get-graphical-y");
   // TMSCM_DEFER_INTS;
   double out= get_current_editor()->get_y ();
   // TMSCM_ALLOW_INTS;
@@ -2565,6 +2799,7 @@ tmg_get_graphical_y () {
 
 tmscm
 tmg_get_graphical_object () {
+  PROFILE_TALLY ("glue get-graphical-object");
   // TMSCM_DEFER_INTS;
   tree out= get_current_editor()->get_graphical_object ();
   // TMSCM_ALLOW_INTS;
@@ -2574,6 +2809,7 @@ tmg_get_graphical_object () {
 
 tmscm
 tmg_set_graphical_object (tmscm arg1) {
+  PROFILE_TALLY ("glue set-graphical-object");
   TMSCM_ASSERT_TREE (arg1, TMSCM_ARG1, "set-graphical-object");
 
   tree in1= tmscm_to_tree (arg1);
@@ -2587,6 +2823,7 @@ tmg_set_graphical_object (tmscm arg1) {
 
 tmscm
 tmg_invalidate_graphical_object () {
+  PROFILE_TALLY ("glue invalidate-graphical-object");
   // TMSCM_DEFER_INTS;
   get_current_editor()->invalidate_graphical_object ();
   // TMSCM_ALLOW_INTS;
@@ -2596,6 +2833,7 @@ tmg_invalidate_graphical_object () {
 
 tmscm
 tmg_graphical_select (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue graphical-select");
   TMSCM_ASSERT_DOUBLE (arg1, TMSCM_ARG1, "graphical-select");
   TMSCM_ASSERT_DOUBLE (arg2, TMSCM_ARG2, "graphical-select");
 
@@ -2611,6 +2849,7 @@ tmg_graphical_select (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_graphical_select_area (tmscm arg1, tmscm arg2, tmscm arg3, tmscm arg4) {
+  PROFILE_TALLY ("glue graphical-select-area");
   TMSCM_ASSERT_DOUBLE (arg1, TMSCM_ARG1, "graphical-select-area");
   TMSCM_ASSERT_DOUBLE (arg2, TMSCM_ARG2, "graphical-select-area");
   TMSCM_ASSERT_DOUBLE (arg3, TMSCM_ARG3, "graphical-select-area");
@@ -2630,6 +2869,7 @@ tmg_graphical_select_area (tmscm arg1, tmscm arg2, tmscm arg3, tmscm arg4) {
 
 tmscm
 tmg_in_normal_modeP () {
+  PROFILE_TALLY ("glue in-normal-mode?");
   // TMSCM_DEFER_INTS;
   bool out= get_current_editor()->in_normal_mode ();
   // TMSCM_ALLOW_INTS;
@@ -2639,6 +2879,7 @@ tmg_in_normal_modeP () {
 
 tmscm
 tmg_in_search_modeP () {
+  PROFILE_TALLY ("glue in-search-mode?");
   // TMSCM_DEFER_INTS;
   bool out= get_current_editor()->in_search_mode ();
   // TMSCM_ALLOW_INTS;
@@ -2648,6 +2889,7 @@ tmg_in_search_modeP () {
 
 tmscm
 tmg_in_replace_modeP () {
+  PROFILE_TALLY ("glue in-replace-mode?");
   // TMSCM_DEFER_INTS;
   bool out= get_current_editor()->in_replace_mode ();
   // TMSCM_ALLOW_INTS;
@@ -2657,6 +2899,7 @@ tmg_in_replace_modeP () {
 
 tmscm
 tmg_in_spell_modeP () {
+  PROFILE_TALLY ("glue in-spell-mode?");
   // TMSCM_DEFER_INTS;
   bool out= get_current_editor()->in_spell_mode ();
   // TMSCM_ALLOW_INTS;
@@ -2666,6 +2909,7 @@ tmg_in_spell_modeP () {
 
 tmscm
 tmg_search_start (tmscm arg1) {
+  PROFILE_TALLY ("glue search-start");
   TMSCM_ASSERT_BOOL (arg1, TMSCM_ARG1, "search-start");
 
   bool in1= tmscm_to_bool (arg1);
@@ -2679,6 +2923,7 @@ tmg_search_start (tmscm arg1) {
 
 tmscm
 tmg_search_button_next () {
+  PROFILE_TALLY ("glue search-button-next");
   // TMSCM_DEFER_INTS;
   get_current_editor()->search_button_next ();
   // TMSCM_ALLOW_INTS;
@@ -2688,6 +2933,7 @@ tmg_search_button_next () {
 
 tmscm
 tmg_replace_start (tmscm arg1, tmscm arg2, tmscm arg3) {
+  PROFILE_TALLY ("glue replace-start");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "replace-start");
   TMSCM_ASSERT_STRING (arg2, TMSCM_ARG2, "replace-start");
   TMSCM_ASSERT_BOOL (arg3, TMSCM_ARG3, "replace-start");
@@ -2703,8 +2949,25 @@ tmg_replace_start (tmscm arg1, tmscm arg2, tmscm arg3) {
   return TMSCM_UNSPECIFIED;
 }
 
+tmscm
+tmg_replace_all_occurrences (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue replace-all-occurrences");
+  TMSCM_ASSERT_ARRAY_PATH (arg1, TMSCM_ARG1, "replace-all-occurrences");
+  TMSCM_ASSERT_CONTENT (arg2, TMSCM_ARG2, "replace-all-occurrences");
+
+  array_path in1= tmscm_to_array_path (arg1);
+  content in2= tmscm_to_content (arg2);
+
+  // TMSCM_DEFER_INTS;
+  int out= get_current_editor()->replace_all (in1, in2);
+  // TMSCM_ALLOW_INTS;
+
+  return int_to_tmscm (out);
+}
+
 tmscm
 tmg_spell_start () {
+  PROFILE_TALLY ("glue spell-start");
   // TMSCM_DEFER_INTS;
   get_current_editor()->spell_start ();
   // TMSCM_ALLOW_INTS;
@@ -2714,6 +2977,7 @@ tmg_spell_start () {
 
 tmscm
 tmg_spell_replace (tmscm arg1) {
+  PROFILE_TALLY ("glue spell-replace");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "spell-replace");
 
   string in1= tmscm_to_string (arg1);
@@ -2727,6 +2991,7 @@ tmg_spell_replace (tmscm arg1) {
 
 tmscm
 tmg_session_complete_command (tmscm arg1) {
+  PROFILE_TALLY ("glue session-complete-command");
   TMSCM_ASSERT_TREE (arg1, TMSCM_ARG1, "session-complete-command");
 
   tree in1= tmscm_to_tree (arg1);
@@ -2740,6 +3005,7 @@ tmg_session_complete_command (tmscm arg1) {
 
 tmscm
 tmg_custom_complete (tmscm arg1) {
+  PROFILE_TALLY ("glue custom-complete");
   TMSCM_ASSERT_TREE (arg1, TMSCM_ARG1, "custom-complete");
 
   tree in1= tmscm_to_tree (arg1);
@@ -2753,6 +3019,7 @@ tmg_custom_complete (tmscm arg1) {
 
 tmscm
 tmg_keyboard_focus_on (tmscm arg1) {
+  PROFILE_TALLY ("glue keyboard-focus-on");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "keyboard-focus-on");
 
   string in1= tmscm_to_string (arg1);
@@ -2766,6 +3033,7 @@ tmg_keyboard_focus_on (tmscm arg1) {
 
 tmscm
 tmg_view_set_property (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue view-set-property");
   TMSCM_ASSERT_SCHEME_TREE (arg1, TMSCM_ARG1, "view-set-property");
   TMSCM_ASSERT_SCHEME_TREE (arg2, TMSCM_ARG2, "view-set-property");
 
@@ -2781,6 +3049,7 @@ tmg_view_set_property (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_view_get_property (tmscm arg1) {
+  PROFILE_TALLY ("glue view-get-property");
   TMSCM_ASSERT_SCHEME_TREE (arg1, TMSCM_ARG1, "view-get-property");
 
   scheme_tree in1= tmscm_to_scheme_tree (arg1);
@@ -2794,6 +3063,7 @@ tmg_view_get_property (tmscm arg1) {
 
 tmscm
 tmg_get_window_width () {
+  PROFILE_TALLY ("glue get-window-width");
   // TMSCM_DEFER_INTS;
   int out= get_current_editor()->get_window_width ();
   // TMSCM_ALLOW_INTS;
@@ -2803,6 +3073,7 @@ tmg_get_window_width () {
 
 tmscm
 tmg_get_window_height () {
+  PROFILE_TALLY ("glue get-window-height");
   // TMSCM_DEFER_INTS;
   int out= get_current_editor()->get_window_height ();
   // TMSCM_ALLOW_INTS;
@@ -2812,6 +3083,7 @@ tmg_get_window_height () {
 
 tmscm
 tmg_clear_buffer () {
+  PROFILE_TALLY ("glue clear-buffer");
   // TMSCM_DEFER_INTS;
   get_current_editor()->clear_buffer ();
   // TMSCM_ALLOW_INTS;
@@ -2821,6 +3093,7 @@ tmg_clear_buffer () {
 
 tmscm
 tmg_tex_buffer () {
+  PROFILE_TALLY ("glue tex-buffer");
   // TMSCM_DEFER_INTS;
   get_current_editor()->tex_buffer ();
   // TMSCM_ALLOW_INTS;
@@ -2830,6 +3103,7 @@ tmg_tex_buffer () {
 
 tmscm
 tmg_clear_local_info () {
+  PROFILE_TALLY ("glue clear-local-info");
   // TMSCM_DEFER_INTS;
   get_current_editor()->clear_local_info ();
   // TMSCM_ALLOW_INTS;
@@ -2839,6 +3113,7 @@ tmg_clear_local_info () {
 
 tmscm
 tmg_refresh_window () {
+  PROFILE_TALLY ("glue refresh-window");
   // TMSCM_DEFER_INTS;
   get_current_editor()->invalidate_all ();
   // TMSCM_ALLOW_INTS;
@@ -2848,6 +3123,7 @@ tmg_refresh_window () {
 
 tmscm
 tmg_update_forced () {
+  PROFILE_TALLY ("glue update-forced");
   // TMSCM_DEFER_INTS;
   get_current_editor()->typeset_forced ();
   // TMSCM_ALLOW_INTS;
@@ -2857,6 +3133,7 @@ tmg_update_forced () {
 
 tmscm
 tmg_update_path (tmscm arg1) {
+  PROFILE_TALLY ("glue update-path");
   TMSCM_ASSERT_PATH (arg1, TMSCM_ARG1, "update-path");
 
   path in1= tmscm_to_path (arg1);
@@ -2870,6 +3147,7 @@ tmg_update_path (tmscm arg1) {
 
 tmscm
 tmg_update_current_buffer () {
+  PROFILE_TALLY ("glue update-current-buffer");
   // TMSCM_DEFER_INTS;
   get_current_editor()->typeset_invalidate_all ();
   // TMSCM_ALLOW_INTS;
@@ -2879,6 +3157,7 @@ tmg_update_current_buffer () {
 
 tmscm
 tmg_update_players (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue update-players");
   TMSCM_ASSERT_PATH (arg1, TMSCM_ARG1, "update-players");
   TMSCM_ASSERT_BOOL (arg2, TMSCM_ARG2, "update-players");
 
@@ -2894,6 +3173,7 @@ tmg_update_players (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_generate_all_aux () {
+  PROFILE_TALLY ("glue generate-all-aux");
   // TMSCM_DEFER_INTS;
   get_current_editor()->generate_aux ();
   // TMSCM_ALLOW_INTS;
@@ -2903,6 +3183,7 @@ tmg_generate_all_aux () {
 
 tmscm
 tmg_generate_aux (tmscm arg1) {
+  PROFILE_TALLY ("glue generate-aux");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "generate-aux");
 
   string in1= tmscm_to_string (arg1);
@@ -2916,6 +3197,7 @@ tmg_generate_aux (tmscm arg1) {
 
 tmscm
 tmg_notify_page_change () {
+  PROFILE_TALLY ("glue notify-page-change");
   // TMSCM_DEFER_INTS;
   get_current_editor()->notify_page_change ();
   // TMSCM_ALLOW_INTS;
@@ -2925,6 +3207,7 @@ tmg_notify_page_change () {
 
 tmscm
 tmg_notify_change (tmscm arg1) {
+  PROFILE_TALLY ("glue notify-change");
   TMSCM_ASSERT_INT (arg1, TMSCM_ARG1, "notify-change");
 
   int in1= tmscm_to_int (arg1);
@@ -2938,6 +3221,7 @@ tmg_notify_change (tmscm arg1) {
 
 tmscm
 tmg_get_metadata (tmscm arg1) {
+  PROFILE_TALLY ("glue get-metadata");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "get-metadata");
 
   string in1= tmscm_to_string (arg1);
@@ -2951,6 +3235,7 @@ tmg_get_metadata (tmscm arg1) {
 
 tmscm
 tmg_cpp_nr_pages () {
+  PROFILE_TALLY ("glue cpp-nr-pages");
   // TMSCM_DEFER_INTS;
   int out= get_current_editor()->nr_pages ();
   // TMSCM_ALLOW_INTS;
@@ -2960,6 +3245,7 @@ tmg_cpp_nr_pages () {
 
 tmscm
 tmg_print_to_file (tmscm arg1) {
+  PROFILE_TALLY ("glue print-to-file");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "print-to-file");
 
   url in1= tmscm_to_url (arg1);
@@ -2973,6 +3259,7 @@ tmg_print_to_file (tmscm arg1) {
 
 tmscm
 tmg_print_pages_to_file (tmscm arg1, tmscm arg2, tmscm arg3) {
+  PROFILE_TALLY ("glue print-pages-to-file");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "print-pages-to-file");
   TMSCM_ASSERT_STRING (arg2, TMSCM_ARG2, "print-pages-to-file");
   TMSCM_ASSERT_STRING (arg3, TMSCM_ARG3, "print-pages-to-file");
@@ -2990,6 +3277,7 @@ tmg_print_pages_to_file (tmscm arg1, tmscm arg2, tmscm arg3) {
 
 tmscm
 tmg_print () {
+  PROFILE_TALLY ("glue print");
   // TMSCM_DEFER_INTS;
   get_current_editor()->print_buffer ();
   // TMSCM_ALLOW_INTS;
@@ -2999,6 +3287,7 @@ tmg_print () {
 
 tmscm
 tmg_print_pages (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue print-pages");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "print-pages");
   TMSCM_ASSERT_STRING (arg2, TMSCM_ARG2, "print-pages");
 
@@ -3014,6 +3303,7 @@ tmg_print_pages (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_print_snippet (tmscm arg1, tmscm arg2, tmscm arg3) {
+  PROFILE_TALLY ("glue print-snippet");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "print-snippet");
   TMSCM_ASSERT_CONTENT (arg2, TMSCM_ARG2, "print-snippet");
   TMSCM_ASSERT_BOOL (arg3, TMSCM_ARG3, "print-snippet");
@@ -3031,6 +3321,7 @@ tmg_print_snippet (tmscm arg1, tmscm arg2, tmscm arg3) {
 
 tmscm
 tmg_graphics_file_to_clipboard (tmscm arg1) {
+  PROFILE_TALLY ("glue graphics-file-to-clipboard");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "graphics-file-to-clipboard");
 
   url in1= tmscm_to_url (arg1);
@@ -3044,6 +3335,7 @@ tmg_graphics_file_to_clipboard (tmscm arg1) {
 
 tmscm
 tmg_export_postscript (tmscm arg1) {
+  PROFILE_TALLY ("glue export-postscript");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "export-postscript");
 
   url in1= tmscm_to_url (arg1);
@@ -3057,6 +3349,7 @@ tmg_export_postscript (tmscm arg1) {
 
 tmscm
 tmg_export_pages_postscript (tmscm arg1, tmscm arg2, tmscm arg3) {
+  PROFILE_TALLY ("glue export-pages-postscript");
   TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "export-pages-postscript");
   TMSCM_ASSERT_STRING (arg2, TMSCM_ARG2, "export-pages-postscript");
   TMSCM_ASSERT_STRING (arg3, TMSCM_ARG3, "export-pages-postscript");
@@ -3072,8 +3365,39 @@ tmg_export_pages_postscript (tmscm arg1, tmscm arg2, tmscm arg3) {
   return TMSCM_UNSPECIFIED;
 }
 
+tmscm
+tmg_typeset_pages () {
+  PROFILE_TALLY ("glue typeset-pages");
+  // TMSCM_DEFER_INTS;
+  int out= get_current_editor()->typeset_pages ();
+  // TMSCM_ALLOW_INTS;
+
+  return int_to_tmscm (out);
+}
+
+tmscm
+tmg_export_pages_raster (tmscm arg1, tmscm arg2, tmscm arg3, tmscm arg4) {
+  PROFILE_TALLY ("glue export-pages-raster");
+  TMSCM_ASSERT_URL (arg1, TMSCM_ARG1, "export-pages-raster");
+  TMSCM_ASSERT_INT (arg2, TMSCM_ARG2, "export-pages-raster");
+  TMSCM_ASSERT_STRING (arg3, TMSCM_ARG3, "export-pages-raster");
+  TMSCM_ASSERT_STRING (arg4, TMSCM_ARG4, "export-pages-raster");
+
+  url in1= tmscm_to_url (arg1);
+  int in2= tmscm_to_int (arg2);
+  string in3= tmscm_to_string (arg3);
+  string in4= tmscm_to_string (arg4);
+
+  // TMSCM_DEFER_INTS;
+  get_current_editor()->export_raster (in1, in2, in3, in4);
+  // TMSCM_ALLOW_INTS;
+
+  return TMSCM_UNSPECIFIED;
+}
+
 tmscm
 tmg_footer_eval (tmscm arg1) {
+  PROFILE_TALLY ("glue footer-eval");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "footer-eval");
 
   string in1= tmscm_to_string (arg1);
@@ -3087,6 +3411,7 @@ tmg_footer_eval (tmscm arg1) {
 
 tmscm
 tmg_texmacs_exec (tmscm arg1) {
+  PROFILE_TALLY ("glue texmacs-exec");
   TMSCM_ASSERT_CONTENT (arg1, TMSCM_ARG1, "texmacs-exec");
 
   content in1= tmscm_to_content (arg1);
@@ -3100,6 +3425,7 @@ tmg_texmacs_exec (tmscm arg1) {
 
 tmscm
 tmg_texmacs_exec_dot (tmscm arg1) {
+  PROFILE_TALLY ("glue texmacs-exec*");
   TMSCM_ASSERT_CONTENT (arg1, TMSCM_ARG1, "texmacs-exec*");
 
   content in1= tmscm_to_content (arg1);
@@ -3113,6 +3439,7 @@ tmg_texmacs_exec_dot (tmscm arg1) {
 
 tmscm
 tmg_texmacs_expand (tmscm arg1) {
+  PROFILE_TALLY ("glue texmacs-expand");
   TMSCM_ASSERT_CONTENT (arg1, TMSCM_ARG1, "texmacs-expand");
 
   content in1= tmscm_to_content (arg1);
@@ -3126,6 +3453,7 @@ tmg_texmacs_expand (tmscm arg1) {
 
 tmscm
 tmg_verbatim_expand (tmscm arg1) {
+  PROFILE_TALLY ("glue verbatim-expand");
   TMSCM_ASSERT_CONTENT (arg1, TMSCM_ARG1, "verbatim-expand");
 
   content in1= tmscm_to_content (arg1);
@@ -3139,6 +3467,7 @@ tmg_verbatim_expand (tmscm arg1) {
 
 tmscm
 tmg_latex_expand (tmscm arg1) {
+  PROFILE_TALLY ("glue latex-expand");
   TMSCM_ASSERT_CONTENT (arg1, TMSCM_ARG1, "latex-expand");
 
   content in1= tmscm_to_content (arg1);
@@ -3152,6 +3481,7 @@ tmg_latex_expand (tmscm arg1) {
 
 tmscm
 tmg_html_expand (tmscm arg1) {
+  PROFILE_TALLY ("glue html-expand");
   TMSCM_ASSERT_CONTENT (arg1, TMSCM_ARG1, "html-expand");
 
   content in1= tmscm_to_content (arg1);
@@ -3165,6 +3495,7 @@ tmg_html_expand (tmscm arg1) {
 
 tmscm
 tmg_animate_checkout (tmscm arg1) {
+  PROFILE_TALLY ("glue animate-checkout");
   TMSCM_ASSERT_CONTENT (arg1, TMSCM_ARG1, "animate-checkout");
 
   content in1= tmscm_to_content (arg1);
@@ -3178,6 +3509,7 @@ tmg_animate_checkout (tmscm arg1) {
 
 tmscm
 tmg_animate_commit (tmscm arg1) {
+  PROFILE_TALLY ("glue animate-commit");
   TMSCM_ASSERT_CONTENT (arg1, TMSCM_ARG1, "animate-commit");
 
   content in1= tmscm_to_content (arg1);
@@ -3191,6 +3523,7 @@ tmg_animate_commit (tmscm arg1) {
 
 tmscm
 tmg_idle_time () {
+  PROFILE_TALLY ("glue idle-time");
   // TMSCM_DEFER_INTS;
   int out= get_current_editor()->idle_time ();
   // TMSCM_ALLOW_INTS;
@@ -3200,6 +3533,7 @@ tmg_idle_time () {
 
 tmscm
 tmg_change_time () {
+  PROFILE_TALLY ("glue change-time");
   // TMSCM_DEFER_INTS;
   int out= get_current_editor()->change_time ();
   // TMSCM_ALLOW_INTS;
@@ -3209,6 +3543,7 @@ tmg_change_time () {
 
 tmscm
 tmg_menu_before_action () {
+  PROFILE_TALLY ("glue menu-before-action");
   // TMSCM_DEFER_INTS;
   get_current_editor()->before_menu_action ();
   // TMSCM_ALLOW_INTS;
@@ -3218,6 +3553,7 @@ tmg_menu_before_action () {
 
 tmscm
 tmg_menu_after_action () {
+  PROFILE_TALLY ("glue menu-after-action");
   // TMSCM_DEFER_INTS;
   get_current_editor()->after_menu_action ();
   // TMSCM_ALLOW_INTS;
@@ -3227,6 +3563,7 @@ tmg_menu_after_action () {
 
 tmscm
 tmg_update_menus () {
+  PROFILE_TALLY ("glue update-menus");
   // TMSCM_DEFER_INTS;
   get_current_editor()->update_menus ();
   // TMSCM_ALLOW_INTS;
@@ -3236,6 +3573,7 @@ tmg_update_menus () {
 
 tmscm
 tmg_show_tree () {
+  PROFILE_TALLY ("glue show-tree");
   // TMSCM_DEFER_INTS;
   get_current_editor()->show_tree ();
   // TMSCM_ALLOW_INTS;
@@ -3245,6 +3583,7 @@ tmg_show_tree () {
 
 tmscm
 tmg_show_env () {
+  PROFILE_TALLY ("glue show-env");
   // TMSCM_DEFER_INTS;
   get_current_editor()->show_env ();
   // TMSCM_ALLOW_INTS;
@@ -3254,6 +3593,7 @@ tmg_show_env () {
 
 tmscm
 tmg_show_path () {
+  PROFILE_TALLY ("glue show-path");
   // TMSCM_DEFER_INTS;
   get_current_editor()->show_path ();
   // TMSCM_ALLOW_INTS;
@@ -3263,6 +3603,7 @@ tmg_show_path () {
 
 tmscm
 tmg_show_cursor () {
+  PROFILE_TALLY ("glue show-cursor");
   // TMSCM_DEFER_INTS;
   get_current_editor()->show_cursor ();
   // TMSCM_ALLOW_INTS;
@@ -3272,6 +3613,7 @@ tmg_show_cursor () {
 
 tmscm
 tmg_show_selection () {
+  PROFILE_TALLY ("glue show-selection");
   // TMSCM_DEFER_INTS;
   get_current_editor()->show_selection ();
   // TMSCM_ALLOW_INTS;
@@ -3281,6 +3623,7 @@ tmg_show_selection () {
 
 tmscm
 tmg_show_meminfo () {
+  PROFILE_TALLY ("glue show-meminfo");
   // TMSCM_DEFER_INTS;
   get_current_editor()->show_meminfo ();
   // TMSCM_ALLOW_INTS;
@@ -3290,6 +3633,7 @@ tmg_show_meminfo () {
 
 tmscm
 tmg_edit_special () {
+  PROFILE_TALLY ("glue edit-special");
   // TMSCM_DEFER_INTS;
   get_current_editor()->edit_special ();
   // TMSCM_ALLOW_INTS;
@@ -3299,6 +3643,7 @@ tmg_edit_special () {
 
 tmscm
 tmg_edit_test () {
+  PROFILE_TALLY ("glue edit-test");
   // TMSCM_DEFER_INTS;
   get_current_editor()->edit_test ();
   // TMSCM_ALLOW_INTS;
@@ -3434,6 +3779,7 @@ initialize_glue_editor () {
   tmscm_install_procedure ("table-test",  tmg_table_test, 0, 0, 0);
   tmscm_install_procedure ("key-press",  tmg_key_press, 1, 0, 0);
   tmscm_install_procedure ("raw-emulate-keyboard",  tmg_raw_emulate_keyboard, 1, 0, 0);
+  tmscm_install_procedure ("keyboard-replay",  tmg_keyboard_replay, 1, 0, 0);
   tmscm_install_procedure ("complete-try?",  tmg_complete_tryP, 0, 0, 0);
   tmscm_install_procedure ("get-input-mode",  tmg_get_input_mode, 0, 0, 0);
   tmscm_install_procedure ("key-press-search",  tmg_key_press_search, 1, 0, 0);
@@ -3540,6 +3886,7 @@ initialize_glue_editor () {
   tmscm_install_procedure ("search-start",  tmg_search_start, 1, 0, 0);
   tmscm_install_procedure ("search-button-next",  tmg_search_button_next, 0, 0, 0);
   tmscm_install_procedure ("replace-start",  tmg_replace_start, 3, 0, 0);
+  tmscm_install_procedure ("replace-all-occurrences",  tmg_replace_all_occurrences, 2, 0, 0);
   tmscm_install_procedure ("spell-start",  tmg_spell_start, 0, 0, 0);
   tmscm_install_procedure ("spell-replace",  tmg_spell_replace, 1, 0, 0);
   tmscm_install_procedure ("session-complete-command",  tmg_session_complete_command, 1, 0, 0);
@@ -3571,6 +3918,8 @@ initialize_glue_editor () {
   tmscm_install_procedure ("graphics-file-to-clipboard",  tmg_graphics_file_to_clipboard, 1, 0, 0);
   tmscm_install_procedure ("export-postscript",  tmg_export_postscript, 1, 0, 0);
   tmscm_install_procedure ("export-pages-postscript",  tmg_export_pages_postscript, 3, 0, 0);
+  tmscm_install_procedure ("typeset-pages",  tmg_typeset_pages, 0, 0, 0);
+  tmscm_install_procedure ("export-pages-raster",  tmg_export_pages_raster, 4, 0, 0);
   tmscm_install_procedure ("footer-eval",  tmg_footer_eval, 1, 0, 0);
   tmscm_install_procedure ("texmacs-exec",  tmg_texmacs_exec, 1, 0, 0);
   tmscm_install_procedure ("texmacs-exec*",  tmg_texmacs_exec_dot, 1, 0, 0);
@@ -13,6 +13,7 @@
 
 tmscm
 tmg_insert_kbd_wildcard (tmscm arg1, tmscm arg2, tmscm arg3, tmscm arg4, tmscm arg5) {
+  PROFILE_TALLY ("glue insert-kbd-wildcard");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "insert-kbd-wildcard");
   TMSCM_ASSERT_STRING (arg2, TMSCM_ARG2, "insert-kbd-wildcard");
   TMSCM_ASSERT_BOOL (arg3, TMSCM_ARG3, "insert-kbd-wildcard");
@@ -34,6 +35,7 @@ tmg_insert_kbd_wildcard (tmscm arg1, tmscm arg2, tmscm arg3, tmscm arg4, tmscm a
 
 tmscm
 tmg_set_variant_keys (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue set-variant-keys");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "set-variant-keys");
   TMSCM_ASSERT_STRING (arg2, TMSCM_ARG2, "set-variant-keys");
 
@@ -49,6 +51,7 @@ tmg_set_variant_keys (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_kbd_pre_rewrite (tmscm arg1) {
+  PROFILE_TALLY ("glue kbd-pre-rewrite");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "kbd-pre-rewrite");
 
   string in1= tmscm_to_string (arg1);
@@ -62,6 +65,7 @@ tmg_kbd_pre_rewrite (tmscm arg1) {
 
 tmscm
 tmg_kbd_post_rewrite (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue kbd-post-rewrite");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "kbd-post-rewrite");
   TMSCM_ASSERT_BOOL (arg2, TMSCM_ARG2, "kbd-post-rewrite");
 
@@ -77,6 +81,7 @@ tmg_kbd_post_rewrite (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_kbd_system_rewrite (tmscm arg1) {
+  PROFILE_TALLY ("glue kbd-system-rewrite");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "kbd-system-rewrite");
 
   string in1= tmscm_to_string (arg1);
@@ -90,6 +95,7 @@ tmg_kbd_system_rewrite (tmscm arg1) {
 
 tmscm
 tmg_set_font_rules (tmscm arg1) {
+  PROFILE_TALLY ("glue set-font-rules");
   TMSCM_ASSERT_SCHEME_TREE (arg1, TMSCM_ARG1, "set-font-rules");
 
   scheme_tree in1= tmscm_to_scheme_tree (arg1);
@@ -103,6 +109,7 @@ tmg_set_font_rules (tmscm arg1) {
 
 tmscm
 tmg_window_get_serial () {
+  PROFILE_TALLY ("glue window-get-serial");
   // TMSCM_DEFER_INTS;
   int out= get_server()->get_window_serial ();
   // TMSCM_ALLOW_INTS;
@@ -112,6 +119,7 @@ tmg_window_get_serial () {
 
 tmscm
 tmg_window_set_property (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue window-set-property");
   TMSCM_ASSERT_SCHEME_TREE (arg1, TMSCM_ARG1, "window-set-property");
   TMSCM_ASSERT_SCHEME_TREE (arg2, TMSCM_ARG2, "window-set-property");
 
@@ -127,6 +135,7 @@ tmg_window_set_property (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_window_get_property (tmscm arg1) {
+  PROFILE_TALLY ("glue window-get-property");
   TMSCM_ASSERT_SCHEME_TREE (arg1, TMSCM_ARG1, "window-get-property");
 
   scheme_tree in1= tmscm_to_scheme_tree (arg1);
@@ -140,6 +149,7 @@ tmg_window_get_property (tmscm arg1) {
 
 tmscm
 tmg_show_header (tmscm arg1) {
+  PROFILE_TALLY ("glue show-header");
   TMSCM_ASSERT_BOOL (arg1, TMSCM_ARG1, "show-header");
 
   bool in1= tmscm_to_bool (arg1);
@@ -153,6 +163,7 @@ tmg_show_header (tmscm arg1) {
 
 tmscm
 tmg_show_icon_bar (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue show-icon-bar");
   TMSCM_ASSERT_INT (arg1, TMSCM_ARG1, "show-icon-bar");
   TMSCM_ASSERT_BOOL (arg2, TMSCM_ARG2, "show-icon-bar");
 
@@ -168,6 +179,7 @@ tmg_show_icon_bar (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_show_side_tools (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue show-side-tools");
   TMSCM_ASSERT_INT (arg1, TMSCM_ARG1, "show-side-tools");
   TMSCM_ASSERT_BOOL (arg2, TMSCM_ARG2, "show-side-tools");
 
@@ -183,6 +195,7 @@ tmg_show_side_tools (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_show_bottom_tools (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue show-bottom-tools");
   TMSCM_ASSERT_INT (arg1, TMSCM_ARG1, "show-bottom-tools");
   TMSCM_ASSERT_BOOL (arg2, TMSCM_ARG2, "show-bottom-tools");
 
@@ -198,6 +211,7 @@ tmg_show_bottom_tools (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_show_footer (tmscm arg1) {
+  PROFILE_TALLY ("glue show-footer");
   TMSCM_ASSERT_BOOL (arg1, TMSCM_ARG1, "show-footer");
 
   bool in1= tmscm_to_bool (arg1);
@@ -211,6 +225,7 @@ tmg_show_footer (tmscm arg1) {
 
 tmscm
 tmg_visible_headerP () {
+  PROFILE_TALLY ("glue visible-header?");
   // TMSCM_DEFER_INTS;
   bool out= get_server()->visible_header ();
   // TMSCM_ALLOW_INTS;
@@ -220,6 +235,7 @@ tmg_visible_headerP () {
 
 tmscm
 tmg_visible_icon_barP (tmscm arg1) {
+  PROFILE_TALLY ("glue visible-icon-bar?");
   TMSCM_ASSERT_INT (arg1, TMSCM_ARG1, "visible-icon-bar?");
 
   int in1= tmscm_to_int (arg1);
@@ -233,6 +249,7 @@ tmg_visible_icon_barP (tmscm arg1) {
 
 tmscm
 tmg_visible_side_toolsP (tmscm arg1) {
+  PROFILE_TALLY ("glue visible-side-tools?");
   TMSCM_ASSERT_INT (arg1, TMSCM_ARG1, "visible-side-tools?");
 
   int in1= tmscm_to_int (arg1);
@@ -246,6 +263,7 @@ tmg_visible_side_toolsP (tmscm arg1) {
 
 tmscm
 tmg_visible_bottom_toolsP (tmscm arg1) {
+  PROFILE_TALLY ("glue visible-bottom-tools?");
   TMSCM_ASSERT_INT (arg1, TMSCM_ARG1, "visible-bottom-tools?");
 
   int in1= tmscm_to_int (arg1);
@@ -259,6 +277,7 @@ tmg_visible_bottom_toolsP (tmscm arg1) {
 
 tmscm
 tmg_visible_footerP () {
+  PROFILE_TALLY ("glue visible-footer?");
   // TMSCM_DEFER_INTS;
   bool out= get_server()->visible_footer ();
   // TMSCM_ALLOW_INTS;
@@ -268,6 +287,7 @@ tmg_visible_footerP () {
 
 tmscm
 tmg_full_screen_mode (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue full-screen-mode");
   TMSCM_ASSERT_BOOL (arg1, TMSCM_ARG1, "full-screen-mode");
   TMSCM_ASSERT_BOOL (arg2, TMSCM_ARG2, "full-screen-mode");
 
@@ -283,6 +303,7 @@ tmg_full_screen_mode (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_full_screenP () {
+  PROFILE_TALLY ("glue full-screen?");
   // TMSCM_DEFER_INTS;
   bool out= get_server()->in_full_screen_mode ();
   // TMSCM_ALLOW_INTS;
@@ -292,6 +313,7 @@ tmg_full_screenP () {
 
 tmscm
 tmg_full_screen_editP () {
+  PROFILE_TALLY ("glue full-screen-edit?");
   // TMSCM_DEFER_INTS;
   bool out= get_server()->in_full_screen_edit_mode ();
   // TMSCM_ALLOW_INTS;
@@ -301,6 +323,7 @@ tmg_full_screen_editP () {
 
 tmscm
 tmg_set_window_zoom_factor (tmscm arg1) {
+  PROFILE_TALLY ("glue set-window-zoom-factor");
   TMSCM_ASSERT_DOUBLE (arg1, TMSCM_ARG1, "set-window-zoom-factor");
 
   double in1= tmscm_to_double (arg1);
@@ -314,6 +337,7 @@ tmg_set_window_zoom_factor (tmscm arg1) {
 
 tmscm
 tmg_get_window_zoom_factor () {
+  PROFILE_TALLY ("glue get-window-zoom-factor");
   // TMSCM_DEFER_INTS;
   double out= get_server()->get_window_zoom_factor ();
   // TMSCM_ALLOW_INTS;
@@ -323,6 +347,7 @@ tmg_get_window_zoom_factor () {
 
 tmscm
 tmg_shell (tmscm arg1) {
+  PROFILE_TALLY ("glue shell");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "shell");
 
   string in1= tmscm_to_string (arg1);
@@ -336,6 +361,7 @@ tmg_shell (tmscm arg1) {
 
 tmscm
 tmg_dialogue_end () {
+  PROFILE_TALLY ("glue dialogue-end");
   // TMSCM_DEFER_INTS;
   get_server()->dialogue_end ();
   // TMSCM_ALLOW_INTS;
@@ -345,6 +371,7 @@ tmg_dialogue_end () {
 
 tmscm
 tmg_cpp_choose_file (tmscm arg1, tmscm arg2, tmscm arg3, tmscm arg4, tmscm arg5) {
+  PROFILE_TALLY ("glue cpp-choose-file");
   TMSCM_ASSERT_OBJECT (arg1, TMSCM_ARG1, "cpp-choose-file");
   TMSCM_ASSERT_STRING (arg2, TMSCM_ARG2, "cpp-choose-file");
   TMSCM_ASSERT_STRING (arg3, TMSCM_ARG3, "cpp-choose-file");
@@ -366,6 +393,7 @@ tmg_cpp_choose_file (tmscm arg1, tmscm arg2, tmscm arg3, tmscm arg4, tmscm arg5)
 
 tmscm
 tmg_tm_interactive (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue tm-interactive");
   TMSCM_ASSERT_OBJECT (arg1, TMSCM_ARG1, "tm-interactive");
   TMSCM_ASSERT_SCHEME_TREE (arg2, TMSCM_ARG2, "tm-interactive");
 
@@ -381,6 +409,7 @@ tmg_tm_interactive (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_cpp_style_clear_cache () {
+  PROFILE_TALLY ("glue cpp-style-clear-cache");
   // TMSCM_DEFER_INTS;
   get_server()->style_clear_cache ();
   // TMSCM_ALLOW_INTS;
@@ -390,6 +419,7 @@ tmg_cpp_style_clear_cache () {
 
 tmscm
 tmg_set_script_status (tmscm arg1) {
+  PROFILE_TALLY ("glue set-script-status");
   TMSCM_ASSERT_INT (arg1, TMSCM_ARG1, "set-script-status");
 
   int in1= tmscm_to_int (arg1);
@@ -403,6 +433,7 @@ tmg_set_script_status (tmscm arg1) {
 
 tmscm
 tmg_set_printing_command (tmscm arg1) {
+  PROFILE_TALLY ("glue set-printing-command");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "set-printing-command");
 
   string in1= tmscm_to_string (arg1);
@@ -416,6 +447,7 @@ tmg_set_printing_command (tmscm arg1) {
 
 tmscm
 tmg_set_printer_paper_type (tmscm arg1) {
+  PROFILE_TALLY ("glue set-printer-paper-type");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "set-printer-paper-type");
 
   string in1= tmscm_to_string (arg1);
@@ -429,6 +461,7 @@ tmg_set_printer_paper_type (tmscm arg1) {
 
 tmscm
 tmg_get_printer_paper_type () {
+  PROFILE_TALLY ("glue get-printer-paper-type");
   // TMSCM_DEFER_INTS;
   string out= get_server()->get_printer_page_type ();
   // TMSCM_ALLOW_INTS;
@@ -438,6 +471,7 @@ tmg_get_printer_paper_type () {
 
 tmscm
 tmg_set_printer_dpi (tmscm arg1) {
+  PROFILE_TALLY ("glue set-printer-dpi");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "set-printer-dpi");
 
   string in1= tmscm_to_string (arg1);
@@ -451,6 +485,7 @@ tmg_set_printer_dpi (tmscm arg1) {
 
 tmscm
 tmg_set_default_zoom_factor (tmscm arg1) {
+  PROFILE_TALLY ("glue set-default-zoom-factor");
   TMSCM_ASSERT_DOUBLE (arg1, TMSCM_ARG1, "set-default-zoom-factor");
 
   double in1= tmscm_to_double (arg1);
@@ -464,6 +499,7 @@ tmg_set_default_zoom_factor (tmscm arg1) {
 
 tmscm
 tmg_get_default_zoom_factor () {
+  PROFILE_TALLY ("glue get-default-zoom-factor");
   // TMSCM_DEFER_INTS;
   double out= get_server()->get_default_zoom_factor ();
   // TMSCM_ALLOW_INTS;
@@ -473,6 +509,7 @@ tmg_get_default_zoom_factor () {
 
 tmscm
 tmg_inclusions_gc () {
+  PROFILE_TALLY ("glue inclusions-gc");
   // TMSCM_DEFER_INTS;
   get_server()->inclusions_gc ();
   // TMSCM_ALLOW_INTS;
@@ -482,6 +519,7 @@ tmg_inclusions_gc () {
 
 tmscm
 tmg_update_all_path (tmscm arg1) {
+  PROFILE_TALLY ("glue update-all-path");
   TMSCM_ASSERT_PATH (arg1, TMSCM_ARG1, "update-all-path");
 
   path in1= tmscm_to_path (arg1);
@@ -495,6 +533,7 @@ tmg_update_all_path (tmscm arg1) {
 
 tmscm
 tmg_update_all_buffers () {
+  PROFILE_TALLY ("glue update-all-buffers");
   // TMSCM_DEFER_INTS;
   get_server()->typeset_update_all ();
   // TMSCM_ALLOW_INTS;
@@ -504,6 +543,7 @@ tmg_update_all_buffers () {
 
 tmscm
 tmg_set_message (tmscm arg1, tmscm arg2) {
+  PROFILE_TALLY ("glue set-message");
   TMSCM_ASSERT_CONTENT (arg1, TMSCM_ARG1, "set-message");
   TMSCM_ASSERT_CONTENT (arg2, TMSCM_ARG2, "set-message");
 
@@ -519,6 +559,7 @@ tmg_set_message (tmscm arg1, tmscm arg2) {
 
 tmscm
 tmg_set_message_temp (tmscm arg1, tmscm arg2, tmscm arg3) {
+  PROFILE_TALLY ("glue set-message-temp");
   TMSCM_ASSERT_CONTENT (arg1, TMSCM_ARG1, "set-message-temp");
   TMSCM_ASSERT_CONTENT (arg2, TMSCM_ARG2, "set-message-temp");
   TMSCM_ASSERT_BOOL (arg3, TMSCM_ARG3, "set-message-temp");
@@ -536,6 +577,7 @@ tmg_set_message_temp (tmscm arg1, tmscm arg2, tmscm arg3) {
 
 tmscm
 tmg_recall_message () {
+  PROFILE_TALLY ("glue recall-message");
   // TMSCM_DEFER_INTS;
   get_server()->recall_message ();
   // TMSCM_ALLOW_INTS;
@@ -545,6 +587,7 @@ tmg_recall_message () {
 
 tmscm
 tmg_yesP (tmscm arg1) {
+  PROFILE_TALLY ("glue yes?");
   TMSCM_ASSERT_STRING (arg1, TMSCM_ARG1, "yes?");
 
   string in1= tmscm_to_string (arg1);
@@ -558,6 +601,7 @@ tmg_yesP (tmscm arg1) {
 
 tmscm
 tmg_quit_TeXmacs () {
+  PROFILE_TALLY ("glue quit-TeXmacs");
   // TMSCM_DEFER_INTS;
   get_server()->quit ();
   // TMSCM_ALLOW_INTS;
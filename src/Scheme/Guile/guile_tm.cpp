@@ -93,6 +93,7 @@ TeXmacs_lazy_eval_file (char *file) {
 
 static SCM
 TeXmacs_eval_file (char *file) {
+  MEM_TAG_SCOPE (MEM_SCHEME);
 #ifndef DEBUG_ON
   return scm_internal_catch (SCM_BOOL_T,
                              (scm_t_catch_body) TeXmacs_lazy_eval_file, file,
@@ -129,6 +130,7 @@ TeXmacs_lazy_eval_string (char *s) {
 
 static SCM
 TeXmacs_eval_string (char *s) {
+  MEM_TAG_SCOPE (MEM_SCHEME);
 #ifndef DEBUG_ON
   return scm_internal_catch (SCM_BOOL_T,
                              (scm_t_catch_body) TeXmacs_lazy_eval_string, s,
@@ -188,6 +190,7 @@ TeXmacs_lazy_call_scm (arg_list* args) {
 
 static SCM
 TeXmacs_call_scm (arg_list *args) {
+  MEM_TAG_SCOPE (MEM_SCHEME);
 #ifndef DEBUG_ON
   return scm_internal_catch (SCM_BOOL_T,
                              (scm_t_catch_body) TeXmacs_lazy_call_scm, (void*) args,
@@ -357,7 +360,8 @@ scm_to_double (SCM i) {
 
 tmscm
 string_to_tmscm (string s) {
-  c_string _s (s);
+  // the length is passed explicitly, so no null terminated copy is needed
+  const char* _s= (N(s) == 0? "": &s[0]);
 #ifdef DEBUG_ON
   if (! scm_busy) {
 #endif
@@ -370,6 +374,18 @@ string_to_tmscm (string s) {
 
 string
 tmscm_to_string (tmscm s) {
+#if (defined(GUILE_C) || defined(GUILE_D))
+  // convert directly into the buffer of the result
+  size_t len= scm_c_string_length (s);
+  string r ((int) len);
+  size_t n= (len == 0? 0: scm_to_locale_stringbuf (s, &r[0], len));
+  if (n > len) {
+    r= string ((int) n);
+    scm_to_locale_stringbuf (s, &r[0], n);
+  }
+  else if (n < len) r= r (0, (int) n);
+  return r;
+#else
   guile_str_size_t len_r;
   char* _r= scm_scm2str (s, &len_r);
   string r (_r, len_r);
@@ -379,6 +395,7 @@ tmscm_to_string (tmscm s) {
   free (_r);
 #endif
   return r;
+#endif
 }
 
 /******************************************************************************
@@ -409,6 +426,7 @@ tmscm_to_symbol (tmscm s) {
   free (_r);
 #endif
   return r;
+#endif
 }
 
 /******************************************************************************
@@ -449,6 +467,8 @@ free_blackbox (SCM blackbox_smob) {
 #ifdef DEBUG_ON
   scm_busy= true;
 #endif
+  if (type_box (*ptr) == type_helper<tree>::id)
+    forget_tree_wrapper (blackbox_smob);
   tm_delete (ptr);
 #ifdef DEBUG_ON
   scm_busy= false;
@@ -503,6 +523,14 @@ cmp_blackbox (SCM t1, SCM t2) {
  * Initialization
  ******************************************************************************/
 
+static void*
+before_gc_blackbox (void* hook_data, void* func_data, void* data) {
+  (void) hook_data; (void) func_data; (void) data;
+  // the cached tree wrappers are not protected, so they become stale
+  flush_tree_wrappers ();
+  return NULL;
+}
+
 
 #ifdef SCM_NEWSMOB
 void
@@ -512,6 +540,7 @@ initialize_smobs () {
   scm_set_smob_free (blackbox_tag, free_blackbox);
   scm_set_smob_print (blackbox_tag, print_blackbox);
   scm_set_smob_equalp (blackbox_tag, cmp_blackbox);
+  scm_c_hook_add (&scm_before_gc_c_hook, before_gc_blackbox, NULL, 0);
 }
 
 #else
@@ -524,6 +553,7 @@ scm_smobfuns blackbox_smob_funcs = {
 void
 initialize_smobs () {
   blackbox_tag= scm_newsmob (&blackbox_smob_funcs);
+  scm_c_hook_add (&scm_before_gc_c_hook, before_gc_blackbox, NULL, 0);
 }
 
 #endif
@@ -21,6 +21,7 @@
 #include "boxes.hpp"
 #include "editor.hpp"
 #include "universal.hpp"
+#include "tm_timer.hpp"
 #include "convert.hpp"
 #include "file.hpp"
 #include "locale.hpp"
@@ -216,9 +217,48 @@ tmscm_is_tree (tmscm u) {
          (type_box (tmscm_to_blackbox(u)) == type_helper<tree>::id));
 }
 
+// Wrappers of recently passed trees are reused.  The cache does not protect
+// them, so the backend flushes it before each garbage collection; this way
+// it never hands out a wrapper which is about to be freed.
+
+#define TREE_WRAPPERS 1024
+
+static tree_rep* tree_wrapper_key [TREE_WRAPPERS];
+static tmscm     tree_wrapper_val [TREE_WRAPPERS];
+
+static inline int
+tree_wrapper_slot (tree_rep* rep) {
+  return (int) ((((size_t) rep) >> 3) & (TREE_WRAPPERS - 1));
+}
+
+void
+flush_tree_wrappers () {
+  for (int i=0; i<TREE_WRAPPERS; i++)
+    tree_wrapper_key[i]= NULL;
+}
+
+void
+forget_tree_wrapper (tmscm u) {
+  // called when the wrapper u of a tree is freed
+  tree_rep* rep= inside (open_box<tree> (tmscm_to_blackbox (u)));
+  int i= tree_wrapper_slot (rep);
+  if (tree_wrapper_key[i] == rep && tree_wrapper_val[i] == u)
+    tree_wrapper_key[i]= NULL;
+}
+
 tmscm 
 tree_to_tmscm (tree o) {
-  return blackbox_to_tmscm (close_box<tree> (o));
+  tree_rep* rep= inside (o);
+  int i= tree_wrapper_slot (rep);
+  if (tree_wrapper_key[i] == rep) {
+    PROFILE_TALLY ("tree wrapper reuses");
+    return tree_wrapper_val[i];
+  }
+  PROFILE_TALLY ("tree wrapper allocations");
+  tmscm r= blackbox_to_tmscm (close_box<tree> (o));
+  tree_wrapper_key[i]= rep;
+  tree_wrapper_val[i]= r;
+  return r;
 }
 
 tree
@@ -398,20 +438,22 @@ tree_remove_node (tree r, int pos) {
 
 #define TMSCM_ASSERT_SCHEME_TREE(p,arg,rout)
 
+static tmscm
+scheme_atom_to_tmscm (string s) {
+  if (s == "#t") return tmscm_true ();
+  if (s == "#f") return tmscm_false ();
+  if (is_int (s)) return int_to_tmscm (as_int (s));
+  if (is_quoted (s))
+    return string_to_tmscm (scm_unquote (s));
+  //if ((N(s)>=2) && (s[0]=='\42') && (s[N(s)-1]=='\42'))
+  //return string_to_tmscm (s (1, N(s)-1));
+  if (N(s) >= 1 && s[0] == '\'') return symbol_to_tmscm (s (1, N(s)));
+  return symbol_to_tmscm (s);
+}
+
 tmscm 
 scheme_tree_to_tmscm (scheme_tree t) {
-  if (is_atomic (t)) {
-    string s= t->label;
-    if (s == "#t") return tmscm_true ();
-    if (s == "#f") return tmscm_false ();
-    if (is_int (s)) return int_to_tmscm (as_int (s));
-    if (is_quoted (s))
-      return string_to_tmscm (scm_unquote (s));
-    //if ((N(s)>=2) && (s[0]=='\42') && (s[N(s)-1]=='\42'))
-    //return string_to_tmscm (s (1, N(s)-1));
-    if (N(s) >= 1 && s[0] == '\'') return symbol_to_tmscm (s (1, N(s)));
-    return symbol_to_tmscm (s);
-  }
+  if (is_atomic (t)) return scheme_atom_to_tmscm (t->label);
   else {
     int i;
     tmscm p= tmscm_null ();
@@ -421,6 +463,28 @@ scheme_tree_to_tmscm (scheme_tree t) {
   }
 }
 
+tmscm
+tree_to_stree_tmscm (tree t) {
+  // same as scheme_tree_to_tmscm (tree_to_scheme_tree (t)),
+  // but without building the intermediate scheme tree
+  if (is_atomic (t)) return string_to_tmscm (t->label);
+  int i, start= 0, n= N(t);
+  string s;
+  if (is_func (t, EXPAND) && is_atomic (t[0])) {
+    s= t[0]->label;
+    start= 1;
+  }
+  else {
+    s= as_string (L(t));
+    if (N(s) > 0 && is_digit (s[0]))
+      if (is_int (s)) s= "'" * s;
+  }
+  tmscm p= tmscm_null ();
+  for (i=n-1; i>=start; i--)
+    p= tmscm_cons (tree_to_stree_tmscm (t[i]), p);
+  return tmscm_cons (scheme_atom_to_tmscm (s), p);
+}
+
 scheme_tree
 tmscm_to_scheme_tree (tmscm p) {
   if (tmscm_is_list (p)) {
@@ -489,8 +553,11 @@ contentP (tmscm t) {
 
 bool
 tmscm_is_path (tmscm p) {
-  if (tmscm_is_null (p)) return true;
-  else return tmscm_is_int (tmscm_car (p)) && tmscm_is_path (tmscm_cdr (p));
+  while (!tmscm_is_null (p)) {
+    if (!tmscm_is_pair (p) || !tmscm_is_int (tmscm_car (p))) return false;
+    p= tmscm_cdr (p);
+  }
+  return true;
 }
 
 #define TMSCM_ASSERT_PATH(p,arg,rout) \
@@ -498,15 +565,21 @@ TMSCM_ASSERT (tmscm_is_path (p), p, arg, rout)
 
 tmscm 
 path_to_tmscm (path p) {
-  if (is_nil (p)) return tmscm_null ();
-  else return tmscm_cons (int_to_tmscm (p->item), path_to_tmscm (p->next));
+  array<int> a;
+  for (; !is_nil (p); p= p->next) a << p->item;
+  tmscm r= tmscm_null ();
+  for (int i=N(a)-1; i>=0; i--) r= tmscm_cons (int_to_tmscm (a[i]), r);
+  return r;
 }
 
 path
 tmscm_to_path (tmscm p) {
-  if (tmscm_is_null (p)) return path ();
-  else return path ((int) tmscm_to_int (tmscm_car (p)), 
-                          tmscm_to_path (tmscm_cdr (p)));
+  array<int> a;
+  for (; !tmscm_is_null (p); p= tmscm_cdr (p))
+    a << ((int) tmscm_to_int (tmscm_car (p)));
+  path r;
+  for (int i=N(a)-1; i>=0; i--) r= path (a[i], r);
+  return r;
 }
 
 
@@ -1171,6 +1244,7 @@ tmscm_to_list_tree (tmscm p) {
 #include "image_files.hpp"
 #include "web_files.hpp"
 #include "sys_utils.hpp"
+#include "background.hpp"
 #include "client_server.hpp"
 #include "analyze.hpp"
 #include "wencoding.hpp"
@@ -22,6 +22,8 @@
 #include "object.hpp"
 
 void initialize_glue ();
+void flush_tree_wrappers ();
+void forget_tree_wrapper (tmscm u);
 
 bool tmscm_is_tree (tmscm obj);
 bool tmscm_is_list_string (tmscm obj);
@@ -45,6 +47,7 @@ tmscm  url_to_tmscm (url u);
 tmscm  modification_to_tmscm (modification m);
 tmscm  patch_to_tmscm (patch p);
 tmscm  scheme_tree_to_tmscm (scheme_tree t);
+tmscm  tree_to_stree_tmscm (tree t);
 
 //int tmscm_to_bool (tmscm obj);
 int tmscm_to_int (tmscm obj);
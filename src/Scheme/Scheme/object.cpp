@@ -272,7 +272,7 @@ as_widget (object obj) {
 
 object
 tree_to_stree (scheme_tree t) {
-  return call ("tree->stree", t);
+  return tmscm_to_object (tree_to_stree_tmscm (t));
 }
 
 tree
@@ -68,12 +68,21 @@ int retcode;
 int tracing;
 
 
+#ifndef CELL_SEGSIZE
 #define CELL_SEGSIZE    5000  /* # of cells in one segment */
-#define CELL_NSEGMENT   10    /* # of segments for cells */
+#endif
+#ifndef CELL_NSEGMENT
+#define CELL_NSEGMENT   4096  /* # of segments for cells */
+#endif
 char *alloc_seg[CELL_NSEGMENT];
 cell_ptr cell_seg[CELL_NSEGMENT];
 int     last_cell_seg;
 
+/* garbage collection statistics and hook */
+long    gc_count;        /* # of collections so far */
+long    gc_recovered;    /* # of cells recovered by the last collection */
+void  (*gc_hook)(scheme *sc, int done); /* called around each collection */
+
 /* We use 4 registers. */
 cell_ptr args;            /* register for arguments of function */
 cell_ptr envir;           /* stack register for current environment */
@@ -109,6 +109,18 @@ static const char *strlwr(char *s) {
 # define FIRST_CELLSEGS 3
 #endif
 
+/* After a collection which leaves less than CELL_MIN_FREE_PERCENT of the
+   heap free, the heap is grown by CELL_GROWTH_PERCENT of its current size
+   (at least one segment), so that the number of collections stays
+   logarithmic in the size of the live data instead of linear. */
+#ifndef CELL_MIN_FREE_PERCENT
+# define CELL_MIN_FREE_PERCENT 50
+#endif
+
+#ifndef CELL_GROWTH_PERCENT
+# define CELL_GROWTH_PERCENT 50
+#endif
+
 enum scheme_types {
   T_STRING=1,
   T_NUMBER=2,
@@ -332,6 +344,7 @@ static void file_pop(scheme *sc);
 static int file_interactive(scheme *sc);
 static INLINE int is_one_of(char *s, int c);
 static int alloc_cellseg(scheme *sc, int n);
+static int grow_cellseg(scheme *sc);
 static long binary_decode(const char *s);
 static INLINE cell_ptr get_cell(scheme *sc, cell_ptr a, cell_ptr b);
 static cell_ptr _get_cell(scheme *sc, cell_ptr a, cell_ptr b);
@@ -618,6 +631,18 @@ static int alloc_cellseg(scheme *sc, int n) {
      return n;
 }
 
+/* grow the heap after a collection which recovered too few cells */
+static int grow_cellseg(scheme *sc) {
+     long total = (long) (sc->last_cell_seg + 1) * CELL_SEGSIZE;
+     int n;
+
+     if (sc->fcells * 100 >= total * CELL_MIN_FREE_PERCENT
+         && sc->free_cell != sc->NIL)
+          return 0;
+     n = 1 + ((sc->last_cell_seg + 1) * CELL_GROWTH_PERCENT) / 100;
+     return alloc_cellseg(sc, n);
+}
+
 static INLINE cell_ptr get_cell_x(scheme *sc, cell_ptr a, cell_ptr b) {
   if (sc->free_cell != sc->NIL) {
     cell_ptr x = sc->free_cell;
@@ -638,15 +663,11 @@ static cell_ptr _get_cell(scheme *sc, cell_ptr a, cell_ptr b) {
   }
 
   if (sc->free_cell == sc->NIL) {
-    const int min_to_be_recovered = sc->last_cell_seg*8;
     gc(sc,a, b);
-    if (sc->fcells < min_to_be_recovered
-    || sc->free_cell == sc->NIL) {
-      /* if only a few recovered, get more to avoid fruitless gc's */
-      if (!alloc_cellseg(sc,1) && sc->free_cell == sc->NIL) {
-    sc->no_memory=1;
-    return sc->sink;
-      }
+    /* if only a few recovered, get more to avoid fruitless gc's */
+    if (!grow_cellseg(sc) && sc->free_cell == sc->NIL) {
+      sc->no_memory=1;
+      return sc->sink;
     }
   }
   x = sc->free_cell;
@@ -665,9 +686,10 @@ static cell_ptr reserve_cells(scheme *sc, int n) {
     if (sc->fcells < n) {
         /* If not, try gc'ing some */
         gc(sc, sc->NIL, sc->NIL);
+        grow_cellseg(sc);
         if (sc->fcells < n) {
             /* If there still aren't, try getting more heap */
-            if (!alloc_cellseg(sc,1)) {
+            if (!alloc_cellseg(sc,1 + (n - 1) / CELL_SEGSIZE)) {
                 sc->no_memory=1;
                 return sc->NIL;
             }
@@ -692,6 +714,7 @@ static cell_ptr get_consecutive_cells(scheme *sc, int n) {
 
   /* If not, try gc'ing some */
   gc(sc, sc->NIL, sc->NIL);
+  grow_cellseg(sc);
   x=find_consecutive_cells(sc,n);
   if (x != sc->NIL) { return x; }
 
@@ -1267,6 +1290,9 @@ static void gc(scheme *sc, cell_ptr a, cell_ptr b) {
   cell_ptr p;
   int i;
 
+  if(sc->gc_hook) {
+    sc->gc_hook(sc, 0);
+  }
   if(sc->gc_verbose) {
     putstr(sc, "gc...");
   }
@@ -1323,11 +1349,16 @@ static void gc(scheme *sc, cell_ptr a, cell_ptr b) {
     }
   }
 
+  sc->gc_count++;
+  sc->gc_recovered = sc->fcells;
   if (sc->gc_verbose) {
     char msg[80];
     snprintf(msg,80,"done: %ld cells were recovered.\n", sc->fcells);
     putstr(sc,msg);
   }
+  if(sc->gc_hook) {
+    sc->gc_hook(sc, 1);
+  }
 }
 
 static void finalize_cell(scheme *sc, cell_ptr a) {
@@ -4585,6 +4616,9 @@ int scheme_init_custom_alloc(scheme *sc, func_alloc malloc, func_dealloc free) {
   sc->nesting=0;
   sc->interactive_repl=0;
 
+  sc->gc_count=0;
+  sc->gc_recovered=0;
+  sc->gc_hook=0;
   if (alloc_cellseg(sc,FIRST_CELLSEGS) != FIRST_CELLSEGS) {
     sc->no_memory=1;
     return 0;
@@ -4671,6 +4705,10 @@ void scheme_set_output_port_string(scheme *sc, char *start, char *past_the_end)
   sc->outport=port_from_string(sc,start,past_the_end,port_output);
 }
 
+void scheme_set_gc_hook(scheme *sc, void (*hook)(scheme *sc, int done)) {
+  sc->gc_hook=hook;
+}
+
 void scheme_set_external_data(scheme *sc, void *p) {
  sc->ext_data=p;
 }
@@ -143,6 +143,7 @@ SCHEME_EXPORT cell_ptr scheme_apply0(scheme *sc, const char *procname);
 SCHEME_EXPORT cell_ptr scheme_call(scheme *sc, cell_ptr func, cell_ptr args);
 SCHEME_EXPORT cell_ptr scheme_eval(scheme *sc, cell_ptr obj);
 void scheme_set_external_data(scheme *sc, void *p);
+SCHEME_EXPORT void scheme_set_gc_hook(scheme *sc, void (*hook)(scheme *sc, int done));
 SCHEME_EXPORT void scheme_define(scheme *sc, cell_ptr env, cell_ptr symbol, cell_ptr value);
 
 typedef cell_ptr (*foreign_func)(scheme *, cell_ptr);
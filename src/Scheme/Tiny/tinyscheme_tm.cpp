@@ -12,6 +12,7 @@
 #include "tinyscheme_tm.hpp"
 #include "object.hpp"
 #include "glue.hpp"
+#include "tm_timer.hpp"
 
 
 
@@ -75,11 +76,24 @@ start_scheme (int argc, char** argv, void (*call_back) (int, char**)) {
 	
 }
 
+static void
+tinyscheme_gc_hook (scheme* sc, int done) {
+	// collection pauses are reported by the profiler and bench_print
+	(void) sc;
+	if (done) bench_cumul ("tinyscheme gc");
+	else {
+		bench_start ("tinyscheme gc");
+		// the cached tree wrappers are not protected, so they become stale
+		flush_tree_wrappers ();
+	}
+}
+
 void
 initialize_scheme () {
 	if(!scheme_init(the_scheme)) {
 		cout << "Could not initialize TinyScheme" << LF;
 	}
+	scheme_set_gc_hook(the_scheme, tinyscheme_gc_hook);
 	scheme_set_output_port_file(the_scheme, stdout);
 	scheme_set_input_port_file(the_scheme, stdin);
 
@@ -160,6 +174,7 @@ eval_scheme_file (string file) {
 	//static int cumul= 0;
 	//timer tm;
 	if (DEBUG_STD) debug_std << "Evaluating " << file << "...\n";
+	MEM_TAG_SCOPE (MEM_SCHEME);
 	c_string _file (file);
 	FILE *f = fopen(_file, "r");
 	scm result= scm_eval_file (f);
@@ -190,6 +205,7 @@ TeXmacs_eval_string (char *s) {
 scm
 eval_scheme (string s) {
 	// cout << "Eval] " << s << "\n";
+	MEM_TAG_SCOPE (MEM_SCHEME);
 	c_string _s (s);
 	scm result= scm_eval_string (_s);
 	return result;
@@ -203,6 +219,7 @@ struct arg_list { int  n; scm* a; };
 
 scm
 TeXmacs_call_scm (arg_list* args) {
+	MEM_TAG_SCOPE (MEM_SCHEME);
 	switch (args->n) {
 		default:
 		{
@@ -40,6 +40,32 @@ round_pow2 (int i) {
   return n;
 }
 
+/******************************************************************************
+* Slots for the standard variables
+******************************************************************************/
+
+// The keys of the variables which are read most often during the evaluation
+// are compiled once and for all, so that reading them does not require
+// a lookup of their names; standard environments cache their values by slot
+
+enum env_slot {
+  SLOT_DPI, SLOT_ZOOM_FACTOR, SLOT_MAGNIFICATION, SLOT_MODE, SLOT_LANGUAGE,
+  SLOT_FONT, SLOT_FONT_FAMILY, SLOT_FONT_SERIES, SLOT_FONT_SHAPE,
+  SLOT_FONT_SIZE, SLOT_FONT_BASE_SIZE, SLOT_MATH_LEVEL,
+  SLOT_MATH_FONT, SLOT_MATH_FONT_FAMILY,
+  SLOT_MATH_FONT_SERIES, SLOT_MATH_FONT_SHAPE,
+  SLOT_PROG_FONT, SLOT_PROG_FONT_FAMILY,
+  SLOT_PROG_FONT_SERIES, SLOT_PROG_FONT_SHAPE,
+  SLOT_PAR_WIDTH, SLOT_PAR_SEP, SLOT_PAGE_FLEXIBILITY, SLOT_COLOR,
+  SLOT_SRC_STYLE, SLOT_SRC_SPECIAL, SLOT_SRC_COMPACT, SLOT_SRC_CLOSE,
+  SLOT_BASE_FILE_NAME, SLOT_CUR_FILE_NAME,
+  ENV_SLOTS
+};
+
+extern bool env_slots_compiled;
+extern int  env_slot_key[ENV_SLOTS];
+void compile_env_slots ();
+
 /******************************************************************************
 * Abstract environments
 ******************************************************************************/
@@ -56,6 +82,9 @@ public:
   virtual void remove (int key) = 0;
   virtual void print (const string& prefix) = 0;
 
+  inline virtual tree read (env_slot slot) {
+    if (!env_slots_compiled) compile_env_slots ();
+    return read (env_slot_key[slot]); }
   inline bool contains (const string& key) {
     return contains ((int) make_tree_label (key)); }
   inline tree read (const string& key) {
@@ -72,6 +101,8 @@ class environment {
   ABSTRACT_NULL(environment);
   inline tree operator [] (int key) {
     return rep->read (key); }
+  inline tree operator [] (env_slot slot) {
+    return rep->read (slot); }
   inline tree operator [] (const string& key) {
     return rep->read (key); }
   inline friend environment_rep* as_pointer (const environment& env) {
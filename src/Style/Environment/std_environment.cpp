@@ -12,6 +12,30 @@
 #include "list_environment.hpp"
 #include "memorizer.hpp"
 #include "iterator.hpp"
+#include "vars.hpp"
+
+/******************************************************************************
+* Compilation of the slots for the standard variables
+******************************************************************************/
+
+bool env_slots_compiled= false;
+int  env_slot_key[ENV_SLOTS];
+
+void
+compile_env_slots () {
+  string names[ENV_SLOTS]= {
+    DPI, ZOOM_FACTOR, MAGNIFICATION, MODE, LANGUAGE,
+    FONT, FONT_FAMILY, FONT_SERIES, FONT_SHAPE,
+    FONT_SIZE, FONT_BASE_SIZE, MATH_LEVEL,
+    MATH_FONT, MATH_FONT_FAMILY, MATH_FONT_SERIES, MATH_FONT_SHAPE,
+    PROG_FONT, PROG_FONT_FAMILY, PROG_FONT_SERIES, PROG_FONT_SHAPE,
+    PAR_WIDTH, PAR_SEP, PAGE_FLEXIBILITY, COLOR,
+    SRC_STYLE, SRC_SPECIAL, SRC_COMPACT, SRC_CLOSE,
+    "base-file-name", "cur-file-name" };
+  for (int i=0; i<ENV_SLOTS; i++)
+    env_slot_key[i]= (int) make_tree_label (names[i]);
+  env_slots_compiled= true;
+}
 
 /******************************************************************************
 * Standard environments
@@ -39,6 +63,12 @@ public:
   std_environment  next;   // the next environment
   list_environment accel;  // accelerated access to environment
   list_environment args;   // recursive macro arguments environment
+  tree* slots;             // cached values of the standard variables
+  unsigned long long known;// the slots whose values are cached
+
+  // NOTE: environments are derived from others by sharing their lists,
+  // so that the slot caches assume that an environment is no longer
+  // modified once other environments have been derived from it
 
 public:
   inline std_environment_rep (bool pure2,
@@ -46,20 +76,29 @@ public:
 			      std_environment next2,
 			      list_environment accel2,
 			      list_environment args2):
-    pure (pure2), env (env2), next (next2), accel (accel2), args (args2) {}
+    pure (pure2), env (env2), next (next2), accel (accel2), args (args2),
+    slots (NULL), known (0) {}
+  inline ~std_environment_rep () {
+    if (slots != NULL) tm_delete_array (slots); }
 
   inline bool contains (int key) {
     return accel->contains (key); }
   inline tree read (int key) {
     return accel->read (key); }
+  inline tree read (env_slot slot) {
+    if ((known >> slot) & 1) return slots[slot];
+    return read_slot (slot); }
+  tree read_slot (env_slot slot);
   inline void write (int key, const tree& val) {
     env->write (key, val);
-    accel->write (key, val); }
+    accel->write (key, val);
+    known= 0; }
   inline void remove (int key) {
     // NOTE: it is not allowed to change next, in the case
     // when 'key' does not exist in the std environment 'env'
     env->remove (key);
-    accel->remove (key); }
+    accel->remove (key);
+    known= 0; }
   void print (const string& prefix);
 };
 
@@ -69,6 +108,15 @@ inline std_environment::std_environment
      rep (tm_new<std_environment_rep> (pure, env, next, accel, args)) {}
 ABSTRACT_NULL_CODE(std_environment);
 
+tree
+std_environment_rep::read_slot (env_slot slot) {
+  if (!env_slots_compiled) compile_env_slots ();
+  if (slots == NULL) slots= tm_new_array<tree> (ENV_SLOTS);
+  slots[slot]= accel->read (env_slot_key[slot]);
+  known |= ((unsigned long long) 1) << slot;
+  return slots[slot];
+}
+
 void
 std_environment_rep::print (const string& prefix) {
   cout << prefix << "Std environment" << LF;
@@ -153,6 +201,7 @@ public:
 
 void
 assign (environment& env, assoc_environment local) {
+  MEM_TAG_SCOPE (MEM_MEMORIZERS);
   memorizer mem= tm_new<assign_memorizer_rep> (env, local);
   if (!is_memorized (mem)) mem->compute ();
   env= mem->get_environment ();
@@ -195,6 +244,7 @@ public:
 
 void
 begin_with (environment& env, assoc_environment local) {
+  MEM_TAG_SCOPE (MEM_MEMORIZERS);
   memorizer mem= tm_new<begin_with_memorizer_rep> (env, local);
   if (!is_memorized (mem)) mem->compute ();
   env= mem->get_environment ();
@@ -243,6 +293,7 @@ public:
 
 void
 end_with (environment& env) {
+  MEM_TAG_SCOPE (MEM_MEMORIZERS);
   memorizer mem= tm_new<end_with_memorizer_rep> (env);
   if (!is_memorized (mem)) mem->compute ();
   env= mem->get_environment ();
@@ -313,6 +364,7 @@ public:
 
 void
 macro_down (environment& env, assoc_environment local) {
+  MEM_TAG_SCOPE (MEM_MEMORIZERS);
   memorizer mem= tm_new<macro_down_memorizer_rep> (env, local);
   if (!is_memorized (mem)) mem->compute ();
   env= mem->get_environment ();
@@ -320,6 +372,7 @@ macro_down (environment& env, assoc_environment local) {
 
 void
 macro_redown (environment& env, basic_environment local) {
+  MEM_TAG_SCOPE (MEM_MEMORIZERS);
   memorizer mem= tm_new<macro_redown_memorizer_rep> (env, local);
   if (!is_memorized (mem)) mem->compute ();
   env= mem->get_environment ();
@@ -375,6 +428,7 @@ public:
 
 void
 macro_up (environment& env) {
+  MEM_TAG_SCOPE (MEM_MEMORIZERS);
   memorizer mem= tm_new<macro_up_memorizer_rep> (env);
   if (!is_memorized (mem)) mem->compute ();
   env= mem->get_environment ();
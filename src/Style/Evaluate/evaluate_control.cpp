@@ -78,7 +78,7 @@ evaluate_for_each (tree t) {
 
 tree
 evaluate_include (tree t) {
-  url base_file_name (as_string (std_env["base-file-name"]));
+  url base_file_name (as_string (std_env [SLOT_BASE_FILE_NAME]));
   url incl_file_name= url_system (as_string (evaluate (t[0])));
   tree incl= load_inclusion (incl_file_name);
 
@@ -125,7 +125,7 @@ tree
 evaluate_use_package (tree t) {
   int i, n= N(t);
   for (i=0; i<n; i++) {
-    url base_file_name (as_string (std_env["base-file-name"]));
+    url base_file_name (as_string (std_env [SLOT_BASE_FILE_NAME]));
     url styp= "$TEXMACS_STYLE_PATH";
     url name= as_string (t[i]) * string (".ts");
     //cout << "Package " << name << "\n";
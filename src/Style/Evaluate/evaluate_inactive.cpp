@@ -125,21 +125,21 @@ retrieve (environment env) {
   string s;
   inactive_style sty;
 
-  s= as_string (env [SRC_STYLE]);
+  s= as_string (env [SLOT_SRC_STYLE]);
   if (s == "angular") sty->style= STYLE_ANGULAR;
   else if (s == "scheme") sty->style= STYLE_SCHEME;
   else if (s == "latex") sty->style= STYLE_LATEX;
   else if (s == "functional") sty->style= STYLE_FUNCTIONAL;
   else sty->style= STYLE_ANGULAR;
   
-  s= as_string (env [SRC_SPECIAL]);
+  s= as_string (env [SLOT_SRC_SPECIAL]);
   if (s == "raw") sty->special= SPECIAL_RAW;
   else if (s == "format") sty->special= SPECIAL_FORMAT;
   else if (s == "normal") sty->special= SPECIAL_NORMAL;
   else if (s == "maximal") sty->special= SPECIAL_MAXIMAL;
   else sty->special= SPECIAL_NORMAL;
 
-  s= as_string (env [SRC_COMPACT]);
+  s= as_string (env [SLOT_SRC_COMPACT]);
   if (s == "all") sty->compact= COMPACT_ALL;
   else if (s == "inline args") sty->compact= COMPACT_INLINE_ARGS;
   else if (s == "normal") sty->compact= COMPACT_INLINE_START;
@@ -147,7 +147,7 @@ retrieve (environment env) {
   else if (s == "none") sty->compact= COMPACT_NONE;
   else sty->compact= COMPACT_INLINE_START;
 
-  s= as_string (env [SRC_CLOSE]);
+  s= as_string (env [SLOT_SRC_CLOSE]);
   if (s == "minimal") sty->close= CLOSE_MINIMAL;
   else if (s == "compact") sty->close= CLOSE_COMPACT;
   else if (s == "long") sty->close= CLOSE_LONG;
@@ -335,7 +335,7 @@ rewrite_inactive_active (tree t, inactive_style sty) {
 
 tree
 rewrite_inactive_var_active (tree t, inactive_style sty) {
-  tree r= tree (WITH, mode_var, std_env [MODE], t[0]);
+  tree r= tree (WITH, mode_var, std_env [SLOT_MODE], t[0]);
   if (sty->flush &&
       (sty->compact != COMPACT_ALL) &&
       (is_multi_paragraph (t[0])) || (sty->compact == COMPACT_NONE))
@@ -119,22 +119,22 @@ as_length (tree t) {
 ******************************************************************************/
 
 inline SI std_inch () {
-  return (SI) ((double) as_int (std_env [DPI]) * PIXEL); }
+  return (SI) ((double) as_int (std_env [SLOT_DPI]) * PIXEL); }
 inline double std_zoom () {
-  return as_double (std_env [ZOOM_FACTOR]); }
+  return as_double (std_env [SLOT_ZOOM_FACTOR]); }
 inline int std_dpi () {
-  return as_int (std_env [DPI]); }
+  return as_int (std_env [SLOT_DPI]); }
 inline double std_magnification () {
-  return as_double (std_env [MAGNIFICATION]); }
+  return as_double (std_env [SLOT_MAGNIFICATION]); }
 inline int std_font_base_size () {
-  return as_int (std_env [FONT_BASE_SIZE]); }
+  return as_int (std_env [SLOT_FONT_BASE_SIZE]); }
 inline double std_font_size () {
-  return as_double (std_env [FONT_SIZE]); }
+  return as_double (std_env [SLOT_FONT_SIZE]); }
 inline int std_math_level () {
-  return as_int (std_env [MATH_LEVEL]); }
+  return as_int (std_env [SLOT_MATH_LEVEL]); }
 
 inline int std_mode () {
-  string s= as_string (std_env [MODE]);
+  string s= as_string (std_env [SLOT_MODE]);
   if (s == "text") return 1;
   else if (s == "math") return 2;
   else if (s == "prog") return 3;
@@ -146,32 +146,32 @@ std_fn () {
   switch (std_mode ()) {
   case 0:
   case 1:
-    return smart_font (as_string (std_env [FONT]),
-                       as_string (std_env [FONT_FAMILY]),
-                       as_string (std_env [FONT_SERIES]),
-                       as_string (std_env [FONT_SHAPE]),
+    return smart_font (as_string (std_env [SLOT_FONT]),
+                       as_string (std_env [SLOT_FONT_FAMILY]),
+                       as_string (std_env [SLOT_FONT_SERIES]),
+                       as_string (std_env [SLOT_FONT_SHAPE]),
                        script (fs, std_math_level ()),
                        (int) (std_magnification () * std_dpi ()));
   case 2:
-    return smart_font (as_string (std_env [MATH_FONT]),
-                       as_string (std_env [MATH_FONT_FAMILY]),
-                       as_string (std_env [MATH_FONT_SERIES]),
-                       as_string (std_env [MATH_FONT_SHAPE]),
-                       as_string (std_env [FONT]),
-                       as_string (std_env [FONT_FAMILY]),
-                       as_string (std_env [FONT_SERIES]),
+    return smart_font (as_string (std_env [SLOT_MATH_FONT]),
+                       as_string (std_env [SLOT_MATH_FONT_FAMILY]),
+                       as_string (std_env [SLOT_MATH_FONT_SERIES]),
+                       as_string (std_env [SLOT_MATH_FONT_SHAPE]),
+                       as_string (std_env [SLOT_FONT]),
+                       as_string (std_env [SLOT_FONT_FAMILY]),
+                       as_string (std_env [SLOT_FONT_SERIES]),
                        "mathitalic",
                        script (fs, std_math_level ()),
                        (int) (std_magnification () * std_dpi ()));
   case 3:
-    return smart_font (as_string (std_env [PROG_FONT]),
-                       as_string (std_env [PROG_FONT_FAMILY]),
-                       as_string (std_env [PROG_FONT_SERIES]),
-                       as_string (std_env [PROG_FONT_SHAPE]),
-                       as_string (std_env [FONT]),
-                       as_string (std_env [FONT_FAMILY]) * "-tt",
-                       as_string (std_env [FONT_SERIES]),
-                       as_string (std_env [FONT_SHAPE]),
+    return smart_font (as_string (std_env [SLOT_PROG_FONT]),
+                       as_string (std_env [SLOT_PROG_FONT_FAMILY]),
+                       as_string (std_env [SLOT_PROG_FONT_SERIES]),
+                       as_string (std_env [SLOT_PROG_FONT_SHAPE]),
+                       as_string (std_env [SLOT_FONT]),
+                       as_string (std_env [SLOT_FONT_FAMILY]) * "-tt",
+                       as_string (std_env [SLOT_FONT_SERIES]),
+                       as_string (std_env [SLOT_FONT_SHAPE]),
                        script (fs, std_math_level ()),
                        (int) (std_magnification () * std_dpi ()));
   default:
@@ -252,7 +252,7 @@ as_vspace (tree t) {
     SI _min= (SI) as_double (r[0]->label);
     SI _def= (SI) as_double (r[1]->label);
     SI _max= (SI) as_double (r[2]->label);
-    double flexibility= as_double (std_env [PAGE_FLEXIBILITY]);
+    double flexibility= as_double (std_env [SLOT_PAGE_FLEXIBILITY]);
     return space (_def + ((SI) (flexibility * (_min - _def))),
 		  _def,
 		  _def + ((SI) (flexibility * (_max - _def))));
@@ -264,7 +264,7 @@ evaluate_bls_length () {
   double fs= (std_font_base_size () * std_magnification () *
 	      std_inch () * std_font_size ()) / 72.0;
   return tmlen_plus (tree (TMLEN, as_string (fs)),
-		     tree (as_vspace (std_env [PAR_SEP])));
+		     tree (as_vspace (std_env [SLOT_PAR_SEP])));
 }
 
 tree
@@ -99,8 +99,8 @@ evaluate_set_binding (tree t) {
     string key= keys[i]->label;
     tree old_value= local_ref[key];
     string part= as_string (std_env ["current-part"]);
-    url base_file_name (as_string (std_env ["base-file-name"]));
-    url cur_file_name (as_string (std_env ["cur-file-name"]));
+    url base_file_name (as_string (std_env [SLOT_BASE_FILE_NAME]));
+    url cur_file_name (as_string (std_env [SLOT_CUR_FILE_NAME]));
     if (is_func (old_value, TUPLE) && (N(old_value) >= 2))
       local_ref (key)= tuple (copy (value), old_value[1]);
     else local_ref (key)= tuple (copy (value), "?");
@@ -145,7 +145,7 @@ evaluate_get_binding (tree t) {
 
 tree
 evaluate_pattern (tree t) {
-  url base_file_name (as_string (std_env ["base-file-name"]));
+  url base_file_name (as_string (std_env [SLOT_BASE_FILE_NAME]));
   url im= evaluate_string (t[0]);
   url image= resolve_pattern (relative (base_file_name, im));
   if (is_none (image)) return "white";
@@ -133,7 +133,7 @@ rewrite_impl (tree t) {
 #endif // CLASSICAL_MACRO_EXPANSION
   case VAR_INCLUDE:
     {
-      url base_file_name (as_string (std_env ["base-file-name"]));
+      url base_file_name (as_string (std_env [SLOT_BASE_FILE_NAME]));
       url file_name= url_system (evaluate_string (t[0]));
       return load_inclusion (relative (base_file_name, file_name));
     }
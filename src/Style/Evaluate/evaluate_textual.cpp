@@ -113,7 +113,7 @@ evaluate_number (tree t) {
 tree
 evaluate_date (tree t) {
   if (N(t)>2) return evaluate_error ("bad date");
-  string lan= as_string (std_env [LANGUAGE]);
+  string lan= as_string (std_env [SLOT_LANGUAGE]);
   if (N(t) == 2) {
     tree u= evaluate (t[1]);
     if (is_compound (u)) return evaluate_error ("bad date");
@@ -197,7 +197,7 @@ evaluate_find_file (tree t) {
       return as_string (u);
     }
   }
-  url base_file_name (as_string (std_env["base-file-name"]));
+  url base_file_name (as_string (std_env [SLOT_BASE_FILE_NAME]));
   url u= resolve (base_file_name * url_parent () * r[n-1]->label);
   if (!is_none (u)) {
     if (is_rooted (u, "default")) u= reroot (u, "file");
@@ -11,6 +11,7 @@
 
 #include "memorizer.hpp"
 #include "environment.hpp"
+#include "tm_timer.hpp"
 
 /******************************************************************************
 * Default implementations
@@ -285,48 +286,113 @@ bigmem_remove (memorizer_ptr ptr) {
   FAILED ("pointer not found");
 }
 
+/******************************************************************************
+* The store of recently used memorizers
+******************************************************************************/
+
+// Memorizers only survive as long as they are referenced, so the store keeps
+// a reference to the most recently used ones, which can then be reused by
+// later evaluations.  The store has a fixed capacity; when it is full, a
+// memorizer which was not used during the last turn of the clock hand is
+// evicted, which approximates least recently used replacement in O(1).
+// The capacity bounds the number of memorizers which are kept alive by the
+// store, not the memory used by them, and memorizers live longer than
+// they would without the store.
+
+#define MEMORIZER_STORE_SIZE (1<<16)
+
+static int store_max= MEMORIZER_STORE_SIZE;
+static int store_hand= 0;
+static memorizer_ptrs store= NULL;
+
+static void
+memorizer_release (memorizer_ptr ptr) {
+  ptr->ref_count--;
+  if (ptr->ref_count == 0) {
+    bigmem_remove (ptr);
+    tm_delete (ptr);
+  }
+}
+
+static void
+store_evict (int i) {
+  memorizer_ptr ptr= store[i];
+  store[i]= NULL;
+  ptr->stored= false;
+  PROFILE_TALLY ("memorizer evictions");
+  memorizer_release (ptr);
+}
+
+static void
+store_insert (memorizer_ptr ptr) {
+  if (store_max <= 0) return;
+  if (store == NULL) {
+    store= tm_new_array<memorizer_ptr> (store_max);
+    for (int i=0; i<store_max; i++) store[i]= NULL;
+  }
+  while (store[store_hand] != NULL) {
+    if (!store[store_hand]->recent) { store_evict (store_hand); break; }
+    store[store_hand]->recent= false;
+    store_hand= (store_hand + 1) % store_max;
+  }
+  store[store_hand]= ptr;
+  store_hand= (store_hand + 1) % store_max;
+  ptr->stored= true;
+  ptr->recent= false;
+  ptr->ref_count++;
+}
+
+void
+set_memorizer_store_size (int n) {
+  // the memorizers which are no longer referenced elsewhere are freed
+  if (store != NULL) {
+    for (int i=0; i<store_max; i++)
+      if (store[i] != NULL) store_evict (i);
+    tm_delete_array (store);
+    store= NULL;
+  }
+  store_max= max (n, 0);
+  store_hand= 0;
+}
+
+/******************************************************************************
+* Memorizer handles
+******************************************************************************/
+
 memorizer::memorizer (memorizer_rep* ptr) {
   rep= bigmem_insert (ptr);
   //cout << "construct " << ptr << " -> " << rep << LF;
-  if (rep != ptr) tm_delete (ptr);
+  if (rep != ptr) {
+    tm_delete (ptr);
+    rep->memorized= true;
+    rep->recent= true;
+    PROFILE_TALLY ("memorizer hits");
+  }
+  else PROFILE_TALLY ("memorizer misses");
+  // acquire the references before releasing others, which might own rep
+  rep->ref_count++;
   //cout << "  set " << mem_pos[mem_cur] << ": " << rep << LF;
   memorizer_rep*& old_rep (mem_stack[mem_pos[mem_cur]++].rep);
-  if (rep == old_rep) rep->ref_count++;
-  else {
-    if (old_rep != NULL) {
-      old_rep->ref_count--;
-      if (old_rep->ref_count == 0) tm_delete (old_rep);
-    }
+  if (rep != old_rep) {
+    rep->ref_count++;
+    if (old_rep != NULL) memorizer_release (old_rep);
     old_rep= rep;
-    rep->ref_count += 2;
   }
+  if (!rep->stored) store_insert (rep);
   if (mem_pos[mem_cur] == mem_max_stack)
     double_size (mem_stack, mem_max_stack);
 }
 
 memorizer::~memorizer () {
-  if (rep != NULL) {
-    rep->ref_count--;
-    //cout << "destroy " << rep << ", " << rep->ref_count << LF;
-    if (rep->ref_count == 0) {
-      bigmem_remove (rep);
-      tm_delete (rep);
-    }
-  }
+  //cout << "destroy " << rep << LF;
+  if (rep != NULL) memorizer_release (rep);
 }
 
 memorizer&
 memorizer::operator = (memorizer mem) {
   //cout << "assign " << rep << ", " << mem.rep << LF;
   if (rep == mem.rep) return *this;
-  if (rep != NULL) {
-    rep->ref_count--;
-    //cout << "refcount " << rep << ", " << rep->ref_count << "\n";
-    if (rep->ref_count == 0) {
-      bigmem_remove (rep);
-      tm_delete (rep);
-    }
-  }
+  if (rep != NULL) memorizer_release (rep);
   rep= mem.rep;
   if (rep != NULL) rep->ref_count++;
   return *this;
@@ -34,7 +34,12 @@ extern int memorizer_count;
 class memorizer;
 class memorizer_rep: public abstract_struct {
 public:
-  inline memorizer_rep () { TM_DEBUG (memorizer_count++); }
+  bool memorized;  // the memorizer was looked up again after its creation
+  bool recent;     // used since the last pass of the store's clock hand
+  bool stored;     // the store of recent memorizers holds a reference
+
+  inline memorizer_rep (): memorized (false), recent (false), stored (false) {
+    TM_DEBUG (memorizer_count++); }
   inline virtual ~memorizer_rep () { TM_DEBUG (memorizer_count--); }
 
   virtual void print (tm_ostream& out) = 0;
@@ -65,7 +70,7 @@ public:
   memorizer& operator = (memorizer mem);
   inline memorizer_rep* operator -> () { return rep; }
   inline friend bool is_memorized (const memorizer& mem) {
-    return mem.rep->ref_count >= 3; }
+    return mem.rep->memorized; }
   inline friend bool operator == (memorizer o1, memorizer o2) {
     return o1.rep->type () == o2.rep->type () && o1.rep->equal (o2.rep); }
   inline friend bool operator != (memorizer o1, memorizer o2) {
@@ -101,5 +106,6 @@ void memorize_initialize ();
 memorizer memorize_finalize ();
 void memorize_start ();
 void memorize_end ();
+void set_memorizer_store_size (int n);
 
 #endif // defined MEMORIZER_H
@@ -17,7 +17,12 @@
 #include "merge_sort.hpp"
 #include "drd_std.hpp"
 #include "language.hpp"
+#include "tm_timer.hpp"
 #include <unistd.h>
+#ifndef OS_MINGW
+#include <signal.h>
+#include <errno.h>
+#endif
 #ifdef OS_MINGW
 #include <time.h>
 #include <direct.h>
@@ -141,6 +146,10 @@ url_temp_dir () {
 
 bool
 process_running (int pid) {
+#ifndef OS_MINGW
+  // avoid spawning 'ps' for the directories of processes which are gone
+  if (kill ((pid_t) pid, 0) != 0 && errno == ESRCH) return false;
+#endif
   string cmd= "ps -p " * as_string (pid);
   string ret= eval_system (cmd);
   return occurs ("texmacs", ret) && occurs (as_string (pid), ret);
@@ -497,28 +506,59 @@ setup_texmacs () {
 * Initialization of TeXmacs
 ******************************************************************************/
 
+static array<string> boot_phases;
+
+static void
+boot_start (string phase) {
+  // the timings of the phases are printed at startup using -debug-bench
+  boot_phases << ("boot " * phase);
+  bench_start ("boot " * phase);
+}
+
+static void
+boot_end (string phase) {
+  bench_cumul ("boot " * phase);
+}
+
+void
+reset_boot_timings () {
+  for (int i=0; i<N(boot_phases); i++)
+    bench_reset (boot_phases[i]);
+  boot_phases= array<string> ();
+}
+
 void
 init_texmacs () {
-  //cout << "Initialize -- Main paths\n";
+  boot_start ("main paths");
   init_main_paths ();
-  //cout << "Initialize -- User dirs\n";
+  boot_end ("main paths");
+  boot_start ("user dirs");
   init_user_dirs ();
-  //cout << "Initialize -- Boot lock\n";
+  boot_end ("user dirs");
+  boot_start ("boot lock");
   acquire_boot_lock ();
-  //cout << "Initialize -- Succession status table\n";
+  boot_end ("boot lock");
+  boot_start ("succession status table");
   init_succession_status_table ();
-  //cout << "Initialize -- Succession standard DRD\n";
+  boot_end ("succession status table");
+  boot_start ("standard drd");
   init_std_drd ();
-  //cout << "Initialize -- User preferences\n";
+  boot_end ("standard drd");
+  boot_start ("user preferences");
   load_user_preferences ();
-  //cout << "Initialize -- Guile\n";
+  boot_end ("user preferences");
+  boot_start ("guile");
   init_guile ();
-  //cout << "Initialize -- Environment variables\n";
+  boot_end ("guile");
+  boot_start ("environment variables");
   init_env_vars ();
-  //cout << "Initialize -- Miscellaneous\n";
+  boot_end ("environment variables");
+  boot_start ("miscellaneous");
   init_misc ();
-  //cout << "Initialize -- Deprecated\n";
+  boot_end ("miscellaneous");
+  boot_start ("deprecated");
   init_deprecated ();
+  boot_end ("deprecated");
 }
 
 /******************************************************************************
@@ -528,6 +568,7 @@ init_texmacs () {
 void
 init_plugins () {
   install_status= 0;
+  boot_start ("settings");
   url old_settings= "$TEXMACS_HOME_PATH/system/TEX_PATHS";
   url new_settings= "$TEXMACS_HOME_PATH/system/settings.scm";
   string s;
@@ -544,5 +585,8 @@ init_plugins () {
     url ch ("$TEXMACS_HOME_PATH/doc/about/changes/changes-recent.en.tm");
     install_status= exists (ch)? 2: 0;
   }
+  boot_end ("settings");
+  boot_start ("tex");
   init_tex ();
+  boot_end ("tex");
 }
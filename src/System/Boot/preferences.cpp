@@ -35,6 +35,7 @@ set_user_preference (string var, string val) {
   if (val == "default") user_prefs->reset (var);
   else user_prefs (var)= val;
   user_prefs_modified= true;
+  reset_conversion_caches ();
   notify_preference (var);
 }
 
@@ -42,6 +43,7 @@ void
 reset_user_preference (string var) {
   user_prefs->reset (var);
   user_prefs_modified= true;
+  reset_conversion_caches ();
   notify_preference (var);
 }
 
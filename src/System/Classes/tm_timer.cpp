@@ -12,6 +12,7 @@
 #include "tm_timer.hpp"
 #include "iterator.hpp"
 #include "merge_sort.hpp"
+#include <time.h>
 
 static hashmap<string,int> timing_level (0);
 static hashmap<string,int> timing_nr    (0);
@@ -50,6 +51,25 @@ texmacs_time () {
 #endif
 }
 
+nano_time
+texmacs_nanotime () {
+#ifdef CLOCK_MONOTONIC
+  struct timespec ts;
+  clock_gettime (CLOCK_MONOTONIC, &ts);
+  return ((nano_time) ts.tv_sec) * 1000000000 + ((nano_time) ts.tv_nsec);
+#else
+#ifdef HAVE_GETTIMEOFDAY
+  struct timeval tp;
+  gettimeofday (&tp, NULL);
+  return ((nano_time) tp.tv_sec) * 1000000000 + ((nano_time) tp.tv_usec) * 1000;
+#else
+  timeb tb;
+  ftime (&tb);
+  return ((nano_time) tb.time) * 1000000000 + ((nano_time) tb.millitm) * 1000000;
+#endif
+#endif
+}
+
 /******************************************************************************
 * Routines for benchmarking
 ******************************************************************************/
@@ -57,6 +77,7 @@ texmacs_time () {
 void
 bench_start (string task) {
   // start timer for a given type of task
+  if (profile_on) profile_enter (profile_counter (task));
   if (timing_level [task] == 0)
     timing_last (task)= (int) texmacs_time ();
   timing_level (task) ++;
@@ -65,6 +86,7 @@ bench_start (string task) {
 void
 bench_cumul (string task) {
   // end timer for a given type of task, but don't reset timer
+  if (profile_on) profile_leave (profile_counter (task));
   timing_level (task) --;
   if (timing_level [task] == 0) {
     int ms= ((int) texmacs_time ()) - timing_last (task);
@@ -120,4 +142,429 @@ bench_print () {
   int i, n= N(a);
   for (i=0; i<n; i++)
     bench_print (a[i]);
+  profile_print ();
+}
+
+/******************************************************************************
+* Hierarchical profiling
+******************************************************************************/
+
+struct profile_node {
+  int       counter; // the timed task
+  int       parent;  // the calling node (-1 for the root)
+  int       child;   // first callee (-1 if none)
+  int       next;    // next callee of the parent (-1 if none)
+  int       calls;   // number of invocations along this call path
+  nano_time total;   // cumulated time in nanoseconds, including callees
+};
+
+bool profile_on= false;
+static profile_node* profile_nodes= NULL;
+static int           profile_nodes_n= 0;
+static int           profile_nodes_max= 0;
+static int*          profile_stack= NULL;   // active nodes
+static nano_time*    profile_starts= NULL;  // their starting times
+static int           profile_depth= 0;
+static int           profile_depth_max= 0;
+static long long*    profile_counts= NULL;  // event counts by counter
+static int           profile_counts_max= 0;
+
+static array<string>&
+profile_names () {
+  static array<string> names;
+  return names;
+}
+
+int
+profile_counter (string name) {
+  // return the unique counter for a given task name
+  static hashmap<string,int> ids (-1);
+  int id= ids[name];
+  if (id < 0) {
+    id= N (profile_names ());
+    profile_names () << name;
+    ids (name)= id;
+  }
+  return id;
+}
+
+static int
+profile_new_node (int counter, int parent) {
+  if (profile_nodes_n == profile_nodes_max) {
+    int nmax= max (16, 2 * profile_nodes_max);
+    profile_node* nodes= tm_new_array<profile_node> (nmax);
+    for (int i=0; i<profile_nodes_n; i++) nodes[i]= profile_nodes[i];
+    if (profile_nodes != NULL) tm_delete_array (profile_nodes);
+    profile_nodes= nodes;
+    profile_nodes_max= nmax;
+  }
+  int i= profile_nodes_n++;
+  profile_node& nd= profile_nodes[i];
+  nd.counter= counter; nd.parent= parent; nd.child= -1; nd.next= -1;
+  nd.calls= 0; nd.total= 0;
+  if (parent >= 0) {
+    int* last= &(profile_nodes[parent].child);
+    while (*last >= 0) last= &(profile_nodes[*last].next);
+    *last= i;
+  }
+  return i;
+}
+
+void
+profile_enter (int counter) {
+  if (profile_nodes_n == 0) profile_new_node (-1, -1);
+  int parent= profile_depth == 0? 0: profile_stack[profile_depth-1];
+  int i= profile_nodes[parent].child;
+  while (i >= 0 && profile_nodes[i].counter != counter)
+    i= profile_nodes[i].next;
+  if (i < 0) i= profile_new_node (counter, parent);
+  if (profile_depth == profile_depth_max) {
+    int nmax= max (16, 2 * profile_depth_max);
+    int* stack= tm_new_array<int> (nmax);
+    nano_time* starts= tm_new_array<nano_time> (nmax);
+    for (int j=0; j<profile_depth; j++) {
+      stack[j]= profile_stack[j]; starts[j]= profile_starts[j]; }
+    if (profile_stack != NULL) {
+      tm_delete_array (profile_stack); tm_delete_array (profile_starts); }
+    profile_stack= stack; profile_starts= starts;
+    profile_depth_max= nmax;
+  }
+  profile_stack[profile_depth]= i;
+  profile_starts[profile_depth]= texmacs_nanotime ();
+  profile_depth++;
+}
+
+void
+profile_leave (int counter) {
+  // close the innermost active scope for counter, together with
+  // the scopes which were left open inside it (e.g. by exceptions)
+  nano_time now= texmacs_nanotime ();
+  int d= profile_depth - 1;
+  while (d >= 0 && profile_nodes[profile_stack[d]].counter != counter) d--;
+  if (d < 0) return;
+  while (profile_depth > d) {
+    profile_depth--;
+    profile_node& nd= profile_nodes[profile_stack[profile_depth]];
+    nd.calls++;
+    nd.total += now - profile_starts[profile_depth];
+  }
+}
+
+void
+profile_start () {
+  profile_on= true;
+}
+
+void
+profile_stop () {
+  profile_on= false;
+  profile_depth= 0;
+}
+
+void
+profile_reset () {
+  // forget the timings, but keep the call tree, since active scopes
+  // may still refer to its nodes
+  for (int i=0; i<profile_nodes_n; i++) {
+    profile_nodes[i].calls= 0;
+    profile_nodes[i].total= 0;
+  }
+  nano_time now= texmacs_nanotime ();
+  for (int d=0; d<profile_depth; d++) profile_starts[d]= now;
+  for (int i=0; i<profile_counts_max; i++) profile_counts[i]= 0;
+}
+
+/******************************************************************************
+* Event counts, such as cache hits and misses
+******************************************************************************/
+
+void
+profile_tally (int counter, int n) {
+  if (counter >= profile_counts_max) {
+    int nmax= max (16, max (counter + 1, 2 * profile_counts_max));
+    long long* counts= tm_new_array<long long> (nmax);
+    for (int i=0; i<nmax; i++)
+      counts[i]= (i < profile_counts_max? profile_counts[i]: 0);
+    if (profile_counts != NULL) tm_delete_array (profile_counts);
+    profile_counts= counts;
+    profile_counts_max= nmax;
+  }
+  profile_counts[counter] += n;
+}
+
+long long
+profile_tallies (string name) {
+  int counter= profile_counter (name);
+  return counter < profile_counts_max? profile_counts[counter]: 0;
+}
+
+/******************************************************************************
+* Reporting
+******************************************************************************/
+
+static nano_time
+profile_self (int i) {
+  nano_time t= profile_nodes[i].total;
+  for (int j= profile_nodes[i].child; j >= 0; j= profile_nodes[j].next)
+    t -= profile_nodes[j].total;
+  return max (t, (nano_time) 0);
+}
+
+static void
+profile_print (int i, string indent) {
+  profile_node nd= profile_nodes[i];
+  if (nd.calls == 0) return;
+  std_bench << indent << profile_names ()[nd.counter] << ": "
+            << as_string (((double) nd.total) / 1000000.0) << " ms";
+  if (nd.calls > 1) std_bench << " (" << nd.calls << " invocations)";
+  if (nd.child >= 0)
+    std_bench << ", self " << as_string (((double) profile_self (i)) / 1000000.0)
+              << " ms";
+  std_bench << "\n";
+  for (int j= nd.child; j >= 0; j= profile_nodes[j].next)
+    profile_print (j, indent * "  ");
+}
+
+void
+profile_print () {
+  // print the call tree of the profiled tasks
+  if (!DEBUG_BENCH) return;
+  if (profile_nodes_n != 0)
+    for (int j= profile_nodes[0].child; j >= 0; j= profile_nodes[j].next)
+      profile_print (j, "");
+  for (int i=0; i<profile_counts_max; i++)
+    if (profile_counts[i] != 0)
+      std_bench << profile_names ()[i] << ": "
+                << as_string (profile_counts[i]) << " times\n";
+}
+
+static nano_time
+profile_time (int i, int counter) {
+  profile_node nd= profile_nodes[i];
+  if (nd.counter == counter) return nd.total;
+  nano_time t= 0;
+  for (int j= nd.child; j >= 0; j= profile_nodes[j].next)
+    t += profile_time (j, counter);
+  return t;
+}
+
+double
+profile_time (string name) {
+  // the time in ms spent in a task along all call paths; recursive
+  // invocations of the task are only counted once
+  if (profile_nodes_n == 0) return 0.0;
+  return ((double) profile_time (0, profile_counter (name))) / 1000000.0;
+}
+
+static void
+profile_flamegraph (string& r, int i, string path) {
+  profile_node nd= profile_nodes[i];
+  if (nd.calls == 0) return;
+  path= (path == ""? path: path * ";") * profile_names ()[nd.counter];
+  nano_time self= profile_self (i) / 1000;
+  if (self > 0) r << path << " " << as_string (self) << "\n";
+  for (int j= nd.child; j >= 0; j= profile_nodes[j].next)
+    profile_flamegraph (r, j, path);
+}
+
+string
+profile_flamegraph () {
+  // folded stacks with the self times in microseconds, as expected by
+  // flamegraph.pl and compatible viewers
+  string r;
+  if (profile_nodes_n == 0) return r;
+  for (int j= profile_nodes[0].child; j >= 0; j= profile_nodes[j].next)
+    profile_flamegraph (r, j, "");
+  return r;
+}
+
+static string
+profile_json_quote (string s) {
+  string r;
+  for (int i=0; i<N(s); i++) {
+    if (s[i] == '\"' || s[i] == '\\') r << '\\';
+    if (((unsigned char) s[i]) >= 32) r << s[i];
+  }
+  return r;
+}
+
+static void
+profile_chrome_trace (string& r, bool& first, int i, nano_time start) {
+  // the aggregated call tree is laid out as a single flame chart,
+  // in which the callees of a node follow each other
+  profile_node nd= profile_nodes[i];
+  if (nd.calls == 0) return;
+  if (!first) r << ",\n";
+  first= false;
+  r << "{\"name\":\"" << profile_json_quote (profile_names ()[nd.counter])
+    << "\",\"ph\":\"X\",\"pid\":1,\"tid\":1"
+    << ",\"ts\":" << as_string (start / 1000)
+    << ",\"dur\":" << as_string (nd.total / 1000)
+    << ",\"args\":{\"calls\":" << as_string (nd.calls) << "}}";
+  for (int j= nd.child; j >= 0; j= profile_nodes[j].next) {
+    profile_chrome_trace (r, first, j, start);
+    start += profile_nodes[j].total;
+  }
+}
+
+string
+profile_chrome_trace () {
+  // JSON in the trace event format of chrome://tracing and Perfetto
+  string r= "{\"traceEvents\":[";
+  nano_time start= 0;
+  bool first= true;
+  if (profile_nodes_n != 0)
+    for (int j= profile_nodes[0].child; j >= 0; j= profile_nodes[j].next) {
+      profile_chrome_trace (r, first, j, start);
+      start += profile_nodes[j].total;
+    }
+  r << "]}\n";
+  return r;
+}
+
+/******************************************************************************
+* Latency of interactive events
+******************************************************************************/
+
+bool latency_on= false;
+static int            latency_budget= 0;      // in ms; 0 for no logging
+static bool           latency_open  = false;  // an event is being handled
+static nano_time      latency_begin_time= 0;
+static nano_time      latency_last_time = 0;
+static array<string>  latency_names;          // stages of the current event
+static array<nano_time> latency_times;
+static array<int>     latency_totals;         // in microseconds
+static hashmap<string,int> latency_slowest (0);
+static hashmap<string,int> latency_cumul (0);  // in microseconds
+static hashmap<string,array<int> > latency_samples;  // by stage
+
+void
+latency_start (int budget) {
+  latency_on= true;
+  latency_budget= budget;
+}
+
+void
+latency_stop () {
+  latency_on= false;
+  latency_open= false;
+}
+
+void
+latency_reset () {
+  latency_open= false;
+  latency_totals = array<int> ();
+  latency_slowest= hashmap<string,int> (0);
+  latency_cumul  = hashmap<string,int> (0);
+  latency_samples= hashmap<string,array<int> > ();
+}
+
+void
+latency_event_begin () {
+  // events which arrive before the previous one was painted are merged
+  if (latency_open) return;
+  latency_open= true;
+  latency_begin_time= latency_last_time= texmacs_nanotime ();
+  latency_names= array<string> ();
+  latency_times= array<nano_time> ();
+}
+
+void
+latency_event_stage (const char* stage) {
+  // the time since the previous mark is attributed to stage
+  if (!latency_open) return;
+  nano_time now= texmacs_nanotime ();
+  string name (stage);
+  int i, n= N(latency_names);
+  for (i=0; i<n; i++)
+    if (latency_names[i] == name) break;
+  if (i == n) { latency_names << name; latency_times << ((nano_time) 0); }
+  latency_times[i] += now - latency_last_time;
+  latency_last_time= now;
+}
+
+static string
+latency_ms (nano_time t) {
+  return as_string (((double) t) / 1000000.0) * " ms";
+}
+
+void
+latency_event_end () {
+  if (!latency_open) return;
+  latency_event_stage ("repaint");
+  latency_open= false;
+  nano_time total= latency_last_time - latency_begin_time;
+  int i, n= N(latency_names), slow= 0;
+  for (i=0; i<n; i++) {
+    latency_cumul (latency_names[i]) += (int) (latency_times[i] / 1000);
+    if (!latency_samples->contains (latency_names[i]))
+      latency_samples (latency_names[i])= array<int> ();
+    latency_samples (latency_names[i]) << (int) (latency_times[i] / 1000);
+    if (latency_times[i] > latency_times[slow]) slow= i;
+  }
+  if (n > 0) latency_slowest (latency_names[slow]) += 1;
+  latency_totals << (int) (total / 1000);
+  if (latency_budget > 0 && total > ((nano_time) latency_budget) * 1000000) {
+    std_bench << "Event took " << latency_ms (total) << ":";
+    for (i=0; i<n; i++)
+      std_bench << " " << latency_names[i] << " " << latency_ms (latency_times[i]);
+    std_bench << "\n";
+  }
+}
+
+string
+latency_report () {
+  int n= N(latency_totals);
+  if (n == 0) return "";
+  array<int> a= copy (latency_totals);
+  merge_sort (a);
+  string r= as_string (n) * " events;";
+  int p[4]= { 50, 90, 99, 100 };
+  for (int i=0; i<4; i++) {
+    int k= min (n - 1, (p[i] * n) / 100);
+    r << " p" << as_string (p[i]) << " "
+      << latency_ms (((nano_time) a[k]) * 1000);
+    if (i < 3) r << ",";
+  }
+  r << "\n";
+  array<string> stages= collect (latency_cumul);
+  for (int i=0; i<N(stages); i++)
+    r << stages[i] << ": mean "
+      << latency_ms ((((nano_time) latency_cumul[stages[i]]) * 1000) / n)
+      << ", slowest in " << as_string (latency_slowest[stages[i]])
+      << " events\n";
+  return r;
+}
+
+static string
+latency_line (string name, array<int> a) {
+  // durations in microseconds, summarized in ms
+  int n= N(a);
+  if (n == 0) return "";
+  a= copy (a);
+  merge_sort (a);
+  long long int sum= 0;
+  for (int i=0; i<n; i++) sum += a[i];
+  string r= name * "," * as_string (n) * ",";
+  r << as_string (((double) sum) / (1000.0 * n));
+  int p[4]= { 50, 90, 99, 100 };
+  for (int i=0; i<4; i++)
+    r << "," << as_string (a[min (n - 1, (p[i] * n) / 100)] / 1000.0);
+  return r * "\n";
+}
+
+string
+latency_distribution () {
+  // comma separated values for the whole events and for each stage
+  string r= "stage,events,mean_ms,p50_ms,p90_ms,p99_ms,max_ms\n";
+  r << latency_line ("total", latency_totals);
+  array<string> stages= collect (latency_cumul);
+  for (int i=0; i<N(stages); i++)
+    r << latency_line (stages[i], latency_samples[stages[i]]);
+  return r;
+}
+
+void
+latency_print () {
+  if (latency_on) std_bench << latency_report ();
 }
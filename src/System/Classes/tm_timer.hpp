@@ -48,4 +48,73 @@ void   bench_reset (string task);
 void   bench_print (string task);
 void   bench_print ();
 
+/******************************************************************************
+* Hierarchical profiling
+*
+* PROFILE_SCOPE ("name") times the remaining part of the enclosing block.
+* The counter is interned once per call site, so that the cost of a scope is
+* a test of profile_on when profiling is off, and two clock reads otherwise.
+* Timings are aggregated along call paths; the legacy bench_start and
+* bench_cumul calls are also recorded in the call tree.
+******************************************************************************/
+
+typedef long long int nano_time;
+nano_time texmacs_nanotime ();
+
+extern bool profile_on;
+int    profile_counter (string name);
+void   profile_enter (int counter);
+void   profile_leave (int counter);
+void   profile_start ();
+void   profile_stop ();
+void   profile_reset ();
+void   profile_print ();
+double profile_time (string name);
+string profile_flamegraph ();
+string profile_chrome_trace ();
+void   profile_tally (int counter, int n= 1);
+long long profile_tallies (string name);
+
+class profile_scope {
+  int counter;
+public:
+  inline profile_scope (int c): counter (c) {
+    if (profile_on) profile_enter (counter); }
+  inline ~profile_scope () {
+    if (profile_on) profile_leave (counter); }
+};
+
+#define PROFILE_SCOPE(name) \
+  static int profile_scope_counter= profile_counter (name); \
+  profile_scope profile_scope_instance (profile_scope_counter)
+
+#define PROFILE_TALLY(name) { \
+  static int profile_tally_counter= profile_counter (name); \
+  if (profile_on) profile_tally (profile_tally_counter); }
+
+/******************************************************************************
+* Latency of interactive events
+*
+* LATENCY_BEGIN () marks the arrival of an event such as a keypress,
+* LATENCY_STAGE ("name") attributes the time since the previous mark to the
+* stage name, and LATENCY_END () marks the moment when the result is painted.
+* When latency measurement is off, each mark is a test of latency_on.
+* Events which exceed the budget (in ms) are reported with their stages.
+******************************************************************************/
+
+extern bool latency_on;
+void   latency_start (int budget= 0);
+void   latency_stop ();
+void   latency_reset ();
+void   latency_event_begin ();
+void   latency_event_stage (const char* stage);
+void   latency_event_end ();
+string latency_report ();
+string latency_distribution ();
+void   latency_print ();
+
+#define LATENCY_BEGIN() { if (latency_on) latency_event_begin (); }
+#define LATENCY_STAGE(name) { if (latency_on) latency_event_stage (name); }
+#define LATENCY_END() { if (latency_on) latency_event_end (); }
+
 #endif // defined TIMER_H
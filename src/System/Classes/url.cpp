@@ -971,7 +971,7 @@ url
 resolve_in_path (url u) {
   if (use_which) {
     string name = escape_sh (as_string (u));
-    string which= var_eval_system ("which " * name * " 2> /dev/null");
+    string which= cached_eval_system ("which " * name * " 2> /dev/null");
     if (ends (which, name))
       return which;
     else if ((which != "") &&
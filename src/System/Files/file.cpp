@@ -13,12 +13,15 @@
 #include "sys_utils.hpp"
 #include "analyze.hpp"
 #include "hashmap.hpp"
+#include "hashset.hpp"
 #include "tm_timer.hpp"
 #include "merge_sort.hpp"
 #include "data_cache.hpp"
+#include "file_watch.hpp"
 #include "web_files.hpp"
 #include "scheme.hpp"
 #include "convert.hpp"
+#include "parallel.hpp"
 
 #include <stddef.h>
 #include <stdio.h>
@@ -189,6 +192,7 @@ save_string (url u, string s, bool fatal) {
       if (file_flag || doc_flag)
         cache_set (cache_type, name, s);
     declare_out_of_date (url_parent (r));
+    watched_forget (name);
     // End caching
   }
 
@@ -242,6 +246,7 @@ append_string (url u, string s, bool fatal) {
     }
     // Cache file contents
     declare_out_of_date (url_parent (r));
+    watched_forget (name);
     // End caching
   }
 
@@ -283,6 +288,15 @@ get_attributes (url name, struct_stat* buf,
       std_warning << "I'm resetting this key" << LF;
       // continue and recache, the current value is inconsistent. 
     }
+  if (cache_flag) {
+    bool err; int mode, mtime, sz;
+    if (watched_stat_get (name_s, err, mode, mtime, sz)) {
+      buf->st_mode = ((unsigned int) mode);
+      buf->st_mtime= ((unsigned int) mtime);
+      buf->st_size = ((unsigned int) sz);
+      return err;
+    }
+  }
   // End caching
 
   //cout << "No cache" << LF;
@@ -310,6 +324,8 @@ get_attributes (url name, struct_stat* buf,
         cache_set ("stat_cache.scm", name_s, tree (TUPLE, s1, s2, s3));
       }
     }
+    watched_stat_set (name_s, flag, (int) buf->st_mode,
+                      (int) buf->st_mtime, (int) buf->st_size);
   }
   // End caching
 
@@ -520,6 +536,8 @@ read_directory (url u, bool& error_flag) {
   // Directory contents in cache?
   if (is_cached ("dir_cache.scm", name) && is_up_to_date (u))
     return cache_dir_get (name);
+  array<string> cached;
+  if (watched_dir_get (name, cached)) return cached;
   bench_start ("read directory");
   // End caching
 
@@ -550,6 +568,7 @@ read_directory (url u, bool& error_flag) {
   bench_cumul ("read directory");
   if (do_cache_dir (name))
     cache_dir_set (name, dir);
+  watched_dir_set (name, dir);
   // End caching
 
   return dir;
@@ -564,6 +583,8 @@ move (url u1, url u2) {
   c_string _u1 (concretize (u1));
   c_string _u2 (concretize (u2));
   (void) rename (_u1, _u2);
+  watched_forget (concretize (u1));
+  watched_forget (concretize (u2));
 }
 
 void
@@ -590,6 +611,7 @@ remove_sub (url u) {
       std_warning << "Remove failed: " << strerror (errno) << LF;
       std_warning << "File was: " << u << LF;
     }
+    watched_forget (concretize (u));
   }
 }
 
@@ -618,6 +640,7 @@ mkdir (url u) {
     if (!is_atomic (u) && !is_root (u)) mkdir (head (u));
     c_string _u (concretize (u));
     (void) ::mkdir (_u, S_IRWXU + S_IRGRP + S_IROTH);
+    watched_forget (concretize (u));
   }
 #else
 #ifdef OS_MINGW
@@ -640,6 +663,7 @@ change_mode (url u, int mode) {
   string m3= as_string (mode & 7);
   system ("chmod -f " * m0 * m1 * m2 * m3, u);
 #endif
+  watched_forget (concretize (u));
 }
 
 /******************************************************************************
@@ -829,26 +853,23 @@ escape_cork_words (string s) {
   return r;
 }
 
-int
-search_score (url u, array<string> a) {
+static array<string>
+search_keywords (array<string> a, string suf) {
   int n= N(a);
-  string in= grep_load (u);
-  if (N(in) == 0) return 0;
-
-  string suf= suffix (u);
-  if (suf == "tmml") {
-    for (int i=0; i<n; i++)
-      a[i]= cork_to_utf8 (a[i]);
-  } else if (suf == "tm") {
-    in= locase_all (in);
-    for (int i=0; i<n; i++)
-      a[i]= locase_all (escape_cork_words (a[i]));
-  } else {
-    in= locase_all (in);
-    for (int i=0; i<n; i++)
-      a[i]= locase_all (a[i]);
-  }
+  array<string> r (n);
+  for (int i=0; i<n; i++)
+    if (suf == "tmml") r[i]= cork_to_utf8 (a[i]);
+    else if (suf == "tm") r[i]= locase_all (escape_cork_words (a[i]));
+    else r[i]= locase_all (a[i]);
+  return r;
+}
 
+static int
+search_score (string in, string suf, array<string> a) {
+  // a contains the keywords as transformed by search_keywords
+  int n= N(a);
+  if (N(in) == 0) return 0;
+  if (suf != "tmml") in= locase_all (in);
   int score= 1;
   for (int i=0; i<n; i++) {
     string what= a[i];
@@ -860,6 +881,130 @@ search_score (url u, array<string> a) {
   return score;
 }
 
+int
+search_score (url u, array<string> a) {
+  string in= grep_load (u);
+  if (N(in) == 0) return 0;
+  string suf= suffix (u);
+  return search_score (in, suf, search_keywords (a, suf));
+}
+
+/******************************************************************************
+* Scoring many files at once
+******************************************************************************/
+
+struct grep_read_job {
+  char* name;   // concrete name of the file
+  char* buf;    // contents of the file, allocated using malloc
+  int   size;   // size of the contents, or -1 if the file could not be read
+};
+
+static void
+grep_read (void* data, int start, int end) {
+  grep_read_job* jobs= (grep_read_job*) data;
+  for (int i=start; i<end; i++) {
+    grep_read_job& job= jobs[i];
+    FILE* fin= fopen (job.name, "rb");
+    if (fin == NULL) continue;
+    if (fseek (fin, 0L, SEEK_END) == 0) {
+      long size= ftell (fin);
+      if (size >= 0 && size < 0x7fffffff) {
+        rewind (fin);
+        job.buf= (char*) malloc (size + 1);
+        if (job.buf != NULL) job.size= (int) fread (job.buf, 1, size, fin);
+      }
+    }
+    fclose (fin);
+  }
+}
+
+static void
+grep_preload (array<url> files) {
+  // concurrently load the local files which are not yet in the cache;
+  // the others are loaded by grep_load, which also reports the errors
+  array<url> todo;
+  array<string> names;
+  hashset<tree> seen;
+  for (int i=0; i<N(files); i++) {
+    url r= files[i];
+    if (grep_load_cache->contains (r->t) || seen->contains (r->t)) continue;
+    seen->insert (r->t);
+    if (!is_rooted_name (r)) r= resolve (r);
+    if (!is_rooted_name (r) || !is_rooted (r, "default")) continue;
+    string name= concretize (r);
+    if (do_cache_file (name) || do_cache_doc (name)) continue;
+    todo  << files[i];
+    names << name;
+  }
+  int n= N(todo);
+  if (n < 2) return;
+  grep_read_job* jobs= tm_new_array<grep_read_job> (n);
+  for (int i=0; i<n; i++) {
+    jobs[i].name= as_charp (names[i]);
+    jobs[i].buf = NULL;
+    jobs[i].size= -1;
+  }
+  parallel_for (grep_read, (void*) jobs, n, 4);
+  for (int i=0; i<n; i++) {
+    if (jobs[i].size >= 0) {
+      string s (jobs[i].size);
+      if (jobs[i].size > 0) memcpy (&(s[0]), jobs[i].buf, jobs[i].size);
+      grep_load_cache (todo[i]->t)= s;
+    }
+    if (jobs[i].buf != NULL) free (jobs[i].buf);
+    tm_delete_array (jobs[i].name);
+  }
+  tm_delete_array (jobs);
+}
+
+struct search_score_job {
+  string        in;     // contents of the file
+  string        suf;    // suffix of the file
+  array<string> a;      // keywords for the suffix
+  int           score;
+};
+
+static void
+search_score_run (void* data, int start, int end) {
+  // each job only accesses data which are not shared with other jobs
+  search_score_job* jobs= (search_score_job*) data;
+  for (int i=start; i<end; i++)
+    jobs[i].score= search_score (jobs[i].in, jobs[i].suf, jobs[i].a);
+}
+
+array<int>
+search_scores (array<url> files, array<string> a) {
+  // scores of several files, which are loaded and scored concurrently
+  grep_preload (files);
+  int n= N(files);
+  hashmap<tree,int> first (-1);
+  hashmap<string,array<string> > keywords;
+  hashset<pointer> contents;
+  search_score_job* jobs= tm_new_array<search_score_job> (n);
+  for (int i=0; i<n; i++) {
+    jobs[i].score= 0;
+    if (first[files[i]->t] >= 0) continue;
+    first (files[i]->t)= i;
+    string suf= suffix (files[i]);
+    if (!keywords->contains (suf))
+      keywords (suf)= search_keywords (a, suf);
+    string in= grep_load (files[i]);
+    if (contents->contains ((pointer) in.operator -> ())) in= copy (in);
+    contents->insert ((pointer) in.operator -> ());
+    jobs[i].in = in;
+    jobs[i].suf= copy (suf);
+    array<string> kw= keywords[suf];
+    for (int k=0; k<N(kw); k++)
+      jobs[i].a << copy (kw[k]);
+  }
+  parallel_for (search_score_run, (void*) jobs, n, 1);
+  array<int> r (n);
+  for (int i=0; i<n; i++)
+    r[i]= jobs[first[files[i]->t]].score;
+  tm_delete_array (jobs);
+  return r;
+}
+
 /******************************************************************************
 * Finding recursive non hidden subdirectories of a given directory
 ******************************************************************************/
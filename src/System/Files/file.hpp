@@ -14,6 +14,7 @@
 #include "url.hpp"
 #include "sys_utils.hpp"
 #include "analyze.hpp"
+#include "mapped_string.hpp"
 
 bool load_string (url file_name, string& s, bool fatal);
 bool save_string (url file_name, string s, bool fatal=false);
@@ -62,6 +63,7 @@ void change_mode (url u, int mode);
 void ps2pdf (url u1, url u2);
 
 int search_score (url u, array<string> a);
+array<int> search_scores (array<url> files, array<string> a);
 
 url search_sub_dirs (url root);
 array<string> file_completions (url search, url dir);
@@ -0,0 +1,192 @@
+
+/******************************************************************************
+* MODULE     : file_watch.cpp
+* DESCRIPTION: file attributes and directory listings kept until they change
+* COPYRIGHT  : (C) 2020  Joris van der Hoeven
+*******************************************************************************
+* This software falls under the GNU general public license version 3 or later.
+* It comes WITHOUT ANY WARRANTY WHATSOEVER. For details, see the file LICENSE
+* in the root directory or <http://www.gnu.org/licenses/gpl-3.0.html>.
+******************************************************************************/
+
+#include "file_watch.hpp"
+#include "hashmap.hpp"
+
+#if defined (__linux__)
+#define USE_INOTIFY
+#include <sys/inotify.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef USE_INOTIFY
+
+/******************************************************************************
+* Watched directories
+******************************************************************************/
+
+#define WATCH_MAX 1024
+#define WATCH_EVENTS (IN_ATTRIB | IN_CREATE | IN_DELETE | IN_MODIFY | \
+                      IN_MOVED_FROM | IN_MOVED_TO | IN_CLOSE_WRITE | \
+                      IN_DELETE_SELF | IN_MOVE_SELF)
+
+static int watch_fd= -2;       // -2 if not yet opened, -1 if unavailable
+static hashmap<int,array<string> > watch_dirs;  // directories of a watch
+static hashmap<string,int> dir_watch (-1);      // watch of a directory
+static hashmap<string,array<string> > watch_names;  // cached names by dir
+static hashmap<string,array<int> > stat_cache;
+static hashmap<string,array<string> > dir_cache;
+
+static string
+parent_dir (string name) {
+  int i= N(name) - 1;
+  while (i > 0 && name[i] != '/') i--;
+  return i <= 0? string (""): name (0, i);
+}
+
+static void
+forget_dir (string dir) {
+  array<string> a= watch_names[dir];
+  for (int i=0; i<N(a); i++) stat_cache->reset (a[i]);
+  watch_names->reset (dir);
+  stat_cache->reset (dir);
+  dir_cache->reset (dir);
+}
+
+static void
+forget_all () {
+  stat_cache= hashmap<string,array<int> > ();
+  dir_cache= hashmap<string,array<string> > ();
+  watch_names= hashmap<string,array<string> > ();
+}
+
+static void
+drain_events () {
+  // process the pending notifications; this is a single non blocking read
+  // when there are none, and the notifications of completed modifications
+  // are always queued, so that cached entries are never outdated
+  char buf[4096] __attribute__ ((aligned (__alignof__ (struct inotify_event))));
+  while (true) {
+    ssize_t n= read (watch_fd, buf, sizeof (buf));
+    if (n <= 0) return;
+    for (char* p= buf; p < buf + n; ) {
+      struct inotify_event* ev= (struct inotify_event*) p;
+      if ((ev->mask & IN_Q_OVERFLOW) != 0) forget_all ();
+      else {
+        array<string> dirs= watch_dirs[ev->wd];
+        for (int i=0; i<N(dirs); i++) forget_dir (dirs[i]);
+        if ((ev->mask & IN_IGNORED) != 0) {
+          for (int i=0; i<N(dirs); i++) dir_watch->reset (dirs[i]);
+          watch_dirs->reset (ev->wd);
+        }
+      }
+      p += sizeof (struct inotify_event) + ev->len;
+    }
+  }
+}
+
+static bool
+watch_ready () {
+  if (watch_fd == -2)
+    watch_fd= inotify_init1 (IN_NONBLOCK | IN_CLOEXEC);
+  if (watch_fd < 0) return false;
+  drain_events ();
+  return true;
+}
+
+static bool
+watch (string dir) {
+  // make sure that dir is being watched
+  if (dir == "") return false;
+  if (dir_watch->contains (dir)) return true;
+  if (N(dir_watch) >= WATCH_MAX) return false;
+  c_string _dir (dir);
+  int wd= inotify_add_watch (watch_fd, _dir, WATCH_EVENTS);
+  if (wd < 0) return false;
+  dir_watch (dir)= wd;
+  if (!watch_dirs->contains (wd)) watch_dirs (wd)= array<string> ();
+  watch_dirs (wd) << dir;
+  return true;
+}
+
+/******************************************************************************
+* Interface
+******************************************************************************/
+
+bool
+watched_stat_get (string name, bool& err, int& mode, int& mtime, int& sz) {
+  if (!watch_ready () || !stat_cache->contains (name)) return false;
+  array<int> a= stat_cache[name];
+  err= (a[0] != 0); mode= a[1]; mtime= a[2]; sz= a[3];
+  return true;
+}
+
+void
+watched_stat_set (string name, bool err, int mode, int mtime, int sz) {
+  if (!watch_ready ()) return;
+  string dir= parent_dir (name);
+  if (!watch (dir)) return;
+  // the attributes of a directory change with its entries, which are
+  // notified to the watch of the directory itself
+  if (!err && S_ISDIR ((mode_t) mode) && !watch (name)) return;
+  array<int> a (4);
+  a[0]= err? 1: 0; a[1]= mode; a[2]= mtime; a[3]= sz;
+  if (!watch_names->contains (dir)) watch_names (dir)= array<string> ();
+  if (!stat_cache->contains (name)) watch_names (dir) << name;
+  stat_cache (name)= a;
+}
+
+bool
+watched_dir_get (string name, array<string>& a) {
+  if (!watch_ready () || !dir_cache->contains (name)) return false;
+  a= dir_cache[name];
+  return true;
+}
+
+void
+watched_dir_set (string name, array<string> a) {
+  if (!watch_ready () || !watch (name)) return;
+  dir_cache (name)= a;
+}
+
+void
+watched_forget (string name) {
+  if (watch_fd < 0) return;
+  forget_dir (name);
+  forget_dir (parent_dir (name));
+}
+
+#else
+
+/******************************************************************************
+* No file system notifications
+******************************************************************************/
+
+bool
+watched_stat_get (string name, bool& err, int& mode, int& mtime, int& sz) {
+  (void) name; (void) err; (void) mode; (void) mtime; (void) sz;
+  return false;
+}
+
+void
+watched_stat_set (string name, bool err, int mode, int mtime, int sz) {
+  (void) name; (void) err; (void) mode; (void) mtime; (void) sz;
+}
+
+bool
+watched_dir_get (string name, array<string>& a) {
+  (void) name; (void) a;
+  return false;
+}
+
+void
+watched_dir_set (string name, array<string> a) {
+  (void) name; (void) a;
+}
+
+void
+watched_forget (string name) {
+  (void) name;
+}
+
+#endif
@@ -0,0 +1,30 @@
+
+/******************************************************************************
+* MODULE     : file_watch.hpp
+* DESCRIPTION: file attributes and directory listings kept until they change
+* COPYRIGHT  : (C) 2020  Joris van der Hoeven
+*******************************************************************************
+* This software falls under the GNU general public license version 3 or later.
+* It comes WITHOUT ANY WARRANTY WHATSOEVER. For details, see the file LICENSE
+* in the root directory or <http://www.gnu.org/licenses/gpl-3.0.html>.
+******************************************************************************/
+
+#ifndef FILE_WATCH_H
+#define FILE_WATCH_H
+#include "string.hpp"
+#include "array.hpp"
+
+/******************************************************************************
+* The results of stat and of directory listings are remembered for the
+* duration of a session, for files whose directory is watched by the system
+* (using inotify on linux).  They are forgotten as soon as the system reports
+* a change in that directory.  On other systems nothing is remembered.
+******************************************************************************/
+
+bool watched_stat_get (string name, bool& err, int& mode, int& mtime, int& sz);
+void watched_stat_set (string name, bool err, int mode, int mtime, int sz);
+bool watched_dir_get (string name, array<string>& a);
+void watched_dir_set (string name, array<string> a);
+void watched_forget (string name);
+
+#endif // defined FILE_WATCH_H
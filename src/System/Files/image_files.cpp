@@ -35,6 +35,13 @@
 #include "hashmap.hpp"
 #include "scheme.hpp"
 #include "Imlib2/imlib2.hpp"
+#include "merge_sort.hpp"
+#include "background.hpp"
+#include "fast_hash.hpp"
+
+#ifndef OS_MINGW
+#include <unistd.h>
+#endif
 
 #ifdef MACOSX_EXTENSIONS
 #include "MacOS/mac_images.h"
@@ -260,6 +267,154 @@ void
 clear_imgbox_cache(tree t){
     img_box->reset (t);
 }
+/******************************************************************************
+* Reading image sizes from file headers
+******************************************************************************/
+
+static inline unsigned int
+header_uint (string buf, int pos, int nr) {
+  // big endian unsigned integer of nr bytes
+  unsigned int r= 0;
+  for (int i=0; i<nr; i++) r= (r << 8) + ((unsigned char) buf[pos+i]);
+  return r;
+}
+
+static bool
+png_header_size (string buf, int& w, int& h) {
+  if (N(buf) < 24 || buf (0, 8) != "\x89PNG\r\n\x1a\n" ||
+      buf (12, 16) != "IHDR") return false;
+  int w_px= (int) header_uint (buf, 16, 4);
+  int h_px= (int) header_uint (buf, 20, 4);
+  double dpmx= 2834.0, dpmy= 2834.0;
+  int pos= 8;
+  while (pos + 8 <= N(buf)) {
+    int len= (int) header_uint (buf, pos, 4);
+    string type= buf (pos+4, pos+8);
+    if (type == "IDAT" || type == "IEND" || len < 0) break;
+    if (type == "pHYs" && len == 9 && pos + 17 <= N(buf) &&
+        buf[pos+16] == ((char) 1)) {
+      dpmx= (double) header_uint (buf, pos+8, 4);
+      dpmy= (double) header_uint (buf, pos+12, 4);
+    }
+    pos += len + 12;
+  }
+  if (w_px <= 0 || h_px <= 0 || dpmx <= 0 || dpmy <= 0) return false;
+  w= (int) round ((w_px * 2834.0) / dpmx);
+  h= (int) round ((h_px * 2834.0) / dpmy);
+  return true;
+}
+
+static bool
+jpeg_header_size (string buf, int& w, int& h) {
+  int n= N(buf);
+  if (n < 4 || ((unsigned char) buf[0]) != 0xff ||
+      ((unsigned char) buf[1]) != 0xd8) return false;
+  double dpix= 72.0, dpiy= 72.0;
+  int pos= 2;
+  while (pos + 4 <= n) {
+    if (((unsigned char) buf[pos]) != 0xff) return false;
+    unsigned int marker= (unsigned char) buf[pos+1];
+    if (marker == 0xff) { pos++; continue; }
+    int len= (int) header_uint (buf, pos+2, 2);
+    if (marker == 0xe0 && len >= 14 && pos + 16 <= n &&
+        buf (pos+4, pos+9) == string ("JFIF\0", 5)) {
+      int unit= (unsigned char) buf[pos+11];
+      double dx= (double) header_uint (buf, pos+12, 2);
+      double dy= (double) header_uint (buf, pos+14, 2);
+      if (unit == 1 && dx > 0 && dy > 0) { dpix= dx; dpiy= dy; }
+      if (unit == 2 && dx > 0 && dy > 0) { dpix= 2.54 * dx; dpiy= 2.54 * dy; }
+    }
+    if (marker >= 0xc0 && marker <= 0xcf &&
+        marker != 0xc4 && marker != 0xc8 && marker != 0xcc) {
+      if (pos + 9 > n) return false;
+      int h_px= (int) header_uint (buf, pos+5, 2);
+      int w_px= (int) header_uint (buf, pos+7, 2);
+      if (w_px <= 0 || h_px <= 0) return false;
+      w= (int) round ((w_px * 72.0) / dpix);
+      h= (int) round ((h_px * 72.0) / dpiy);
+      return true;
+    }
+    if (marker == 0xd9 || marker == 0xda) return false;
+    pos += len + 2;
+  }
+  return false;
+}
+
+static bool
+pdf_read_array (string buf, int pos, array<double>& a) {
+  a= array<double> ();
+  skip_spaces (buf, pos);
+  if (!read (buf, pos, "[")) return false;
+  for (int i=0; i<4; i++) {
+    double x;
+    skip_spaces (buf, pos);
+    if (!read_double (buf, pos, x)) return false;
+    a << x;
+  }
+  skip_spaces (buf, pos);
+  return read (buf, pos, "]");
+}
+
+static bool
+pdf_unique_box (string buf, string key, array<double>& box, bool& found) {
+  // the box with the given key, provided no other value occurs
+  found= false;
+  int pos= search_forwards (key, buf);
+  while (pos >= 0) {
+    array<double> a;
+    if (!pdf_read_array (buf, pos + N(key), a)) return false;
+    if (found && a != box) return false;
+    box= a;
+    found= true;
+    pos= search_forwards (key, pos + N(key), buf);
+  }
+  return true;
+}
+
+static bool
+pdf_header_size (string buf, int& w, int& h) {
+  // only for pdf files whose pages all share an uncompressed media box;
+  // other files are left to the pdf renderer or to ghostscript
+  if (!starts (buf, "%PDF-")) return false;
+  array<double> media, crop;
+  bool has_media, has_crop;
+  if (!pdf_unique_box (buf, "/MediaBox", media, has_media) || !has_media)
+    return false;
+  if (!pdf_unique_box (buf, "/CropBox", crop, has_crop)) return false;
+  array<double> b= has_crop? crop: media;
+  int x1= (int) floor (b[0]), y1= (int) floor (b[1]);
+  int x2= (int) ceil (b[2]), y2= (int) ceil (b[3]);
+  w= x2 - x1;
+  h= y2 - y1;
+  int rot= 0, pos= search_forwards ("/Rotate", buf);
+  if (pos >= 0) {
+    pos += 7;
+    skip_spaces (buf, pos);
+    if (!read_int (buf, pos, rot)) return false;
+    if (search_forwards ("/Rotate", pos, buf) >= 0) return false;
+    rot= rot % 360;
+    if (rot < 0) rot += 360;
+    if ((rot % 180) == 90) { w= y2 - y1; h= x2 - x1; }
+  }
+  return w > 0 && h > 0;
+}
+
+static bool
+header_image_size (url image, string suf, int& w, int& h) {
+  // determine the size in pt of common image formats without external tools
+  if (suf != "png" && suf != "jpg" && suf != "jpeg" && suf != "pdf")
+    return false;
+  string buf;
+  if (load_string (image, buf, false)) return false;
+  bool ok;
+  if (suf == "png") ok= png_header_size (buf, w, h);
+  else if (suf == "pdf") ok= pdf_header_size (buf, w, h);
+  else ok= jpeg_header_size (buf, w, h);
+  if (ok && DEBUG_CONVERT)
+    debug_convert << "image_size from header : " << w << " x " << h << LF;
+  return ok;
+}
+
 /******************************************************************************
 * Getting the original size of an image, using internal plug-ins if possible
 ******************************************************************************/
@@ -297,6 +452,7 @@ void
 image_size_sub (url image, int& w, int& h) { // returns w,h in units of pt (1/72 inch)
   if (DEBUG_CONVERT) debug_convert<< "image_size not cached for :" << image <<LF;
   string suf = suffix (image);	
+  if (header_image_size (image, locase_all (suf), w, h)) return;
   if (suf=="pdf") {
     pdf_image_size (image, w, h);
     return;
@@ -373,8 +529,7 @@ svg_image_size (url image, int& w, int& h) {
   string content;
   bool err= load_string (image, content, false);
   if (!err) {
-    tree t= parse_xml (content);
-    tree result= find_first_element_by_name (t, "svg");
+    tree result= parse_xml_element (content, "svg");
     string width= get_attr_from_element (result, "width", "");
     string height= get_attr_from_element (result, "height", "");
     int try_width= parse_xml_length (width);
@@ -384,14 +539,115 @@ svg_image_size (url image, int& w, int& h) {
   }
 }
  
+/******************************************************************************
+* Persistent cache of converted images
+*******************************************************************************
+* The results of the conversions are stored in
+* $TEXMACS_HOME_PATH/system/cache/images under a name which is made of a
+* digest of the contents of the source image and the conversion parameters.
+* The total size of the cache is bounded by the preference
+* "texmacs->image:cache size" (in megabytes, 0 disables the cache); when it
+* is exceeded, the oldest conversions are removed.
+******************************************************************************/
+
+bool prefer_inkscape (string suffix);
+static hashmap<string,string> image_digests ("");
+
+static string
+image_digest (url image) {
+  // digest of the contents of an image file, remembered for the
+  // session as long as the file is not modified
+  if (!is_regular (image)) return "";
+  string stamp= as_string (last_modified (image, false)) * ":" *
+                as_string (image);
+  if (image_digests->contains (stamp)) return image_digests[stamp];
+  string s;
+  if (load_string (image, s, false)) return "";
+  string r= fast_hash_key (s) * "-" * as_string (N(s));
+  image_digests (stamp)= r;
+  return r;
+}
+
+static int
+image_cache_budget () {
+  // in kilobytes
+  string s= get_preference ("texmacs->image:cache size", "100");
+  return is_int (s)? max (0, min (as_int (s), 1000000)) * 1024: 0;
+}
+
+static url
+image_cache_file (url image, url dest, int w, int h, int dpi) {
+  if (image_cache_budget () == 0) return url_none ();
+  string digest= image_digest (image);
+  if (digest == "") return url_none ();
+  string s= suffix (image);
+  string name= digest * "-" * s * "-" * as_string (w) * "x" * as_string (h);
+  if (dpi > 0) name << "-" << as_string (dpi);
+  if (prefer_inkscape (s)) name << "-inkscape";
+  return get_texmacs_home_path () * url ("system/cache/images") *
+         url (name * "." * suffix (dest));
+}
+
+static bool
+image_cache_load (url cached, url dest) {
+  if (is_none (cached) || !is_regular (cached)) return false;
+  if (DEBUG_CONVERT) debug_convert << " using cache " << cached << LF;
+  copy (cached, dest);
+  return is_regular (dest);
+}
+
+static void
+image_cache_prune (url dir) {
+  bool error_flag;
+  array<string> names= read_directory (dir, error_flag);
+  if (error_flag) return;
+  array<int> stamps, sizes;
+  array<string> files;
+  double total= 0.0;
+  for (int i=0; i<N(names); i++) {
+    if (names[i] == "." || names[i] == "..") continue;
+    url u= dir * url (names[i]);
+    if (!is_regular (u)) continue;
+    files  << names[i];
+    stamps << last_modified (u, false);
+    sizes  << file_size (u);
+    total += (double) sizes[N(sizes)-1];
+  }
+  double budget= 1024.0 * image_cache_budget ();
+  if (total <= budget) return;
+  array<int> where (N(files));
+  for (int i=0; i<N(files); i++) where[i]= i;
+  merge_sort_leq<int,int,less_eq_operator<int> > (stamps, where);
+  // remove the oldest conversions until a quarter of the budget is free
+  for (int i=0; i<N(where) && total > 0.75 * budget; i++) {
+    remove (dir * url (files[where[i]]));
+    total -= (double) sizes[where[i]];
+  }
+}
+
+static void
+image_cache_save (url cached, url converted) {
+  if (is_none (cached) || !is_regular (converted)) return;
+  mkdir (head (cached));
+#ifdef OS_MINGW
+  copy (converted, cached);
+#else
+  // the copy is moved into place, so that concurrent conversions by
+  // other processes never see partially written files
+  url temp= glue (cached, ".tmp" * as_string ((int) getpid ()));
+  copy (converted, temp);
+  move (temp, cached);
+#endif
+  image_cache_prune (head (cached));
+}
+
 /******************************************************************************
 * Converting any image format to the only three we need for
 * displaying and printing : png, eps, pdf
 ******************************************************************************/
 
-void
-image_to_eps (url image, url eps, int w_pt, int h_pt, int dpi) {
-  if (DEBUG_CONVERT) debug_convert << "image_to_eps ...";
+static void
+image_to_eps_sub (url image, url eps, int w_pt, int h_pt, int dpi) {
   /* if ((suffix (eps) != "eps") && (suffix (eps) != "ps")) {
      std_warning << concretize (eps) << " has no .eps or .ps suffix\n";
      }
@@ -426,6 +682,15 @@ image_to_eps (url image, url eps, int w_pt, int h_pt, int dpi) {
   call_imagemagick_convert (image, eps, w_pt, h_pt, dpi);
 }
 
+void
+image_to_eps (url image, url eps, int w_pt, int h_pt, int dpi) {
+  if (DEBUG_CONVERT) debug_convert << "image_to_eps ...";
+  url cached= image_cache_file (image, eps, w_pt, h_pt, dpi);
+  if (image_cache_load (cached, eps)) return;
+  image_to_eps_sub (image, eps, w_pt, h_pt, dpi);
+  image_cache_save (cached, eps);
+}
+
 string
 image_to_psdoc (url image) {
   if (DEBUG_CONVERT) debug_convert << "image_to_psdoc " << image << LF;
@@ -439,9 +704,8 @@ image_to_psdoc (url image) {
 }
 
 //mostly the same code as image_to_eps 
-void 
-image_to_pdf (url image, url pdf, int w_pt, int h_pt, int dpi) {
-  if (DEBUG_CONVERT) debug_convert << "image_to_pdf ... ";
+static void
+image_to_pdf_sub (url image, url pdf, int w_pt, int h_pt, int dpi) {
   string s= suffix (image);
   // First try to preserve "vectorialness"
   if ((s == "svg") && call_scm_converter(image, pdf)) return;
@@ -464,16 +728,64 @@ image_to_pdf (url image, url pdf, int w_pt, int h_pt, int dpi) {
   call_imagemagick_convert(image, pdf, w_pt, h_pt, dpi);
 }
 
+void
+image_to_pdf (url image, url pdf, int w_pt, int h_pt, int dpi) {
+  if (DEBUG_CONVERT) debug_convert << "image_to_pdf ... ";
+  url cached= image_cache_file (image, pdf, w_pt, h_pt, dpi);
+  if (image_cache_load (cached, pdf)) return;
+  image_to_pdf_sub (image, pdf, w_pt, h_pt, dpi);
+  image_cache_save (cached, pdf);
+}
+
+#ifdef USE_GS
+class pdf_converted_command_rep: public command_rep {
+  url cached;
+  url pdf;
+  command done;
+public:
+  pdf_converted_command_rep (url cached2, url pdf2, command done2):
+    cached (cached2), pdf (pdf2), done (done2) {}
+  void apply () {
+    image_cache_save (cached, pdf);
+    if (!is_nil (done)) done ();
+  }
+  tm_ostream& print (tm_ostream& out) { return out << "pdf converted"; }
+};
+#endif
+
+bool
+image_to_pdf_background (url image, url pdf, int w_pt, int h_pt, int dpi,
+                         command done) {
+  // start the conversion on the pool of background_system, when it
+  // is done by an external program; otherwise return false, so that
+  // the caller converts the image using image_to_pdf
+#ifdef USE_GS
+  if (!gs_supports (image)) return false;
+  url cached= image_cache_file (image, pdf, w_pt, h_pt, dpi);
+  if (image_cache_load (cached, pdf)) {
+    if (!is_nil (done)) done ();
+    return true;
+  }
+  if (DEBUG_CONVERT) debug_convert << "image_to_pdf_background " << image << LF;
+  command converted= tm_new<pdf_converted_command_rep> (cached, pdf, done);
+  background_system (gs_to_pdf_command (image, pdf, w_pt, h_pt), converted);
+  return true;
+#else
+  (void) image; (void) pdf; (void) w_pt; (void) h_pt; (void) dpi;
+  (void) done;
+  return false;
+#endif
+}
+
 bool prefer_inkscape (string suffix) {
   return suffix == "svg" &&
     exists_in_path ("inkscape") &&
     get_preference ("image->texmacs:svg-prefer-inkscape", "off") == "on";
 }
 
-void
-image_to_png (url image, url png, int w, int h) {// IN PIXEL UNITS!
+static void
+image_to_png_sub (url image, url png, int w, int h) {
   string source_suffix= suffix (image);
-  if (DEBUG_CONVERT) debug_convert << "image_to_png ... ";
   /* if (suffix (png) != "png") {
      std_warning << concretize (png) << " has no .png suffix\n";
      }
@@ -501,10 +813,19 @@ image_to_png (url image, url png, int w, int h) {// IN PIXEL UNITS!
 #endif
   if (call_scm_converter(image, png)) return;
   call_imagemagick_convert (image, png, w, h);
+}
+
+void
+image_to_png (url image, url png, int w, int h) {// IN PIXEL UNITS!
+  if (DEBUG_CONVERT) debug_convert << "image_to_png ... ";
+  url cached= image_cache_file (image, png, w, h, 0);
+  if (image_cache_load (cached, png)) return;
+  image_to_png_sub (image, png, w, h);
   if (! exists(png)) {
     convert_error << image << " could not be converted to png" <<LF;
     copy("$TEXMACS_PATH/misc/pixmaps/unknown.png",png);
   }
+  else image_cache_save (cached, png);
 }
 
 bool
@@ -12,6 +12,7 @@
 #ifndef IMAGE_FILES_H
 #define IMAGE_FILES_H
 #include "url.hpp"
+#include "command.hpp"
 
 tree          xpm_load (url file_name);
 void          xpm_size (url file_name, int& w, int& h);
@@ -27,6 +28,7 @@ void          pdf_image_size (url image, int& w, int& h);
 void          svg_image_size (url image, int& w, int& h);
 void          image_to_eps (url image, url eps, int w_pt= 0, int h_pt= 0, int dpi= 0);
 void          image_to_pdf (url image, url eps, int w_pt= 0, int h_pt= 0, int dpi= 0);
+bool          image_to_pdf_background (url image, url pdf, int w_pt, int h_pt, int dpi, command done);
 string        image_to_psdoc (url image);
 void          image_to_png (url image, url png, int w= 0, int h= 0);
 bool          call_scm_converter(url image, url dest);
@@ -0,0 +1,138 @@
+/******************************************************************************
+* MODULE     : mapped_string.cpp
+* DESCRIPTION: read-only strings backed by memory mapped files
+* COPYRIGHT  : (C) 2020  Joris van der Hoeven
+*******************************************************************************
+* This software falls under the GNU general public license version 3 or later.
+* It comes WITHOUT ANY WARRANTY WHATSOEVER. For details, see the file LICENSE
+* in the root directory or <http://www.gnu.org/licenses/gpl-3.0.html>.
+******************************************************************************/
+
+#include "mapped_string.hpp"
+#include "analyze.hpp"
+#include "tm_timer.hpp"
+
+#include <stdio.h>
+#include <errno.h>
+#include <string.h>  // strerror, memcpy
+#include <sys/stat.h>
+#include <sys/types.h>
+#ifndef OS_MINGW
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+/******************************************************************************
+* Routines for mapped strings
+******************************************************************************/
+
+mapped_string_rep::~mapped_string_rep () {
+  if (a == NULL) return;
+#ifndef OS_MINGW
+  if (mapped) { munmap ((void*) a, (size_t) n); return; }
+#endif
+  tm_delete_array (a);
+}
+
+string
+mapped_string::operator () (int begin, int end) {
+  if (end <= begin) return string ();
+  begin= max (min (rep->n, begin), 0);
+  end  = max (min (rep->n, end), 0);
+  string r (end - begin);
+  if (end > begin) memcpy (&(r[0]), rep->a + begin, end - begin);
+  return r;
+}
+
+string
+as_string (mapped_string s) {
+  return s (0, N(s));
+}
+
+bool
+starts (mapped_string s, string what) {
+  int i, n= N(what);
+  if (N(s) < n) return false;
+  for (i=0; i<n; i++)
+    if (s[i] != what[i]) return false;
+  return true;
+}
+
+void
+skip_spaces (mapped_string s, int& i) {
+  int n= N(s);
+  while ((i<n) && ((s[i]==' ') || (s[i]=='\t'))) i++;
+}
+
+/******************************************************************************
+* Loading
+******************************************************************************/
+
+static bool
+read_contents (FILE* fin, char*& a, int& n, int size) {
+  // fall back on an ordinary read when mapping is impossible
+  a= tm_new_array<char> (max (size, 1));
+  int read= fread (a, 1, size, fin);
+  n= max (read, 0);
+  return read < size;
+}
+
+bool
+load_mapped (url u, mapped_string& s, bool fatal) {
+  // load a file into a mapped string; unlike load_string,
+  // the file cache is ignored, since mapping is meant for large files
+  url r= u;
+  if (!is_rooted_name (r)) r= resolve (r);
+  bool err= !is_rooted_name (r);
+  s= mapped_string ();
+  if (!err) {
+    bench_start ("load file");
+    string name= concretize (r);
+    c_string _name (name);
+#ifdef OS_MINGW
+    FILE* fin= fopen (_name, "rb");
+    if (fin == NULL) err= true;
+    else {
+      struct stat st;
+      if (fstat (fileno (fin), &st) != 0) err= true;
+      else err= read_contents (fin, s->a, s->n, (int) st.st_size);
+      fclose (fin);
+    }
+#else
+    int fd= open (_name, O_RDONLY);
+    if (fd < 0) err= true;
+    else {
+      struct stat st;
+      if (fstat (fd, &st) != 0) err= true;
+      else if (st.st_size > 0) {
+        void* p= mmap (NULL, (size_t) st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (p != MAP_FAILED) {
+          s->a= (char*) p;
+          s->n= (int) st.st_size;
+          s->mapped= true;
+        }
+        else {
+          FILE* fin= fdopen (fd, "r");
+          if (fin == NULL) err= true;
+          else {
+            err= read_contents (fin, s->a, s->n, (int) st.st_size);
+            fclose (fin);
+            fd= -1;
+          }
+        }
+      }
+      if (fd >= 0) close (fd);
+    }
+#endif
+    if (err && !occurs ("system", name))
+      std_warning << "Load error for " << name << ", "
+                  << strerror (errno) << "\n";
+    bench_cumul ("load file");
+  }
+  if (err && fatal) {
+    failed_error << "File name= " << as_string (u) << "\n";
+    FAILED ("file not readable");
+  }
+  return err;
+}
@@ -0,0 +1,54 @@
+/******************************************************************************
+* MODULE     : mapped_string.hpp
+* DESCRIPTION: read-only strings backed by memory mapped files
+* COPYRIGHT  : (C) 2020  Joris van der Hoeven
+*******************************************************************************
+* This software falls under the GNU general public license version 3 or later.
+* It comes WITHOUT ANY WARRANTY WHATSOEVER. For details, see the file LICENSE
+* in the root directory or <http://www.gnu.org/licenses/gpl-3.0.html>.
+******************************************************************************/
+
+#ifndef MAPPED_STRING_H
+#define MAPPED_STRING_H
+#include "url.hpp"
+
+/******************************************************************************
+* A mapped_string gives read-only access to the contents of a file without
+* copying them into memory. Indexing works as for strings; substrings are
+* ordinary strings and hence copies. The file should not be truncated by
+* another process while the mapped_string is alive, so mapped strings are
+* meant to be used during the parsing of a file only.
+******************************************************************************/
+
+class mapped_string;
+class mapped_string_rep: concrete_struct {
+  int   n;       // length of the string
+  char* a;       // the contents
+  bool  mapped;  // a was obtained using mmap (otherwise using tm_new_array)
+
+public:
+  inline mapped_string_rep (): n (0), a (NULL), mapped (false) {}
+  ~mapped_string_rep ();
+
+  friend class mapped_string;
+  friend int  N (mapped_string s);
+  friend bool load_mapped (url u, mapped_string& s, bool fatal);
+};
+
+class mapped_string {
+  CONCRETE(mapped_string);
+  inline mapped_string (): rep (tm_new<mapped_string_rep> ()) {}
+  inline char operator [] (int i) { return rep->a[i]; }
+  inline const char* data () { return rep->a; }
+  string operator () (int start, int end);
+};
+CONCRETE_CODE(mapped_string);
+
+inline int N (mapped_string s) { return s->n; }
+string as_string (mapped_string s);
+bool   starts (mapped_string s, string what);
+void   skip_spaces (mapped_string s, int& i);
+
+bool   load_mapped (url u, mapped_string& s, bool fatal= false);
+
+#endif // defined MAPPED_STRING_H
@@ -11,6 +11,11 @@
 
 #include "tm_ostream.hpp"
 #include "tree.hpp"
+#include <string.h>
+#ifndef OS_MINGW
+#include <errno.h>
+#include <sys/uio.h>
+#endif
 #ifdef OS_MINGW
 #include "Windows/win-utf8-compat.hpp"
 #include "Windows/nowide/iostream.hpp"
@@ -121,6 +126,110 @@ std_ostream_rep::flush () {
   if (file && is_w) fflush (file);
 }
 
+/******************************************************************************
+* File streams with a large write buffer
+******************************************************************************/
+
+class file_ostream_rep: public tm_ostream_rep {
+  FILE *file;
+  bool is_w;
+  bool is_mine;
+  char* buf;
+  int   size;
+  int   pos;
+  bool  line_flush;  // flush at the end of each line
+
+  void write (const char* s, int n);
+
+public:
+  file_ostream_rep (FILE* f, bool mine, int size, bool line_flush);
+  ~file_ostream_rep ();
+
+  bool is_writable () const;
+  void write (const char*);
+  void flush ();
+};
+
+file_ostream_rep::file_ostream_rep (FILE* f, bool mine, int size2, bool lf):
+  file (f), is_w (f != NULL), is_mine (mine && f != NULL),
+  buf (NULL), size (size2 < 1? 1: size2), pos (0), line_flush (lf)
+{
+  buf= tm_new_array<char> (size);
+}
+
+file_ostream_rep::~file_ostream_rep () {
+  flush ();
+  tm_delete_array (buf);
+  if (file && is_mine) fclose (file);
+}
+
+bool
+file_ostream_rep::is_writable () const {
+  return is_w;
+}
+
+void
+file_ostream_rep::write (const char* s, int n) {
+  // write the buffer followed by s, using a single system call if possible
+  if (!file || !is_w) { pos= 0; return; }
+#ifdef OS_MINGW
+  if (pos > 0 && fwrite (buf, 1, pos, file) != (size_t) pos) is_w= false;
+  if (n > 0 && fwrite (s, 1, n, file) != (size_t) n) is_w= false;
+  if (is_w) fflush (file);
+#else
+  fflush (file);
+  int fd= fileno (file);
+  struct iovec v[2];
+  v[0].iov_base= buf;
+  v[0].iov_len = pos;
+  v[1].iov_base= (void*) s;
+  v[1].iov_len = n;
+  int k= (pos > 0? 0: 1);
+  while (k < 2 && is_w) {
+    ssize_t r= writev (fd, v + k, 2 - k);
+    if (r < 0) {
+      if (errno != EINTR) is_w= false;
+      continue;
+    }
+    while (k < 2 && r >= (ssize_t) v[k].iov_len) r -= v[k++].iov_len;
+    if (k < 2) {
+      v[k].iov_base= ((char*) v[k].iov_base) + r;
+      v[k].iov_len -= r;
+    }
+  }
+#endif
+  pos= 0;
+}
+
+void
+file_ostream_rep::write (const char* s) {
+  int n= strlen (s);
+  if (pos + n <= size) {
+    memcpy (buf + pos, s, n);
+    pos += n;
+    if (line_flush && memchr (s, '\n', n) != NULL) write ("", 0);
+  }
+  else write (s, n);
+}
+
+void
+file_ostream_rep::flush () {
+  if (pos > 0) write ("", 0);
+}
+
+tm_ostream
+file_ostream (FILE* f, int buffer_size, bool line_flush) {
+  return (tm_ostream_rep*)
+    tm_new<file_ostream_rep> (f, false, buffer_size, line_flush);
+}
+
+tm_ostream
+file_ostream (char* fn, int buffer_size, bool line_flush) {
+  FILE* f= fopen (fn, "w");
+  return (tm_ostream_rep*)
+    tm_new<file_ostream_rep> (f, true, buffer_size, line_flush);
+}
+
 /******************************************************************************
 * Buffered streams
 ******************************************************************************/
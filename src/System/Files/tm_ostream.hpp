@@ -79,6 +79,14 @@ public:
   tm_ostream& operator << (formatted);
 };
 
+// explicitly buffered file sinks which have to be flushed by the caller;
+// they are flushed when full and when the last reference disappears,
+// and also at the end of each line if line_flush is set
+tm_ostream file_ostream (FILE* f, int buffer_size= 65536,
+                         bool line_flush= false);
+tm_ostream file_ostream (char* file_name, int buffer_size= 65536,
+                         bool line_flush= false);
+
 extern tm_ostream& cout;
 extern tm_ostream& cerr;
 
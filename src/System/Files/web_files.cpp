@@ -15,6 +15,9 @@
 #include "analyze.hpp"
 #include "hashmap.hpp"
 #include "scheme.hpp"
+#include "background.hpp"
+#include "persistent.hpp"
+#include <time.h>
 
 #define MAX_CACHED 25
 static int web_nr=0;
@@ -87,40 +90,148 @@ fetch_tool () {
   return tool;
 }
 
-url
-get_from_web (url name) {
-  if (!is_rooted_web (name)) return url_none ();
-  url res= get_cache (name);
-  if (!is_none (res)) return res;
+/******************************************************************************
+* Copies of web files on disk
+*******************************************************************************
+* Downloaded files are kept in the persistent directory system/cache/web,
+* indexed by their url, so that they survive the session.  When such a copy
+* exists, it is only downloaded again if the server reports that the file was
+* modified since; the copy is also used when the server cannot be reached.
+******************************************************************************/
+
+static url
+web_disk_dir () {
+  return get_texmacs_home_path () * url ("system/cache/web");
+}
+
+static url
+web_disk_get (url name) {
+  url dir= web_disk_dir ();
+  string key= as_string (name);
+  if (!persistent_contains (dir, key)) return url_none ();
+  url u= url_system (persistent_get (dir, key));
+  if (!is_regular (u)) return url_none ();
+  return u;
+}
+
+static url
+web_disk_set (url name, url tmp) {
+  url dir= web_disk_dir ();
+  url u= web_disk_get (name);
+  if (is_none (u)) {
+    string suf= suffix (name);
+    u= persistent_file_name (dir, suf == ""? suf: "." * suf);
+    persistent_set (dir, as_string (name), as_string (u));
+  }
+  move (tmp, u);
+  return u;
+}
+
+static string
+http_date (int t) {
+  time_t tt= (time_t) t;
+  char buf[64];
+  strftime (buf, sizeof (buf), "%a, %d %b %Y %H:%M:%S GMT", gmtime (&tt));
+  return string (buf);
+}
+
+/******************************************************************************
+* Fetching web files
+******************************************************************************/
 
+static string
+fetch_command (url name, url tmp, url local) {
   string tool= fetch_tool ();
-  if (tool == "") return url_none ();
-  
-  url tmp= url_temp ();
   string tmp_s= escape_sh (concretize (tmp));
   string cmd= "";
+  string since= "";
+  if (!is_none (local))
+    since= "If-Modified-Since: " * http_date (last_modified (local, false));
   
   if (tool == "wget") {
     cmd= "wget --header='User-Agent: TeXmacs-" TEXMACS_VERSION "' -q";
+    if (since != "") cmd << " --header=" << escape_sh (since);
     cmd << " --no-check-certificate --tries=1";
     cmd << " -O " << tmp_s << " " << escape_sh (web_encode (as_string (name)));
   }
   
   if (tool == "curl") {
     cmd= "curl --user-agent TeXmacs-" TEXMACS_VERSION;
+    if (since != "") cmd << " -H " << escape_sh (since);
     cmd << " " << escape_sh (web_encode (as_string (name)));
     cmd << " --output " << tmp_s;
   }
+  return cmd;
+}
+
+static url
+fetch_result (url name, url tmp, url local) {
+  // an empty answer means that the local copy is still valid or unreachable
+  if (file_size (tmp) > 0) return set_cache (name, web_disk_set (name, tmp));
+  remove (tmp);
+  if (is_none (local)) return url_none ();
+  return set_cache (name, local);
+}
+
+static hashmap<tree,tree> web_pending ("");
+static hashmap<tree,array<command> > web_waiting;
 
+url
+get_from_web (url name) {
+  if (!is_rooted_web (name)) return url_none ();
+  if (web_pending->contains (name->t)) background_wait ();
+  url res= get_cache (name);
+  if (!is_none (res)) return res;
+
+  url local= web_disk_get (name);
+  if (fetch_tool () == "")
+    return is_none (local)? local: set_cache (name, local);
+  url tmp= url_temp ();
+  string cmd= fetch_command (name, tmp, local);
   //cout << cmd << LF;
   system (cmd);
   //cout << "got " << name << " as " << tmp << LF;
+  return fetch_result (name, tmp, local);
+}
 
-  if (var_eval_system ("cat " * tmp_s * " 2> /dev/null") == "") {
-    remove (tmp);
-    return url_none ();
+/******************************************************************************
+* Downloading web files in the background
+******************************************************************************/
+
+class web_fetched_command_rep: public command_rep {
+  url name;
+  url tmp;
+  url local;
+public:
+  web_fetched_command_rep (url name2, url tmp2, url local2):
+    name (name2), tmp (tmp2), local (local2) {}
+  void apply () {
+    array<command> a= web_waiting [name->t];
+    web_pending->reset (name->t);
+    web_waiting->reset (name->t);
+    (void) fetch_result (name, tmp, local);
+    for (int i=0; i<N(a); i++)
+      if (!is_nil (a[i])) a[i] ();
+  }
+  tm_ostream& print (tm_ostream& out) { return out << "web fetched"; }
+};
+
+void
+web_prefetch (url name, command done) {
+  if (web_pending->contains (name->t)) {
+    web_waiting (name->t) << done;
+    return;
+  }
+  if (is_rooted_web (name) && is_none (get_cache (name)) &&
+      fetch_tool () != "") {
+    url tmp= url_temp (), local= web_disk_get (name);
+    web_pending (name->t)= tmp->t;
+    web_waiting (name->t)= array<command> ();
+    web_waiting (name->t) << done;
+    command fetched= tm_new<web_fetched_command_rep> (name, tmp, local);
+    background_system (fetch_command (name, tmp, local), fetched);
   }
-  else return set_cache (name, tmp);
+  else if (!is_nil (done)) done ();
 }
 
 /******************************************************************************
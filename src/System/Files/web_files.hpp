@@ -12,10 +12,12 @@
 #ifndef WEB_FILES_H
 #define WEB_FILES_H
 #include "url.hpp"
+#include "command.hpp"
 
 void web_cache_invalidate (url u);
 
 url get_from_web (url u);
+void web_prefetch (url u, command done);
 url get_from_server (url u);
 url get_from_ramdisc (url u);
 
@@ -16,6 +16,7 @@
 #include "universal.hpp"
 #include "drd_std.hpp"
 #include "scheme.hpp"
+#include "data_cache.hpp"
 
 RESOURCE_CODE(dictionary);
 
@@ -24,7 +25,8 @@ RESOURCE_CODE(dictionary);
 ******************************************************************************/
 
 dictionary_rep::dictionary_rep (string from2, string to2):
-  rep<dictionary> (from2 * "-" * to2), table ("?"), from (from2), to (to2) {}
+  rep<dictionary> (from2 * "-" * to2), table ("?"),
+  done (""), done_as_is (""), from (from2), to (to2) {}
 
 void
 dictionary_rep::load (url u) {
@@ -35,25 +37,40 @@ dictionary_rep::load (url u) {
     return;
   }
 
-  string s;
-  if (load_string (u, s, false)) return;
-  tree t= block_to_scheme_tree (s);
-  if (!is_tuple (t)) return;
+  // the unquoted and converted entries are kept in the binary tree cache,
+  // so that the parsing only happens when the dictionary file changes
+  tree c;
+  if (!cache_tree_load (u, c)) {
+    string s;
+    if (load_string (u, s, false)) return;
+    tree t= block_to_scheme_tree (s);
+    if (!is_tuple (t)) return;
+
+    c= tree (TUPLE);
+    int i, n= N(t);
+    for (i=0; i<n; i++)
+      if (is_func (t[i], TUPLE, 2) &&
+          is_atomic (t[i][0]) && is_atomic (t[i][1]))
+      {
+        string l= t[i][0]->label; if (is_quoted (l)) l= scm_unquote (l);
+        string r= t[i][1]->label; if (is_quoted (r)) r= scm_unquote (r);
+        if (to == "chinese" ||  to == "japanese"  ||
+            to == "korean"  ||  to == "taiwanese" ||
+            to == "russian" ||  to == "ukrainian" || to == "bulgarian" ||
+            to == "german" || to == "greek")
+          r= utf8_to_cork (r);
+        c << tree (TUPLE, l, r);
+      }
+    cache_tree_save (u, c);
+  }
 
-  int i, n= N(t);
+  int i, n= N(c);
   for (i=0; i<n; i++)
-    if (is_func (t[i], TUPLE, 2) &&
-        is_atomic (t[i][0]) && is_atomic (t[i][1]))
-    {
-      string l= t[i][0]->label; if (is_quoted (l)) l= scm_unquote (l);
-      string r= t[i][1]->label; if (is_quoted (r)) r= scm_unquote (r);
-      if (to == "chinese" ||  to == "japanese"  ||
-          to == "korean"  ||  to == "taiwanese" ||
-          to == "russian" ||  to == "ukrainian" || to == "bulgarian" ||
-          to == "german" || to == "greek")
-        r= utf8_to_cork (r);
-      table (l)= r;
-    }
+    if (is_func (c[i], TUPLE, 2) &&
+        is_atomic (c[i][0]) && is_atomic (c[i][1]))
+      table (c[i][0]->label)= c[i][1]->label;
+  done= hashmap<string,string> ("");
+  done_as_is= hashmap<string,string> ("");
 }
 
 void
@@ -78,8 +95,22 @@ load_dictionary (string from, string to) {
 * Translation routines
 ******************************************************************************/
 
+#define MAX_MEMOIZED 50000
+
 string
 dictionary_rep::translate (string s, bool guess) {
+  // menus are rebuilt often, so translations are memoized; the table
+  // is only flushed when it grows large because of document strings
+  hashmap<string,string>& h= (guess? done: done_as_is);
+  if (h->contains (s)) return h[s];
+  if (N(h) >= MAX_MEMOIZED) h= hashmap<string,string> ("");
+  string r= translate_sub (s, guess);
+  h(s)= r;
+  return r;
+}
+
+string
+dictionary_rep::translate_sub (string s, bool guess) {
   if (s == "") return s;
   if (from == to) {
     int pos= search_forwards ("::", s);
@@ -154,10 +185,21 @@ string get_input_language () { return in_lan; }
 void set_output_language (string s) { out_lan= s; }
 string get_output_language () { return out_lan; }
 
+static dictionary last_dict;
+
+static dictionary
+get_dictionary (string from, string to) {
+  // avoid the construction and lookup of the dictionary name
+  // for the common case of repeated translations between the same languages
+  if (is_nil (last_dict) || last_dict->from != from || last_dict->to != to)
+    last_dict= load_dictionary (from, to);
+  return last_dict;
+}
+
 string
 translate (string s, string from, string to) {
   if (N(from)==0) return s;
-  dictionary dict= load_dictionary (from, to);
+  dictionary dict= get_dictionary (from, to);
   return dict->translate (s);
 }
 
@@ -176,13 +218,14 @@ force_load_dictionary (string from, string to) {
   string name= from * "-" * to;
   if (dictionary::instances -> contains (name))
     dictionary::instances -> reset (name);
+  last_dict= dictionary ();
   load_dictionary (from, to);
   notify_preference ("language");
 }
 
 string
 translate_as_is (string s, string from, string to) {
-  dictionary dict= load_dictionary (from, to);
+  dictionary dict= get_dictionary (from, to);
   return dict->translate (s, false);
 }
 
@@ -22,6 +22,8 @@ RESOURCE(dictionary);
 
 struct dictionary_rep: rep<dictionary> {
   hashmap<string,string> table;
+  hashmap<string,string> done;        // memoized translations
+  hashmap<string,string> done_as_is;  // idem, without guessing
   string from, to;
 
 public:
@@ -30,6 +32,7 @@ public:
   void   load (url fname);
   void   load (string fname);
   string translate (string s, bool guess=true);
+  string translate_sub (string s, bool guess);
 };
 
 dictionary load_dictionary (string from, string to);
@@ -13,13 +13,16 @@
 #include "hyphenate.hpp"
 #include "analyze.hpp"
 #include "converter.hpp"
+#include "iterator.hpp"
+#include "merge_sort.hpp"
+#include "sys_utils.hpp"
 
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
-#define MAX_SEARCH 10
 #define MAX_BUFFER_SIZE 256
+#define MAX_HYPHENATED 20000
 
 /*
 static bool
@@ -96,13 +99,6 @@ load_hyphen_tables (string file_name,
   }
 }
 
-array<int>
-get_hyphens (string s,
-             hashmap<string,string> patterns,
-             hashmap<string,string> hyphenations) {
-  return get_hyphens (s, patterns, hyphenations, false);
-}
-
 void
 goto_next_char (string s, int &i, bool utf8) {
   if (utf8) decode_from_utf8 (s, i);
@@ -129,12 +125,72 @@ str_length (string s, bool utf8) {
   else return N(s);
 }
 
-array<int>
-get_hyphens (string s,
-             hashmap<string,string> patterns,
-             hashmap<string,string> hyphenations, bool utf8) {
-  ASSERT (N(s) != 0, "hyphenation of empty string");
+/******************************************************************************
+* Compiled hyphenation tables
+******************************************************************************/
+
+static int
+build_trie (hyphen_table_rep* t, array<string> keys, array<string> vals,
+            int lo, int hi, int depth) {
+  // create the node for the keys in [lo, hi), which share depth bytes
+  int node= N(t->weights);
+  t->weights << 0;
+  t->first << N(t->target);
+  int i= lo;
+  if (i < hi && N(keys[i]) == depth) {
+    string v= vals[i++];
+    array<int> w;
+    int cur= 0;
+    for (int j=0; j<N(v); )
+      if (is_digit (v[j])) cur= ((int) v[j++]) - ((int) '0');
+      else {
+        w << cur;
+        cur= 0;
+        if (t->utf8) decode_from_utf8 (v, j);
+        else j++;
+      }
+    w << cur;
+    t->weights[node]= N(t->digits) + 1;
+    t->digits << ((char) N(w));
+    for (int j=0; j<N(w); j++) t->digits << ((char) w[j]);
+  }
+  array<int> ranges;
+  for (int j=i; j<hi; ) {
+    int k= j;
+    while (k < hi && keys[k][depth] == keys[j][depth]) k++;
+    t->labels << keys[j][depth];
+    t->target << -1;
+    ranges << j;
+    j= k;
+  }
+  ranges << hi;
+  int e= t->first[node];
+  for (int j=0; j+1<N(ranges); j++) {
+    int child= build_trie (t, keys, vals, ranges[j], ranges[j+1], depth+1);
+    t->target[e+j]= child;
+  }
+  return node;
+}
+
+void
+hyphen_table_rep::compile (hashmap<string,string> patterns) {
+  array<string> keys;
+  for (iterator<string> it= iterate (patterns); it->busy (); )
+    keys << it->next ();
+  merge_sort (keys);
+  array<string> vals (N(keys));
+  for (int i=0; i<N(keys); i++) vals[i]= patterns[keys[i]];
+  first = array<int> ();
+  labels= string ();
+  target= array<int> ();
+  weights= array<int> ();
+  digits= string ();
+  build_trie (this, keys, vals, 0, N(keys), 0);
+  first << N(target);
+}
 
+array<int>
+hyphen_table_rep::hyphens (string s) {
   if (utf8) s= cork_to_utf8 (s);
 
   if (hyphenations->contains (s)) {
@@ -158,27 +214,32 @@ get_hyphens (string s,
   else {
     s= "." * locase_all (s) * ".";
     // cout << s << "\n";
-    int i, j, k, l, m, len;
-    array<int> T (str_length (s, utf8)+1);
-    for (i=0; i<N(T); i++) T[i]=0;
-    for (len=1; len < MAX_SEARCH; len++)
-      for (i=0, l=0; i<N(s) - len; goto_next_char (s, i, utf8), l++) {
-        string r= patterns [s (i, i+len)];
-        if (!(r == "?")) {
-          // cout << "  " << s (i, i+len) << " => " << r << "\n";
-          for (j=0, k=0; j<=len; j++, k++) {
-            if (k<N(r) && is_digit (r[k])) {
-              m= ((int) r[k])-((int) '0');
-              k++;
-            }
-            else m=0;
-            if (m>T[l+j]) T[l+j]=m;
+    array<int> start;
+    for (int i=0; i<N(s); ) {
+      start << i;
+      if (utf8) decode_from_utf8 (s, i);
+      else i++;
+    }
+    array<int> T (N(start)+1);
+    for (int i=0; i<N(T); i++) T[i]=0;
+    if (N(first) > 1)
+      for (int l=0; l<N(start); l++) {
+        int node= 0;
+        for (int i=start[l]; i<N(s); i++) {
+          int e= first[node], end= first[node+1];
+          while (e < end && labels[e] != s[i]) e++;
+          if (e == end) break;
+          node= target[e];
+          if (weights[node] != 0) {
+            int k= weights[node], n= (int) digits[k-1];
+            for (int j=0; j<n; j++)
+              if (((int) digits[k+j]) > T[l+j]) T[l+j]= (int) digits[k+j];
           }
         }
       }
 
     array<int> penalty (N(T)-4);
-    for (i=2; i < N(T)-4; i++)
+    for (int i=2; i < N(T)-4; i++)
       penalty [i-2]= (((T[i]&1)==1)? HYPH_STD: HYPH_INVALID);
     if (N(penalty)>0) penalty[0] = penalty[N(penalty)-1] = HYPH_INVALID;
     if (N(penalty)>1) penalty[1] = penalty[N(penalty)-2] = HYPH_INVALID;
@@ -188,6 +249,102 @@ get_hyphens (string s,
   }
 }
 
+/******************************************************************************
+* Binary cache of compiled tables
+******************************************************************************/
+
+static void
+marshall_array (string& s, array<int> a) {
+  marshall_number (s, N(a));
+  for (int i=0; i<N(a); i++) marshall_number (s, (unsigned long int) a[i]);
+}
+
+static array<int>
+unmarshall_array (string s, int& pos) {
+  int n= (int) unmarshall_number (s, pos);
+  array<int> a (n);
+  for (int i=0; i<n; i++) a[i]= (int) unmarshall_number (s, pos);
+  return a;
+}
+
+bool
+hyphen_table_rep::load (url src, url cache) {
+  string s;
+  if (load_string (cache, s, false)) return false;
+  int pos= 0;
+  if (unmarshall_string (s, pos) != as_string (src)) return false;
+  if (((int) unmarshall_number (s, pos)) != last_modified (src, false))
+    return false;
+  if (((bool) unmarshall_number (s, pos)) != utf8) return false;
+  first  = unmarshall_array (s, pos);
+  labels = unmarshall_string (s, pos);
+  target = unmarshall_array (s, pos);
+  weights= unmarshall_array (s, pos);
+  digits = unmarshall_string (s, pos);
+  int n= (int) unmarshall_number (s, pos);
+  for (int i=0; i<n && pos<N(s); i++) {
+    string key= unmarshall_string (s, pos);
+    hyphenations (key)= unmarshall_string (s, pos);
+  }
+  return pos == N(s) && N(first) == N(weights) + 1 &&
+         N(labels) == N(target);
+}
+
+void
+hyphen_table_rep::save (url src, url cache) {
+  string s;
+  marshall_string (s, as_string (src));
+  marshall_number (s, (unsigned long int) last_modified (src, false));
+  marshall_number (s, utf8? 1: 0);
+  marshall_array (s, first);
+  marshall_string (s, labels);
+  marshall_array (s, target);
+  marshall_array (s, weights);
+  marshall_string (s, digits);
+  marshall_number (s, N(hyphenations));
+  for (iterator<string> it= iterate (hyphenations); it->busy (); ) {
+    string key= it->next ();
+    marshall_string (s, key);
+    marshall_string (s, hyphenations[key]);
+  }
+  (void) save_string (cache, s);
+}
+
+static url
+hyphen_cache_file (string name, bool to_cork) {
+  // no cache if the home directory of TeXmacs is not known, e.g. in tests
+  if (get_env ("TEXMACS_HOME_PATH") == "") return url_none ();
+  url dir ("$TEXMACS_HOME_PATH/system/cache/hyphen");
+  if (!exists (dir)) mkdir (dir);
+  return dir * (name * (to_cork? string (".tmb"): string ("-utf8.tmb")));
+}
+
+hyphen_table_rep::hyphen_table_rep (string name, bool to_cork):
+  utf8 (!to_cork), hyphenations ("?"), done (array<int> ())
+{
+  url src ("$TEXMACS_PATH/langs/natural/hyphen", "hyphen." * name);
+  url cache= hyphen_cache_file (name, to_cork);
+  if (!is_none (cache) && load (src, cache)) return;
+  hyphenations= hashmap<string,string> ("?");
+  hashmap<string,string> patterns ("?");
+  load_hyphen_tables (name, patterns, hyphenations, to_cork);
+  compile (patterns);
+  if (!is_none (cache)) save (src, cache);
+}
+
+hyphen_table::hyphen_table (string name, bool to_cork):
+  rep (tm_new<hyphen_table_rep> (name, to_cork)) {}
+
+array<int>
+get_hyphens (string s, hyphen_table t) {
+  ASSERT (N(s) != 0, "hyphenation of empty string");
+  if (t->done->contains (s)) return t->done[s];
+  array<int> penalty= t->hyphens (s);
+  if (N(t->done) >= MAX_HYPHENATED) t->done= hashmap<string,array<int> > ();
+  t->done (s)= penalty;
+  return penalty;
+}
+
 void
 std_hyphenate (string s, int after, string& left, string& right, int penalty) {
   std_hyphenate (s, after, left, right, penalty, false);
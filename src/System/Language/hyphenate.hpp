@@ -12,16 +12,47 @@
 #ifndef HYPHENATE_H
 #define HYPHENATE_H
 #include "language.hpp"
+#include "url.hpp"
+
+/******************************************************************************
+* Hyphenation patterns are compiled into a packed trie, like in TeX.
+* The children of a node are stored in a contiguous block of edges, so that
+* all patterns which start at a given position of a word are found in a
+* single walk down the trie.  Compiled tables are cached in binary form
+* and the hyphenations of words are remembered.
+******************************************************************************/
+
+class hyphen_table;
+class hyphen_table_rep: concrete_struct {
+public:
+  bool utf8;                            // patterns in utf8 instead of cork
+  array<int> first;                     // first edge of each node
+  string labels;                        // the byte on each edge
+  array<int> target;                    // the node at the end of each edge
+  array<int> weights;                   // start of the weights of a pattern
+  string digits;                        // number of weights, followed by them
+  hashmap<string,string> hyphenations;  // exceptions
+  hashmap<string,array<int> > done;     // hyphenated words
+
+  hyphen_table_rep (string name, bool to_cork);
+  void compile (hashmap<string,string> patterns);
+  bool load (url src, url cache);
+  void save (url src, url cache);
+  array<int> hyphens (string s);
+
+  friend class hyphen_table;
+};
+
+class hyphen_table {
+  CONCRETE(hyphen_table);
+  hyphen_table (string name, bool to_cork);
+};
+CONCRETE_CODE(hyphen_table);
 
 void load_hyphen_tables (string language_name,
                          hashmap<string,string>& patterns,
                          hashmap<string,string>& hyphenations, bool toCork);
-array<int> get_hyphens (string s,
-                        hashmap<string,string> patterns,
-                        hashmap<string,string> hyphenations);
-array<int> get_hyphens (string s,
-                        hashmap<string,string> patterns,
-                        hashmap<string,string> hyphenations, bool utf8);
+array<int> get_hyphens (string s, hyphen_table t);
 void std_hyphenate (string s, int after, string& left, string& right, int pen);
 void std_hyphenate (string s, int after, string& left, string& right, int pen,
                     bool utf8);
@@ -54,121 +54,82 @@ line_inc (tree t, int i) {
   return pt[p->item + i];
 }
 
-static void
-parse_comment_multi_lines (string s, int& pos) {
-  if (pos+1 < N(s) && s[pos] == '/' && s[pos+1] == '*')
-    pos += 2;
-}
-
-static bool
-parse_string (string s, int& pos, bool force) {
-  int n= N(s);
-  static string delim;
-  if (pos >= n) return false;
-  if (s[pos] == '\"' || s[pos] == '\'') {
-    delim= s(pos, pos+1);
-    pos+= N(delim);
-  }
-  else if (!force)
-    return false;
-  while (pos<n && !test (s, pos, delim)) {
-    if (s[pos] == '\\') {
-      return true;
-    }
-    else
-      pos++;
-  }
-  if (test (s, pos, delim))
-    pos+= N(delim);
-  return false;
-}
+/******************************************************************************
+* Multi-line comments
+******************************************************************************/
 
-static bool
-begin_comment (string s, int i) {
-  bool comment= false;
-  int opos, pos= 0;
-  do {
-    do {
-      opos= pos;
-      parse_string (s, pos, false);
-      if (opos < pos) break;
-      parse_comment_multi_lines (s, pos);
-      if (opos < pos) {
-        comment = true;
-        break;
-      }
-      pos++;
-    } while (false);
-  } while (pos <= i);
-  return comment;
-}
+#define LINE_OUTSIDE 0
+#define LINE_COMMENT 1
 
 static int
-after_begin_comment (int i, tree t) {
-  tree   t2= t;
-  string s2= t->label;
-  int  line= line_number (t2);
-  do {
-    if (begin_comment (s2, i)) return line;
-    t2= line_inc (t2, -1);
-    --line;
-      // line_inc returns tree(ERROR) upon error
-    if (!is_atomic (t2)) return -1; // FIXME
-    s2= t2->label;
-    i = N(s2) - 1;
-  } while (line > -1);
-  return -1;
-}
-
-static void
-parse_end_comment (string s, int& pos) {
-  if (pos+1 < N(s) && s[pos] == '*' && s[pos+1] == '/')
-    pos += 2;
-}
-
-static bool
-end_comment (string s, int i) {
-  int opos, pos= 0;
-  do {
-    do {
-      opos= pos;
-      parse_string (s, pos, false);
-      if (opos < pos) break;
-      parse_end_comment (s, pos);
-      if (opos < pos && pos>i) return true;
-      pos++;
-    } while (false);
-  } while (pos < N(s));
-  return false;
+comment_scan (string s, int state, int upto, bool& inside) {
+  // Scan s in the given lexer state up to the token containing upto.
+  // Return the state after this token and set inside if the token
+  // belongs to a multi-line comment, including its delimiters
+  int i= 0, n= N(s);
+  inside= false;
+  while (i < n) {
+    int j= i+1;
+    bool comment= (state == LINE_COMMENT);
+    if (state == LINE_COMMENT) {
+      if (test (s, i, "*/")) { j= i+2; state= LINE_OUTSIDE; }
+    }
+    else if (test (s, i, "/*")) { j= i+2; comment= true; state= LINE_COMMENT; }
+    else if (test (s, i, "//")) j= n;
+    else if (s[i] == '\"' || s[i] == '\'') {
+      while (j < n && s[j] != s[i]) j += (s[j] == '\\'? 2: 1);
+      j= min (j+1, n);
+    }
+    if (upto < j) { inside= comment; return state; }
+    i= j;
+  }
+  return state;
 }
 
 static int
-before_end_comment (int i, tree t) {
-  int   end= number_of_lines (t);
-  tree   t2= t;
-  string s2= t2->label;
-  int  line= line_number (t2);
-  do {
-    if (end_comment (s2, i)) return line;
-    t2= line_inc (t2, 1);
-    ++line;
-      // line_inc returns tree(ERROR) upon error
-    if (!is_atomic (t2)) return -1; // FIXME
-    s2= t2->label;
-    i = 0;
-  } while (line <= end);
-  return -1;
+line_state (tree& doc, int line) {
+  // the lexer state at the start of a line, using and updating the states
+  // which were cached for the document during previous calls
+  array<int> states;
+  int valid, dirty;
+  if (!obtain_line_states (doc, states, valid, dirty)) {
+    states= array<int> (1);
+    states[0]= LINE_OUTSIDE;
+    valid= 1;
+    dirty= -1;
+  }
+  bool inside;
+  for (int i= valid-1; i < line; i++) {
+    int next= states[i];
+    if (is_atomic (doc[i]))
+      next= comment_scan (doc[i]->label, states[i], N(doc[i]->label), inside);
+    if (i+1 < N(states) && i+1 > dirty && states[i+1] == next) {
+      valid= N(states);
+      break;
+    }
+    if (i+1 < N(states)) states[i+1]= next;
+    else states << next;
+    valid= i+2;
+  }
+  if (valid > dirty) dirty= -1;
+  attach_line_states (doc, states, valid, dirty);
+  return states[line];
 }
 
 bool
 in_comment (int pos, tree t) {
-  int beg= after_begin_comment (pos, t);
-  if (beg >= 0) {
-    int cur= line_number (t);
-    int end= before_end_comment (pos, line_inc (t, beg - cur));
-    return end >= beg && cur <= end;
+  // multi-line comments are only detected for lines of documents
+  // inside the global meta-tree; other strings are scanned on their own
+  int state= LINE_OUTSIDE;
+  path p= obtain_ip (t);
+  if (!is_nil (p) && last_item (p) >= 0) {
+    tree& doc= subtree (the_et, reverse (p->next));
+    if (is_func (doc, DOCUMENT) && p->item < N(doc))
+      state= line_state (doc, p->item);
   }
-  return false;
+  bool inside;
+  comment_scan (t->label, state, pos, inside);
+  return inside;
 }
 
 bool
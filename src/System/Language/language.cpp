@@ -507,12 +507,56 @@ spell_check (string lan, string s) {
   }
 }
 
-bool
-check_word (string lan, string s) {
-  string key= lan * ":" * s;
+static string
+spell_key (string lan, string s) {
   string f= uni_Locase_all (s);
   string l= uni_locase_first (f);
-  if (s != l && s != f) key= lan * ":" * l;
+  if (s != l && s != f) return lan * ":" * l;
+  return lan * ":" * s;
+}
+
+static array<tree>
+spell_check (string lan, array<string> a) {
+#ifdef MACOSX_EXTENSIONS
+  array<tree> r;
+  for (int i=0; i<N(a); i++) r << ispell_check (lan, a[i]);
+  return r;
+#else
+  return ispell_check (lan, a);
+#endif
+}
+
+void
+check_words (string lan, array<string> a) {
+  // check all uncached words of a at once
+  if (lan == "verbatim") return;
+  array<string> keys, words;
+  hashset<string> done;
+  for (int i=0; i<N(a); i++) {
+    string key= spell_key (lan, a[i]);
+    if (spell_cache[key] != 0 || done->contains (key)) continue;
+    done->insert (key);
+    keys << key;
+    string f= uni_Locase_all (a[i]);
+    words << (f == a[i]? a[i]: uni_locase_all (a[i]));
+  }
+  if (N(words) == 0) return;
+  bool busy= spell_busy->contains (lan);
+  if (!busy && spell_start (lan) != "ok") {
+    spell_active= false;
+    spell_done (lan);
+    for (int i=0; i<N(keys); i++) spell_cache (keys[i])= 1;
+    return;
+  }
+  array<tree> r= spell_check (lan, words);
+  for (int i=0; i<N(keys); i++)
+    spell_cache (keys[i])= (i < N(r) && r[i] == "ok")? 1: -1;
+  if (!busy) spell_done (lan);
+}
+
+bool
+check_word (string lan, string s) {
+  string key= spell_key (lan, s);
   int val= spell_cache[key];
   if (val == 0) {
     tree t= spell_check (lan, s);
@@ -167,6 +167,7 @@ string spell_start (string lan);
 void spell_done (string lan);
 tree spell_check (string lan, string s);
 bool check_word (string lan, string s);
+void check_words (string lan, array<string> a);
 void spell_accept (string lan, string s, bool permanent= false);
 void spell_insert (string lan, string s);
 
@@ -19,6 +19,7 @@ int                  packrat_nr_symbols= 0;
 hashmap<string,C>    packrat_tokens;
 hashmap<tree,C>      packrat_symbols;
 hashmap<C,tree>      packrat_decode (packrat_uninit);
+int                  packrat_grammar_version= 0;
 
 RESOURCE_CODE(packrat_grammar);
 
@@ -379,12 +380,14 @@ void
 packrat_define (string lan, string s, tree t) {
   packrat_grammar gr= find_packrat_grammar (lan);
   gr->define (s, t);
+  packrat_grammar_version++;
 }
 
 void
 packrat_property (string lan, string s, string var, string val) {
   packrat_grammar gr= find_packrat_grammar (lan);
   gr->set_property (s, var, val);
+  packrat_grammar_version++;
 }
 
 void
@@ -405,6 +408,7 @@ packrat_inherit (string lan, string from) {
     //cout << "Inherit " << p << " -> " << inh->properties (p) << LF;
     gr->properties (p)= inh->properties (p);
   }
+  packrat_grammar_version++;
 }
 
 int
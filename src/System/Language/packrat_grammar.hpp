@@ -90,4 +90,8 @@ struct packrat_grammar_rep: rep<packrat_grammar> {
 
 packrat_grammar find_packrat_grammar (string s);
 
+// increased whenever a grammar is modified, which invalidates the parsers
+// and the results of parsing which are remembered
+extern int packrat_grammar_version;
+
 #endif // PACKRAT_GRAMMAR_H
@@ -34,19 +34,29 @@ packrat_parser_rep::packrat_parser_rep (packrat_grammar gr):
   current_pos_path (-1),
   current_cursor (-1),
   current_input (),
-  current_cache (PACKRAT_UNDEFINED),
+  memo_index (-1),
+  current_memo (),
+  current_reach (0),
   current_production (packrat_uninit) {}
 
 packrat_parser
 make_packrat_parser (string lan, tree in) {
   static string         last_lan   = "";
   static tree           last_in    = "";
+  static int            last_vers  = -1;
   static packrat_parser last_par;
-  if (lan != last_lan || in != last_in) {
+  if (lan != last_lan || in != last_in ||
+      last_vers != packrat_grammar_version) {
     packrat_grammar gr= find_packrat_grammar (lan);
+    packrat_parser par (gr, copy (in));
+    if (lan == last_lan && last_vers == packrat_grammar_version &&
+        !is_nil (last_par))
+      par->reuse (last_par->current_input, last_par->current_memo,
+                  last_par->memo_index);
     last_lan   = lan;
-    last_in    = copy (in);
-    last_par   = packrat_parser (gr, last_in);
+    last_in    = par->current_tree;
+    last_vers  = packrat_grammar_version;
+    last_par   = par;
   }
   return last_par;
 }
@@ -56,10 +66,13 @@ make_packrat_parser (string lan, tree in, path in_pos) {
   static string         last_lan   = "";
   static tree           last_in    = "";
   static path           last_in_pos= path ();
+  static int            last_vers  = -1;
   static packrat_parser last_par;
-  if (lan != last_lan || in != last_in || in_pos != last_in_pos) {
+  if (lan != last_lan || in != last_in || in_pos != last_in_pos ||
+      last_vers != packrat_grammar_version) {
     packrat_grammar gr= find_packrat_grammar (lan);
     last_lan   = lan;
+    last_vers  = packrat_grammar_version;
     last_in    = copy (in);
     last_in_pos= copy (in_pos);
     last_par   = packrat_parser (gr, last_in, last_in_pos);
@@ -79,6 +92,7 @@ packrat_parser_rep::set_input (tree t) {
   if (DEBUG_FLATTEN)
     debug_packrat << "Input " << current_string << "\n";
   current_input= encode_tokens (current_string);
+  current_memo = array<array<C> > (N(current_input) + 1);
 }
 
 void
@@ -88,6 +102,41 @@ packrat_parser_rep::set_cursor (path p) {
   //cout << current_input << ", " << current_cursor << "\n";
 }
 
+void
+packrat_parser_rep::reuse (array<C> old_input, array<array<C> > old_memo,
+                           hashmap<C,int> old_index) {
+  // Take over the memoized results of a previous parser for an edited
+  // version of the input.  Results before the edited range remain valid
+  // if they were obtained without inspecting this range; results after
+  // the range remain valid, up to a shift of the positions.
+  int n= N(current_input), old_n= N(old_input);
+  if (N(old_memo) != old_n + 1) return;
+  int a= 0, b= 0;
+  while (a < n && a < old_n && current_input[a] == old_input[a]) a++;
+  while (b < n - a && b < old_n - a &&
+         current_input[n-1-b] == old_input[old_n-1-b]) b++;
+  memo_index= old_index;
+  for (int pos=0; pos<=a && pos<n-b; pos++) {
+    array<C> row= copy (old_memo[pos]);
+    for (int i=0; i<N(row); i+=2)
+      if (row[i+1] > a) {
+        row[i  ]= PACKRAT_UNDEFINED;
+        row[i+1]= pos;
+      }
+    current_memo[pos]= row;
+  }
+  C delta= n - old_n;
+  for (int pos=n-b; pos<=n; pos++) {
+    array<C> row= copy (old_memo[pos - delta]);
+    for (int i=0; i<N(row); i+=2)
+      if (row[i] != PACKRAT_UNDEFINED) {
+        if (row[i] >= 0) row[i] += delta;
+        row[i+1] += delta;
+      }
+    current_memo[pos]= row;
+  }
+}
+
 /******************************************************************************
 * Encoding and decoding of cursor positions in the input
 ******************************************************************************/
@@ -178,15 +227,43 @@ starts (tree t, string s) {
   return is_atomic (t) && starts (t->label, s);
 }
 
+void
+packrat_parser_rep::memo_set (C pos, int index, C result, C reach) {
+  array<C>& row= current_memo[pos];
+  int n= N(row);
+  if (2*index >= n) {
+    row->resize (2*index + 2);
+    for (int i=n; i<N(row); i+=2) {
+      row[i  ]= PACKRAT_UNDEFINED;
+      row[i+1]= pos;
+    }
+  }
+  row[2*index  ]= result;
+  row[2*index+1]= reach;
+}
+
 C
 packrat_parser_rep::parse (C sym, C pos) {
-  D key= (((D) sym) << 32) + ((D) (sym^pos));
-  C im = current_cache [key];
-  if (im != PACKRAT_UNDEFINED) {
-    //cout << "Cached " << sym << " at " << pos << " -> " << im << LF;
-    return im;
+  // results for non terminal symbols are memoized by position, together
+  // with the end of the part of the input which was inspected to get them
+  int index= -1;
+  if (sym >= PACKRAT_TM_OPEN && pos >= 0 && pos < N(current_memo)) {
+    index= memo_index[sym];
+    if (index < 0) {
+      index= N(memo_index);
+      memo_index (sym)= index;
+    }
+    array<C>& row= current_memo[pos];
+    if (2*index < N(row) && row[2*index] != PACKRAT_UNDEFINED) {
+      //cout << "Cached " << sym << " at " << pos << " -> " << im << LF;
+      current_reach= max (current_reach, row[2*index+1]);
+      return row[2*index];
+    }
+    memo_set (pos, index, PACKRAT_FAILED, pos);
   }
-  current_cache (key)= PACKRAT_FAILED;
+  C im;
+  C outer_reach= current_reach;
+  current_reach= pos;
   if (DEBUG_PACKRAT)
     debug_packrat << "Parse " << packrat_decode[sym]
                   << " at " << pos << INDENT << LF;
@@ -226,6 +303,7 @@ packrat_parser_rep::parse (C sym, C pos) {
         }
       break;
     case PACKRAT_RANGE:
+      current_reach= pos + 1;
       if (pos < N (current_input) &&
           current_input [pos] >= inst[1] &&
           current_input [pos] <= inst[2])
@@ -243,6 +321,7 @@ packrat_parser_rep::parse (C sym, C pos) {
           im= PACKRAT_FAILED;
       break;
     case PACKRAT_TM_OPEN:
+      current_reach= pos + 1;
       if (pos < N (current_input) &&
           starts (packrat_decode[current_input[pos]], "<\\"))
         im= pos + 1;
@@ -268,6 +347,7 @@ packrat_parser_rep::parse (C sym, C pos) {
       while (im < N (current_input))
         if (current_input[im] != encode_token ("<|>")) break;
         else im= parse (PACKRAT_TM_ANY, im + 1);
+      current_reach= max (current_reach, im + 1);
       break;
     case PACKRAT_TM_LEAF:
       im= pos;
@@ -276,8 +356,10 @@ packrat_parser_rep::parse (C sym, C pos) {
         if (starts (t, "<\\") || t == "<|>" || t == "</>") break;
         else im++;
       }
+      current_reach= im + 1;
       break;
     case PACKRAT_TM_CHAR:
+      current_reach= pos + 1;
       if (pos >= N (current_input)) im= PACKRAT_FAILED;
       else {
         tree t= packrat_decode[current_input[pos]];
@@ -298,10 +380,12 @@ packrat_parser_rep::parse (C sym, C pos) {
     }
   }
   else {
+    current_reach= pos + 1;
     if (pos < N (current_input) && current_input[pos] == sym) im= pos + 1;
     else im= PACKRAT_FAILED;
   }
-  current_cache (key)= im;
+  if (index >= 0) memo_set (pos, index, im, current_reach);
+  current_reach= max (outer_reach, current_reach);
   if (DEBUG_PACKRAT)
     debug_packrat << UNINDENT << "Parsed " << packrat_decode[sym]
                   << " at " << pos << " -> " << im << LF;
@@ -731,11 +815,27 @@ packrat_parse (string lan, string sym, tree in) {
   return par->decode_tree_position (pos);
 }
 
+#define PACKRAT_CORRECT_MAX 4096
+
 bool
 packrat_correct (string lan, string sym, tree in) {
+  // the correctness of the same formulas is checked many times while
+  // editing them, both during the typesetting and by the editing routines
+  static hashmap<tree,int> correct (-1);
+  static int version= -1;
+  if (version != packrat_grammar_version) {
+    correct= hashmap<tree,int> (-1);
+    version= packrat_grammar_version;
+  }
+  tree key= tuple (lan, sym, in);
+  int r= correct[key];
+  if (r >= 0) return r == 1;
   packrat_parser par= make_packrat_parser (lan, in);
   C pos= par->parse (encode_symbol (compound ("symbol", sym)), 0);
-  return pos == N(par->current_input);
+  bool ok= (pos == N(par->current_input));
+  if (N(correct) >= PACKRAT_CORRECT_MAX) correct= hashmap<tree,int> (-1);
+  correct (tuple (lan, sym, copy (in)))= ok? 1: 0;
+  return ok;
 }
 
 bool
@@ -34,7 +34,9 @@ public:
   int                       current_hl_lan;
 
   array<C>                  current_input;
-  hashmap<D,C>              current_cache;
+  hashmap<C,int>            memo_index;     // dense numbering of symbols
+  array<array<C> >          current_memo;   // (result, reach) per position
+  C                         current_reach;  // end of the inspected input
   hashmap<D,tree>           current_production;
 
 protected:
@@ -45,6 +47,7 @@ protected:
   void set_cursor (path t_pos);
   path decode_path (tree t, path p, int pos);
   int  encode_path (tree t, path p, path pos);
+  void memo_set (C pos, int index, C result, C reach);
 
 public:
   packrat_parser_rep (packrat_grammar gr);
@@ -54,6 +57,8 @@ public:
   path decode_tree_position (C pos);
   C    encode_tree_position (path p);
   C    parse (C sym, C pos);
+  void reuse (array<C> old_input, array<array<C> > old_memo,
+              hashmap<C,int> old_index);
 
   void inspect (C sym, C pos, array<C>& syms, array<C>& poss);
   bool is_left_recursive (C sym);
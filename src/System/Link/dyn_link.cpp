@@ -86,7 +86,7 @@ symbols_install (string lib, string* symb, pointer* f, int n) {
 ******************************************************************************/
 
 dyn_link_rep::dyn_link_rep (string l, string s, string i, string ses):
-  lib (l), symbol (s), init (i), routs (NULL), session (ses)
+  lib (l), symbol (s), init (i), routs (NULL), session (ses), protocol (1)
 {
   alive= false;
 }
@@ -105,24 +105,57 @@ static TeXmacs_exports_1 TeXmacs= {
   const_cast<char*> ("TeXmacs " TEXMACS_VERSION),
 };
 
+static char*
+dyn_link_reserve (void* out, int size) {
+  // the output buffer is the string in which the answer is returned
+  string& s= *((string*) out);
+  int n= N(s);
+  s->resize (max (n + size, 0));
+  return &(s[min (n, N(s))]);
+}
+
+static TeXmacs_exports_2 TeXmacs_2= {
+  const_cast<char*> ("TeXmacs communication protocol 2"),
+  const_cast<char*> ("TeXmacs " TEXMACS_VERSION),
+  dyn_link_reserve
+};
+
+static int
+dyn_link_protocol (pointer routs) {
+  package_exports* pack= (package_exports*) routs;
+  string version (pack->version_protocol);
+  if (version == "TeXmacs communication protocol 2") return 2;
+  return 1;
+}
+
 string
 dyn_link_rep::start () {
 #ifndef OS_MINGW
   string name= lib * ":" * symbol * "-package";
   if (dyn_linked->contains (name))
     routs= dyn_linked [name];
-  if (routs != NULL)
+  if (routs != NULL) {
+    protocol= dyn_link_protocol (routs);
     return "continuation of#'" * lib * "'";
+  }
   if (DEBUG_AUTO)
     debug_automatic << "Installing dynamic link '" << lib << "'\n";
 
   string message= symbol_install (lib, symbol, routs);
   if (routs != NULL) {
     dyn_linked (name)= routs;
-    package_exports_1* pack= (package_exports_1*) routs;
+    protocol= dyn_link_protocol (routs);
     c_string _init (init);
     char* _errors= NULL;
-    char* _message= pack->install (&TeXmacs, _init, &_errors);
+    char* _message;
+    if (protocol == 2) {
+      package_exports_2* pack= (package_exports_2*) routs;
+      _message= pack->install (&TeXmacs_2, _init, &_errors);
+    }
+    else {
+      package_exports_1* pack= (package_exports_1*) routs;
+      _message= pack->install (&TeXmacs, _init, &_errors);
+    }
     if (_errors != NULL) {
       routs= NULL;
       ret= "Error: " * string (_errors);
@@ -147,13 +180,22 @@ dyn_link_rep::write (string s, int channel) {
     failed_error << "Library= " << lib << "\n";
     FAILED ("library not installed");
   }
-  package_exports_1* pack= (package_exports_1*) routs;
-
   c_string _session (session);
-  c_string _s (s);
   char* _errors= NULL;
-  char* _r= pack->evaluate (_s, _session, &_errors);
-  ret= string (_r==NULL? (_errors==NULL? ((char*) "Error"): _errors): _r);
+  if (protocol == 2) {
+    // the package reads s and writes its answer into ret without copies
+    package_exports_2* pack= (package_exports_2*) routs;
+    ret= "";
+    int r= pack->evaluate (&(s[0]), N(s), _session, (void*) &ret, &_errors);
+    if (r != 0 && N(ret) == 0)
+      ret= string (_errors==NULL? ((char*) "Error"): _errors);
+  }
+  else {
+    package_exports_1* pack= (package_exports_1*) routs;
+    c_string _s (s);
+    char* _r= pack->evaluate (_s, _session, &_errors);
+    ret= string (_r==NULL? (_errors==NULL? ((char*) "Error"): _errors): _r);
+  }
   if (!is_nil (this->feed_cmd)) this->feed_cmd->apply ();
 #endif
 }
@@ -27,6 +27,7 @@ struct dyn_link_rep: tm_link_rep {
   pointer routs;     // Routines exported by package
   string  session;   // Name of the session
   string  ret;       // the last answer returned after 'write'
+  int     protocol;  // version of the communication protocol
 
 public:
   dyn_link_rep (string lib, string symbol, string init, string session);
@@ -34,6 +34,8 @@
 #include <malloc.h>
 #endif
 
+#define PIPE_BUFFER_SIZE 65536
+
 hashset<pointer> pipe_link_set;
 void pipe_callback (void *obj, void *info);
 extern char **environ;
@@ -147,6 +149,8 @@ pipe_link_rep::start () {
 #ifndef OS_MINGW
   if (alive) return "busy";
   if (DEBUG_AUTO) debug_io << "Launching '" << cmd << "'\n";
+  // tell the plugins that they may send sized blocks (see input.cpp)
+  set_env ("TEXMACS_SIZED_BLOCKS", "1");
 
   int e1= pipe (pp_in ); (void) e1;
   int e2= pipe (pp_out); (void) e2;
@@ -238,9 +242,9 @@ pipe_link_rep::feed (int channel) {
 #ifndef OS_MINGW
   if ((!alive) || ((channel != LINK_OUT) && (channel != LINK_ERR))) return;
   int r;
-  char tempout[1024];
-  if (channel == LINK_OUT) r = ::read (out, tempout, 1024);
-  else r = ::read (err, tempout, 1024);
+  char tempout[PIPE_BUFFER_SIZE];
+  if (channel == LINK_OUT) r = ::read (out, tempout, PIPE_BUFFER_SIZE);
+  else r = ::read (err, tempout, PIPE_BUFFER_SIZE);
   if (r == -1) {
     io_error << "Read failed for '" << cmd << "'\n";
     wait (NULL);
@@ -291,16 +295,9 @@ pipe_link_rep::listen (int msecs) {
   if (!alive) return;
   time_t wait_until= texmacs_time () + msecs;
   while ((outbuf == "") && (errbuf == "")) {
-    fd_set rfds;
-    FD_ZERO (&rfds);
-    FD_SET (out, &rfds);
-    FD_SET (err, &rfds);
-    struct timeval tv;
-    tv.tv_sec  = msecs / 1000;
-    tv.tv_usec = 1000 * (msecs % 1000);
-    int nr= select (max (out, err) + 1, &rfds, NULL, NULL, &tv);
-    if (nr != 0 && FD_ISSET (out, &rfds)) feed (LINK_OUT);
-    if (nr != 0 && FD_ISSET (err, &rfds)) feed (LINK_ERR);
+    int r= wait_for_input (out, err, msecs);
+    if (r & 1) feed (LINK_OUT);
+    if (r & 2) feed (LINK_ERR);
     if (texmacs_time () - wait_until > 0) break;
   }
 }
@@ -342,24 +339,14 @@ void pipe_callback (void *obj, void *info) {
   bool busy= true;
   bool news= false;
   while (busy) {
-    fd_set rfds;
-    FD_ZERO (&rfds);
-    int max_fd= max (con->err, con->out) + 1;
-    FD_SET (con->out, &rfds);
-    FD_SET (con->err, &rfds);
-  
-    struct timeval tv;
-    tv.tv_sec  = 0;
-    tv.tv_usec = 0;
-    select (max_fd, &rfds, NULL, NULL, &tv);
-
+    int r= wait_for_input (con->out, con->err, 0);
     busy= false;
-    if (con->alive && FD_ISSET (con->out, &rfds)) {
+    if (con->alive && (r & 1)) {
       //cout << "pipe_callback OUT" << LF;
       con->feed (LINK_OUT);
       busy= news= true;
     }
-    if (con->alive && FD_ISSET (con->err, &rfds)) {
+    if (con->alive && (r & 2)) {
       //cout << "pipe_callback ERR" << LF;
       con->feed (LINK_ERR);
       busy= news= true;
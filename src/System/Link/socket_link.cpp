@@ -35,6 +35,10 @@ namespace wsoc {
 #endif
 #include <errno.h>
 
+// maximal amount of unprocessed input, beyond which we stop reading
+// from the socket, so that the sender is slowed down by TCP flow control
+#define SOCKET_MAX_PENDING (1 << 24)
+
 hashset<pointer> socket_link_set;
 void socket_callback (void *obj, void* info);
 
@@ -48,6 +52,7 @@ socket_link_rep::socket_link_rep (string host2, int port2, int type2, int fd):
   socket_link_set->insert ((pointer) this);
   io     = fd;
   outbuf = "";
+  throttled= false;
   alive  = (fd != -1);
   if (type == SOCKET_SERVER) {
     sn = socket_notifier (io, &socket_callback, this, NULL);  
@@ -278,25 +283,31 @@ socket_link_rep::read (int channel) {
   if (channel == LINK_OUT) {
     string r= outbuf;
     outbuf= "";
+    drained (channel);
     return r;
   }
   else return "";
 }
 
+void
+socket_link_rep::throttle (bool on) {
+  if (on == throttled || is_nil (sn)) return;
+  throttled= on;
+  if (on) remove_notifier (sn);
+  else add_notifier (sn);
+}
+
+void
+socket_link_rep::drained (int channel) {
+  if (channel == LINK_OUT && throttled && alive &&
+      N(outbuf) < SOCKET_MAX_PENDING / 2)
+    throttle (false);
+}
+
 void
 socket_link_rep::listen (int msecs) {
-#ifdef OS_MINGW
-  using namespace wsoc;
-#endif
   if (!alive) return;
-  fd_set rfds;
-  FD_ZERO (&rfds);
-  FD_SET (io, &rfds);
-  struct timeval tv;
-  tv.tv_sec  = msecs / 1000;
-  tv.tv_usec = 1000 * (msecs % 1000);
-  int nr= select (io+1, &rfds, NULL, NULL, &tv);
-  if (nr != 0 && FD_ISSET (io, &rfds)) feed (LINK_OUT);
+  if (wait_for_input (io, -1, msecs) & 1) feed (LINK_OUT);
 }
 
 void
@@ -316,6 +327,7 @@ socket_link_rep::stop () {
   alive= false;
   remove_notifier (sn);
   sn = socket_notifier ();
+  throttled= false;
 #ifdef OS_MINGW
   closesocket (io);
   WSACleanup();
@@ -345,22 +357,17 @@ socket_callback (void *obj, void* info) {
   bool busy= true;
   bool news= false;
   while (busy) {
-    fd_set rfds;
-    FD_ZERO (&rfds);
-    int max_fd= con->io + 1;
-    FD_SET (con->io, &rfds);
-  
-    struct timeval tv;
-    tv.tv_sec  = 0;
-    tv.tv_usec = 0;
-    select (max_fd, &rfds, NULL, NULL, &tv);
-
+    int r= wait_for_input (con->io, -1, 0);
     busy= false;
-    if (con->alive && FD_ISSET (con->io, &rfds)) {
+    if (con->alive && (r & 1)) {
       //cout << "socket_callback OUT" << LF;
       con->feed (LINK_OUT);
       busy= news= true;
       if (!con->alive) break;
+      if (N(con->outbuf) >= SOCKET_MAX_PENDING) {
+        con->throttle (true);
+        break;
+      }
     }
   }
   if (!is_nil (con->feed_cmd) && news)
@@ -24,6 +24,7 @@ struct socket_link_rep: tm_link_rep {
   int    type;          // socket type
   int    io;            // file descriptor for data going to the child
   string outbuf;        // pending output from plugin
+  bool   throttled;     // stop reading until outbuf has been consumed
 
   socket_notifier sn;
   
@@ -38,8 +39,10 @@ public:
   void    listen (int msecs);
   void    interrupt ();
   void    stop ();
+  void    drained (int channel);
 
   void    feed (int channel);
+  void    throttle (bool on);
 };
 
 #endif // SOCKET_LINK_H
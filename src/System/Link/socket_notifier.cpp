@@ -8,18 +8,30 @@
 * It comes WITHOUT ANY WARRANTY WHATSOEVER. For details, see the file LICENSE
 * in the root directory or <http://www.gnu.org/licenses/gpl-3.0.html>.
 ******************************************************************************/
-#ifndef QTTEXMACS
-
 #include "config.h"
 
 #ifndef OS_MINGW
 #include <unistd.h>
 #include <fcntl.h>
+#include <poll.h>
 #include <sys/wait.h>
 #include <sys/types.h>
 #include <sys/socket.h>
 #include <netinet/in.h>
 #include <netdb.h>
+#if defined (__linux__)
+#define NOTIFIER_EPOLL
+#include <sys/epoll.h>
+#elif defined (__APPLE__) || defined (__FreeBSD__)
+#define NOTIFIER_KQUEUE
+#include <sys/event.h>
+#include <sys/time.h>
+#endif
+#else
+namespace wsoc {
+#include <sys/types.h>
+#include <winsock2.h>
+}
 #endif
 #include <errno.h>
 
@@ -28,53 +40,197 @@
 #include "list.hpp"
 #include "iterator.hpp"
 
+/******************************************************************************
+* Waiting for input on one or two file descriptors
+******************************************************************************/
+
+int
+wait_for_input (int fd1, int fd2, int msecs) {
+  // unlike select, poll does not restrict the values of the descriptors
+  int r= 0;
+#ifdef OS_MINGW
+  using namespace wsoc;
+  fd_set rfds;
+  FD_ZERO (&rfds);
+  if (fd1 >= 0) FD_SET (fd1, &rfds);
+  if (fd2 >= 0) FD_SET (fd2, &rfds);
+  struct timeval tv;
+  tv.tv_sec  = msecs / 1000;
+  tv.tv_usec = 1000 * (msecs % 1000);
+  if (select (max (fd1, fd2) + 1, &rfds, NULL, NULL, &tv) <= 0) return 0;
+  if (fd1 >= 0 && FD_ISSET (fd1, &rfds)) r |= 1;
+  if (fd2 >= 0 && FD_ISSET (fd2, &rfds)) r |= 2;
+#else
+  struct pollfd pfds[2];
+  pfds[0].fd= fd1; pfds[0].events= POLLIN; pfds[0].revents= 0;
+  pfds[1].fd= fd2; pfds[1].events= POLLIN; pfds[1].revents= 0;
+  if (poll (pfds, 2, msecs) <= 0) return 0;
+  // hangups and errors are reported as input, so that reads detect them
+  if (pfds[0].revents & (POLLIN | POLLHUP | POLLERR)) r |= 1;
+  if (pfds[1].revents & (POLLIN | POLLHUP | POLLERR)) r |= 2;
+#endif
+  return r;
+}
+
+#ifndef QTTEXMACS
+
+/******************************************************************************
+* The set of notifiers and the kernel event queue
+******************************************************************************/
+
 static hashset<socket_notifier> notifiers;
+static hashmap<int,socket_notifier> notifier_of;
+static int  notifier_queue = -1;
+static bool notifier_failed= false;
+
+#define NOTIFIER_BATCH 64
 
 void
 socket_notifier_rep::notify () {
   if (!is_nil (cmd)) cmd->apply ();
 }
 
+static int
+get_notifier_queue () {
+  // returns a negative value if we have to fall back on select
+  if (notifier_queue < 0 && !notifier_failed) {
+#if defined (NOTIFIER_EPOLL)
+    notifier_queue= epoll_create (NOTIFIER_BATCH);
+#elif defined (NOTIFIER_KQUEUE)
+    notifier_queue= kqueue ();
+#endif
+    if (notifier_queue < 0) notifier_failed= true;
+#ifndef OS_MINGW
+    else fcntl (notifier_queue, F_SETFD, FD_CLOEXEC);
+#endif
+  }
+  return notifier_queue;
+}
+
+static void
+notifier_watch (int q, int fd, bool on) {
+#if defined (NOTIFIER_EPOLL)
+  struct epoll_event ev;
+  ev.events = EPOLLIN;
+  ev.data.u64= 0;
+  ev.data.fd= fd;
+  epoll_ctl (q, on? EPOLL_CTL_ADD: EPOLL_CTL_DEL, fd, &ev);
+#elif defined (NOTIFIER_KQUEUE)
+  struct kevent ev;
+  EV_SET (&ev, fd, EVFILT_READ, on? EV_ADD: EV_DELETE, 0, 0, NULL);
+  kevent (q, &ev, 1, NULL, 0, NULL);
+#else
+  (void) q; (void) fd; (void) on;
+#endif
+}
+
+static int
+notifier_events (int q, int* fds, int msecs) {
+  // store the descriptors with pending input in fds and return their number
+#if defined (NOTIFIER_EPOLL)
+  struct epoll_event evs[NOTIFIER_BATCH];
+  int nr= epoll_wait (q, evs, NOTIFIER_BATCH, msecs);
+  for (int i=0; i<nr; i++) fds[i]= evs[i].data.fd;
+  return nr;
+#elif defined (NOTIFIER_KQUEUE)
+  struct kevent evs[NOTIFIER_BATCH];
+  struct timespec ts;
+  ts.tv_sec = msecs / 1000;
+  ts.tv_nsec= 1000000 * (msecs % 1000);
+  int nr= kevent (q, NULL, 0, evs, NOTIFIER_BATCH, &ts);
+  for (int i=0; i<nr; i++) fds[i]= (int) evs[i].ident;
+  return nr;
+#else
+  (void) q; (void) fds; (void) msecs;
+  return 0;
+#endif
+}
+
 void
 add_notifier (socket_notifier sn)  {
   //cout << "enable notifier " << LF;
   notifiers->insert (sn);
+  notifier_of (sn->fd)= sn;
+  int q= get_notifier_queue ();
+  if (q >= 0) notifier_watch (q, sn->fd, true);
 } 
 
 void
 remove_notifier (socket_notifier sn)  {
   //cout << "disable notifier " << LF;
   notifiers->remove (sn);
+  if (notifier_of[sn->fd] == sn) {
+    notifier_of->reset (sn->fd);
+    int q= get_notifier_queue ();
+    if (q >= 0) notifier_watch (q, sn->fd, false);
+  }
 }
 
+/******************************************************************************
+* Dispatching the notifiers with pending input
+******************************************************************************/
+
+#ifndef OS_MINGW
+static int
+select_notifiers (fd_set& rfds, int fd, int msecs) {
+  // fallback in case the kernel event queue is not available
+  FD_ZERO (&rfds);
+  int max_fd= 0;
+  if (fd >= 0) { FD_SET (fd, &rfds); max_fd= fd+1; }
+  iterator<socket_notifier> it = iterate (notifiers);
+  while (it->busy ()) {
+    socket_notifier sn= it->next ();
+    FD_SET (sn->fd, &rfds);
+    if (sn->fd >= max_fd) max_fd= sn->fd+1;
+  }
+  if (max_fd == 0 && msecs == 0) return 0;
+  struct timeval tv;
+  tv.tv_sec  = msecs / 1000;
+  tv.tv_usec = 1000 * (msecs % 1000);
+  return select (max_fd, &rfds, NULL, NULL, &tv);
+}
+#endif
+
 void 
 perform_select () {
 #ifndef OS_MINGW
-  //FIXME: this can be optimizied
-  while (true) {
-    fd_set rfds;
-    FD_ZERO (&rfds);
-    int max_fd= 0;
-    iterator<socket_notifier> it = iterate (notifiers);
-    while (it->busy ()) {
-      socket_notifier sn= it->next ();
-      FD_SET (sn->fd, &rfds);
-      if (sn->fd >= max_fd) max_fd= sn->fd+1;
+  int q= get_notifier_queue ();
+  while (N(notifiers) != 0) {
+    if (q >= 0) {
+      int fds[NOTIFIER_BATCH];
+      int nr= notifier_events (q, fds, 0);
+      if (nr <= 0) break;
+      for (int i=0; i<nr; i++) {
+        socket_notifier sn= notifier_of[fds[i]];
+        if (!is_nil (sn)) sn->notify ();
+      }
     }
-    if (max_fd == 0) break;
-    
-    struct timeval tv;
-    tv.tv_sec  = 0;
-    tv.tv_usec = 0;
-    int nr = select (max_fd, &rfds, NULL, NULL, &tv);
-    if (nr==0) break;
-    
-    it = iterate (notifiers);
-    while (it->busy ()) {
-      socket_notifier sn=  it->next ();
-      if (FD_ISSET (sn->fd, &rfds)) sn->notify ();
+    else {
+      fd_set rfds;
+      int nr= select_notifiers (rfds, -1, 0);
+      if (nr <= 0) break;
+      iterator<socket_notifier> it = iterate (notifiers);
+      while (it->busy ()) {
+        socket_notifier sn=  it->next ();
+        if (FD_ISSET (sn->fd, &rfds)) sn->notify ();
+      }
     }
   }  
 #endif  
 }
+
+void
+wait_for_notifiers (int fd, int msecs) {
+#ifndef OS_MINGW
+  int q= get_notifier_queue ();
+  if (q >= 0) wait_for_input (q, fd, msecs);
+  else {
+    fd_set rfds;
+    select_notifiers (rfds, fd, msecs);
+  }
+#else
+  wait_for_input (fd, -1, msecs);
 #endif
+}
+
+#endif // QTTEXMACS
@@ -47,4 +47,11 @@ void perform_select ();
 void add_notifier (socket_notifier);
 void remove_notifier (socket_notifier);
 
+// wait until there is input for one of the notifiers or on fd
+void wait_for_notifiers (int fd, int msecs);
+
+// bit 1 (resp. 2) of the result is set if there is input on fd1 (resp. fd2);
+// negative descriptors are ignored
+int  wait_for_input (int fd1, int fd2, int msecs);
+
 #endif // SOCKET_NOTIFIER_H
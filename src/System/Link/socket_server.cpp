@@ -65,9 +65,8 @@ number_of_servers () {
 
 void
 close_all_servers () {
-iterator<pointer> it= iterate (socket_server_set);
-  while (it->busy()) {
-    socket_server_rep* ss= (socket_server_rep*) it->next();
+  for (pointer p: socket_server_set) {
+    socket_server_rep* ss= (socket_server_rep*) p;
     if (ss->alive) {
       // FIXME: cleanly close the connection to the socket here
       ss->alive= false;
@@ -225,18 +224,9 @@ socket_server_callback (void *obj, void *info) {
   bool busy= true;
   bool news= false;
   while (busy) {
-    fd_set rfds;
-    FD_ZERO (&rfds);
-    int max_fd= ss->server + 1;
-    FD_SET (ss->server, &rfds);
-  
-    struct timeval tv;
-    tv.tv_sec  = 0;
-    tv.tv_usec = 0;
-    select (max_fd, &rfds, NULL, NULL, &tv);
-
+    int r= wait_for_input (ss->server, -1, 0);
     busy= false;
-    if (ss->alive && FD_ISSET (ss->server, &rfds)) {
+    if (ss->alive && (r & 1)) {
       //cout << "server_callback" << LF;
       ss->start_client ();
       busy= news= true;
@@ -66,10 +66,12 @@ tm_link_rep::read_packet (int channel, int timeout, bool& success) {
   }
   if (channel == LINK_OUT && N(r) > 0 && r[0] == '!') {
     secure_server (message_receive (r));
+    drained (channel);
     return "";
   }
   else {
     string back= message_receive (r);
+    drained (channel);
     if (secret != "") back= secret_decode (back, secret);
     success= true;
     return back;
@@ -54,6 +54,7 @@ public:
   virtual void    listen (int msecs) = 0;
   virtual void    interrupt () = 0;
   virtual void    stop () = 0;
+  virtual void    drained (int channel) { (void) channel; }
 
   void write_packet (string s, int channel);
   bool complete_packet (int channel);
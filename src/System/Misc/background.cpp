@@ -0,0 +1,180 @@
+
+/******************************************************************************
+* MODULE     : background.cpp
+* DESCRIPTION: running external programs on background threads
+* COPYRIGHT  : (C) 2020  Joris van der Hoeven
+*******************************************************************************
+* This software falls under the GNU general public license version 3 or later.
+* It comes WITHOUT ANY WARRANTY WHATSOEVER. For details, see the file LICENSE
+* in the root directory or <http://www.gnu.org/licenses/gpl-3.0.html>.
+******************************************************************************/
+
+#include "background.hpp"
+#include "sys_utils.hpp"
+#include "hashmap.hpp"
+#include <stdlib.h>
+
+#if defined(THREAD_SAFE_ALLOC) && !defined(OS_MINGW)
+#define BACKGROUND_THREADS
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+#define BACKGROUND_WORKERS 4
+
+/******************************************************************************
+* Tasks
+******************************************************************************/
+
+struct background_task {
+  int              id;
+  char*            cmd;     // plain copy of the command line
+  int              status;  // exit status, set by the worker
+  background_task* next;
+};
+
+static hashmap<int,command> background_done;  // only used by the main thread
+static int background_nr  = 0;
+static int background_last= 0;
+
+static void
+background_finish (background_task* t) {
+  command done= background_done [t->id];
+  background_done->reset (t->id);
+  background_last= t->status;
+  tm_delete_array (t->cmd);
+  tm_delete (t);
+  if (!is_nil (done)) done ();
+}
+
+int
+background_status () {
+  return background_last;
+}
+
+bool
+background_busy () {
+  return N(background_done) > 0;
+}
+
+/******************************************************************************
+* The pool of workers
+******************************************************************************/
+
+#ifdef BACKGROUND_THREADS
+
+static pthread_mutex_t  bg_lock    = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t   bg_work    = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t   bg_finished= PTHREAD_COND_INITIALIZER;
+static background_task* bg_first   = NULL;  // tasks which were not started
+static background_task* bg_last    = NULL;
+static background_task* bg_ready   = NULL;  // finished tasks
+static pid_t            bg_pid     = 0;     // process which started the pool
+static int              bg_workers = 0;
+static int              bg_idle    = 0;
+
+static void*
+background_loop (void* arg) {
+  (void) arg;
+  pthread_mutex_lock (&bg_lock);
+  while (true) {
+    bg_idle++;
+    while (bg_first == NULL) pthread_cond_wait (&bg_work, &bg_lock);
+    bg_idle--;
+    background_task* t= bg_first;
+    bg_first= t->next;
+    if (bg_first == NULL) bg_last= NULL;
+    pthread_mutex_unlock (&bg_lock);
+    t->status= ::system (t->cmd);
+    pthread_mutex_lock (&bg_lock);
+    t->next= bg_ready;
+    bg_ready= t;
+    pthread_cond_broadcast (&bg_finished);
+  }
+  return NULL;
+}
+
+static bool
+background_start () {
+  // called with bg_lock held
+  if (bg_pid != getpid ()) {
+    // the workers are not inherited by forked processes
+    bg_pid    = getpid ();
+    bg_workers= 0;
+    bg_idle   = 0;
+  }
+  if (bg_idle == 0 && bg_workers < BACKGROUND_WORKERS) {
+    pthread_t thread;
+    pthread_attr_t attr;
+    pthread_attr_init (&attr);
+    pthread_attr_setdetachstate (&attr, PTHREAD_CREATE_DETACHED);
+    if (pthread_create (&thread, &attr, background_loop, NULL) == 0)
+      bg_workers++;
+    pthread_attr_destroy (&attr);
+  }
+  return bg_workers > 0;
+}
+
+#endif
+
+/******************************************************************************
+* Interface
+******************************************************************************/
+
+void
+background_system (string cmd, command done) {
+  if (DEBUG_STD) debug_shell << cmd << " &\n";
+  background_task* t= tm_new<background_task> ();
+  t->id    = ++background_nr;
+  t->cmd   = as_charp (cmd);
+  t->status= 0;
+  t->next  = NULL;
+  background_done (t->id)= done;
+#ifdef BACKGROUND_THREADS
+  pthread_mutex_lock (&bg_lock);
+  if (background_start ()) {
+    if (bg_last == NULL) bg_first= t;
+    else bg_last->next= t;
+    bg_last= t;
+    pthread_cond_signal (&bg_work);
+    pthread_mutex_unlock (&bg_lock);
+    return;
+  }
+  pthread_mutex_unlock (&bg_lock);
+#endif
+  t->status= system (cmd);
+  background_finish (t);
+}
+
+void
+background_poll () {
+#ifdef BACKGROUND_THREADS
+  if (!background_busy ()) return;
+  pthread_mutex_lock (&bg_lock);
+  background_task* l= bg_ready;
+  bg_ready= NULL;
+  pthread_mutex_unlock (&bg_lock);
+  background_task* r= NULL;
+  while (l != NULL) {
+    background_task* next= l->next;
+    l->next= r; r= l; l= next;
+  }
+  while (r != NULL) {
+    background_task* next= r->next;
+    background_finish (r);
+    r= next;
+  }
+#endif
+}
+
+void
+background_wait () {
+#ifdef BACKGROUND_THREADS
+  while (background_busy ()) {
+    pthread_mutex_lock (&bg_lock);
+    while (bg_ready == NULL) pthread_cond_wait (&bg_finished, &bg_lock);
+    pthread_mutex_unlock (&bg_lock);
+    background_poll ();
+  }
+#endif
+}
@@ -0,0 +1,34 @@
+
+/******************************************************************************
+* MODULE     : background.hpp
+* DESCRIPTION: running external programs on background threads
+* COPYRIGHT  : (C) 2020  Joris van der Hoeven
+*******************************************************************************
+* This software falls under the GNU general public license version 3 or later.
+* It comes WITHOUT ANY WARRANTY WHATSOEVER. For details, see the file LICENSE
+* in the root directory or <http://www.gnu.org/licenses/gpl-3.0.html>.
+******************************************************************************/
+
+#ifndef BACKGROUND_H
+#define BACKGROUND_H
+#include "command.hpp"
+
+/******************************************************************************
+* background_system runs a shell command on a small pool of worker threads,
+* so that slow external programs (downloads, converters) do not block the
+* interface. The workers only see a plain copy of the command line; once the
+* command has finished, the continuation done is executed by the main thread,
+* from background_poll, which is called by the main loop. During the
+* execution of done, background_status returns the exit status of the shell
+* command. background_wait finishes all pending tasks; it is used when a
+* result is needed right away. When threads are not available, the command
+* is executed directly.
+******************************************************************************/
+
+void background_system (string cmd, command done);
+int  background_status ();
+bool background_busy ();
+void background_poll ();
+void background_wait ();
+
+#endif // defined BACKGROUND_H
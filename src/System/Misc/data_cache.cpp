@@ -18,37 +18,48 @@
 * Caching routines
 ******************************************************************************/
 
-static hashmap<tree,tree> cache_data ("?");
+static hashmap<string,hashmap<tree,tree> > cache_data;
+static hashset<string> cache_pending;
 static hashset<string> cache_loaded;
 static hashset<string> cache_changed;
 static hashmap<string,bool> cache_valid (false);
 
+static hashmap<tree,tree>
+cache_buffer (string buffer) {
+  // the buffers are only loaded from disk when they are first used
+  if (cache_pending->contains (buffer)) {
+    cache_pending->remove (buffer);
+    cache_load (buffer);
+  }
+  if (!cache_data->contains (buffer))
+    cache_data (buffer)= hashmap<tree,tree> ("?");
+  return cache_data [buffer];
+}
+
 void
 cache_set (string buffer, tree key, tree t) {
-  tree ckey= tuple (buffer, key);
-  if (cache_data[ckey] != t) {
-    cache_data (ckey)= t;
+  hashmap<tree,tree> h= cache_buffer (buffer);
+  if (h[key] != t) {
+    h (key)= t;
     cache_changed->insert (buffer);
   }
 }
 
 void
 cache_reset (string buffer, tree key) {
-  tree ckey= tuple (buffer, key);
-  cache_data->reset (ckey);
+  hashmap<tree,tree> h= cache_buffer (buffer);
+  h->reset (key);
   cache_changed->insert (buffer);
 }
 
 bool
 is_cached (string buffer, tree key) {
-  tree ckey= tuple (buffer, key);
-  return cache_data->contains (ckey);
+  return cache_buffer (buffer) -> contains (key);
 }
 
 tree
 cache_get (string buffer, tree key) {
-  tree ckey= tuple (buffer, key);
-  return cache_data [ckey];
+  return cache_buffer (buffer) [key];
 }
 
 bool
@@ -154,70 +165,78 @@ do_cache_doc (string name) {
 * Saving and loading the cache to/from disk
 ******************************************************************************/
 
+static url
+cache_file (string buffer, bool binary) {
+  // the buffers are stored in binary form, in files without the .scm suffix
+  if (binary && ends (buffer, ".scm")) buffer= buffer (0, N(buffer) - 4);
+  if (binary) buffer= buffer * ".tmb";
+  return texmacs_home_path * url ("system/cache/" * buffer);
+}
+
 void
 cache_save (string buffer) {
   if (cache_changed->contains (buffer)) {
-    url cache_file= texmacs_home_path * url ("system/cache/" * buffer);
-    string cached;
-    iterator<tree> it= iterate (cache_data);
-    if (buffer == "file_cache" || buffer == "doc_cache") {
-      while (it->busy ()) {
-        tree ckey= it->next ();
-        if (ckey[0] == buffer) {
-          cached << ckey[1]->label << "\n";
-          cached << cache_data [ckey]->label << "\n";
-          cached << "%-%-tm-cache-%-%\n";
-        }
-      }
+    hashmap<tree,tree> h= cache_buffer (buffer);
+    tree t (TUPLE, 2 * N(h));
+    iterator<tree> it= iterate (h);
+    for (int i=0; it->busy (); i+=2) {
+      tree key= it->next ();
+      t[i]= key;
+      t[i+1]= h[key];
     }
-    else {
-      cached << "(tuple\n";
-      while (it->busy ()) {
-        tree ckey= it->next ();
-        if (ckey[0] == buffer) {
-          cached << tree_to_scheme (ckey[1]) << " ";
-          cached << tree_to_scheme (cache_data [ckey]) << "\n";
-        }
-      }
-      cached << ")";
-    }
-    (void) save_string (cache_file, cached);
+    (void) save_string (cache_file (buffer, true), tree_to_binary (t));
+    url old_file= cache_file (buffer, false);
+    if (exists (old_file)) remove (old_file);
     cache_changed->remove (buffer);
   }
 }
 
+static void
+cache_load_text (string buffer, hashmap<tree,tree> h) {
+  // cache files from before the binary format
+  string cached;
+  if (load_string (cache_file (buffer, false), cached, false)) return;
+  if (buffer == "file_cache" || buffer == "doc_cache") {
+    int i=0, n= N(cached);
+    while (i<n) {
+      int start= i;
+      while (i<n && cached[i] != '\n') i++;
+      string key= cached (start, i);
+      i++; start= i;
+      while (i<n && (cached[i] != '\n' ||
+                     !test (cached, i+1, "%-%-tm-cache-%-%"))) i++;
+      string im= cached (start, i);
+      i++;
+      while (i<n && cached[i] != '\n') i++;
+      i++;
+      //cout << "key= " << key << "\n----------------------\n";
+      //cout << "im= " << im << "\n----------------------\n";
+      h (key)= im;
+    }
+  }
+  else {
+    tree t= scheme_to_tree (cached);
+    for (int i=0; i<N(t)-1; i+=2)
+      h (t[i])= t[i+1];
+  }
+}
+
 void
 cache_load (string buffer) {
   if (!cache_loaded->contains (buffer)) {
-    url cache_file = texmacs_home_path * url ("system/cache/" * buffer);
-    //cout << "cache_file "<< cache_file << LF;
+    cache_loaded->insert (buffer);
+    cache_pending->remove (buffer);
+    hashmap<tree,tree> h= cache_buffer (buffer);
     string cached;
-    if (!load_string (cache_file, cached, false)) {
-      if (buffer == "file_cache" || buffer == "doc_cache") {
-        int i=0, n= N(cached);
-        while (i<n) {
-          int start= i;
-          while (i<n && cached[i] != '\n') i++;
-          string key= cached (start, i);
-          i++; start= i;
-          while (i<n && (cached[i] != '\n' ||
-                         !test (cached, i+1, "%-%-tm-cache-%-%"))) i++;
-          string im= cached (start, i);
-          i++;
-          while (i<n && cached[i] != '\n') i++;
-          i++;
-          //cout << "key= " << key << "\n----------------------\n";
-          //cout << "im= " << im << "\n----------------------\n";
-          cache_data (tuple (buffer, key))= im;
-        }
-      }
-      else {
-        tree t= scheme_to_tree (cached);
-        for (int i=0; i<N(t)-1; i+=2)
-          cache_data (tuple (buffer, t[i]))= t[i+1];
+    if (!load_string (cache_file (buffer, true), cached, false)) {
+      tree t= binary_to_tree (cached);
+      if (!is_func (t, ERROR)) {
+        for (int i=0; i+1<N(t); i+=2)
+          h (t[i])= t[i+1];
+        return;
       }
     }
-    cache_loaded->insert (buffer);
+    cache_load_text (buffer, h);
   }
 }
 
@@ -228,19 +247,22 @@ cache_memorize () {
   cache_save ("dir_cache.scm");
   cache_save ("stat_cache.scm");
   cache_save ("font_cache.scm");
+  cache_save ("image_cache.scm");
   cache_save ("validate_cache.scm");
 }
 
 void
 cache_refresh () {
-  cache_data   = hashmap<tree,tree> ("?");
+  cache_data   = hashmap<string,hashmap<tree,tree> > ();
+  cache_pending= hashset<string> ();
   cache_loaded = hashset<string> ();
   cache_changed= hashset<string> ();
-  cache_load ("file_cache");
-  cache_load ("dir_cache.scm");
-  cache_load ("stat_cache.scm");
-  cache_load ("font_cache.scm");
-  cache_load ("validate_cache.scm");
+  cache_pending->insert ("file_cache");
+  cache_pending->insert ("dir_cache.scm");
+  cache_pending->insert ("stat_cache.scm");
+  cache_pending->insert ("font_cache.scm");
+  cache_pending->insert ("image_cache.scm");
+  cache_pending->insert ("validate_cache.scm");
 }
 
 void
@@ -265,3 +287,43 @@ cache_initialize () {
       is_recursively_up_to_date (texmacs_home_path * "fonts/truetype"));
   else remove (texmacs_home_path * "fonts/error" * url_wildcard ("*"));
 }
+
+/******************************************************************************
+* Caching parsed trees in binary form
+******************************************************************************/
+
+static url
+cache_tree_file (string name) {
+  return texmacs_home_path * url ("system/cache/trees/" *
+                                  as_hexadecimal (hash (name)) * ".tmb");
+}
+
+bool
+cache_tree_load (url u, tree& t) {
+  // retrieve the cached tree for u, if it is still up to date
+  string name= concretize (u);
+  string s;
+  if (load_string (cache_tree_file (name), s, false)) return false;
+  int pos= 0;
+  if (unmarshall_string (s, pos) != name) return false;
+  if (((int) unmarshall_number (s, pos)) != last_modified (u, false))
+    return false;
+  tree r= binary_to_tree (s (pos, N(s)));
+  if (is_func (r, ERROR)) return false;
+  t= r;
+  return true;
+}
+
+void
+cache_tree_save (url u, tree t) {
+  // store the tree parsed from u in binary form, together with
+  // the name of u and its modification time, which are checked on loading
+  string name= concretize (u);
+  url dir= texmacs_home_path * url ("system/cache/trees");
+  if (!exists (dir)) mkdir (dir);
+  string s;
+  marshall_string (s, name);
+  marshall_number (s, (unsigned long int) last_modified (u, false));
+  s << tree_to_binary (t);
+  (void) save_string (cache_tree_file (name), s);
+}
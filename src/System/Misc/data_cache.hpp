@@ -27,6 +27,9 @@ bool do_cache_stat (string name);
 bool do_cache_file (string name);
 bool do_cache_doc (string name);
 
+bool cache_tree_load (url u, tree& t);
+void cache_tree_save (url u, tree t);
+
 void cache_save (string buffer);
 void cache_load (string buffer);
 void cache_memorize ();
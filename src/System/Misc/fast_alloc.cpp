@@ -15,19 +15,111 @@
 ******************************************************************************/
 
 #include "fast_alloc.hpp"
+#include <string.h>
 
-void*   alloc_table[MAX_FAST]; // Static declaration initializes with NULL's
-char*  alloc_mem=NULL;
+TM_THREAD_LOCAL void*  alloc_table[MAX_FAST]; // initialized with NULL's
+TM_THREAD_LOCAL char*  alloc_mem=NULL;
 #ifdef DEBUG_ON
 char*  alloc_mem_top=NULL;
 char*  alloc_mem_bottom=(char*)((unsigned long long)-1);
 #endif
-size_t alloc_remains=0;
+TM_THREAD_LOCAL size_t alloc_remains=0;
 int    allocated=0;
 int    fast_chunks=0;
 int    large_uses=0;
+int    alloc_threads=0;
 int    MEM_DEBUG=0;
 int    mem_used ();
+TM_THREAD_LOCAL int mem_tag= MEM_OTHER;
+TM_THREAD_LOCAL long long mem_tag_bytes[MEM_TAGS];
+static long long mem_tag_merged[MEM_TAGS];  // of terminated threads
+
+/*****************************************************************************/
+// Central pool for the free lists of terminated threads
+/*****************************************************************************/
+
+#ifdef THREAD_SAFE_ALLOC
+#include <pthread.h>
+#define ATOMIC_ADD(x,d) __sync_fetch_and_add (&(x), (d))
+#define ATOMIC_LOAD(x) __atomic_load_n (&(x), __ATOMIC_RELAXED)
+#define ATOMIC_STORE(x,v) __atomic_store_n (&(x), (v), __ATOMIC_RELAXED)
+
+static void*           central_table[MAX_FAST];
+static pthread_mutex_t central_lock= PTHREAD_MUTEX_INITIALIZER;
+static pthread_key_t   thread_key;
+static pthread_once_t  thread_once= PTHREAD_ONCE_INIT;
+static TM_THREAD_LOCAL bool thread_registered= false;
+
+// the tag counters of the running threads, which are summed by mem_tagged
+#define MAX_COUNTED_THREADS 256
+static long long* thread_counters[MAX_COUNTED_THREADS];
+static int        thread_counters_nr= 0;
+
+static void
+flush_thread_cache (void* dummy) {
+  // hand the free lists and the unused part of the current block, which is
+  // cut into free blocks of the largest possible sizes, to the central pool
+  (void) dummy;
+  pthread_mutex_lock (&central_lock);
+  while (alloc_remains >= WORD_LENGTH) {
+    size_t sz= alloc_remains < MAX_FAST? alloc_remains: MAX_FAST-WORD_LENGTH;
+    ind (alloc_mem)= alloc_table[sz];
+    alloc_table[sz]= alloc_mem;
+    alloc_mem    += sz;
+    alloc_remains-= sz;
+  }
+  for (int i=WORD_LENGTH; i<MAX_FAST; i+=WORD_LENGTH) {
+    void* ptr= alloc_table[i];
+    if (ptr == NULL) continue;
+    void* last= ptr;
+    while (ind (last) != NULL) last= ind (last);
+    ind (last)= central_table[i];
+    ATOMIC_STORE (central_table[i], ptr);
+    alloc_table[i]= NULL;
+  }
+  for (int i=0; i<MEM_TAGS; i++) {
+    mem_tag_merged[i] += mem_tag_bytes[i];
+    mem_tag_bytes[i]= 0;
+  }
+  for (int i=0; i<thread_counters_nr; i++)
+    if (thread_counters[i] == mem_tag_bytes) {
+      thread_counters[i]= thread_counters[--thread_counters_nr];
+      break;
+    }
+  pthread_mutex_unlock (&central_lock);
+  ATOMIC_ADD (alloc_threads, -1);
+  // blocks which are freed by the destructors of other thread specific
+  // data register the thread again, so that they are flushed in the next
+  // round of destructors
+  thread_registered= false;
+}
+
+static void
+create_thread_key () {
+  pthread_key_create (&thread_key, flush_thread_cache);
+}
+
+static void
+register_thread () {
+  // make sure that the free lists are flushed when the thread terminates
+  thread_registered= true;
+  pthread_once (&thread_once, create_thread_key);
+  pthread_setspecific (thread_key, (void*) 1);
+  ATOMIC_ADD (alloc_threads, 1);
+  pthread_mutex_lock (&central_lock);
+  // when there are too many threads, the counters of the others are only
+  // taken into account once they terminate
+  if (thread_counters_nr < MAX_COUNTED_THREADS)
+    thread_counters[thread_counters_nr++]= mem_tag_bytes;
+  pthread_mutex_unlock (&central_lock);
+}
+
+#define CHECK_THREAD() { if (!thread_registered) register_thread (); }
+
+#else
+#define ATOMIC_ADD(x,d) ((x) += (d))
+#define CHECK_THREAD()
+#endif
 
 /*****************************************************************************/
 // General purpose fast allocation routines
@@ -52,7 +144,7 @@ enlarge_malloc (size_t sz) {
     alloc_mem_bottom=alloc_mem_bottom>alloc_mem?alloc_mem:alloc_mem_bottom;
     #endif
     alloc_remains= BLOCK_SIZE;
-    fast_chunks++;
+    ATOMIC_ADD (fast_chunks, 1);
   }
   void* ptr= alloc_mem;
   alloc_mem    += sz;
@@ -60,12 +152,31 @@ enlarge_malloc (size_t sz) {
   return ptr;
 }
 
+void*
+refill_malloc (size_t sz) {
+  // the free list of the current thread for size sz is empty
+  CHECK_THREAD ();
+#ifdef THREAD_SAFE_ALLOC
+  if (ATOMIC_LOAD (central_table[sz]) != NULL) {
+    pthread_mutex_lock (&central_lock);
+    void* ptr= central_table[sz];
+    if (ptr != NULL) {
+      alloc_table[sz]= ind (ptr);
+      ATOMIC_STORE (central_table[sz], (void*) NULL);
+    }
+    pthread_mutex_unlock (&central_lock);
+    if (ptr != NULL) return ptr;
+  }
+#endif
+  return enlarge_malloc (sz);
+}
+
 void*
 fast_alloc (size_t sz) {
   sz= (sz+WORD_LENGTH_INC)&WORD_MASK;
   if (sz<MAX_FAST) {
     void *ptr= alloc_ptr (sz);
-    if (ptr==NULL) return enlarge_malloc (sz);
+    if (ptr==NULL) return refill_malloc (sz);
     alloc_ptr (sz)= ind (ptr);
     #ifdef DEBUG_ON
     break_stub(ptr);
@@ -75,7 +186,8 @@ fast_alloc (size_t sz) {
   else {
     if (MEM_DEBUG>=3) cout << "Big alloc of " << sz << " bytes\n";
     if (MEM_DEBUG>=3) cout << "Memory used: " << mem_used () << " bytes\n";
-    large_uses += sz;
+    CHECK_THREAD ();
+    ATOMIC_ADD (large_uses, sz);
     return safe_malloc (sz);
   }
 }
@@ -88,12 +200,14 @@ fast_free (void* ptr, size_t sz) {
     break_stub(ptr);
     break_stub(alloc_ptr (sz));
     #endif
+    CHECK_THREAD ();
     ind (ptr)     = alloc_ptr (sz);
     alloc_ptr (sz)= ptr;
   }
   else {
     if (MEM_DEBUG>=3) cout << "Big free of " << sz << " bytes\n";
-    large_uses -= sz;    
+    CHECK_THREAD ();
+    ATOMIC_ADD (large_uses, -((int) sz));    
     free (ptr);
     if (MEM_DEBUG>=3) cout << "Memory used: " << mem_used () << " bytes\n";
   }
@@ -109,7 +223,7 @@ fast_new (size_t s) {
   #endif
   if (s<MAX_FAST) {
     ptr= alloc_ptr(s);
-    if (ptr==NULL) ptr= enlarge_malloc (s);
+    if (ptr==NULL) ptr= refill_malloc (s);
     else alloc_ptr(s)= ind(ptr);
     #ifdef DEBUG_ON
     break_stub(ptr);
@@ -118,13 +232,15 @@ fast_new (size_t s) {
   else {
     if (MEM_DEBUG>=3) cout << "Big alloc of " << s << " bytes\n";
     if (MEM_DEBUG>=3) cout << "Memory used: " << mem_used () << " bytes\n";
+    CHECK_THREAD ();
     ptr= safe_malloc (s);
     //if ((((int) ptr) & 15) != 0) cout << "Unaligned new " << ptr << "\n";
-    large_uses += s;
+    ATOMIC_ADD (large_uses, s);
   }
+  mem_tag_bytes[mem_tag_of (mem_tag_pack (s))] += s;
   #ifdef DEBUG_ON
   char *mem=(char *)ptr;
-  *((size_t *) ptr)=s;
+  *((size_t *) ptr)=mem_tag_pack (s);
   ptr= ((char*) ptr)+ WORD_LENGTH;
   *((size_t *) ptr)=s;
   ptr= ((char*) ptr)+ WORD_LENGTH;
@@ -133,7 +249,7 @@ fast_new (size_t s) {
   *((int*)(mem+s-WORD_LENGTH))=0x55aa;
   return (void*) ptr;
   #else
-  *((size_t *) ptr)=s;
+  *((size_t *) ptr)=mem_tag_pack (s);
   return (void*) (((char*) ptr)+ WORD_LENGTH);
   #endif
 }
@@ -146,7 +262,7 @@ void* alloc_check(const char *msg,void *ptr,size_t* sp) {
   ptr= (void*) (((char*) ptr)- WORD_LENGTH);
   size_t s1= *((size_t *) ptr);
   ptr= (void*) (((char*) ptr)- WORD_LENGTH);
-  size_t s= *((size_t *) ptr);
+  size_t s= mem_size_of (*((size_t *) ptr));
   if((s1 + comp) != -1 || (s + comp) != -1) {
     printf("%s %p size mismatch at %p %lu:%lu :%lu:%lu\n",msg,mem, ptr,s,s+comp,s1,s1+comp);
     if(break_stub (ptr)) s=s1<s?s1:s;
@@ -166,21 +282,24 @@ fast_delete (void* ptr) {
   ptr=alloc_check("fast_delete",ptr,&s);
   #else
   ptr= (void*) (((char*) ptr)- WORD_LENGTH);
-  size_t s= *((size_t *) ptr);
+  size_t s= mem_size_of (*((size_t *) ptr));
   #endif
+  mem_tag_bytes[mem_tag_of (*((size_t *) ptr))] -= s;
   if (s<MAX_FAST) {
     #ifdef DEBUG_ON
     break_stub(ptr);
     break_stub(alloc_ptr(s));
     #endif
+    CHECK_THREAD ();
     ind(ptr)    = alloc_ptr(s);
     alloc_ptr(s)= ptr;
   }
   else {
     if (MEM_DEBUG>=3) cout << "Big free of " << s << " bytes\n";
     //if ((((int) ptr) & 15) != 0) cout << "Unaligned delete " << ptr << "\n";
+    CHECK_THREAD ();
     free (ptr);
-    large_uses -= s;
+    ATOMIC_ADD (large_uses, -((int) s));
     if (MEM_DEBUG>=3) cout << "Memory used: " << mem_used () << " bytes\n";
   }
 }
@@ -194,7 +313,7 @@ fast_alloc_mw (size_t s)
 {
   if (s<MAX_FAST) {
     void *ptr= alloc_ptr(s);
-    if (ptr==NULL) return enlarge_malloc (s);
+    if (ptr==NULL) return refill_malloc (s);
     alloc_ptr(s)= ind(ptr);
     return ptr;
   }
@@ -205,6 +324,7 @@ void
 fast_free_mw (void* ptr, size_t s)
 {
   if (s<MAX_FAST) {
+    CHECK_THREAD ();
     ind(ptr)    = alloc_ptr(s);
     alloc_ptr(s)= ptr;
   }
@@ -225,9 +345,22 @@ compute_free (void* ptr) {
   return i;
 }
 
+int
+mem_central () {
+  int central_bytes= 0;
+#ifdef THREAD_SAFE_ALLOC
+  pthread_mutex_lock (&central_lock);
+  for (int i=WORD_LENGTH; i<MAX_FAST; i+=WORD_LENGTH)
+    central_bytes += i*compute_free (central_table+i);
+  pthread_mutex_unlock (&central_lock);
+#endif
+  return central_bytes;
+}
+
 int
 mem_used () {
-  int free_bytes= alloc_remains;
+  // free lists of other running threads are counted as used memory
+  int free_bytes= alloc_remains + mem_central ();
   int chunks_use= BLOCK_SIZE*fast_chunks;
   int i;
   for (i=WORD_LENGTH; i<MAX_FAST; i+=WORD_LENGTH)
@@ -239,7 +372,8 @@ mem_used () {
 void
 mem_info () {
   cout << "\n---------------- memory statistics ----------------\n";
-  int free_bytes= alloc_remains;
+  int central_bytes= mem_central ();
+  int free_bytes= alloc_remains + central_bytes;
   int chunks_use= BLOCK_SIZE*fast_chunks;
   int i;
   for (i=WORD_LENGTH; i<MAX_FAST; i+=WORD_LENGTH)
@@ -252,6 +386,54 @@ mem_info () {
   cout << "Allocator     : " << chunks_use+ large_uses << " bytes\n";
   cout << "Small mallocs : "
        << ((100*((float) small_uses))/((float) total_uses)) << "%\n";
+#ifdef THREAD_SAFE_ALLOC
+  cout << "Central pool  : " << central_bytes << " bytes\n";
+  cout << "Threads       : " << alloc_threads << "\n";
+#endif
+  cout << "---------------- by subsystem ---------------------\n";
+  mem_tag_info ();
+}
+
+/******************************************************************************
+* Memory accounting by subsystem
+******************************************************************************/
+
+static const char* mem_tag_names[MEM_TAGS]= {
+  "other", "trees", "boxes", "fonts", "glyphs",
+  "pictures", "scheme", "memorizers", "history" };
+
+const char*
+mem_tag_name (int tag) {
+  if (tag < 0 || tag >= MEM_TAGS) return "unknown";
+  return mem_tag_names[tag];
+}
+
+long long
+mem_tagged (int tag) {
+  // memory may be freed by another thread than the one which allocated it,
+  // so that only the sum over all threads is meaningful; the counters of
+  // the other running threads are read while they may change
+  if (tag < 0 || tag >= MEM_TAGS) return 0;
+#ifdef THREAD_SAFE_ALLOC
+  CHECK_THREAD ();
+  pthread_mutex_lock (&central_lock);
+  long long r= mem_tag_merged[tag];
+  for (int i=0; i<thread_counters_nr; i++)
+    r += __atomic_load_n (thread_counters[i] + tag, __ATOMIC_RELAXED);
+  pthread_mutex_unlock (&central_lock);
+  return r;
+#else
+  return mem_tag_merged[tag] + mem_tag_bytes[tag];
+#endif
+}
+
+void
+mem_tag_info () {
+  for (int i=0; i<MEM_TAGS; i++) {
+    cout << mem_tag_names[i];
+    for (int j= strlen (mem_tag_names[i]); j<14; j++) cout << " ";
+    cout << ": " << mem_tagged (i) << " bytes\n";
+  }
 }
 
 #ifdef DEBUG_ON
@@ -276,12 +458,12 @@ operator new (size_t s) {
   s= (s+ WORD_LENGTH+ WORD_LENGTH_INC)&WORD_MASK;
   if (s<MAX_FAST) {
     ptr= alloc_ptr(s);
-    if (ptr==NULL) ptr= enlarge_malloc (s);
+    if (ptr==NULL) ptr= refill_malloc (s);
     else alloc_ptr(s)= ind(ptr);
   }
   else {
     ptr= safe_malloc (s);
-    large_uses += s;
+    ATOMIC_ADD (large_uses, s);
   }
   *((size_t *) ptr)=s;
   return (void*) (((char*) ptr)+ WORD_LENGTH);
@@ -292,12 +474,13 @@ operator delete (void* ptr) {
   ptr= (void*) (((char*) ptr)- WORD_LENGTH);
   size_t s= *((size_t *) ptr);
   if (s<MAX_FAST) {
+    CHECK_THREAD ();
     ind(ptr)    = alloc_ptr(s);
     alloc_ptr(s)= ptr;
   }
   else {
     free (ptr);
-    large_uses -= s;
+    ATOMIC_ADD (large_uses, -((int) s));
   }
 }
 
@@ -307,12 +490,12 @@ operator new[] (size_t s) {
   s= (s+ WORD_LENGTH+ WORD_LENGTH_INC)&WORD_MASK;
   if (s<MAX_FAST) {
     ptr= alloc_ptr(s);
-    if (ptr==NULL) ptr= enlarge_malloc (s);
+    if (ptr==NULL) ptr= refill_malloc (s);
     else alloc_ptr(s)= ind(ptr);
   }
   else {
     ptr= safe_malloc (s);
-    large_uses += s;
+    ATOMIC_ADD (large_uses, s);
   }
   *((size_t *) ptr)=s;
   return (void*) (((char*) ptr)+ WORD_LENGTH);
@@ -323,12 +506,13 @@ operator delete[] (void* ptr) {
   ptr= (void*) (((char*) ptr)- WORD_LENGTH);
   size_t s= *((size_t *) ptr);
   if (s<MAX_FAST) {
+    CHECK_THREAD ();
     ind(ptr)    = alloc_ptr(s);
     alloc_ptr(s)= ptr;
   }
   else {
     free (ptr);
-    large_uses -= s;
+    ATOMIC_ADD (large_uses, -((int) s));
   }
 }
 
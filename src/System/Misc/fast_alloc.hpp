@@ -20,36 +20,128 @@
 
 #define BLOCK_SIZE 65536 // should be >>> MAX_FAST
 
+/******************************************************************************
+* Thread local caches
+*
+* Each thread owns its free lists and its current memory block, so that
+* the fast paths below need neither locks nor atomic operations.
+* The free lists and the unused part of the current block of terminated
+* threads are handed over to a central pool, from which other threads
+* refill their lists before taking new blocks.
+******************************************************************************/
+
+#if defined(__GNUC__) && (!defined(NO_THREAD_SAFE_ALLOC))
+#define THREAD_SAFE_ALLOC
+#define TM_THREAD_LOCAL __thread
+#else
+#define TM_THREAD_LOCAL
+#endif
+
 /******************************************************************************
 * Globals
 ******************************************************************************/
 
-extern void*   alloc_table[MAX_FAST]; // Static declaration initializes with NULL's
-extern char*  alloc_mem;
+extern TM_THREAD_LOCAL void* alloc_table[MAX_FAST]; // initialized with NULL's
+extern TM_THREAD_LOCAL char* alloc_mem;
 #ifdef DEBUG_ON
 extern char*  alloc_mem_top;
 extern char*  alloc_mem_bottom;
 #endif
 bool break_stub(void* ptr);
-extern size_t alloc_remains;
+extern TM_THREAD_LOCAL size_t alloc_remains;
 extern int    allocated;
 extern int    large_uses;
 
 #define alloc_ptr(i) alloc_table[i]
 #define ind(ptr) (*((void **) ptr))
 
+/******************************************************************************
+* Memory accounting by subsystem
+*
+* Memory obtained through tm_new and tm_new_array is charged to the tag
+* of the innermost MEM_TAG_SCOPE at the moment of the allocation.  The tag
+* is kept in the unused bits of the size header, so that the memory is
+* credited to the same tag when it is freed, whatever the current scope.
+* The counters are thread local; reports sum those of the running threads
+* and those of terminated threads, which are merged when they exit.
+******************************************************************************/
+
+#define MEM_OTHER        0
+#define MEM_TREES        1
+#define MEM_BOXES        2
+#define MEM_FONTS        3
+#define MEM_GLYPHS       4
+#define MEM_PICTURES     5
+#define MEM_SCHEME       6
+#define MEM_MEMORIZERS   7
+#define MEM_HISTORY      8
+#define MEM_TAGS         9
+
+extern TM_THREAD_LOCAL int mem_tag;
+extern TM_THREAD_LOCAL long long mem_tag_bytes[MEM_TAGS];
+
+#if WORD_LENGTH >= 8
+#define MEM_TAG_SHIFT 56
+#define mem_tag_pack(s) ((s) | (((size_t) mem_tag) << MEM_TAG_SHIFT))
+#define mem_tag_of(h) ((int) ((h) >> MEM_TAG_SHIFT))
+#define mem_size_of(h) ((h) & ((((size_t) 1) << MEM_TAG_SHIFT) - 1))
+#define mem_array_tag(ptr) (((int*) (ptr)) [1])
+#else
+#define mem_tag_pack(s) (s)
+#define mem_tag_of(h) MEM_OTHER
+#define mem_size_of(h) (h)
+#endif
+
+inline void
+mem_array_charge (void* ptr, size_t sz) {
+  // the element count of an array only occupies half of its header word
+#if WORD_LENGTH >= 8
+  mem_array_tag (ptr)= mem_tag;
+  mem_tag_bytes[mem_tag] += (sz+WORD_LENGTH_INC)&WORD_MASK;
+#else
+  (void) ptr;
+  mem_tag_bytes[MEM_OTHER] += (sz+WORD_LENGTH_INC)&WORD_MASK;
+#endif
+}
+
+inline void
+mem_array_credit (void* ptr, size_t sz) {
+#if WORD_LENGTH >= 8
+  mem_tag_bytes[mem_array_tag (ptr)] -= (sz+WORD_LENGTH_INC)&WORD_MASK;
+#else
+  (void) ptr;
+  mem_tag_bytes[MEM_OTHER] -= (sz+WORD_LENGTH_INC)&WORD_MASK;
+#endif
+}
+
+class mem_tag_scope {
+  int old_tag;
+public:
+  inline mem_tag_scope (int tag): old_tag (mem_tag) { mem_tag= tag; }
+  inline ~mem_tag_scope () { mem_tag= old_tag; }
+};
+
+#define MEM_TAG_SCOPE(tag) \
+  mem_tag_scope mem_tag_scope_instance (tag)
+
+extern long long   mem_tagged (int tag);
+extern const char* mem_tag_name (int tag);
+extern void        mem_tag_info ();
+
 /******************************************************************************
 * General purpose fast allocation routines
 ******************************************************************************/
 
 extern void* safe_malloc (size_t s);
 extern void* enlarge_malloc (size_t s);
+extern void* refill_malloc (size_t s);
 extern void* fast_alloc (size_t s);
 extern void  fast_free (void* ptr, size_t s);
 extern void* fast_new (size_t s);
 extern void  fast_delete (void* ptr);
 
 extern int   mem_used ();
+extern int   mem_central ();
 extern void  mem_info ();
 void* alloc_check(const char *msg,void *ptr,size_t* sp);
 
@@ -388,6 +480,7 @@ template<typename C>  C*
 tm_new_array (int n) {
   void* ptr= fast_alloc (n * sizeof (C) + (4 * WORD_LENGTH));
   *((int*) ptr)= n;
+  mem_array_charge (ptr, n * sizeof (C) + (4 * WORD_LENGTH));
   ptr= (void*) (((char*) ptr) + WORD_LENGTH);
   *((int*) ptr)= n;
   ptr= (void*) (((char*) ptr) + WORD_LENGTH);
@@ -419,6 +512,7 @@ tm_delete_array (C* Ptr) {
   }
   ctr--;
   for (int i=0; i<n; i++, ctr--) ctr -> ~C();
+  mem_array_credit (ptr, n * sizeof (C) + (4 * WORD_LENGTH));
   fast_free (ptr, n * sizeof (C) + (4 * WORD_LENGTH));
 }
 #else
@@ -426,6 +520,7 @@ template<typename C> inline C*
 tm_new_array (int n) {
   void* ptr= fast_alloc (n * sizeof (C) + WORD_LENGTH);
   *((int*) ptr)= n;
+  mem_array_charge (ptr, n * sizeof (C) + WORD_LENGTH);
   ptr= (void*) (((char*) ptr) + WORD_LENGTH);
   C* ctr= (C*) ptr;
   for (int i=0; i<n; i++, ctr++)
@@ -440,6 +535,7 @@ tm_delete_array (C* Ptr) {
   int n= *((int*) ptr);
   C* ctr= Ptr+n-1;
   for (int i=0; i<n; i++, ctr--) ctr -> ~C();
+  mem_array_credit (ptr, n * sizeof (C) + WORD_LENGTH);
   fast_free (ptr, n * sizeof (C) + WORD_LENGTH);
 }
 #endif
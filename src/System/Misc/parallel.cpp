@@ -0,0 +1,152 @@
+
+/******************************************************************************
+* MODULE     : parallel.cpp
+* DESCRIPTION: running data parallel jobs on a pool of worker threads
+* COPYRIGHT  : (C) 2020  Joris van der Hoeven
+*******************************************************************************
+* This software falls under the GNU general public license version 3 or later.
+* It comes WITHOUT ANY WARRANTY WHATSOEVER. For details, see the file LICENSE
+* in the root directory or <http://www.gnu.org/licenses/gpl-3.0.html>.
+******************************************************************************/
+
+#include "parallel.hpp"
+#include <stdlib.h>
+
+#if defined(THREAD_SAFE_ALLOC) && !defined(OS_MINGW)
+#define PARALLEL_THREADS
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+/******************************************************************************
+* Number of workers
+******************************************************************************/
+
+int
+parallel_workers () {
+#ifdef PARALLEL_THREADS
+  static int nr= 0;
+  if (nr == 0) {
+    const char* s= getenv ("TEXMACS_THREADS");
+    int n= (s != NULL? atoi (s): (int) sysconf (_SC_NPROCESSORS_ONLN));
+    nr= n < 1? 1: (n > 16? 16: n);
+  }
+  return nr;
+#else
+  return 1;
+#endif
+}
+
+/******************************************************************************
+* The pool of workers
+******************************************************************************/
+
+#ifdef PARALLEL_THREADS
+
+static pthread_mutex_t pool_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t  work_cond = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t  done_cond = PTHREAD_COND_INITIALIZER;
+static pid_t           pool_pid  = 0;     // process which started the pool
+static int             pool_size = 0;     // number of started workers
+static bool            pool_busy = false; // a job is running
+static unsigned int    pool_round= 0;     // incremented for each new job
+
+static parallel_job    job_fun;
+static void*           job_data;
+static int             job_n;
+static int             job_grain;
+static int             job_next;          // first tile which was not started
+static int             job_remaining;     // indices which were not finished
+
+static TM_THREAD_LOCAL bool in_job= false;
+
+static void
+run_tiles () {
+  // called with pool_lock held
+  while (job_next < job_n) {
+    int start= job_next;
+    int end  = (job_n - start > job_grain? start + job_grain: job_n);
+    job_next= end;
+    pthread_mutex_unlock (&pool_lock);
+    job_fun (job_data, start, end);
+    pthread_mutex_lock (&pool_lock);
+    job_remaining -= end - start;
+    if (job_remaining == 0) pthread_cond_signal (&done_cond);
+  }
+}
+
+static void*
+worker_loop (void* arg) {
+  (void) arg;
+  in_job= true;
+  unsigned int seen= 0;
+  pthread_mutex_lock (&pool_lock);
+  while (true) {
+    while (pool_round == seen) pthread_cond_wait (&work_cond, &pool_lock);
+    seen= pool_round;
+    run_tiles ();
+  }
+  return NULL;
+}
+
+static void
+start_workers (int nr) {
+  // called with pool_lock held
+  if (pool_pid != getpid ()) {
+    // the workers are not inherited by forked processes
+    pool_pid = getpid ();
+    pool_size= 0;
+  }
+  while (pool_size < nr) {
+    pthread_t thread;
+    pthread_attr_t attr;
+    pthread_attr_init (&attr);
+    pthread_attr_setdetachstate (&attr, PTHREAD_CREATE_DETACHED);
+    int err= pthread_create (&thread, &attr, worker_loop, NULL);
+    pthread_attr_destroy (&attr);
+    if (err != 0) break;
+    pool_size++;
+  }
+}
+
+#endif
+
+/******************************************************************************
+* Running jobs
+******************************************************************************/
+
+void
+parallel_for (parallel_job job, void* data, int n, int grain) {
+  if (n <= 0) return;
+  if (grain < 1) grain= 1;
+#ifdef PARALLEL_THREADS
+  int nr= parallel_workers ();
+  if (nr > 1 && n > grain && !in_job) {
+    pthread_mutex_lock (&pool_lock);
+    if (!pool_busy) {
+      start_workers (nr - 1);
+      if (pool_size > 0) {
+        pool_busy    = true;
+        job_fun      = job;
+        job_data     = data;
+        job_n        = n;
+        job_grain    = grain;
+        job_next     = 0;
+        job_remaining= n;
+        pool_round++;
+        pthread_cond_broadcast (&work_cond);
+        in_job= true;
+        run_tiles ();
+        in_job= false;
+        while (job_remaining > 0)
+          pthread_cond_wait (&done_cond, &pool_lock);
+        pool_busy= false;
+        pthread_mutex_unlock (&pool_lock);
+        return;
+      }
+    }
+    pthread_mutex_unlock (&pool_lock);
+  }
+#endif
+  job (data, 0, n);
+}
@@ -0,0 +1,31 @@
+
+/******************************************************************************
+* MODULE     : parallel.hpp
+* DESCRIPTION: running data parallel jobs on a pool of worker threads
+* COPYRIGHT  : (C) 2020  Joris van der Hoeven
+*******************************************************************************
+* This software falls under the GNU general public license version 3 or later.
+* It comes WITHOUT ANY WARRANTY WHATSOEVER. For details, see the file LICENSE
+* in the root directory or <http://www.gnu.org/licenses/gpl-3.0.html>.
+******************************************************************************/
+
+#ifndef PARALLEL_H
+#define PARALLEL_H
+#include "fast_alloc.hpp"
+
+/******************************************************************************
+* A parallel job processes the indices start <= i < end of a range 0 <= i < n.
+* parallel_for splits the range into tiles of grain indices and distributes
+* them over the calling thread and a pool of workers. The job is responsible
+* for the thread safety of what it does: in practice, it should only read
+* and write plain memory and never touch reference counted objects.
+* Jobs which are too small, nested jobs, and jobs started while another job
+* is running are executed directly by the calling thread.
+******************************************************************************/
+
+typedef void (*parallel_job) (void* data, int start, int end);
+
+int  parallel_workers ();
+void parallel_for (parallel_job job, void* data, int n, int grain);
+
+#endif // defined PARALLEL_H
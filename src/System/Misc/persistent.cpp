@@ -19,8 +19,6 @@
 ******************************************************************************/
 
 #define MAX_BRANCH 26
-#define MAX_INNER 10
-#define MAX_SIZE 4096
 #define MAX_FILES 26
 
 static hashmap<string,string>       persistent_pre   ("");
@@ -28,11 +26,175 @@ static hashmap<string,url>          persistent_file  (url_none ());
 static hashmap<string,unsigned int> persistent_hash  (0);
 static hashmap<string,bool>         persistent_has   (false);
 static hashmap<string,string>       persistent_cache ("");
+static hashmap<string,bool>         persistent_old   (false);
+static hashmap<string,int>          persistent_junk  (0);
 
 static int number_persistent_file_names= -1;
 
 /******************************************************************************
-* Writing and reading hashmaps to and from disk
+* Cache management subroutines
+******************************************************************************/
+
+static void persistent_load (url dir, string pre);
+
+string
+local_prefix (url dir) {
+  string name= as_string (dir);
+  if (!persistent_pre->contains (name)) {
+    string prefix= as_string (N (persistent_pre) + 1) * ":";
+    persistent_pre (name)= prefix;
+    if (!is_directory (dir)) mkdir (dir);
+    if (!is_directory (dir * url ("_"))) mkdir (dir * url ("_"));
+    bool old= false;
+    for (int i=0; i<MAX_BRANCH && !old; i++)
+      old= exists (dir * url (string ((char) (97 + i))));
+    persistent_old (prefix)= old;
+    persistent_load (dir, prefix);
+  }
+  return persistent_pre [name];
+}
+
+void
+persistent_init_key (url dir, string key) {
+  string v= local_prefix (dir) * key;
+  if (!persistent_file->contains (v)) {
+    persistent_file (v)= dir;
+    persistent_hash (v)= (unsigned int) hash (key);
+  }
+}
+
+void
+persistent_update_key (url dir, string key, url file, unsigned int code) {
+  unsigned int ncode= code / MAX_BRANCH;
+  unsigned int mcode= code % MAX_BRANCH;
+  url nfile= file * url (string ((char) (97 + mcode)));
+  string v= local_prefix (dir) * key;
+  persistent_file (v)= nfile;
+  persistent_hash (v)= ncode;
+}
+
+/******************************************************************************
+* The store of a directory
+*******************************************************************************
+* All pairs of a directory are kept in the single file _/store, which is only
+* appended to.  Each record consists of a header line with the length of
+* the key, the length of the value (-1 for removals) and a checksum,
+* followed by the key and the value.  When the file is read, a truncated or
+* damaged tail is ignored, so that an interrupted write only loses the pair
+* being written.  The file is rewritten when it contains too many obsolete
+* records, first into a temporary file which then replaces the store.
+******************************************************************************/
+
+static url
+persistent_store (url dir) {
+  return dir * url ("_") * url ("store");
+}
+
+static unsigned int
+persistent_checksum (string key, string val, int vn) {
+  return ((unsigned int) hash (key)) ^ ((unsigned int) hash (val)) ^
+         ((unsigned int) vn);
+}
+
+static string
+persistent_record (string key, string val, bool removed) {
+  int vn= removed? -1: N(val);
+  string r= as_string (N(key)) * " " * as_string (vn) * " " *
+            as_string ((int) persistent_checksum (key, val, vn)) * "\n";
+  r << key << val;
+  return r;
+}
+
+static bool
+read_field (string s, int& i, char end, int& x) {
+  int start= i, n= N(s);
+  if (i<n && s[i] == '-') i++;
+  while (i<n && is_digit (s[i])) i++;
+  if (i == start || i>=n || s[i] != end) return false;
+  x= as_int (s (start, i));
+  i++;
+  return true;
+}
+
+static void
+persistent_compact (url dir, string pre, hashmap<string,string> map) {
+  string s;
+  iterator<string> it= iterate (map);
+  while (it->busy ()) {
+    string key= it->next ();
+    s << persistent_record (key, map[key], false);
+  }
+  url store= persistent_store (dir);
+  url tmp= dir * url ("_") * url ("store.tmp");
+  if (!save_string (tmp, s, false)) move (tmp, store);
+  persistent_junk (pre)= 0;
+}
+
+static int
+persistent_parse (string s, hashmap<string,string>& map, int& junk) {
+  // returns the end of the valid part of the store
+  int i=0, n= N(s);
+  while (i<n) {
+    int j= i, kn, vn, sum;
+    if (!read_field (s, j, ' ', kn) || !read_field (s, j, ' ', vn) ||
+        !read_field (s, j, '\n', sum) || kn < 0 || vn < -1 ||
+        j + kn + max (vn, 0) > n) break;
+    string key= s (j, j + kn);
+    string val= vn < 0? string (""): s (j + kn, j + kn + vn);
+    if (persistent_checksum (key, val, vn) != (unsigned int) sum) break;
+    if (map->contains (key)) junk++;
+    if (vn < 0) { map->reset (key); junk++; }
+    else map (key)= val;
+    i= j + kn + max (vn, 0);
+  }
+  if (i<n) junk++;
+  return i;
+}
+
+static void
+persistent_load (url dir, string pre) {
+  string s;
+  hashmap<string,string> map ("");
+  int i=0, junk= 0;
+  url store= persistent_store (dir);
+  if (is_regular (store) && !load_string (store, s, false))
+    i= persistent_parse (s, map, junk);
+  iterator<string> it= iterate (map);
+  while (it->busy ()) {
+    string key= it->next ();
+    persistent_has   (pre * key)= true;
+    persistent_cache (pre * key)= map[key];
+  }
+  persistent_junk (pre)= junk;
+  if (i < N(s)) persistent_compact (dir, pre, map);
+}
+
+static void
+persistent_append (url dir, string key, string val, bool removed) {
+  string pre= local_prefix (dir);
+  if (append_string (persistent_store (dir),
+                     persistent_record (key, val, removed), false)) return;
+  persistent_junk (pre) += 1;
+  if (persistent_junk [pre] > 1024) {
+    // other processes may have appended to the store since it was loaded,
+    // so the live pairs are read again from the file itself
+    string s;
+    hashmap<string,string> map ("");
+    int junk= 0;
+    if (load_string (persistent_store (dir), s, false)) return;
+    persistent_parse (s, map, junk);
+    iterator<string> it= iterate (map);
+    while (it->busy ()) {
+      string k= it->next ();
+      persistent_has   (pre * k)= true;
+      persistent_cache (pre * k)= map[k];
+    }
+    persistent_compact (dir, pre, map);
+  }
+}
+
+/******************************************************************************
+* Hashmaps on disk, as stored by older versions
 ******************************************************************************/
 
 void
@@ -94,105 +256,30 @@ persistent_read_map (url file) {
   return map;
 }
 
-/******************************************************************************
-* Cache management subroutines
-******************************************************************************/
-
-string
-local_prefix (url dir) {
-  string name= as_string (dir);
-  if (!persistent_pre->contains (name)) {
-    string prefix= as_string (N (persistent_pre) + 1) * ":";
-    persistent_pre (name)= prefix;
-    if (!is_directory (dir)) mkdir (dir);
-    if (!is_directory (dir * url ("_"))) mkdir (dir * url ("_"));
-  }
-  return persistent_pre [name];
-}
-
-void
-persistent_init_key (url dir, string key) {
-  string v= local_prefix (dir) * key;
-  if (!persistent_file->contains (v)) {
-    persistent_file (v)= dir;
-    persistent_hash (v)= (unsigned int) hash (key);
-  }
-}
-
-void
-persistent_update_key (url dir, string key, url file, unsigned int code) {
-  unsigned int ncode= code / MAX_BRANCH;
-  unsigned int mcode= code % MAX_BRANCH;
-  url nfile= file * url (string ((char) (97 + mcode)));
-  string v= local_prefix (dir) * key;
-  persistent_file (v)= nfile;
-  persistent_hash (v)= ncode;
-}
-
-/******************************************************************************
-* Storing in cache
-******************************************************************************/
-
-int
-total_size (hashmap<string,string> map) {
-  int sum= 0;
-  iterator<string> it= iterate (map);
-  while (it->busy ()) {
-    string key= it->next ();
-    sum += N(key) + N(map[key]);
-  }
-  return sum;
-}
-
-void
-persistent_write (url dir, string key, string val,
-                  url file, unsigned int code)
+static bool
+persistent_retrieve (url dir, string key, url file, unsigned int code,
+                     string& val)
 {
-  string v= local_prefix (dir) * key;
   if (is_directory (file)) {
+    string v= local_prefix (dir) * key;
     persistent_update_key (dir, key, file, code);
-    persistent_write (dir, key, val,
-                      persistent_file [v], persistent_hash [v]);
+    return persistent_retrieve (dir, key, persistent_file [v],
+                                persistent_hash [v], val);
   }
-  else {
-    hashmap<string,string> map ("");
-    if (is_regular (file))
-      map= persistent_read_map (file);
-    map (key)= val;
-    if (code == 0 || (N (map) <= MAX_INNER && total_size (map) <= MAX_SIZE))
-      persistent_write_map (file, map);
-    else {
-      remove (file);
-      mkdir (file);
-      iterator<string> it= iterate (map);
-      while (it->busy ()) {
-        string skey= it->next ();
-        string sval= map [skey];
-        string sv  = local_prefix (dir) * skey;
-        unsigned int scode= persistent_hash [sv];
-        persistent_write (dir, skey, sval, file, scode);
-      }
+  else if (is_regular (file)) {
+    hashmap<string,string> map= persistent_read_map (file);
+    if (map->contains (key)) {
+      val= map [key];
+      return true;
     }
   }
+  return false;
 }
 
-void
-persistent_set (url dir, string key, string val) {
-  string v= local_prefix (dir) * key;
-  persistent_init_key (dir, key);
-  persistent_write (dir, key, val, persistent_file [v], persistent_hash [v]);
-  persistent_has   (v)= true;
-  persistent_cache (v)= val;
-}
-
-/******************************************************************************
-* Removing from cache
-******************************************************************************/
-
-void
+static void
 persistent_remove (url dir, string key, url file, unsigned int code) {
-  string v= local_prefix (dir) * key;
   if (is_directory (file)) {
+    string v= local_prefix (dir) * key;
     persistent_update_key (dir, key, file, code);
     persistent_remove (dir, key, persistent_file [v], persistent_hash [v]);
   }
@@ -205,55 +292,56 @@ persistent_remove (url dir, string key, url file, unsigned int code) {
   }
 }
 
-void
-persistent_reset (url dir, string key) {
-  string v= local_prefix (dir) * key;
-  persistent_init_key (dir, key);
-  persistent_remove (dir, key, persistent_file [v], persistent_hash [v]);
-  persistent_has (v)= false;
-  persistent_cache->reset (v);
-}
-
 /******************************************************************************
-* Retrieving from cache
+* Interface
 ******************************************************************************/
 
+static void
+persistent_lookup (url dir, string key) {
+  // pairs which are not in the store may still be stored in the old format
+  string pre= local_prefix (dir), v= pre * key;
+  if (persistent_has->contains (v)) return;
+  string val;
+  persistent_has (v)= false;
+  if (!persistent_old [pre]) return;
+  persistent_init_key (dir, key);
+  if (persistent_retrieve (dir, key, persistent_file [v],
+                           persistent_hash [v], val))
+    persistent_set (dir, key, val);
+}
+
 void
-persistent_retrieve (url dir, string key, url file, unsigned int code) {
+persistent_set (url dir, string key, string val) {
   string v= local_prefix (dir) * key;
-  if (is_directory (file)) {
-    persistent_update_key (dir, key, file, code);
-    persistent_retrieve (dir, key, persistent_file [v], persistent_hash [v]);
-  }
-  else if (is_regular (file)) {
-    hashmap<string,string> map= persistent_read_map (file);
-    if (map->contains (key)) {
-      persistent_cache (v)= map [key];
-      persistent_has   (v)= true;
-    }
-    else persistent_has (v)= false;
+  if (persistent_has [v] && persistent_cache [v] == val) return;
+  persistent_has   (v)= true;
+  persistent_cache (v)= val;
+  persistent_append (dir, key, val, false);
+}
+
+void
+persistent_reset (url dir, string key) {
+  string pre= local_prefix (dir), v= pre * key;
+  if (persistent_old [pre]) {
+    persistent_init_key (dir, key);
+    persistent_remove (dir, key, persistent_file [v], persistent_hash [v]);
   }
-  else persistent_has (v)= false;
+  bool had= persistent_has [v];
+  persistent_has (v)= false;
+  persistent_cache->reset (v);
+  if (had) persistent_append (dir, key, "", true);
 }
 
 bool
 persistent_contains (url dir, string key) {
-  string v= local_prefix (dir) * key;
-  if (!persistent_has->contains (v)) {
-    persistent_init_key (dir, key);
-    persistent_retrieve (dir, key, persistent_file [v], persistent_hash [v]);
-  }
-  return persistent_has [v];
+  persistent_lookup (dir, key);
+  return persistent_has [local_prefix (dir) * key];
 }
 
 string
 persistent_get (url dir, string key) {
-  string v= local_prefix (dir) * key;
-  if (!persistent_has->contains (v)) {
-    persistent_init_key (dir, key);
-    persistent_retrieve (dir, key, persistent_file [v], persistent_hash [v]);
-  }
-  return persistent_cache [v];
+  persistent_lookup (dir, key);
+  return persistent_cache [local_prefix (dir) * key];
 }
 
 /******************************************************************************
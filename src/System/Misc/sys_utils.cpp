@@ -13,6 +13,7 @@
 #include "file.hpp"
 #include "tree.hpp"
 #include "parse_string.hpp"
+#include "hashmap.hpp"
 
 #ifdef OS_MINGW
 #include "Qt/qt_sys_utils.hpp"
@@ -20,6 +21,7 @@
 #include "Windows/win-utf8-compat.hpp"
 #else
 #include "Unix/unix_sys_utils.hpp"
+#include <sys/resource.h>
 #endif
 
 int script_status = 1;
@@ -81,6 +83,17 @@ var_eval_system (string s) {
   return r;
 }
 
+static hashmap<string,string> eval_system_cache ("");
+
+string
+cached_eval_system (string s) {
+  // for commands which only query the installation, such as 'which',
+  // whose results do not change during a session
+  if (!eval_system_cache->contains (s))
+    eval_system_cache (s)= var_eval_system (s);
+  return eval_system_cache [s];
+}
+
 string
 get_env (string var) {
   c_string _var (var);
@@ -108,6 +121,32 @@ set_env (string var, string with) {
 #endif
 }
 
+int
+peak_memory () {
+  // the maximal resident set size of TeXmacs in kilobytes (0 if unknown)
+#if defined (OS_MINGW)
+  return 0;
+#else
+  struct rusage usage;
+  if (getrusage (RUSAGE_SELF, &usage) != 0) return 0;
+#ifdef __APPLE__
+  return (int) (usage.ru_maxrss / 1024);
+#else
+  return (int) usage.ru_maxrss;
+#endif
+#endif
+}
+
+string
+memory_report () {
+  // the memory in use by subsystem, as comma separated values
+  string r= "subsystem,bytes\n";
+  for (int i=0; i<MEM_TAGS; i++)
+    r << mem_tag_name (i) << "," << as_string (mem_tagged (i)) << "\n";
+  r << "total," << as_string (mem_used ()) << "\n";
+  return r;
+}
+
 url
 get_texmacs_path () {
   string tmpath= get_env ("TEXMACS_PATH");
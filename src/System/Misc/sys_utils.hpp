@@ -22,9 +22,12 @@ int    system (string s, string &r);
 int    system (string s, string &r, string& e);
 string eval_system (string s);
 string var_eval_system (string s);
+string cached_eval_system (string s);
 string get_env (string var);
 void   set_env (string var, string with);
 int    os_version ();
+int    peak_memory ();
+string memory_report ();
 string get_stacktrace (unsigned int max_frames= 127);
 
 url get_texmacs_path ();
@@ -106,6 +106,12 @@
 /* Disable fast memory allocator */
 #cmakedefine NO_FAST_ALLOC 1
 
+/* Disable thread local caches in the fast memory allocator */
+#cmakedefine NO_THREAD_SAFE_ALLOC 1
+
+/* Use atomic reference counts for trees, strings and arrays */
+#cmakedefine ATOMIC_REF_COUNT 1
+
 /* Use g++ strictly prior to g++ 3.0 */
 #cmakedefine OLD_GNU_COMPILER 1
 
@@ -18,6 +18,7 @@
 #include "dictionary.hpp"
 #include "new_document.hpp"
 #include "merge_sort.hpp"
+#include "data_cache.hpp"
 
 array<tm_buffer> bufs;
 
@@ -394,6 +395,7 @@ pretend_buffer_saved (url name) {
   for (int i=0; i<N(vs); i++)
     view_to_editor (vs[i]) -> notify_save ();
   set_last_save_buffer (name, last_modified (name));
+  start_buffer_journal (name);
 }
 
 void
@@ -405,6 +407,65 @@ pretend_buffer_autosaved (url name) {
     view_to_editor (vs[i]) -> notify_save (false);
 }
 
+/******************************************************************************
+* Journals of the modifications since the last save
+******************************************************************************/
+
+static url
+buffer_journal_file (url name) {
+  return glue (name, "~j");
+}
+
+static bool
+journal_eligible (url name) {
+  return get_preference ("autosave journal", "on") == "on" &&
+         is_rooted (name, "default") && !is_scratch (name) &&
+         file_format (name) == "texmacs";
+}
+
+void
+start_buffer_journal (url name) {
+  // the journal is always relative to the saved version of the buffer
+  tm_buffer buf= concrete_buffer (name);
+  if (is_nil (buf)) return;
+  if (buf->jour != NULL) buf->jour->reset ();
+  else if (journal_eligible (name))
+    buf->jour= tm_new<journal_rep> (buffer_journal_file (name), buf->rp);
+}
+
+bool
+buffer_journaled (url name) {
+  tm_buffer buf= concrete_buffer (name);
+  return !is_nil (buf) && buf->jour != NULL;
+}
+
+void
+flush_buffer_journal (url name) {
+  tm_buffer buf= concrete_buffer (name);
+  if (!is_nil (buf) && buf->jour != NULL) buf->jour->flush ();
+}
+
+bool
+buffer_recoverable (url name) {
+  url u= buffer_journal_file (name);
+  return journal_eligible (name) && exists (u) && is_newer (u, name);
+}
+
+bool
+buffer_recover (url name) {
+  // load the saved version of the buffer and replay the journal on top of it
+  list<modification> mods= load_journal (buffer_journal_file (name));
+  if (buffer_load (name)) return true;
+  tm_buffer buf= concrete_buffer (name);
+  if (is_nil (buf)) return true;
+  for (; !is_nil (mods); mods= mods->next) {
+    if (!is_applicable (subtree (the_et, buf->rp), mods->item)) break;
+    apply (the_et, buf->rp * mods->item);
+  }
+  pretend_buffer_modified (name);
+  return false;
+}
+
 void
 attach_buffer_notifier (url name) {
   tm_buffer buf= concrete_buffer (name);
@@ -412,6 +473,20 @@ attach_buffer_notifier (url name) {
   buf->attach_notifier ();
 }
 
+/******************************************************************************
+* Snapshots for background tasks
+******************************************************************************/
+
+tree
+buffer_snapshot (url name) {
+  // the buffer is copied only once; the unmodified subtrees are shared
+  // between successive snapshots, which should not be modified
+  tm_buffer buf= concrete_buffer (name);
+  if (is_nil (buf)) return "";
+  if (buf->snap == NULL) buf->snap= tm_new<snapshot_rep> (buf->rp);
+  return buf->snap->get ();
+}
+
 /******************************************************************************
 * Loading
 ******************************************************************************/
@@ -434,6 +509,13 @@ attach_subformat (tree t, url u, string fm) {
   return change_doc_attr (t, "initial", make_collection (h));
 }
 
+static void
+register_links (tree t, url u) {
+  tree links= extract (t, "links");
+  if (N (links) != 0)
+    (void) call ("register-link-locations", object (u), object (links));
+}
+
 tree
 import_loaded_tree (string s, url u, string fm) {
   set_file_focus (u);
@@ -442,9 +524,7 @@ import_loaded_tree (string s, url u, string fm) {
   if (fm == "texmacs" && starts (s, "(document (TeXmacs")) fm= "stm";
   if (fm == "verbatim" && starts (s, "(document (TeXmacs")) fm= "stm";
   tree t= generic_to_tree (s, fm * "-document");
-  tree links= extract (t, "links");
-  if (N (links) != 0)
-    (void) call ("register-link-locations", object (u), object (links));
+  register_links (t, u);
   return attach_subformat (t, u, fm);
 }
 
@@ -452,9 +532,20 @@ tree
 import_tree (url u, string fm) {
   u= resolve (u, "fr");
   set_file_focus (u);
+  if (is_none (u)) return "error";
+  // documentation is read often and rarely modified, so that
+  // we keep binary copies of the parsed documents
+  bool cache_flag= (fm == "texmacs" && do_cache_doc (concretize (u)));
+  tree t;
+  if (cache_flag && cache_tree_load (u, t)) {
+    register_links (t, u);
+    return t;
+  }
   string s;
-  if (is_none (u) || load_string (u, s, false)) return "error";
-  return import_loaded_tree (s, u, fm);
+  if (load_string (u, s, false)) return "error";
+  t= import_loaded_tree (s, u, fm);
+  if (cache_flag && is_document (t)) cache_tree_save (u, t);
+  return t;
 }
 
 bool
@@ -482,10 +573,16 @@ load_style_tree (string package) {
   if (ends (package, ".ts")) name= package;
   else name= styp * (package * ".ts");
   name= resolve (name);
-  string doc_s;
-  if (!load_string (name, doc_s, false)) {
-    tree doc= texmacs_document_to_tree (doc_s);
+  tree doc;
+  if (!is_none (name) && cache_tree_load (name, doc)) {
+    style_tree_cache (package)= doc;
+    return doc;
+  }
+  mapped_string doc_s;
+  if (!load_mapped (name, doc_s, false)) {
+    doc= texmacs_document_to_tree (doc_s);
     if (is_compound (doc)) doc= extract (doc, "body");
+    if (!is_func (doc, ERROR)) cache_tree_save (name, doc);
     style_tree_cache (package)= doc;
     return doc;
   }
@@ -49,12 +49,17 @@ CONCRETE(new_buffer);
 
 inline new_buffer::new_buffer (const new_buffer& x):
   rep(x.rep) { INC_COUNT (this->rep); }
-inline new_buffer::~new_buffer () { DEC_COUNT (this->rep); }
+inline new_buffer::new_buffer (new_buffer&& x):
+  rep(x.rep) { x.rep= NULL; }
+inline new_buffer::~new_buffer () { DEC_COUNT_NULL (this->rep); }
 inline new_buffer_rep* new_buffer::operator -> () {
   return rep; }
-inline new_buffer& new_buffer::operator = (new_buffer x) {
-  INC_COUNT (x.rep); DEC_COUNT (this->rep);
-  this->rep=x.rep; return *this; }
+inline new_buffer& new_buffer::operator = (const new_buffer& x) {
+  new_buffer_rep* r= x.rep; INC_COUNT (r); DEC_COUNT_NULL (this->rep);
+  this->rep= r; return *this; }
+inline new_buffer& new_buffer::operator = (new_buffer&& x) {
+  new_buffer_rep* r= this->rep; this->rep= x.rep;
+  x.rep= r; return *this; }
 
 /******************************************************************************
 * Low level types and routines
@@ -95,7 +100,13 @@ bool buffer_modified_since_autosave (url name);
 void pretend_buffer_modified (url name);
 void pretend_buffer_saved (url name);
 void pretend_buffer_autosaved (url name);
+void start_buffer_journal (url name);
+bool buffer_journaled (url name);
+void flush_buffer_journal (url name);
+bool buffer_recoverable (url name);
+bool buffer_recover (url name);
 void attach_buffer_notifier (url name);
+tree buffer_snapshot (url name);
 bool buffer_has_name (url name);
 bool buffer_import (url name, url src, string fm);
 bool buffer_load (url name);
@@ -81,6 +81,16 @@ apply_wildcards (string s, hashmap<string,tree> w) {
   return s;
 }
 
+static string
+apply_wildcards (string s, hashmap<string,tree> w,
+                 hashmap<string,string>& cache)
+{
+  // The rewritings are looked up on each keystroke and for each binding,
+  // so we remember them until the next change of the wildcards
+  if (!cache->contains (s)) cache (s)= apply_wildcards (s, w);
+  return cache [s];
+}
+
 void
 tm_config_rep::insert_kbd_wildcard (
   string key, string im, bool post, bool l, bool r)
@@ -89,8 +99,14 @@ tm_config_rep::insert_kbd_wildcard (
   tree t= tuple (im,
 		 l? string ("*"): string (""),
 		 r? string ("*"): string (""));
-  if (post) post_kbd_wildcards (key)= t;
-  else pre_kbd_wildcards (key)= t;
+  if (post) {
+    post_kbd_wildcards (key)= t;
+    post_kbd_cache= hashmap<string,string> ();
+  }
+  else {
+    pre_kbd_wildcards (key)= t;
+    pre_kbd_cache= hashmap<string,string> ();
+  }
 }
 
 /******************************************************************************
@@ -104,7 +120,7 @@ tm_config_rep::set_variant_keys (string var, string unvar) {
 }
 
 #define rewrite_find_key_binding(s) \
-  find_key_binding (apply_wildcards (s, post_kbd_wildcards))
+  find_key_binding (apply_wildcards (s, post_kbd_wildcards, post_kbd_cache))
 
 void
 tm_config_rep::variant_simplification (string& which) {
@@ -140,13 +156,13 @@ tm_config_rep::find_key_binding (string key) {
 
 string
 tm_config_rep::kbd_pre_rewrite (string s) {
-  return apply_wildcards (s, pre_kbd_wildcards);
+  return apply_wildcards (s, pre_kbd_wildcards, pre_kbd_cache);
 }
 
 string
 tm_config_rep::kbd_post_rewrite (string s, bool var_flag) {
   if (var_flag) variant_simplification (s);
-  return apply_wildcards (s, post_kbd_wildcards);
+  return apply_wildcards (s, post_kbd_wildcards, post_kbd_cache);
 }
 
 void
@@ -157,7 +173,7 @@ tm_config_rep::get_keycomb (
   if (DEBUG_KEYBOARD) debug_keyboard << which;
   variant_simplification (which);
   if (DEBUG_KEYBOARD) debug_keyboard << " -> " << which;
-  string rew= apply_wildcards (which, post_kbd_wildcards);
+  string rew= apply_wildcards (which, post_kbd_wildcards, post_kbd_cache);
   bool no_var= false;
   if (rew * var_suffix == orig) {
     no_var= true;
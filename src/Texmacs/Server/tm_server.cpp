@@ -15,6 +15,7 @@
 #include "convert.hpp"
 #include "connect.hpp"
 #include "sys_utils.hpp"
+#include "background.hpp"
 #include "file.hpp"
 #include "analyze.hpp"
 #include "dictionary.hpp"
@@ -22,6 +23,7 @@
 #include "socket_notifier.hpp"
 #include "new_style.hpp"
 #include "Database/database.hpp"
+#include "metric_cache.hpp"
 
 server* the_server= NULL;
 bool texmacs_started= false;
@@ -141,6 +143,30 @@ tm_server_rep::refresh () {
   }
 }
 
+/******************************************************************************
+* Memory management for views which are not displayed
+******************************************************************************/
+
+#define RELEASE_DELAY   600000 // free views not visited for ten minutes
+#define RELEASE_CHECK    10000 // but only look for them every ten seconds
+
+static void
+release_hidden_views () {
+  static time_t last_check= texmacs_time ();
+  time_t now= texmacs_time ();
+  if (now - last_check < RELEASE_CHECK) return;
+  last_check= now;
+  for (int i=0; i<N(bufs); i++) {
+    tm_buffer buf= (tm_buffer) bufs[i];
+    if (now - buf->buf->last_visit < RELEASE_DELAY) continue;
+    for (int j=0; j<N(buf->vws); j++) {
+      tm_view vw= (tm_view) buf->vws[j];
+      if (vw->win == NULL && !vw->ed->typeset_released ())
+        vw->ed->typeset_release ();
+    }
+  }
+}
+
 void
 tm_server_rep::interpose_handler () {
 #ifdef QTTEXMACS
@@ -154,6 +180,7 @@ tm_server_rep::interpose_handler () {
   perform_select ();
   exec_pending_commands ();
 #endif
+  background_poll ();
 
   int i, j;
   for (i=0; i<N(bufs); i++) {
@@ -170,6 +197,8 @@ tm_server_rep::interpose_handler () {
     }
   }
 
+  release_hidden_views ();
+
   windows_refresh ();
   sync_databases ();
 }
@@ -251,6 +280,7 @@ tm_server_rep::is_yes (string s) {
 void
 tm_server_rep::quit () {
   close_all_pipes ();
+  save_metric_caches ();
   call ("quit-TeXmacs-scheme");
   clear_pending_commands ();
 #ifdef QTTEXMACS
@@ -25,6 +25,7 @@
 #include "server.hpp"
 #include "tm_timer.hpp"
 #include "data_cache.hpp"
+#include "convert.hpp"
 #include "tm_window.hpp"
 #ifdef AQUATEXMACS
 void mac_fix_paths ();
@@ -219,6 +220,14 @@ TeXmacs_main (int argc, char** argv) {
       else if (s == "-debug-events") debug (DEBUG_FLAG_EVENTS, true);
       else if (s == "-debug-io") debug (DEBUG_FLAG_IO, true);
       else if (s == "-debug-bench") debug (DEBUG_FLAG_BENCH, true);
+      else if (s == "-debug-profile") {
+        debug (DEBUG_FLAG_BENCH, true);
+        profile_start ();
+      }
+      else if (s == "-debug-latency") {
+        debug (DEBUG_FLAG_BENCH, true);
+        latency_start (50);
+      }
       else if (s == "-debug-history") debug (DEBUG_FLAG_HISTORY, true);
       else if (s == "-debug-qt") debug (DEBUG_FLAG_QT, true);
       else if (s == "-debug-qt-widgets") debug (DEBUG_FLAG_QT_WIDGETS, true);
@@ -337,6 +346,23 @@ TeXmacs_main (int argc, char** argv) {
         i++;
         if (i<argc) my_init_cmds= (my_init_cmds * " ") * argv[i];
       }
+      else if (s == "-batch") {
+        // convert all jobs of a file, or of the standard input for "-",
+        // in a single process
+        i++;
+        if (i<argc)
+          my_init_cmds= my_init_cmds * " " *
+            "(batch-convert " * scm_quote (argv[i]) * ")";
+      }
+      else if (s == "-raster") {
+        // export pages as images, see also immediate_options
+        i+=4;
+        if (i<argc)
+          my_init_cmds= my_init_cmds * " " *
+            "(raster-export " * scm_quote (argv[i-3]) * " " *
+            scm_quote (argv[i-2]) * " " * scm_quote (argv[i-1]) * " " *
+            scm_quote (argv[i]) * ")";
+      }
       else if (s == "-server") start_server_flag= true;
       else if (s == "-log-file") i++;
       else if ((s == "-Oc") || (s == "-no-char-clipping")) char_clip= false;
@@ -367,6 +393,9 @@ TeXmacs_main (int argc, char** argv) {
         cout << "Options for TeXmacs:\n\n";
         cout << "  -b [file]  Specify scheme buffers initialization file\n";
         cout << "  -c [i] [o] Convert file 'i' into file 'o'\n";
+        cout << "  -batch [f] Convert the files listed in 'f' ('-' for stdin)\n";
+        cout << "  -raster [i] [o] [dpi] [pages]\n";
+        cout << "             Export 'pages' of 'i' as images 'o' at 'dpi'\n";
         cout << "  -d         For debugging purposes\n";
         cout << "  -fn [font] Set the default TeX font\n";
         cout << "  -g [geom]  Set geometry of window in pixels\n";
@@ -433,8 +462,10 @@ TeXmacs_main (int argc, char** argv) {
   init_mac_application ();
 #endif
     
+  bench_start ("initialize display");
   gui_open (argc, argv);
   set_default_font (the_default_font);
+  bench_cumul ("initialize display");
   if (DEBUG_STD) debug_boot << "Starting server...\n";
   { // opening scope for server sv
   server sv;
@@ -460,12 +491,13 @@ TeXmacs_main (int argc, char** argv) {
       exec_delayed (scheme_cmd (cmd));
     }
     if      ((s == "-c") || (s == "-convert")) i+=2;
+    else if (s == "-raster") i+=4;
     else if ((s == "-b") || (s == "-initialize-buffer") ||
              (s == "-fn") || (s == "-font") ||
              (s == "-i") || (s == "-initialize") ||
              (s == "-g") || (s == "-geometry") ||
              (s == "-x") || (s == "-execute") ||
-             (s == "-log-file") ||
+             (s == "-batch") || (s == "-log-file") ||
              (s == "-build-manual") ||
              (s == "-reference-suite") || (s == "-test-suite")) i++;
   }
@@ -492,6 +524,8 @@ TeXmacs_main (int argc, char** argv) {
   bench_reset ("initialize texmacs");
   bench_reset ("initialize plugins");
   bench_reset ("initialize scheme");
+  bench_reset ("initialize display");
+  reset_boot_timings ();
 
   if (DEBUG_STD) debug_boot << "Starting event loop...\n";
   texmacs_started= true;
@@ -500,6 +534,9 @@ TeXmacs_main (int argc, char** argv) {
   release_boot_lock ();
   if (N(extra_init_cmd) > 0) exec_delayed (scheme_cmd (extra_init_cmd));
   gui_start_loop ();
+  if (DEBUG_BENCH) print_conversion_statistics ();
+  if (DEBUG_BENCH && profile_on) profile_print ();
+  if (DEBUG_BENCH && latency_on) latency_print ();
 
   if (DEBUG_STD) debug_boot << "Stopping server...\n";
   } // ending scope for server sv
@@ -587,6 +624,11 @@ immediate_options (int argc, char** argv) {
     }
     else if (s == "-delete-cache")
       remove (url ("$TEXMACS_HOME_PATH/system/cache") * url_wildcard ("*"));
+#ifdef QTTEXMACS
+    else if (s == "-raster" && get_env ("QT_QPA_PLATFORM") == "")
+      // pictures are rendered in software, so no display is needed
+      set_env ("QT_QPA_PLATFORM", "offscreen");
+#endif
     else if (s == "-delete-style-cache")
       remove (url ("$TEXMACS_HOME_PATH/system/cache") * url_wildcard ("__*"));
     else if (s == "-delete-font-cache") {
@@ -618,7 +660,8 @@ immediate_options (int argc, char** argv) {
     else if (s == "-log-file" && i + 1 < argc) {
       i++;
       char* log_file = argv[i];
-      tm_ostream logf (log_file);
+      // flushed at each line, so that the log survives crashes
+      tm_ostream logf= file_ostream (log_file, 65536, true);
       if (!logf->is_writable ())
         cerr << "TeXmacs] Error: could not open " << log_file << "\n";
       cout.redirect (logf);
@@ -352,6 +352,7 @@ tm_window_rep::unmap () {
 
 void
 tm_window_rep::refresh () {
+  menu_current= hashmap<int,object> (object ());
   menu_cache= hashmap<object,widget> (widget ());
 }
 
@@ -360,6 +361,7 @@ tm_window_rep::refresh () {
 ******************************************************************************/
 
 bool menu_caching= true;
+#define MENU_CACHE_MAX 1024
 
 bool
 tm_window_rep::get_menu_widget (int which, string menu, widget& w) {
@@ -371,9 +373,10 @@ tm_window_rep::get_menu_widget (int which, string menu, widget& w) {
   object xmenu= call ("menu-expand", eval ("'" * menu));
   the_drd= old_drd;
   //cout << "xmenu= " << xmenu << "\n";
+  // the most frequent case is an unchanged cached menu, for which we even
+  // avoid the computation of the hash code of the expanded menu
+  if (menu_current[which] == xmenu) return false;
   if (menu_cache->contains (xmenu)) {
-    //if (menu_current[which] == xmenu) cout << "Same " << menu << "\n";
-    if (menu_current[which] == xmenu) return false;
     menu_current (which)= xmenu;
     //cout << "Cached " << menu << "\n";
     w= menu_cache [xmenu];
@@ -384,8 +387,14 @@ tm_window_rep::get_menu_widget (int which, string menu, widget& w) {
   object umenu= eval ("'" * menu);
   w= make_menu_widget (umenu);
   if (menu_caching)
-    if (as_bool (call ("cache-menu?", xmenu)))
+    if (as_bool (call ("cache-menu?", xmenu))) {
+      if (N (menu_cache) >= MENU_CACHE_MAX)
+        menu_cache= hashmap<object,widget> (widget ());
       menu_cache (xmenu)= w;
+      return true;
+    }
+  // menus which are not cached are recomputed, even if they did not change
+  menu_current (which)= object ();
   return true;
 }
 
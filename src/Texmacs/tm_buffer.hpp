@@ -12,6 +12,8 @@
 #ifndef TM_BUFFER_H
 #define TM_BUFFER_H
 #include "new_data.hpp"
+#include "journal.hpp"
+#include "snapshot.hpp"
 #include "Data/new_buffer.hpp"
 
 class tm_buffer_rep;
@@ -35,12 +37,17 @@ public:
   path rp;                // path to the document's root in the_et
   link_repository lns;    // global links
   bool notify;            // notify modifications to scheme
+  journal_rep* jour;      // journal of the modifications since the last save
+  snapshot_rep* snap;     // immutable snapshots for background tasks
 
   inline tm_buffer_rep (url name):
     buf (name), data (),
-    vws (0), prj (NULL), rp (new_document ()), notify (false) {}
+    vws (0), prj (NULL), rp (new_document ()), notify (false), jour (NULL),
+    snap (NULL) {}
 
   inline ~tm_buffer_rep () {
+    if (jour != NULL) tm_delete (jour);
+    if (snap != NULL) tm_delete (snap);
     delete_document (rp); }
 
   void attach_notifier ();
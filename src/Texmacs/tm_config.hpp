@@ -21,6 +21,8 @@ protected:
   string unvar_suffix;                      // space + the unvariant key
   hashmap<string,tree> pre_kbd_wildcards;   // wildcards applied to defns
   hashmap<string,tree> post_kbd_wildcards;  // wildcards applied at lookup
+  hashmap<string,string> pre_kbd_cache;     // results of pre rewritings
+  hashmap<string,string> post_kbd_cache;    // results of post rewritings
   hashmap<string,tree> system_kbd_decode;   // for printing of shortcuts
 
 public:
@@ -12,6 +12,7 @@
 #include "Boxes/composite.hpp"
 #include "Boxes/construct.hpp"
 #include "file.hpp"
+#include "gui.hpp"
 #include "player.hpp"
 #include "Files/image_files.hpp"
 
@@ -58,19 +59,89 @@ struct composite_anim_box_rep: public composite_box_rep {
 ******************************************************************************/
 
 struct anim_constant_box_rep: public composite_anim_box_rep {
+  int     animated;  // -1 if not yet known whether the content has duration
+  picture pic;       // pre-rendered frame
+  double  pic_zoom;  // zoom factor for which the frame was rendered
   anim_constant_box_rep (path ip, box b, player pl, int length);
+  ~anim_constant_box_rep ();
   operator tree () { return tree (TUPLE, "anim_constant", (tree) bs[0]); }
+  void redraw (renderer ren, path p, rectangles& l);
 };
 
 anim_constant_box_rep::anim_constant_box_rep (path ip, box b, player pl,
                                               int length2):
-  composite_anim_box_rep (ip, pl, (double) length2)
+  composite_anim_box_rep (ip, pl, (double) length2),
+  animated (-1), pic_zoom (0.0)
 {
   insert (b, 0, 0);
   position ();
   finalize ();
 }
 
+/******************************************************************************
+* Pre-rendering the frames of animations
+******************************************************************************/
+
+#define ANIM_CACHE_MAX (1 << 24)
+
+static long anim_cached_pixels= 0;  // total size of the pre-rendered frames
+extern int nr_painted;
+
+static long
+picture_size (picture pic) {
+  return is_nil (pic)? 0: ((long) pic->get_width ()) * pic->get_height ();
+}
+
+anim_constant_box_rep::~anim_constant_box_rep () {
+  anim_cached_pixels -= picture_size (pic);
+}
+
+void
+anim_constant_box_rep::redraw (renderer ren, path p, rectangles& l) {
+  // frames of animations are often displayed repeatedly, so that we keep
+  // a picture of frames with static content for screen rendering;
+  // sounds have no duration, but remain pending until they have been played
+  if (animated == -1) animated= bs[0]->anim_duration () != 0.0? 1: 0;
+  if (!ren->is_screen || animated == 1 || !is_nil (p) ||
+      bs[0]->anim_next () < 1.0e12) {
+    composite_anim_box_rep::redraw (ren, p, l);
+    return;
+  }
+  if (!is_nil (pic) && pic_zoom != ren->zoomf) {
+    anim_cached_pixels -= picture_size (pic);
+    pic= picture ();
+  }
+  if (is_nil (pic) && anim_cached_pixels >= ANIM_CACHE_MAX) {
+    composite_anim_box_rep::redraw (ren, p, l);
+    return;
+  }
+  ren->move_origin (x0, y0);
+  SI delta= ren->retina_pixel;
+  if (ren->is_visible (x3- delta, y3- delta, x4+ delta, y4+ delta)) {
+    l= rectangles ();
+    pre_display (ren);
+    if (is_nil (pic)) {
+      picture frame;
+      renderer shad= ren->shadow (frame, sx3(0), sy3(0), sx4(0), sy4(0));
+      shad->set_clipping (sx3(0), sy3(0), sx4(0), sy4(0));
+      rectangles rs;
+      bs[0]->redraw (shad, path (), rs);
+      delete_renderer (shad);
+      if (((nr_painted&15) != 15) || !gui_interrupted (true)) {
+        pic= frame;
+        pic_zoom= ren->zoomf;
+        anim_cached_pixels += picture_size (pic);
+      }
+    }
+    if (!is_nil (pic)) {
+      ren->draw_picture (pic, 0, 0);
+      l= rectangle (x3+ ren->ox, y3+ ren->oy, x4+ ren->ox, y4+ ren->oy);
+    }
+    post_display (ren);
+  }
+  ren->move_origin (-x0, -y0);
+}
+
 /******************************************************************************
 * Compositions of animations
 ******************************************************************************/
@@ -380,6 +380,14 @@ box_rep::find_limits (path bp, point& lim1, point& lim2) {
   }
 }
 
+bool
+box_rep::graphical_bounds (SI& X1, SI& Y1, SI& X2, SI& Y2) {
+  // a rectangle outside which the box can neither be selected nor snapped
+  // to; boxes which cannot guarantee such a rectangle return false
+  (void) X1; (void) Y1; (void) X2; (void) Y2;
+  return false;
+}
+
 SI
 box_rep::graphical_distance (SI x, SI y) {
   SI dx, dy;
@@ -541,6 +549,30 @@ box_rep::reindex (int i, int item, int n) {
   return n-i;
 }
 
+bool
+box_rep::find_visible (SI x1, SI y1, SI x2, SI y2, array<int>& ks) {
+  // boxes with a spatial index return the children whose ink
+  // extents meet the rectangle, in increasing order
+  (void) x1; (void) y1; (void) x2; (void) y2; (void) ks;
+  return false;
+}
+
+static array<int>
+redraw_order (array<int> ks, int c) {
+  // order the children ks as reindex does, that is, by increasing distance
+  // to the child c, and to the left of c first in case of equal distances
+  int n= N(ks), j= 0;
+  while (j < n && ks[j] < c) j++;
+  array<int> r (n);
+  int l= j-1, k= 0;
+  while (l >= 0 || j < n) {
+    if (j < n && (ks[j] == c || l < 0 || ks[j] - c < c - ks[l]))
+      r[k++]= ks[j++];
+    else r[k++]= ks[l--];
+  }
+  return r;
+}
+
 void
 box_rep::redraw (renderer ren, path p, rectangles& l) {
   if ((nr_painted&15) == 15 && ren->is_screen && gui_interrupted (true)) return;
@@ -553,10 +585,18 @@ box_rep::redraw (renderer ren, path p, rectangles& l) {
     
     int i, item=-1, n=subnr (), i1= n, i2= -1;
     if (!is_nil(p)) i1= i2= item= p->item;
-    for (i=0; i<n; i++) {
-      int k= reindex (i, item, n-1);
+    array<int> ks;
+    bool indexed= find_visible (ren->cx1- ren->ox- delta,
+                                ren->cy1- ren->oy- delta,
+                                ren->cx2- ren->ox+ delta,
+                                ren->cy2- ren->oy+ delta, ks);
+    if (indexed) ks= redraw_order (ks, reindex (0, item, n-1));
+    int nr= indexed? N(ks): n;
+    for (i=0; i<nr; i++) {
+      int k= indexed? ks[i]: reindex (i, item, n-1);
+      bool first= indexed? k == reindex (0, item, n-1): i == 0;
       if (is_nil(p)) subbox (k)->redraw (ren, path (), ll);
-      else if (i!=0) {
+      else if (!first) {
         if (k > item) subbox(k)->redraw (ren, path (0), ll);
         else subbox(k)->redraw (ren, path (subbox(k)->subnr()-1), ll);
       }
@@ -822,26 +862,30 @@ box_rep::loci (SI x, SI y, SI delta, list<string>& ids, rectangles& rs) {
 
 void
 box_rep::display_links (renderer ren) {
-  if (!is_nil (ip) && ip->item >= 0 && x2 > x1 && y2 > y1) {
-    path p= reverse (ip);
-    while (N(p) > 1) {
+  if (!is_nil (ip) && ip->item >= 0 && x2 > x1 && y2 > y1 &&
+      has_links ("hyperlink")) {
+    // collect the ancestors of the box in one descent from the root
+    array<tree> ts;
+    tree t= the_et;
+    for (path p= reverse (ip); !is_nil (p); p= p->next) {
+      if (is_atomic (t) || p->item < 0 || p->item >= N(t)) break;
+      t= t[p->item];
+      ts << t;
+    }
+    for (int k=N(ts)-1; k>=1; k--) {
       // FIXME: we might want to sort out overlapping and adjacent links
-      if (has_subtree (the_et, p)) {
-        tree t= subtree (the_et, p);
-        list<string> ids= get_ids (t);
-        for (int i=0; i<N(ids); i++) {
-          list<tree> lns= get_links (compound ("id", ids[i]));
-          for (int j=0; j<N(lns); j++)
-            if (is_compound (lns[j], "link", 4) &&
-                lns[j][0] == "hyperlink" &&
-                is_compound (lns[j][3], "url", 1) &&
-                is_atomic (lns[j][3][0])) {
-              string dest= lns[j][3][0]->label;
-              ren->href (dest, x1, y1, x2, y2);
-            }
-        }
+      list<string> ids= get_ids (ts[k]);
+      for (int i=0; i<N(ids); i++) {
+        list<tree> lns= get_links (compound ("id", ids[i]));
+        for (int j=0; j<N(lns); j++)
+          if (is_compound (lns[j], "link", 4) &&
+              lns[j][0] == "hyperlink" &&
+              is_compound (lns[j][3], "url", 1) &&
+              is_atomic (lns[j][3][0])) {
+            string dest= lns[j][3][0]->label;
+            ren->href (dest, x1, y1, x2, y2);
+          }
       }
-      p= path_up (p);
     }
   }
 }
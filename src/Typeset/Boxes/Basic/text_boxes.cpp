@@ -47,6 +47,8 @@ struct text_box_rep: public box_rep {
   xkerning  xk;
 
   text_box_rep (path ip, int pos, string s, font fn, pencil pen, xkerning xk);
+  text_box_rep (path ip, int pos, string s, font fn, pencil pen, metric& ex);
+  void set_extents (metric& ex);
   operator tree () { return str; }
   box adjust_kerning (int mode, double factor);
   box expand_glyphs (int mode, double factor);
@@ -95,6 +97,19 @@ text_box_rep::text_box_rep (path ip, int pos2, string s,
 {
   metric ex;
   fn->get_extents (str, ex);
+  set_extents (ex);
+}
+
+text_box_rep::text_box_rep (path ip, int pos2, string s,
+                            font fn2, pencil p2, metric& ex):
+  box_rep (ip), pos (pos2), str (s), fn (fn2), pen (p2), xk (xkerning ())
+{
+  // for extents which were computed along with those of other strings
+  set_extents (ex);
+}
+
+void
+text_box_rep::set_extents (metric& ex) {
   x1= ex->x1; y1= ex->y1;
   x2= ex->x2; y2= ex->y2;
   x3= ex->x3; y3= ex->y3;
@@ -586,7 +601,29 @@ wide_stix_box (path ip, string s, font fn, pencil pen, SI width) {
   return macro_box (ip, b, fn);
 }
 
+#define TEXT_WORDS_MAX 65536
+#define TEXT_WORD_LENGTH 16
+
+static hashmap<string,string> text_words ("");
+
+static string
+shared_word (string s) {
+  // the many text boxes for the same short word share a single string;
+  // the font, pencil and ip of text boxes are already shared
+  if (N(s) > TEXT_WORD_LENGTH) return s;
+  if (text_words->contains (s)) return text_words[s];
+  if (N(text_words) < TEXT_WORDS_MAX) text_words (s)= s;
+  return s;
+}
+
 box
 text_box (path ip, int pos, string s, font fn, pencil pen) {
-  return tm_new<text_box_rep> (ip, pos, s, fn, pen, xkerning ());
+  string w= shared_word (s);
+  return tm_new<text_box_rep> (ip, pos, w, fn, pen, xkerning ());
+}
+
+box
+text_box (path ip, int pos, string s, font fn, pencil pen, metric& ex) {
+  string w= shared_word (s);
+  return tm_new<text_box_rep> (ip, pos, w, fn, pen, ex);
 }
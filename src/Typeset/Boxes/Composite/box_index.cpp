@@ -0,0 +1,156 @@
+/******************************************************************************
+* MODULE     : box_index.cpp
+* DESCRIPTION: spatial indices over the children of composite boxes
+* COPYRIGHT  : (C) 2020  Joris van der Hoeven
+*******************************************************************************
+* This software falls under the GNU general public license version 3 or later.
+* It comes WITHOUT ANY WARRANTY WHATSOEVER. For details, see the file LICENSE
+* in the root directory or <http://www.gnu.org/licenses/gpl-3.0.html>.
+******************************************************************************/
+
+#include "Boxes/composite.hpp"
+#include "merge_sort.hpp"
+
+/******************************************************************************
+* Construction by sort-tile-recursive packing
+******************************************************************************/
+
+static void
+sort_by (array<int>& ks, array<SI>& center, int start, int end) {
+  // sort ks[start..end) on the centers of the corresponding children
+  int i, n= end - start;
+  array<SI>  c (n);
+  array<int> k (n);
+  for (i=0; i<n; i++) { k[i]= ks[start+i]; c[i]= center[k[i]]; }
+  merge_sort_leq<SI,int,less_eq_operator<SI> > (c, k);
+  for (i=0; i<n; i++) ks[start+i]= k[i];
+}
+
+static box_index_node
+index_node (int start, int end) {
+  box_index_node nd;
+  nd.x1= nd.y1= nd.x3= nd.y3=  MAX_SI;
+  nd.x2= nd.y2= nd.x4= nd.y4= -MAX_SI;
+  nd.start= start;
+  nd.end  = end;
+  return nd;
+}
+
+static void
+enlarge (box_index_node& nd, SI x1, SI y1, SI x2, SI y2,
+         SI x3, SI y3, SI x4, SI y4) {
+  nd.x1= min (nd.x1, x1); nd.y1= min (nd.y1, y1);
+  nd.x2= max (nd.x2, x2); nd.y2= max (nd.y2, y2);
+  nd.x3= min (nd.x3, x3); nd.y3= min (nd.y3, y3);
+  nd.x4= max (nd.x4, x4); nd.y4= max (nd.y4, y4);
+}
+
+box_index_rep::box_index_rep (box_rep* b) {
+  int i, j, n= b->subnr ();
+  array<SI> cx (n), cy (n);
+  child= array<int> (n);
+  for (i=0; i<n; i++) {
+    child[i]= i;
+    cx[i]= (b->sx1 (i) >> 1) + (b->sx2 (i) >> 1);
+    cy[i]= (b->sy1 (i) >> 1) + (b->sy2 (i) >> 1);
+  }
+
+  // group the children into vertical slices of leaves
+  int nr_leaves= (n + BOX_INDEX_FANOUT - 1) / BOX_INDEX_FANOUT;
+  int nr_slices= 1;
+  while (nr_slices * nr_slices < nr_leaves) nr_slices++;
+  int slice= nr_slices * BOX_INDEX_FANOUT;
+  sort_by (child, cx, 0, n);
+  for (i=0; i<n; i+=slice)
+    sort_by (child, cy, i, min (i + slice, n));
+
+  for (i=0; i<n; i+=BOX_INDEX_FANOUT) {
+    box_index_node nd= index_node (i, min (i + BOX_INDEX_FANOUT, n));
+    for (j=nd.start; j<nd.end; j++) {
+      int c= child[j];
+      enlarge (nd, b->sx1 (c), b->sy1 (c), b->sx2 (c), b->sy2 (c),
+               b->sx3 (c), b->sy3 (c), b->sx4 (c), b->sy4 (c));
+    }
+    nodes << nd;
+  }
+  leaves= N(nodes);
+
+  // the upper levels group consecutive nodes of the level below
+  int start= 0, end= leaves;
+  while (end - start > 1) {
+    for (i=start; i<end; i+=BOX_INDEX_FANOUT) {
+      box_index_node nd= index_node (i, min (i + BOX_INDEX_FANOUT, end));
+      for (j=nd.start; j<nd.end; j++) {
+        box_index_node sub= nodes[j];
+        enlarge (nd, sub.x1, sub.y1, sub.x2, sub.y2,
+                 sub.x3, sub.y3, sub.x4, sub.y4);
+      }
+      nodes << nd;
+    }
+    start= end;
+    end  = N(nodes);
+  }
+}
+
+/******************************************************************************
+* Queries
+******************************************************************************/
+
+void
+box_index_rep::nearest (box_rep* b, int i, SI x, SI y, SI delta, bool force,
+                        int& d, int& m) {
+  // the branch and bound counterpart of the linear search in find_child,
+  // which selects the first accessible child at the smallest distance
+  box_index_node nd= nodes[i];
+  SI dx= (x < nd.x1? nd.x1 - x: (x > nd.x2? x - nd.x2: 0));
+  SI dy= (y < nd.y1? nd.y1 - y: (y > nd.y2? y - nd.y2: 0));
+  if (m >= 0 && dx + dy - 1 > d) return;
+  if (i < leaves) {
+    for (int j= nd.start; j<nd.end; j++) {
+      int c= child[j];
+      int dc= b->distance (c, x, y, delta);
+      if ((dc < d || (dc == d && c < m)) &&
+          (b->subbox (c)->accessible () || force)) {
+        d= dc;
+        m= c;
+      }
+    }
+  }
+  else
+    for (int j= nd.start; j<nd.end; j++)
+      nearest (b, j, x, y, delta, force, d, m);
+}
+
+int
+box_index_rep::nearest (box_rep* b, SI x, SI y, SI delta, bool force) {
+  int d= MAX_SI, m= -1;
+  if (N(nodes) != 0) nearest (b, N(nodes) - 1, x, y, delta, force, d, m);
+  return m;
+}
+
+void
+box_index_rep::visible (box_rep* b, int i, SI x1, SI y1, SI x2, SI y2,
+                        array<int>& r) {
+  box_index_node nd= nodes[i];
+  if (nd.x4 < x1 || nd.y4 < y1 || nd.x3 >= x2 || nd.y3 >= y2) return;
+  if (i < leaves) {
+    for (int j= nd.start; j<nd.end; j++) {
+      int c= child[j];
+      if (b->sx4 (c) >= x1 && b->sy4 (c) >= y1 &&
+          b->sx3 (c) <  x2 && b->sy3 (c) <  y2)
+        r << c;
+    }
+  }
+  else
+    for (int j= nd.start; j<nd.end; j++)
+      visible (b, j, x1, y1, x2, y2, r);
+}
+
+array<int>
+box_index_rep::visible (box_rep* b, SI x1, SI y1, SI x2, SI y2) {
+  // the children whose ink extents meet the rectangle, in increasing order
+  array<int> r;
+  if (N(nodes) != 0) visible (b, N(nodes) - 1, x1, y1, x2, y2, r);
+  merge_sort (r);
+  return r;
+}
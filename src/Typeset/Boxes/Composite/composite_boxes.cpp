@@ -59,11 +59,13 @@ composite_box_rep::insert (box b, SI x, SI y) {
   bs << b;
   sx(n)= x;
   sy(n)= y;
+  idx= box_index ();
 }
 
 void
 composite_box_rep::position () {
   int i, n= subnr();
+  idx= box_index ();
   if (n == 0) {
     x1= y1= x3= y3= 0;
     x2= y2= x4= y4= 0;
@@ -91,6 +93,7 @@ composite_box_rep::left_justify () {
   SI d= x1;
   x1-=d; x2-=d; x3-=d; x4-=d;
   for (i=0; i<n; i++) sx(i) -= d;
+  idx= box_index ();
 }
 
 /******************************************************************************
@@ -198,9 +201,25 @@ composite_box_rep::finalize () {
   */
 }
 
+bool
+composite_box_rep::indexed () {
+  if (!is_nil (idx)) return true;
+  if (subnr () < BOX_INDEX_THRESHOLD) return false;
+  idx= box_index (this);
+  return true;
+}
+
+bool
+composite_box_rep::find_visible (SI X1, SI Y1, SI X2, SI Y2, array<int>& ks) {
+  if (!indexed ()) return false;
+  ks= idx->visible (this, X1, Y1, X2, Y2);
+  return true;
+}
+
 int
 composite_box_rep::find_child (SI x, SI y, SI delta, bool force) {
   if (outside (x, delta, x1, x2) && (is_accessible (ip) || force)) return -1;
+  if (indexed ()) return idx->nearest (this, x, y, delta, force);
   int i, n= subnr(), d= MAX_SI, m= -1;
   for (i=0; i<n; i++)
     if (distance (i, x, y, delta)< d)
@@ -376,6 +395,7 @@ concrete_composite_box_rep::find_child (SI x, SI y, SI delta, bool force) {
   if (border_flag &&
       outside (x, delta, x1, x2) &&
       (is_accessible (ip) || force)) return -1;
+  if (indexed ()) return idx->nearest (this, x, y, delta, force);
   int i, n= subnr(), d= MAX_SI, m= -1;
   for (i=0; i<n; i++)
     if (distance (i, x, y, delta)< d)
@@ -124,10 +124,14 @@ struct page_box_rep: composite_box_rep {
   int   page_nr;
   brush page_bgc;
   box   decoration;
+  box_maker maker;  // makes the decoration when it is first needed
   int   old_page;
 
   page_box_rep (path ip, tree page, int page_nr, brush bgc, SI w, SI h,
 		array<box> bs, array<SI> x, array<SI> y, box dec);
+  page_box_rep (path ip, tree page, int page_nr, brush bgc, SI w, SI h,
+		array<box> bs, array<SI> x, array<SI> y, box_maker m);
+  box  get_decoration ();
   operator tree ();
   int find_child (SI x, SI y, SI delta, bool force);
   void display_background (renderer ren);
@@ -164,6 +168,33 @@ page_box_rep::page_box_rep (path ip2, tree p2, int nr2, brush bgc, SI w, SI h,
   finalize ();
 }
 
+page_box_rep::page_box_rep (path ip2, tree p2, int nr2, brush bgc, SI w, SI h,
+			    array<box> bs, array<SI> x, array<SI> y,
+			    box_maker m):
+  composite_box_rep (ip2, bs, x, y),
+  page (p2), page_nr (nr2), page_bgc (bgc), maker (m), old_page (0)
+{
+  // the ink of the decoration is assumed to remain inside the page
+  x1= min (x1, 0);
+  x2= max (x2, w);
+  y1= -h;
+  y2=  0;
+  x3= min (x3,  0);
+  x4= max (x4,  w);
+  y3= min (y3, -h);
+  y4= max (y4,  0);
+  finalize ();
+}
+
+box
+page_box_rep::get_decoration () {
+  if (!is_nil (maker)) {
+    decoration= maker->produce ();
+    maker= box_maker ();
+  }
+  return decoration;
+}
+
 page_box_rep::operator tree () {
   int i, n= N(bs);
   tree t (TUPLE, n+1);
@@ -217,6 +248,7 @@ page_box_rep::post_display (renderer& ren) {
 
 void
 page_box_rep::display (renderer ren) {
+  box decoration= get_decoration ();
   if (!is_nil (decoration)) {
     rectangles rs;
     decoration->redraw (ren, path (), rs);
@@ -235,6 +267,7 @@ page_box_rep::clear_incomplete (
   // cout << "main   = " << r1 << "\n";
   extra = extra - r1;
 
+  box decoration= get_decoration ();
   if (!is_nil (decoration)) {
     int i, n= N (decoration);
     for (i=0; i<n; i++) {
@@ -432,6 +465,13 @@ page_box (path ip, tree page, int page_nr, brush bgc, SI w, SI h,
                                w, h, bs, bs_x, bs_y, dec);
 }
 
+box
+page_box (path ip, tree page, int page_nr, brush bgc, SI w, SI h,
+	  array<box> bs, array<SI> bs_x, array<SI> bs_y, box_maker decs) {
+  return tm_new<page_box_rep> (ip, page, page_nr, bgc,
+                               w, h, bs, bs_x, bs_y, decs);
+}
+
 box
 page_border_box (path ip, box pb, color tmb, SI l, SI r, SI b, SI t, SI pixel) {
   box rb= tm_new<page_border_box_rep> (ip, pb, tmb, l, r, b, t, pixel);
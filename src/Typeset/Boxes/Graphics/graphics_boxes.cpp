@@ -24,6 +24,12 @@ struct graphics_box_rep: public composite_box_rep {
   grid g;
   point lim1, lim2;
   SI old_clip_x1, old_clip_x2, old_clip_y1, old_clip_y2;
+  bool indexed;                  // index of the children built?
+  int side;                      // number of cells of the index per row
+  SI gx, gy, gw, gh;             // origin and size of the cells
+  array<array<int> > cells;      // children whose bounds meet each cell
+  array<int> always;             // children without graphical bounds
+  array<SI> bounds;              // bounds of the children
   graphics_box_rep (
     path ip, array<box> bs, frame f, grid g, point lim1, point lim2);
   frame get_frame ();
@@ -34,13 +40,16 @@ struct graphics_box_rep: public composite_box_rep {
   void post_display (renderer &ren);
   int reindex (int i, int item, int n);
   virtual int find_child (SI x, SI y, SI delta, bool force);
+  void build_index ();
+  array<bool> candidates (SI x1, SI y1, SI x2, SI y2);
   gr_selections graphical_select (SI x, SI y, SI dist);
   gr_selections graphical_select (SI x1, SI y1, SI x2, SI y2);
 };
 
 graphics_box_rep::graphics_box_rep (
   path ip2, array<box> bs2, frame f2, grid g2, point lim1b, point lim2b):
-  composite_box_rep (ip2, bs2), f (f2), g (g2), lim1 (lim1b), lim2 (lim2b)
+  composite_box_rep (ip2, bs2), f (f2), g (g2), lim1 (lim1b), lim2 (lim2b),
+  indexed (false)
 {
   point flim1= f(lim1), flim2= f(lim2);
   x1= (SI) min (flim1[0], flim2[0]);
@@ -111,12 +120,81 @@ graphics_box_rep::find_child (SI x, SI y, SI delta, bool force) {
   and consequently, its more specific implementation below should be
   removed (this is the same in concat_boxes and stack_boxes). */
 
+/******************************************************************************
+* Spatial index for the selection of the children of big graphics
+******************************************************************************/
+
+#define GRAPHICS_INDEX_MIN 64
+#define GRAPHICS_INDEX_MAX 64
+
+void
+graphics_box_rep::build_index () {
+  // a uniform grid over the graphical bounds of the children;
+  // boxes being rebuilt whenever the graphics change, so is the index
+  indexed= true;
+  int i, n= subnr ();
+  if (n < GRAPHICS_INDEX_MIN) return;
+  bounds= array<SI> (4*n);
+  SI X1= MAX_SI, Y1= MAX_SI, X2= -MAX_SI, Y2= -MAX_SI;
+  for (i=0; i<n; i++) {
+    SI& b1= bounds[4*i]; SI& b2= bounds[4*i+1];
+    SI& b3= bounds[4*i+2]; SI& b4= bounds[4*i+3];
+    if (!bs[i]->graphical_bounds (b1, b2, b3, b4)) {
+      b1= b2= MAX_SI; b3= b4= -MAX_SI;
+      always << i;
+      continue;
+    }
+    b1 += sx(i); b2 += sy(i); b3 += sx(i); b4 += sy(i);
+    X1= min (X1, b1); Y1= min (Y1, b2); X2= max (X2, b3); Y2= max (Y2, b4);
+  }
+  side= max (1, min (GRAPHICS_INDEX_MAX, (int) sqrt ((double) n) / 2));
+  gx= X1; gy= Y1;
+  gw= max (1, (X2 - X1) / side + 1);
+  gh= max (1, (Y2 - Y1) / side + 1);
+  cells= array<array<int> > (side * side);
+  for (i=0; i<n; i++) {
+    if (bounds[4*i] > bounds[4*i+2]) continue;
+    int k1= (bounds[4*i  ] - gx) / gw, k2= (bounds[4*i+2] - gx) / gw;
+    int l1= (bounds[4*i+1] - gy) / gh, l2= (bounds[4*i+3] - gy) / gh;
+    for (int l=l1; l<=l2; l++)
+      for (int k=k1; k<=k2; k++)
+        cells[l*side + k] << i;
+  }
+}
+
+array<bool>
+graphics_box_rep::candidates (SI X1, SI Y1, SI X2, SI Y2) {
+  // the children which may be selected inside the rectangle
+  int i, n= subnr ();
+  if (!indexed) build_index ();
+  if (N(cells) == 0) return array<bool> ();
+  array<bool> r (n);
+  for (i=0; i<n; i++) r[i]= false;
+  for (i=0; i<N(always); i++) r[always[i]]= true;
+  if (X2 < gx || Y2 < gy) return r;
+  int k1= max (0, (X1 - gx) / gw), k2= min (side - 1, (X2 - gx) / gw);
+  int l1= max (0, (Y1 - gy) / gh), l2= min (side - 1, (Y2 - gy) / gh);
+  for (int l=l1; l<=l2; l++)
+    for (int k=k1; k<=k2; k++) {
+      array<int>& c= cells[l*side + k];
+      for (int j=0; j<N(c); j++) {
+        int m= c[j];
+        if (bounds[4*m] <= X2 && bounds[4*m+2] >= X1 &&
+            bounds[4*m+1] <= Y2 && bounds[4*m+3] >= Y1)
+          r[m]= true;
+      }
+    }
+  return r;
+}
+
 gr_selections
 graphics_box_rep::graphical_select (SI x, SI y, SI dist) {
   gr_selections res;
   int i, n= subnr();
+  array<bool> cand= candidates (x - dist, y - dist, x + dist, y + dist);
   for (i=n-1; i>=0; i--)
-    res << bs[i]->graphical_select (x- sx(i), y- sy(i), dist);
+    if (N(cand) == 0 || cand[i])
+      res << bs[i]->graphical_select (x- sx(i), y- sy(i), dist);
   return res;
 }
 
@@ -124,9 +202,11 @@ gr_selections
 graphics_box_rep::graphical_select (SI x1, SI y1, SI x2, SI y2) {
   gr_selections res;
   int i, n= subnr();
+  array<bool> cand= candidates (x1, y1, x2, y2);
   for (i=n-1; i>=0; i--)
-    res << bs[i]->graphical_select (x1- sx(i), y1- sy(i),
-				    x2- sx(i), y2- sy(i));
+    if (N(cand) == 0 || cand[i])
+      res << bs[i]->graphical_select (x1- sx(i), y1- sy(i),
+				      x2- sx(i), y2- sy(i));
   return res;
 }
 
@@ -197,6 +277,8 @@ struct point_box_rep: public box_rep {
 		 brush br, string style);
   SI graphical_distance (SI x, SI y) { return (SI) norm (p - point (x, y)); }
   gr_selections graphical_select (SI x, SI y, SI dist);
+  bool graphical_bounds (SI& X1, SI& Y1, SI& X2, SI& Y2) {
+    X1= x1; Y1= y1; X2= x2; Y2= y2; return true; }
   void display (renderer ren);
   operator tree () { return "point"; }
 };
@@ -327,6 +409,7 @@ struct curve_box_rep: public box_rep {
   array<SI> styled_n;
   brush fill_br;
   array<box> arrows;
+  array<point> lo, hi;  // bounding boxes of chunks of segments of a
   curve_box_rep (path ip, curve c, pencil pen,
 		 array<bool> style, array<point> motif, SI style_unit,
 		 brush fill_br,
@@ -335,9 +418,11 @@ struct curve_box_rep: public box_rep {
   SI graphical_distance (SI x, SI y);
   gr_selections graphical_select (SI x, SI y, SI dist);
   gr_selections graphical_select (SI x1, SI y1, SI x2, SI y2);
+  bool graphical_bounds (SI& X1, SI& Y1, SI& X2, SI& Y2);
   void display (renderer ren);
   operator tree () { return "curve"; }
   SI length ();
+  void build_chunks ();
   void apply_style ();
   void apply_motif (array<box> arrows);
 };
@@ -403,16 +488,49 @@ curve_box_rep::transform (frame fr) {
                     fill_br, arrows);
 }
 
+#define CURVE_CHUNK 16
+
+void
+curve_box_rep::build_chunks () {
+  // bounding boxes of consecutive chunks of CURVE_CHUNK segments,
+  // so that distant parts of long curves can be skipped at once
+  int i, j, n= N(a);
+  for (i=0; i+1<n; i+=CURVE_CHUNK) {
+    point l= a[i], h= a[i];
+    for (j=i+1; j<=i+CURVE_CHUNK && j<n; j++)
+      for (int k=0; k<2; k++) {
+        l[k]= min (l[k], a[j][k]);
+        h[k]= max (h[k], a[j][k]);
+      }
+    lo << l;
+    hi << h;
+  }
+}
+
 SI
 curve_box_rep::graphical_distance (SI x, SI y) {
   SI gd= MAX_SI;
   point p (x, y);
-  int i;
-  for (i=0; i<N(a)-1; i++) {
-    axis ax;
-    ax.p0= a[i];
-    ax.p1= a[i+1];
-    gd= min (gd, (SI)seg_dist (ax, p));
+  int i, j;
+  if (N(lo) == 0 && N(a) > CURVE_CHUNK) build_chunks ();
+  if (N(lo) == 0)
+    for (i=0; i<N(a)-1; i++) {
+      axis ax;
+      ax.p0= a[i];
+      ax.p1= a[i+1];
+      gd= min (gd, (SI)seg_dist (ax, p));
+    }
+  for (j=0; j<N(lo); j++) {
+    double dx= max (0.0, max (lo[j][0] - p[0], p[0] - hi[j][0]));
+    double dy= max (0.0, max (lo[j][1] - p[1], p[1] - hi[j][1]));
+    if (sqrt (dx*dx + dy*dy) >= (double) gd) continue;
+    int e= min (N(a)-1, (j+1) * CURVE_CHUNK);
+    for (i=j*CURVE_CHUNK; i<e; i++) {
+      axis ax;
+      ax.p0= a[i];
+      ax.p1= a[i+1];
+      gd= min (gd, (SI)seg_dist (ax, p));
+    }
   }
   array<double> abs;
   array<point> pts;
@@ -423,6 +541,21 @@ curve_box_rep::graphical_distance (SI x, SI y) {
   return gd;
 }
 
+bool
+curve_box_rep::graphical_bounds (SI& X1, SI& Y1, SI& X2, SI& Y2) {
+  // the control points may lie outside the curve itself
+  X1= x1; Y1= y1; X2= x2; Y2= y2;
+  array<double> abs;
+  array<point> pts;
+  array<path> paths;
+  c->get_control_points (abs, pts, paths);
+  for (int i=0; i<N(pts); i++) {
+    X1= min (X1, (SI) pts[i][0]); Y1= min (Y1, (SI) pts[i][1]);
+    X2= max (X2, (SI) pts[i][0]); Y2= max (Y2, (SI) pts[i][1]);
+  }
+  return true;
+}
+
 gr_selections
 curve_box_rep::graphical_select (SI x, SI y, SI dist) {
   gr_selections res;
@@ -475,31 +475,36 @@ struct repeat_box_rep: public change_box_rep {
   box repeat;
   SI xoff;
   bool under;
+  box moved;   // the repeated box, moved to the origin
+  int i1, i2;  // range of the repetitions
   repeat_box_rep (path ip, box b, box repeat, SI xoff, bool under);
   operator tree () { return tree (TUPLE, "repeat", (tree) bs[0]); }
-  int reindex (int i, int item, int n);
+  void display_repeats (renderer ren);
+  void pre_display (renderer& ren) { if (under) display_repeats (ren); }
+  void display (renderer ren) { if (!under) display_repeats (ren); }
   box adjust_kerning (int mode, double factor);
   box expand_glyphs (int mode, double factor);
 };
 
 repeat_box_rep::repeat_box_rep (path ip, box b, box r2, SI xoff2, bool u2):
-  change_box_rep (ip, false), repeat (r2), xoff (xoff2), under (u2)
+  change_box_rep (ip, false), repeat (r2), xoff (xoff2), under (u2),
+  i1 (0), i2 (0)
 {
   insert (b, 0, 0);
   position ();
 
+  // the repetitions are only decorations, which are not made into
+  // separate boxes, but drawn on the fly when the box is displayed
   SI width= repeat->w ();
   if (width >= PIXEL) {
-    int i;
-    int i1= ((xoff+b->x1)/width)-1;
-    int i2= ((xoff+b->x2)/width)+1;
+    i1= ((xoff+b->x1)/width)-1;
+    i2= ((xoff+b->x2)/width)+1;
     while (i1*width < (xoff+b->x1)) i1++;
     while (i2*width > (xoff+b->x2)) i2--;
-    for (i=i1; i<i2; i++) {
-      box bb= move_box (decorate_right (ip), repeat, 0, 0);
-      insert (bb, i*width-xoff, 0);
-      x3= min (x3, i*width-xoff + repeat->x3);
-      x4= max (x4, i*width-xoff + repeat->x4);
+    if (i1 < i2) {
+      moved= move_box (decorate_right (ip), repeat, 0, 0);
+      x3= min (x3, i1*width-xoff + repeat->x3);
+      x4= max (x4, (i2-1)*width-xoff + repeat->x4);
       y3= min (y3, repeat->y3);
       y4= max (y4, repeat->y4);
     }
@@ -510,10 +515,17 @@ repeat_box_rep::repeat_box_rep (path ip, box b, box r2, SI xoff2, bool u2):
   x2= b->x2; y2= b->y2;
 }
 
-int
-repeat_box_rep::reindex (int i, int item, int n) {
-  if (under) return (i<n? i+1: 0);
-  else return change_box_rep::reindex (i, item, n);
+void
+repeat_box_rep::display_repeats (renderer ren) {
+  if (i1 >= i2) return;
+  SI width= repeat->w ();
+  for (int i=i1; i<i2; i++) {
+    SI x= i*width-xoff;
+    if (!ren->is_visible (x + repeat->x3, repeat->y3,
+                          x + repeat->x4, repeat->y4)) continue;
+    rectangles rs;
+    moved->redraw (ren, path (), rs, x, 0);
+  }
 }
 
 box
@@ -14,6 +14,46 @@
 #include "boxes.hpp"
 #include "array.hpp"
 
+/******************************************************************************
+* Spatial indices over the children of composite boxes are packed R-trees.
+* They are built on demand for boxes with at least BOX_INDEX_THRESHOLD
+* children, after which the positions of the children should not change.
+******************************************************************************/
+
+#define BOX_INDEX_THRESHOLD 32
+#define BOX_INDEX_FANOUT    16
+
+struct box_index_node {
+  SI  x1, y1, x2, y2;  // logical extents of the children below the node
+  SI  x3, y3, x4, y4;  // ink extents of the children below the node
+  int start, end;      // range in child (for leaves) or in nodes
+};
+
+class box_index;
+class box_index_rep: concrete_struct {
+  array<int>            child;   // the children, grouped by leaves
+  array<box_index_node> nodes;   // the leaves first and the root last
+  int                   leaves;  // the number of leaves
+
+  void nearest (box_rep* b, int i, SI x, SI y, SI delta, bool force,
+                int& d, int& m);
+  void visible (box_rep* b, int i, SI x1, SI y1, SI x2, SI y2,
+                array<int>& r);
+
+public:
+  box_index_rep (box_rep* b);
+  int  nearest (box_rep* b, SI x, SI y, SI delta, bool force);
+  array<int> visible (box_rep* b, SI x1, SI y1, SI x2, SI y2);
+
+  friend class box_index;
+};
+
+class box_index {
+  CONCRETE_NULL(box_index);
+  inline box_index (box_rep* b): rep (tm_new<box_index_rep> (b)) {}
+};
+CONCRETE_NULL_CODE(box_index);
+
 /******************************************************************************
 * Composite boxes
 ******************************************************************************/
@@ -21,6 +61,7 @@
 struct composite_box_rep: public box_rep {
   array<box> bs;  // the children
   path lip, rip;  // left-most and right-most inverse paths
+  box_index idx;  // spatial index over the children, if any
 
   composite_box_rep (path ip);
   composite_box_rep (path ip, array<box> bs);
@@ -36,6 +77,7 @@ struct composite_box_rep: public box_rep {
   int     subnr ();
   box     subbox (int i);
   void    display (renderer ren);
+  bool    indexed ();
 
   virtual int             find_child (SI x, SI y, SI delta, bool force);
   virtual path            find_box_path (SI x, SI y, SI delta,
@@ -43,6 +85,8 @@ struct composite_box_rep: public box_rep {
   virtual path            find_lip ();
   virtual path            find_rip ();
   virtual path            find_box_path (path p, bool& found);
+  virtual bool            find_visible (SI x1, SI y1, SI x2, SI y2,
+                                        array<int>& ks);
   virtual path            find_tree_path (path bp);
   virtual cursor          find_cursor (path bp);
   virtual selection       find_selection (path lbp, path rbp);
@@ -19,6 +19,22 @@
 
 class frame;
 
+/******************************************************************************
+* Boxes which are only made when they are needed
+******************************************************************************/
+
+class box_maker_rep: public abstract_struct {
+public:
+  inline box_maker_rep () {}
+  inline virtual ~box_maker_rep () {}
+  virtual box produce () = 0;
+};
+
+class box_maker {
+ABSTRACT_NULL(box_maker);
+};
+ABSTRACT_NULL_CODE(box_maker);
+
 /******************************************************************************
 * Ornament parameters
 ******************************************************************************/
@@ -116,6 +132,7 @@ box polygon_box (path ip, array<SI> x, array<SI> y, brush fill, pencil pen);
 box image_box (path ip, url u, SI w, SI h, int alpha, int px);
 
 box text_box (path ip, int pos, string s, font fn, pencil pen);
+box text_box (path ip, int pos, string s, font fn, pencil pen, metric& ex);
 box delimiter_box (path ip, string s, font fn, pencil pen, SI y1, SI y2);
 box delimiter_box (path ip, string s, font fn, pencil pen,
                    SI bot, SI top, SI mid, SI real_bot, SI real_top);
@@ -189,6 +206,9 @@ box vcorrect_box (path ip, box b, SI top_cor, SI bot_cor);
 box page_box (path ip, tree page, int page_nr, brush bgc, SI w, SI h,
 	      array<box> bs  , array<SI> bs_x  , array<SI> bs_y,
 	      array<box> decs, array<SI> decs_x, array<SI> decs_y);
+box page_box (path ip, tree page, int page_nr, brush bgc, SI w, SI h,
+	      array<box> bs  , array<SI> bs_x  , array<SI> bs_y,
+	      box_maker decs);
 box page_border_box (path ip, box pb, color tmb, SI l, SI r, SI b, SI t, SI pix);
 box crop_marks_box (path ip, box pb, SI w, SI h, SI lw, SI ll);
 box locus_box (path ip, box b, list<string> ids, SI pixel);
@@ -201,13 +201,16 @@ bridge_document_rep::my_typeset (int desired_status) {
     int i, n= N(st);
     array<line_item> a= ttt->a;
     array<line_item> b= ttt->b;
+    bool root= (ttt->br->ip == ip);
     for (i=0; i<n; i++) {
       //cout << "Typesetting " << st[i] << LF;
+      if (root) env->ref_reader= i;
       int wanted= (i==n-1? desired_status & WANTED_MASK: WANTED_PARAGRAPH);
       ttt->a= (i==0  ? a: array<line_item> ());
       ttt->b= (i==n-1? b: array<line_item> ());
       brs[i]->typeset (PROCESSED+ wanted);
     }
+    if (root) env->ref_reader= -1;
   }
   else acc->my_typeset (desired_status);
   //cout << UNINDENT;
@@ -35,8 +35,11 @@ bridge_rewrite_rep::bridge_rewrite_rep (typesetter ttt, tree st, path ip):
 
 void
 bridge_rewrite_rep::initialize (tree body_t) {
+  // NOTE: included documents are shared through the inclusion cache,
+  // so that an unchanged inclusion keeps its typesetted body
   if (is_nil (body)) body= make_bridge (ttt, attach_right (body_t, ip));
-  else replace_bridge (body, attach_right (body_t, ip));
+  else if (body->st != body_t)
+    replace_bridge (body, attach_right (body_t, ip));
 }
 
 bridge
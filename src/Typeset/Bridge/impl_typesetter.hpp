@@ -28,6 +28,7 @@ public:
   SI x1, y1, x2, y2;
   hashmap<string,tree> old_patch;
   bool paper;
+  page_break_memo page_memo;   // for incremental page breaking
 
 public:
   typesetter_rep (edit_env& env, tree et, path ip);
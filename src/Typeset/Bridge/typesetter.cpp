@@ -11,6 +11,7 @@
 
 #include "Bridge/impl_typesetter.hpp"
 #include "iterator.hpp"
+#include "tm_timer.hpp"
 
 /******************************************************************************
 * Constructor and destructor
@@ -50,7 +51,12 @@ typesetter_rep::insert_parunit (tree t, path ip) {
 
 void
 typesetter_rep::insert_paragraph (tree t, path ip) {
+  // NOTE: paragraphs are typeset one after another on purpose. Even when
+  // a paragraph only depends on the environment at its start, typesetting
+  // it writes into env (counters, labels, local_aux), fills global font
+  // and glyph caches and may call Scheme, none of which is thread safe.
   // cout << "Typesetting " << t << ", " << ip << "\n";
+  PROFILE_SCOPE ("typeset paragraph");
   stack_border     temp_sb;
   array<page_item> temp_l= typeset_stack (env, t, ip, a, b, temp_sb);
   insert_stack (temp_l, temp_sb);
@@ -128,6 +134,8 @@ typesetter_rep::determine_page_references (box b) {
     string var= it->next ();
     tree   val= copy (h[var]);
     tree   old= env->local_ref [var];
+    if (is_tuple (old) && N(old) >= 2 && old[1] != val)
+      env->changed (var)= true;
     if (is_func (old, TUPLE, 2))
       env->local_ref (var)= tuple (old[0], val);
     else if (is_func (old, TUPLE, 3))
@@ -163,11 +171,24 @@ typesetter_rep::typeset () {
     env->missing  = hashmap<string,tree> (UNINIT);
     env->redefined= array<tree> ();
     env->touched  = hashmap<string,bool> (false);
+    env->changed  = hashmap<string,bool> (false);
+    env->ref_readers= hashmap<string,array<int> > ();
   }
+  else if (env->refining) {
+    env->missing  = hashmap<string,tree> (UNINIT);
+    env->redefined= array<tree> ();
+    env->changed  = hashmap<string,bool> (false);
+  }
+  PROFILE_SCOPE ("typeset document");
   br->typeset (PROCESSED+ WANTED_PARAGRAPH);
-  pager ppp= tm_new<pager_rep> (br->ip, env, l);
-  box rb= ppp->make_pages ();
-  if (env->complete && paper) determine_page_references (rb);
+  pager ppp= tm_new<pager_rep> (br->ip, env, l, page_memo);
+  box rb;
+  {
+    PROFILE_SCOPE ("page breaking");
+    rb= ppp->make_pages ();
+  }
+  if ((env->complete || env->refining) && paper)
+    determine_page_references (rb);
   tm_delete (ppp);
   // env->complete= false;  // moved to edit_typeset_rep::typeset
   return rb;
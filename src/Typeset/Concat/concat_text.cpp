@@ -78,10 +78,27 @@ concater_rep::typeset_text_string (tree t, path ip, int pos, int end) {
   string s= t->label;
   int    start;
 
+  // the words are first collected, so that they can be measured at once
+  array<int> starts, ends;
+  array<text_property> tps;
+  array<string> words;
   do {
     start= pos;
     text_property tp= env->lan->advance (t, pos);
     if (pos > end) pos= end;
+    starts << start;
+    ends << pos;
+    tps << tp;
+    if (!((pos > start) && (s[start] == ' '))) words << s (start, pos);
+  } while (pos<end);
+  array<metric_struct> exs;
+  env->fn->get_extents (words, exs);
+
+  int i, k= 0;
+  for (i=0; i<N(tps); i++) {
+    start= starts[i];
+    pos  = ends[i];
+    text_property tp= tps[i];
     if ((pos > start) && (s[start] == ' ')) { // spaces
       if (start == 0) typeset_substring ("", ip, 0);
       penalty_min (tp->pen_after);
@@ -93,11 +110,14 @@ concater_rep::typeset_text_string (tree t, path ip, int pos, int end) {
     else { // strings
       penalty_max (tp->pen_before);
       PRINT_SPACE (tp->spc_before)
-      typeset_substring (s (start, pos), ip, start);
+      metric ex;
+      ex[0]= exs[k];
+      box b= text_box (ip, start, words[k++], env->fn, env->pen, ex);
+      a << line_item (STRING_ITEM, OP_TEXT, b, HYPH_INVALID, env->lan);
       penalty_min (tp->pen_after);
       PRINT_SPACE (tp->spc_after)
     }
-  } while (pos<end);
+  }
 }
 
 inline array<space>
@@ -223,6 +243,7 @@ concater_rep::typeset_surround (tree t, path ip) {
 void
 concater_rep::typeset_concat (tree t, path ip) {
   int i, n= N(t);
+  a->reserve (N(a) + 2*n); // most items give rise to a box and a space
   for (i=0; i<n; i++)
     typeset (t[i], descend (ip, i));
 }
@@ -151,6 +151,49 @@ concater_rep::with_limits (int status) {
       a[N(a)-1]->limits = true;
 }
 
+/******************************************************************************
+* Hidden content
+******************************************************************************/
+
+static bool
+is_inert (edit_env env, tree t) {
+  // Hidden content is typeset for its side effects only (assignments,
+  // labels, loci, ...), since the resulting boxes are discarded.
+  // Plain text and primitive markup have no side effects and are skipped.
+  if (is_atomic (t)) return true;
+  switch (L(t)) {
+  case ARG:
+    if (N(t) == 1 && is_atomic (t[0]) && !is_nil (env->macro_arg) &&
+        env->macro_arg->item->contains (t[0]->label)) {
+      tree r= env->macro_arg->item [t[0]->label];
+      list<hashmap<string,tree> > old_var= env->macro_arg;
+      list<hashmap<string,path> > old_src= env->macro_src;
+      env->macro_arg= env->macro_arg->next;
+      if (!is_nil (env->macro_src)) env->macro_src= env->macro_src->next;
+      bool inert= is_inert (env, r);
+      env->macro_arg= old_var;
+      env->macro_src= old_src;
+      return inert;
+    }
+    return false;
+  case WITH:
+    for (int i=0; i<N(t)-1; i++)
+      if (!is_atomic (t[i])) return false;
+    return N(t) > 0 && is_inert (env, t[N(t)-1]);
+  case DOCUMENT: case PARA: case CONCAT:
+  case HSPACE: case VSPACE: case SPACE: case HTAB:
+  case LEFT: case MID: case RIGHT: case BIG:
+  case LPRIME: case RPRIME: case BELOW: case ABOVE:
+  case LSUB: case LSUP: case RSUB: case RSUP:
+  case FRAC: case SQRT: case WIDE: case NEG:
+    for (int i=0; i<N(t); i++)
+      if (!is_inert (env, t[i])) return false;
+    return true;
+  default:
+    return false;
+  }
+}
+
 /******************************************************************************
 * Typesetting generic objects
 ******************************************************************************/
@@ -213,7 +256,8 @@ concater_rep::typeset (tree t, path ip) {
   case HIDDEN:
     //(void) env->exec (t);
     if (N(t) != 1) typeset_error (t, ip);
-    else (void) typeset_as_concat (env, t[0], descend (ip, 0));
+    else if (!is_inert (env, t[0]))
+      (void) typeset_as_concat (env, t[0], descend (ip, 0));
     break;
   case FREEZE:
     if (N(t) != 1) typeset_error (t, ip);
@@ -885,6 +929,7 @@ concater_rep::concater_rep (edit_env env2, bool rigid2):
 
 array<line_item>
 typeset_concat (edit_env env, tree t, path ip) {
+  PROFILE_SCOPE ("typeset concat");
   concater ccc= tm_new<concater_rep> (env);
   ccc->typeset (t, ip);
   ccc->finish ();
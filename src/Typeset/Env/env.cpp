@@ -38,7 +38,9 @@ edit_env_rep::edit_env_rep (drd_info& drd2,
   local_ref (local_ref2), global_ref (global_ref2),
   local_aux (local_aux2), global_aux (global_aux2),
   local_att (local_att2), global_att (global_att2),
-  missing (UNINIT), redefined (), touched (false)
+  missing (UNINIT), redefined (), touched (false),
+  changed (false), ref_reader (-1),
+  fixed_lengths (UNINIT), font_lengths (UNINIT)
 {
   initialize_default_env ();
   initialize_default_var_type ();
@@ -46,6 +48,7 @@ edit_env_rep::edit_env_rep (drd_info& drd2,
   style_init_env ();
   update ();
   complete= false;
+  refining= false;
   recover_env= tuple ();
   anim_start= anim_end= anim_portion= 0.0;
 }
@@ -67,6 +70,7 @@ void
 edit_env_rep::style_init_env () {
   dpi = get_int (DPI);
   inch= ((double) dpi*PIXEL);
+  fixed_lengths= hashmap<string,tree> (UNINIT);
   flexibility= get_double (PAGE_FLEXIBILITY);
   first_page= get_double (PAGE_FIRST);
   back= hashmap<string,tree> (UNINIT);
@@ -180,6 +184,11 @@ edit_env_rep::read_env (hashmap<string,tree>& ret) {
   ret= copy (env);
 }
 
+bool
+edit_env_rep::same_env (hashmap<string,tree> h) {
+  return env == h;
+}
+
 void
 edit_env_rep::local_start (hashmap<string,tree>& prev_back) {
   prev_back= back;
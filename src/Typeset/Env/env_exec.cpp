@@ -19,6 +19,7 @@
 #include "typesetter.hpp"
 #include "drd_mode.hpp"
 #include "dictionary.hpp"
+#include "new_style.hpp"
 
 extern int script_status;
 extern tree with_package_definitions (string package, tree body);
@@ -182,6 +183,7 @@ tree
 edit_env_rep::exec (tree t) {
   // cout << "Execute: " << t << "\n";
   if (is_atomic (t)) return t;
+  PROFILE_SCOPE ("typeset exec");
   switch (L(t)) {
   case MOVE:
   case SHIFT:
@@ -651,6 +653,97 @@ edit_env_rep::exec_with (tree t) {
   return u;
 }
 
+/******************************************************************************
+* Compiled macro definitions
+******************************************************************************/
+
+// Applying a macro binds its arguments in a new frame of macro_arg, in which
+// the body looks them up by name.  Each definition is compiled once into the
+// positions of the arguments which its body accesses, so that the other ones
+// need not be bound and no frame is pushed for bodies which access none.
+// Bodies which may evaluate trees from elsewhere ('value', 'eval', ...)
+// can access any argument, so that all arguments are bound for them.
+
+#define MACRO_CODE_CACHE_SIZE 10000
+
+class macro_code_rep: concrete_struct {
+public:
+  tree       def;      // the compiled definition, which keeps the key alive
+  bool       dynamic;  // the body may access arguments in unforeseen ways
+  bool       frame;    // the body looks up arguments in the top frame
+  array<int> used;     // the positions of the arguments used by the body
+
+  macro_code_rep (tree def);
+  friend class macro_code;
+};
+
+class macro_code {
+  CONCRETE_NULL(macro_code);
+  inline macro_code (tree def): rep (tm_new<macro_code_rep> (def)) {}
+};
+CONCRETE_NULL_CODE(macro_code);
+
+static void
+macro_scan (tree t, hashmap<string,bool>& names, bool& dynamic) {
+  if (is_atomic (t) || dynamic) return;
+  switch (L(t)) {
+  case ARG:
+  case QUOTE_ARG:
+  case EVAL_ARGS:
+    if (N(t) >= 1 && is_atomic (t[0])) names (t[0]->label)= true;
+    else dynamic= true;
+    break;
+  case MAP_ARGS:
+    if (N(t) >= 3 && is_atomic (t[2])) names (t[2]->label)= true;
+    else dynamic= true;
+    break;
+  case OCCURS_INSIDE:
+    if (N(t) >= 2 && is_atomic (t[1])) names (t[1]->label)= true;
+    else dynamic= true;
+    break;
+  case VALUE:
+  case QUOTE_VALUE:
+  case OR_VALUE:
+  case EVAL:
+  case QUASI:
+  case EXTERN:
+  case VAR_INCLUDE:
+  case WITH_PACKAGE:
+    dynamic= true;
+    break;
+  default:
+    break;
+  }
+  for (int i=0; i<N(t); i++)
+    macro_scan (t[i], names, dynamic);
+}
+
+macro_code_rep::macro_code_rep (tree def2): def (def2), dynamic (false) {
+  hashmap<string,bool> names (false);
+  int i, n= N(def)-1;
+  macro_scan (def[n], names, dynamic);
+  frame= dynamic || N(names) != 0;
+  if (L(def) == XMACRO) {
+    if (is_atomic (def[0]) && (dynamic || names->contains (def[0]->label)))
+      used << 0;
+  }
+  else for (i=0; i<n; i++)
+    if (is_atomic (def[i]) && (dynamic || names->contains (def[i]->label)))
+      used << i;
+}
+
+static macro_code
+compile_macro (tree f) {
+  static hashmap<pointer,macro_code> macro_codes;
+  pointer key= (pointer) f.operator -> ();
+  if (macro_codes->contains (key)) return macro_codes [key];
+  if (N(macro_codes) >= MACRO_CODE_CACHE_SIZE)
+    macro_codes= hashmap<pointer,macro_code> ();
+  macro_code code (f);
+  macro_codes (key)= code;
+  return code;
+}
+
 tree
 edit_env_rep::exec_compound (tree t) {
   int d; tree f;
@@ -673,21 +766,23 @@ edit_env_rep::exec_compound (tree t) {
   }
 
   if (is_applicable (f)) {
-    int i, n=N(f)-1, m=N(t)-d;
+    int n=N(f)-1, m=N(t)-d;
+    macro_code code= compile_macro (f);
+    if (!code->frame) return exec (f[n]);
     macro_arg= list<hashmap<string,tree> > (
       hashmap<string,tree> (UNINIT), macro_arg);
     macro_src= list<hashmap<string,path> > (
       hashmap<string,path> (path (DECORATION)), macro_src);
     if (L(f) == XMACRO) {
-      if (is_atomic (f[0]))
+      if (N(code->used) != 0)
 	macro_arg->item (f[0]->label)= t;
     }
-    else for (i=0; i<n; i++)
-      if (is_atomic (f[i])) {
-	tree st= i<m? t[i+d]: tree (UNINIT);
-	macro_arg->item (f[i]->label)= st;
-	macro_src->item (f[i]->label)= obtain_ip (st);
-      }
+    else for (int k=0; k<N(code->used); k++) {
+      int i= code->used[k];
+      tree st= i<m? t[i+d]: tree (UNINIT);
+      macro_arg->item (f[i]->label)= st;
+      macro_src->item (f[i]->label)= obtain_ip (st);
+    }
     tree r= exec (f[n]);
     macro_arg= macro_arg->next;
     macro_src= macro_src->next;
@@ -1206,6 +1301,7 @@ edit_env_rep::exec_use_package (tree t) {
     else name= styp * (as_string (t[i]) * string (".ts"));
     name= resolve (name);
     //cout << as_string (t[i]) << " -> " << name << "\n";
+    style_declare_dependency (name);
     string doc_s;
     if (!load_string (name, doc_s, false)) {
       tree doc= texmacs_document_to_tree (doc_s);
@@ -1965,9 +2061,10 @@ edit_env_rep::exec_set_binding (tree t) {
       local_ref (key) << extra;
     }
     touched (key)= true;
-    if (complete && is_tuple (old_value) && N(old_value) >= 1) {
+    if ((complete || refining) && is_tuple (old_value) && N(old_value) >= 1) {
       string old_s= tree_as_string (old_value[0]);
       string new_s= tree_as_string (value);
+      if (new_s != old_s) changed (key)= true;
       if (new_s != old_s && !starts (key, "auto-")) {
         redefined << tree (TUPLE, key, new_s);
 	//if (new_s == "") typeset_warning << "Redefined " << key << LF;
@@ -1978,6 +2075,14 @@ edit_env_rep::exec_set_binding (tree t) {
   return tree (HIDDEN_BINDING, keys, value);
 }
 
+void
+edit_env_rep::read_binding (string key) {
+  // remember which top-level paragraphs depend on which references;
+  // -1 stands for the material outside paragraphs, such as page headers
+  array<int>& a= ref_readers (key);
+  if (N(a) == 0 || a[N(a)-1] != ref_reader) a << ref_reader;
+}
+
 tree
 edit_env_rep::exec_get_binding (tree t) {
   if (N(t) != 1 && N(t) != 2) return tree (ERROR, "bad get binding");
@@ -1987,7 +2092,11 @@ edit_env_rep::exec_get_binding (tree t) {
   if (type != 0 && type != 1) type= 0;
   if (is_func (value, TUPLE) && (N(value) >= 2)) value= value[type];
   else if (type == 1) value= tree (UNINIT);
-  if (complete && value == tree (UNINIT))
+  if (complete || refining) {
+    read_binding (key);
+    if (value == tree (UNINIT)) changed (key)= true;
+  }
+  if ((complete || refining) && value == tree (UNINIT))
     if (get_bool (WARN_MISSING)) {
       missing (key)= tree (GET_BINDING, key);
       //typeset_warning << "Undefined reference " << key << LF;
@@ -2005,6 +2114,10 @@ edit_env_rep::exec_has_binding (tree t) {
   if (type != 0 && type != 1) type= 0;
   if (is_func (value, TUPLE) && (N(value) >= 2)) value= value[type];
   else if (type == 1) value= tree (UNINIT);
+  if (complete || refining) {
+    read_binding (key);
+    if (value == tree (UNINIT)) changed (key)= true;
+  }
   if (value == tree (UNINIT)) return "false";
   else return "true";
 }
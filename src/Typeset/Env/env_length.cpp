@@ -166,24 +166,68 @@ edit_env_rep::as_tmlen (tree t) {
     _max= _max[N(_max) == 3? 1: 0];
     return tree (TMLEN, _min, _def, _max);
   }
-  else if (is_atomic (t)) {
-    string s= t->label;
-    int start= 0, i, n=N(s);
-    while ((start+1<n) && (s[start]=='-') && (s[start+1]=='-')) start += 2;
-    double len;
-    string unit;
-    parse_length (s (start, n), len, unit);
-    if (unit == "error" || is_empty (unit)) {
-      return tree (TMLEN, "0");
-    } else {
-      return tmlen_times (len, as_tmlen (exec (compound (unit * "-length"))));
-    }
-  }
+  else if (is_atomic (t)) return decode_tmlen (t->label);
   else if (is_func (t, MACRO, 1))
     return as_tmlen (exec (t[0]));
   else return tree (TMLEN, "0");
 }
 
+static int
+length_unit_kind (tree_label l) {
+  // 0: depends on the environment, 1: absolute, 2: depends on the font
+  switch (l) {
+  case CM_LENGTH: case MM_LENGTH: case IN_LENGTH: case PT_LENGTH:
+  case BP_LENGTH: case DD_LENGTH: case PC_LENGTH: case CC_LENGTH:
+  case TMPT_LENGTH:
+  case MS_LENGTH: case S_LENGTH: case MSEC_LENGTH: case SEC_LENGTH:
+  case MIN_LENGTH: case HR_LENGTH:
+    return 1;
+  case FS_LENGTH: case FBS_LENGTH: case EM_LENGTH:
+  case LN_LENGTH: case SEP_LENGTH: case YFRAC_LENGTH: case EX_LENGTH:
+  case FN_LENGTH: case FNS_LENGTH:
+  case FNBOT_LENGTH: case FNTOP_LENGTH:
+  case SPC_LENGTH: case XSPC_LENGTH:
+    return 2;
+  default:
+    return 0;
+  }
+}
+
+tree
+edit_env_rep::decode_tmlen (string s) {
+  // Lengths in absolute and font units are cached per string;
+  // the latter are forgotten whenever the font changes
+  if (fixed_lengths->contains (s)) return fixed_lengths[s];
+  if (fn.rep != length_font.rep) {
+    if (N(font_lengths) != 0) font_lengths= hashmap<string,tree> (UNINIT);
+    length_font= fn;
+  }
+  if (font_lengths->contains (s)) return font_lengths[s];
+  int start= 0, n=N(s);
+  while ((start+1<n) && (s[start]=='-') && (s[start+1]=='-')) start += 2;
+  double len;
+  string unit;
+  parse_length (s (start, n), len, unit);
+  if (unit == "error" || is_empty (unit)) {
+    tree r (TMLEN, "0");
+    fixed_lengths (s)= r;
+    return r;
+  }
+  tree u= compound (unit * "-length");
+  tree r= tmlen_times (len, as_tmlen (exec (u)));
+  switch (length_unit_kind (L(u))) {
+  case 1:
+    if (N(fixed_lengths) >= 4096) fixed_lengths= hashmap<string,tree> (UNINIT);
+    fixed_lengths (s)= r;
+    break;
+  case 2:
+    if (N(font_lengths) >= 4096) font_lengths= hashmap<string,tree> (UNINIT);
+    font_lengths (s)= r;
+    break;
+  }
+  return r;
+}
+
 SI
 edit_env_rep::as_length (tree t) {
   tree r= as_tmlen (t);
@@ -542,30 +542,52 @@ void
 edit_env_rep::update_font () {
   fn_size= (int) (((double) get_int (FONT_BASE_SIZE)) *
 		  get_double (FONT_SIZE) + 0.5);
+  if (N(font_lengths) != 0) font_lengths= hashmap<string,tree> (UNINIT);
+  if (mode < 0 || mode > 3) return;
+
+  // Resolved fonts are cached on the values of the font variables,
+  // so that switching back to a previous font avoids the font rules
+  int    sz  = get_script_size (fn_size, index_level);
+  int    fdpi= (int) (magn*dpi);
+  string fam = get_string (FONT), var= get_string (FONT_FAMILY);
+  string ser = get_string (FONT_SERIES), sh= get_string (FONT_SHAPE);
+  string eff = get_string (FONT_EFFECTS);
+  string key = fam * "\t" * var * "\t" * ser * "\t" * sh * "\t" * eff;
+  key << "\t" << as_string (sz) << "\t" << as_string (fdpi);
+  string mfam, mvar, mser, msh;
+  if (mode == 2) {
+    mfam= get_string (MATH_FONT); mvar= get_string (MATH_FONT_FAMILY);
+    mser= get_string (MATH_FONT_SERIES); msh= get_string (MATH_FONT_SHAPE);
+  }
+  if (mode == 3) {
+    mfam= get_string (PROG_FONT); mvar= get_string (PROG_FONT_FAMILY);
+    mser= get_string (PROG_FONT_SERIES); msh= get_string (PROG_FONT_SHAPE);
+  }
+  if (mode >= 2) {
+    key << "\t" << as_string (mode) << "\t" << mfam << "\t" << mvar;
+    key << "\t" << mser << "\t" << msh;
+  }
+  if (font_cache->contains (key)) {
+    fn= font_cache [key];
+    return;
+  }
+
   switch (mode) {
   case 0:
   case 1:
-    fn= smart_font (get_string (FONT), get_string (FONT_FAMILY),
-                    get_string (FONT_SERIES), get_string (FONT_SHAPE),
-                    get_script_size (fn_size, index_level), (int) (magn*dpi));
+    fn= smart_font (fam, var, ser, sh, sz, fdpi);
     break;
   case 2:
-    fn= smart_font (get_string (MATH_FONT), get_string (MATH_FONT_FAMILY),
-                    get_string (MATH_FONT_SERIES), get_string (MATH_FONT_SHAPE),
-                    get_string (FONT), get_string (FONT_FAMILY),
-                    get_string (FONT_SERIES), "mathitalic",
-                    get_script_size (fn_size, index_level), (int) (magn*dpi));
+    fn= smart_font (mfam, mvar, mser, msh,
+                    fam, var, ser, "mathitalic", sz, fdpi);
     break;
   case 3:
-    fn= smart_font (get_string (PROG_FONT), get_string (PROG_FONT_FAMILY),
-                    get_string (PROG_FONT_SERIES), get_string (PROG_FONT_SHAPE),
-                    get_string (FONT), get_string (FONT_FAMILY) * "-tt",
-                    get_string (FONT_SERIES), get_string (FONT_SHAPE),
-                    get_script_size (fn_size, index_level), (int) (magn*dpi));
+    fn= smart_font (mfam, mvar, mser, msh,
+                    fam, var * "-tt", ser, sh, sz, fdpi);
     break;
   }
-  string eff= get_string (FONT_EFFECTS);
   if (N(eff) != 0) fn= apply_effects (fn, eff);
+  font_cache (key)= fn;
 }
 
 int
@@ -850,6 +850,7 @@ join (array<line_item> a, array<line_item> b) {
 
 format
 lazy_paragraph_rep::query (lazy_type request, format fm) {
+  if (known_query (request, fm)) return query_ret;
   if ((request == LAZY_BOX) && (fm->type == QUERY_VSTREAM_WIDTH)) {
     array<line_item> li= a;
     query_vstream_width qvw= (query_vstream_width) fm;
@@ -881,7 +882,7 @@ lazy_paragraph_rep::query (lazy_type request, format fm) {
     if (i<n) w += li[i]->b->x2;
     w= max (w, 1);  // width of a paragraph must be strictly positive for
                     // correct positioning inside tables
-    return make_format_width (w);
+    return remember_query (request, fm, make_format_width (w));
   }
   return lazy_rep::query (request, fm);
 }
@@ -890,6 +891,9 @@ lazy
 lazy_paragraph_rep::produce (lazy_type request, format fm) {
   if (request == type) return this;
   if (request == LAZY_VSTREAM) {
+    // NOTE: formatting the paragraph modifies it, so we may only do it once
+    if (!is_nil (produce_fm) && produce_fm == fm) return produce_ret;
+    forget_query ();
     bool hidden= (N(a) == 0);
     if (fm->type == FORMAT_VSTREAM) {
       format_vstream fs= (format_vstream) fm;
@@ -908,7 +912,9 @@ lazy_paragraph_rep::produce (lazy_type request, format fm) {
         sss->l[i]->spc = space (0, 0, 0);
       }
     /* End hiding code */
-    return lazy_vstream (ip, "", sss->l, sss->sb);
+    produce_fm = fm;
+    produce_ret= lazy_vstream (ip, "", sss->l, sss->sb);
+    return produce_ret;
   }
   return lazy_rep::produce (request, fm);
 }
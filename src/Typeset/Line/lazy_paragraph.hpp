@@ -27,6 +27,8 @@ struct lazy_paragraph_rep: public lazy_rep {
   array<line_item>     a;          // the line items to format
   hashmap<string,tree> style;      // the style parameters
   stacker_rep*         sss;        // the typesetted paragraph
+  format               produce_fm; // format of the production of sss
+  lazy                 produce_ret;// the produced vertical stream
 
 protected:
   array<box>    items;       // the boxes on the line in order
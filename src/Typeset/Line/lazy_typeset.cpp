@@ -40,6 +40,7 @@ lazy_document_rep::lazy_document_rep (edit_env env, tree t, path ip):
 
 format
 lazy_document_rep::query (lazy_type request, format fm) {
+  if (known_query (request, fm)) return query_ret;
   if ((request == LAZY_BOX) && (fm->type == QUERY_VSTREAM_WIDTH)) {
     query_vstream_width qvw= (query_vstream_width) fm;
     array<line_item> before= qvw->before;
@@ -55,7 +56,7 @@ lazy_document_rep::query (lazy_type request, format fm) {
       format_width fmw= (format_width) ret_fm;
       w= max (w, fmw->width);
     }
-    return make_format_width (w);
+    return remember_query (request, fm, make_format_width (w));
   }
   return lazy_rep::query (request, fm);
 }
@@ -64,6 +65,7 @@ lazy
 lazy_document_rep::produce (lazy_type request, format fm) {
   if (request == type) return this;
   if (request == LAZY_VSTREAM) {
+    forget_query ();
     int i, n= N(par);
     SI width= 1;
     array<line_item> before;
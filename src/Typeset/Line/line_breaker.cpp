@@ -11,6 +11,7 @@
 
 #include "Boxes/construct.hpp"
 #include "Format/line_item.hpp"
+#include "sys_utils.hpp"
 #define PEN DI
 
 /******************************************************************************
@@ -59,6 +60,9 @@ struct line_breaker_rep {
   SI  last_spc;
   int pass;
   hashmap<path,lb_info> best;
+  bool fast;         // prune hopeless candidates (see prepare_pruning)
+  bool neg_pen;      // some penalties are negative
+  array<SI> neg;     // lower bound for the width which can be gained back
 
   line_breaker_rep (array<line_item> a, int start, int end,
 		    SI line_width, SI large_width, SI first_spc, SI last_spc);
@@ -70,6 +74,7 @@ struct line_breaker_rep {
   void test_better (path new_pos, path old_pos, int penalty, PEN pen_spc);
   bool propose_break (path new_pos, path old_pos, int penalty, space spc);
   void break_string (line_item item, path pos, int i, space spc);
+  void prepare_pruning ();
   void process (path pos);
   void get_breaks (array<path>& ap, path p);
   array<path> compute_breaks ();
@@ -81,7 +86,7 @@ line_breaker_rep::line_breaker_rep (
     a (a2), start (start2), end (end2),
     line_width (line_width2), large_width (large_width2),
     first_spc (first_spc2), last_spc (last_spc2),
-    best (lb_info ()) {}
+    best (lb_info ()), fast (false), neg_pen (false) {}
 
 /******************************************************************************
 * Some subroutines
@@ -314,6 +319,31 @@ line_breaker_rep::propose_break (path new_pos, path old_pos,
   return spc->min > large_width;
 }
 
+/******************************************************************************
+* Pruning of the search for long paragraphs
+*******************************************************************************
+* The classical search scans all items of a line for each candidate start,
+* in the first pass until the next break after large_width and in the
+* second pass from every position of the paragraph. On long paragraphs
+* without break points, such as verbatim listings, this is quadratic.
+* Two prunings leave the result unchanged:
+*   - In the first pass, only breaks for lines which are not overfull
+*     are proposed, so we may stop as soon as the line is overfull and
+*     no item with a negative width or separation follows.
+*   - Positions which were never reached with a finite penalty cannot
+*     improve any break, unless some penalties are negative.
+******************************************************************************/
+
+void
+line_breaker_rep::prepare_pruning () {
+  neg= array<SI> (end + 1);
+  neg[end]= 0;
+  for (int i=end-1; i>start; i--)
+    neg[i]= neg[i+1] + min (a[i-1]->spc->min, 0) + min (a[i]->b->w (), 0);
+  for (int i=start; i<end; i++)
+    if (a[i]->penalty < 0) neg_pen= true;
+}
+
 /******************************************************************************
 * Fill up a line starting from pos
 ******************************************************************************/
@@ -369,7 +399,10 @@ line_breaker_rep::process (path pos) {
     spc= space (first->b->w());
   }
 
-  if ((pass>1) || (best[pos]->pen < HYPH_INVALID)) {
+  bool hopeless= fast && !neg_pen && (best[pos]->pen == HYPH_INVALID) &&
+                 (best[pos]->pen_spc >= (PEN) 1000000000);
+  SI limit= max (line_width, line_width - last_spc);
+  if (((pass>1) && !hopeless) || (best[pos]->pen < HYPH_INVALID)) {
     // cout << "Process " << pos << ": " << first << "\n";
     for (i=pos->item; i<end; i++) {
       line_item item= a[i];
@@ -387,6 +420,7 @@ line_breaker_rep::process (path pos) {
 	  (spc->min < line_width))
 	if (propose_break (path (i+1), pos, 0, space (line_width)))
 	  break;
+      if (fast && (pass == 1) && (spc->min + neg[i+1] > limit)) break;
     }
     if (i==end) {
       line_width -= last_spc;
@@ -420,6 +454,7 @@ line_breaker_rep::get_breaks (array<path>& ap, path p) {
 array<path>
 line_breaker_rep::compute_breaks () {
   int i;
+  if (fast) prepare_pruning ();
   test_better (path (start), path (), 0, 0);
 
   pass= 1;
@@ -446,6 +481,82 @@ line_breaker_rep::compute_breaks () {
   return ap;
 }
 
+/******************************************************************************
+* Caching line breaks
+*******************************************************************************
+* Line items are rebuilt at each retypesetting, so the cache is keyed by
+* everything the line breaker looks at: the types, widths, separations and
+* penalties of the items, the strings, fonts and languages of the items
+* which might be hyphenated, and the widths of the lines. Hence, no explicit
+* invalidation is needed.
+******************************************************************************/
+
+#define LINE_BREAK_CACHE_SIZE 10000
+
+static int line_breaker_mode= -1;
+
+void
+set_line_breaker (string name) {
+  // "classic" selects the unpruned search, which is useful for comparisons;
+  // the default can be changed through the TEXMACS_LINE_BREAKER variable
+  line_breaker_mode= (name == "classic"? 0: 1);
+}
+
+static bool
+fast_line_breaking () {
+  if (line_breaker_mode < 0) set_line_breaker (get_env ("TEXMACS_LINE_BREAKER"));
+  return line_breaker_mode == 1;
+}
+
+static hashmap<string,array<path> > line_break_cache;
+
+static inline void
+add_key (string& key, SI x) {
+  key << ((char) (x & 255)) << ((char) ((x >> 8) & 255))
+      << ((char) ((x >> 16) & 255)) << ((char) ((x >> 24) & 255));
+}
+
+static inline void
+add_key (string& key, string s) {
+  add_key (key, N(s));
+  key << s;
+}
+
+static string
+line_break_key (array<line_item> a, int start, int end,
+                SI line_width, SI large_width,
+                SI first_spc, SI last_spc, bool ragged)
+{
+  PROFILE_SCOPE ("line breaking");
+  string key;
+  add_key (key, line_width);
+  add_key (key, large_width);
+  add_key (key, first_spc);
+  add_key (key, last_spc);
+  add_key (key, ragged? 1: 0);
+  add_key (key, fast_line_breaking ()? 1: 0);
+  add_key (key, start);
+  for (int i=start; i<end; i++) {
+    line_item item= a[i];
+    add_key (key, item->type);
+    add_key (key, item->penalty);
+    add_key (key, item->b->w ());
+    add_key (key, item->spc->min);
+    add_key (key, item->spc->def);
+    add_key (key, item->spc->max);
+    if (item->type == STRING_ITEM) {
+      add_key (key, item->b->get_leaf_string ());
+      add_key (key, item->b->get_leaf_font ()->res_name);
+      add_key (key, is_nil (item->lan)? string (""): item->lan->res_name);
+    }
+    else if (item->type == CONTROL_ITEM) {
+      add_key (key, (int) L(item->t));
+      if (is_atomic (item->t)) add_key (key, item->t->label);
+    }
+  }
+  return key;
+}
+
 /******************************************************************************
 * The exported line breaking routine
 *******************************************************************************
@@ -462,12 +573,19 @@ line_breaks (array<line_item> a, int start, int end,
 	     SI line_width, SI large_width,
              SI first_spc, SI last_spc, bool ragged)
 {
+  string key= line_break_key (a, start, end, line_width, large_width,
+                              first_spc, last_spc, ragged);
+  if (line_break_cache->contains (key)) return line_break_cache [key];
   int tol= 5;         // extra tolerance of 5tmpt avoid rounding errors when
   line_width += tol;  // the widths of the boxes sum up to precisely 1par
   line_breaker_rep* H=
     tm_new<line_breaker_rep> (a, start, end, line_width, large_width,
                               first_spc, last_spc);
+  H->fast= fast_line_breaking ();
   array<path> ap= ragged? H->compute_ragged_breaks (): H->compute_breaks ();
   tm_delete (H);
+  if (N(line_break_cache) >= LINE_BREAK_CACHE_SIZE)
+    line_break_cache= hashmap<string,array<path> > ();
+  line_break_cache (key)= ap;
   return ap;
 }
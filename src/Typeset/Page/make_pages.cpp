@@ -21,10 +21,12 @@ page_item access (array<page_item> l, path p);
 space as_space (tree t);
 skeleton break_pages (array<page_item> l, space ph, int qual,
 		      space fn_sep, space fnote_sep, space float_sep,
-                      font fn, int first_page);
+                      font fn, int first_page, page_break_memo memo);
 box page_box (path ip, box b, tree page, int page_nr, brush bgc,
               SI width, SI height, SI left, SI top,
 	      SI bot, box header, box footer, SI head_sep, SI foot_sep);
+box page_box (path ip, box b, tree page, int page_nr, brush bgc,
+              SI width, SI height, SI left, SI top, box_maker dec);
 
 box
 pager_rep::pages_format (array<page_item> l, SI ht, SI tcor, SI bcor) {
@@ -175,13 +177,26 @@ pager_rep::pages_make_page (pagelet pg) {
   env->write (PAGE_THE_PAGE, style[PAGE_THE_PAGE]);
   tree page_t= env->exec (compound (PAGE_THE_PAGE));
   bool empty= N (pg->ins) == 0;
-  box header= make_header (empty);
-  box footer= make_footer (empty);
-  brush bgc = make_background (empty);
-  adjust_margins (empty);
-  box page= page_box (ip, lb, page_t, nr, bgc, width, height,
-                      left, top + dtop, top + dtop + text_height,
-                      header, footer, head_sep, foot_sep);
+  box page;
+  if (!show_hf || empty) {
+    box header= make_header (empty);
+    box footer= make_footer (empty);
+    brush bgc = make_background (empty);
+    adjust_margins (empty);
+    page= page_box (ip, lb, page_t, nr, bgc, width, height,
+                    left, top + dtop, top + dtop + text_height,
+                    header, footer, head_sep, foot_sep);
+  }
+  else {
+    // typesetting the headers and footers of all pages takes a large part
+    // of the time needed for opening long documents, so we postpone it
+    // until the pages are displayed
+    brush bgc = make_background (empty);
+    adjust_margins (empty);
+    box_maker dec= make_decoration (left, top + dtop, top + dtop + text_height);
+    page= page_box (ip, lb, page_t, nr, bgc, width, height,
+                    left, top + dtop, dec);
+  }
   if (env->get_string (PAGE_CROP_MARKS) == "") return page;
   bool ls= env->page_landscape;
   string sz= env->get_string (PAGE_CROP_MARKS);
@@ -197,7 +212,7 @@ pager_rep::pages_make () {
   space ht (text_height- may_shrink, text_height, text_height+ may_extend);
   skeleton sk=
     break_pages (l, ht, quality, fn_sep, fnote_sep, float_sep,
-                 env->fn, env->first_page);
+                 env->fn, env->first_page, memo);
   int i, n= N(sk);
   for (i=0; i<n; i++)
     pages << pages_make_page (sk[i]);
@@ -208,7 +223,7 @@ pager_rep::papyrus_make () {
   space ht (MAX_SI >> 1);
   skeleton sk=
     break_pages (l, ht, quality, fn_sep, fnote_sep, float_sep,
-                 env->fn, env->first_page);
+                 env->fn, env->first_page, memo);
   if (N(sk) != 1) {
     failed_error << "Number of pages: " << N(sk) << "\n";
     FAILED ("unexpected situation");
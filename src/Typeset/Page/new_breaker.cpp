@@ -10,6 +10,7 @@
 ******************************************************************************/
 
 #include "new_breaker.hpp"
+#include "pager.hpp"
 
 /******************************************************************************
 * Float placement subroutines
@@ -253,8 +254,17 @@ new_breaker_rep::compute_space (path b1, path b2) {
 
 /******************************************************************************
 * Find page breaks for a given start
+*
+* The break states are pairs of a page item and the pending floats which
+* are deferred to later pages.  Every item yields one state for each way
+* to flush the oldest pending floats, so that the number of states grows
+* with the number of pending floats.  We bound the lookahead by forcing
+* the oldest floats onto the current page when too many of them are
+* pending; in practice, such placements are far too bad to be optimal.
 ******************************************************************************/
 
+#define MAX_DEFERRED_FLOATS 8
+
 bool
 new_breaker_rep::last_break (path b) {
   return last_page_flag && (b == path (N(l)) ||
@@ -306,7 +316,13 @@ new_breaker_rep::find_page_breaks (path b1) {
           }
         }
       }
-      b2= path (i+1, floats);
+      path pending= floats;
+      int nr= N(floats) >> 1;
+      while (nr > MAX_DEFERRED_FLOATS) {
+        pending= pending->next->next;
+        nr--;
+      }
+      b2= path (i+1, pending);
     }
     if (b2->item > n) break;
     bool break_page= must_break[b2->item];
@@ -715,12 +731,112 @@ new_breaker_rep::assemble_skeleton (skeleton& sk, path end, int& offset) {
       offset= as_int (l[i]->t[2]->label) - N(sk);
 }
 
+/******************************************************************************
+* Incremental page breaking
+*
+* Pages never extend beyond a forced new page and pending floats are not
+* postponed across it, so that the pages before a new page only depend
+* on the page items before it. When the page items of the previous call
+* coincide with the current ones until some point, we keep the pages until
+* the last new page before that point and only break the remaining items.
+* This is only exact for professional page breaking, since the faster
+* modes do not examine all candidate breaks.  The previous call is
+* remembered by each typesetter, together with which it is freed.
+******************************************************************************/
+
+static bool
+same_page_item (page_item it1, page_item it2) {
+  // page items of unchanged paragraphs are sometimes copied by merge_stack
+  if (it1 == it2) return true;
+  return it1->type == it2->type && it1->b == it2->b &&
+         it1->spc == it2->spc && it1->penalty == it2->penalty &&
+         it1->nr_cols == it2->nr_cols && it1->fl == it2->fl &&
+         it1->t == it2->t;
+}
+
+static bool
+has_wide_footnotes (page_item item) {
+  // footnotes which might be migrated by the constructor of new_breaker_rep
+  for (int j=0; j<N(item->fl); j++) {
+    lazy_vstream lvs= (lazy_vstream) item->fl[j];
+    if (is_tuple (lvs->channel, "footnote") &&
+        N(lvs->l) > 0 && lvs->l[0]->nr_cols != 1) return true;
+  }
+  return false;
+}
+
+static int
+stable_break (array<page_item> l, array<page_item> old) {
+  // last forced new page such that all previous page items are unchanged
+  int i, n= min (N(l), N(old)), r= -1;
+  for (i=0; i<n; i++) {
+    if (!same_page_item (l[i], old[i])) break;
+    if (l[i]->nr_cols != 1 || has_wide_footnotes (l[i])) break;
+    if (l[i]->type == PAGE_CONTROL_ITEM) {
+      if (is_tuple (l[i]->t, "env_page") && l[i]->t[1] == PAGE_NR) break;
+      if (l[i]->t == NEW_PAGE || l[i]->t == NEW_DPAGE) r= i;
+    }
+  }
+  return r;
+}
+
+static int
+first_item (pagelet pg) {
+  // index of the first page item on a page, or -1 for blank pages
+  int r= -1;
+  for (int i=0; i<N(pg->ins); i++) {
+    insertion ins= pg->ins[i];
+    int k= -1;
+    if (!is_nil (ins->begin)) k= ins->begin->item;
+    for (int j=0; j<N(ins->sk) && k<0; j++) k= first_item (ins->sk[j]);
+    if (k >= 0 && (r < 0 || k < r)) r= k;
+  }
+  return r;
+}
+
+static path
+shift (path p, int delta) {
+  if (is_nil (p)) return p;
+  return path (p->item + delta, p->next);
+}
+
+static skeleton shift (skeleton sk, int delta);
+
+static insertion
+shift (insertion ins, int delta) {
+  insertion r (ins->type, shift (ins->begin, delta), shift (ins->end, delta));
+  r->sk     = shift (ins->sk, delta);
+  r->ht     = ins->ht;
+  r->xh     = ins->xh;
+  r->pen    = ins->pen;
+  r->stretch= ins->stretch;
+  r->top_cor= ins->top_cor;
+  r->bot_cor= ins->bot_cor;
+  r->nr_cols= ins->nr_cols;
+  return r;
+}
+
+static skeleton
+shift (skeleton sk, int delta) {
+  skeleton r;
+  for (int i=0; i<N(sk); i++) {
+    pagelet pg (0);
+    for (int j=0; j<N(sk[i]->ins); j++)
+      pg->ins << shift (sk[i]->ins[j], delta);
+    pg->ht     = sk[i]->ht;
+    pg->pen    = sk[i]->pen;
+    pg->stretch= sk[i]->stretch;
+    r << pg;
+  }
+  return r;
+}
+
 /******************************************************************************
 * The exported page breaking routine
 ******************************************************************************/
 
-skeleton
-new_break_pages (array<page_item> l, space ph, int qual,
+static skeleton
+break_all_pages (array<page_item> l, space ph, int qual,
                  space fn_sep, space fnote_sep, space float_sep,
                  font fn, int first_page)
 {
@@ -737,3 +853,36 @@ new_break_pages (array<page_item> l, space ph, int qual,
   tm_delete (H);
   return sk;
 }
+
+skeleton
+new_break_pages (array<page_item> l, space ph, int qual,
+                 space fn_sep, space fnote_sep, space float_sep,
+                 font fn, int first_page, page_break_memo M)
+{
+  int f= -1, p= 0;
+  if (M->ph == ph && M->qual == qual && M->fn_sep == fn_sep &&
+      M->fnote_sep == fnote_sep && M->float_sep == float_sep &&
+      M->fn_name == fn->res_name && M->first_page == first_page &&
+      qual > 1 && ph != (MAX_SI >> 1))
+    f= stable_break (l, M->l);
+  if (f > 0)
+    for (p= N(M->sk); p > 0; p--) {
+      int k= first_item (M->sk[p-1]);
+      if (k >= 0 && k < f) break;
+    }
+
+  skeleton sk;
+  if (p == 0) sk= break_all_pages (l, ph, qual, fn_sep, fnote_sep, float_sep,
+                                   fn, first_page);
+  else {
+    array<page_item> tail= range (l, f, N(l));
+    sk= range (M->sk, 0, p);
+    sk << shift (break_all_pages (tail, ph, qual, fn_sep, fnote_sep,
+                                  float_sep, fn, first_page + p), f);
+  }
+  M->l= copy (l); M->ph= ph; M->qual= qual;
+  M->fn_sep= fn_sep; M->fnote_sep= fnote_sep; M->float_sep= float_sep;
+  M->fn_name= fn->res_name; M->first_page= first_page;
+  M->sk= sk;
+  return sk;
+}
@@ -13,6 +13,7 @@
 #include "vpenalty.hpp"
 #include "skeleton.hpp"
 #include "boot.hpp"
+#include "pager.hpp"
 
 #include "merge_sort.hpp"
 void sort (pagelet& pg);
@@ -158,10 +159,14 @@ page_breaker_rep::page_breaker_rep (
 
 bool
 var_path_inf_eq (path p1, path p2) {
-  if (is_nil (p1) || is_nil (p2)) return is_nil (p1);
-  if (p1->item<p2->item) return true;
-  if (p1->item>p2->item) return false;
-  return var_path_inf_eq (p1->next, p2->next);
+  path *a= &p1, *b= &p2;
+  while (!is_nil (*a) && !is_nil (*b)) {
+    if (strong_equal (*a, *b)) return true;
+    if ((*a)->item < (*b)->item) return true;
+    if ((*a)->item > (*b)->item) return false;
+    a= &((*a)->next); b= &((*b)->next);
+  }
+  return is_nil (*a);
 }
 
 static int
@@ -1500,16 +1505,16 @@ page_breaker_rep::make_skeleton () {
 
 skeleton new_break_pages (array<page_item> l, space ph, int qual,
                           space fn_sep, space fnote_sep, space float_sep,
-                          font fn, int first_page);
+                          font fn, int first_page, page_break_memo memo);
 
 skeleton
 break_pages (array<page_item> l, space ph, int qual,
 	     space fn_sep, space fnote_sep, space float_sep,
-             font fn, int first_page)
+             font fn, int first_page, page_break_memo memo)
 {
   if (get_user_preference ("new style page breaking") != "off")
     return new_break_pages (l, ph, qual, fn_sep, fnote_sep, float_sep,
-                            fn, first_page);
+                            fn, first_page, memo);
   else {
     page_breaker_rep* H=
       tm_new<page_breaker_rep> (l, ph, qual, fn_sep, fnote_sep, float_sep,
@@ -16,8 +16,9 @@
 * Routines for the pager class
 ******************************************************************************/
 
-pager_rep::pager_rep (path ip2, edit_env env2, array<page_item> l2):
-  ip (ip2), env (env2), style (UNINIT), l (l2)
+pager_rep::pager_rep (path ip2, edit_env env2, array<page_item> l2,
+                      page_break_memo memo2):
+  ip (ip2), env (env2), style (UNINIT), l (l2), memo (memo2)
 {
   style (PAGE_THE_PAGE)     = tree (MACRO, compound ("page-nr"));
   style (PAGE_ODD_HEADER)   = env->read (PAGE_ODD_HEADER);
@@ -146,6 +147,17 @@ page_box (path ip, box b, tree page, int page_nr, brush bgc,
 		   decs, decs_x, decs_y);
 }
 
+box
+page_box (path ip, box b, tree page, int page_nr, brush bgc,
+	  SI width, SI height, SI left, SI top, box_maker dec)
+{
+  array<box> bs     (1); bs     [0]= b;
+  array<SI>  bs_x   (1); bs_x   [0]= left;
+  array<SI>  bs_y   (1); bs_y   [0]= -top;
+  return page_box (ip, page, page_nr, bgc, width, height,
+		   bs, bs_x, bs_y, dec);
+}
+
 /******************************************************************************
 * Typesetting a page
 ******************************************************************************/
@@ -189,34 +201,106 @@ pager_rep::end_page (bool flag) {
 }
 */
 
-box
-pager_rep::make_header (bool empty_flag) {
-  if (!show_hf || empty_flag) return empty_box (decorate ());
-  env->write (PAGE_NR, as_string (N(pages)+1+page_offset));
-  env->write (PAGE_THE_PAGE, style[PAGE_THE_PAGE]);
-  tree old= env->local_begin (PAR_COLUMNS, "1");
+tree
+pager_rep::header_source () {
   string which= (N(pages)&1)==0? PAGE_ODD_HEADER: PAGE_EVEN_HEADER;
   if (style [PAGE_THIS_HEADER] != "") which= PAGE_THIS_HEADER;
-  box b= typeset_as_concat (env, attach_here (tree (PARA, style[which]),
-					      decorate()));
+  tree t= style[which];
   style (PAGE_THIS_HEADER) = "";
+  return t;
+}
+
+tree
+pager_rep::footer_source () {
+  string which= (N(pages)&1)==0? PAGE_ODD_FOOTER: PAGE_EVEN_FOOTER;
+  if (style [PAGE_THIS_FOOTER] != "") which= PAGE_THIS_FOOTER;
+  tree t= style[which];
+  style (PAGE_THIS_FOOTER) = "";
+  return t;
+}
+
+static box
+typeset_page_decoration (edit_env env, tree t, string nr, tree the_page) {
+  env->write (PAGE_NR, nr);
+  env->write (PAGE_THE_PAGE, the_page);
+  tree old= env->local_begin (PAR_COLUMNS, "1");
+  box b= typeset_as_concat (env, attach_here (tree (PARA, t), decorate()));
   env->local_end (PAR_COLUMNS, old);
   return b;
 }
 
+box
+pager_rep::make_header (bool empty_flag) {
+  if (!show_hf || empty_flag) return empty_box (decorate ());
+  tree t= header_source ();
+  return typeset_page_decoration (env, t, as_string (N(pages)+1+page_offset),
+                                  style[PAGE_THE_PAGE]);
+}
+
 box
 pager_rep::make_footer (bool empty_flag) {
   if (!show_hf || empty_flag) return empty_box (decorate ());
-  env->write (PAGE_NR, as_string (N(pages)+1+page_offset));
-  env->write (PAGE_THE_PAGE, style[PAGE_THE_PAGE]);
+  tree t= footer_source ();
+  return typeset_page_decoration (env, t, as_string (N(pages)+1+page_offset),
+                                  style[PAGE_THE_PAGE]);
+}
+
+/******************************************************************************
+* Headers and footers are only typeset when their page is displayed
+******************************************************************************/
+
+struct page_decoration_rep: public box_maker_rep {
+  edit_env env;
+  path     ip;
+  tree     header, footer;
+  string   nr;
+  tree     the_page;
+  SI       left, top, bot, head_sep, foot_sep;
+
+  page_decoration_rep (edit_env env2, path ip2, tree h, tree f,
+                       string nr2, tree p, SI l, SI t, SI b, SI hs, SI fs):
+    env (env2), ip (ip2), header (h), footer (f), nr (nr2), the_page (p),
+    left (l), top (t), bot (b), head_sep (hs), foot_sep (fs) {}
+
+  box produce () {
+    // the header and footer were evaluated when the page was made, so that
+    // only their typesetting depends on the environment at display time;
+    // the typesetting of the document left the page number of its
+    // last page in the environment, which is preserved
+    tree old_nr  = env->read (PAGE_NR);
+    tree old_page= env->read (PAGE_THE_PAGE);
+    box hb= typeset_page_decoration (env, header, nr, the_page);
+    box fb= typeset_page_decoration (env, footer, nr, the_page);
+    env->write (PAGE_NR, old_nr);
+    env->write (PAGE_THE_PAGE, old_page);
+    array<box> decs   (2); decs   [0]= hb  ; decs   [1]= fb;
+    array<SI>  decs_x (2); decs_x [0]= left; decs_x [1]= left;
+    array<SI>  decs_y (2);
+    decs_y [0]= -top- hb->y1+ head_sep;
+    decs_y [1]= -bot- fb->y2- foot_sep;
+    return composite_box (ip, decs, decs_x, decs_y, false);
+  }
+};
+
+static tree
+evaluate_page_decoration (edit_env env, tree t, string nr, tree the_page) {
+  // expand the macros and values in t as if it were typeset right now
+  env->write (PAGE_NR, nr);
+  env->write (PAGE_THE_PAGE, the_page);
   tree old= env->local_begin (PAR_COLUMNS, "1");
-  string which= (N(pages)&1)==0? PAGE_ODD_FOOTER: PAGE_EVEN_FOOTER;
-  if (style [PAGE_THIS_FOOTER] != "") which= PAGE_THIS_FOOTER;
-  box b= typeset_as_concat (env, attach_here (tree (PARA, style[which]),
-					      decorate()));
-  style (PAGE_THIS_FOOTER) = "";
+  tree r= env->exec (t);
   env->local_end (PAR_COLUMNS, old);
-  return b;
+  return r;
+}
+
+box_maker
+pager_rep::make_decoration (SI left, SI top, SI bot) {
+  string nr= as_string (N(pages)+1+page_offset);
+  tree   tp= style[PAGE_THE_PAGE];
+  tree   hs= evaluate_page_decoration (env, header_source (), nr, tp);
+  tree   fs= evaluate_page_decoration (env, footer_source (), nr, tp);
+  return tm_new<page_decoration_rep> (env, ip, hs, fs, nr, tp,
+                                      left, top, bot, head_sep, foot_sep);
 }
 
 brush
@@ -17,12 +17,30 @@
 #include "Format/stack_border.hpp"
 #include "Page/skeleton.hpp"
 
+class box_maker;
+
+// the last page breaking of a typesetter, for incremental page breaking
+struct page_break_memo_rep: concrete_struct {
+  array<page_item> l;
+  space    ph, fn_sep, fnote_sep, float_sep;
+  string   fn_name;
+  int      qual, first_page;
+  skeleton sk;
+};
+
+struct page_break_memo {
+  CONCRETE(page_break_memo);
+  inline page_break_memo (): rep (tm_new<page_break_memo_rep> ()) {}
+};
+CONCRETE_CODE(page_break_memo);
+
 class pager_rep {
 public:
   path                 ip;
   edit_env             env;
   hashmap<string,tree> style;
   array<page_item>     l;
+  page_break_memo      memo;
 
   bool         paper;
   int          quality;
@@ -72,13 +90,16 @@ protected: // making page boxes
   void papyrus_make ();
 
 public:
-  pager_rep (path ip, edit_env env, array<page_item> l);
+  pager_rep (path ip, edit_env env, array<page_item> l, page_break_memo memo);
 
   //void start_page ();
   //void print (page_item item);
   //void end_page (bool flag);
+  tree  header_source ();
+  tree  footer_source ();
   box   make_header (bool empty_flag);
   box   make_footer (bool empty_flag);
+  box_maker make_decoration (SI left, SI top, SI bot);
   brush make_background (bool empty_flag);
   void  adjust_margins (bool empty_flag);
   box   make_pages ();
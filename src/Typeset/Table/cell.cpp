@@ -20,6 +20,13 @@
 cell_rep::cell_rep (edit_env env2):
   var (""), env (env2), border_flags (0) {}
 
+void
+cell_rep::restore (cell c) {
+  int rc= ref_count;
+  *this= *(c.operator -> ());
+  ref_count= rc;
+}
+
 void
 cell_rep::typeset (tree fm, tree t, path iq) {
   ip= iq;
@@ -16,6 +16,67 @@
 
 lazy make_lazy_paragraph (edit_env env, array<box> bs, path ip);
 
+/******************************************************************************
+* Reusing the cells of big tables
+******************************************************************************/
+
+#define TABLE_CACHE_MIN 64   // minimal number of cells of cached tables
+#define TABLE_CACHE_MAX 16   // maximal number of cached tables
+
+static hashmap<path,table_cache> table_caches;
+
+table_cache_rep::table_cache_rep (hashmap<string,tree> env2):
+  env (env2), src (UNINIT), fm (UNINIT), cells () {}
+
+static bool
+is_plain (tree t) {
+  // cells whose typesetting only depends on the environment
+  // and which do not modify the environment
+  if (is_atomic (t)) return true;
+  switch (L(t)) {
+  case CELL: case CONCAT:
+  case LEFT: case MID: case RIGHT: case BIG:
+  case LPRIME: case RPRIME: case BELOW: case ABOVE:
+  case LSUB: case LSUP: case RSUB: case RSUP:
+  case FRAC: case SQRT: case WIDE: case VAR_WIDE: case NEG:
+    for (int i=0; i<N(t); i++)
+      if (!is_plain (t[i])) return false;
+    return true;
+  default:
+    return false;
+  }
+}
+
+void
+table_rep::typeset_cell (cell& C, tree fm, tree t, path ip) {
+  if (!is_nil (reuse) && reuse->cells->contains (ip)) {
+    cell R= reuse->cells[ip];
+    if (R->border_flags == C->border_flags &&
+        reuse->fm[ip] == fm && reuse->src[ip] == t) {
+      C->restore (R);
+      cache->cells (ip)= R;
+      cache->fm (ip)= reuse->fm[ip];
+      cache->src (ip)= reuse->src[ip];
+      return;
+    }
+  }
+  C->typeset (fm, t, ip);
+  if (!is_plain (t)) {
+    // the cell may have modified the environment of the next cells,
+    // so that these are neither reused nor remembered
+    reuse= table_cache ();
+    cache= table_cache ();
+  }
+  else if (!is_nil (cache) &&
+      is_nil (C->T) && is_nil (C->D) && is_nil (C->lz)) {
+    cell R (env);
+    R->restore (C);
+    cache->cells (ip)= R;
+    cache->fm (ip)= fm;
+    cache->src (ip)= copy (t);
+  }
+}
+
 /******************************************************************************
 * Tables
 ******************************************************************************/
@@ -90,6 +151,21 @@ table_rep::typeset_table (tree fm, tree t, path ip) {
   nr_cols= 0;
   T= tm_new_array<cell*> (nr_rows);
   for (i=0; i<nr_rows; i++) T[i]= NULL;
+  bool big= status == 0 && nr_rows > 0 &&
+            nr_rows * N(t[0]) >= TABLE_CACHE_MIN;
+  table_cache keep;
+  if (big) {
+    // the environment is only copied when it changed since last time
+    reuse= table_caches[ip];
+    if (!is_nil (reuse) && !env->same_env (reuse->env)) reuse= table_cache ();
+    if (!is_nil (reuse)) cache= table_cache (reuse->env);
+    else {
+      hashmap<string,tree> snap;
+      env->read_env (snap);
+      cache= table_cache (snap);
+    }
+    keep= cache;
+  }
   STACK_NEW_ARRAY (subformat, tree, nr_rows);
   extract_format (fm, subformat, nr_rows);
   for (i=0; i<nr_rows; i++) {
@@ -98,6 +174,13 @@ table_rep::typeset_table (tree fm, tree t, path ip) {
     env->local_end (CELL_ROW_NR, old);
   }
   STACK_DELETE_ARRAY (subformat);
+  if (big) {
+    if (N(table_caches) >= TABLE_CACHE_MAX)
+      table_caches= hashmap<path,table_cache> ();
+    table_caches (ip)= keep;
+    reuse= table_cache ();
+    cache= table_cache ();
+  }
   mw= tm_new_array<SI> (nr_cols);
   lw= tm_new_array<SI> (nr_cols);
   rw= tm_new_array<SI> (nr_cols);
@@ -105,6 +188,10 @@ table_rep::typeset_table (tree fm, tree t, path ip) {
 
 void
 table_rep::typeset_row (int i, tree fm, tree t, path ip) {
+  // NOTE: the cells are typeset one after another in the shared edit_env,
+  // which is modified by local_begin and local_end; typesetting also fills
+  // global font and glyph caches and may call scheme, so that cells cannot
+  // be handled by parallel_for.  Unchanged cells of big tables are reused.
   //ASSERT (i==0 || nr_cols == N(t), "inconsistent number of columns");
   int j;
   nr_cols= (i==0? N(t): min (nr_cols, N(t)));
@@ -117,7 +204,7 @@ table_rep::typeset_row (int i, tree fm, tree t, path ip) {
     if (i == 0) C->border_flags += 1;
     if (i == nr_rows-1) C->border_flags += 2;
     tree old= env->local_begin (CELL_COL_NR, as_string (j));
-    C->typeset (subformat[j], t[j], descend (ip, j));
+    typeset_cell (C, subformat[j], t[j], descend (ip, j));
     env->local_end (CELL_COL_NR, old);
     C->row_span= min (C->row_span, nr_rows- i);
     C->col_span= min (C->col_span, nr_cols- j);
@@ -784,6 +871,9 @@ table_rep::var_finish () {
     return bs;
   }
 
+  // the rows are emitted one by one and the cells of each row are
+  // released as soon as its box has been made; only the row boxes
+  // remain for the page breaking of very long tables
   int i, j;
   array<box> stack;
   for (i=0; i<nr_rows; i++) {
@@ -798,6 +888,8 @@ table_rep::var_finish () {
         x  << C->x1;
         y  << (C->y1 + C->shift);
       }
+    tm_delete_array (T[i]);
+    T[i]= NULL;
     if (N(bs)==0) continue;
 
     box   tb= composite_box (ip, bs, x, y, false);
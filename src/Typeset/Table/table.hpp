@@ -19,6 +19,12 @@
 
 class cell;
 class table;
+class table_cache_rep;
+
+class table_cache {
+  CONCRETE_NULL(table_cache);
+  table_cache (hashmap<string,tree> env);
+};
 
 class table_rep: public concrete_struct {
 protected:
@@ -60,6 +66,8 @@ public:
   string   hyphen;            // vertical hypenation
   int      row_origin;        // row span (not yet implemented)
   int      col_origin;        // column span (not yet implemented)
+  table_cache reuse;          // cells of the previous typesetting
+  table_cache cache;          // cells which may be reused next time
 
   table_rep (edit_env env, int status, int i0, int j0);
   ~table_rep ();
@@ -68,6 +76,7 @@ public:
   void typeset (tree t, path ip);
   void typeset_table (tree fm, tree t, path ip);
   void typeset_row (int i, tree fm, tree t, path ip);
+  void typeset_cell (cell& C, tree fm, tree t, path ip);
   void format_table (tree fm);
   void format_item (tree with);
   void handle_decorations ();
@@ -141,6 +150,7 @@ public:
   table    T;                 // potential subtable
 
   cell_rep (edit_env env);
+  void restore (cell c);
 
   void typeset (tree fm, tree t, path ip);
   void cell_local_begin (tree fm);
@@ -162,6 +172,20 @@ class cell {
 };
 CONCRETE_NULL_CODE(cell);
 
+class table_cache_rep: public concrete_struct {
+public:
+  hashmap<string,tree> env;   // environment at the start of the table
+  hashmap<path,tree>   src;   // copies of the cells, by source location
+  hashmap<path,tree>   fm;    // formats of the cells
+  hashmap<path,cell>   cells; // the cells just after their typesetting
+
+  table_cache_rep (hashmap<string,tree> env);
+};
+CONCRETE_NULL_CODE(table_cache);
+
+inline table_cache::table_cache (hashmap<string,tree> env):
+  rep (tm_new<table_cache_rep> (env)) {}
+
 void extract_format (tree fm, tree* r, int n);
 
 #endif // defined TABLE_H
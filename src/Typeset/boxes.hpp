@@ -152,6 +152,7 @@ public:
   virtual path find_tag (string name);
 
   virtual int  reindex (int i, int item, int n);
+  virtual bool find_visible (SI x1, SI y1, SI x2, SI y2, array<int>& ks);
   virtual void redraw (renderer ren, path p, rectangles& l);
   virtual void redraw_background (renderer ren);
   void redraw (renderer ren, path p, rectangles& l, SI x, SI y);
@@ -232,6 +233,7 @@ public:
   virtual SI             graphical_distance (SI x, SI y);
   virtual gr_selections  graphical_select (SI x, SI y, SI dist);
   virtual gr_selections  graphical_select (SI x1, SI y1, SI x2, SI y2);
+  virtual bool           graphical_bounds (SI& x1, SI& y1, SI& x2, SI& y2);
 
   /************************** retrieving information *************************/
 
@@ -264,6 +266,7 @@ public:
   friend class  phrase_box_rep;
   friend class  remember_box_rep;
   friend struct effect_box_rep;
+  friend struct anim_constant_box_rep;
   friend void make_eps (url dest, box b, int dpi);
   friend void make_raster_image (url dest, box b, double zoom);
 };
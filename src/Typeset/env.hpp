@@ -152,8 +152,16 @@ public:
   hashmap<string,tree>         missing;     // missing refs
   array<tree>                  redefined;   // redefined labels
   hashmap<string,bool>         touched;     // touched refs
+  bool                         refining;    // only typeset dependents ?
+  hashmap<string,bool>         changed;     // refs with outdated readers
+  int                          ref_reader;  // paragraph being typeset
+  hashmap<string,array<int> >  ref_readers; // paragraphs which read refs
   link_repository              link_env;    // current links
   array<array<int> >           size_cache;  // math font size cache
+  hashmap<string,tree>         fixed_lengths; // lengths in absolute units
+  hashmap<string,tree>         font_lengths;  // lengths in font units
+  font                         length_font;   // font for font_lengths
+  hashmap<string,font>         font_cache;    // fonts for font variables
 
   int          dpi;
   double       inch;
@@ -369,6 +377,7 @@ private:
   tree exec_find_accessible (tree t);
   tree exec_set_binding (tree t);
   tree exec_get_binding (tree t);
+  void read_binding (string key);
   tree exec_has_binding (tree t);
   tree exec_get_attachment (tree t);
 
@@ -472,6 +481,7 @@ public:
   void monitored_patch_env (hashmap<string,tree> patch);
   void patch_env (hashmap<string,tree> patch);
   void read_env (hashmap<string,tree>& ret);
+  bool same_env (hashmap<string,tree> h);
   void local_start (hashmap<string,tree>& prev_back);
   void local_update (hashmap<string,tree>& oldpat, hashmap<string,tree>& chg);
   void local_end (hashmap<string,tree>& prev_back);
@@ -522,6 +532,7 @@ public:
   double    divide_lengths (string l1, string l2);
 
   tree      as_tmlen (tree t);
+  tree      decode_tmlen (string s);
   SI        as_length (tree t);
   SI        as_length (tree t, string perc);
   SI        as_eff_length (tree t);
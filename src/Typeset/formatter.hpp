@@ -68,11 +68,22 @@ struct lazy_rep: public abstract_struct {
   lazy_type type;  // the lazy type
   path ip;         // source location
 
-  inline  lazy_rep (lazy_type type2, path ip2): type (type2), ip (ip2) {
-    TM_DEBUG (lazy_count++); }
+  lazy_type query_request;  // request of the last query
+  format    query_fm;       // format of the last query
+  format    query_ret;      // result of the last query
+
+  inline  lazy_rep (lazy_type type2, path ip2):
+    type (type2), ip (ip2), query_request (type2) {
+      TM_DEBUG (lazy_count++); }
   inline  virtual ~lazy_rep () {
     TM_DEBUG (lazy_count--); }
 
+  inline bool known_query (lazy_type request, format fm) {
+    return !is_nil (query_fm) && query_request == request && query_fm == fm; }
+  inline format remember_query (lazy_type request, format fm, format ret) {
+    query_request= request; query_fm= fm; query_ret= ret; return ret; }
+  inline void forget_query () { query_fm= format (); query_ret= format (); }
+
   virtual operator tree () = 0;
   virtual void append (lazy lz);
   virtual lazy produce (lazy_type request, format fm);
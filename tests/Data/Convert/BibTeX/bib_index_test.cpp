@@ -0,0 +1,65 @@
+
+/******************************************************************************
+* MODULE     : bib_index_test.cpp
+* DESCRIPTION: test the indexes of BibTeX files
+* COPYRIGHT  : (C) 2020  Joris van der Hoeven
+*******************************************************************************
+* This software falls under the GNU general public license version 3 or later.
+* It comes WITHOUT ANY WARRANTY WHATSOEVER. For details, see the file LICENSE
+* in the root directory or <http://www.gnu.org/licenses/gpl-3.0.html>.
+******************************************************************************/
+
+#include "gtest/gtest.h"
+#include "BibTeX/bib_index.hpp"
+#include "analyze.hpp"
+
+static string bib_sample=
+  "% a comment with @fake{entry,\n"
+  "@String{ams = \"American Mathematical Society\"}\n"
+  "@article{knuth84,\n  title = {Literate {P}rogramming},\n"
+  "  journal = ams}\n"
+  "Some text between the entries\n"
+  "@comment{ignored, this is not an entry}\n"
+  "@Book( lamport94, title = \"\\LaTeX\" )\n"
+  "@preamble{\"\\newcommand{\\noop}[1]{}\"}\n"
+  "@misc{knuth84, note = {duplicate}}\n";
+
+TEST (bib_index, make) {
+  bib_index ix= make_bib_index (bib_sample);
+  ASSERT_EQ (N(ix->keys), 2);
+  EXPECT_TRUE (ix->keys[0] == "knuth84");
+  EXPECT_TRUE (ix->keys[1] == "lamport94");
+  EXPECT_EQ (N(ix->pro_start), 2);
+  int k= ix->where ["lamport94"];
+  EXPECT_TRUE (bib_sample (ix->start[k], ix->end[k]) ==
+               "@Book( lamport94, title = \"\\LaTeX\" )");
+  EXPECT_TRUE (starts (bib_sample (ix->start[0], ix->end[0]), "@article"));
+  EXPECT_EQ (bib_sample [ix->end[0] - 1], '}');
+}
+
+TEST (bib_index, source) {
+  bib_index ix= make_bib_index (bib_sample);
+  array<string> keys;
+  keys << string ("lamport94") << string ("unknown");
+  string src= bib_index_source (ix, bib_sample, keys);
+  EXPECT_TRUE (starts (src, "@String{ams"));
+  EXPECT_TRUE (ends (src, "@Book( lamport94, title = \"\\LaTeX\" )\n"));
+  EXPECT_EQ (search_forwards ("knuth84", src), -1);
+}
+
+TEST (bib_index, serialization) {
+  bib_index ix= make_bib_index (bib_sample);
+  ix->size = N(bib_sample);
+  ix->stamp= 12345;
+  bib_index iy= as_bib_index (as_string (ix));
+  EXPECT_EQ (iy->size, ix->size);
+  EXPECT_EQ (iy->stamp, 12345);
+  ASSERT_EQ (N(iy->keys), N(ix->keys));
+  for (int i=0; i<N(ix->keys); i++) {
+    EXPECT_TRUE (iy->keys[i] == ix->keys[i]);
+    EXPECT_EQ (iy->start[i], ix->start[i]);
+    EXPECT_EQ (iy->end[i], ix->end[i]);
+  }
+  EXPECT_EQ (iy->where ["lamport94"], 1);
+  EXPECT_EQ (as_bib_index ("garbage")->size, -1);
+}
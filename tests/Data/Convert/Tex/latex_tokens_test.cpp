@@ -0,0 +1,50 @@
+
+/******************************************************************************
+* MODULE     : latex_tokens_test.cpp
+* DESCRIPTION: test the tokenization of LaTeX control sequences
+* COPYRIGHT  : (C) 2020  Joris van der Hoeven
+*******************************************************************************
+* This software falls under the GNU general public license version 3 or later.
+* It comes WITHOUT ANY WARRANTY WHATSOEVER. For details, see the file LICENSE
+* in the root directory or <http://www.gnu.org/licenses/gpl-3.0.html>.
+******************************************************************************/
+
+#include "gtest/gtest.h"
+#include "Tex/latex_tokens.hpp"
+
+TEST (latex_tokens, tokenize) {
+  string s= "a\\frac{x}{y}\\\\ \\@ifnext*\\alpha1\\";
+  latex_tokens toks;
+  toks.tokenize (s);
+  ASSERT_EQ (N(toks.start), 5);
+  EXPECT_TRUE (latex_command_name (toks.id[0]) == "\\frac");
+  EXPECT_TRUE (latex_command_name (toks.id[1]) == "\\\\");
+  EXPECT_TRUE (latex_command_name (toks.id[2]) == "\\@ifnext");
+  EXPECT_TRUE (latex_command_name (toks.id[3]) == "\\alpha");
+  EXPECT_TRUE (latex_command_name (toks.id[4]) == "\\");
+  for (int k=0; k<N(toks.start); k++)
+    EXPECT_EQ (toks.end[k], latex_command_end (s, toks.start[k]));
+}
+
+TEST (latex_tokens, interning) {
+  int id= latex_command_id ("\\section");
+  EXPECT_EQ (latex_command_id ("\\section"), id);
+  EXPECT_NE (latex_command_id ("\\section*"), id);
+  EXPECT_TRUE (latex_command_name (id) == "\\section");
+}
+
+TEST (latex_tokens, command_at) {
+  string s= "\\begin{a}\\x\\end{a}";
+  latex_tokens toks;
+  toks.tokenize (s);
+  int e;
+  EXPECT_EQ (toks.command_at (s, 9, e), latex_command_id ("\\x"));
+  EXPECT_EQ (e, 11);
+  EXPECT_EQ (toks.command_at (s, 0, e), latex_command_id ("\\begin"));
+  EXPECT_EQ (e, 6);
+  // other strings are scanned directly
+  string t= copy (s);
+  EXPECT_FALSE (toks.contains (t));
+  EXPECT_EQ (toks.command_at (t, 11, e), latex_command_id ("\\end"));
+  EXPECT_EQ (e, 15);
+}
@@ -0,0 +1,39 @@
+/******************************************************************************
+* MODULE     : binarytm_test.cpp
+* DESCRIPTION: test on the binary format for TeXmacs trees
+* COPYRIGHT  : (C) 2020  Joris van der Hoeven
+*******************************************************************************
+* This software falls under the GNU general public license version 3 or later.
+* It comes WITHOUT ANY WARRANTY WHATSOEVER. For details, see the file LICENSE
+* in the root directory or <http://www.gnu.org/licenses/gpl-3.0.html>.
+******************************************************************************/
+
+#include "gtest/gtest.h"
+#include "convert.hpp"
+
+static tree
+sample_document () {
+  tree body (DOCUMENT);
+  for (int i=0; i<300; i++)
+    body << tree (CONCAT, "Paragraph " * as_string (i),
+                  compound ("em", "emphasized"),
+                  tree (WITH, "font-shape", "italic", string ((char) i, i)));
+  body << compound ("user-macro", "", tree (DOCUMENT));
+  return tree (DOCUMENT, compound ("TeXmacs", TEXMACS_VERSION),
+                         compound ("body", body));
+}
+
+TEST (binarytm, round_trip) {
+  tree t= sample_document ();
+  string s= tree_to_binary (t);
+  EXPECT_EQ (is_binary_tree (s), true);
+  EXPECT_EQ (binary_to_tree (s) == t, true);
+  EXPECT_EQ (binary_to_tree (tree_to_binary ("atom")) == tree ("atom"), true);
+}
+
+TEST (binarytm, corrupted) {
+  string s= tree_to_binary (sample_document ());
+  EXPECT_EQ (is_func (binary_to_tree (s (0, N(s) - 1)), ERROR), true);
+  EXPECT_EQ (is_func (binary_to_tree (s * "x"), ERROR), true);
+  EXPECT_EQ (is_func (binary_to_tree ("<TeXmacs|1.0>"), ERROR), true);
+}
@@ -0,0 +1,39 @@
+/******************************************************************************
+* MODULE     : fromtm_test.cpp
+* DESCRIPTION: test on the conversion of TeXmacs documents to trees
+* COPYRIGHT  : (C) 2020  Joris van der Hoeven
+*******************************************************************************
+* This software falls under the GNU general public license version 3 or later.
+* It comes WITHOUT ANY WARRANTY WHATSOEVER. For details, see the file LICENSE
+* in the root directory or <http://www.gnu.org/licenses/gpl-3.0.html>.
+******************************************************************************/
+
+#include "gtest/gtest.h"
+#include "convert.hpp"
+#include "file.hpp"
+
+static array<path> streamed_paths;
+
+static void
+record (void* obj, path p, tree t) {
+  (void) obj; (void) t;
+  streamed_paths << p;
+}
+
+TEST (fromtm, stream) {
+  string s= "<TeXmacs|2.1>\n\n<style|generic>\n\n<\\body>\n";
+  for (int i=0; i<1000; i++)
+    s << "  Paragraph <em|" << as_string (i) << ">\n\n";
+  s << "  Last\n</body>\n\n<initial|<\\collection>\n</collection>>\n";
+  url u= url_temp (".tm");
+  ASSERT_FALSE (save_string (u, s));
+
+  tree doc= texmacs_stream_to_tree (u, record, NULL);
+  EXPECT_EQ (doc == texmacs_document_to_tree (s), true);
+  EXPECT_EQ (N(streamed_paths), 1001 + 4);
+  EXPECT_EQ (streamed_paths[1] == path (1), true);
+  EXPECT_EQ (streamed_paths[2] == path (2, 0), true);
+  EXPECT_EQ (streamed_paths[1002] == path (2, 1000), true);
+  EXPECT_EQ (streamed_paths[1003] == path (2), true);
+  remove (u);
+}
@@ -0,0 +1,55 @@
+
+/******************************************************************************
+* MODULE     : htmlout_test.cpp
+* DESCRIPTION: Serialization of Html scheme trees
+* COPYRIGHT  : (C) 2020  Joris van der Hoeven
+*******************************************************************************
+* This software falls under the GNU general public license version 3 or later.
+* It comes WITHOUT ANY WARRANTY WHATSOEVER. For details, see the file LICENSE
+* in the root directory or <http://www.gnu.org/licenses/gpl-3.0.html>.
+******************************************************************************/
+
+#include "gtest/gtest.h"
+
+#include "convert.hpp"
+#include "file.hpp"
+
+TEST (htmlout, serialize_html) {
+  tree t= tuple ("body",
+    tuple ("p", tuple ("@", tuple ("\"color\"", "\"red\"")),
+           "\"Hallo allemaal laten we eens even kijken hoe het hiermee staat. "
+           "Hallo allemaal laten we eens even kijken hoe het hiermee staat.\""),
+    tuple ("p", tuple ("!concat", "\"Hallo allemaal \"",
+                       tuple ("b", "\"hopsa\""), "\". Grapje\"")),
+    tuple ("p", tuple ("!concat", "\"Hallo allemaal \"",
+                       tuple ("pre", "\"hopsa\""), "\". Grapje\"")));
+  string expected=
+    "<body>\n"
+    "  <p color=\"red\">\n"
+    "    Hallo allemaal laten we eens even kijken hoe het hiermee staat. Hallo\n"
+    "    allemaal laten we eens even kijken hoe het hiermee staat.\n"
+    "  </p>\n"
+    "  <p>\n"
+    "    Hallo allemaal <b>hopsa</b>. Grapje\n"
+    "  </p>\n"
+    "  <p>\n"
+    "    Hallo allemaal <pre>\n"
+    "hopsa</pre>. Grapje\n"
+    "  </p>\n"
+    "</body>";
+  EXPECT_EQ (serialize_html (t), expected);
+}
+
+TEST (htmlout, serialize_html_file) {
+  tree t= tuple ("*TOP*", tuple ("*PI*", "xml", "\"version=\\\"1.0\\\"\""),
+                 tuple ("math", tuple ("@", tuple ("xmlns", "\"m\"")),
+                        tuple ("mi", "\"x\"")));
+  url u= url_temp (".html");
+  ASSERT_FALSE (serialize_html (t, u));
+  string s;
+  ASSERT_FALSE (load_string (u, s, false));
+  EXPECT_EQ (s, serialize_html (t));
+  EXPECT_EQ (s, string ("<?xml version=\"1.0\"?>\n"
+                        "<math xmlns=\"m\"><mi>x</mi></math>"));
+  remove (u);
+}
@@ -13,6 +13,7 @@
 
 #include "convert.hpp"
 #include "drd_std.hpp"
+#include "Xml/xml_handler.hpp"
 
 TEST (xml_html_parser, expand_xml_default_entity) {
   // init_std_drd ();
@@ -23,3 +24,40 @@ TEST (xml_html_parser, expand_xml_default_entity) {
   ASSERT_TRUE (parse_xml ("&apos;") == tuple(tree("*TOP*"), tree("\"'\"")));
   ASSERT_TRUE (parse_xml ("&quot;") == tuple(tree("*TOP*"), tree("\"\\\"\"")));
 }
+
+struct count_handler: public xml_handler {
+  int elements, depth, max_depth;
+  string chars;
+  count_handler (): elements (0), depth (0), max_depth (0) {}
+  void start_element (string name, tree attrs) {
+    (void) name; (void) attrs;
+    elements++; depth++;
+    max_depth= max (depth, max_depth);
+  }
+  void end_element (string name) { (void) name; depth--; }
+  void text (string s) { chars << s; }
+};
+
+TEST (xml_html_parser, events) {
+  count_handler h;
+  parse_xml ("<a><b>x</b><c/><b>y<d>z</d></b></a>", h);
+  ASSERT_EQ (h.elements, 5);
+  ASSERT_EQ (h.depth, 0);
+  ASSERT_EQ (h.max_depth, 3);
+  ASSERT_TRUE (h.chars == "xyz");
+  count_handler g;
+  parse_plain_html ("<ul><li>a<li>b</ul>", g);
+  ASSERT_EQ (g.elements, 3);
+  ASSERT_EQ (g.max_depth, 2);
+}
+
+TEST (xml_html_parser, parse_xml_element) {
+  string s= "<svg width=\"10px\" height=\"20\"><g width=\"5\"/></svg>";
+  tree e= parse_xml_element (s, "svg");
+  ASSERT_TRUE (get_attr_from_element (e, "width", "") == "10px");
+  ASSERT_TRUE (get_attr_from_element (e, "height", "") == "20");
+  ASSERT_TRUE (get_attr_from_element (parse_xml_element (s, "g"), "width", "")
+               == "5");
+  ASSERT_TRUE (get_attr_from_element (parse_xml_element (s, "h"), "width", "")
+               == "");
+}
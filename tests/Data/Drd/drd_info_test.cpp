@@ -0,0 +1,41 @@
+
+/******************************************************************************
+* MODULE     : drd_info_test.cpp
+* DESCRIPTION: test the heuristic initialization of drds
+* COPYRIGHT  : (C) 2020  Joris van der Hoeven
+*******************************************************************************
+* This software falls under the GNU general public license version 3 or later.
+* It comes WITHOUT ANY WARRANTY WHATSOEVER. For details, see the file LICENSE
+* in the root directory or <http://www.gnu.org/licenses/gpl-3.0.html>.
+******************************************************************************/
+
+#include "gtest/gtest.h"
+#include "drd_info.hpp"
+#include "drd_std.hpp"
+#include "vars.hpp"
+
+TEST (drd_info, heuristic_init) {
+  init_std_drd ();
+  drd_info drd ("test", std_drd);
+  hashmap<string,tree> env (UNINIT);
+  env ("foo")= tree (MACRO, "x", tree (WITH, "color", "red", "none"));
+  env ("bar")= tree (MACRO, "y", compound ("foo", tree (ARG, "y")));
+  env ("baz")= "1cm";
+  drd->heuristic_init (env);
+  tree_label foo= make_tree_label ("foo");
+  tree_label bar= make_tree_label ("bar");
+  tree_label baz= make_tree_label ("baz");
+  EXPECT_NE (drd->get_accessible (foo, 0), ACCESSIBLE_ALWAYS);
+  EXPECT_NE (drd->get_accessible (bar, 0), ACCESSIBLE_ALWAYS);
+  EXPECT_EQ (drd->get_type (baz), TYPE_LENGTH);
+
+  // definitions modified in place and the tags which depend on them
+  env ["foo"][1][2]= tree (ARG, "x");
+  drd->heuristic_init (env);
+  EXPECT_EQ (drd->get_accessible (foo, 0), ACCESSIBLE_ALWAYS);
+  EXPECT_EQ (drd->get_accessible (bar, 0), ACCESSIBLE_ALWAYS);
+
+  env ("baz")= "true";
+  drd->heuristic_init (env);
+  EXPECT_EQ (drd->get_type (baz), TYPE_BOOLEAN);
+}
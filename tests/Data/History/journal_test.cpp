@@ -0,0 +1,32 @@
+
+/******************************************************************************
+* MODULE     : journal_test.cpp
+* DESCRIPTION: test the serialization of journals
+* COPYRIGHT  : (C) 2020  Joris van der Hoeven
+*******************************************************************************
+* This software falls under the GNU general public license version 3 or later.
+* It comes WITHOUT ANY WARRANTY WHATSOEVER. For details, see the file LICENSE
+* in the root directory or <http://www.gnu.org/licenses/gpl-3.0.html>.
+******************************************************************************/
+
+#include "gtest/gtest.h"
+#include "journal.hpp"
+
+TEST (journal, serialization) {
+  tree t= compound ("para", "a\nb", compound ("em", "x y"));
+  modification m1= mod_assign (path (1), t);
+  modification m2= mod_insert (path (0, 2), 1, "z");
+  modification m3= mod_remove (path (), 0, 1);
+  string s= as_string (m1) * as_string (m2) * as_string (m3);
+  list<modification> l= as_modifications (s);
+  ASSERT_EQ (N(l), 3);
+  EXPECT_TRUE (l[0] == m1);
+  EXPECT_TRUE (l[1] == m2);
+  EXPECT_TRUE (l[2] == m3);
+}
+
+TEST (journal, truncated) {
+  string s= as_string (mod_insert (path (0), 0, "abc"));
+  list<modification> l= as_modifications (s * s (0, N(s) - 2));
+  EXPECT_EQ (N(l), 1);
+}
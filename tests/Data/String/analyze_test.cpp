@@ -106,3 +106,21 @@ TEST (string, read_word) {
   ASSERT_TRUE (is_empty (word));
   ASSERT_EQ (i, 0);
 }
+
+TEST (string, search_forwards) {
+  ASSERT_EQ (search_forwards ("", 3, "hello"), 3);
+  ASSERT_EQ (search_forwards ("lo", 0, "hello"), 3);
+  ASSERT_EQ (search_forwards ("l", 3, "hello"), 3);
+  ASSERT_EQ (search_forwards ("ll", 3, "hello"), -1);
+  ASSERT_EQ (search_forwards ("hello!", 0, "hello"), -1);
+  ASSERT_EQ (search_forwards ("aab", 0, "aaaaab"), 3);
+  ASSERT_EQ (search_forwards ('l', 0, 3, "hello"), 2);
+  ASSERT_EQ (search_forwards ('o', 0, 3, "hello"), -1);
+}
+
+TEST (string, tm_search_forwards) {
+  ASSERT_EQ (tm_search_forwards ("alpha", 0, "<alpha> alpha"), 8);
+  ASSERT_EQ (tm_search_forwards ("<alpha>", 0, "a<alpha>"), 1);
+  ASSERT_EQ (tm_search_forwards ("a", 0, "<alpha><beta>"), -1);
+  ASSERT_EQ (tm_search_forwards ("b", 0, "<alpha><beta>b"), 13);
+}
@@ -0,0 +1,61 @@
+
+/******************************************************************************
+* MODULE     : base64_test.cpp
+* DESCRIPTION: Base64 encoding and decoding
+* COPYRIGHT  : (C) 2020  Joris van der Hoeven
+*******************************************************************************
+* This software falls under the GNU general public license version 3 or later.
+* It comes WITHOUT ANY WARRANTY WHATSOEVER. For details, see the file LICENSE
+* in the root directory or <http://www.gnu.org/licenses/gpl-3.0.html>.
+******************************************************************************/
+
+#include "gtest/gtest.h"
+
+#include "string.hpp"
+#include "base64.hpp"
+
+static string
+bytes (int n) {
+  string r (n);
+  for (int i=0; i<n; i++) r[i]= (char) ((i * 37 + 11) & 0xff);
+  return r;
+}
+
+TEST (base64, known_vectors) {
+  ASSERT_TRUE (encode_base64 ("") == string (""));
+  ASSERT_TRUE (encode_base64 ("M") == string ("TQ=="));
+  ASSERT_TRUE (encode_base64 ("Ma") == string ("TWE="));
+  ASSERT_TRUE (encode_base64 ("Man") == string ("TWFu"));
+  ASSERT_TRUE (decode_base64 ("TQ==") == string ("M"));
+  ASSERT_TRUE (decode_base64 ("TWE=") == string ("Ma"));
+  ASSERT_TRUE (decode_base64 ("TWFu") == string ("Man"));
+}
+
+TEST (base64, round_trip) {
+  for (int n=0; n<=200; n++) {
+    string s= bytes (n);
+    string e= encode_base64 (s);
+    ASSERT_TRUE (decode_base64 (e) == s);
+  }
+}
+
+TEST (base64, line_breaks) {
+  string e= encode_base64 (bytes (1000));
+  int col= 0;
+  for (int i=0; i<N(e); i++)
+    if (e[i] == '\n') { ASSERT_EQ (col, 80); col= 0; }
+    else col++;
+  ASSERT_TRUE (col > 0 && col <= 80);
+  ASSERT_TRUE (e[N(e)-1] != '\n');
+}
+
+TEST (base64, ignore_other_characters) {
+  string s= bytes (100);
+  string e= encode_base64 (s), f;
+  for (int i=0; i<N(e); i++) {
+    f << e[i];
+    if (i % 7 == 3) f << "\r\n ";
+    if (i % 11 == 5) f << '\xe9';
+  }
+  ASSERT_TRUE (decode_base64 (f) == s);
+}
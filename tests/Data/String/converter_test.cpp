@@ -16,4 +16,10 @@ TEST (string, utf8_to_cork) {
   ASSERT_STREQ (as_charp (utf8_to_cork ("中")), "<#4E2D>");
   ASSERT_STREQ (as_charp (utf8_to_cork ("“")), "\x10");
   ASSERT_STREQ (as_charp (utf8_to_cork("”")), "\x11");
-}
\ No newline at end of file
+}
+
+TEST (string, ascii_runs) {
+  ASSERT_STREQ (as_charp (utf8_to_cork ("ab中c“d")), "ab<#4E2D>c\x10" "d");
+  ASSERT_STREQ (as_charp (cork_to_utf8 ("ab\x10" "cd\x11")), "ab“cd”");
+  ASSERT_STREQ (as_charp (cork_to_utf8 ("x<#4E2D>y")), "x中y");
+}
@@ -0,0 +1,30 @@
+
+/******************************************************************************
+* MODULE     : tree_brackets_test.cpp
+* DESCRIPTION: test the downgrading of big operators and brackets
+* COPYRIGHT  : (C) 2020  Joris van der Hoeven
+*******************************************************************************
+* This software falls under the GNU general public license version 3 or later.
+* It comes WITHOUT ANY WARRANTY WHATSOEVER. For details, see the file LICENSE
+* in the root directory or <http://www.gnu.org/licenses/gpl-3.0.html>.
+******************************************************************************/
+
+#include "gtest/gtest.h"
+#include "tree_correct.hpp"
+
+TEST (tree_brackets, needs_downgrade_big) {
+  tree normal= tree (DOCUMENT, concat ("a", tree (BIG, "sum"), "b"));
+  EXPECT_FALSE (needs_downgrade_big (normal));
+  EXPECT_TRUE (downgrade_big (normal) == normal);
+  tree tests[]= {
+    tree (DOCUMENT, tree (BIG_AROUND, "sum", "x")),
+    tree (DOCUMENT, concat ("a", "b")),
+    tree (DOCUMENT, concat ("", compound ("x"))),
+    tree (DOCUMENT, concat ("a", concat ("b", compound ("x")))),
+    tree (DOCUMENT, tree (CONCAT, compound ("x")))
+  };
+  for (int i=0; i<5; i++) {
+    EXPECT_TRUE (needs_downgrade_big (tests[i]));
+    EXPECT_FALSE (needs_downgrade_big (downgrade_big (tests[i])));
+  }
+}
@@ -0,0 +1,103 @@
+/******************************************************************************
+* MODULE     : glyph_ops_test.cpp
+* DESCRIPTION: test on operations on glyphs
+* COPYRIGHT  : (C) 2020  Joris van der Hoeven
+*******************************************************************************
+* This software falls under the GNU general public license version 3 or later.
+* It comes WITHOUT ANY WARRANTY WHATSOEVER. For details, see the file LICENSE
+* in the root directory or <http://www.gnu.org/licenses/gpl-3.0.html>.
+******************************************************************************/
+
+#include "gtest/gtest.h"
+#include "bitmap_font.hpp"
+
+static glyph
+test_glyph (int w, int h, int xoff, int yoff, int depth, int seed) {
+  glyph gl (w, h, xoff, yoff, depth);
+  unsigned int r= seed;
+  for (int j=0; j<h; j++)
+    for (int i=0; i<w; i++) {
+      r= r * 1103515245 + 12345;
+      int c= (r >> 16) % 3 == 0? (int) ((r >> 8) % (1 << depth)): 0;
+      if (j == 0 || i == w-1) c= 0;
+      gl->set_x (i, j, c);
+    }
+  gl->lwidth= w + 1;
+  return gl;
+}
+
+static bool
+same_pixels (glyph gl1, glyph gl2) {
+  if (gl1->width != gl2->width || gl1->height != gl2->height ||
+      gl1->xoff != gl2->xoff || gl1->yoff != gl2->yoff ||
+      gl1->depth != gl2->depth) return false;
+  for (int j=0; j<gl1->height; j++)
+    for (int i=0; i<gl1->width; i++)
+      if (gl1->get_x (i, j) != gl2->get_x (i, j)) return false;
+  return true;
+}
+
+static int
+pixel (glyph gl, int x, int y) {
+  // the pixel at (x, y) with respect to the origin
+  return gl->get_x (x + gl->xoff, gl->yoff - y);
+}
+
+TEST (glyph_ops, spans) {
+  for (int depth=1; depth<=8; depth+=7) {
+    glyph gl= test_glyph (131, 5, 0, 0, depth, depth);
+    for (int j=0; j<5; j++) {
+      int first= 131, last= -1;
+      for (int i=0; i<131; i++)
+        if (gl->get_x (i, j) != 0) { first= min (first, i); last= i; }
+      EXPECT_EQ (first_in_row (gl, j), first);
+      EXPECT_EQ (last_in_row (gl, j), last);
+      EXPECT_EQ (empty_row (gl, j), last < 0);
+    }
+  }
+}
+
+TEST (glyph_ops, flips) {
+  for (int depth=1; depth<=8; depth+=7) {
+    glyph gl= test_glyph (77, 9, 3, 6, depth, 17);
+    glyph h= hor_flip (gl), v= ver_flip (gl);
+    for (int j=0; j<9; j++)
+      for (int i=0; i<77; i++) {
+        EXPECT_EQ (h->get_x (76-i, j), gl->get_x (i, j));
+        EXPECT_EQ (v->get_x (i, 8-j), gl->get_x (i, j));
+      }
+    EXPECT_TRUE (same_pixels (hor_flip (h), gl));
+    EXPECT_TRUE (same_pixels (copy (gl), gl));
+  }
+}
+
+TEST (glyph_ops, combine) {
+  for (int depth=1; depth<=8; depth+=7) {
+    glyph gl1= test_glyph (70, 12, 5, 9, depth, 3);
+    glyph gl2= test_glyph (61, 15, -4, 7, depth, 4);
+    glyph u= join (gl1, gl2);
+    glyph m= intersect (gl1, gl2);
+    glyph e= exclude (gl1, gl2);
+    for (int y=-12; y<15; y++)
+      for (int x=-10; x<80; x++) {
+        int c1= pixel (gl1, x, y), c2= pixel (gl2, x, y);
+        EXPECT_EQ (pixel (u, x, y), max (c1, c2));
+        EXPECT_EQ (pixel (m, x, y), min (c1, c2));
+        EXPECT_EQ (pixel (e, x, y), c2 != 0? 0: c1);
+      }
+  }
+}
+
+TEST (glyph_ops, simplify) {
+  glyph gl (40, 20, 2, 10);
+  gl->set_x (13, 4, 1);
+  gl->set_x (27, 15, 1);
+  glyph s= simplify (gl);
+  EXPECT_EQ (s->width, 15);
+  EXPECT_EQ (s->height, 12);
+  EXPECT_EQ (s->xoff, 2 - 13);
+  EXPECT_EQ (s->yoff, 10 - 4);
+  EXPECT_EQ (s->get_x (0, 0), 1);
+  EXPECT_EQ (s->get_x (14, 11), 1);
+  EXPECT_EQ (simplify (glyph (40, 20, 2, 10))->width, 0);
+}
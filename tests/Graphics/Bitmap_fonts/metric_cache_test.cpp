@@ -0,0 +1,106 @@
+/******************************************************************************
+* MODULE     : metric_cache_test.cpp
+* DESCRIPTION: test on persistent caches for the metrics of glyphs
+* COPYRIGHT  : (C) 2020  Joris van der Hoeven
+*******************************************************************************
+* This software falls under the GNU general public license version 3 or later.
+* It comes WITHOUT ANY WARRANTY WHATSOEVER. For details, see the file LICENSE
+* in the root directory or <http://www.gnu.org/licenses/gpl-3.0.html>.
+******************************************************************************/
+
+#include "gtest/gtest.h"
+#include "metric_cache.hpp"
+#include "file.hpp"
+#include "sys_utils.hpp"
+
+static metric_struct*
+test_metric (int c) {
+  metric_struct* m= tm_new<metric_struct> ();
+  m->x1= c; m->y1= -c; m->x2= 2*c; m->y2= 3*c;
+  m->x3= c-1; m->y3= -c-1; m->x4= 2*c+1; m->y4= 3*c+1;
+  return m;
+}
+
+TEST (metric_cache, save_and_reload) {
+  url home= url_temp ("");
+  mkdir (home);
+  set_env ("TEXMACS_HOME_PATH", as_string (home));
+  url font_file= url_temp (".ttf");
+  ASSERT_FALSE (save_string (font_file, "dummy font"));
+
+  metric_cache c1 ("test-font10@600", font_file);
+  metric_struct m;
+  EXPECT_FALSE (c1->get (65, m));
+  for (int c=200; c>=0; c-=2) c1->set (c, test_metric (c));
+  c1->save ();
+
+  metric_cache c2 ("test-font10@600", font_file);
+  for (int c=0; c<=200; c++) {
+    EXPECT_EQ (c2->get (c, m), (c & 1) == 0);
+    if ((c & 1) == 0) {
+      EXPECT_EQ (m.x2, 2*c);
+      EXPECT_EQ (m.y4, 3*c+1);
+    }
+  }
+
+  // merging metrics found later with those already in the cache file
+  c2->set (101, test_metric (101));
+  c2->save ();
+  metric_cache c3 ("test-font10@600", font_file);
+  EXPECT_TRUE (c3->get (100, m));
+  EXPECT_TRUE (c3->get (101, m));
+  EXPECT_EQ (m.y1, -101);
+  EXPECT_FALSE (c3->get (103, m));
+
+  // the cache becomes invalid when the font changes
+  metric_cache c4 ("test-font10@600", url_temp (".ttf"));
+  EXPECT_FALSE (c4->get (100, m));
+  remove (font_file);
+}
+
+TEST (glyph_cache, save_and_reload) {
+  url home= url_temp ("");
+  mkdir (home);
+  set_env ("TEXMACS_HOME_PATH", as_string (home));
+  url def_file= url_temp (".vfn");
+  ASSERT_FALSE (save_string (def_file, "(virtual-font)"));
+
+  glyph_cache c1 ("test-virtual10@600", def_file);
+  metric_struct m;
+  glyph gl;
+  EXPECT_FALSE (c1->get ("<big-lparenthesis-3>", m, gl));
+  for (int depth=1; depth<=8; depth+=7) {
+    glyph g (13, 7, 2, 5, depth);
+    for (int i=0; i<13; i++) g->set_x (i, i % 7, depth);
+    g->lwidth= 15;
+    c1->set (depth == 1? "a": "<big-b>", *test_metric (depth), g);
+  }
+  c1->save ();
+
+  glyph_cache c2 ("test-virtual10@600", def_file);
+  ASSERT_TRUE (c2->get ("<big-b>", m, gl));
+  EXPECT_EQ (m.x2, 16);
+  EXPECT_EQ (gl->width, 13);
+  EXPECT_EQ (gl->depth, 8);
+  EXPECT_EQ (gl->yoff, 5);
+  EXPECT_EQ (gl->lwidth, 15);
+  EXPECT_EQ (gl->get_x (9, 2), 8);
+  EXPECT_EQ (gl->get_x (9, 3), 0);
+  ASSERT_TRUE (c2->get ("a", m, gl));
+  EXPECT_EQ (gl->get_x (12, 5), 1);
+  EXPECT_FALSE (c2->get ("b", m, gl));
+
+  // merging glyphs found later with those already in the cache file
+  c2->set ("b", *test_metric (2), glyph (0, 0, 0, 0));
+  c2->save ();
+  glyph_cache c3 ("test-virtual10@600", def_file);
+  EXPECT_TRUE (c3->get ("a", m, gl));
+  EXPECT_TRUE (c3->get ("<big-b>", m, gl));
+  EXPECT_TRUE (c3->get ("b", m, gl));
+  EXPECT_EQ (gl->width, 0);
+
+  // the cache becomes invalid when the definition changes
+  glyph_cache c4 ("test-virtual10@600", url_temp (".vfn"));
+  EXPECT_FALSE (c4->get ("a", m, gl));
+  remove (def_file);
+}
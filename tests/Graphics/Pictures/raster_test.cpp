@@ -0,0 +1,123 @@
+/******************************************************************************
+* MODULE     : raster_test.cpp
+* DESCRIPTION: test on the tiled evaluation of raster operations
+* COPYRIGHT  : (C) 2020  Joris van der Hoeven
+*******************************************************************************
+* This software falls under the GNU general public license version 3 or later.
+* It comes WITHOUT ANY WARRANTY WHATSOEVER. For details, see the file LICENSE
+* in the root directory or <http://www.gnu.org/licenses/gpl-3.0.html>.
+******************************************************************************/
+
+#include "gtest/gtest.h"
+#include "raster.hpp"
+#include "true_color.hpp"
+#include <stdlib.h>
+
+static raster<true_color>
+test_raster (int w, int h, int ox, int oy, int seed) {
+  raster<true_color> r (w, h, ox, oy);
+  unsigned int s= seed;
+  for (int i=0; i<w*h; i++) {
+    double c[4];
+    for (int k=0; k<4; k++) {
+      s= s * 1103515245 + 12345;
+      c[k]= ((s >> 16) % 256) / 255.0;
+    }
+    r->a[i]= true_color (c[0], c[1], c[2], c[3]);
+  }
+  return r;
+}
+
+static bool
+same (true_color c1, true_color c2) {
+  return c1.r == c2.r && c1.g == c2.g && c1.b == c2.b && c1.a == c2.a;
+}
+
+static raster<true_color>
+direct_convolute (raster<true_color> s1, raster<double> s2) {
+  // the convolution as it was computed before the tiled evaluation
+  int s1w= s1->w, s1h= s1->h, s2w= s2->w, s2h= s2->h;
+  int dw= s1w + s2w - 1, dh= s1h + s2h - 1;
+  raster<true_color> d (dw, dh, s1->ox + s2->ox, s1->oy + s2->oy);
+  for (int i=0; i<dw*dh; i++) clear (d->a[i]);
+  raster<true_color> temp (s1w, s1h, s1->ox, s1->oy);
+  for (int i=0; i<s1w*s1h; i++) temp->a[i]= mul_alpha (s1->a[i]);
+  for (int y1=0; y1<s1h; y1++)
+    for (int y2=0; y2<s2h; y2++) {
+      int o1= y1 * s1w, o2= y2 * s2w, o= (y1 + y2) * dw;
+      for (int x1=0; x1<s1w; x1++)
+        for (int x2=0; x2<s2w; x2++)
+          d->a[o+x1+x2] += temp->a[o1+x1] * s2->a[o2+x2];
+    }
+  for (int i=0; i<dw*dh; i++) d->a[i]= div_alpha (d->a[i]);
+  return d;
+}
+
+class raster_test: public ::testing::Test {
+protected:
+  static void SetUpTestCase () { setenv ("TEXMACS_THREADS", "4", 1); }
+};
+
+TEST_F (raster_test, map) {
+  raster<true_color> r= test_raster (301, 97, 5, 7, 1);
+  raster<true_color> m= mul_alpha (r);
+  raster<true_color> s= r * 0.5;
+  raster<true_color> c= compose<compose_source_over> (r, m);
+  EXPECT_EQ (m->w, 301);
+  EXPECT_EQ (m->oy, 7);
+  for (int i=0; i<301*97; i++) {
+    EXPECT_TRUE (same (m->a[i], mul_alpha (r->a[i])));
+    EXPECT_TRUE (same (s->a[i], r->a[i] * 0.5));
+    true_color x= r->a[i];
+    composition_op<compose_source_over>::set_op (x, m->a[i]);
+    EXPECT_TRUE (same (c->a[i], x));
+  }
+}
+
+TEST_F (raster_test, convolute) {
+  raster<true_color> r= test_raster (173, 131, 3, 2, 2);
+  raster<double> pen= gaussian_pen<double> (2.0, 3.0, 0.4);
+  raster<true_color> d1= convolute (r, pen);
+  raster<true_color> d2= direct_convolute (r, pen);
+  ASSERT_EQ (d1->w, d2->w);
+  ASSERT_EQ (d1->h, d2->h);
+  for (int i=0; i<d1->w*d1->h; i++)
+    EXPECT_TRUE (same (d1->a[i], d2->a[i]));
+}
+
+TEST_F (raster_test, factored_convolute) {
+  raster<true_color> r= test_raster (211, 89, 0, 0, 3);
+  raster<double> pen= gaussian_pen<double> (3.0, 3.0, 0.0);
+  pen= pen / sum (pen);
+  ASSERT_TRUE (can_be_factored (pen));
+  raster<true_color> d1= factored_convolute (r, pen);
+  raster<true_color> d2= direct_convolute (r, pen);
+  ASSERT_EQ (d1->w, d2->w);
+  ASSERT_EQ (d1->h, d2->h);
+  for (int i=0; i<d1->w*d1->h; i++) {
+    EXPECT_NEAR (d1->a[i].r, d2->a[i].r, 1.0e-6);
+    EXPECT_NEAR (d1->a[i].a, d2->a[i].a, 1.0e-6);
+  }
+}
+
+TEST_F (raster_test, kernels) {
+  raster<true_color> r1= test_raster (57, 3, 0, 0, 4);
+  raster<true_color> r2= test_raster (57, 3, 0, 0, 5);
+  raster<double> a= get_alpha (r2);
+  raster<true_color> m= compose<compose_mul> (r1, r2);
+  raster<true_color> p= apply_alpha (r1, a);
+  raster<true_color> q= apply_alpha (true_color (0.2, 0.4, 0.6, 0.8), a);
+  for (int i=0; i<57*3; i++) {
+    EXPECT_TRUE (same (m->a[i], r1->a[i] * r2->a[i]));
+    EXPECT_TRUE (same (p->a[i], apply_alpha (r1->a[i], a->a[i])));
+    EXPECT_EQ (q->a[i].a, 0.8 * a->a[i]);
+  }
+  true_color c[3]= { true_color (1.0, 0.5, 0.0, 1.0),
+                     true_color (1.0, 1.0, 1.0, 0.5),
+                     true_color (0.3, 0.3, 0.3, 0.0) };
+  unsigned int v[3];
+  premultiplied_pixels (v, c, 3);
+  EXPECT_EQ (v[0], (unsigned int) 0xffff8000);
+  EXPECT_EQ (v[1], (unsigned int) 0x80808080);
+  EXPECT_EQ (v[2], (unsigned int) 0);
+}
@@ -110,3 +110,29 @@ TEST (array, contains) {
   EXPECT_EQ (contains (2, five_elem), true);
   EXPECT_EQ (contains (3, five_elem), true);
 }
+
+TEST (array, reserve) {
+  auto a= array<int> ();
+  a->reserve (100);
+  EXPECT_EQ (N (a), 0);
+  for (auto i=1; i<=100; i++) a << i;
+  EXPECT_EQ (a, gen_array (100));
+  a->reserve (10);
+  EXPECT_EQ (a, gen_array (100));
+}
+
+TEST (array, shrink) {
+  auto a= gen_array (100);
+  for (auto k=0; k<10; k++) {
+    a->resize (60);
+    a << 61;
+    a->resize (100);
+  }
+  EXPECT_EQ (range (a, 0, 61), gen_array (61));
+  a->resize (3);
+  EXPECT_EQ (a, array<int> (1,2,3));
+  a->resize (0);
+  EXPECT_EQ (N (a), 0);
+  a << 1;
+  EXPECT_EQ (a, one_elem);
+}
@@ -0,0 +1,138 @@
+/******************************************************************************
+* MODULE     : flat_hashmap_test.cpp
+* DESCRIPTION: test on flat_hashmap
+* COPYRIGHT  : (C) 2020  Joris van der Hoeven
+*******************************************************************************
+* This software falls under the GNU general public license version 3 or later.
+* It comes WITHOUT ANY WARRANTY WHATSOEVER. For details, see the file LICENSE
+* in the root directory or <http://www.gnu.org/licenses/gpl-3.0.html>.
+******************************************************************************/
+#include "gtest/gtest.h"
+#include "flat_hashmap.hpp"
+#include "iterator.hpp"
+
+/******************************************************************************
+* tests on resize
+******************************************************************************/
+TEST (flat_hashmap, resize) {
+  auto hm = flat_hashmap<int, int>(0, 10);
+  hm(1) = 10;
+  hm(2) = 20;
+
+  hm->resize(1);
+  EXPECT_EQ (hm[1] == 10, true);
+  EXPECT_EQ (hm[2] == 20, true);
+
+  hm->resize(20);
+  EXPECT_EQ (hm[1] == 10, true);
+  EXPECT_EQ (hm[2] == 20, true);
+}
+
+/******************************************************************************
+* tests on reset
+******************************************************************************/
+TEST (flat_hashmap, reset) {
+  auto hm = flat_hashmap<int, int>(0, 10);
+  hm(1) = 10;
+  hm(11) = 20;
+  hm->reset(1);
+
+  EXPECT_EQ (hm->contains(1), false);
+  EXPECT_EQ (hm->contains(11), true);
+  EXPECT_EQ (N(hm) == 1, true);
+}
+
+/******************************************************************************
+* tests on collisions
+******************************************************************************/
+TEST (flat_hashmap, collisions) {
+  // without scrambling, all keys would share the same home slot
+  auto hm = flat_hashmap<int, int>(-1, 16);
+  for (int i=0; i<10; i++) hm(i*16) = i;
+  for (int i=0; i<10; i++) EXPECT_EQ (hm[i*16] == i, true);
+
+  hm->reset(0);
+  hm->reset(80);
+  EXPECT_EQ (hm[0] == -1, true);
+  EXPECT_EQ (hm[80] == -1, true);
+  for (int i=1; i<10; i++)
+    if (i != 5) {
+      EXPECT_EQ (hm[i*16] == i, true);
+    }
+  EXPECT_EQ (N(hm) == 8, true);
+}
+
+/******************************************************************************
+* tests on many insertions and removals
+******************************************************************************/
+TEST (flat_hashmap, stress) {
+  auto hm = flat_hashmap<string, int>(-1);
+  for (int i=0; i<1000; i++) hm(as_string (i)) = i;
+  EXPECT_EQ (N(hm) == 1000, true);
+  for (int i=0; i<1000; i+=2) hm->reset(as_string (i));
+  EXPECT_EQ (N(hm) == 500, true);
+  for (int i=0; i<1000; i++)
+    EXPECT_EQ (hm[as_string (i)] == (i%2 == 0? -1: i), true);
+  for (int i=1; i<1000; i+=2) hm->reset(as_string (i));
+  EXPECT_EQ (hm->empty(), true);
+}
+
+/******************************************************************************
+* tests on contains
+******************************************************************************/
+TEST (flat_hashmap, contains) {
+  auto hm = flat_hashmap<int, void*>(nullptr, 2, 2);
+  hm(1) = nullptr;
+  EXPECT_EQ (hm->contains(1), true);
+  EXPECT_EQ (hm->contains(3), false);
+}
+
+/******************************************************************************
+* tests on join
+******************************************************************************/
+TEST (flat_hashmap, join) {
+  auto hm1 = flat_hashmap<int, int>();
+  auto hm2 = flat_hashmap<int, int>();
+  hm1(1) = 10;
+  hm1(2) = 20;
+  hm2(2) = -20;
+  hm2(3) = -30;
+  hm1->join(hm2);
+
+  EXPECT_EQ (hm1[1] == 10, true);
+  EXPECT_EQ (hm1[2] == -20, true);
+  EXPECT_EQ (hm1[3] == -30, true);
+}
+
+/******************************************************************************
+* tests on copy and equality
+******************************************************************************/
+TEST (flat_hashmap, copy) {
+  auto hm = flat_hashmap<int, int>(0, 10, 2);
+  hm(1) = 10;
+  hm(11) = 110;
+  hm(2) = 20;
+
+  auto res_hm = copy(hm);
+  EXPECT_EQ (res_hm[1] == 10, true);
+  EXPECT_EQ (res_hm[11] == 110, true);
+  EXPECT_EQ (res_hm[2] == 20, true);
+  EXPECT_EQ (res_hm == hm, true);
+
+  res_hm(3) = 30;
+  EXPECT_EQ (res_hm != hm, true);
+  EXPECT_EQ (hm->contains(3), false);
+}
+
+/******************************************************************************
+* tests on iterate
+******************************************************************************/
+TEST (flat_hashmap, iterate) {
+  auto hm = flat_hashmap<int, int>();
+  for (int i=0; i<100; i++) hm(i) = i;
+  int sum= 0, count= 0;
+  iterator<int> it= iterate (hm);
+  while (it->busy ()) { sum += it->next (); count++; }
+  EXPECT_EQ (count == 100, true);
+  EXPECT_EQ (sum == 4950, true);
+}
@@ -232,3 +232,25 @@ TEST (hashmap, N) {
   non_empty_hm(1) = nullptr;
   EXPECT_EQ (N(non_empty_hm) == 1, true);
 }
+
+/******************************************************************************
+* tests on range-based iteration
+******************************************************************************/
+TEST (hashmap, range_for) {
+  auto empty_hm = hashmap<int, int>(0, 10);
+  int count = 0;
+  for (int key: empty_hm) { (void) key; count++; }
+  EXPECT_EQ (count, 0);
+
+  auto hm = hashmap<int, int>(0, 4);
+  for (int i = 0; i < 100; i++) hm(i) = 2 * i;
+  int sum = 0;
+  count = 0;
+  for (int key: hm) {
+    EXPECT_EQ (hm[key], 2 * key);
+    sum += key;
+    count++;
+  }
+  EXPECT_EQ (count, 100);
+  EXPECT_EQ (sum, 4950);
+}
@@ -0,0 +1,71 @@
+/******************************************************************************
+* MODULE     : lru_cache_test.cpp
+* DESCRIPTION: test on lru_cache
+* COPYRIGHT  : (C) 2020  Joris van der Hoeven
+*******************************************************************************
+* This software falls under the GNU general public license version 3 or later.
+* It comes WITHOUT ANY WARRANTY WHATSOEVER. For details, see the file LICENSE
+* in the root directory or <http://www.gnu.org/licenses/gpl-3.0.html>.
+******************************************************************************/
+#include "gtest/gtest.h"
+#include "lru_cache.hpp"
+
+static int released= 0;
+
+static void
+count_release (int key, int im) {
+  (void) key; (void) im;
+  released++;
+}
+
+/******************************************************************************
+* tests on eviction
+******************************************************************************/
+TEST (lru_cache, eviction) {
+  lru_cache<int,int> c (-1, 100);
+  for (int i=0; i<10; i++) c->set (i, 10*i, 20);
+  EXPECT_EQ (N(c), 5);
+  EXPECT_EQ (c->get_used (), 100);
+  EXPECT_EQ (c->evictions, 5);
+  EXPECT_EQ (c[4], -1);
+  EXPECT_EQ (c[5], 50);
+
+  // 5 is now the most recently used entry, so 6 is evicted first
+  c->set (10, 100, 20);
+  EXPECT_EQ (c->contains (5), true);
+  EXPECT_EQ (c->contains (6), false);
+  EXPECT_EQ (c->hits, 1);
+  EXPECT_EQ (c->misses, 1);
+}
+
+TEST (lru_cache, large_entries) {
+  lru_cache<int,int> c (-1, 100);
+  c->set (1, 1, 30);
+  c->set (2, 2, 500);
+  EXPECT_EQ (N(c), 1);
+  EXPECT_EQ (c[2], 2);
+  c->set (2, 3, 40);
+  EXPECT_EQ (c->get_used (), 40);
+  EXPECT_EQ (c[2], 3);
+}
+
+/******************************************************************************
+* tests on release
+******************************************************************************/
+TEST (lru_cache, release) {
+  released= 0;
+  {
+    lru_cache<int,int> c (-1, 50, count_release);
+    c->set (1, 1, 20);
+    c->set (2, 2, 20);
+    c->set (3, 3, 20);
+    EXPECT_EQ (released, 1);
+    c->reset (2);
+    EXPECT_EQ (released, 2);
+    c->set_budget (10);
+    EXPECT_EQ (N(c), 0);
+    EXPECT_EQ (released, 3);
+    c->set (4, 4, 5);
+  }
+  EXPECT_EQ (released, 3);
+}
@@ -0,0 +1,86 @@
+
+/******************************************************************************
+* MODULE     : fast_hash_test.cpp
+* DESCRIPTION: Tests on fast content hashes
+* COPYRIGHT  : (C) 2020  Joris van der Hoeven
+*******************************************************************************
+* This software falls under the GNU general public license version 3 or later.
+* It comes WITHOUT ANY WARRANTY WHATSOEVER. For details, see the file LICENSE
+* in the root directory or <http://www.gnu.org/licenses/gpl-3.0.html>.
+******************************************************************************/
+
+#include "gtest/gtest.h"
+
+#include "fast_hash.hpp"
+#include "hashmap.hpp"
+
+TEST (fast_hash, xxhash64) {
+  ASSERT_EQ (fast_hash (string ("")), 0xEF46DB3751D8E999ULL);
+  ASSERT_EQ (fast_hash (string ("abc")), 0x44BC2CF5AD770999ULL);
+  char buf[100];
+  for (int i=0; i<100; i++) buf[i]= (char) i;
+  ASSERT_EQ (fast_hash (buf, 100), 0x6AC1E58032166597ULL);
+  ASSERT_EQ (fast_hash (buf, 100, 1), 0x3D19A3A2098A7023ULL);
+}
+
+TEST (fast_hash, key) {
+  string k= fast_hash_key (string ("abc"));
+  ASSERT_EQ (N(k), 32);
+  ASSERT_TRUE (k (0, 16) == "44bc2cf5ad770999");
+  ASSERT_TRUE (k != fast_hash_key (string ("abd")));
+}
+
+TEST (fast_hash, tree) {
+  tree t1= tree (TUPLE, "a", tree (CONCAT, "b", "c"));
+  tree t2= tree (TUPLE, "a", tree (CONCAT, "b", "c"));
+  ASSERT_EQ (fast_hash (t1), fast_hash (t2));
+  ASSERT_TRUE (fast_hash_key (t1) == fast_hash_key (t2));
+  ASSERT_NE (fast_hash (t1), fast_hash (tree (TUPLE, "a", "bc")));
+  ASSERT_NE (fast_hash (t1), fast_hash (tree (TUPLE, "a", tree (TUPLE, "b", "c"))));
+  ASSERT_NE (fast_hash (tree (TUPLE, "ab")), fast_hash (tree (TUPLE, "a", "b")));
+  ASSERT_NE (fast_hash (tree ("a")), fast_hash (tree (TUPLE, "a")));
+}
+
+TEST (fast_hash, hashmap_keys) {
+  tree t1= tree (TUPLE, "a", tree (CONCAT, "b", "c"));
+  tree t2= copy (t1);
+  ASSERT_EQ (hash (t1), hash (t2));
+  hashmap<tree,int> h (0);
+  h (t1)= 1;
+  ASSERT_EQ (h[t2], 1);
+  ASSERT_EQ (h[tree (TUPLE, "a", "bc")], 0);
+}
+
+static tree
+large_tree (string s) {
+  tree t (DOCUMENT);
+  for (int i=0; i<32; i++) t << tree (CONCAT, s, as_string (i) * "          ");
+  return t;
+}
+
+TEST (fast_hash, modified_in_place) {
+  // trees are often modified in place, which leaves their cached hashes
+  // outdated, so that equality does not rely on these hashes
+  tree t= large_tree ("a");
+  attach_ip (t, path (0));
+  fast_hash (t);
+  DN h1, h2;
+  ASSERT_TRUE (obtain_content_hash (t, h1, h2));
+  t[0]= tree (CONCAT, "b");
+  tree u= copy (t);
+  attach_ip (u, path (1));
+  fast_hash (u);
+  ASSERT_TRUE (t == u);
+  ASSERT_FALSE (t != u);
+  ASSERT_TRUE (fast_unequal (t, u));
+}
+
+TEST (fast_hash, lookups_do_not_cache) {
+  tree t= large_tree ("a");
+  attach_ip (t, path (0));
+  hashmap<tree,int> h (0);
+  h (t)= 1;
+  DN h1, h2;
+  ASSERT_FALSE (obtain_content_hash (t, h1, h2));
+  ASSERT_EQ (h[copy (t)], 1);
+}
@@ -0,0 +1,62 @@
+
+/******************************************************************************
+* MODULE     : path_test.cpp
+* DESCRIPTION: Tests on path
+* COPYRIGHT  : (C) 2020  Joris van der Hoeven
+*******************************************************************************
+* This software falls under the GNU general public license version 3 or later.
+* It comes WITHOUT ANY WARRANTY WHATSOEVER. For details, see the file LICENSE
+* in the root directory or <http://www.gnu.org/licenses/gpl-3.0.html>.
+******************************************************************************/
+
+#include "gtest/gtest.h"
+
+#include "path.hpp"
+
+static path
+deep_path (int depth, int last) {
+  path p (last);
+  for (int i=0; i<depth; i++) p= path (1, p);
+  return p;
+}
+
+TEST (path, compare) {
+  EXPECT_TRUE (path_inf_eq (path (1, 2), path (1, 3)));
+  EXPECT_FALSE (path_inf_eq (path (1), path (1, 0)));
+  EXPECT_TRUE (path_inf_eq (path (1, 2), path (1, 2)));
+  EXPECT_FALSE (path_inf_eq (path (1, 0), path (1)));
+  EXPECT_FALSE (path_inf_eq (path (2), path (1, 5)));
+  EXPECT_TRUE (path_inf (path (1, 2), path (1, 3)));
+  EXPECT_FALSE (path_inf (path (1, 2), path (1, 2)));
+}
+
+TEST (path, less_eq) {
+  EXPECT_TRUE (path_less_eq (path (3, 0), path (3, 1)));
+  EXPECT_TRUE (path_less_eq (path (3, 0), path (3, 2, 5)));
+  EXPECT_TRUE (path_less_eq (path (3, 2, 5), path (3, 1)));
+  EXPECT_FALSE (path_less_eq (path (3, 1), path (3, 0)));
+  EXPECT_FALSE (path_less_eq (path (3, 2, 5), path (3, 0)));
+  EXPECT_TRUE (path_less (path (3, 0), path (3, 1)));
+  EXPECT_FALSE (path_less (path (3, 1), path (3, 1)));
+}
+
+TEST (path, shared_tail) {
+  path tail= deep_path (10000, 0);
+  path p1 (2, tail), p2 (2, tail), p3 (2, copy (tail));
+  EXPECT_TRUE (p1 == p2);
+  EXPECT_TRUE (p1 == p3);
+  EXPECT_TRUE (path_inf_eq (p1, p2));
+  EXPECT_TRUE (path_less_eq (p1, p3));
+  EXPECT_FALSE (path_inf (p1, p3));
+  EXPECT_EQ (N (p1), 10002);
+}
+
+TEST (path, deep) {
+  path p1= deep_path (10000, 3), p2= deep_path (10000, 4);
+  EXPECT_TRUE (path_inf (p1, p2));
+  EXPECT_TRUE (path_inf_eq (p1, p2));
+  EXPECT_FALSE (path_inf_eq (p2, p1));
+  EXPECT_TRUE (zero_path (path (0, deep_path (0, 0))));
+  EXPECT_FALSE (zero_path (p1));
+  EXPECT_TRUE ((p1 / path (1, 1)) == deep_path (9998, 3));
+}
@@ -0,0 +1,91 @@
+
+/******************************************************************************
+* MODULE     : rectangles_test.cpp
+* DESCRIPTION: Set operations on lists of rectangles
+* COPYRIGHT  : (C) 2020  Joris van der Hoeven
+*******************************************************************************
+* This software falls under the GNU general public license version 3 or later.
+* It comes WITHOUT ANY WARRANTY WHATSOEVER. For details, see the file LICENSE
+* in the root directory or <http://www.gnu.org/licenses/gpl-3.0.html>.
+******************************************************************************/
+
+#include "gtest/gtest.h"
+
+#include "rectangles.hpp"
+
+static unsigned int seed= 1;
+
+static int
+random_int (int n) {
+  seed= seed * 1103515245 + 12345;
+  return (int) ((seed >> 16) % ((unsigned int) n));
+}
+
+static rectangles
+random_rectangles (int n) {
+  rectangles l;
+  for (int i=0; i<n; i++) {
+    SI x= random_int (20), y= random_int (20);
+    l= rectangles (rectangle (x, y, x + random_int (8), y + random_int (8)), l);
+  }
+  return l;
+}
+
+static bool
+contains (rectangles l, SI x, SI y) {
+  for (; !is_nil (l); l= l->next)
+    if (l->item->x1 <= x && x < l->item->x2 &&
+        l->item->y1 <= y && y < l->item->y2) return true;
+  return false;
+}
+
+static bool
+disjoint (rectangles l) {
+  for (rectangles a= l; !is_nil (a); a= a->next)
+    for (rectangles b= a->next; !is_nil (b); b= b->next)
+      if (intersect (a->item, b->item)) return false;
+  return true;
+}
+
+TEST (rectangles, set_operations) {
+  for (int k=0; k<200; k++) {
+    rectangles l1= random_rectangles (random_int (12));
+    rectangles l2= random_rectangles (random_int (12));
+    rectangles u= l1 | l2, i= l1 & l2, d= l1 - l2, s= simplify (l1);
+    EXPECT_TRUE (disjoint (u));
+    EXPECT_TRUE (disjoint (i));
+    if (!is_nil (l2)) {
+      EXPECT_TRUE (disjoint (d));
+    }
+    EXPECT_TRUE (disjoint (s));
+    for (SI x=0; x<28; x++)
+      for (SI y=0; y<28; y++) {
+        bool in1= contains (l1, x, y), in2= contains (l2, x, y);
+        ASSERT_EQ (contains (u, x, y), in1 || in2);
+        ASSERT_EQ (contains (i, x, y), in1 && in2);
+        ASSERT_EQ (contains (d, x, y), in1 && !in2);
+        ASSERT_EQ (contains (s, x, y), in1);
+      }
+  }
+}
+
+TEST (rectangles, merge_adjacent) {
+  rectangles l (rectangle (0, 0, 10, 10));
+  l= l | rectangles (rectangle (10, 0, 20, 10));
+  l= l | rectangles (rectangle (0, 10, 20, 20));
+  ASSERT_EQ (N(l), 1);
+  EXPECT_TRUE (l->item == rectangle (0, 0, 20, 20));
+  l= l - rectangles (rectangle (5, 5, 15, 15));
+  ASSERT_EQ (N(l), 4);
+  EXPECT_EQ (area (l), 300.0);
+}
+
+TEST (rectangles, incremental_union) {
+  // invalidating many small rectangles one by one remains canonical
+  rectangles l;
+  for (int i=0; i<100; i++)
+    for (int j=0; j<10; j++)
+      l= l | rectangles (rectangle (10*j, 10*i, 10*j+10, 10*i+10));
+  ASSERT_EQ (N(l), 1);
+  EXPECT_TRUE (l->item == rectangle (0, 0, 100, 1000));
+}
@@ -71,6 +71,40 @@ TEST (string, append) {
   ASSERT_TRUE (str == string("xyz"));
 }
 
+TEST (string, append_across_inline_buffer) {
+  auto str = string();
+  auto ref = "abcdefghijklmnopqrstuvwxyz0123456789";
+  for (int i=0; i<36; i++) {
+    str << ref[i];
+    ASSERT_TRUE (str == string(ref, i+1));
+  }
+  auto head = str (0, 3);
+  ASSERT_TRUE (head == string("abc"));
+  head << str (3, 36);
+  ASSERT_TRUE (head == str);
+  ASSERT_TRUE (copy (str) == str);
+}
+
+TEST (string, insert_remove) {
+  auto str = string ("abcdef");
+  insert (str, 3, string ("XYZ"));
+  ASSERT_TRUE (str == string ("abcXYZdef"));
+  remove (str, 1, 4);
+  ASSERT_TRUE (str == string ("aZdef"));
+  auto shared = str;
+  insert (str, 0, str);
+  ASSERT_TRUE (str == string ("aZdefaZdef"));
+  ASSERT_TRUE (shared == string ("aZdef"));
+  shared = str;
+  remove (str, 0, 5);
+  ASSERT_TRUE (str == string ("aZdef"));
+  ASSERT_TRUE (shared == string ("aZdefaZdef"));
+  for (int i=0; i<1000; i++) insert (str, 2, string ("+"));
+  ASSERT_EQ (N(str), 1005);
+  remove (str, 2, 1000);
+  ASSERT_TRUE (str == string ("aZdef"));
+}
+
 /******************************************************************************
 * Conversions
 ******************************************************************************/
@@ -34,3 +34,47 @@ TEST (tree, is_concat) {
   ASSERT_TRUE (is_concat (concat (tree (), tree (), tree (), tree ())));
   ASSERT_TRUE (is_concat (concat (tree (), tree (), tree (), tree (), tree ())));
 }
+
+TEST (tree, share_atoms) {
+  tree t1= concat ("a", "<alpha>", tuple ("a"));
+  tree t2= concat ("<alpha>", "a long atom which is not shared");
+  share_atoms (t1);
+  share_atoms (t2);
+  ASSERT_TRUE (strong_equal (t1[0], t1[2][0]));
+  ASSERT_TRUE (strong_equal (t1[1], t2[0]));
+  ASSERT_TRUE (t2[1] == "a long atom which is not shared");
+  ASSERT_TRUE (t1 == concat ("a", "<alpha>", tuple ("a")));
+  clear_shared_atoms ();
+  ASSERT_FALSE (strong_equal (shared_atom ("a"), t1[0]));
+}
+
+TEST (tree, shared_atoms_bounded) {
+  clear_shared_atoms ();
+  tree a= shared_atom ("a");
+  for (int i=0; i<70000; i++) shared_atom (as_string (i));
+  ASSERT_TRUE (strong_equal (shared_atom ("a"), a));
+  ASSERT_FALSE (strong_equal (shared_atom ("b"), shared_atom ("b")));
+  clear_shared_atoms ();
+  ASSERT_TRUE (strong_equal (shared_atom ("b"), shared_atom ("b")));
+  clear_shared_atoms ();
+}
+
+TEST (tree, assign_subtree) {
+  tree t= concat (tuple ("a", "b"), "c");
+  t= t[0];
+  ASSERT_TRUE (t == tuple ("a", "b"));
+  t= t[1];
+  ASSERT_TRUE (t == "b");
+}
+
+TEST (tree, move) {
+  tree t= tuple ("a", "b");
+  tree u (std::move (t));
+  ASSERT_TRUE (u == tuple ("a", "b"));
+  t= concat ("c");
+  u= std::move (t);
+  ASSERT_TRUE (u == concat ("c"));
+  array<tree> a;
+  for (int i=0; i<100; i++) a << tree (as_string (i));
+  ASSERT_TRUE (a[99] == "99");
+}
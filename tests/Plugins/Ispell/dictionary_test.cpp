@@ -0,0 +1,51 @@
+
+/******************************************************************************
+* MODULE     : dictionary_test.cpp
+* DESCRIPTION: test the resident hunspell dictionaries
+* COPYRIGHT  : (C) 2020  Joris van der Hoeven
+*******************************************************************************
+* This software falls under the GNU general public license version 3 or later.
+* It comes WITHOUT ANY WARRANTY WHATSOEVER. For details, see the file LICENSE
+* in the root directory or <http://www.gnu.org/licenses/gpl-3.0.html>.
+******************************************************************************/
+
+#include "gtest/gtest.h"
+#include "Ispell/dictionary.hpp"
+#include "file.hpp"
+
+static url
+write_file (string name, string s) {
+  url u= url_system ("/tmp") * name;
+  save_string (u, s, false);
+  return u;
+}
+
+TEST (dictionary, affixes) {
+  url aff= write_file ("dictionary_test.aff",
+                       "SET UTF-8\n"
+                       "PFX U Y 1\n"
+                       "PFX U 0 un .\n"
+                       "SFX S Y 2\n"
+                       "SFX S y ies [^aeiou]y\n"
+                       "SFX S 0 s [^y]\n"
+                       "SFX D N 1\n"
+                       "SFX D 0 ed .\n");
+  url dic= write_file ("dictionary_test.dic",
+                       "4\nfly/S\ndo/US\nlock/UD\nParis\n");
+  ASSERT_TRUE (dictionary_load ("test", dic, aff));
+  EXPECT_TRUE (dictionary_contains ("test", "fly"));
+  EXPECT_TRUE (dictionary_contains ("test", "flies"));
+  EXPECT_FALSE (dictionary_contains ("test", "flys"));
+  EXPECT_TRUE (dictionary_contains ("test", "undos"));
+  EXPECT_TRUE (dictionary_contains ("test", "unlock"));
+  EXPECT_TRUE (dictionary_contains ("test", "locked"));
+  EXPECT_FALSE (dictionary_contains ("test", "unlocked"));
+  EXPECT_TRUE (dictionary_contains ("test", "Lock"));
+  EXPECT_TRUE (dictionary_contains ("test", "Paris"));
+  EXPECT_FALSE (dictionary_contains ("test", "paris"));
+  EXPECT_FALSE (dictionary_contains ("other", "fly"));
+  dictionary_insert ("test", "texmacs");
+  EXPECT_TRUE (dictionary_contains ("test", "texmacs"));
+  remove (aff);
+  remove (dic);
+}
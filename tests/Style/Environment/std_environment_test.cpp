@@ -0,0 +1,35 @@
+/******************************************************************************
+* MODULE     : std_environment_test.cpp
+* DESCRIPTION: test on the slots for the standard variables
+* COPYRIGHT  : (C) 2020  Joris van der Hoeven
+*******************************************************************************
+* This software falls under the GNU general public license version 3 or later.
+* It comes WITHOUT ANY WARRANTY WHATSOEVER. For details, see the file LICENSE
+* in the root directory or <http://www.gnu.org/licenses/gpl-3.0.html>.
+******************************************************************************/
+
+#include "gtest/gtest.h"
+#include "std_environment.hpp"
+#include "memorizer.hpp"
+#include "vars.hpp"
+
+TEST (std_environment, slots) {
+  hashmap<string,tree> h (UNINIT);
+  h (FONT_SIZE)= "1";
+  h (MODE)= "text";
+  memorize_initialize ();
+  environment env;
+  primitive (env, h);
+  EXPECT_EQ (env [SLOT_FONT_SIZE] == tree ("1"), true);
+  assoc_environment local (1);
+  local->raw_write (0, FONT_SIZE, "2");
+  environment inner= env;
+  assign (inner, local);
+  (void) memorize_finalize ();
+  EXPECT_EQ (inner [SLOT_FONT_SIZE] == tree ("2"), true);
+  EXPECT_EQ (inner [SLOT_MODE] == inner [MODE], true);
+  EXPECT_EQ (env [SLOT_FONT_SIZE] == tree ("1"), true);
+  EXPECT_EQ (inner [SLOT_COLOR] == tree (UNINIT), true);
+  inner->write (FONT_SIZE, "3");
+  EXPECT_EQ (inner [SLOT_FONT_SIZE] == tree ("3"), true);
+}
@@ -0,0 +1,76 @@
+/******************************************************************************
+* MODULE     : memorizer_test.cpp
+* DESCRIPTION: test on the bounded store of memorizers
+* COPYRIGHT  : (C) 2020  Joris van der Hoeven
+*******************************************************************************
+* This software falls under the GNU general public license version 3 or later.
+* It comes WITHOUT ANY WARRANTY WHATSOEVER. For details, see the file LICENSE
+* in the root directory or <http://www.gnu.org/licenses/gpl-3.0.html>.
+******************************************************************************/
+
+#include "gtest/gtest.h"
+#include "memorizer.hpp"
+#include "tm_timer.hpp"
+
+static int live_memorizers= 0;
+
+class test_memorizer_rep: public memorizer_rep {
+  int key;
+public:
+  test_memorizer_rep (int key2): key (key2) { live_memorizers++; }
+  ~test_memorizer_rep () { live_memorizers--; }
+  void print (tm_ostream& out) { out << "test_memorizer " << key; }
+  int type () { return 100; }
+  int hash () { return key; }
+  bool equal (memorizer_rep* mem) {
+    return ((test_memorizer_rep*) mem)->key == key; }
+};
+
+static bool
+lookup (int key) {
+  memorize_initialize ();
+  bool r;
+  {
+    memorizer mem= tm_new<test_memorizer_rep> (key);
+    r= is_memorized (mem);
+  }
+  (void) memorize_finalize ();
+  return r;
+}
+
+TEST (memorizer, reuse) {
+  set_memorizer_store_size (16);
+  EXPECT_EQ (lookup (1), false);
+  EXPECT_EQ (lookup (1), true);
+  EXPECT_EQ (lookup (2), false);
+  set_memorizer_store_size (16);
+  EXPECT_EQ (live_memorizers, 0);
+}
+
+TEST (memorizer, bounded) {
+  set_memorizer_store_size (16);
+  profile_reset ();
+  profile_start ();
+  for (int i=0; i<1000; i++) {
+    (void) lookup (i);
+    EXPECT_EQ (live_memorizers <= 16, true);
+  }
+  EXPECT_EQ (lookup (999), true);
+  EXPECT_EQ (lookup (0), false);
+  profile_stop ();
+  EXPECT_EQ (profile_tallies ("memorizer hits"), 1);
+  EXPECT_EQ (profile_tallies ("memorizer misses"), 1001);
+  EXPECT_EQ (profile_tallies ("memorizer evictions"), 1001 - 16);
+}
+
+TEST (memorizer, recently_used) {
+  // frequently used memorizers survive the eviction of the other ones
+  set_memorizer_store_size (16);
+  for (int i=0; i<1000; i++) {
+    (void) lookup (i);
+    EXPECT_EQ (lookup (-1), i != 0);
+  }
+  set_memorizer_store_size (0);
+  EXPECT_EQ (lookup (-1), false);
+  EXPECT_EQ (live_memorizers, 0);
+}
@@ -0,0 +1,142 @@
+/******************************************************************************
+* MODULE     : tm_timer_test.cpp
+* DESCRIPTION: test on the hierarchical profiler
+* COPYRIGHT  : (C) 2020  Joris van der Hoeven
+*******************************************************************************
+* This software falls under the GNU general public license version 3 or later.
+* It comes WITHOUT ANY WARRANTY WHATSOEVER. For details, see the file LICENSE
+* in the root directory or <http://www.gnu.org/licenses/gpl-3.0.html>.
+******************************************************************************/
+
+#include "gtest/gtest.h"
+#include "tm_timer.hpp"
+#include "analyze.hpp"
+
+static void
+profiled_leaf () {
+  PROFILE_SCOPE ("leaf");
+  nano_time start= texmacs_nanotime ();
+  while (texmacs_nanotime () - start < 100000) {}
+}
+
+static void
+profiled_node () {
+  PROFILE_SCOPE ("node");
+  profiled_leaf ();
+  profiled_leaf ();
+}
+
+TEST (profile, nanotime) {
+  nano_time t1= texmacs_nanotime ();
+  nano_time t2= texmacs_nanotime ();
+  EXPECT_EQ (t2 >= t1, true);
+}
+
+TEST (profile, counter) {
+  EXPECT_EQ (profile_counter ("a") == profile_counter ("a"), true);
+  EXPECT_EQ (profile_counter ("a") != profile_counter ("b"), true);
+}
+
+TEST (profile, flamegraph) {
+  profile_start ();
+  profiled_node ();
+  profiled_leaf ();
+  profile_stop ();
+  string r= profile_flamegraph ();
+  EXPECT_EQ (occurs ("node;leaf ", r), true);
+  EXPECT_EQ (occurs ("\nleaf ", "\n" * r), true);
+  EXPECT_EQ (occurs ("leaf;", r), false);
+
+  profile_reset ();
+  EXPECT_EQ (profile_flamegraph (), string (""));
+}
+
+TEST (profile, unbalanced) {
+  // a missing bench_cumul must not corrupt the enclosing scopes
+  profile_reset ();
+  profile_start ();
+  {
+    PROFILE_SCOPE ("outer");
+    bench_start ("unbalanced");
+  }
+  profiled_leaf ();
+  profile_stop ();
+  string r= profile_flamegraph ();
+  EXPECT_EQ (occurs ("outer;unbalanced;leaf", r), false);
+  EXPECT_EQ (occurs ("\nleaf ", "\n" * r), true);
+  bench_reset ("unbalanced");
+}
+
+TEST (profile, chrome_trace) {
+  profile_reset ();
+  profile_start ();
+  profiled_node ();
+  profile_stop ();
+  string r= profile_chrome_trace ();
+  EXPECT_EQ (starts (r, "{\"traceEvents\":[{\"name\":"), true);
+  EXPECT_EQ (occurs ("\"name\":\"node\"", r), true);
+  EXPECT_EQ (occurs ("\"calls\":2", r), true);
+}
+
+TEST (profile, tally) {
+  profile_reset ();
+  profile_start ();
+  for (int i=0; i<3; i++) PROFILE_TALLY ("tallied");
+  profile_stop ();
+  PROFILE_TALLY ("tallied");
+  EXPECT_EQ (profile_tallies ("tallied"), 3);
+  profile_reset ();
+  EXPECT_EQ (profile_tallies ("tallied"), 0);
+}
+
+TEST (profile, time) {
+  // the leaves are called inside and outside the node
+  profile_reset ();
+  profile_start ();
+  profiled_node ();
+  profiled_leaf ();
+  profile_stop ();
+  EXPECT_EQ (profile_time ("leaf") >= 0.3, true);
+  EXPECT_EQ (profile_time ("node") >= 0.2, true);
+  EXPECT_EQ (profile_time ("never profiled"), 0.0);
+}
+
+TEST (latency, report) {
+  latency_reset ();
+  LATENCY_BEGIN ();
+  EXPECT_EQ (latency_report (), string (""));
+  latency_start ();
+  for (int i=0; i<4; i++) {
+    LATENCY_BEGIN ();
+    profiled_leaf ();
+    LATENCY_STAGE ("typeset");
+    LATENCY_BEGIN ();
+    LATENCY_END ();
+  }
+  latency_stop ();
+  LATENCY_END ();
+  string r= latency_report ();
+  EXPECT_EQ (starts (r, "4 events; p50 "), true);
+  EXPECT_EQ (occurs ("typeset: mean ", r), true);
+  EXPECT_EQ (occurs ("slowest in 4 events", r), true);
+  latency_reset ();
+}
+
+TEST (latency, distribution) {
+  latency_reset ();
+  latency_start ();
+  for (int i=0; i<3; i++) {
+    LATENCY_BEGIN ();
+    profiled_leaf ();
+    LATENCY_STAGE ("typeset");
+    LATENCY_END ();
+  }
+  latency_stop ();
+  string r= latency_distribution ();
+  EXPECT_EQ (starts (r, "stage,events,mean_ms,"), true);
+  EXPECT_EQ (occurs ("\ntotal,3,", r), true);
+  EXPECT_EQ (occurs ("\ntypeset,3,", r), true);
+  EXPECT_EQ (occurs ("\nrepaint,3,", r), true);
+  latency_reset ();
+  EXPECT_EQ (occurs ("typeset", latency_distribution ()), false);
+}
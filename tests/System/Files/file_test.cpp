@@ -14,4 +14,28 @@
 
 TEST (file, work) {
   url_temp_dir();
-}
\ No newline at end of file
+}
+
+TEST (file, load_mapped) {
+  url u= url_temp (".txt");
+  string s= "<TeXmacs|1.99.13>\n\n<body|mapped>\n";
+  ASSERT_FALSE (save_string (u, s));
+  mapped_string m;
+  ASSERT_FALSE (load_mapped (u, m));
+  EXPECT_EQ (N(m), N(s));
+  EXPECT_EQ (as_string (m), s);
+  EXPECT_EQ (m (1, 8), string ("TeXmacs"));
+  EXPECT_TRUE (starts (m, "<TeXmacs|"));
+  remove (u);
+}
+
+TEST (file, load_mapped_empty) {
+  url u= url_temp (".txt");
+  ASSERT_FALSE (save_string (u, ""));
+  mapped_string m;
+  ASSERT_FALSE (load_mapped (u, m));
+  EXPECT_EQ (N(m), 0);
+  EXPECT_EQ (as_string (m), string (""));
+  remove (u);
+  EXPECT_TRUE (load_mapped (u, m));
+}
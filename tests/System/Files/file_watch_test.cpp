@@ -0,0 +1,84 @@
+
+/******************************************************************************
+* MODULE     : file_watch_test.cpp
+* DESCRIPTION: test the invalidation of watched file attributes
+* COPYRIGHT  : (C) 2020  Joris van der Hoeven
+*******************************************************************************
+* This software falls under the GNU general public license version 3 or later.
+* It comes WITHOUT ANY WARRANTY WHATSOEVER. For details, see the file LICENSE
+* in the root directory or <http://www.gnu.org/licenses/gpl-3.0.html>.
+******************************************************************************/
+
+#include "gtest/gtest.h"
+#include "file_watch.hpp"
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#if defined (__linux__)
+
+static string
+make_dir () {
+  char tmpl[]= "/tmp/file_watch_XXXXXX";
+  return string (mkdtemp (tmpl));
+}
+
+static void
+touch (string name) {
+  c_string _name (name);
+  FILE* f= fopen (_name, "a");
+  fputs ("x", f);
+  fclose (f);
+}
+
+TEST (file_watch, stat) {
+  string dir= make_dir ();
+  string name= dir * "/a.txt";
+  bool err; int mode, mtime, sz;
+  watched_stat_set (name, true, 0, 0, 0);
+  ASSERT_TRUE (watched_stat_get (name, err, mode, mtime, sz));
+  EXPECT_TRUE (err);
+  touch (name);
+  usleep (5000);
+  EXPECT_FALSE (watched_stat_get (name, err, mode, mtime, sz));
+  watched_stat_set (name, false, 1, 2, 3);
+  ASSERT_TRUE (watched_stat_get (name, err, mode, mtime, sz));
+  EXPECT_FALSE (err);
+  EXPECT_EQ (sz, 3);
+  watched_forget (name);
+  EXPECT_FALSE (watched_stat_get (name, err, mode, mtime, sz));
+  c_string _name (name), _dir (dir);
+  remove (_name);
+  rmdir (_dir);
+}
+
+TEST (file_watch, directory_stat) {
+  // the attributes of a directory change with its entries
+  string dir= make_dir ();
+  bool err; int mode, mtime, sz;
+  watched_stat_set (dir, false, (int) S_IFDIR, 1, 4096);
+  ASSERT_TRUE (watched_stat_get (dir, err, mode, mtime, sz));
+  touch (dir * "/c.txt");
+  EXPECT_FALSE (watched_stat_get (dir, err, mode, mtime, sz));
+  c_string _name (dir * "/c.txt"), _dir (dir);
+  remove (_name);
+  rmdir (_dir);
+}
+
+TEST (file_watch, directory) {
+  string dir= make_dir ();
+  array<string> a, b;
+  a << string (".") << string ("..");
+  watched_dir_set (dir, a);
+  ASSERT_TRUE (watched_dir_get (dir, b));
+  EXPECT_EQ (N(b), 2);
+  touch (dir * "/b.txt");
+  usleep (5000);
+  EXPECT_FALSE (watched_dir_get (dir, b));
+  c_string _name (dir * "/b.txt"), _dir (dir);
+  remove (_name);
+  rmdir (_dir);
+}
+
+#endif
@@ -0,0 +1,57 @@
+
+/******************************************************************************
+* MODULE     : tm_ostream_test.cpp
+* COPYRIGHT  : (C) 2020  Joris van der Hoeven
+*******************************************************************************
+* This software falls under the GNU general public license version 3 or later.
+* It comes WITHOUT ANY WARRANTY WHATSOEVER. For details, see the file LICENSE
+* in the root directory or <http://www.gnu.org/licenses/gpl-3.0.html>.
+******************************************************************************/
+
+#include "gtest/gtest.h"
+
+#include "file.hpp"
+#include "tm_ostream.hpp"
+
+TEST (tm_ostream, file_ostream) {
+  url u= url_temp (".txt");
+  c_string name (concretize (u));
+  string expected;
+  {
+    // a tiny buffer forces writes of the buffer plus an overflowing string
+    tm_ostream out= file_ostream ((char*) name, 16);
+    ASSERT_TRUE (out->is_writable ());
+    for (int i=0; i<1000; i++) {
+      out << i << " ";
+      expected << as_string (i) << " ";
+    }
+    out << "a string which is longer than the buffer\n";
+    expected << "a string which is longer than the buffer\n";
+    out.flush ();
+    string s;
+    ASSERT_FALSE (load_string (u, s, false));
+    EXPECT_EQ (s, expected);
+    out << "tail";
+    expected << "tail";
+  }
+  string s;
+  ASSERT_FALSE (load_string (u, s, false));
+  EXPECT_EQ (s, expected);
+  remove (u);
+}
+
+TEST (tm_ostream, file_ostream_line_flush) {
+  url u= url_temp (".txt");
+  c_string name (concretize (u));
+  tm_ostream out= file_ostream ((char*) name, 65536, true);
+  ASSERT_TRUE (out->is_writable ());
+  out << "first line\n";
+  out << "incomplete";
+  string s;
+  ASSERT_FALSE (load_string (u, s, false));
+  EXPECT_EQ (s, string ("first line\n"));
+  out << " second line\n";
+  ASSERT_FALSE (load_string (u, s, false));
+  EXPECT_EQ (s, string ("first line\nincomplete second line\n"));
+  remove (u);
+}
@@ -0,0 +1,44 @@
+
+/******************************************************************************
+* MODULE     : hyphenate_test.cpp
+* DESCRIPTION: test hyphenation using compiled pattern tables
+* COPYRIGHT  : (C) 2020  Joris van der Hoeven
+*******************************************************************************
+* This software falls under the GNU general public license version 3 or later.
+* It comes WITHOUT ANY WARRANTY WHATSOEVER. For details, see the file LICENSE
+* in the root directory or <http://www.gnu.org/licenses/gpl-3.0.html>.
+******************************************************************************/
+
+#include "gtest/gtest.h"
+#include "hyphenate.hpp"
+
+static string
+hyphenated (string s, array<int> penalty) {
+  string r;
+  for (int i=0; i<N(s); i++) {
+    r << s[i];
+    if (i < N(penalty) && penalty[i] < HYPH_INVALID) r << "-";
+  }
+  return r;
+}
+
+TEST (hyphenate, patterns) {
+  hyphen_table t ("us", true);
+  EXPECT_EQ (hyphenated ("algorithm", get_hyphens ("algorithm", t)),
+             string ("algo-rithm"));
+  EXPECT_EQ (hyphenated ("typesetting", get_hyphens ("typesetting", t)),
+             string ("type-set-ting"));
+  // patterns which end at the end of the word
+  EXPECT_EQ (hyphenated ("specific", get_hyphens ("specific", t)),
+             string ("spe-cific"));
+  // remembered hyphenations
+  EXPECT_EQ (N(get_hyphens ("algorithm", t)), 8);
+}
+
+TEST (hyphenate, exceptions) {
+  hyphen_table t ("us", true);
+  EXPECT_EQ (hyphenated ("table", get_hyphens ("table", t)),
+             string ("ta-ble"));
+  EXPECT_EQ (hyphenated ("project", get_hyphens ("project", t)),
+             string ("project"));
+}
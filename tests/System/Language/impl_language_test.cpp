@@ -0,0 +1,24 @@
+
+/******************************************************************************
+* MODULE     : impl_language_test.cpp
+* DESCRIPTION: test the detection of multi-line comments
+* COPYRIGHT  : (C) 2020  Joris van der Hoeven
+*******************************************************************************
+* This software falls under the GNU general public license version 3 or later.
+* It comes WITHOUT ANY WARRANTY WHATSOEVER. For details, see the file LICENSE
+* in the root directory or <http://www.gnu.org/licenses/gpl-3.0.html>.
+******************************************************************************/
+
+#include "gtest/gtest.h"
+#include "impl_language.hpp"
+
+TEST (in_comment, single_line) {
+  tree t ("a /* b */ c \"/*\" // /* x");
+  EXPECT_FALSE (in_comment (0, t));
+  EXPECT_TRUE (in_comment (2, t));
+  EXPECT_TRUE (in_comment (5, t));
+  EXPECT_TRUE (in_comment (8, t));
+  EXPECT_FALSE (in_comment (10, t));
+  EXPECT_FALSE (in_comment (13, t));
+  EXPECT_FALSE (in_comment (21, t));
+}
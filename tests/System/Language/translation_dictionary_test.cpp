@@ -0,0 +1,27 @@
+
+/******************************************************************************
+* MODULE     : translation_dictionary_test.cpp
+* DESCRIPTION: test the memoized translation of user interface strings
+* COPYRIGHT  : (C) 2020  Joris van der Hoeven
+*******************************************************************************
+* This software falls under the GNU general public license version 3 or later.
+* It comes WITHOUT ANY WARRANTY WHATSOEVER. For details, see the file LICENSE
+* in the root directory or <http://www.gnu.org/licenses/gpl-3.0.html>.
+******************************************************************************/
+
+#include "gtest/gtest.h"
+#include "dictionary.hpp"
+
+TEST (dictionary, translate) {
+  dictionary_rep* dict= tm_new<dictionary_rep> ("english", "test-french");
+  dict->table ("File")= "Fichier";
+  dict->table ("open")= "ouvrir";
+  for (int i=0; i<2; i++) {
+    EXPECT_EQ (dict->translate ("File"), string ("Fichier"));
+    EXPECT_EQ (dict->translate ("Open"), string ("Ouvrir"));
+    EXPECT_EQ (dict->translate ("File::menu"), string ("Fichier"));
+    EXPECT_EQ (dict->translate ("(File)"), string ("(Fichier)"));
+    EXPECT_EQ (dict->translate ("(File)", false), string ("(File)"));
+    EXPECT_EQ (dict->translate ("Close"), string ("Close"));
+  }
+}
@@ -0,0 +1,37 @@
+
+/******************************************************************************
+* MODULE     : background_test.cpp
+* DESCRIPTION: test the execution of shell commands in the background
+* COPYRIGHT  : (C) 2020  Joris van der Hoeven
+*******************************************************************************
+* This software falls under the GNU general public license version 3 or later.
+* It comes WITHOUT ANY WARRANTY WHATSOEVER. For details, see the file LICENSE
+* in the root directory or <http://www.gnu.org/licenses/gpl-3.0.html>.
+******************************************************************************/
+
+#include "gtest/gtest.h"
+#include "background.hpp"
+
+static int done_nr= 0;
+static int done_status= 0;
+
+static void
+done () {
+  done_nr++;
+  done_status= background_status ();
+}
+
+TEST (background, wait) {
+  done_nr= 0;
+  background_system ("true", command (done));
+  background_system ("sleep 0.05", command (done));
+  background_wait ();
+  EXPECT_EQ (done_nr, 2);
+  EXPECT_FALSE (background_busy ());
+}
+
+TEST (background, status) {
+  background_system ("exit 3", command (done));
+  background_wait ();
+  EXPECT_NE (done_status, 0);
+}
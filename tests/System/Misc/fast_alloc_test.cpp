@@ -0,0 +1,56 @@
+/******************************************************************************
+* MODULE     : fast_alloc_test.cpp
+* DESCRIPTION: test the accounting of memory by subsystem
+* COPYRIGHT  : (C) 2020  Joris van der Hoeven
+*******************************************************************************
+* This software falls under the GNU general public license version 3 or later.
+* It comes WITHOUT ANY WARRANTY WHATSOEVER. For details, see the file LICENSE
+* in the root directory or <http://www.gnu.org/licenses/gpl-3.0.html>.
+******************************************************************************/
+
+#include "gtest/gtest.h"
+#include "tree.hpp"
+
+TEST (mem_tag, charge) {
+  long long before= mem_tagged (MEM_BOXES);
+  array<int>* a;
+  {
+    MEM_TAG_SCOPE (MEM_BOXES);
+    a= tm_new<array<int> > (1000);
+  }
+  EXPECT_GE (mem_tagged (MEM_BOXES) - before, (long long) (1000 * sizeof (int)));
+  tm_delete (a);
+  EXPECT_EQ (mem_tagged (MEM_BOXES), before);
+}
+
+TEST (mem_tag, credit) {
+  // memory is credited to the tag of its allocation, not to the current one
+  long long trees= mem_tagged (MEM_TREES);
+  long long history= mem_tagged (MEM_HISTORY);
+  tree t, empty;
+  {
+    MEM_TAG_SCOPE (MEM_TREES);
+    t= tree (TUPLE, "hello", "world");
+  }
+  EXPECT_GT (mem_tagged (MEM_TREES), trees);
+  {
+    MEM_TAG_SCOPE (MEM_HISTORY);
+    t= empty;
+  }
+  EXPECT_EQ (mem_tagged (MEM_TREES), trees);
+  EXPECT_EQ (mem_tagged (MEM_HISTORY), history);
+}
+
+TEST (mem_tag, nested) {
+  EXPECT_EQ (mem_tag, MEM_OTHER);
+  {
+    MEM_TAG_SCOPE (MEM_SCHEME);
+    {
+      MEM_TAG_SCOPE (MEM_FONTS);
+      EXPECT_EQ (mem_tag, MEM_FONTS);
+    }
+    EXPECT_EQ (mem_tag, MEM_SCHEME);
+  }
+  EXPECT_EQ (mem_tag, MEM_OTHER);
+  EXPECT_STREQ (mem_tag_name (MEM_GLYPHS), "glyphs");
+}
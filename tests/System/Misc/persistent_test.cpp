@@ -0,0 +1,88 @@
+
+/******************************************************************************
+* MODULE     : persistent_test.cpp
+* DESCRIPTION: test the persistent storage of key-value pairs
+* COPYRIGHT  : (C) 2020  Joris van der Hoeven
+*******************************************************************************
+* This software falls under the GNU general public license version 3 or later.
+* It comes WITHOUT ANY WARRANTY WHATSOEVER. For details, see the file LICENSE
+* in the root directory or <http://www.gnu.org/licenses/gpl-3.0.html>.
+******************************************************************************/
+
+#include "gtest/gtest.h"
+#include "persistent.hpp"
+#include <stdlib.h>
+
+static url
+make_dir () {
+  char tmpl[]= "/tmp/persistent_XXXXXX";
+  return url_system (mkdtemp (tmpl));
+}
+
+TEST (persistent, set_get) {
+  url dir= make_dir ();
+  persistent_set (dir, "a", "x\ny");
+  persistent_set (dir, "b", "z");
+  persistent_set (dir, "a", "u");
+  persistent_reset (dir, "b");
+  EXPECT_TRUE (persistent_contains (dir, "a"));
+  EXPECT_FALSE (persistent_contains (dir, "b"));
+  EXPECT_EQ (persistent_get (dir, "a"), string ("u"));
+  string s;
+  ASSERT_FALSE (load_string (dir * url ("_") * url ("store"), s, false));
+  EXPECT_TRUE (N(s) > 0);
+}
+
+TEST (persistent, damaged_tail) {
+  url dir= make_dir ();
+  url store= dir * url ("_") * url ("store");
+  mkdir (dir * url ("_"));
+  ASSERT_FALSE (save_string (store, "1 1 ", false));
+  EXPECT_FALSE (persistent_contains (dir, "k"));
+  string s;
+  load_string (store, s, false);
+  EXPECT_EQ (N(s), 0);
+}
+
+static url
+copy_store (url dir) {
+  // a fresh directory with the same store is loaded from the file
+  url dir2= make_dir ();
+  string s;
+  mkdir (dir2 * url ("_"));
+  load_string (dir * url ("_") * url ("store"), s, false);
+  save_string (dir2 * url ("_") * url ("store"), s, false);
+  return dir2;
+}
+
+TEST (persistent, compaction) {
+  url dir= make_dir ();
+  persistent_set (dir, "b", "y");
+  for (int i=0; i<1100; i++)
+    persistent_set (dir, "a", as_string (i));
+  string s;
+  ASSERT_FALSE (load_string (dir * url ("_") * url ("store"), s, false));
+  int records= 0;
+  for (int i=0; i<N(s); i++)
+    if (s[i] == '\n') records++;
+  EXPECT_TRUE (records < 1024);
+  url dir2= copy_store (dir);
+  EXPECT_EQ (persistent_get (dir2, "a"), string ("1099"));
+  EXPECT_EQ (persistent_get (dir2, "b"), string ("y"));
+}
+
+TEST (persistent, compaction_keeps_other_writes) {
+  url dir= make_dir ();
+  persistent_set (dir, "a", "x");
+  // a record appended by another process
+  string key= "c", val= "z";
+  unsigned int sum= ((unsigned int) hash (key)) ^
+                    ((unsigned int) hash (val)) ^ ((unsigned int) N(val));
+  string r= "1 1 " * as_string ((int) sum) * "\n" * key * val;
+  ASSERT_FALSE (append_string (dir * url ("_") * url ("store"), r, false));
+  for (int i=0; i<1100; i++)
+    persistent_set (dir, "a", as_string (i));
+  url dir2= copy_store (dir);
+  EXPECT_EQ (persistent_get (dir2, "a"), string ("1099"));
+  EXPECT_EQ (persistent_get (dir2, "c"), string ("z"));
+}
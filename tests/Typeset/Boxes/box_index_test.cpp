@@ -0,0 +1,83 @@
+/******************************************************************************
+* MODULE     : box_index_test.cpp
+* DESCRIPTION: test on the spatial indices of composite boxes
+* COPYRIGHT  : (C) 2020  Joris van der Hoeven
+*******************************************************************************
+* This software falls under the GNU general public license version 3 or later.
+* It comes WITHOUT ANY WARRANTY WHATSOEVER. For details, see the file LICENSE
+* in the root directory or <http://www.gnu.org/licenses/gpl-3.0.html>.
+******************************************************************************/
+
+#include "gtest/gtest.h"
+#include "Boxes/composite.hpp"
+#include "Boxes/construct.hpp"
+
+static unsigned int seed= 1;
+
+static int
+random_int (int n) {
+  seed= seed * 1103515245 + 12345;
+  return (int) ((seed >> 8) % ((unsigned int) n));
+}
+
+static box
+random_cells (int n) {
+  // a table like arrangement of cells, some of which overlap
+  array<box> bs;
+  array<SI> x, y;
+  for (int i=0; i<n; i++) {
+    SI w= 1000 + random_int (4000), h= 1000 + random_int (2000);
+    path ip= (random_int (5) == 0? decorate (): path (i));
+    bs << empty_box (ip, 0, 0, w, h);
+    x << 3000 * (i % 40) + random_int (500);
+    y << -2000 * (i / 40) + random_int (500);
+  }
+  return composite_box (path (), bs, x, y, false);
+}
+
+static int
+linear_find_child (box_rep* b, SI x, SI y, SI delta, bool force) {
+  int i, n= b->subnr(), d= MAX_SI, m= -1;
+  for (i=0; i<n; i++)
+    if (b->distance (i, x, y, delta) < d)
+      if (b->subbox (i)->accessible () || force) {
+        d= b->distance (i, x, y, delta);
+        m= i;
+      }
+  return m;
+}
+
+TEST (box_index, find_child) {
+  box b= random_cells (2000);
+  composite_box_rep* rep= (composite_box_rep*) b.operator -> ();
+  EXPECT_EQ (rep->indexed (), true);
+  for (int k=0; k<2000; k++) {
+    SI x= random_int (140000) - 10000;
+    SI y= random_int (120000) - 110000;
+    SI delta= random_int (3) - 1;
+    bool force= random_int (2) == 0;
+    EXPECT_EQ (rep->find_child (x, y, delta, force),
+               linear_find_child (rep, x, y, delta, force));
+  }
+}
+
+TEST (box_index, find_visible) {
+  box b= random_cells (2000);
+  for (int k=0; k<100; k++) {
+    SI x1= random_int (140000) - 10000, x2= x1 + random_int (40000);
+    SI y1= random_int (120000) - 110000, y2= y1 + random_int (40000);
+    array<int> ks, expected;
+    EXPECT_EQ (b->find_visible (x1, y1, x2, y2, ks), true);
+    for (int i=0; i<N(b); i++)
+      if (b->sx4 (i) >= x1 && b->sy4 (i) >= y1 &&
+          b->sx3 (i) < x2 && b->sy3 (i) < y2)
+        expected << i;
+    EXPECT_EQ (ks == expected, true);
+  }
+}
+
+TEST (box_index, small) {
+  box b= random_cells (BOX_INDEX_THRESHOLD - 1);
+  array<int> ks;
+  EXPECT_EQ (b->find_visible (0, 0, 1, 1, ks), false);
+}
@@ -0,0 +1,46 @@
+/******************************************************************************
+* MODULE     : page_box_test.cpp
+* DESCRIPTION: test on page boxes with postponed decorations
+* COPYRIGHT  : (C) 2020  Joris van der Hoeven
+*******************************************************************************
+* This software falls under the GNU general public license version 3 or later.
+* It comes WITHOUT ANY WARRANTY WHATSOEVER. For details, see the file LICENSE
+* in the root directory or <http://www.gnu.org/licenses/gpl-3.0.html>.
+******************************************************************************/
+
+#include "gtest/gtest.h"
+#include "Boxes/construct.hpp"
+
+static int produced= 0;
+
+struct test_decoration_rep: public box_maker_rep {
+  box produce () {
+    produced++;
+    array<box> bs (1); bs[0]= empty_box (decorate (), 0, 0, 1000, 1000);
+    array<SI>  x  (1); x [0]= 500;
+    array<SI>  y  (1); y [0]= -1000;
+    return composite_box (decorate (), bs, x, y, false);
+  }
+};
+
+TEST (page_box, postponed_decoration) {
+  array<box> bs (1); bs[0]= empty_box (path (0), 0, -5000, 3000, 0);
+  array<SI>  x  (1); x [0]= 100;
+  array<SI>  y  (1); y [0]= -200;
+  box_maker dec= tm_new<test_decoration_rep> ();
+  box pb= page_box (path (), "1", 1, brush (), 4000, 6000,
+                    bs, x, y, dec);
+  EXPECT_EQ (produced, 0);
+  EXPECT_EQ (pb->w (), 4000);
+  EXPECT_EQ (pb->h (), 6000);
+  EXPECT_EQ (pb->subnr (), 1);
+  EXPECT_EQ (pb->sx (0), 100);
+  EXPECT_EQ (produced, 0);
+
+  rectangles rs (rectangle (-10000, -10000, 10000, 10000));
+  pb->clear_incomplete (rs, 1, 0, 0, 0);
+  EXPECT_EQ (produced, 1);
+  rectangles rs2 (rectangle (-10000, -10000, 10000, 10000));
+  pb->clear_incomplete (rs2, 1, 0, 0, 0);
+  EXPECT_EQ (produced, 1);
+}
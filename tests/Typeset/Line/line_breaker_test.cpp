@@ -0,0 +1,68 @@
+/******************************************************************************
+* MODULE     : line_breaker_test.cpp
+* DESCRIPTION: test on the pruning of the line breaker
+* COPYRIGHT  : (C) 2020  Joris van der Hoeven
+*******************************************************************************
+* This software falls under the GNU general public license version 3 or later.
+* It comes WITHOUT ANY WARRANTY WHATSOEVER. For details, see the file LICENSE
+* in the root directory or <http://www.gnu.org/licenses/gpl-3.0.html>.
+******************************************************************************/
+
+#include "gtest/gtest.h"
+#include "Format/line_item.hpp"
+#include "Boxes/construct.hpp"
+
+array<path>
+line_breaks (array<line_item> a, int start, int end,
+	     SI line_width, SI large_width,
+             SI first_spc, SI last_spc, bool ragged);
+void set_line_breaker (string name);
+
+static unsigned int seed= 1;
+
+static int
+random_int (int n) {
+  seed= seed * 1103515245 + 12345;
+  return (int) ((seed >> 8) % ((unsigned int) n));
+}
+
+static array<line_item>
+random_paragraph (int n, int unbreakable, bool negative) {
+  // words of random widths, separated by breakable spaces
+  array<line_item> a;
+  for (int i=0; i<n; i++) {
+    SI w= 1000 * (1 + random_int (60));
+    if (negative && random_int (20) == 0) w= -w;
+    int pen= (random_int (100) < unbreakable? HYPH_INVALID: random_int (3));
+    line_item item (STD_ITEM, 0, empty_box (decorate (), 0, 0, w, 5000), pen);
+    item->spc= space (2000, 3000, 5000);
+    a << item;
+  }
+  return a;
+}
+
+static bool
+same_breaks (array<line_item> a) {
+  SI lw= 300000, lw2= 330000;
+  set_line_breaker ("classic");
+  array<path> ap1= line_breaks (a, 0, N(a), lw, lw2, 10000, 20000, false);
+  set_line_breaker ("fast");
+  array<path> ap2= line_breaks (a, 0, N(a), lw, lw2, 10000, 20000, false);
+  return ap1 == ap2;
+}
+
+TEST (line_breaker, normal_text) {
+  for (int i=0; i<20; i++)
+    EXPECT_EQ (same_breaks (random_paragraph (400, 0, false)), true);
+}
+
+TEST (line_breaker, negative_widths) {
+  for (int i=0; i<20; i++)
+    EXPECT_EQ (same_breaks (random_paragraph (400, 10, true)), true);
+}
+
+TEST (line_breaker, unbreakable) {
+  // most lines end up overfull, so that the second pass is needed
+  for (int i=0; i<20; i++)
+    EXPECT_EQ (same_breaks (random_paragraph (400, 97, false)), true);
+}
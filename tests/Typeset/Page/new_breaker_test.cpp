@@ -0,0 +1,79 @@
+/******************************************************************************
+* MODULE     : new_breaker_test.cpp
+* DESCRIPTION: test on incremental page breaking
+* COPYRIGHT  : (C) 2020  Joris van der Hoeven
+*******************************************************************************
+* This software falls under the GNU general public license version 3 or later.
+* It comes WITHOUT ANY WARRANTY WHATSOEVER. For details, see the file LICENSE
+* in the root directory or <http://www.gnu.org/licenses/gpl-3.0.html>.
+******************************************************************************/
+
+#include "gtest/gtest.h"
+#include "Page/new_breaker.hpp"
+#include "Boxes/construct.hpp"
+
+skeleton new_break_pages (array<page_item> l, space ph, int qual,
+                          space fn_sep, space fnote_sep, space float_sep,
+                          font fn, int first_page);
+
+struct page_test_font_rep: font_rep {
+  page_test_font_rep (): font_rep ("page-test-font") {
+    y1= -2000; y2= 8000; }
+  bool supports (string c) { (void) c; return true; }
+  void get_extents (string s, metric& ex) { (void) s; (void) ex; }
+  void draw_fixed (renderer ren, string s, SI x, SI y) {
+    (void) ren; (void) s; (void) x; (void) y; }
+  font magnify (double zx, double zy) { (void) zx; (void) zy; return this; }
+};
+
+static font
+page_test_font () {
+  static font fn= tm_new<page_test_font_rep> ();
+  return fn;
+}
+
+static page_item
+line (int i, SI h) {
+  page_item item (empty_box (decorate (), 0, -h/4, 100000, 3*h/4));
+  item->spc= space (1000, 2000, 3000);
+  item->penalty= (i % 7 == 0? 1000: 0);
+  return item;
+}
+
+static array<page_item>
+chapters (int nr, int lines) {
+  array<page_item> l;
+  for (int c=0; c<nr; c++) {
+    if (c > 0) l << page_item (tree (c % 2 == 0? NEW_DPAGE: NEW_PAGE), 1);
+    for (int i=0; i<lines; i++) l << line (i, 10000);
+  }
+  return l;
+}
+
+static skeleton
+break_pages (array<page_item> l) {
+  return new_break_pages (l, space (490000, 500000, 510000), 2,
+                          space (0), space (0), space (0),
+                          page_test_font (), 1);
+}
+
+TEST (new_breaker, incremental) {
+  array<page_item> l= chapters (6, 250);
+  skeleton sk0= break_pages (l);
+  EXPECT_EQ (N(sk0) > 6, true);
+
+  array<page_item> l2= copy (l);
+  l2[4*251 + 10]= line (10, 30000);
+  skeleton sk1= break_pages (l2);
+  (void) break_pages (array<page_item> ());
+  skeleton sk2= break_pages (l2);
+  EXPECT_EQ (sk1 == sk2, true);
+
+  (void) break_pages (l);
+  l2= copy (l);
+  l2[20]= line (20, 30000);
+  sk1= break_pages (l2);
+  (void) break_pages (array<page_item> ());
+  sk2= break_pages (l2);
+  EXPECT_EQ (sk1 == sk2, true);
+}